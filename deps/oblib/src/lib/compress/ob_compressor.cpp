@@ -15,11 +15,39 @@
 #include <stdio.h>
 #include <dlfcn.h>
 #include "lib/compress/ob_compressor.h"
+#include "lib/ob_errno.h"
+#include "lib/utility/ob_macro_utils.h"
 
 namespace oceanbase
 {
 namespace common
 {
 const char *ObCompressor::none_compressor_name = "none";
+
+int ObCompressor::compress_with_dict(const char *src_buffer,
+                                     const int64_t src_data_size,
+                                     const char *dict_buffer,
+                                     const int64_t dict_size,
+                                     char *dst_buffer,
+                                     const int64_t dst_buffer_size,
+                                     int64_t &dst_data_size)
+{
+  UNUSEDx(src_buffer, src_data_size, dict_buffer, dict_size, dst_buffer, dst_buffer_size);
+  dst_data_size = 0;
+  return OB_NOT_SUPPORTED;
+}
+
+int ObCompressor::decompress_with_dict(const char *src_buffer,
+                                       const int64_t src_data_size,
+                                       const char *dict_buffer,
+                                       const int64_t dict_size,
+                                       char *dst_buffer,
+                                       const int64_t dst_buffer_size,
+                                       int64_t &dst_data_size)
+{
+  UNUSEDx(src_buffer, src_data_size, dict_buffer, dict_size, dst_buffer, dst_buffer_size);
+  dst_data_size = 0;
+  return OB_NOT_SUPPORTED;
+}
 }//namespace common
 }//namespace oceanbase*/
@@ -39,6 +39,23 @@ public:
                          char *dst_buffer,
                          const int64_t dst_buffer_size,
                          int64_t &dst_data_size) = 0;
+  // the dictionary is raw content shared by the compressed blocks, decompress must use
+  // the same dictionary, only supported by some compressors.
+  virtual int compress_with_dict(const char *src_buffer,
+                                 const int64_t src_data_size,
+                                 const char *dict_buffer,
+                                 const int64_t dict_size,
+                                 char *dst_buffer,
+                                 const int64_t dst_buffer_size,
+                                 int64_t &dst_data_size);
+  virtual int decompress_with_dict(const char *src_buffer,
+                                   const int64_t src_data_size,
+                                   const char *dict_buffer,
+                                   const int64_t dict_size,
+                                   char *dst_buffer,
+                                   const int64_t dst_buffer_size,
+                                   int64_t &dst_data_size);
+  virtual bool support_dict() const { return false; }
   virtual int get_max_overflow_size(const int64_t src_data_size,
                                     int64_t &max_overflow_size) const = 0;
   virtual const char *get_compressor_name() const = 0;
@@ -38,6 +38,21 @@ public:
                  char *dst_buffer,
                  const int64_t dst_buffer_size,
                  int64_t &dst_data_size) override;
+  int compress_with_dict(const char *src_buffer,
+                         const int64_t src_data_size,
+                         const char *dict_buffer,
+                         const int64_t dict_size,
+                         char *dst_buffer,
+                         const int64_t dst_buffer_size,
+                         int64_t &dst_data_size) override;
+  int decompress_with_dict(const char *src_buffer,
+                           const int64_t src_data_size,
+                           const char *dict_buffer,
+                           const int64_t dict_size,
+                           char *dst_buffer,
+                           const int64_t dst_buffer_size,
+                           int64_t &dst_data_size) override;
+  bool support_dict() const override { return true; }
   const char *get_compressor_name() const;
   ObCompressorType get_compressor_type() const;
   int get_max_overflow_size(const int64_t src_data_size,
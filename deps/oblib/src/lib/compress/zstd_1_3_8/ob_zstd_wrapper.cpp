@@ -122,6 +122,100 @@ int ObZstdWrapper::decompress(
 }
 
 
+int ObZstdWrapper::compress_using_dict(
+    OB_ZSTD_customMem &ob_zstd_mem,
+    const char *src_buffer,
+    const size_t src_data_size,
+    const char *dict_buffer,
+    const size_t dict_size,
+    char *dst_buffer,
+    const size_t dst_buffer_size,
+    size_t &compress_ret_size)
+{
+  int ret = OB_SUCCESS;
+  ZSTD_CCtx *zstd_cctx = NULL;
+  ZSTD_customMem zstd_mem;
+  zstd_mem.customAlloc = ob_zstd_mem.customAlloc;
+  zstd_mem.customFree = ob_zstd_mem.customFree;
+  zstd_mem.opaque = ob_zstd_mem.opaque;
+
+  if (NULL == src_buffer
+      || 0 >= src_data_size
+      || NULL == dict_buffer
+      || 0 >= dict_size
+      || NULL == dst_buffer
+      || 0 >= dst_buffer_size) {
+    ret = OB_INVALID_ARGUMENT;
+  } else if (NULL == (zstd_cctx = ZSTD_createCCtx_advanced(zstd_mem))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else {
+    compress_ret_size = ZSTD_compress_usingDict(zstd_cctx,
+                                                dst_buffer,
+                                                dst_buffer_size,
+                                                src_buffer,
+                                                src_data_size,
+                                                dict_buffer,
+                                                dict_size,
+                                                OB_ZSTD_COMPRESS_LEVEL);
+    if (0 != ZSTD_isError(compress_ret_size)) {
+      ret = OB_ERR_COMPRESS_DECOMPRESS_DATA;
+    }
+  }
+
+  if (NULL != zstd_cctx) {
+    ZSTD_freeCCtx(zstd_cctx);
+    zstd_cctx = NULL;
+  }
+  return ret;
+}
+
+int ObZstdWrapper::decompress_using_dict(
+    OB_ZSTD_customMem &ob_zstd_mem,
+    const char *src_buffer,
+    const size_t src_data_size,
+    const char *dict_buffer,
+    const size_t dict_size,
+    char *dst_buffer,
+    const size_t dst_buffer_size,
+    size_t &dst_data_size)
+{
+  int ret = OB_SUCCESS;
+  ZSTD_DCtx *zstd_dctx = NULL;
+  ZSTD_customMem zstd_mem;
+  zstd_mem.customAlloc = ob_zstd_mem.customAlloc;
+  zstd_mem.customFree = ob_zstd_mem.customFree;
+  zstd_mem.opaque = ob_zstd_mem.opaque;
+  dst_data_size = 0;
+
+  if (NULL == src_buffer
+      || 0 >= src_data_size
+      || NULL == dict_buffer
+      || 0 >= dict_size
+      || NULL == dst_buffer
+      || 0 >= dst_buffer_size) {
+    ret = OB_INVALID_ARGUMENT;
+  } else if (NULL == (zstd_dctx = ZSTD_createDCtx_advanced(zstd_mem))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else {
+    dst_data_size = ZSTD_decompress_usingDict(zstd_dctx,
+                                              dst_buffer,
+                                              dst_buffer_size,
+                                              src_buffer,
+                                              src_data_size,
+                                              dict_buffer,
+                                              dict_size);
+    if (0 != ZSTD_isError(dst_data_size)) {
+      ret = OB_ERR_COMPRESS_DECOMPRESS_DATA;
+    }
+  }
+
+  if (NULL != zstd_dctx) {
+    ZSTD_freeDCtx(zstd_dctx);
+    zstd_dctx = NULL;
+  }
+  return ret;
+}
+
 int ObZstdWrapper::create_cctx(OB_ZSTD_customMem &ob_zstd_mem, void *&ctx)
 {
   int ret = OB_SUCCESS;
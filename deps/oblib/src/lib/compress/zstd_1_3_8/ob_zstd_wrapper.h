@@ -48,6 +48,25 @@ public:
       char *dst_buffer,
       const size_t dst_buffer_size,
       size_t &dst_data_size);
+  // for normal with raw content dictionary
+  static int compress_using_dict(
+      OB_ZSTD_customMem &zstd_mem,
+      const char *src_buffer,
+      const size_t src_data_size,
+      const char *dict_buffer,
+      const size_t dict_size,
+      char *dst_buffer,
+      const size_t dst_buffer_size,
+      size_t &compress_ret_size);
+  static int decompress_using_dict(
+      OB_ZSTD_customMem &zstd_mem,
+      const char *src_buffer,
+      const size_t src_data_size,
+      const char *dict_buffer,
+      const size_t dict_size,
+      char *dst_buffer,
+      const size_t dst_buffer_size,
+      size_t &dst_data_size);
 
   // for stream
   static int create_cctx(OB_ZSTD_customMem &ob_zstd_mem, void *&ctx);
@@ -269,6 +269,18 @@ STAT_EVENT_ADD_DEF(OPT_SYSTEM_STAT_CACHE_MISS, "opt system stat cache miss", ObS
 STAT_EVENT_ADD_DEF(LOG_KV_CACHE_HIT, "log kv cache hit", ObStatClassIds::CACHE, 50065, false, true, true)
 STAT_EVENT_ADD_DEF(LOG_KV_CACHE_MISS, "log kv cache miss", ObStatClassIds::CACHE, 50066, false, true, true)
 
+STAT_EVENT_ADD_DEF(COMPRESSED_BLOCK_CACHE_HIT, "compressed block cache hit", ObStatClassIds::CACHE, 50067, true, true, true)
+STAT_EVENT_ADD_DEF(COMPRESSED_BLOCK_CACHE_MISS, "compressed block cache miss", ObStatClassIds::CACHE, 50068, true, true, true)
+STAT_EVENT_ADD_DEF(COMPRESSED_BLOCK_CACHE_DECOMPRESS_TIME, "compressed block cache decompress time", ObStatClassIds::CACHE, 50069, true, true, true)
+
+STAT_EVENT_ADD_DEF(KVCACHE_PROBATION_PUT_COUNT, "kvcache probation put count", ObStatClassIds::CACHE, 50070, true, true, true)
+STAT_EVENT_ADD_DEF(KVCACHE_PROBATION_PROMOTE_COUNT, "kvcache probation promote count", ObStatClassIds::CACHE, 50071, true, true, true)
+
+STAT_EVENT_ADD_DEF(MICRO_BLOCK_FLASH_CACHE_HIT, "micro block flash cache hit", ObStatClassIds::CACHE, 50072, true, true, true)
+STAT_EVENT_ADD_DEF(MICRO_BLOCK_FLASH_CACHE_MISS, "micro block flash cache miss", ObStatClassIds::CACHE, 50073, true, true, true)
+STAT_EVENT_ADD_DEF(MICRO_BLOCK_FLASH_CACHE_WRITE_SIZE, "micro block flash cache write size", ObStatClassIds::CACHE, 50074, true, true, true)
+STAT_EVENT_ADD_DEF(MICRO_BLOCK_FLASH_CACHE_PUT_DROP_COUNT, "micro block flash cache put drop count", ObStatClassIds::CACHE, 50075, true, true, true)
+
 // STORAGE
 STAT_EVENT_ADD_DEF(MEMSTORE_LOGICAL_READS, "MEMSTORE_LOGICAL_READS", STORAGE, "MEMSTORE_LOGICAL_READS", true, true, false)
 STAT_EVENT_ADD_DEF(MEMSTORE_LOGICAL_BYTES, "MEMSTORE_LOGICAL_BYTES", STORAGE, "MEMSTORE_LOGICAL_BYTES", true, true, false)
@@ -344,6 +356,16 @@ STAT_EVENT_ADD_DEF(PUSHDOWN_STORAGE_FILTER_ROW_CNT, "storage filtered row count"
 STAT_EVENT_ADD_DEF(MINOR_SSSTORE_READ_ROW_COUNT, "minor ssstore read row count", ObStatClassIds::STORAGE, 60091, true, true, true)
 STAT_EVENT_ADD_DEF(MAJOR_SSSTORE_READ_ROW_COUNT, "major ssstore read row count", ObStatClassIds::STORAGE, 60092, true, true, true)
 STAT_EVENT_ADD_DEF(STORAGE_WRITING_THROTTLE_TIME, "storage waiting throttle time", ObStatClassIds::STORAGE, 60093, true, true, true)
+STAT_EVENT_ADD_DEF(DATA_PREFETCH_ROUND_CNT, "data micro block prefetch round count", ObStatClassIds::STORAGE, 60094, true, true, true)
+STAT_EVENT_ADD_DEF(DATA_PREFETCH_DEPTH, "data micro block prefetch depth", ObStatClassIds::STORAGE, 60095, true, true, true)
+STAT_EVENT_ADD_DEF(MICRO_BLOCK_IO_STALL_TIME, "micro block io stall time", ObStatClassIds::STORAGE, 60096, true, true, true)
+STAT_EVENT_ADD_DEF(TMP_FILE_WASH_BLOCK_COUNT, "tmp file wash block count", ObStatClassIds::STORAGE, 60097, false, true, true)
+STAT_EVENT_ADD_DEF(TMP_FILE_WASH_COMPRESSED_BLOCK_COUNT, "tmp file wash compressed block count", ObStatClassIds::STORAGE, 60098, false, true, true)
+STAT_EVENT_ADD_DEF(TMP_FILE_WASH_RAW_BYTES, "tmp file wash raw bytes", ObStatClassIds::STORAGE, 60099, false, true, true)
+STAT_EVENT_ADD_DEF(TMP_FILE_WASH_WRITE_BYTES, "tmp file wash write bytes", ObStatClassIds::STORAGE, 60100, false, true, true)
+STAT_EVENT_ADD_DEF(TMP_FILE_COMPRESS_TIME, "tmp file compress time", ObStatClassIds::STORAGE, 60101, false, true, true)
+STAT_EVENT_ADD_DEF(TMP_FILE_WRITE_IO_WAIT_TIME, "tmp file write io wait time", ObStatClassIds::STORAGE, 60102, true, true, true)
+STAT_EVENT_ADD_DEF(TMP_FILE_READ_IO_WAIT_TIME, "tmp file read io wait time", ObStatClassIds::STORAGE, 60103, true, true, true)
 
 // backup & restore
 STAT_EVENT_ADD_DEF(BACKUP_IO_READ_COUNT, "backup io read count", ObStatClassIds::STORAGE, 69000, true, true, true)
@@ -604,6 +626,7 @@ STAT_EVENT_SET_DEF(USER_BLOCK_CACHE_SIZE, "user block cache size", ObStatClassId
 STAT_EVENT_SET_DEF(USER_ROW_CACHE_SIZE, "user row cache size", ObStatClassIds::CACHE, 120008, false, true, true)
 STAT_EVENT_SET_DEF(BLOOM_FILTER_CACHE_SIZE, "bloom filter cache size", ObStatClassIds::CACHE, 120009, false, true, true)
 STAT_EVENT_SET_DEF(LOG_KV_CACHE_SIZE, "log kv cache size", ObStatClassIds::CACHE, 120010, false, true, true)
+STAT_EVENT_SET_DEF(USER_COMPRESSED_BLOCK_CACHE_SIZE, "user compressed block cache size", ObStatClassIds::CACHE, 120011, false, true, true)
 
 // STORAGE
 STAT_EVENT_SET_DEF(ACTIVE_MEMSTORE_USED, "active memstore used", ObStatClassIds::STORAGE, 130000, false, true, true)
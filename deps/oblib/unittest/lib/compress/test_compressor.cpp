@@ -380,6 +380,61 @@ TEST_F(ObCompressorTest, test_zstd)
   test_normal(zstd_compressor);
 }
 
+TEST_F(ObCompressorTest, test_zstd_1_3_8_dict)
+{
+  int ret = OB_SUCCESS;
+  ObCompressor *compressor = NULL;
+  const int64_t src_size = static_cast<int64_t>(strlen(src_data));
+  // raw content dictionary with the common parts of the data
+  const char *dict_data = "OceanBase is the first financial database in the world. without shared storage ";
+  const int64_t dict_size = static_cast<int64_t>(strlen(dict_data));
+  int64_t dict_compress_size = 0;
+  int64_t plain_compress_size = 0;
+  memset(compress_buffer, 0, sizeof(compress_buffer));
+  memset(decompress_buffer, 0, sizeof(decompress_buffer));
+
+  //compressors without dict support
+  ret = ObCompressorPool::get_instance().get_compressor(ZSTD_COMPRESSOR, compressor);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_FALSE(compressor->support_dict());
+  ret = compressor->compress_with_dict(src_data, src_size, dict_data, dict_size,
+                                       compress_buffer, buffer_size, dst_data_size);
+  ASSERT_EQ(OB_NOT_SUPPORTED, ret);
+
+  ret = ObCompressorPool::get_instance().get_compressor(ZSTD_1_3_8_COMPRESSOR, compressor);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_TRUE(compressor->support_dict());
+
+  //test invalid argument
+  ret = compressor->compress_with_dict(src_data, src_size, NULL, dict_size,
+                                       compress_buffer, buffer_size, dst_data_size);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ret);
+  ret = compressor->compress_with_dict(src_data, src_size, dict_data, 0,
+                                       compress_buffer, buffer_size, dst_data_size);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ret);
+  ret = compressor->decompress_with_dict(compress_buffer, 1, NULL, dict_size,
+                                         decompress_buffer, buffer_size, dst_data_size);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ret);
+
+  //test overflow size
+  ret = compressor->compress_with_dict(src_data, src_size, dict_data, dict_size,
+                                       compress_buffer, src_size, dst_data_size);
+  ASSERT_EQ(OB_BUF_NOT_ENOUGH, ret);
+
+  //test normal
+  ret = compressor->compress(src_data, src_size, compress_buffer, buffer_size, plain_compress_size);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ret = compressor->compress_with_dict(src_data, src_size, dict_data, dict_size,
+                                       compress_buffer, buffer_size, dict_compress_size);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_LT(dict_compress_size, plain_compress_size);
+  ret = compressor->decompress_with_dict(compress_buffer, dict_compress_size, dict_data, dict_size,
+                                         decompress_buffer, src_size, dst_data_size);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(src_size, dst_data_size);
+  ASSERT_EQ(0, memcmp(src_data, decompress_buffer, src_size));
+}
+
 TEST(ObCompressorStress, compress_stable)
 {
   int ret = OB_SUCCESS;
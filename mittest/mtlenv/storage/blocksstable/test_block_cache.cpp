@@ -17,6 +17,7 @@
 #include "storage/blocksstable/ob_micro_block_cache.h"
 #include "ob_index_block_data_prepare.h"
 #include "storage/blocksstable/ob_shared_macro_block_manager.h"
+#include "storage/blocksstable/ob_micro_block_flash_cache.h"
 
 namespace oceanbase
 {
@@ -287,6 +288,64 @@ TEST_F(TestObMicroBlockCache, test_block_cache)
 }
 
 
+TEST_F(TestObMicroBlockCache, test_flash_cache_restart)
+{
+  const char *file_path = "test_block_cache.flash";
+  const int64_t segment_size = ObMicroBlockFlashCache::SEGMENT_SIZE;
+  const int64_t file_size = ObMicroBlockFlashCache::MIN_SEGMENT_CNT * segment_size;
+  system("rm -f test_block_cache.flash");
+
+  // a macro block in use by the sstable
+  ObIndexBlockRowScanner idx_row_scanner;
+  ObMicroBlockData root_block;
+  ObMicroIndexInfo micro_idx_info;
+  sstable_.get_index_tree_root(root_block);
+  ASSERT_EQ(OB_SUCCESS, idx_row_scanner.init(
+      tablet_handle_.get_obj()->get_rowkey_read_info().get_datum_utils(),
+      allocator_,
+      context_.query_flag_,
+      0));
+  ASSERT_EQ(OB_SUCCESS, idx_row_scanner.open(
+      ObIndexBlockRowHeader::DEFAULT_IDX_ROW_MACRO_ID, root_block, ObDatumRowkey::MIN_ROWKEY));
+  ASSERT_EQ(OB_SUCCESS, idx_row_scanner.get_next(micro_idx_info));
+  bool is_free = true;
+  ObMicroBlockId live_block_id(micro_idx_info.get_macro_id(), 0, 1024);
+  ASSERT_EQ(OB_SUCCESS, OB_SERVER_BLOCK_MGR.check_macro_block_free(live_block_id.macro_id_, is_free));
+  ASSERT_FALSE(is_free);
+  // a macro block freed before restart
+  ObMicroBlockId freed_block_id(MacroBlockId(0, 2, 1000000), 0, 1024);
+  ASSERT_EQ(OB_SUCCESS, OB_SERVER_BLOCK_MGR.check_macro_block_free(freed_block_id.macro_id_, is_free));
+  ASSERT_TRUE(is_free);
+
+  char live_buf[1024];
+  char freed_buf[1024];
+  char read_buf[1024];
+  MEMSET(live_buf, 'a', sizeof(live_buf));
+  MEMSET(freed_buf, 'b', sizeof(freed_buf));
+  ObMicroBlockFlashCache flash_cache;
+  ASSERT_EQ(OB_SUCCESS, flash_cache.init(file_path, file_size));
+  ASSERT_FALSE(flash_cache.need_check_loaded_blocks_);
+  ASSERT_EQ(OB_SUCCESS, flash_cache.put_block(live_block_id, live_buf));
+  ASSERT_EQ(OB_SUCCESS, flash_cache.put_block(freed_block_id, freed_buf));
+  ASSERT_EQ(OB_SUCCESS, flash_cache.flush_segment(flash_cache.active_segment_));
+  ASSERT_EQ(OB_SUCCESS, flash_cache.get_block(freed_block_id, read_buf));
+  ASSERT_EQ(0, MEMCMP(freed_buf, read_buf, sizeof(read_buf)));
+  flash_cache.destroy();
+
+  // restart, both blocks are loaded until checked against the block manager
+  ASSERT_EQ(OB_SUCCESS, flash_cache.init(file_path, file_size));
+  ASSERT_TRUE(flash_cache.need_check_loaded_blocks_);
+  ASSERT_EQ(2, flash_cache.index_map_.size());
+  ASSERT_EQ(OB_SUCCESS, flash_cache.purge_freed_macro_blocks());
+  ASSERT_EQ(1, flash_cache.index_map_.size());
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, flash_cache.get_block(freed_block_id, read_buf));
+  ASSERT_EQ(OB_SUCCESS, flash_cache.get_block(live_block_id, read_buf));
+  ASSERT_EQ(0, MEMCMP(live_buf, read_buf, sizeof(read_buf)));
+  flash_cache.destroy();
+  system("rm -f test_block_cache.flash");
+}
+
+
 } // blocksstable
 } // oceanbase
 
@@ -158,6 +158,75 @@ TEST_F(TestBloomFilterCache, test_normal)
 }
 
 
+TEST_F(TestBloomFilterCache, test_blocked_bloom_filter)
+{
+  const int64_t element_cnt = 10000;
+  const int64_t probe_cnt = 2 * element_cnt;
+  ObBloomFilter classic_bf;
+  ObBloomFilter blocked_bf;
+  ASSERT_EQ(OB_SUCCESS, classic_bf.init(element_cnt));
+  ASSERT_EQ(OB_SUCCESS, blocked_bf.init(element_cnt, ObBloomFilter::BLOOM_FILTER_FALSE_POSITIVE_PROB, true));
+  ASSERT_FALSE(classic_bf.is_blocked());
+  ASSERT_TRUE(blocked_bf.is_blocked());
+  ASSERT_EQ(ObBloomFilter::BLOCKED_NHASH, blocked_bf.get_nhash());
+  ASSERT_EQ(0, blocked_bf.get_nbit() % ObBloomFilter::BLOCK_NBIT);
+
+  uint32_t *hashes = static_cast<uint32_t *>(allocator_.alloc(sizeof(uint32_t) * probe_cnt));
+  uint64_t *bitmap = static_cast<uint64_t *>(allocator_.alloc(sizeof(uint64_t) * (probe_cnt + 63) / 64));
+  ASSERT_TRUE(nullptr != hashes && nullptr != bitmap);
+  for (int64_t i = 0; i < probe_cnt; ++i) {
+    hashes[i] = static_cast<uint32_t>(murmurhash(&i, sizeof(i), 0));
+  }
+  for (int64_t i = 0; i < element_cnt; ++i) {
+    ASSERT_EQ(OB_SUCCESS, classic_bf.insert(hashes[i]));
+    ASSERT_EQ(OB_SUCCESS, blocked_bf.insert(hashes[i]));
+  }
+
+  // batch probe returns the same results as single probe, no false negative
+  ObBloomFilter *bfs[2] = {&classic_bf, &blocked_bf};
+  for (int64_t bf_idx = 0; bf_idx < 2; ++bf_idx) {
+    const ObBloomFilter &bf = *bfs[bf_idx];
+    int64_t false_positive_cnt = 0;
+    // odd count and offset to check the tail of bitmap
+    ASSERT_EQ(OB_SUCCESS, bf.may_contain(hashes + 1, probe_cnt - 1, bitmap));
+    for (int64_t i = 1; i < probe_cnt; ++i) {
+      bool is_contain = false;
+      const bool batch_contain = (bitmap[(i - 1) / 64] >> ((i - 1) % 64)) & 1;
+      ASSERT_EQ(OB_SUCCESS, bf.may_contain(hashes[i], is_contain));
+      ASSERT_EQ(is_contain, batch_contain) << "i=" << i;
+      if (i < element_cnt) {
+        ASSERT_TRUE(is_contain);
+      } else if (is_contain) {
+        false_positive_cnt++;
+      }
+    }
+    STORAGE_LOG(INFO, "bloom filter false positive", K(bf), K(false_positive_cnt));
+    ASSERT_LT(false_positive_cnt, element_cnt * 5 / 100);
+  }
+  ASSERT_EQ(OB_INVALID_ARGUMENT, blocked_bf.may_contain(nullptr, 1, bitmap));
+
+  // blocked format is recorded by the version of cache value
+  ObBloomFilterCacheValue bf_value;
+  ObBloomFilterCacheValue deserialized_value;
+  ASSERT_EQ(OB_SUCCESS, bf_value.init(2, element_cnt));
+  ASSERT_EQ(ObBloomFilterCacheValue::BLOOM_FILTER_CACHE_VALUE_BLOCKED_VERSION, bf_value.version_);
+  for (int64_t i = 0; i < element_cnt; ++i) {
+    ASSERT_EQ(OB_SUCCESS, bf_value.insert(hashes[i]));
+  }
+  const int64_t buf_len = bf_value.get_serialize_size();
+  char *buf = static_cast<char *>(allocator_.alloc(buf_len));
+  int64_t pos = 0;
+  ASSERT_TRUE(nullptr != buf);
+  ASSERT_EQ(OB_SUCCESS, bf_value.serialize(buf, buf_len, pos));
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, deserialized_value.deserialize(buf, buf_len, pos));
+  ASSERT_TRUE(deserialized_value.bloom_filter_.is_blocked());
+  ASSERT_EQ(OB_SUCCESS, deserialized_value.may_contain(hashes, probe_cnt, bitmap));
+  for (int64_t i = 0; i < element_cnt; ++i) {
+    ASSERT_TRUE((bitmap[i / 64] >> (i % 64)) & 1);
+  }
+}
+
 TEST_F(TestBloomFilterCache, test_empty_read_cell_normal)
 {
   int ret = OB_SUCCESS;
@@ -0,0 +1,239 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+
+#include "storage/blocksstable/ob_micro_block_cache.h"
+#include "storage/blocksstable/ob_micro_block_compress_dict.h"
+#include "storage/blocksstable/ob_shared_dict_cache.h"
+#include "storage/access/ob_sstable_row_getter.h"
+#include "ob_index_block_data_prepare.h"
+
+namespace oceanbase
+{
+using namespace storage;
+using namespace common;
+namespace blocksstable
+{
+class TestMicroBlockCompressDict : public TestIndexBlockDataPrepare
+{
+public:
+  TestMicroBlockCompressDict();
+  virtual ~TestMicroBlockCompressDict();
+  static void SetUpTestCase();
+  static void TearDownTestCase();
+
+  virtual void SetUp();
+  virtual void TearDown();
+  virtual void prepare_schema();
+  void get_data_micro_infos(ObIArray<ObMicroIndexInfo> &micro_idx_infos);
+  void test_one_rowkey(const int64_t seed);
+protected:
+  ObDataMicroBlockCache *data_block_cache_;
+};
+
+TestMicroBlockCompressDict::TestMicroBlockCompressDict()
+  : TestIndexBlockDataPrepare("Test micro block compress dict"),
+    data_block_cache_(nullptr)
+{
+}
+
+TestMicroBlockCompressDict::~TestMicroBlockCompressDict()
+{
+}
+
+void TestMicroBlockCompressDict::SetUpTestCase()
+{
+  TestIndexBlockDataPrepare::SetUpTestCase();
+  GCONF._enable_micro_block_compress_dict = true;
+}
+
+void TestMicroBlockCompressDict::TearDownTestCase()
+{
+  GCONF._enable_micro_block_compress_dict = false;
+  TestIndexBlockDataPrepare::TearDownTestCase();
+}
+
+void TestMicroBlockCompressDict::SetUp()
+{
+  TestIndexBlockDataPrepare::SetUp();
+  data_block_cache_ = &ObStorageCacheSuite::get_instance().get_block_cache();
+  ObLSID ls_id(ls_id_);
+  ObTabletID tablet_id(tablet_id_);
+  ObLSHandle ls_handle;
+  ObLSService *ls_svr = MTL(ObLSService*);
+  ASSERT_EQ(OB_SUCCESS, ls_svr->get_ls(ls_id, ls_handle, ObLSGetMod::STORAGE_MOD));
+  ASSERT_EQ(OB_SUCCESS, ls_handle.get_ls()->get_tablet(tablet_id, tablet_handle_));
+
+  prepare_query_param(false);
+}
+
+void TestMicroBlockCompressDict::TearDown()
+{
+  destroy_query_param();
+  tablet_handle_.reset();
+  TestIndexBlockDataPrepare::TearDown();
+}
+
+void TestMicroBlockCompressDict::prepare_schema()
+{
+  TestIndexBlockDataPrepare::prepare_schema();
+  // only compressors with dict support use the compress dict
+  table_schema_.set_compress_func_name("zstd_1.3.8");
+}
+
+// micro blocks of the first data macro block
+void TestMicroBlockCompressDict::get_data_micro_infos(ObIArray<ObMicroIndexInfo> &micro_idx_infos)
+{
+  ObIndexBlockRowScanner idx_row_scanner;
+  ObMicroBlockData root_block;
+  ObMicroIndexInfo micro_idx_info;
+  ObMicroBlockBufferHandle idx_buf_handle;
+  ObMacroBlockHandle idx_io_handle;
+  ObIndexMicroBlockCache &index_block_cache = ObStorageCacheSuite::get_instance().get_index_block_cache();
+  sstable_.get_index_tree_root(root_block);
+  ASSERT_EQ(OB_SUCCESS, idx_row_scanner.init(
+      tablet_handle_.get_obj()->get_rowkey_read_info().get_datum_utils(),
+      allocator_,
+      context_.query_flag_,
+      0));
+  ASSERT_EQ(OB_SUCCESS, idx_row_scanner.open(
+      ObIndexBlockRowHeader::DEFAULT_IDX_ROW_MACRO_ID, root_block, ObDatumRowkey::MIN_ROWKEY));
+  ASSERT_EQ(OB_SUCCESS, idx_row_scanner.get_next(micro_idx_info));
+  ASSERT_TRUE(micro_idx_info.is_leaf_block());
+  ASSERT_EQ(OB_SUCCESS, index_block_cache.prefetch(
+      MTL_ID(),
+      micro_idx_info.get_macro_id(),
+      micro_idx_info,
+      context_.query_flag_.is_use_block_cache(),
+      idx_io_handle,
+      &allocator_));
+  ASSERT_EQ(OB_SUCCESS, idx_io_handle.wait());
+  ObMicroBlockData idx_data =
+      reinterpret_cast<const ObMicroBlockCacheValue*>(idx_io_handle.get_buffer())->get_block_data();
+
+  int tmp_ret = OB_SUCCESS;
+  ObDatumRange full_range;
+  full_range.set_whole_range();
+  idx_row_scanner.reuse();
+  ASSERT_EQ(OB_SUCCESS, idx_row_scanner.open(micro_idx_info.get_macro_id(), idx_data, full_range, 0, true, true));
+  while (OB_SUCCESS == tmp_ret) {
+    tmp_ret = idx_row_scanner.get_next(micro_idx_info);
+    if (OB_SUCCESS == tmp_ret) {
+      ASSERT_EQ(OB_SUCCESS, micro_idx_infos.push_back(micro_idx_info));
+    }
+  }
+  ASSERT_EQ(OB_ITER_END, tmp_ret);
+  ASSERT_NE(0, micro_idx_infos.count());
+}
+
+void TestMicroBlockCompressDict::test_one_rowkey(const int64_t seed)
+{
+  ObSSTableRowGetter getter;
+  ObDatumRow query_row;
+  ASSERT_EQ(OB_SUCCESS, query_row.init(allocator_, TEST_COLUMN_CNT));
+  row_generate_.get_next_row(seed, query_row);
+  ObDatumRowkey query_rowkey;
+  query_rowkey.assign(query_row.storage_datums_, TEST_ROWKEY_COLUMN_CNT);
+  ASSERT_EQ(OB_SUCCESS, getter.init(iter_param_, context_, &sstable_, &query_rowkey));
+
+  const ObDatumRow *prow = nullptr;
+  ASSERT_EQ(OB_SUCCESS, getter.inner_get_next_row(prow));
+  ASSERT_TRUE(*prow == query_row);
+  ASSERT_EQ(OB_ITER_END, getter.inner_get_next_row(prow));
+}
+
+TEST_F(TestMicroBlockCompressDict, test_load_block)
+{
+  ObArray<ObMicroIndexInfo> micro_idx_infos;
+  get_data_micro_infos(micro_idx_infos);
+
+  // the first micro blocks are sampled into the dict, the following ones are compressed with it
+  int64_t dict_block_cnt = 0;
+  ObMacroBlockReader macro_reader;
+  for (int64_t i = 0; i < micro_idx_infos.count(); ++i) {
+    ObMicroIndexInfo &data_idx_info = micro_idx_infos.at(i);
+    ObMicroBlockDesMeta micro_des_meta;
+    ObMicroBlockData loaded_micro_data;
+    ObMicroBlockId micro_block_id(data_idx_info.get_macro_id(),
+        data_idx_info.get_block_offset(), data_idx_info.get_block_size());
+    ASSERT_EQ(OB_SUCCESS, data_idx_info.row_header_->fill_micro_des_meta(false, micro_des_meta));
+    ASSERT_EQ(OB_SUCCESS, data_block_cache_->load_block(
+        micro_block_id,
+        micro_des_meta,
+        &macro_reader,
+        loaded_micro_data,
+        &allocator_));
+    ASSERT_TRUE(loaded_micro_data.is_valid());
+    ASSERT_EQ(loaded_micro_data.get_micro_header()->row_count_, data_idx_info.get_row_count());
+    if (loaded_micro_data.get_micro_header()->has_compress_dict()) {
+      ++dict_block_cnt;
+      // the dict of reader is only set during decompression
+      ASSERT_TRUE(macro_reader.get_compress_dict().empty());
+
+      // read through the prefetch path, which puts the micro block into cache
+      ObMacroBlockHandle data_io_handle;
+      ObMicroBlockBufferHandle data_buf_handle;
+      ASSERT_EQ(OB_SUCCESS, data_block_cache_->prefetch(
+          MTL_ID(),
+          data_idx_info.get_macro_id(),
+          data_idx_info,
+          context_.query_flag_.is_use_block_cache(),
+          data_io_handle,
+          &allocator_));
+      ASSERT_EQ(OB_SUCCESS, data_io_handle.wait());
+      ASSERT_EQ(OB_SUCCESS, data_block_cache_->get_cache_block(
+          MTL_ID(),
+          data_idx_info.get_macro_id(),
+          data_idx_info.get_block_offset(),
+          data_idx_info.get_block_size(),
+          data_buf_handle));
+      const ObMicroBlockData *cached_data = data_buf_handle.get_block_data();
+      ASSERT_EQ(loaded_micro_data.get_micro_header()->row_count_, cached_data->get_micro_header()->row_count_);
+      ASSERT_EQ(loaded_micro_data.get_micro_header()->original_length_,
+                cached_data->get_micro_header()->original_length_);
+    }
+  }
+  ASSERT_GT(dict_block_cnt, 0);
+
+  // the dict of the macro block is loaded into compress dict cache
+  ObCompressDictValueHandle dict_handle;
+  ASSERT_EQ(OB_SUCCESS, ObStorageCacheSuite::get_instance().get_compress_dict_cache().get_or_load_compress_dict(
+      MTL_ID(), micro_idx_infos.at(0).get_macro_id(), dict_handle));
+  const int64_t max_dict_size = ObMicroBlockCompressDictBuilder::MAX_DICT_SIZE;
+  ASSERT_TRUE(dict_handle.is_valid());
+  ASSERT_GT(dict_handle.get_dict().length(), 0);
+  ASSERT_LE(dict_handle.get_dict().length(), max_dict_size);
+}
+
+TEST_F(TestMicroBlockCompressDict, test_get_row)
+{
+  // rows of the micro blocks sampled into dict and the ones compressed with dict
+  test_one_rowkey(0);
+  test_one_rowkey(row_cnt_ / 4);
+  test_one_rowkey(row_cnt_ / 2);
+  test_one_rowkey(row_cnt_ - 1);
+}
+
+} // blocksstable
+} // oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_micro_block_compress_dict.log*");
+  OB_LOGGER.set_file_name("test_micro_block_compress_dict.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
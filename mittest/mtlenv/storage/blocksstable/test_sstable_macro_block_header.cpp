@@ -18,6 +18,7 @@
 #include "storage/blocksstable/ob_sstable_macro_block_header.h"
 #include "storage/blocksstable/ob_macro_block.h"
 #include "storage/blocksstable/ob_data_store_desc.h"
+#include "storage/compaction/ob_sstable_builder.h"
 
 using namespace oceanbase::blocksstable;
 
@@ -169,6 +170,64 @@ TEST_F(TestSSTableMacroBlockHeader, serialize_and_deserialize_compat)
   ASSERT_EQ(OB_INVALID_ARGUMENT, ret);
 }
 
+TEST_F(TestSSTableMacroBlockHeader, check_macro_block_movable)
+{
+  char buf[1024];
+  const int64_t buf_len = 1024;
+  int64_t pos = 0;
+  bool is_movable = false;
+  ObMacroBlockCommonHeader common_header;
+  common_header.set_attr(ObMacroBlockCommonHeader::SSTableData);
+  macro_header_.fixed_header_.row_count_ = 100;
+  macro_header_.fixed_header_.occupy_size_ = 400;
+  macro_header_.fixed_header_.micro_block_count_ = 1;
+  macro_header_.fixed_header_.micro_block_data_offset_ = 400;
+  macro_header_.fixed_header_.micro_block_data_size_ = 400;
+  ASSERT_EQ(OB_SUCCESS, common_header.serialize(buf, buf_len, pos));
+  ASSERT_EQ(OB_SUCCESS, macro_header_.serialize(buf, buf_len, pos));
+  ASSERT_EQ(OB_SUCCESS, compaction::ObSSTableBuilder::check_macro_block_movable(buf, buf_len, is_movable));
+  ASSERT_TRUE(is_movable);
+
+  // written with shared dict enabled, but no column references it
+  macro_header_.with_shared_dict_ = true;
+  macro_header_.fixed_header_.header_size_ += ObSSTableMacroBlockHeader::get_shared_dict_pos_size();
+  pos = common_header.get_serialize_size();
+  ASSERT_EQ(OB_SUCCESS, macro_header_.serialize(buf, buf_len, pos));
+  ASSERT_EQ(OB_SUCCESS, compaction::ObSSTableBuilder::check_macro_block_movable(buf, buf_len, is_movable));
+  ASSERT_TRUE(is_movable);
+
+  // micro blocks reference the shared dict stored in this macro block, whatever the config is now
+  macro_header_.shared_dict_offset_ = 800;
+  macro_header_.shared_dict_size_ = 100;
+  pos = common_header.get_serialize_size();
+  ASSERT_EQ(OB_SUCCESS, macro_header_.serialize(buf, buf_len, pos));
+  ASSERT_EQ(OB_SUCCESS, compaction::ObSSTableBuilder::check_macro_block_movable(buf, buf_len, is_movable));
+  ASSERT_FALSE(is_movable);
+
+  // micro blocks compressed with the compress dict stored in this macro block
+  macro_header_.with_shared_dict_ = false;
+  macro_header_.shared_dict_offset_ = 0;
+  macro_header_.shared_dict_size_ = 0;
+  macro_header_.with_compress_dict_ = true;
+  macro_header_.fixed_header_.header_size_ += ObSSTableMacroBlockHeader::get_compress_dict_pos_size();
+  pos = common_header.get_serialize_size();
+  ASSERT_EQ(OB_SUCCESS, macro_header_.serialize(buf, buf_len, pos));
+  ASSERT_EQ(OB_SUCCESS, compaction::ObSSTableBuilder::check_macro_block_movable(buf, buf_len, is_movable));
+  ASSERT_TRUE(is_movable);
+  macro_header_.compress_dict_offset_ = 800;
+  macro_header_.compress_dict_size_ = 100;
+  pos = common_header.get_serialize_size();
+  ASSERT_EQ(OB_SUCCESS, macro_header_.serialize(buf, buf_len, pos));
+  ASSERT_EQ(OB_SUCCESS, compaction::ObSSTableBuilder::check_macro_block_movable(buf, buf_len, is_movable));
+  ASSERT_FALSE(is_movable);
+
+  // only data macro blocks are rebuilt
+  common_header.set_attr(ObMacroBlockCommonHeader::SSTableIndex);
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, common_header.serialize(buf, buf_len, pos));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, compaction::ObSSTableBuilder::check_macro_block_movable(buf, buf_len, is_movable));
+}
+
 } // end namespace unittest
 } // end namespace oceanbase
 
@@ -41,6 +41,7 @@ public:
       const bool is_reverse_scan);
   void test_border(const bool is_reverse_scan);
   void test_normal(const bool is_reverse_scan);
+  void test_sorted_batch_case(const ObIArray<int64_t> &seeds, const bool expect_sorted_batch);
 
 protected:
   static const int64_t TEST_MULTI_GET_CNT = 2000;
@@ -350,6 +351,86 @@ void TestSSTableRowMultiGetter::test_normal(const bool is_reverse_scan)
   destroy_query_param();
 }
 
+void TestSSTableRowMultiGetter::test_sorted_batch_case(
+    const ObIArray<int64_t> &seeds,
+    const bool expect_sorted_batch)
+{
+  int ret = OB_SUCCESS;
+  ObArray<ObDatumRowkey> rowkeys;
+  const ObDatumRow *prow = NULL;
+  ObSSTableRowMultiGetter getter;
+  ObDatumRowkey mget_rowkeys[TEST_MULTI_GET_CNT];
+  for (int64_t i = 0; i < seeds.count(); ++i) {
+    ObDatumRowkey tmp_rowkey;
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(seeds.at(i), start_row_));
+    tmp_rowkey.assign(start_row_.storage_datums_, TEST_ROWKEY_COLUMN_CNT);
+    ASSERT_EQ(OB_SUCCESS, tmp_rowkey.deep_copy(mget_rowkeys[i], allocator_));
+    ASSERT_EQ(OB_SUCCESS, rowkeys.push_back(mget_rowkeys[i]));
+  }
+
+  // first round in io, second round in cache
+  for (int64_t round = 0; round < 2; ++round) {
+    ASSERT_EQ(OB_SUCCESS, getter.init(iter_param_, context_, &sstable_, &rowkeys));
+    ASSERT_EQ(expect_sorted_batch, getter.is_sorted_batch_);
+    ASSERT_EQ(expect_sorted_batch, getter.prefetcher_.is_rowkey_sorted_);
+    // rows are returned in the rowkey order of the caller
+    for (int64_t i = 0; i < seeds.count(); ++i) {
+      ret = getter.inner_get_next_row(prow);
+      ASSERT_EQ(OB_SUCCESS, ret);
+      if (seeds.at(i) >= row_cnt_) {
+        ASSERT_TRUE(prow->row_flag_.is_not_exist());
+      } else {
+        ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(seeds.at(i), check_row_));
+        ASSERT_TRUE(check_row_ == *prow);
+      }
+    }
+    ret = getter.inner_get_next_row(prow);
+    ASSERT_EQ(OB_ITER_END, ret);
+    getter.reuse();
+  }
+}
+
+TEST_F(TestSSTableRowMultiGetter, test_sorted_batch)
+{
+  ObArray<int64_t> seeds;
+  prepare_query_param(false);
+  // unordered multi get runs in sorted batch mode
+  context_.query_flag_.scan_order_ = ObQueryFlag::ImplementedOrder;
+
+  // too few rowkeys to sort
+  for (int64_t i = 0; i < ObSSTableRowMultiGetter::SORTED_BATCH_GET_MIN_ROWKEY_CNT - 1; ++i) {
+    ASSERT_EQ(OB_SUCCESS, seeds.push_back((i * 37) % row_cnt_));
+  }
+  test_sorted_batch_case(seeds, false);
+
+  // shuffled rowkeys, exist and not exist mixed
+  seeds.reuse();
+  for (int64_t i = 0; i < TEST_MULTI_GET_CNT; ++i) {
+    ASSERT_EQ(OB_SUCCESS, seeds.push_back(i + (i % 3 ? 0 : row_cnt_)));
+  }
+  std::random_shuffle(seeds.begin(), seeds.end());
+  test_sorted_batch_case(seeds, true);
+
+  // descending rowkeys with duplicates
+  seeds.reuse();
+  for (int64_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(OB_SUCCESS, seeds.push_back(row_cnt_ - 1 - (i / 2) * 5));
+  }
+  test_sorted_batch_case(seeds, true);
+
+  // all rowkeys not exist
+  seeds.reuse();
+  for (int64_t i = 0; i < 50; ++i) {
+    ASSERT_EQ(OB_SUCCESS, seeds.push_back(row_cnt_ + 50 - i));
+  }
+  test_sorted_batch_case(seeds, true);
+
+  // ordered multi get keeps the order of the caller
+  context_.query_flag_.scan_order_ = ObQueryFlag::Reverse;
+  test_sorted_batch_case(seeds, false);
+  destroy_query_param();
+}
+
 TEST_F(TestSSTableRowMultiGetter, test_border)
 {
   bool is_reverse_scan = false;
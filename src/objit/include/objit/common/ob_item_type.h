@@ -2543,6 +2543,7 @@ typedef enum ObItemType
   // select into outfile
   T_BUFFER_SIZE,
   T_PARTITION_EXPR,
+  T_COL_SKIP_INDEX_BLOOM_FILTER,
   T_MAX //Attention: add a new type before T_MAX
 } ObItemType;
 
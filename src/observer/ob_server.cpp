@@ -2925,6 +2925,15 @@ int ObServer::init_storage()
     }
   }
 
+  if (OB_SUCC(ret)) {
+    int tmp_ret = OB_SUCCESS;
+    // the flash cache is only an accelerator, the server works without it on failure
+    if (OB_TMP_FAIL(OB_STORE_CACHE.init_flash_cache(GCONF._micro_block_flash_cache_path.str(),
+                                                    GCONF._micro_block_flash_cache_size))) {
+      LOG_ERROR("fail to init micro block flash cache", KR(tmp_ret));
+    }
+  }
+
   if (OB_SUCC(ret)) {
     if (OB_FAIL(ObDDLCtrlSpeedHandle::get_instance().init())) {
       LOG_WARN("fail to init ObDDLCtrlSpeedHandle", KR(ret));
@@ -3145,6 +3154,8 @@ int ObServer::reload_config()
                                                    GCONF.bf_cache_priority,
                                                    GCONF.storage_meta_cache_priority))) {
     LOG_WARN("set cache priority fail, ", KR(ret));
+  } else if (OB_FAIL(OB_STORE_CACHE.set_block_cache_admission(GCONF._enable_block_cache_admission))) {
+    LOG_WARN("set block cache admission fail", KR(ret));
   } else if (OB_FAIL(reload_bandwidth_throttle_limit(ethernet_speed_))) {
     LOG_WARN("failed to reload_bandwidth_throttle_limit", KR(ret));
   }
@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_all_virtual_sql_expr_vector_fallback.h"
+#include "observer/ob_server.h"
+#include "sql/code_generator/ob_static_engine_expr_cg.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace sql;
+namespace observer
+{
+ObAllVirtualSqlExprVectorFallback::ObAllVirtualSqlExprVectorFallback()
+    : ObVirtualTableScannerIterator(),
+      cur_type_(T_MIN_OP + 1),
+      svr_port_(0)
+{
+  MEMSET(svr_ip_, 0, sizeof(svr_ip_));
+}
+
+ObAllVirtualSqlExprVectorFallback::~ObAllVirtualSqlExprVectorFallback()
+{
+  reset();
+}
+
+void ObAllVirtualSqlExprVectorFallback::reset()
+{
+  cur_type_ = T_MIN_OP + 1;
+  MEMSET(svr_ip_, 0, sizeof(svr_ip_));
+  svr_port_ = 0;
+  ObVirtualTableScannerIterator::reset();
+}
+
+int ObAllVirtualSqlExprVectorFallback::inner_open()
+{
+  int ret = OB_SUCCESS;
+  if (!start_to_read_) {
+    const common::ObAddr &svr_addr = ObServerConfig::get_instance().self_addr_;
+    if (OB_UNLIKELY(false == svr_addr.ip_to_string(svr_ip_, sizeof(svr_ip_)))) {
+      ret = OB_ERR_UNEXPECTED;
+      SERVER_LOG(WARN, "ip to string failed");
+    } else {
+      svr_port_ = svr_addr.get_port();
+      start_to_read_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObAllVirtualSqlExprVectorFallback::inner_get_next_row(common::ObNewRow *&row)
+{
+  int ret = OB_SUCCESS;
+  const ObExprVectorFallbackStat &stat = ObExprVectorFallbackStat::get_instance();
+  int64_t cnt = 0;
+  if (!start_to_read_) {
+    ret = OB_NOT_INIT;
+    SERVER_LOG(WARN, "not inited", K(ret));
+  } else {
+    // skip expr types never fallback
+    while (cur_type_ < T_MAX_OP
+           && 0 == (cnt = stat.get(static_cast<ObExprOperatorType>(cur_type_)))) {
+      cur_type_++;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (cur_type_ >= T_MAX_OP) {
+    ret = OB_ITER_END;
+  } else {
+    ObObj *cells = cur_row_.cells_;
+    if (OB_UNLIKELY(nullptr == cells)) {
+      ret = OB_ERR_UNEXPECTED;
+      SERVER_LOG(WARN, "cur row cell is NULL", K(ret));
+    } else {
+      for (int64_t i = 0; OB_SUCC(ret) && i < output_column_ids_.count(); i++) {
+        uint64_t col_id = output_column_ids_.at(i);
+        switch (col_id) {
+          case SVR_IP: {
+            cells[i].set_varchar(svr_ip_);
+            cells[i].set_collation_type(
+                ObCharset::get_default_collation(ObCharset::get_default_charset()));
+            break;
+          }
+          case SVR_PORT: {
+            cells[i].set_int(svr_port_);
+            break;
+          }
+          case EXPR_TYPE: {
+            cells[i].set_varchar(get_type_name(static_cast<int>(cur_type_)));
+            cells[i].set_collation_type(
+                ObCharset::get_default_collation(ObCharset::get_default_charset()));
+            break;
+          }
+          case FALLBACK_COUNT: {
+            cells[i].set_int(cnt);
+            break;
+          }
+          default: {
+            ret = OB_ERR_UNEXPECTED;
+            SERVER_LOG(WARN, "unexpected column id", K(col_id), K(i), K(ret));
+            break;
+          }
+        }
+      }
+      if (OB_SUCC(ret)) {
+        cur_type_++;
+        row = &cur_row_;
+      }
+    }
+  }
+  return ret;
+}
+
+} // namespace observer
+} // namespace oceanbase
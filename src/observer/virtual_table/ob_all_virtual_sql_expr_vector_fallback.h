@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_OBSERVER_VIRTUAL_TABLE_OB_ALL_VIRTUAL_SQL_EXPR_VECTOR_FALLBACK_
+#define OCEANBASE_OBSERVER_VIRTUAL_TABLE_OB_ALL_VIRTUAL_SQL_EXPR_VECTOR_FALLBACK_
+
+#include "share/ob_virtual_table_scanner_iterator.h"
+
+namespace oceanbase
+{
+namespace observer
+{
+// One row for every expr type which has been generated with the row by row default vector
+// evaluation function in rich format plans since the server started.
+class ObAllVirtualSqlExprVectorFallback : public common::ObVirtualTableScannerIterator
+{
+  enum COLUMN_ID_LIST
+  {
+    SVR_IP = common::OB_APP_MIN_COLUMN_ID,
+    SVR_PORT,
+    EXPR_TYPE,
+    FALLBACK_COUNT
+  };
+
+public:
+  ObAllVirtualSqlExprVectorFallback();
+  virtual ~ObAllVirtualSqlExprVectorFallback();
+  virtual void reset() override;
+  virtual int inner_open() override;
+  virtual int inner_get_next_row(common::ObNewRow *&row) override;
+private:
+  // next expr type to check
+  int64_t cur_type_;
+  char svr_ip_[common::MAX_IP_ADDR_LENGTH];
+  int32_t svr_port_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObAllVirtualSqlExprVectorFallback);
+};
+
+} // namespace observer
+} // namespace oceanbase
+
+#endif // OCEANBASE_OBSERVER_VIRTUAL_TABLE_OB_ALL_VIRTUAL_SQL_EXPR_VECTOR_FALLBACK_
@@ -177,6 +177,8 @@ int ObInfoSchemaKvCacheTable::set_diagnose_info(ObKVCacheInst *inst, ObDiagnoseT
     SERVER_LOG(WARN, "Unexpected null cache inst config", KP(inst->status_.config_));
   } else if (0 == strcmp(inst->status_.config_->cache_name_,"user_block_cache")) {
     inst->status_.total_miss_cnt_ = GLOBAL_EVENT_GET(ObStatEventIds::BLOCK_CACHE_MISS);
+  } else if (0 == strcmp(inst->status_.config_->cache_name_,"user_compressed_block_cache")) {
+    inst->status_.total_miss_cnt_ = GLOBAL_EVENT_GET(ObStatEventIds::COMPRESSED_BLOCK_CACHE_MISS);
   } else if (0 == strcmp(inst->status_.config_->cache_name_,"user_row_cache")) {
     inst->status_.total_miss_cnt_ = GLOBAL_EVENT_GET(ObStatEventIds::ROW_CACHE_MISS);
   } else if (0 == strcmp(inst->status_.config_->cache_name_,"bf_cache")) {
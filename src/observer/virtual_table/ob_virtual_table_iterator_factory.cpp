@@ -228,6 +228,7 @@
 #include "observer/virtual_table/ob_all_virtual_tenant_resource_limit_detail.h"
 #include "observer/virtual_table/ob_all_virtual_tracepoint_info.h"
 #include "observer/virtual_table/ob_all_virtual_nic_info.h"
+#include "observer/virtual_table/ob_all_virtual_sql_expr_vector_fallback.h"
 #include "observer/virtual_table/ob_all_virtual_sys_variable_default_value.h"
 #include "observer/virtual_table/ob_information_schema_enable_roles_table.h"
 #include "observer/virtual_table/ob_all_virtual_tenant_scheduler_running_job.h"
@@ -2711,6 +2712,15 @@ int ObVTIterCreator::create_vt_iter(ObVTableScanParam &params,
             }
             break;
           }
+          case OB_ALL_VIRTUAL_SQL_EXPR_VECTOR_FALLBACK_TID: {
+            ObAllVirtualSqlExprVectorFallback *expr_vector_fallback = NULL;
+            if (OB_FAIL(NEW_VIRTUAL_TABLE(ObAllVirtualSqlExprVectorFallback, expr_vector_fallback))) {
+              SERVER_LOG(ERROR, "failed to init ObAllVirtualSqlExprVectorFallback", K(ret));
+            } else {
+              vt_iter = static_cast<ObVirtualTableIterator *>(expr_vector_fallback);
+            }
+            break;
+          }
           case OB_ALL_VIRTUAL_STORAGE_HA_ERROR_DIAGNOSE_TID: {
             ObAllVirtualStorageHAErrorDiagnose *storage_ha_error_diagnose = NULL;
             if (OB_FAIL(NEW_VIRTUAL_TABLE(ObAllVirtualStorageHAErrorDiagnose, storage_ha_error_diagnose))) {
@@ -203,7 +203,7 @@ struct RuntimeContext
     eval_ctx_(eval_ctx),
     aggr_infos_(aggr_infos),
     allocator_(label, OB_MALLOC_NORMAL_BLOCK_SIZE, tenant_id, ObCtxIds::WORK_AREA),
-    op_monitor_info_(nullptr), io_event_observer_(nullptr), agg_row_meta_(),
+    op_monitor_info_(nullptr), io_event_observer_(nullptr), dir_id_(-1), agg_row_meta_(),
     agg_rows_(ModulePageAllocator(label, tenant_id, ObCtxIds::WORK_AREA)),
     agg_extras_(ModulePageAllocator(label, tenant_id, ObCtxIds::WORK_AREA)),
     removal_info_(), win_func_agg_(false)
@@ -332,6 +332,7 @@ struct RuntimeContext
     allocator_.reset();
     op_monitor_info_ = nullptr;
     io_event_observer_ = nullptr;
+    dir_id_ = -1;
     agg_row_meta_.reset();
     removal_info_.reset();
     win_func_agg_ = false;
@@ -358,6 +359,8 @@ struct RuntimeContext
   ObArenaAllocator allocator_;
   sql::ObMonitorNode *op_monitor_info_;
   sql::ObIOEventObserver *io_event_observer_;
+  // temp file directory of dumped extra rows
+  int64_t dir_id_;
   AggrRowMeta agg_row_meta_;
   ObSegmentArray<AggrRowPtr, OB_MALLOC_MIDDLE_BLOCK_SIZE, common::ModulePageAllocator>
     agg_rows_;
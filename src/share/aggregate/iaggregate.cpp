@@ -41,6 +41,10 @@ extern int init_approx_count_distinct_aggregate(RuntimeContext &agg_ctx, const i
                                                 ObIAllocator &allocator, IAggregate *&agg);
 extern int init_sysbit_aggregate(RuntimeContext &agg_ctx, const int64_t agg_col_id,
                                  ObIAllocator &allocator, IAggregate *&agg);
+extern int init_group_concat_aggregate(RuntimeContext &agg_ctx, const int64_t agg_col_id,
+                                       ObIAllocator &allocator, IAggregate *&agg);
+extern int init_percentile_aggregate(RuntimeContext &agg_ctx, const int64_t agg_col_id,
+                                     ObIAllocator &allocator, IAggregate *&agg);
 #define INIT_AGGREGATE_CASE(OP_TYPE, func_name, col_id)                                            \
   case (OP_TYPE): {                                                                                \
     ret = init_##func_name##_aggregate(agg_ctx, col_id, allocator, aggregate);                     \
@@ -76,6 +80,10 @@ int init_aggregates(RuntimeContext &agg_ctx, ObIAllocator &allocator,
         INIT_AGGREGATE_CASE(T_FUN_SYS_BIT_OR, sysbit, i);
         INIT_AGGREGATE_CASE(T_FUN_SYS_BIT_AND, sysbit, i);
         INIT_AGGREGATE_CASE(T_FUN_SYS_BIT_XOR, sysbit, i);
+        INIT_AGGREGATE_CASE(T_FUN_GROUP_CONCAT, group_concat, i);
+        INIT_AGGREGATE_CASE(T_FUN_MEDIAN, percentile, i);
+        INIT_AGGREGATE_CASE(T_FUN_GROUP_PERCENTILE_CONT, percentile, i);
+        INIT_AGGREGATE_CASE(T_FUN_GROUP_PERCENTILE_DISC, percentile, i);
       default: {
         ret = OB_NOT_SUPPORTED;
         SQL_LOG(WARN, "not supported aggregate function", K(ret), K(aggr_info.expr_->type_));
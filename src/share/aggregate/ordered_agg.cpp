@@ -0,0 +1,1027 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include "ordered_agg.h"
+#include "lib/utility/ob_sort.h"
+#include "sql/engine/expr/ob_rt_datum_arith.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "sql/engine/ob_sql_mem_mgr_processor.h"
+
+namespace oceanbase
+{
+namespace share
+{
+namespace aggregate
+{
+using namespace sql;
+using namespace common;
+using number::ObNumber;
+
+// ================ OrderedRowsExtra
+bool OrderedRowsExtra::Compare::operator()(const Record *l, const Record *r)
+{
+  bool less = false;
+  int &ret = ret_;
+  if (OB_FAIL(ret)) {
+    // already fail
+  } else {
+    int cmp = 0;
+    ObDatum l_datum;
+    ObDatum r_datum;
+    for (int64_t i = 0; 0 == cmp && OB_SUCC(ret) && i < aggr_info_.sort_collations_.count(); i++) {
+      const ObSortFieldCollation &sort_collation = aggr_info_.sort_collations_.at(i);
+      l->get_datum(sort_collation.field_idx_, l_datum);
+      r->get_datum(sort_collation.field_idx_, r_datum);
+      if (OB_FAIL(aggr_info_.sort_cmp_funcs_.at(i).cmp_func_(l_datum, r_datum, cmp))) {
+        LOG_WARN("compare failed", K(ret));
+      } else if (cmp < 0) {
+        less = sort_collation.is_ascending_;
+      } else if (cmp > 0) {
+        less = !sort_collation.is_ascending_;
+      }
+    }
+  }
+  return less;
+}
+
+namespace
+{
+// cells of a row in param vectors
+struct VectorCellGetter
+{
+  VectorCellGetter(ObIVector **param_vecs, const int64_t batch_idx) :
+    param_vecs_(param_vecs), batch_idx_(batch_idx)
+  {}
+  inline void operator()(const int64_t idx, bool &is_null, const char *&payload, ObLength &len)
+  {
+    param_vecs_[idx]->get_payload(batch_idx_, is_null, payload, len);
+  }
+  ObIVector **param_vecs_;
+  int64_t batch_idx_;
+};
+
+// cells of an in-memory record
+struct RecordCellGetter
+{
+  explicit RecordCellGetter(const OrderedRowsExtra::Record &record) : record_(record) {}
+  inline void operator()(const int64_t idx, bool &is_null, const char *&payload, ObLength &len)
+  {
+    is_null = record_.is_null(idx);
+    payload = is_null ? nullptr
+                      : reinterpret_cast<const char *>(&record_) + record_.cells_[idx].offset_;
+    len = is_null ? 0 : record_.cells_[idx].len_;
+  }
+  const OrderedRowsExtra::Record &record_;
+};
+} // end anonymous namespace
+
+int OrderedRowsExtra::add_row(ObIAllocator &allocator, ObIVector **param_vecs,
+                              const int64_t param_cnt, const int64_t batch_idx)
+{
+  int ret = OB_SUCCESS;
+  const int64_t header_size = sizeof(Record) + sizeof(Cell) * param_cnt;
+  int64_t row_size = header_size;
+  bool is_null = false;
+  const char *payload = nullptr;
+  ObLength len = 0;
+  Record *record = nullptr;
+  if (nullptr != spill_store_) {
+    VectorCellGetter getter(param_vecs, batch_idx);
+    if (OB_FAIL(add_spilled_row(param_cnt, getter, row_size))) {
+      LOG_WARN("add spilled row failed", K(ret), K(batch_idx));
+    } else {
+      row_cnt_++;
+      data_size_ += row_size;
+    }
+  } else {
+    for (int64_t i = 0; i < param_cnt; i++) {
+      param_vecs[i]->get_payload(batch_idx, is_null, payload, len);
+      row_size += (is_null ? 0 : len);
+    }
+    if (OB_ISNULL(record = static_cast<Record *>(allocator.alloc(row_size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(row_size));
+    } else {
+      int64_t offset = header_size;
+      for (int64_t i = 0; i < param_cnt; i++) {
+        param_vecs[i]->get_payload(batch_idx, is_null, payload, len);
+        if (is_null) {
+          record->cells_[i].len_ = -1;
+          record->cells_[i].offset_ = 0;
+        } else {
+          record->cells_[i].len_ = len;
+          record->cells_[i].offset_ = static_cast<int32_t>(offset);
+          MEMCPY(reinterpret_cast<char *>(record) + offset, payload, len);
+          offset += len;
+        }
+      }
+      record->next_ = head_;
+      head_ = record;
+      row_cnt_++;
+      data_size_ += row_size;
+    }
+  }
+  return ret;
+}
+
+int OrderedRowsExtra::prepare_row_buf(const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (size > row_buf_size_) {
+    const int64_t buf_size = max(size, row_buf_size_ * 2);
+    char *buf = nullptr;
+    if (OB_ISNULL(buf = static_cast<char *>(alloc_.alloc(buf_size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(buf_size));
+    } else {
+      if (nullptr != row_buf_) {
+        alloc_.free(row_buf_);
+      }
+      row_buf_ = buf;
+      row_buf_size_ = buf_size;
+    }
+  }
+  return ret;
+}
+
+// build a self-contained stored row in `row_buf_` and add it to `spill_store_`
+template <typename CellGetter>
+int OrderedRowsExtra::add_spilled_row(const int64_t param_cnt, CellGetter &getter,
+                                      int64_t &row_size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t header_size = sizeof(ObChunkDatumStore::StoredRow) + sizeof(ObDatum) * param_cnt;
+  bool is_null = false;
+  const char *payload = nullptr;
+  ObLength len = 0;
+  row_size = header_size;
+  for (int64_t i = 0; i < param_cnt; i++) {
+    getter(i, is_null, payload, len);
+    row_size += (is_null ? 0 : len);
+  }
+  if (OB_ISNULL(spill_store_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid null spill store", K(ret));
+  } else if (OB_FAIL(prepare_row_buf(row_size))) {
+    LOG_WARN("prepare row buffer failed", K(ret), K(row_size));
+  } else {
+    ObChunkDatumStore::StoredRow *sr = new (row_buf_) ObChunkDatumStore::StoredRow();
+    sr->cnt_ = static_cast<uint32_t>(param_cnt);
+    sr->row_size_ = static_cast<uint32_t>(row_size);
+    ObDatum *cells = sr->cells();
+    int64_t offset = header_size;
+    for (int64_t i = 0; i < param_cnt; i++) {
+      getter(i, is_null, payload, len);
+      if (is_null) {
+        new (&cells[i]) ObDatum();
+        cells[i].ptr_ = row_buf_ + offset;
+        cells[i].set_null();
+      } else {
+        MEMCPY(row_buf_ + offset, payload, len);
+        cells[i] = ObDatum(row_buf_ + offset, len, false);
+        offset += len;
+      }
+    }
+    if (OB_FAIL(spill_store_->add_row(*sr))) {
+      LOG_WARN("add row to spill store failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int OrderedRowsExtra::spill(const uint64_t tenant_id, const ObAggrInfo &aggr_info,
+                            ObEvalCtx &eval_ctx, const int64_t dir_id,
+                            ObIOEventObserver *io_event_observer, const int64_t param_cnt)
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  if (OB_UNLIKELY(nullptr != spill_store_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("rows already spilled", K(ret), KPC(this));
+  } else if (OB_ISNULL(buf = alloc_.alloc(sizeof(ObAggregateProcessor::GroupConcatExtraResult)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret));
+  } else {
+    spill_store_ = new (buf) ObAggregateProcessor::GroupConcatExtraResult(alloc_, op_monitor_info_);
+    // rows are iterated twice by group_concat
+    if (OB_FAIL(spill_store_->init(tenant_id, aggr_info, eval_ctx, true /* need_rewind */, dir_id,
+                                   io_event_observer))) {
+      LOG_WARN("init spill store failed", K(ret));
+    } else {
+      // records are linked in reverse order of adding, reverse them to keep the adding order
+      Record *prev = nullptr;
+      Record *cur = head_;
+      while (nullptr != cur) {
+        Record *next = cur->next_;
+        cur->next_ = prev;
+        prev = cur;
+        cur = next;
+      }
+      head_ = nullptr;
+      int64_t row_size = 0;
+      for (const Record *record = prev; OB_SUCC(ret) && nullptr != record; record = record->next_) {
+        RecordCellGetter getter(*record);
+        if (OB_FAIL(add_spilled_row(param_cnt, getter, row_size))) {
+          LOG_WARN("add spilled row failed", K(ret));
+        }
+      }
+    }
+    if (OB_FAIL(ret)) {
+      destroy_spill_store();
+    }
+  }
+  return ret;
+}
+
+void OrderedRowsExtra::destroy_spill_store()
+{
+  if (nullptr != spill_store_) {
+    spill_store_->~GroupConcatExtraResult();
+    alloc_.free(spill_store_);
+    spill_store_ = nullptr;
+  }
+}
+
+int OrderedRowsExtra::begin_iterate(ObIAllocator &allocator, const ObAggrInfo &aggr_info,
+                                    const bool need_sort, const int64_t param_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(row_cnt_ <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("no rows to iterate", K(ret), K(row_cnt_));
+  } else if (nullptr != spill_store_) {
+    // sort or finish adding rows only once, rewind for the following iterations
+    if (!iter_started_ && OB_FAIL(spill_store_->finish_add_row())) {
+      LOG_WARN("finish add row failed", K(ret));
+    } else if (iter_started_ && OB_FAIL(spill_store_->rewind())) {
+      LOG_WARN("rewind spill store failed", K(ret));
+    } else {
+      iter_started_ = true;
+    }
+  } else if (FALSE_IT(reset_iter())) {
+  } else if (OB_ISNULL(rows_ = static_cast<const Record **>(
+                         allocator.alloc(sizeof(Record *) * row_cnt_)))
+             || OB_ISNULL(cells_ = static_cast<ObDatum *>(
+                            allocator.alloc(sizeof(ObDatum) * param_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(row_cnt_), K(param_cnt));
+  } else {
+    // records are linked in reverse order of adding
+    int64_t idx = row_cnt_;
+    for (const Record *cur = head_; nullptr != cur && idx > 0; cur = cur->next_) {
+      rows_[--idx] = cur;
+    }
+    if (OB_UNLIKELY(0 != idx)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("record count mismatch", K(ret), K(idx), K(row_cnt_));
+    } else if (need_sort && row_cnt_ > 1) {
+      Compare cmp(aggr_info);
+      lib::ob_sort(rows_, rows_ + row_cnt_, cmp);
+      if (OB_FAIL(cmp.ret_)) {
+        LOG_WARN("sort rows failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      cell_cnt_ = param_cnt;
+      iter_started_ = true;
+    }
+  }
+  return ret;
+}
+
+int OrderedRowsExtra::get_next_row(const ObDatum *&cells)
+{
+  int ret = OB_SUCCESS;
+  if (nullptr != spill_store_) {
+    const ObChunkDatumStore::StoredRow *sr = nullptr;
+    if (OB_FAIL(spill_store_->get_next_row(sr))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get next row failed", K(ret));
+      }
+    } else if (OB_ISNULL(sr)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("invalid null stored row", K(ret));
+    } else {
+      cells = sr->cells();
+    }
+  } else if (OB_UNLIKELY(!iter_started_ || nullptr == rows_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("iterate not started", K(ret), KP(rows_));
+  } else if (iter_idx_ >= row_cnt_) {
+    ret = OB_ITER_END;
+  } else {
+    const Record *record = rows_[iter_idx_++];
+    for (int64_t i = 0; i < cell_cnt_; i++) {
+      record->get_datum(i, cells_[i]);
+    }
+    cells = cells_;
+  }
+  return ret;
+}
+
+int OrderedRowsExtra::rewind()
+{
+  int ret = OB_SUCCESS;
+  if (nullptr != spill_store_) {
+    if (OB_FAIL(spill_store_->rewind())) {
+      LOG_WARN("rewind spill store failed", K(ret));
+    }
+  } else {
+    iter_idx_ = 0;
+  }
+  return ret;
+}
+
+// ================ OrderedAggregate
+int OrderedAggregate::init(RuntimeContext &agg_ctx, const int64_t agg_col_id,
+                           ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  ObAggrInfo &aggr_info = agg_ctx.locate_aggr_info(agg_col_id);
+  ObSQLSessionInfo *session = agg_ctx.eval_ctx_.exec_ctx_.get_my_session();
+  param_cnt_ = aggr_info.param_exprs_.count();
+  if (OB_UNLIKELY(param_cnt_ <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid param count", K(ret), K(param_cnt_));
+  } else if (OB_ISNULL(session)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid null session", K(ret));
+  } else if (OB_FAIL(ObSqlWorkareaUtil::get_workarea_size(
+               SORT_WORK_AREA, session->get_effective_tenant_id(), &agg_ctx.eval_ctx_.exec_ctx_,
+               spill_threshold_))) {
+    LOG_WARN("failed to get workarea size", K(ret));
+  } else if (OB_ISNULL(param_vecs_ = static_cast<ObIVector **>(
+                         allocator.alloc(sizeof(ObIVector *) * param_cnt_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(param_cnt_));
+  } else {
+    MEMSET(param_vecs_, 0, sizeof(ObIVector *) * param_cnt_);
+  }
+  return ret;
+}
+
+int OrderedAggregate::get_extra(RuntimeContext &agg_ctx, const int32_t agg_col_id,
+                                char *agg_cell, OrderedRowsExtra *&extra)
+{
+  int ret = OB_SUCCESS;
+  ObAggregateProcessor::ExtraResult *&extra_res = agg_ctx.get_extra(agg_col_id, agg_cell);
+  if (OB_NOT_NULL(extra_res)) {
+    extra = static_cast<OrderedRowsExtra *>(extra_res);
+  } else {
+    void *buf = nullptr;
+    if (OB_ISNULL(agg_ctx.op_monitor_info_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("invalid null monitor info", K(ret));
+    } else if (OB_ISNULL(buf = agg_ctx.allocator_.alloc(sizeof(OrderedRowsExtra)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret));
+    } else {
+      extra = new (buf) OrderedRowsExtra(agg_ctx.allocator_, *agg_ctx.op_monitor_info_);
+      extra_res = extra;
+    }
+  }
+  return ret;
+}
+
+int OrderedAggregate::load_param_vecs(RuntimeContext &agg_ctx, const int32_t agg_col_id)
+{
+  int ret = OB_SUCCESS;
+  ObIArray<ObExpr *> &param_exprs = agg_ctx.locate_aggr_info(agg_col_id).param_exprs_;
+  if (OB_ISNULL(param_vecs_) || OB_UNLIKELY(param_exprs.count() != param_cnt_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid param vectors", K(ret), KP(param_vecs_), K(param_cnt_),
+             K(param_exprs.count()));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < param_cnt_; i++) {
+    if (OB_ISNULL(param_vecs_[i] = param_exprs.at(i)->get_vector(agg_ctx.eval_ctx_))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("invalid null param vector", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+int OrderedAggregate::add_row(RuntimeContext &agg_ctx, const int32_t agg_col_id,
+                              OrderedRowsExtra &extra, const int64_t batch_idx)
+{
+  int ret = OB_SUCCESS;
+  bool has_null = false;
+  for (int64_t i = null_check_start_; !has_null && i < null_check_end_; i++) {
+    has_null = param_vecs_[i]->is_null(batch_idx);
+  }
+  if (has_null) {
+    // ignore
+  } else if (OB_FAIL(extra.add_row(agg_ctx.allocator_, param_vecs_, param_cnt_, batch_idx))) {
+    LOG_WARN("add row failed", K(ret), K(batch_idx));
+  } else if (OB_LIKELY(extra.is_spilled() || extra.get_data_size() <= spill_threshold_)) {
+    // do nothing
+  } else if (OB_FAIL(spill_rows(agg_ctx, agg_col_id, extra))) {
+    LOG_WARN("spill rows failed", K(ret), K(extra), K(spill_threshold_));
+  }
+  return ret;
+}
+
+int OrderedAggregate::spill_rows(RuntimeContext &agg_ctx, const int32_t agg_col_id,
+                                 OrderedRowsExtra &extra)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &ctx = agg_ctx.eval_ctx_;
+  if (OB_ISNULL(ctx.exec_ctx_.get_my_session())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid null session", K(ret));
+  } else if (agg_ctx.dir_id_ < 0 && OB_FAIL(ObChunkStoreUtil::alloc_dir_id(agg_ctx.dir_id_))) {
+    LOG_WARN("failed to alloc dir id", K(ret));
+  } else if (OB_FAIL(extra.spill(ctx.exec_ctx_.get_my_session()->get_effective_tenant_id(),
+                                 agg_ctx.locate_aggr_info(agg_col_id), ctx, agg_ctx.dir_id_,
+                                 agg_ctx.io_event_observer_, param_cnt_))) {
+    LOG_WARN("spill rows failed", K(ret));
+  }
+  return ret;
+}
+
+int OrderedAggregate::add_batch_rows(RuntimeContext &agg_ctx, int32_t agg_col_id,
+                                     const sql::ObBitVector &skip, const sql::EvalBound &bound,
+                                     char *agg_cell, const RowSelector row_sel)
+{
+  int ret = OB_SUCCESS;
+  OrderedRowsExtra *extra = nullptr;
+  if (OB_FAIL(load_param_vecs(agg_ctx, agg_col_id))) {
+    LOG_WARN("load param vectors failed", K(ret));
+  } else if (OB_FAIL(get_extra(agg_ctx, agg_col_id, agg_cell, extra))) {
+    LOG_WARN("get extra failed", K(ret));
+  } else if (!row_sel.is_empty()) {
+    for (int i = 0; OB_SUCC(ret) && i < row_sel.size(); i++) {
+      ret = add_row(agg_ctx, agg_col_id, *extra, row_sel.index(i));
+    }
+  } else if (bound.get_all_rows_active()) {
+    for (int i = bound.start(); OB_SUCC(ret) && i < bound.end(); i++) {
+      ret = add_row(agg_ctx, agg_col_id, *extra, i);
+    }
+  } else {
+    for (int i = bound.start(); OB_SUCC(ret) && i < bound.end(); i++) {
+      if (skip.at(i)) {
+      } else {
+        ret = add_row(agg_ctx, agg_col_id, *extra, i);
+      }
+    }
+  }
+  return ret;
+}
+
+int OrderedAggregate::add_batch_for_multi_groups(RuntimeContext &agg_ctx, AggrRowPtr *agg_rows,
+                                                 RowSelector &row_sel, const int64_t batch_size,
+                                                 const int32_t agg_col_id)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(batch_size);
+  OrderedRowsExtra *extra = nullptr;
+  if (OB_FAIL(load_param_vecs(agg_ctx, agg_col_id))) {
+    LOG_WARN("load param vectors failed", K(ret));
+  }
+  for (int i = 0; OB_SUCC(ret) && i < row_sel.size(); i++) {
+    const int64_t batch_idx = row_sel.index(i);
+    char *agg_cell = agg_ctx.row_meta().locate_cell_payload(agg_col_id, agg_rows[batch_idx]);
+    if (OB_FAIL(get_extra(agg_ctx, agg_col_id, agg_cell, extra))) {
+      LOG_WARN("get extra failed", K(ret));
+    } else if (OB_FAIL(add_row(agg_ctx, agg_col_id, *extra, batch_idx))) {
+      LOG_WARN("add row failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int OrderedAggregate::add_one_row(RuntimeContext &agg_ctx, const int64_t batch_idx,
+                                  const int64_t batch_size, const bool is_null, const char *data,
+                                  const int32_t data_len, int32_t agg_col_id, char *agg_cell)
+{
+  // all params are read from param vectors
+  int ret = OB_SUCCESS;
+  UNUSEDx(batch_size, is_null, data, data_len);
+  OrderedRowsExtra *extra = nullptr;
+  if (OB_FAIL(load_param_vecs(agg_ctx, agg_col_id))) {
+    LOG_WARN("load param vectors failed", K(ret));
+  } else if (OB_FAIL(get_extra(agg_ctx, agg_col_id, agg_cell, extra))) {
+    LOG_WARN("get extra failed", K(ret));
+  } else if (OB_FAIL(add_row(agg_ctx, agg_col_id, *extra, batch_idx))) {
+    LOG_WARN("add row failed", K(ret));
+  }
+  return ret;
+}
+
+int OrderedAggregate::collect_group_result(RuntimeContext &agg_ctx, const int32_t agg_col_id,
+                                           const char *agg_cell, const int64_t output_idx)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &ctx = agg_ctx.eval_ctx_;
+  ObAggrInfo &aggr_info = agg_ctx.locate_aggr_info(agg_col_id);
+  ObAggregateProcessor::ExtraResult *extra_res = agg_ctx.get_extra(agg_col_id, agg_cell);
+  OrderedRowsExtra *extra = static_cast<OrderedRowsExtra *>(extra_res);
+  if (nullptr == extra || extra->empty()) {
+    aggr_info.expr_->get_vector(ctx)->set_null(output_idx);
+  } else {
+    ObEvalCtx::TempAllocGuard alloc_guard(ctx);
+    if (OB_FAIL(extra->begin_iterate(alloc_guard.get_allocator(), aggr_info, need_sort_,
+                                     param_cnt_))) {
+      LOG_WARN("begin iterate failed", K(ret));
+    } else if (OB_FAIL(collect_rows(agg_ctx, agg_col_id, *extra, output_idx))) {
+      LOG_WARN("collect rows failed", K(ret), KPC(extra));
+    }
+  }
+  return ret;
+}
+
+int OrderedAggregate::collect_batch_group_results(RuntimeContext &agg_ctx,
+                                                  const int32_t agg_col_id,
+                                                  const int32_t cur_group_id,
+                                                  const int32_t output_start_idx,
+                                                  const int32_t expect_batch_size,
+                                                  int32_t &output_size, const ObBitVector *skip)
+{
+  int ret = OB_SUCCESS;
+  ObExpr &agg_expr = *agg_ctx.locate_aggr_info(agg_col_id).expr_;
+  int32_t loop_cnt =
+    min(expect_batch_size, static_cast<int32_t>(agg_ctx.agg_rows_.count()) - cur_group_id);
+  if (loop_cnt <= 0) {
+    LOG_DEBUG("no need to collect", K(ret), K(agg_ctx.agg_rows_.count()), K(cur_group_id));
+  } else if (OB_FAIL(agg_expr.init_vector_for_write(
+               agg_ctx.eval_ctx_, agg_expr.get_default_res_format(), expect_batch_size))) {
+    LOG_WARN("init vector for write failed", K(ret));
+  } else {
+    output_size = 0;
+    ObEvalCtx::BatchInfoScopeGuard guard(agg_ctx.eval_ctx_);
+    const char *agg_cell = nullptr;
+    int32_t agg_cell_len = 0;
+    for (int i = 0; OB_SUCC(ret) && i < loop_cnt; i++) {
+      if (skip != nullptr && skip->at(output_start_idx + i)) { continue; }
+      guard.set_batch_idx(output_start_idx + i);
+      agg_ctx.get_agg_payload(agg_col_id, cur_group_id + i, agg_cell, agg_cell_len);
+      if (OB_FAIL(collect_group_result(agg_ctx, agg_col_id, agg_cell, output_start_idx + i))) {
+        LOG_WARN("collect group result failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      output_size = loop_cnt;
+    }
+  }
+  return ret;
+}
+
+int OrderedAggregate::collect_batch_group_results(RuntimeContext &agg_ctx,
+                                                  const int32_t agg_col_id,
+                                                  const int32_t output_start_idx,
+                                                  const int32_t batch_size,
+                                                  const ObCompactRow **rows,
+                                                  const RowMeta &row_meta)
+{
+  int ret = OB_SUCCESS;
+  ObExpr &agg_expr = *agg_ctx.locate_aggr_info(agg_col_id).expr_;
+  if (OB_UNLIKELY(batch_size <= 0)) {
+  } else if (OB_ISNULL(rows)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid null rows", K(ret));
+  } else if (OB_FAIL(agg_expr.init_vector_for_write(
+               agg_ctx.eval_ctx_, agg_expr.get_default_res_format(), batch_size))) {
+    LOG_WARN("init vector for write failed", K(ret));
+  } else {
+    ObEvalCtx::BatchInfoScopeGuard guard(agg_ctx.eval_ctx_);
+    for (int i = 0; OB_SUCC(ret) && i < batch_size; i++) {
+      guard.set_batch_idx(output_start_idx + i);
+      if (OB_ISNULL(rows[i])) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("invalid compact row", K(ret), K(i));
+      } else {
+        const char *agg_row = static_cast<const char *>(rows[i]->get_extra_payload(row_meta));
+        const char *agg_cell = agg_ctx.row_meta().locate_cell_payload(agg_col_id, agg_row);
+        if (OB_FAIL(collect_group_result(agg_ctx, agg_col_id, agg_cell, output_start_idx + i))) {
+          LOG_WARN("collect group result failed", K(ret));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int OrderedAggregate::set_result(RuntimeContext &agg_ctx, const ObExpr &agg_expr,
+                                 const int64_t output_idx, const ObDatum &res)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &ctx = agg_ctx.eval_ctx_;
+  ObIVector *res_vec = agg_expr.get_vector(ctx);
+  if (res.is_null()) {
+    res_vec->set_null(output_idx);
+  } else if (VEC_FIXED == agg_expr.get_format(ctx)) {
+    res_vec->set_payload(output_idx, res.ptr_, res.len_);
+  } else {
+    char *res_buf = nullptr;
+    if (res.len_ > 0
+        && OB_ISNULL(res_buf = agg_expr.get_str_res_mem(ctx, res.len_, output_idx))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(res.len_));
+    } else {
+      if (res.len_ > 0) {
+        MEMCPY(res_buf, res.ptr_, res.len_);
+      }
+      res_vec->set_payload_shallow(output_idx, res_buf, res.len_);
+    }
+  }
+  return ret;
+}
+
+// ================ GroupConcatAggregate
+int GroupConcatAggregate::init(RuntimeContext &agg_ctx, const int64_t agg_col_id,
+                               ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  ObAggrInfo &aggr_info = agg_ctx.locate_aggr_info(agg_col_id);
+  ObSQLSessionInfo *session = agg_ctx.eval_ctx_.exec_ctx_.get_my_session();
+  concat_max_len_ = (lib::is_oracle_mode() ? OB_DEFAULT_GROUP_CONCAT_MAX_LEN_FOR_ORACLE
+                                           : OB_DEFAULT_GROUP_CONCAT_MAX_LEN);
+  if (OB_FAIL(OrderedAggregate::init(agg_ctx, agg_col_id, allocator))) {
+    LOG_WARN("init ordered aggregate failed", K(ret));
+  } else if (OB_UNLIKELY(aggr_info.group_concat_param_count_ <= 0
+                         || aggr_info.group_concat_param_count_ > param_cnt_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid group concat param count", K(ret), K(aggr_info.group_concat_param_count_),
+             K(param_cnt_));
+  } else if (OB_ISNULL(session)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid null session", K(ret));
+  } else if (!lib::is_oracle_mode()
+             && OB_FAIL(session->get_group_concat_max_len(concat_max_len_))) {
+    LOG_WARN("fail to get group concat max len", K(ret));
+  } else {
+    // item is skipped if any concat param is null
+    null_check_start_ = 0;
+    null_check_end_ = aggr_info.group_concat_param_count_;
+    need_sort_ = aggr_info.has_order_by_ && !aggr_info.sort_collations_.empty();
+  }
+  return ret;
+}
+
+int GroupConcatAggregate::append_str(const ObString &str, const ObCollationType cs_type,
+                                     const int64_t item_cnt, char *buf, int64_t &pos,
+                                     bool &buf_is_full)
+{
+  int ret = OB_SUCCESS;
+  int64_t append_len = str.length();
+  if (pos + append_len > static_cast<int64_t>(concat_max_len_)) {
+    append_len = concat_max_len_ - pos;
+    buf_is_full = true;
+    if (lib::is_oracle_mode()) {
+      ret = OB_ERR_TOO_LONG_STRING_IN_CONCAT;
+      LOG_WARN("result of string concatenation is too long", K(ret), K(str.length()), K(pos),
+               K(concat_max_len_));
+    } else {
+      int64_t well_formed_len = 0;
+      int32_t well_formed_error = 0;
+      if (OB_FAIL(ObCharset::well_formed_len(cs_type, str.ptr(), append_len, well_formed_len,
+                                             well_formed_error))) {
+        LOG_WARN("invalid string for charset", K(ret), K(cs_type), K(str));
+      } else {
+        append_len = well_formed_len;
+        LOG_USER_WARN(OB_ERR_CUT_VALUE_GROUP_CONCAT, item_cnt + 1);
+      }
+    }
+  }
+  if (OB_SUCC(ret) && append_len > 0) {
+    MEMCPY(buf + pos, str.ptr(), append_len);
+    pos += append_len;
+  }
+  return ret;
+}
+
+int GroupConcatAggregate::collect_rows(RuntimeContext &agg_ctx, const int32_t agg_col_id,
+                                       OrderedRowsExtra &extra, const int64_t output_idx)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &ctx = agg_ctx.eval_ctx_;
+  ObAggrInfo &aggr_info = agg_ctx.locate_aggr_info(agg_col_id);
+  const ObCollationType cs_type = aggr_info.expr_->datum_meta_.cs_type_;
+  const int64_t concat_param_cnt = aggr_info.group_concat_param_count_;
+  const int64_t row_cnt = extra.get_row_count();
+  const ObDatum *cells = nullptr;
+  ObString sep_str;
+  if (nullptr != aggr_info.separator_expr_) {
+    ObDatum *sep_datum = nullptr;
+    if (OB_FAIL(aggr_info.separator_expr_->eval(ctx, sep_datum))) {
+      LOG_WARN("eval separator failed", K(ret));
+    } else if (!sep_datum->is_null()) {
+      sep_str = sep_datum->get_string();
+    }
+  } else if (lib::is_oracle_mode()) {
+    sep_str = ObString::make_empty_string();
+  } else {
+    sep_str = ObCharsetUtils::get_const_str(cs_type, ',');
+  }
+  // iterate rows twice to allocate the result buffer once, stop counting once the max length is
+  // reached.
+  int64_t total_len = sep_str.length() * (row_cnt - 1);
+  while (OB_SUCC(ret) && total_len < static_cast<int64_t>(concat_max_len_)
+         && OB_SUCC(extra.get_next_row(cells))) {
+    for (int64_t j = 0; j < concat_param_cnt; j++) {
+      total_len += cells[j].len_;
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+  }
+  total_len = min(total_len, static_cast<int64_t>(concat_max_len_));
+  char *buf = nullptr;
+  int64_t pos = 0;
+  bool buf_is_full = false;
+  int64_t item_cnt = 0;
+  if (OB_FAIL(ret)) {
+  } else if (total_len > 0
+             && OB_ISNULL(buf = aggr_info.expr_->get_str_res_mem(ctx, total_len, output_idx))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(total_len));
+  } else if (OB_FAIL(extra.rewind())) {
+    LOG_WARN("rewind rows failed", K(ret));
+  }
+  while (OB_SUCC(ret) && !buf_is_full && OB_SUCC(extra.get_next_row(cells))) {
+    if (item_cnt > 0 && OB_FAIL(append_str(sep_str, cs_type, item_cnt, buf, pos, buf_is_full))) {
+      LOG_WARN("append separator failed", K(ret));
+    }
+    for (int64_t j = 0; OB_SUCC(ret) && !buf_is_full && j < concat_param_cnt; j++) {
+      if (OB_FAIL(append_str(cells[j].get_string(), cs_type, item_cnt, buf, pos, buf_is_full))) {
+        LOG_WARN("append item failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      item_cnt++;
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+  }
+  if (OB_SUCC(ret)) {
+    // rows with null items are not stored, at least one item is printed.
+    aggr_info.expr_->get_vector(ctx)->set_payload_shallow(output_idx, buf, pos);
+  }
+  return ret;
+}
+
+// ================ PercentileAggregate
+int PercentileAggregate::init(RuntimeContext &agg_ctx, const int64_t agg_col_id,
+                              ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  ObAggrInfo &aggr_info = agg_ctx.locate_aggr_info(agg_col_id);
+  if (OB_FAIL(OrderedAggregate::init(agg_ctx, agg_col_id, allocator))) {
+    LOG_WARN("init ordered aggregate failed", K(ret));
+  } else if (OB_UNLIKELY(1 != aggr_info.sort_collations_.count()
+                         || 1 != aggr_info.sort_cmp_funcs_.count()
+                         || aggr_info.sort_collations_.at(0).field_idx_ >= param_cnt_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected sort_collations/param_exprs count", K(ret),
+             K(aggr_info.sort_collations_.count()), K(param_cnt_));
+  } else {
+    order_idx_ = aggr_info.sort_collations_.at(0).field_idx_;
+    // null order values are ignored
+    null_check_start_ = order_idx_;
+    null_check_end_ = order_idx_ + 1;
+    need_sort_ = true;
+  }
+  return ret;
+}
+
+void PercentileAggregate::destroy()
+{
+  if (nullptr != linear_inter_) {
+    linear_inter_->~ObRTDatumArith();
+    linear_inter_ = nullptr;
+  }
+  OrderedAggregate::destroy();
+}
+
+// same as ObAggregateProcessor::get_percentile_param(), but `dest_idx` is the index of sorted
+// non-null rows
+int PercentileAggregate::get_percentile_param(const ObAggrInfo &aggr_info, const ObDatum &param,
+                                              const int64_t row_cnt, int64_t &dest_idx,
+                                              bool &need_linear_inter, ObNumber &factor,
+                                              ObDataBuffer &allocator)
+{
+  int ret = OB_SUCCESS;
+  need_linear_inter = false;
+  int64_t scale = 0;
+  int64_t int64_value = 0;
+  char buf_alloc[ObNumber::MAX_CALC_BYTE_LEN * 5];
+  ObDataBuffer local_allocator(buf_alloc, ObNumber::MAX_CALC_BYTE_LEN * 5);
+  const ObDatumMeta param_datum_meta = aggr_info.param_exprs_.at(0)->datum_meta_;
+  ObNumber percentile;
+  if (!ob_is_number_tc(param_datum_meta.type_) || param.is_null()) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("percentile value invalid", K(ret), K(param_datum_meta), K(param));
+  } else if (OB_FAIL(percentile.from(ObNumber(param.get_number()), local_allocator))) {
+    LOG_WARN("failed to create number percentile", K(ret));
+  } else if (percentile.is_negative() || 0 < percentile.compare(ObNumber::get_positive_one())) {
+    ret = OB_ERR_PERCENTILE_VALUE_INVALID;
+    LOG_WARN("invalid percentile value", K(ret), K(percentile));
+  } else if (T_FUN_GROUP_PERCENTILE_DISC == aggr_info.get_expr_type()) {
+    // dest_idx = ceil(N * P) - 1, read the first row if P = 0
+    ObNumber row_count, rn;
+    if (percentile.is_zero()) {
+      dest_idx = 0;
+    } else if (OB_FAIL(row_count.from(row_cnt, local_allocator))) {
+      LOG_WARN("failed to create number", K(ret));
+    } else if (OB_FAIL(percentile.mul(row_count, rn, local_allocator, false))) {
+      LOG_WARN("failed to calc number mul", K(ret));
+    } else if (OB_FAIL(rn.ceil(scale))) {
+      LOG_WARN("failed to ceil number", K(ret));
+    } else if (!rn.is_int64()) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("failed to get int64 after ceil", K(ret));
+    } else if (OB_FAIL(rn.cast_to_int64(int64_value))) {
+      LOG_WARN("failed to cast to int64", K(ret), K(rn));
+    } else {
+      dest_idx = int64_value - 1;
+    }
+  } else if (T_FUN_GROUP_PERCENTILE_CONT == aggr_info.get_expr_type()) {
+    // RN = P * (N - 1), dest_idx = floor(RN), factor = RN - floor(RN)
+    ObNumber row_count, rn, frn, res;
+    if (OB_FAIL(row_count.from(row_cnt - 1, local_allocator))) {
+      LOG_WARN("failed to create number", K(ret));
+    } else if (OB_FAIL(percentile.mul(row_count, rn, local_allocator, false))) {
+      LOG_WARN("failed to calc number mul", K(ret));
+    } else if (OB_FAIL(frn.from(rn, local_allocator))) {
+      LOG_WARN("failed to create number", K(ret));
+    } else if (OB_FAIL(frn.floor(scale))) {
+      LOG_WARN("failed to floor number", K(ret));
+    } else if (OB_FAIL(rn.sub(frn, res, local_allocator))) {
+      LOG_WARN("failed to calc number sub", K(ret));
+    } else if (!frn.is_int64()) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("failed to get int64 after floor", K(ret));
+    } else if (OB_FAIL(frn.cast_to_int64(int64_value))) {
+      LOG_WARN("failed to cast to int64", K(ret), K(rn));
+    } else if (OB_FAIL(factor.from(res, allocator))) {
+      LOG_WARN("failed to create number", K(ret));
+    } else {
+      need_linear_inter = !rn.is_integer();
+      dest_idx = int64_value;
+    }
+  } else {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected aggr function type", K(ret), K(aggr_info.get_expr_type()));
+  }
+  return ret;
+}
+
+// same as ObAggregateProcessor::linear_inter_calc(), res = factor * (curr - prev) + prev
+int PercentileAggregate::linear_inter_calc(RuntimeContext &agg_ctx, const ObAggrInfo &aggr_info,
+                                           const ObDatum &prev_datum, const ObDatum &curr_datum,
+                                           const ObNumber &factor, ObDatum &res)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &ctx = agg_ctx.eval_ctx_;
+  ObExpr *order_expr = aggr_info.param_exprs_.at(order_idx_);
+  res.set_null();
+  if (OB_UNLIKELY(T_QUESTIONMARK == order_expr->type_)) {
+    res.set_datum(curr_datum);
+  } else {
+    if (nullptr == linear_inter_) {
+      ObRTDatumArith *arith = nullptr;
+      ObDatumMeta factor_meta;
+      factor_meta.type_ = ObNumberType;
+      factor_meta.cs_type_ = CS_TYPE_BINARY;
+      factor_meta.scale_ =
+        ObAccuracy::DDL_DEFAULT_ACCURACY2[ORACLE_MODE][ObNumberType].get_scale();
+      factor_meta.precision_ =
+        ObAccuracy::DDL_DEFAULT_ACCURACY2[ORACLE_MODE][ObNumberType].get_precision();
+      if (OB_ISNULL(ctx.exec_ctx_.get_my_session())) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("invalid null session", K(ret));
+      } else if (OB_ISNULL(arith = OB_NEWx(ObRTDatumArith, (&ctx.exec_ctx_.get_allocator()),
+                                           ctx.exec_ctx_, *ctx.exec_ctx_.get_my_session()))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate memory failed", K(ret));
+      } else if (OB_FAIL(arith->setup_datum_metas(factor_meta /* factor meta */,
+                                                   order_expr->datum_meta_ /* prev meta */,
+                                                   order_expr->datum_meta_ /* cur meta */))) {
+        LOG_WARN("setup datum metas failed", K(ret));
+      } else {
+        auto factor_item = arith->ref(0);
+        auto prev_item = arith->ref(1);
+        auto cur_item = arith->ref(2);
+        if (OB_FAIL(arith->generate(factor_item * (cur_item - prev_item) + prev_item))) {
+          LOG_WARN("generate arithmetic expression failed", K(ret));
+        } else if (OB_ISNULL(arith->get_expr())) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("no runtime expr generated", K(ret));
+        } else if (order_expr->datum_meta_.type_ != arith->get_expr()->datum_meta_.type_) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("result meta miss match", K(ret), K(*order_expr), K(*arith->get_expr()));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        linear_inter_ = arith;
+      } else if (nullptr != arith) {
+        arith->~ObRTDatumArith();
+      }
+    }
+    if (OB_SUCC(ret)) {
+      char factor_nmb_buf[OBJ_DATUM_NUMBER_RES_SIZE];
+      ObDatum factor_datum;
+      factor_datum.ptr_ = factor_nmb_buf;
+      factor_datum.set_number(factor);
+      ObDatum *eval_res = nullptr;
+      if (OB_FAIL(linear_inter_->eval(eval_res, factor_datum, prev_datum, curr_datum))) {
+        LOG_WARN("runtime datum arithmetic evaluate failed", K(ret));
+      } else if (OB_ISNULL(eval_res)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("eval result is NULL", K(ret));
+      } else {
+        res = *eval_res;
+      }
+    }
+  }
+  return ret;
+}
+
+int PercentileAggregate::collect_rows(RuntimeContext &agg_ctx, const int32_t agg_col_id,
+                                      OrderedRowsExtra &extra, const int64_t output_idx)
+{
+  int ret = OB_SUCCESS;
+  ObAggrInfo &aggr_info = agg_ctx.locate_aggr_info(agg_col_id);
+  char buf_alloc[ObNumber::MAX_CALC_BYTE_LEN];
+  ObDataBuffer allocator(buf_alloc, ObNumber::MAX_CALC_BYTE_LEN);
+  ObNumber factor;
+  bool need_linear_inter = false;
+  const int64_t row_cnt = extra.get_row_count();
+  int64_t dest_idx = 0;
+  const ObDatum *cells = nullptr;
+  ObDatum res;
+  if (OB_FAIL(extra.get_next_row(cells))) {
+    LOG_WARN("get first row failed", K(ret));
+  } else if (T_FUN_MEDIAN == aggr_info.get_expr_type()) {
+    dest_idx = (row_cnt - 1) / 2;
+    if (0 == row_cnt % 2) {
+      need_linear_inter = true;
+      if (OB_FAIL(factor.from(ObNumber::get_positive_zero_dot_five(), allocator))) {
+        LOG_WARN("failed to create number", K(ret));
+      }
+    }
+  } else if (OB_FAIL(get_percentile_param(aggr_info, cells[0], row_cnt, dest_idx,
+                                          need_linear_inter, factor, allocator))) {
+    LOG_WARN("get linear inter factor", K(ret), K(factor));
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_UNLIKELY(dest_idx < 0 || dest_idx >= row_cnt
+                         || (need_linear_inter && dest_idx + 1 >= row_cnt))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid dest row", K(ret), K(dest_idx), K(row_cnt), K(need_linear_inter));
+  }
+  // sorted rows are iterated, the first row is already read.
+  for (int64_t i = 0; OB_SUCC(ret) && i < dest_idx; i++) {
+    if (OB_FAIL(extra.get_next_row(cells))) {
+      LOG_WARN("get next row failed", K(ret), K(i), K(dest_idx));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (need_linear_inter) {
+    // cells are invalid after getting next row, copy the previous datum.
+    ObEvalCtx::TempAllocGuard alloc_guard(agg_ctx.eval_ctx_);
+    ObDatum prev_datum;
+    if (OB_FAIL(prev_datum.deep_copy(cells[order_idx_], alloc_guard.get_allocator()))) {
+      LOG_WARN("deep copy datum failed", K(ret));
+    } else if (OB_FAIL(extra.get_next_row(cells))) {
+      LOG_WARN("get next row failed", K(ret), K(dest_idx));
+    } else if (OB_FAIL(linear_inter_calc(agg_ctx, aggr_info, prev_datum, cells[order_idx_],
+                                         factor, res))) {
+      LOG_WARN("failed to calc linear inter", K(ret), K(prev_datum), K(factor));
+    } else if (OB_FAIL(set_result(agg_ctx, *aggr_info.expr_, output_idx, res))) {
+      LOG_WARN("set result failed", K(ret));
+    }
+  } else if (OB_FAIL(set_result(agg_ctx, *aggr_info.expr_, output_idx, cells[order_idx_]))) {
+    LOG_WARN("set result failed", K(ret));
+  }
+  return ret;
+}
+
+namespace helper
+{
+int init_group_concat_aggregate(RuntimeContext &agg_ctx, const int64_t agg_col_id,
+                                ObIAllocator &allocator, IAggregate *&agg)
+{
+  return init_agg_func<GroupConcatAggregate>(agg_ctx, agg_col_id, allocator, agg);
+}
+
+int init_percentile_aggregate(RuntimeContext &agg_ctx, const int64_t agg_col_id,
+                              ObIAllocator &allocator, IAggregate *&agg)
+{
+  return init_agg_func<PercentileAggregate>(agg_ctx, agg_col_id, allocator, agg);
+}
+} // end namespace helper
+} // end namespace aggregate
+} // end namespace share
+} // end namespace oceanbase
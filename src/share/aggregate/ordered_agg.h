@@ -0,0 +1,289 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SHARE_AGGREGATE_ORDERED_AGG_H_
+#define OCEANBASE_SHARE_AGGREGATE_ORDERED_AGG_H_
+
+#include "share/aggregate/iaggregate.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+class ObRTDatumArith;
+}
+namespace share
+{
+namespace aggregate
+{
+// Param rows of one group for aggregates which need all rows of the group to calculate the
+// result, e.g. GROUP_CONCAT, MEDIAN and PERCENTILE_CONT/PERCENTILE_DISC.
+//
+// Every added row is serialized into one flat record allocated from `agg_ctx.allocator_`:
+//
+//   | next record | <len, offset> of param 0 ... param n-1 | payload of param 0 ... param n-1 |
+//
+// len is -1 for null cell and offset is relative to the start of the record. Records do not refer
+// to the param vectors, so they are independent of the input format, and the memory of records is
+// counted in `Processor::get_aggr_used_size()` which drives the dumping of hash group by.
+// Rows are sorted only once when the group result is collected.
+//
+// Dumping of hash group by can not bound the size of one group, so once the records of a group
+// exceed `spill_threshold_` of the aggregate, they are moved into a `GroupConcatExtraResult`, the
+// dumpable row store (or sort operator for ordered aggregates) of the non-vectorized operators,
+// and the following rows of the group are added to it directly.
+class OrderedRowsExtra final : public ObAggregateProcessor::ExtraResult
+{
+public:
+  struct Cell
+  {
+    int32_t len_;
+    int32_t offset_;
+  };
+  struct Record
+  {
+    inline bool is_null(const int64_t idx) const { return cells_[idx].len_ < 0; }
+    inline void get_datum(const int64_t idx, ObDatum &datum) const
+    {
+      if (is_null(idx)) {
+        datum.set_null();
+      } else {
+        datum = ObDatum(reinterpret_cast<const char *>(this) + cells_[idx].offset_,
+                        static_cast<uint32_t>(cells_[idx].len_), false);
+      }
+    }
+    inline ObString get_string(const int64_t idx) const
+    {
+      return is_null(idx) ? ObString()
+                          : ObString(cells_[idx].len_,
+                                     reinterpret_cast<const char *>(this) + cells_[idx].offset_);
+    }
+    Record *next_;
+    Cell cells_[0];
+  };
+  struct Compare
+  {
+    explicit Compare(const ObAggrInfo &aggr_info) : aggr_info_(aggr_info), ret_(OB_SUCCESS) {}
+    bool operator()(const Record *l, const Record *r);
+    const ObAggrInfo &aggr_info_;
+    int ret_;
+  };
+
+public:
+  OrderedRowsExtra(common::ObIAllocator &alloc, ObMonitorNode &op_monitor_info) :
+    ExtraResult(alloc, op_monitor_info), head_(nullptr), row_cnt_(0), data_size_(0),
+    spill_store_(nullptr), row_buf_(nullptr), row_buf_size_(0), rows_(nullptr), cells_(nullptr),
+    cell_cnt_(0), iter_idx_(0), iter_started_(false)
+  {}
+  virtual ~OrderedRowsExtra() { destroy_spill_store(); }
+  virtual void reuse() override
+  {
+    destroy_spill_store();
+    head_ = nullptr;
+    row_cnt_ = 0;
+    data_size_ = 0;
+    row_buf_ = nullptr;
+    row_buf_size_ = 0;
+    reset_iter();
+    ExtraResult::reuse();
+  }
+  // serialize row `batch_idx` of `param_vecs` into a record, or add it to the spill store.
+  int add_row(common::ObIAllocator &allocator, ObIVector **param_vecs, const int64_t param_cnt,
+              const int64_t batch_idx);
+  // move records to a dumpable spill store, see `GroupConcatExtraResult::init()`.
+  int spill(const uint64_t tenant_id, const ObAggrInfo &aggr_info, ObEvalCtx &eval_ctx,
+            const int64_t dir_id, ObIOEventObserver *io_event_observer, const int64_t param_cnt);
+  // start iterating rows in adding order, sorted by `sort_collations_` of aggregate if `need_sort`.
+  // rows are rewound if they are iterated again.
+  int begin_iterate(common::ObIAllocator &allocator, const ObAggrInfo &aggr_info,
+                    const bool need_sort, const int64_t param_cnt);
+  // `cells` is valid until next call, return OB_ITER_END if no more rows.
+  int get_next_row(const ObDatum *&cells);
+  int rewind();
+  inline bool empty() const { return 0 == row_cnt_; }
+  inline bool is_spilled() const { return nullptr != spill_store_; }
+  inline int64_t get_row_count() const { return row_cnt_; }
+  // total size of records, including the rows added to spill store
+  inline int64_t get_data_size() const { return data_size_; }
+  INHERIT_TO_STRING_KV("ExtraResult", ExtraResult, KP_(head), K_(row_cnt), K_(data_size),
+                       KP_(spill_store));
+
+private:
+  int prepare_row_buf(const int64_t size);
+  template <typename CellGetter>
+  int add_spilled_row(const int64_t param_cnt, CellGetter &getter, int64_t &row_size);
+  void destroy_spill_store();
+  void reset_iter()
+  {
+    rows_ = nullptr;
+    cells_ = nullptr;
+    cell_cnt_ = 0;
+    iter_idx_ = 0;
+    iter_started_ = false;
+  }
+
+private:
+  Record *head_;
+  int64_t row_cnt_;
+  int64_t data_size_;
+  ObAggregateProcessor::GroupConcatExtraResult *spill_store_;
+  // buffer to build the stored row added to `spill_store_`
+  char *row_buf_;
+  int64_t row_buf_size_;
+  // iterate state of in-memory records
+  const Record **rows_;
+  ObDatum *cells_;
+  int64_t cell_cnt_;
+  int64_t iter_idx_;
+  bool iter_started_;
+};
+
+// Base of the aggregates on OrderedRowsExtra, rows whose cells in
+// [null_check_start_, null_check_end_) contain null are ignored.
+class OrderedAggregate : public IAggregate
+{
+public:
+  OrderedAggregate() :
+    param_vecs_(nullptr), param_cnt_(0), null_check_start_(0), null_check_end_(0),
+    need_sort_(false), spill_threshold_(0)
+  {}
+
+  int collect_batch_group_results(RuntimeContext &agg_ctx, const int32_t agg_col_id,
+                                  const int32_t cur_group_id, const int32_t output_start_idx,
+                                  const int32_t expect_batch_size, int32_t &output_size,
+                                  const ObBitVector *skip = nullptr) override;
+
+  int collect_batch_group_results(RuntimeContext &agg_ctx, const int32_t agg_col_id,
+                                  const int32_t output_start_idx, const int32_t batch_size,
+                                  const ObCompactRow **rows, const RowMeta &row_meta) override;
+
+  int add_batch_rows(RuntimeContext &agg_ctx, int32_t agg_col_id, const sql::ObBitVector &skip,
+                     const sql::EvalBound &bound, char *agg_cell,
+                     const RowSelector row_sel = RowSelector{}) override;
+
+  int add_batch_for_multi_groups(RuntimeContext &agg_ctx, AggrRowPtr *agg_rows,
+                                 RowSelector &row_sel, const int64_t batch_size,
+                                 const int32_t agg_col_id) override;
+
+  int add_one_row(RuntimeContext &agg_ctx, const int64_t batch_idx, const int64_t batch_size,
+                  const bool is_null, const char *data, const int32_t data_len,
+                  int32_t agg_col_id, char *agg_cell) override;
+
+  inline void *get_tmp_res(RuntimeContext &agg_ctx, int32_t agg_col_id, char *agg_cell) override
+  {
+    UNUSEDx(agg_ctx, agg_col_id, agg_cell);
+    return nullptr;
+  }
+
+  inline int64_t get_batch_calc_info(RuntimeContext &agg_ctx, int32_t agg_col_id,
+                                     char *agg_cell) override
+  {
+    UNUSEDx(agg_ctx, agg_col_id, agg_cell);
+    return 0;
+  }
+
+  inline void set_inner_aggregate(IAggregate *agg) override { UNUSED(agg); }
+
+  int init(RuntimeContext &agg_ctx, const int64_t agg_col_id, ObIAllocator &allocator) override;
+
+  void reuse() override {}
+
+  void destroy() override
+  {
+    param_vecs_ = nullptr;
+    param_cnt_ = 0;
+  }
+
+protected:
+  // calculate result of one group from rows of `extra`, which is not empty and ready to iterate.
+  virtual int collect_rows(RuntimeContext &agg_ctx, const int32_t agg_col_id,
+                           OrderedRowsExtra &extra, const int64_t output_idx) = 0;
+  int set_result(RuntimeContext &agg_ctx, const ObExpr &agg_expr, const int64_t output_idx,
+                 const ObDatum &res);
+
+private:
+  int get_extra(RuntimeContext &agg_ctx, const int32_t agg_col_id, char *agg_cell,
+                OrderedRowsExtra *&extra);
+  int load_param_vecs(RuntimeContext &agg_ctx, const int32_t agg_col_id);
+  int add_row(RuntimeContext &agg_ctx, const int32_t agg_col_id, OrderedRowsExtra &extra,
+              const int64_t batch_idx);
+  int spill_rows(RuntimeContext &agg_ctx, const int32_t agg_col_id, OrderedRowsExtra &extra);
+  int collect_group_result(RuntimeContext &agg_ctx, const int32_t agg_col_id,
+                           const char *agg_cell, const int64_t output_idx);
+
+protected:
+  ObIVector **param_vecs_;
+  int64_t param_cnt_;
+  int64_t null_check_start_;
+  int64_t null_check_end_;
+  bool need_sort_;
+  // rows of a group are moved to spill store once the records exceed it, sort work area size.
+  int64_t spill_threshold_;
+};
+
+// GROUP_CONCAT/LISTAGG with constant separator, items are concatenated in the order of
+// `ORDER BY` clause or in the adding order.
+class GroupConcatAggregate final : public OrderedAggregate
+{
+public:
+  GroupConcatAggregate() : OrderedAggregate(), concat_max_len_(0) {}
+
+  int init(RuntimeContext &agg_ctx, const int64_t agg_col_id, ObIAllocator &allocator) override;
+
+  TO_STRING_KV("aggregate", "group_concat", K_(param_cnt), K_(concat_max_len));
+
+protected:
+  int collect_rows(RuntimeContext &agg_ctx, const int32_t agg_col_id, OrderedRowsExtra &extra,
+                   const int64_t output_idx) override;
+
+private:
+  int append_str(const ObString &str, const ObCollationType cs_type, const int64_t item_cnt,
+                 char *buf, int64_t &pos, bool &buf_is_full);
+
+private:
+  uint64_t concat_max_len_;
+};
+
+// MEDIAN, PERCENTILE_CONT and PERCENTILE_DISC, only rows with non-null order value are stored.
+class PercentileAggregate final : public OrderedAggregate
+{
+public:
+  PercentileAggregate() : OrderedAggregate(), order_idx_(0), linear_inter_(nullptr) {}
+
+  int init(RuntimeContext &agg_ctx, const int64_t agg_col_id, ObIAllocator &allocator) override;
+
+  void destroy() override;
+
+  TO_STRING_KV("aggregate", "percentile", K_(param_cnt), K_(order_idx), KP_(linear_inter));
+
+protected:
+  int collect_rows(RuntimeContext &agg_ctx, const int32_t agg_col_id, OrderedRowsExtra &extra,
+                   const int64_t output_idx) override;
+
+private:
+  int get_percentile_param(const ObAggrInfo &aggr_info, const ObDatum &param,
+                           const int64_t row_cnt, int64_t &dest_idx, bool &need_linear_inter,
+                           number::ObNumber &factor, ObDataBuffer &allocator);
+  int linear_inter_calc(RuntimeContext &agg_ctx, const ObAggrInfo &aggr_info,
+                        const ObDatum &prev_datum, const ObDatum &curr_datum,
+                        const number::ObNumber &factor, ObDatum &res);
+
+private:
+  int64_t order_idx_;
+  // factor * (curr - prev) + prev
+  sql::ObRTDatumArith *linear_inter_;
+};
+
+} // end namespace aggregate
+} // end namespace share
+} // end namespace oceanbase
+#endif // OCEANBASE_SHARE_AGGREGATE_ORDERED_AGG_H_
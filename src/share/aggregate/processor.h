@@ -143,6 +143,7 @@ public:
   inline void set_dir_id(const int64_t dir_id)
   {
     dir_id_ = dir_id;
+    agg_ctx_.dir_id_ = dir_id;
   }
   inline int64_t dir_id() const
   {
@@ -178,7 +179,31 @@ public:
       OB_ASSERT(agg_expr != NULL);
       // TODO: remove distinct constraint @zongmei.zzm
       supported = aggregate::supported_aggregate_function(agg_expr->get_expr_type())
-                  && !agg_expr->is_param_distinct();
+                  && !agg_expr->is_param_distinct()
+                  && supported_ordered_aggregate(*agg_expr);
+    }
+    return supported;
+  }
+
+  // GROUP_CONCAT/MEDIAN/PERCENTILE_XXX store param cells as they are, lob params or result with
+  // lob header and non-constant separator are left to non-vectorized operators.
+  inline static bool supported_ordered_aggregate(const ObAggFunRawExpr &agg_expr)
+  {
+    bool supported = true;
+    if (aggregate::is_ordered_aggregate_function(agg_expr.get_expr_type())) {
+      const ObIArray<ObRawExpr *> &params = agg_expr.get_real_param_exprs();
+      const ObIArray<OrderItem> &order_items = agg_expr.get_order_items();
+      supported = !agg_expr.get_result_type().has_lob_header();
+      for (int64_t i = 0; supported && i < params.count(); i++) {
+        supported = (nullptr != params.at(i) && !params.at(i)->get_result_type().is_lob_storage());
+      }
+      for (int64_t i = 0; supported && i < order_items.count(); i++) {
+        supported = (nullptr != order_items.at(i).expr_
+                     && !order_items.at(i).expr_->get_result_type().is_lob_storage());
+      }
+      if (supported && nullptr != agg_expr.get_separator_param_expr()) {
+        supported = agg_expr.get_separator_param_expr()->is_const_expr();
+      }
     }
     return supported;
   }
@@ -607,7 +607,11 @@ inline bool supported_aggregate_function(const ObItemType agg_op)
   case T_FUN_APPROX_COUNT_DISTINCT_SYNOPSIS_MERGE:
   case T_FUN_SYS_BIT_OR:
   case T_FUN_SYS_BIT_AND:
-  case T_FUN_SYS_BIT_XOR: {
+  case T_FUN_SYS_BIT_XOR:
+  case T_FUN_GROUP_CONCAT:
+  case T_FUN_MEDIAN:
+  case T_FUN_GROUP_PERCENTILE_CONT:
+  case T_FUN_GROUP_PERCENTILE_DISC: {
     return true;
   }
   default:
@@ -615,6 +619,13 @@ inline bool supported_aggregate_function(const ObItemType agg_op)
   }
 }
 
+// aggregate functions which need all rows of group, see `OrderedAggregate`
+inline bool is_ordered_aggregate_function(const ObItemType agg_op)
+{
+  return T_FUN_GROUP_CONCAT == agg_op || T_FUN_MEDIAN == agg_op
+         || T_FUN_GROUP_PERCENTILE_CONT == agg_op || T_FUN_GROUP_PERCENTILE_DISC == agg_op;
+}
+
 inline bool agg_res_not_null(const ObItemType agg_op)
 {
   // TODO: add other functions
@@ -286,6 +286,7 @@ void ObKVGlobalCache::destroy()
     insts_.destroy();
     for (int64_t i = 0; i < MAX_CACHE_NUM; ++i) {
       configs_[i].reset();
+      sketches_[i].destroy();
     }
     cache_num_ = 0;
     mem_limit_getter_ = nullptr;
@@ -360,7 +361,8 @@ int ObKVGlobalCache::put(
     COMMON_LOG(WARN, "The inst is NULL, ", K(ret));
   } else if (!overwrite && (OB_SUCC(map_.get(cache_id, key, pvalue, mb_handle)))) {
     ret = OB_ENTRY_EXIST;
-  } else if (OB_FAIL(store.store(*inst_handle.get_inst(), key, value, kvpair, mb_wrapper))) {
+  } else if (OB_FAIL(store.store(*inst_handle.get_inst(), key, value, kvpair, mb_wrapper,
+                                 get_put_policy(cache_id, key)))) {
     COMMON_LOG(WARN, "Fail to store kvpair to store, ", K(ret));
   } else {
     mb_handle = mb_wrapper->get_mb_handle();
@@ -465,9 +467,28 @@ int ObKVGlobalCache::get(
       COMMON_LOG(WARN, "fail to get value from map, ", K(ret));
     }
   }
+  if (inited_ && ATOMIC_LOAD(&configs_[cache_id].enable_admission_)) {
+    // record both hit and miss, so the frequency of key is known when it is put after miss
+    uint64_t hash_code = 0;
+    if (OB_SUCCESS == key.hash(hash_code)) {
+      sketches_[cache_id].increment(hash_code);
+    }
+  }
   return ret;
 }
 
+ObKVCachePolicy ObKVGlobalCache::get_put_policy(const int64_t cache_id, const ObIKVCacheKey &key) const
+{
+  ObKVCachePolicy policy = LRU;
+  uint64_t hash_code = 0;
+  if (ATOMIC_LOAD(&configs_[cache_id].enable_admission_) && OB_SUCCESS == key.hash(hash_code)
+      && sketches_[cache_id].estimate(hash_code) < ADMISSION_FREQ_THRESHOLD) {
+    policy = PROBATION;
+    EVENT_INC(KVCACHE_PROBATION_PUT_COUNT);
+  }
+  return policy;
+}
+
 int ObKVGlobalCache::erase(const int64_t cache_id, const ObIKVCacheKey &key)
 {
   int ret = OB_SUCCESS;
@@ -654,6 +675,7 @@ void ObKVGlobalCache::deregister_cache(const int64_t cache_id)
   } else {
     lib::ObMutexGuard guard(mutex_);
     configs_[cache_id].is_valid_ = false;
+    ATOMIC_STORE(&configs_[cache_id].enable_admission_, false);
   }
 
   if (OB_SUCC(ret)) {
@@ -737,6 +759,32 @@ int ObKVGlobalCache::set_mem_limit_pct(const int64_t cache_id, const int64_t mem
   return ret;
 }
 
+int ObKVGlobalCache::set_admission(const int64_t cache_id, const bool enable_admission)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVGlobalCache has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(cache_id < 0) || OB_UNLIKELY(cache_id >= MAX_CACHE_NUM)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid argument, ", K(cache_id), K(ret));
+  } else if (enable_admission == ATOMIC_LOAD(&configs_[cache_id].enable_admission_)) {
+    // do nothing
+  } else {
+    lib::ObMutexGuard guard(mutex_);
+    // the sketch is kept after admission is disabled, since gets may still be reading it
+    if (enable_admission && !sketches_[cache_id].is_inited()
+        && OB_FAIL(sketches_[cache_id].init())) {
+      COMMON_LOG(WARN, "Fail to init frequency sketch, ", K(ret), K(cache_id));
+    } else {
+      ATOMIC_STORE(&configs_[cache_id].enable_admission_, enable_admission);
+      COMMON_LOG(INFO, "Succ to set cache admission", K(cache_id), K(enable_admission),
+                 "cache_name", configs_[cache_id].cache_name_);
+    }
+  }
+  return ret;
+}
+
 void ObKVGlobalCache::wash()
 {
   if (OB_LIKELY(inited_ && !stopped_)) {
@@ -792,12 +840,18 @@ void ObKVGlobalCache::reload_priority()
         priority = common::ObServerConfig::get_instance().index_block_cache_priority;
       } else if (0 == STRNCMP(configs_[i].cache_name_, "user_block_cache", MAX_CACHE_NAME_LENGTH)) {
         priority = common::ObServerConfig::get_instance().user_block_cache_priority;
+      } else if (0 == STRNCMP(configs_[i].cache_name_, "user_compressed_block_cache", MAX_CACHE_NAME_LENGTH)) {
+        priority = common::ObServerConfig::get_instance().user_block_cache_priority;
       } else if (0 == STRNCMP(configs_[i].cache_name_, "user_row_cache", MAX_CACHE_NAME_LENGTH)) {
         priority = common::ObServerConfig::get_instance().user_row_cache_priority;
       } else if (0 == STRNCMP(configs_[i].cache_name_, "fuse_row_cache", MAX_CACHE_NAME_LENGTH)) {
         priority = common::ObServerConfig::get_instance().fuse_row_cache_priority;
       } else if (0 == STRNCMP(configs_[i].cache_name_, "bf_cache", MAX_CACHE_NAME_LENGTH)) {
         priority = common::ObServerConfig::get_instance().bf_cache_priority;
+      } else if (0 == STRNCMP(configs_[i].cache_name_, "shared_dict_cache", MAX_CACHE_NAME_LENGTH)) {
+        priority = common::ObServerConfig::get_instance().bf_cache_priority;
+      } else if (0 == STRNCMP(configs_[i].cache_name_, "compress_dict_cache", MAX_CACHE_NAME_LENGTH)) {
+        priority = common::ObServerConfig::get_instance().bf_cache_priority;
       } else {
         priority = 0;
       }
@@ -23,6 +23,7 @@
 #include "share/cache/ob_kvcache_struct.h"
 #include "share/cache/ob_kvcache_inst_map.h"
 #include "share/cache/ob_kvcache_map.h"
+#include "share/cache/ob_kvcache_freq_sketch.h"
 #include "share/cache/ob_working_set_mgr.h"
 #include "sql/optimizer/ob_opt_default_stat.h"
 
@@ -62,6 +63,9 @@ public:
   void destroy();
   int set_priority(const int64_t priority);
   int set_mem_limit_pct(const int64_t mem_limit_pct);
+  // Scan resistant admission, new kvpairs whose keys are not read frequently recently are put
+  // into probation memblocks, which are washed first.
+  int set_admission(const bool enable_admission);
   virtual int put(const Key &key, const Value &value, bool overwrite = true);
   virtual int put_and_fetch(
     const Key &key,
@@ -175,6 +179,8 @@ private:
   int delete_working_set(ObWorkingSet *working_set);
   int set_priority(const int64_t cache_id, const int64_t priority);
   int set_mem_limit_pct(const int64_t cache_id, const int64_t mem_limit_pct);
+  int set_admission(const int64_t cache_id, const bool enable_admission);
+  ObKVCachePolicy get_put_policy(const int64_t cache_id, const ObIKVCacheKey &key) const;
   int put(
     const int64_t cache_id,
     const ObIKVCacheKey &key,
@@ -251,6 +257,8 @@ private:
   static const int64_t PRINT_INTERVAL = 30 * 1000L * 1000L;
   static const int64_t MAP_WASH_CLEAN_INTERNAL = 10;
   static const int64_t MAP_REPLACE_ONCE_SKIP_COUNT = 10;
+  // new kvpair is put into LRU memblock if its key is read at least twice recently
+  static const int64_t ADMISSION_FREQ_THRESHOLD = 2;
 private:
   class KVStoreWashTask: public ObTimerTask
   {
@@ -297,6 +305,8 @@ private:
   ObWorkingSetMgr ws_mgr_;
   // cache configs
   ObKVCacheConfig configs_[MAX_CACHE_NUM];
+  // admission filters, inited when admission of cache is enabled first time
+  ObKVCacheFreqSketch sketches_[MAX_CACHE_NUM];
   int64_t cache_num_;
   lib::ObMutex mutex_;
   // timer and task
@@ -459,6 +469,19 @@ int ObKVCache<Key, Value>::set_priority(const int64_t priority)
   return ret;
 }
 
+template <class Key, class Value>
+int ObKVCache<Key, Value>::set_admission(const bool enable_admission)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
+  } else if (OB_FAIL(ObKVGlobalCache::get_instance().set_admission(cache_id_, enable_admission))) {
+    COMMON_LOG(WARN, "Fail to set admission, ", K(ret), K(enable_admission));
+  }
+  return ret;
+}
+
 template <class Key, class Value>
 int ObKVCache<Key, Value>::set_mem_limit_pct(const int64_t mem_limit_pct)
 {
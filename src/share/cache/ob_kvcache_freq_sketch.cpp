@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_kvcache_freq_sketch.h"
+#include "lib/allocator/ob_malloc.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+const uint64_t ObKVCacheFreqSketch::ROW_SEEDS[DEPTH] = {
+  0x9E3779B97F4A7C15UL, 0xC2B2AE3D27D4EB4FUL, 0x165667B19E3779F9UL, 0xD6E8FEB86659FD93UL
+};
+
+ObKVCacheFreqSketch::ObKVCacheFreqSketch()
+  : is_inited_(false),
+    table_(NULL),
+    add_cnt_(0)
+{
+}
+
+int ObKVCacheFreqSketch::init()
+{
+  int ret = OB_SUCCESS;
+  const int64_t table_size = DEPTH * WIDTH;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "The ObKVCacheFreqSketch has been inited, ", K(ret));
+  } else if (OB_ISNULL(table_ = static_cast<uint8_t *>(ob_malloc(table_size,
+      ObMemAttr(OB_SERVER_TENANT_ID, "CACHE_SKETCH", ObCtxIds::KVSTORE_CACHE_ID))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    COMMON_LOG(WARN, "Fail to allocate memory for sketch, ", K(ret), K(table_size));
+  } else {
+    MEMSET(table_, 0, table_size);
+    add_cnt_ = 0;
+    ATOMIC_STORE(&is_inited_, true);
+  }
+  return ret;
+}
+
+void ObKVCacheFreqSketch::destroy()
+{
+  is_inited_ = false;
+  if (NULL != table_) {
+    ob_free(table_);
+    table_ = NULL;
+  }
+  add_cnt_ = 0;
+}
+
+void ObKVCacheFreqSketch::increment(const uint64_t hash)
+{
+  if (OB_LIKELY(is_inited())) {
+    bool added = false;
+    for (int64_t row = 0; row < DEPTH; ++row) {
+      uint8_t &counter = table_[get_idx(hash, row)];
+      if (counter < MAX_FREQ) {
+        ++counter;
+        added = true;
+      }
+    }
+    // only the thread reaching the sample size exactly does the aging
+    if (added && WIDTH * SAMPLE_FACTOR == ATOMIC_AAF(&add_cnt_, 1)) {
+      age();
+    }
+  }
+}
+
+int64_t ObKVCacheFreqSketch::estimate(const uint64_t hash) const
+{
+  int64_t freq = 0;
+  if (OB_LIKELY(is_inited())) {
+    freq = MAX_FREQ;
+    for (int64_t row = 0; row < DEPTH; ++row) {
+      const int64_t counter = table_[get_idx(hash, row)];
+      freq = MIN(freq, counter);
+    }
+  }
+  return freq;
+}
+
+void ObKVCacheFreqSketch::age()
+{
+  // halve all counters, 8 counters in one word
+  const uint64_t mask = 0x7F7F7F7F7F7F7F7FUL;
+  uint64_t *words = reinterpret_cast<uint64_t *>(table_);
+  const int64_t word_cnt = DEPTH * WIDTH / static_cast<int64_t>(sizeof(uint64_t));
+  for (int64_t i = 0; i < word_cnt; ++i) {
+    words[i] = (words[i] >> 1) & mask;
+  }
+  ATOMIC_STORE(&add_cnt_, WIDTH * SAMPLE_FACTOR / 2);
+}
+
+}//end namespace common
+}//end namespace oceanbase
@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_CACHE_OB_KVCACHE_FREQ_SKETCH_H_
+#define OCEANBASE_CACHE_OB_KVCACHE_FREQ_SKETCH_H_
+
+#include "lib/ob_define.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+// Count-min sketch with aging which estimates the recent access frequency of cache keys, used
+// as the admission filter of kvcache (TinyLFU). Every row has WIDTH saturating 4-bit counters
+// (stored in one byte each), all counters are halved after SAMPLE_FACTOR * WIDTH increments,
+// so the keys read by one large scan fade out soon.
+//
+// Counters are updated without synchronization, lost updates under concurrency only make the
+// estimation a bit lower, which is acceptable for an admission filter.
+class ObKVCacheFreqSketch
+{
+public:
+  static const int64_t DEPTH = 4;
+  static const int64_t WIDTH = 1L << 16;
+  static const int64_t SAMPLE_FACTOR = 10;
+  static const uint8_t MAX_FREQ = 15;
+public:
+  ObKVCacheFreqSketch();
+  ~ObKVCacheFreqSketch() { destroy(); }
+  int init();
+  void destroy();
+  inline bool is_inited() const { return ATOMIC_LOAD(&is_inited_); }
+  void increment(const uint64_t hash);
+  int64_t estimate(const uint64_t hash) const;
+  TO_STRING_KV(K_(is_inited), KP_(table), K_(add_cnt));
+private:
+  void age();
+  inline int64_t get_idx(const uint64_t hash, const int64_t row) const
+  {
+    const uint64_t h = (hash ^ (hash >> 29)) * ROW_SEEDS[row];
+    return row * WIDTH + static_cast<int64_t>((h >> 32) & (WIDTH - 1));
+  }
+private:
+  static const uint64_t ROW_SEEDS[DEPTH];
+  bool is_inited_;
+  uint8_t *table_;
+  int64_t add_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObKVCacheFreqSketch);
+};
+
+}//end namespace common
+}//end namespace oceanbase
+
+#endif //OCEANBASE_CACHE_OB_KVCACHE_FREQ_SKETCH_H_
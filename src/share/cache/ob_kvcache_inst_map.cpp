@@ -106,7 +106,8 @@ bool ObKVCacheInst::can_destroy() const
       && 0 == status_.kv_cnt_
       && 0 == status_.store_size_
       && 0 == status_.lru_mb_cnt_
-      && 0 == status_.lfu_mb_cnt_;
+      && 0 == status_.lfu_mb_cnt_
+      && 0 == status_.probation_mb_cnt_;
 }
 
 void ObKVCacheInst::try_mark_delete()
@@ -426,7 +427,8 @@ int ObKVCacheInstMap::refresh_score()
     DRWLock::RDLockGuard rd_guard(lock_);
     for (KVCacheInstMap::iterator iter = inst_map_.begin(); OB_SUCC(ret) && iter != inst_map_.end(); ++iter) {
       inst = iter->second;
-      mb_cnt = ATOMIC_LOAD(&inst->status_.lru_mb_cnt_) + ATOMIC_LOAD(&inst->status_.lfu_mb_cnt_);
+      mb_cnt = ATOMIC_LOAD(&inst->status_.lru_mb_cnt_) + ATOMIC_LOAD(&inst->status_.lfu_mb_cnt_)
+          + ATOMIC_LOAD(&inst->status_.probation_mb_cnt_);
       avg_hit = 0;
       total_hit_cnt = inst->status_.total_hit_cnt_.value();
       if (mb_cnt > 0) {
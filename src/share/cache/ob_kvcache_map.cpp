@@ -15,6 +15,7 @@
 #include "lib/ob_running_mode.h"
 #include "share/config/ob_server_config.h"
 #include "common/ob_clock_generator.h"
+#include "lib/stat/ob_diagnose_info.h"
 
 namespace oceanbase
 {
@@ -299,7 +300,14 @@ int ObKVCacheMap::get(
         tmp_ret = OB_ERR_UNEXPECTED;
         COMMON_LOG(ERROR, "unexpected kv cnt", K(tmp_ret), K(mb_handle_kv_cnt), KPC(iter->mb_handle_));
       } else {
+        ObKVCachePolicy target_policy = MAX_POLICY;
         if (LRU == mb_policy && need_modify_cache(iter_get_cnt, mb_get_cnt, mb_handle_kv_cnt)) {
+          target_policy = LFU;
+        } else if (PROBATION == mb_policy && iter_get_cnt >= PROBATION_PROMOTE_GET_CNT) {
+          // read again after put, promote to LRU memblock
+          target_policy = LRU;
+        }
+        if (MAX_POLICY != target_policy) {
           ObBucketWLockGuard guard(bucket_lock_, bucket_pos);
           if (OB_TMP_FAIL(guard.get_ret())) {
             COMMON_LOG(WARN, "Fail to write lock bucket, ", K(tmp_ret), K(bucket_pos));
@@ -309,8 +317,10 @@ int ObKVCacheMap::get(
             prev = NULL;
             while (nullptr != curr) {
               if (curr == iter) {
-                if (OB_TMP_FAIL(internal_data_move(hazard_guard, prev, iter, bucket_ptr))) {
-                  COMMON_LOG(WARN, "Fail to move node to LFU block, ", K(tmp_ret));
+                if (OB_TMP_FAIL(internal_data_move(hazard_guard, prev, iter, bucket_ptr, target_policy))) {
+                  COMMON_LOG(WARN, "Fail to move node, ", K(tmp_ret), K(target_policy));
+                } else if (PROBATION == mb_policy) {
+                  EVENT_INC(KVCACHE_PROBATION_PROMOTE_COUNT);
                 }
                 break;
               }
@@ -791,7 +801,8 @@ void ObKVCacheMap::internal_map_replace(const ObKVCacheHazardGuard &guard,
 int ObKVCacheMap::internal_data_move(const ObKVCacheHazardGuard &guard,
                                      Node *&prev,
                                      Node *&old_iter,
-                                     Node *&bucket_ptr)
+                                     Node *&bucket_ptr,
+                                     const ObKVCachePolicy policy)
 {
   int ret = OB_SUCCESS;
   Node *new_node = NULL;
@@ -801,7 +812,7 @@ int ObKVCacheMap::internal_data_move(const ObKVCacheHazardGuard &guard,
   if (NULL == (buf = old_iter->inst_->node_allocator_.alloc(sizeof(Node)))) {
     ret = OB_ALLOCATE_MEMORY_FAILED;
     COMMON_LOG(WARN, "Fail to allocate memory for Node, ", K(ret), "size:", sizeof(Node));
-  } else if (OB_FAIL(store_->store(*old_iter->inst_, *old_iter->key_, *old_iter->value_, new_kvpair, new_mb_handle, LFU))) {
+  } else if (OB_FAIL(store_->store(*old_iter->inst_, *old_iter->key_, *old_iter->value_, new_kvpair, new_mb_handle, policy))) {
     old_iter->inst_->node_allocator_.free(buf);
     COMMON_LOG(WARN, "Fail to move kvpair ", K(ret));
   } else {
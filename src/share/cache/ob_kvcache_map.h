@@ -33,6 +33,8 @@ class ObKVCacheMap
   static constexpr int64_t BUCKET_SIZE_ARRAY_LEN = 4;
   static constexpr int64_t BUCKET_SIZE_ARRAY[BUCKET_SIZE_ARRAY_LEN] = {MIN_BUCKET_SIZE, MIN_BUCKET_SIZE << 4,  MIN_BUCKET_SIZE << 8, DEFAULT_BUCKET_SIZE};
   static const int64_t DEFAULT_LFU_THRESHOLD_BASE = 2;
+  // get count of node includes the put, node in probation memblock is promoted on the first get after put
+  static const int64_t PROBATION_PROMOTE_GET_CNT = 2;
 public:
   ObKVCacheMap();
   virtual ~ObKVCacheMap();
@@ -92,7 +94,8 @@ private:
   int multi_get(const int64_t cache_id, const int64_t pos, common::ObList<Node, common::ObArenaAllocator> &list);
   void internal_map_erase(const ObKVCacheHazardGuard &guard, Node *&prev, Node *&iter, Node *&bucket_ptr);
   void internal_map_replace(const ObKVCacheHazardGuard &guard, Node *&prev, Node *&iter, Node *&bucket_ptr);
-  int internal_data_move(const ObKVCacheHazardGuard &guard, Node *&prev, Node *&iter, Node *&bucket_ptr);
+  int internal_data_move(const ObKVCacheHazardGuard &guard, Node *&prev, Node *&iter, Node *&bucket_ptr,
+                         const ObKVCachePolicy policy);
   OB_INLINE bool need_modify_cache(const int64_t iter_get_cnt, const int64_t total_get_cnt, const int64_t kv_cnt) const
   {
     bool ret = false;
@@ -240,7 +240,8 @@ void ObKVCacheStore::refresh_score()
     for (i = 0; i < cur_mb_num_; i++) {
       if (add_handle_ref(&mb_handles_[i])) {
         if (NULL != mb_handles_[i].inst_) {
-          priority = mb_handles_[i].inst_->status_.config_->priority_;
+          // gets of probation memblocks are not weighted by priority, so they are washed first
+          priority = PROBATION == mb_handles_[i].policy_ ? 1 : mb_handles_[i].inst_->status_.config_->priority_;
           score = mb_handles_[i].score_;
           score = score * CACHE_SCORE_DECAY_FACTOR + (double) (mb_handles_[i].recent_get_cnt_ * priority);
           mb_handles_[i].score_ = score;
@@ -916,8 +917,10 @@ int ObKVCacheStore::alloc_mbhandle(
     } else {
       if (LRU == policy) {
         (void) ATOMIC_AAF(&inst.status_.lru_mb_cnt_, 1);
-      } else {
+      } else if (LFU == policy) {
         (void) ATOMIC_AAF(&inst.status_.lfu_mb_cnt_, 1);
+      } else {
+        (void) ATOMIC_AAF(&inst.status_.probation_mb_cnt_, 1);
       }
       mb_handle->inst_ = &inst;
       mb_handle->policy_ = policy;
@@ -1217,8 +1220,10 @@ int ObKVCacheStore::do_wash_mb(ObKVMemBlockHandle *mb_handle, void *&buf, int64_
                         mb_handle->mem_block_->get_payload_size() + sizeof(ObKVStoreMemBlock));
       if (mb_handle->policy_ == LRU) {
         (void) ATOMIC_SAF(&mb_handle->inst_->status_.lru_mb_cnt_, 1);
-      } else {
+      } else if (mb_handle->policy_ == LFU) {
         (void) ATOMIC_SAF(&mb_handle->inst_->status_.lfu_mb_cnt_, 1);
+      } else {
+        (void) ATOMIC_SAF(&mb_handle->inst_->status_.probation_mb_cnt_, 1);
       }
     }
     buf = mb_handle->mem_block_;
@@ -21,7 +21,8 @@ namespace common
  */
 ObKVCacheConfig::ObKVCacheConfig()
   : is_valid_(false),
-    priority_(0)
+    priority_(0),
+    enable_admission_(false)
 {
   MEMSET(cache_name_, 0, MAX_CACHE_NAME_LENGTH);
 }
@@ -31,6 +32,7 @@ void ObKVCacheConfig::reset()
   is_valid_ = false;
   priority_ = 0;
   mem_limit_pct_ = 100;
+  enable_admission_ = false;
   MEMSET(cache_name_, 0, MAX_CACHE_NAME_LENGTH);
 }
 
@@ -61,6 +63,7 @@ void ObKVCacheStatus::reset()
   map_size_ = 0;
   lru_mb_cnt_ = 0;
   lfu_mb_cnt_ = 0;
+  probation_mb_cnt_ = 0;
   total_put_cnt_.reset();
   total_hit_cnt_.reset();
   total_miss_cnt_ = 0;
@@ -323,7 +326,9 @@ int ObKVMemBlockHandle::alloc(const int64_t key_size, const int64_t value_size,
 
 void ObKVMemBlockHandle::set_full(const double base_mb_score)
 {
-  score_ += base_mb_score;
+  if (PROBATION != policy_) {
+    score_ += base_mb_score;
+  }
   ATOMIC_STORE((uint32_t*)(&status_), FULL);
 }
 
@@ -75,7 +75,10 @@ enum ObKVCachePolicy
 {
   LRU = 0,
   LFU = 1,
-  MAX_POLICY = 2
+  // kvpairs not admitted by the frequency sketch of cache, washed before LRU and LFU memblocks
+  // and moved to LRU memblocks when read again
+  PROBATION = 2,
+  MAX_POLICY = 3
 };
 
 class ObKVStoreMemBlock
@@ -178,6 +181,8 @@ public:
   bool is_valid_;
   int64_t priority_;
   int64_t mem_limit_pct_;
+  // new kvpairs with low estimated frequency are put into PROBATION memblocks
+  bool enable_admission_;
   char cache_name_[MAX_CACHE_NAME_LENGTH];
 };
 
@@ -195,7 +200,7 @@ public:
   }
   void reset();
   TO_STRING_KV(KP_(config), K_(kv_cnt), K_(store_size), K_(map_size), K_(lru_mb_cnt),
-      K_(lfu_mb_cnt), K_(base_mb_score), K_(hold_size));
+      K_(lfu_mb_cnt), K_(probation_mb_cnt), K_(base_mb_score), K_(hold_size));
 
   const ObKVCacheConfig *config_;
   ObPCNonAtomicCounter total_put_cnt_;
@@ -204,6 +209,7 @@ public:
   int64_t store_size_;
   int64_t lru_mb_cnt_;
   int64_t lfu_mb_cnt_;
+  int64_t probation_mb_cnt_;
   int64_t map_size_;
   int64_t last_hit_cnt_;
   int64_t total_miss_cnt_;
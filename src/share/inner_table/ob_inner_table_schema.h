@@ -1045,6 +1045,7 @@ public:
   static int all_virtual_nic_info_schema(share::schema::ObTableSchema &table_schema);
   static int all_virtual_scheduler_job_run_detail_v2_schema(share::schema::ObTableSchema &table_schema);
   static int all_virtual_spatial_reference_systems_schema(share::schema::ObTableSchema &table_schema);
+  static int all_virtual_sql_expr_vector_fallback_schema(share::schema::ObTableSchema &table_schema);
   static int all_virtual_sql_audit_ora_schema(share::schema::ObTableSchema &table_schema);
   static int all_virtual_plan_stat_ora_schema(share::schema::ObTableSchema &table_schema);
   static int all_virtual_plan_cache_plan_explain_ora_schema(share::schema::ObTableSchema &table_schema);
@@ -3790,6 +3791,7 @@ const schema_create_func virtual_table_schema_creators [] = {
   ObInnerTableSchema::all_virtual_nic_info_schema,
   ObInnerTableSchema::all_virtual_scheduler_job_run_detail_v2_schema,
   ObInnerTableSchema::all_virtual_spatial_reference_systems_schema,
+  ObInnerTableSchema::all_virtual_sql_expr_vector_fallback_schema,
   ObInnerTableSchema::all_virtual_ash_all_virtual_ash_i1_schema,
   ObInnerTableSchema::all_virtual_sql_plan_monitor_all_virtual_sql_plan_monitor_i1_schema,
   ObInnerTableSchema::all_virtual_sql_audit_all_virtual_sql_audit_i1_schema,
@@ -10145,7 +10147,8 @@ const uint64_t cluster_distributed_vtables [] = {
   OB_ALL_VIRTUAL_STORAGE_LEAK_INFO_TID,
   OB_ALL_VIRTUAL_STORAGE_HA_ERROR_DIAGNOSE_TID,
   OB_ALL_VIRTUAL_STORAGE_HA_PERF_DIAGNOSE_TID,
-  OB_ALL_VIRTUAL_TENANT_SCHEDULER_RUNNING_JOB_TID,  };
+  OB_ALL_VIRTUAL_TENANT_SCHEDULER_RUNNING_JOB_TID,
+  OB_ALL_VIRTUAL_SQL_EXPR_VECTOR_FALLBACK_TID,  };
 
 const uint64_t tenant_distributed_vtables [] = {
   OB_ALL_VIRTUAL_PROCESSLIST_TID,
@@ -13025,11 +13028,11 @@ static inline int get_sys_table_lob_aux_schema(const uint64_t tid,
 
 const int64_t OB_CORE_TABLE_COUNT = 4;
 const int64_t OB_SYS_TABLE_COUNT = 296;
-const int64_t OB_VIRTUAL_TABLE_COUNT = 820;
+const int64_t OB_VIRTUAL_TABLE_COUNT = 821;
 const int64_t OB_SYS_VIEW_COUNT = 901;
-const int64_t OB_SYS_TENANT_TABLE_COUNT = 2022;
+const int64_t OB_SYS_TENANT_TABLE_COUNT = 2023;
 const int64_t OB_CORE_SCHEMA_VERSION = 1;
-const int64_t OB_BOOTSTRAP_SCHEMA_VERSION = 2025;
+const int64_t OB_BOOTSTRAP_SCHEMA_VERSION = 2026;
 
 } // end namespace share
 } // end namespace oceanbase
@@ -14547,6 +14547,23 @@ def_table_schema(**gen_iterate_virtual_table_def(
 
 # 12492: __all_virtual_ss_local_cache_info
 
+def_table_schema(
+  owner             = 'agent',
+  table_name        = '__all_virtual_sql_expr_vector_fallback',
+  table_id          = '12493',
+  table_type        = 'VIRTUAL_TABLE',
+  gm_columns        = [],
+  rowkey_columns    = [],
+  normal_columns    = [
+    ('svr_ip', 'varchar:MAX_IP_ADDR_LENGTH'),
+    ('svr_port', 'int'),
+    ('expr_type', 'varchar:OB_MAX_FUNC_EXPR_LENGTH'),
+    ('fallback_count', 'int'),
+  ],
+  partition_columns = ['svr_ip', 'svr_port'],
+  vtable_route_policy = 'distributed',
+)
+
 # 余留位置（此行之前占位）
 # 本区域占位建议：采用真实表名进行占位
 ################################################################################
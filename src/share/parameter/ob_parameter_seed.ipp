@@ -515,6 +515,10 @@ DEF_INT(_temporary_file_meta_memory_limit_percentage, OB_TENANT_PARAMETER, "0",
         "The default value is 70. For compatibility, 0 is 70% of tenant memory."
         "Range: [0, 100], percentage",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_temporary_file_compression, OB_TENANT_PARAMETER, "False",
+         "specifies whether the pages of temporary file blocks are compressed with lz4 when the blocks are written to disk. "
+         "The default value is False. Value: True: turned on; False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_storage_meta_memory_limit_percentage, OB_TENANT_PARAMETER, "20", "[0, 50)",
          "maximum memory for storage meta, as a percentage of total tenant memory. "
          "Range: [0, 50), percentage, 0 means no limit to storage meta memory",
@@ -927,6 +931,24 @@ DEF_INT(index_block_cache_priority, OB_CLUSTER_PARAMETER, "10", "[1,)", "index c
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(user_block_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "user block cache priority. Range:[1, )",
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_compressed_block_cache, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether to keep the compressed data micro blocks read from disk in a second tier "
+         "of user block cache, which uses the priority of user block cache. "
+         "Value:  True:turned on;  False: turned off",
+         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_block_cache_admission, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether to put the micro blocks not read frequently recently into the probation "
+         "part of index block cache and user block cache, which is washed first, so that large scans "
+         "do not flush the hot micro blocks. "
+         "Value:  True:turned on;  False: turned off",
+         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR(_micro_block_flash_cache_path, OB_CLUSTER_PARAMETER, "",
+        "the file on local flash device to cache the micro blocks read from data files, "
+        "empty means the flash cache is disabled",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_CAP(_micro_block_flash_cache_size, OB_CLUSTER_PARAMETER, "0M", "[0M,)",
+        "size of the micro block flash cache file, 0 means the flash cache is disabled. Range: [0M,)",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 DEF_INT(user_row_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "user row cache priority. Range:[1, )",
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(bf_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "bf cache priority. Range:[1, )",
@@ -1008,6 +1030,14 @@ DEF_BOOL(_enable_compaction_diagnose, OB_CLUSTER_PARAMETER, "False",
 DEF_STR(_force_skip_encoding_partition_id, OB_CLUSTER_PARAMETER, "",
         "force the specified partition to major without encoding row store, only for emergency!",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_cs_shared_dict, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether major compaction shares the string dictionaries of cs encoding "
+         "micro blocks in macro block. The default value is False. Value: True: turned on; False: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_micro_block_compress_dict, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether major compaction compresses data micro blocks with a dictionary sampled "
+         "from the micro blocks of the same macro block writer. The default value is False. Value: True: turned on; False: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_CAP(_private_buffer_size, OB_CLUSTER_PARAMETER, "16K", "[0B,)"
          "the trigger remaining data size within transaction for immediate logging, 0B represents not trigger immediate logging"
          "Range: [0B, total size of memory]",
@@ -1728,6 +1758,11 @@ DEF_CAP(_pdml_thread_cache_size, OB_CLUSTER_PARAMETER, "2M", "[1B,)",
 DEF_BOOL(_enable_hgby_llc_ndv_adaptive, OB_TENANT_PARAMETER, "True",
          "specifies whether llc ndv adptive is activated",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_hash_groupby_shared_table_ndv_threshold, OB_TENANT_PARAMETER, "4096", "[0, 65536]",
+        "the max estimated group count of partial hash group by in parallel plan to merge "
+        "results of workers in the same SQC into a shared table, 0 means disabled. "
+        "Range: [0, 65536]",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_enable_reserved_user_dcl_restriction, OB_CLUSTER_PARAMETER, "False",
          "specifies whether to forbid non-reserved user to modify reserved users",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
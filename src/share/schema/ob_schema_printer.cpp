@@ -472,6 +472,15 @@ int ObSchemaPrinter::print_table_definition_columns(const ObTableSchema &table_s
               first_skip_idx_attr_printed = true;
             }
           }
+          if (OB_SUCC(ret) && col->get_skip_index_attr().has_bloom_filter()) {
+            if (first_skip_idx_attr_printed && OB_FAIL(databuff_printf(buf, buf_len, pos, ", "))) {
+              SHARE_SCHEMA_LOG(WARN, "fail to print skip index attr", K(ret));
+            } else if (OB_FAIL(databuff_printf(buf, buf_len, pos, "BLOOM_FILTER"))) {
+              SHARE_SCHEMA_LOG(WARN, "fail to print skip index attr", K(ret));
+            } else {
+              first_skip_idx_attr_printed = true;
+            }
+          }
           if (OB_SUCC(ret)) {
             if (OB_FAIL(databuff_printf(buf, buf_len, pos, ")"))) {
               SHARE_SCHEMA_LOG(WARN, "fail to print skip index", K(ret));
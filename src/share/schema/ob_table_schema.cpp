@@ -7538,6 +7538,11 @@ int ObTableSchema::check_skip_index_valid() const
       ret = OB_NOT_SUPPORTED;
       LOG_USER_ERROR(OB_NOT_SUPPORTED, "build skip index on invalid type");
       LOG_WARN("not supported skip index on column with invalid column type", K(ret), KPC(column_schema));
+    } else if (column_schema->get_skip_index_attr().has_bloom_filter() &&
+               !can_agg_bloom_filter(column_schema->get_meta_type().get_type())) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_USER_ERROR(OB_NOT_SUPPORTED, "build bloom filter skip index on invalid type");
+      LOG_WARN("not supported bloom filter skip index on column type", K(ret), KPC(column_schema));
     } else if (OB_FAIL(blocksstable::ObSkipIndexColMeta::calc_skip_index_maximum_size(
         column_schema->get_skip_index_attr(),
         column_schema->get_meta_type().get_type(),
@@ -94,6 +94,7 @@
 #include "sql/engine/join/ob_hash_join_op.h"
 #include "sql/engine/join/hash_join/ob_hash_join_vec_op.h"
 #include "sql/engine/join/ob_nested_loop_join_op.h"
+#include "sql/engine/join/ob_nested_loop_join_vec_op.h"
 #include "sql/engine/join/ob_join_filter_op.h"
 #include "sql/engine/sequence/ob_sequence_op.h"
 #include "sql/engine/subquery/ob_subplan_filter_op.h"
@@ -103,7 +104,9 @@
 #include "sql/engine/aggregate/ob_scalar_aggregate_op.h"
 #include "sql/engine/aggregate/ob_merge_groupby_op.h"
 #include "sql/engine/aggregate/ob_hash_groupby_op.h"
+#include "sql/engine/aggregate/ob_hash_groupby_vec_op.h"
 #include "sql/engine/join/ob_merge_join_op.h"
+#include "sql/engine/join/ob_merge_join_vec_op.h"
 #include "sql/engine/basic/ob_topk_op.h"
 #include "sql/executor/ob_task_spliter.h"
 #include "sql/engine/dml/ob_table_delete_op.h"
@@ -5146,7 +5149,47 @@ int ObStaticEngineCG::generate_spec(ObLogGroupBy &op, ObHashGroupBySpec &spec,
 
 int ObStaticEngineCG::generate_spec(ObLogGroupBy &op, ObHashGroupByVecSpec &spec, const bool in_root_job)
 {
-  return generate_spec(op, reinterpret_cast<ObHashGroupBySpec &> (spec), in_root_job);
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(generate_spec(op, reinterpret_cast<ObHashGroupBySpec &> (spec), in_root_job))) {
+    LOG_WARN("generate hash group by spec failed", K(ret));
+  } else if (OB_FAIL(check_hash_groupby_shared_table(op, spec))) {
+    LOG_WARN("check shared table for hash group by failed", K(ret));
+  }
+  return ret;
+}
+
+// Partial group by of parallel plan with few groups, merge results of workers in the same SQC
+// into one table to reduce rows sent to the final group by, see ObHashGbySharedTable.
+int ObStaticEngineCG::check_hash_groupby_shared_table(ObLogGroupBy &op, ObHashGroupByVecSpec &spec)
+{
+  int ret = OB_SUCCESS;
+  int64_t ndv_threshold = 0;
+  const ObLogicalOperator *parent = op.get_parent();
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(
+      op.get_plan()->get_optimizer_context().get_session_info()->get_effective_tenant_id()));
+  if (tenant_config.is_valid()) {
+    ndv_threshold = tenant_config->_hash_groupby_shared_table_ndv_threshold;
+  }
+  spec.use_shared_table_ = ndv_threshold > 0
+                           && op.get_distinct_card() <= ndv_threshold
+                           && op.is_push_down()
+                           && op.get_parallel() > 1
+                           && NULL != parent
+                           && log_op_def::LOG_EXCHANGE == parent->get_type()
+                           && ObThreeStageAggrStage::NONE_STAGE == spec.aggr_stage_
+                           && !op.has_rollup()
+                           && op.get_filter_exprs().empty()
+                           && !spec.group_exprs_.empty();
+  for (int64_t i = 0; spec.use_shared_table_ && i < spec.group_exprs_.count(); i++) {
+    const ObExpr *expr = spec.group_exprs_.at(i);
+    spec.use_shared_table_ = !expr->is_const_expr() && !is_lob_storage(expr->datum_meta_.type_);
+  }
+  for (int64_t i = 0; spec.use_shared_table_ && i < spec.aggr_infos_.count(); i++) {
+    spec.use_shared_table_ = ObHashGbySharedTable::is_supported_aggr(spec.aggr_infos_.at(i));
+  }
+  LOG_TRACE("hash group by shared table", K(spec.id_), K(spec.use_shared_table_),
+            K(op.get_distinct_card()), K(ndv_threshold), K(op.get_parallel()));
+  return ret;
 }
 
 // copy from ObCodeGeneratorImpl::convert_normal_table_scan
@@ -5889,6 +5932,43 @@ int ObStaticEngineCG::generate_spec(ObLogJoin &op,
   UNUSED(in_root_job);
   return generate_join_spec(op, spec);
 }
+int ObStaticEngineCG::generate_spec(ObLogJoin &op,
+                                    ObNestedLoopJoinVecSpec &spec,
+                                    const bool in_root_job)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(in_root_job);
+  if (op.is_partition_wise()) {
+    phy_plan_->set_is_wise_join(op.is_partition_wise()); // set is_wise_join
+  }
+  const ObIArray<ObRawExpr*> &other_join_conds = op.get_other_join_conditions();
+  OZ(spec.other_join_conds_.init(other_join_conds.count()));
+  ARRAY_FOREACH(other_join_conds, i) {
+    ObRawExpr *raw_expr = other_join_conds.at(i);
+    ObExpr *expr = NULL;
+    if (OB_ISNULL(raw_expr)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_ERROR("null pointer", K(ret));
+    } else if (OB_FAIL(generate_rt_expr(*raw_expr, expr))) {
+      LOG_WARN("fail to generate rt expr", K(ret), K(*raw_expr));
+    } else if (OB_FAIL(spec.other_join_conds_.push_back(expr))) {
+      LOG_WARN("failed to add sql expr", K(ret), K(*expr));
+    }
+  } // end for
+  spec.join_type_ = op.get_join_type();
+  if (OB_FAIL(ret)) {
+  } else if (OB_UNLIKELY(0 != op.get_equal_join_conditions().count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("equal join conditions' count should equal 0", K(ret));
+  } else if (OB_FAIL(generate_param_spec(op.get_nl_params(), spec.rescan_params_))) {
+    LOG_WARN("fail to generate param spec", K(ret));
+  } else if (FALSE_IT(spec.group_rescan_ = op.can_use_batch_nlj())) {
+  } else if (OB_FAIL(set_batch_exec_param(op.get_nl_params(), spec.rescan_params_))) {
+    // params of the group rescan operators below are set by this NLJ
+    LOG_WARN("fail to set batch exec param", K(ret));
+  }
+  return ret;
+}
 int ObStaticEngineCG::generate_spec(ObLogJoin &op,
                                     ObMergeJoinSpec &spec,
                                     const bool in_root_job)
@@ -5896,6 +5976,110 @@ int ObStaticEngineCG::generate_spec(ObLogJoin &op,
   UNUSED(in_root_job);
   return generate_join_spec(op, spec);
 }
+int ObStaticEngineCG::generate_spec(ObLogJoin &op,
+                                    ObMergeJoinVecSpec &spec,
+                                    const bool in_root_job)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(in_root_job);
+  if (op.is_partition_wise()) {
+    phy_plan_->set_is_wise_join(op.is_partition_wise()); // set is_wise_join
+  }
+  // 1. add other join conditions
+  const ObIArray<ObRawExpr*> &other_join_conds = op.get_other_join_conditions();
+  OZ(spec.other_join_conds_.init(other_join_conds.count()));
+  ARRAY_FOREACH(other_join_conds, i) {
+    ObRawExpr *raw_expr = other_join_conds.at(i);
+    ObExpr *expr = NULL;
+    if (OB_ISNULL(raw_expr)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_ERROR("null pointer", K(ret));
+    } else if (OB_FAIL(generate_rt_expr(*raw_expr, expr))) {
+      LOG_WARN("fail to generate rt expr", K(ret), K(*raw_expr));
+    } else if (OB_FAIL(spec.other_join_conds_.push_back(expr))) {
+      LOG_WARN("failed to add sql expr", K(ret), K(*expr));
+    }
+  } // end for
+  spec.join_type_ = op.get_join_type();
+
+  // 2. add equal join keys and populate all exprs for left/right child fetcher,
+  // child output comes first so that the output can be projected by column index.
+  const ObIArray<ObRawExpr*> &equal_join_conds = op.get_equal_join_conditions();
+  if (OB_FAIL(ret)) {
+  } else if (OB_ISNULL(spec.get_left()) || OB_ISNULL(spec.get_right())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("child is null", K(ret));
+  } else if (OB_FAIL(spec.left_keys_.init(equal_join_conds.count()))
+             || OB_FAIL(spec.right_keys_.init(equal_join_conds.count()))
+             || OB_FAIL(spec.is_ns_equal_cond_.init(equal_join_conds.count()))) {
+    LOG_WARN("failed to init join keys", K(ret));
+  } else if (OB_FAIL(spec.left_child_fetcher_all_exprs_.init(
+               spec.get_left()->output_.count() + equal_join_conds.count()))) {
+    LOG_WARN("failed to init left fetcher all exprs", K(ret));
+  } else if (OB_FAIL(spec.right_child_fetcher_all_exprs_.init(
+               spec.get_right()->output_.count() + equal_join_conds.count()))) {
+    LOG_WARN("failed to init right fetcher all exprs", K(ret));
+  } else if (OB_FAIL(append(spec.left_child_fetcher_all_exprs_, spec.get_left()->output_))) {
+    LOG_WARN("fail to append left child output", K(ret));
+  } else if (OB_FAIL(append(spec.right_child_fetcher_all_exprs_, spec.get_right()->output_))) {
+    LOG_WARN("fail to append right child output", K(ret));
+  }
+  ARRAY_FOREACH(equal_join_conds, i) {
+    ObRawExpr *raw_expr = equal_join_conds.at(i);
+    ObExpr *expr = NULL;
+    bool is_opposite = false;
+    CK(OB_NOT_NULL(raw_expr));
+    CK(T_OP_EQ == raw_expr->get_expr_type() || T_OP_NSEQ == raw_expr->get_expr_type());
+    OZ(generate_rt_expr(*raw_expr, expr));
+    CK(OB_NOT_NULL(expr));
+    CK(2 == expr->arg_cnt_);
+    OZ(calc_equal_cond_opposite(op, *raw_expr, is_opposite));
+    if (OB_SUCC(ret)) {
+      ObExpr *l_key = is_opposite ? expr->args_[1] : expr->args_[0];
+      ObExpr *r_key = is_opposite ? expr->args_[0] : expr->args_[1];
+      OZ(spec.left_keys_.push_back(l_key));
+      OZ(spec.right_keys_.push_back(r_key));
+      OZ(spec.is_ns_equal_cond_.push_back(T_OP_NSEQ == raw_expr->get_expr_type()));
+      OZ(add_var_to_array_no_dup(spec.left_child_fetcher_all_exprs_, l_key));
+      OZ(add_var_to_array_no_dup(spec.right_child_fetcher_all_exprs_, r_key));
+    }
+  } // end for
+  // 3. add merge directions
+  if (OB_SUCC(ret)) {
+    bool left_unique = false;
+    if (OB_FAIL(spec.set_merge_directions(op.get_merge_directions()))) {
+      LOG_WARN("fail to set merge directions", K(ret));
+    } else if (OB_FAIL(op.is_left_unique(left_unique))) {
+      LOG_WARN("fail to check left unique", K(ret), K(op));
+    } else {
+      spec.is_left_unique_ = left_unique;
+    }
+  }
+  return ret;
+}
+
+bool ObStaticEngineCG::is_merge_join_keys_vec_supported(const ObLogJoin &op)
+{
+  bool supported = true;
+  const ObIArray<ObRawExpr*> &equal_join_conds = op.get_equal_join_conditions();
+  for (int64_t i = 0; supported && i < equal_join_conds.count(); i++) {
+    const ObRawExpr *raw_expr = equal_join_conds.at(i);
+    if (OB_ISNULL(raw_expr) || 2 != raw_expr->get_param_count()
+        || OB_ISNULL(raw_expr->get_param_expr(0)) || OB_ISNULL(raw_expr->get_param_expr(1))) {
+      supported = false;
+    } else {
+      const ObExprResType &l = raw_expr->get_param_expr(0)->get_result_type();
+      const ObExprResType &r = raw_expr->get_param_expr(1)->get_result_type();
+      supported = l.get_type() == r.get_type()
+                  && l.get_collation_type() == r.get_collation_type()
+                  && (!ob_is_decimal_int(l.get_type())
+                      || (l.get_precision() == r.get_precision()
+                          && l.get_scale() == r.get_scale()));
+    }
+  }
+  return supported;
+}
+
 int ObStaticEngineCG::generate_join_spec(ObLogJoin &op, ObJoinSpec &spec)
 {
   int ret = OB_SUCCESS;
@@ -8804,15 +8988,36 @@ int ObStaticEngineCG::get_phy_op_type(ObLogicalOperator &log_op,
       auto &op = static_cast<ObLogJoin&>(log_op);
       switch(op.get_join_algo()) {
         case NESTED_LOOP_JOIN: {
-          type = CONNECT_BY_JOIN != op.get_join_type()
-             ? PHY_NESTED_LOOP_JOIN
-             : (op.get_nl_params().count() > 0
-                  ? PHY_NESTED_LOOP_CONNECT_BY_WITH_INDEX
-                  : PHY_NESTED_LOOP_CONNECT_BY);
+          int tmp_ret = OB_SUCCESS;
+          tmp_ret = OB_E(EventTable::EN_DISABLE_VEC_NESTED_LOOP_JOIN) OB_SUCCESS;
+          if (CONNECT_BY_JOIN == op.get_join_type()) {
+            type = op.get_nl_params().count() > 0
+                   ? PHY_NESTED_LOOP_CONNECT_BY_WITH_INDEX
+                   : PHY_NESTED_LOOP_CONNECT_BY;
+          } else if (OB_SUCCESS == tmp_ret && use_rich_format
+                     && GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0
+                     && !op.enable_px_batch_rescan()
+                     && !op.is_enable_gi_partition_pruning()
+                     && op.get_above_pushdown_left_params().empty()
+                     && op.get_above_pushdown_right_params().empty()) {
+            // multi level group rescan, px batch rescan and gi partition pruning are
+            // only supported by the non-rich-format NLJ.
+            type = PHY_VEC_NESTED_LOOP_JOIN;
+          } else {
+            type = PHY_NESTED_LOOP_JOIN;
+          }
           break;
         }
         case MERGE_JOIN: {
-          type = PHY_MERGE_JOIN;
+          int tmp_ret = OB_SUCCESS;
+          tmp_ret = OB_E(EventTable::EN_DISABLE_VEC_MERGE_JOIN) OB_SUCCESS;
+          if (OB_SUCCESS == tmp_ret && use_rich_format
+              && GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0
+              && is_merge_join_keys_vec_supported(op)) {
+            type = PHY_VEC_MERGE_JOIN;
+          } else {
+            type = PHY_MERGE_JOIN;
+          }
           break;
         }
         case HASH_JOIN: {
@@ -67,6 +67,8 @@ class ObHashJoinVecSpec;
 class ObNestedLoopJoinSpec;
 class ObBasicNestedLoopJoinSpec;
 class ObMergeJoinSpec;
+class ObMergeJoinVecSpec;
+class ObNestedLoopJoinVecSpec;
 class ObJoinSpec;
 class ObMonitoringDumpSpec;
 class ObLogSequence;
@@ -204,6 +206,9 @@ public:
   // detect physical operator type from logic operator.
   static int get_phy_op_type(ObLogicalOperator &op, ObPhyOperatorType &type,
                              const bool in_root_job, const bool use_rich_format = false);
+  // vectorized merge join compares keys of the two children with the row compare function of
+  // the left key, which requires identical key types on both sides.
+  static bool is_merge_join_keys_vec_supported(const ObLogJoin &op);
   //set is json constraint type is strict or relax
   const static uint8_t IS_JSON_CONSTRAINT_RELAX = 1;
   const static uint8_t IS_JSON_CONSTRAINT_STRICT = 4;
@@ -329,6 +334,7 @@ private:
   int generate_spec(ObLogGroupBy &op, ObMergeGroupBySpec &spec, const bool in_root_job);
   int generate_spec(ObLogGroupBy &op, ObHashGroupBySpec &spec, const bool in_root_job);
   int generate_spec(ObLogGroupBy &op, ObHashGroupByVecSpec &spec, const bool in_root_job);
+  int check_hash_groupby_shared_table(ObLogGroupBy &op, ObHashGroupByVecSpec &spec);
   int generate_dist_aggr_distinct_columns(ObLogGroupBy &op, ObHashGroupBySpec &spec);
   int generate_dist_aggr_group(ObLogGroupBy &op, ObGroupBySpec &spec);
 
@@ -356,8 +362,10 @@ private:
 
   // generate nested loop join
   int generate_spec(ObLogJoin &op, ObNestedLoopJoinSpec &spec, const bool in_root_job);
+  int generate_spec(ObLogJoin &op, ObNestedLoopJoinVecSpec &spec, const bool in_root_job);
   // generate merge join
   int generate_spec(ObLogJoin &op, ObMergeJoinSpec &spec, const bool in_root_job);
+  int generate_spec(ObLogJoin &op, ObMergeJoinVecSpec &spec, const bool in_root_job);
 
   int generate_join_spec(ObLogJoin &op, ObJoinSpec &spec);
 
@@ -579,6 +579,13 @@ int ObStaticEngineExprCG::cg_expr_by_operator(const ObIArray<ObRawExpr *> &raw_e
       }
       if (NULL == rt_expr->eval_vector_func_) {
         rt_expr->eval_vector_func_ = &expr_default_eval_vector_func;
+        // expressions evaluated row by row in vectorized plan, count them by type to find the
+        // expressions worth vectorizing.
+        if (use_rich_format() && rt_expr->is_batch_result() && rt_expr->arg_cnt_ > 0) {
+          ObExprVectorFallbackStat::get_instance().inc(rt_expr->type_);
+          LOG_TRACE("expr vector eval fallback to row by row",
+                    "expr_type", get_type_name(rt_expr->type_), K(rt_expr->arg_cnt_));
+        }
       }
     }
   }
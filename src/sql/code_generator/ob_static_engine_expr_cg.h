@@ -63,6 +63,32 @@ public:
   uint64_t cur_cluster_version_;
 };
 
+// Number of expressions generated with the row by row default vector evaluation function in
+// rich format plans, counted by expr type, see __all_virtual_sql_expr_vector_fallback.
+class ObExprVectorFallbackStat
+{
+public:
+  static ObExprVectorFallbackStat &get_instance()
+  {
+    static ObExprVectorFallbackStat instance;
+    return instance;
+  }
+  void inc(const ObExprOperatorType type)
+  {
+    if (type > T_MIN_OP && type < T_MAX_OP) {
+      ATOMIC_INC(&cnts_[type]);
+    }
+  }
+  int64_t get(const ObExprOperatorType type) const
+  {
+    return (type > T_MIN_OP && type < T_MAX_OP) ? ATOMIC_LOAD(&cnts_[type]) : 0;
+  }
+private:
+  ObExprVectorFallbackStat() { MEMSET(cnts_, 0, sizeof(cnts_)); }
+  int64_t cnts_[T_MAX_OP];
+  DISALLOW_COPY_AND_ASSIGN(ObExprVectorFallbackStat);
+};
+
 class ObRawExpr;
 class ObRawExprFactory;
 class RowDesc;
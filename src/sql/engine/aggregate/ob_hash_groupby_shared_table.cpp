@@ -0,0 +1,491 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/aggregate/ob_hash_groupby_shared_table.h"
+#include "common/data_buffer.h"
+#include "lib/wide_integer/ob_wide_integer.h"
+#include "share/vector/ob_i_vector.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+int ObHashGbySharedTable::init(ObIAllocator &alloc,
+                               const uint64_t tenant_id,
+                               const int64_t task_cnt,
+                               const ObIArray<ObExpr *> &group_exprs,
+                               const AggrInfoFixedArray &aggr_infos)
+{
+  int ret = OB_SUCCESS;
+  const int64_t col_cnt = group_exprs.count() + aggr_infos.count();
+  if (OB_UNLIKELY(inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_UNLIKELY(task_cnt <= 0 || group_exprs.empty())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(task_cnt), K(group_exprs.count()));
+  } else if (OB_ISNULL(cols_ = static_cast<ColInfo *>(alloc.alloc(sizeof(ColInfo) * col_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(col_cnt));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < col_cnt; i++) {
+      ColInfo *col = new (&cols_[i]) ColInfo();
+      const ObExpr *expr = NULL;
+      if (i < group_exprs.count()) {
+        expr = group_exprs.at(i);
+        col->merge_type_ = MERGE_KEEP;
+      } else {
+        const ObAggrInfo &aggr_info = aggr_infos.at(i - group_exprs.count());
+        expr = aggr_info.expr_;
+        if (OB_UNLIKELY(!is_supported_aggr(aggr_info))) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("unsupported aggregate for shared group table", K(ret), K(aggr_info));
+        } else if (aggr_info.is_implicit_first_aggr()) {
+          col->merge_type_ = MERGE_KEEP;
+        } else if (T_FUN_MIN == aggr_info.get_expr_type()) {
+          col->merge_type_ = MERGE_MIN;
+        } else if (T_FUN_MAX == aggr_info.get_expr_type()) {
+          col->merge_type_ = MERGE_MAX;
+        } else {
+          col->merge_type_ = MERGE_ADD;
+        }
+      }
+      if (OB_FAIL(ret)) {
+      } else if (OB_ISNULL(expr) || OB_ISNULL(expr->basic_funcs_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("invalid expr", K(ret), K(i), KP(expr));
+      } else {
+        col->meta_ = expr->datum_meta_;
+        col->hash_func_ = expr->basic_funcs_->murmur_hash_v2_;
+        col->cmp_func_ = expr->basic_funcs_->null_first_cmp_;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ObMemAttr attr(tenant_id, "SqcSharedGby", ObCtxIds::WORK_AREA);
+      for (int64_t i = 0; i < STRIPE_CNT; i++) {
+        stripes_[i].alloc_.set_attr(attr);
+      }
+      task_cnt_ = task_cnt;
+      finished_cnt_ = 0;
+      group_cnt_ = 0;
+      is_full_ = false;
+      key_cnt_ = group_exprs.count();
+      col_cnt_ = col_cnt;
+      inited_ = true;
+    }
+  }
+  return ret;
+}
+
+void ObHashGbySharedTable::destroy()
+{
+  for (int64_t i = 0; i < STRIPE_CNT; i++) {
+    stripes_[i].alloc_.reset();
+    stripes_[i].buckets_ = NULL;
+    stripes_[i].row_cnt_ = 0;
+  }
+  // %cols_ is allocated by the allocator of SQC
+  cols_ = NULL;
+  inited_ = false;
+}
+
+bool ObHashGbySharedTable::is_supported_aggr(const ObAggrInfo &aggr_info)
+{
+  bool supported = false;
+  const ObExpr *expr = aggr_info.expr_;
+  if (OB_ISNULL(expr) || expr->is_const_expr() || is_lob_storage(expr->datum_meta_.type_)) {
+  } else if (aggr_info.is_implicit_first_aggr()) {
+    supported = true;
+  } else if (aggr_info.has_distinct_ || aggr_info.has_order_by_) {
+  } else {
+    switch (aggr_info.get_expr_type()) {
+      case T_FUN_MIN:
+      case T_FUN_MAX: {
+        supported = true;
+        break;
+      }
+      case T_FUN_COUNT:
+      case T_FUN_COUNT_SUM:
+      case T_FUN_SUM: {
+        switch (ob_obj_type_class(expr->datum_meta_.type_)) {
+          case ObIntTC:
+          case ObUIntTC:
+          case ObFloatTC:
+          case ObDoubleTC:
+          case ObNumberTC: {
+            supported = true;
+            break;
+          }
+          case ObDecimalIntTC: {
+            // narrow decimal int may overflow after merged
+            supported = wide::ObDecimalIntConstValue::get_int_bytes_by_precision(
+                          expr->datum_meta_.precision_) >= static_cast<int>(sizeof(int128_t));
+            break;
+          }
+          default: {
+            break;
+          }
+        }
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+  }
+  return supported;
+}
+
+int ObHashGbySharedTable::merge_batch(ObEvalCtx &eval_ctx,
+                                      const ObIArray<ObExpr *> &cols,
+                                      const ObBatchRows &brs,
+                                      uint64_t *hash_vals,
+                                      uint16_t *selector,
+                                      ObBitVector &skip,
+                                      int64_t &merged_cnt)
+{
+  int ret = OB_SUCCESS;
+  merged_cnt = 0;
+  int64_t stripe_offsets[STRIPE_CNT + 1];
+  ObSEArray<ObIVector *, 16> vectors;
+  ObSEArray<ObDatum, 16> datums;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(cols.count() != col_cnt_)
+             || OB_ISNULL(hash_vals) || OB_ISNULL(selector)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(cols.count()), K(col_cnt_), KP(hash_vals),
+             KP(selector));
+  } else if (OB_FAIL(datums.prepare_allocate(col_cnt_))) {
+    LOG_WARN("prepare allocate failed", K(ret));
+  } else {
+    for (int64_t c = 0; OB_SUCC(ret) && c < col_cnt_; c++) {
+      if (OB_FAIL(vectors.push_back(cols.at(c)->get_vector(eval_ctx)))) {
+        LOG_WARN("push back failed", K(ret));
+      }
+    }
+    MEMSET(stripe_offsets, 0, sizeof(stripe_offsets));
+    // calc hash values and sort rows by stripe, so that each stripe is locked once
+    for (int64_t i = 0; OB_SUCC(ret) && i < brs.size_; i++) {
+      if (brs.skip_->at(i)) {
+        continue;
+      }
+      uint64_t hash_val = HASH_SEED;
+      for (int64_t c = 0; OB_SUCC(ret) && c < key_cnt_; c++) {
+        ObDatum key;
+        if (vectors.at(c)->is_null(i)) {
+          key.set_null();
+        } else {
+          ObLength len = 0;
+          vectors.at(c)->get_payload(i, key.ptr_, len);
+          key.pack_ = len;
+        }
+        if (OB_FAIL(cols_[c].hash_func_(key, hash_val, hash_val))) {
+          LOG_WARN("hash failed", K(ret), K(c));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        hash_vals[i] = hash_val;
+        stripe_offsets[get_stripe_idx(hash_val) + 1] += 1;
+      }
+    }
+    for (int64_t s = 0; OB_SUCC(ret) && s < STRIPE_CNT; s++) {
+      stripe_offsets[s + 1] += stripe_offsets[s];
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < brs.size_; i++) {
+      if (!brs.skip_->at(i)) {
+        selector[stripe_offsets[get_stripe_idx(hash_vals[i])]++] = static_cast<uint16_t>(i);
+      }
+    }
+    // after the loop above, stripe_offsets[s] is the end of stripe s
+    int64_t begin = 0;
+    for (int64_t s = 0; OB_SUCC(ret) && s < STRIPE_CNT; s++) {
+      const int64_t end = stripe_offsets[s];
+      if (begin < end) {
+        Stripe &stripe = stripes_[s];
+        ObSpinLockGuard guard(stripe.lock_);
+        for (int64_t j = begin; OB_SUCC(ret) && j < end; j++) {
+          const int64_t i = selector[j];
+          bool merged = false;
+          for (int64_t c = 0; c < col_cnt_; c++) {
+            ObDatum &datum = datums.at(c);
+            if (vectors.at(c)->is_null(i)) {
+              datum.set_null();
+            } else {
+              ObLength len = 0;
+              vectors.at(c)->get_payload(i, datum.ptr_, len);
+              datum.pack_ = len;
+            }
+          }
+          if (OB_FAIL(merge_row(stripe, datums.get_data(), hash_vals[i], merged))) {
+            LOG_WARN("merge row failed", K(ret), K(i));
+          } else if (merged) {
+            skip.set(i);
+            merged_cnt += 1;
+          }
+        }
+      }
+      begin = end;
+    }
+  }
+  return ret;
+}
+
+int ObHashGbySharedTable::merge_row(Stripe &stripe,
+                                    const ObDatum *datums,
+                                    const uint64_t hash_val,
+                                    bool &merged)
+{
+  int ret = OB_SUCCESS;
+  merged = false;
+  Row *row = NULL;
+  if (OB_ISNULL(stripe.buckets_)) {
+    const int64_t size = sizeof(Row *) * STRIPE_BUCKET_CNT;
+    if (OB_ISNULL(stripe.buckets_ = static_cast<Row **>(stripe.alloc_.alloc(size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(size));
+    } else {
+      MEMSET(stripe.buckets_, 0, size);
+    }
+  }
+  if (OB_SUCC(ret)) {
+    Row **bucket = &stripe.buckets_[get_bucket_idx(hash_val)];
+    for (Row *cur = *bucket; OB_SUCC(ret) && NULL == row && NULL != cur; cur = cur->next_) {
+      bool equal = (cur->hash_ == hash_val);
+      for (int64_t c = 0; OB_SUCC(ret) && equal && c < key_cnt_; c++) {
+        int cmp_ret = 0;
+        if (OB_FAIL(cols_[c].cmp_func_(cur->cells_[c], datums[c], cmp_ret))) {
+          LOG_WARN("compare failed", K(ret), K(c));
+        } else {
+          equal = (0 == cmp_ret);
+        }
+      }
+      if (OB_SUCC(ret) && equal) {
+        row = cur;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (NULL != row) {
+      for (int64_t c = key_cnt_; OB_SUCC(ret) && c < col_cnt_; c++) {
+        if (OB_FAIL(merge_cell(stripe.alloc_, cols_[c], datums[c], row->cells_[c]))) {
+          LOG_WARN("merge cell failed", K(ret), K(c), K(cols_[c]));
+        }
+      }
+      merged = OB_SUCC(ret);
+    } else if (is_full()) {
+      // new group is output by the worker itself
+    } else if (ATOMIC_AAF(&group_cnt_, 1) > MAX_GROUP_CNT) {
+      ATOMIC_STORE(&is_full_, true);
+      LOG_TRACE("shared group table is full", K(*this));
+    } else {
+      const int64_t size = sizeof(Row) + sizeof(ObDatum) * col_cnt_;
+      if (OB_ISNULL(row = static_cast<Row *>(stripe.alloc_.alloc(size)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate memory failed", K(ret), K(size));
+      } else {
+        new (row) Row();
+        for (int64_t c = 0; OB_SUCC(ret) && c < col_cnt_; c++) {
+          new (&row->cells_[c]) ObDatum();
+          if (OB_FAIL(row->cells_[c].deep_copy(datums[c], stripe.alloc_))) {
+            LOG_WARN("deep copy datum failed", K(ret), K(c));
+          }
+        }
+        if (OB_SUCC(ret)) {
+          row->hash_ = hash_val;
+          row->next_ = *bucket;
+          *bucket = row;
+          stripe.row_cnt_ += 1;
+          merged = true;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObHashGbySharedTable::merge_cell(ObIAllocator &alloc,
+                                     const ColInfo &col,
+                                     const ObDatum &in,
+                                     ObDatum &cell)
+{
+  int ret = OB_SUCCESS;
+  if (MERGE_KEEP == col.merge_type_ || in.is_null()) {
+    // do nothing
+  } else if (cell.is_null()) {
+    if (OB_FAIL(cell.deep_copy(in, alloc))) {
+      LOG_WARN("deep copy datum failed", K(ret));
+    }
+  } else if (MERGE_ADD == col.merge_type_) {
+    if (OB_FAIL(add_cell(alloc, col, in, cell))) {
+      LOG_WARN("add cell failed", K(ret));
+    }
+  } else {
+    int cmp_ret = 0;
+    if (OB_FAIL(col.cmp_func_(in, cell, cmp_ret))) {
+      LOG_WARN("compare failed", K(ret));
+    } else if ((MERGE_MIN == col.merge_type_ && cmp_ret < 0)
+               || (MERGE_MAX == col.merge_type_ && cmp_ret > 0)) {
+      if (OB_FAIL(cell.deep_copy(in, alloc))) {
+        LOG_WARN("deep copy datum failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+template <typename T>
+static int add_decimal_int(const ObDatum &in, ObDatum &cell)
+{
+  // cell is deep copied, it's safe to modify in place
+  *reinterpret_cast<T *>(const_cast<char *>(cell.ptr_)) += *reinterpret_cast<const T *>(in.ptr_);
+  return OB_SUCCESS;
+}
+
+int ObHashGbySharedTable::add_cell(ObIAllocator &alloc,
+                                   const ColInfo &col,
+                                   const ObDatum &in,
+                                   ObDatum &cell)
+{
+  int ret = OB_SUCCESS;
+  char *res = const_cast<char *>(cell.ptr_);
+  switch (ob_obj_type_class(col.meta_.type_)) {
+    case ObIntTC: {
+      int64_t v = 0;
+      if (__builtin_add_overflow(cell.get_int(), in.get_int(), &v)) {
+        ret = OB_OPERATE_OVERFLOW;
+        LOG_WARN("int add overflow", K(ret), K(cell.get_int()), K(in.get_int()));
+      } else {
+        *reinterpret_cast<int64_t *>(res) = v;
+      }
+      break;
+    }
+    case ObUIntTC: {
+      uint64_t v = 0;
+      if (__builtin_add_overflow(cell.get_uint64(), in.get_uint64(), &v)) {
+        ret = OB_OPERATE_OVERFLOW;
+        LOG_WARN("uint add overflow", K(ret), K(cell.get_uint64()), K(in.get_uint64()));
+      } else {
+        *reinterpret_cast<uint64_t *>(res) = v;
+      }
+      break;
+    }
+    case ObFloatTC: {
+      *reinterpret_cast<float *>(res) = cell.get_float() + in.get_float();
+      break;
+    }
+    case ObDoubleTC: {
+      *reinterpret_cast<double *>(res) = cell.get_double() + in.get_double();
+      break;
+    }
+    case ObNumberTC: {
+      char calc_buf[number::ObNumber::MAX_CALC_BYTE_LEN];
+      ObDataBuffer calc_alloc(calc_buf, number::ObNumber::MAX_CALC_BYTE_LEN);
+      number::ObNumber l(cell.get_number());
+      number::ObNumber r(in.get_number());
+      number::ObNumber sum;
+      char *buf = NULL;
+      if (OB_FAIL(l.add_v3(r, sum, calc_alloc))) {
+        LOG_WARN("number add failed", K(ret));
+      } else if (OB_ISNULL(buf = static_cast<char *>(
+                             alloc.alloc(number::ObNumber::MAX_BYTE_LEN)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate memory failed", K(ret));
+      } else {
+        cell.ptr_ = buf;
+        cell.set_number(sum);
+      }
+      break;
+    }
+    case ObDecimalIntTC: {
+      if (OB_UNLIKELY(in.len_ != cell.len_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("decimal int width mismatch", K(ret), K(in.len_), K(cell.len_));
+      } else {
+        switch (cell.len_) {
+          case sizeof(int128_t): ret = add_decimal_int<int128_t>(in, cell); break;
+          case sizeof(int256_t): ret = add_decimal_int<int256_t>(in, cell); break;
+          case sizeof(int512_t): ret = add_decimal_int<int512_t>(in, cell); break;
+          default: {
+            ret = OB_ERR_UNEXPECTED;
+            LOG_WARN("unexpected decimal int width", K(ret), K(cell.len_));
+          }
+        }
+      }
+      break;
+    }
+    default: {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected type to add", K(ret), K(col));
+    }
+  }
+  return ret;
+}
+
+int ObHashGbySharedTable::get_next_batch(ObEvalCtx &eval_ctx,
+                                         const ObIArray<ObExpr *> &cols,
+                                         const int64_t max_row_cnt,
+                                         Iterator &iter,
+                                         int64_t &read_rows)
+{
+  int ret = OB_SUCCESS;
+  read_rows = 0;
+  ObSEArray<ObIVector *, 16> vectors;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(cols.count() != col_cnt_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(cols.count()), K(col_cnt_));
+  }
+  for (int64_t c = 0; OB_SUCC(ret) && c < col_cnt_; c++) {
+    if (OB_FAIL(cols.at(c)->init_vector_for_write(
+          eval_ctx, cols.at(c)->get_default_res_format(), max_row_cnt))) {
+      LOG_WARN("init vector failed", K(ret), K(c));
+    } else if (OB_FAIL(vectors.push_back(cols.at(c)->get_vector(eval_ctx)))) {
+      LOG_WARN("push back failed", K(ret));
+    }
+  }
+  while (OB_SUCC(ret) && read_rows < max_row_cnt && iter.stripe_idx_ < STRIPE_CNT) {
+    if (NULL != iter.row_) {
+      for (int64_t c = 0; c < col_cnt_; c++) {
+        const ObDatum &cell = iter.row_->cells_[c];
+        if (cell.is_null()) {
+          vectors.at(c)->set_null(read_rows);
+        } else {
+          vectors.at(c)->set_payload_shallow(read_rows, cell.ptr_, cell.len_);
+        }
+      }
+      read_rows += 1;
+      iter.row_ = iter.row_->next_;
+    } else {
+      const Stripe &stripe = stripes_[iter.stripe_idx_];
+      if (NULL == stripe.buckets_ || iter.bucket_idx_ >= STRIPE_BUCKET_CNT) {
+        iter.stripe_idx_ += 1;
+        iter.bucket_idx_ = 0;
+      } else {
+        iter.row_ = stripe.buckets_[iter.bucket_idx_++];
+      }
+    }
+  }
+  for (int64_t c = 0; OB_SUCC(ret) && c < col_cnt_; c++) {
+    cols.at(c)->set_evaluated_projected(eval_ctx);
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_AGGREGATE_OB_HASH_GROUPBY_SHARED_TABLE_H_
+#define OCEANBASE_SQL_ENGINE_AGGREGATE_OB_HASH_GROUPBY_SHARED_TABLE_H_
+
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/allocator/page_arena.h"
+#include "share/datum/ob_datum.h"
+#include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/aggregate/ob_aggregate_processor.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// Group table shared by the workers of one SQC for partial (pushed down) hash group by with
+// few groups.
+//
+// Every worker aggregates its input into its private hash table without any synchronization,
+// then merges the partial results into this table instead of sending them to the exchange. The
+// last finished worker of the SQC outputs the merged rows, so the consumer DFO receives one
+// partial row per group from each SQC instead of one from each worker.
+//
+// The table is split into stripes by hash value, each stripe has its own lock and allocator.
+// When the groups exceed MAX_GROUP_CNT, merging stops and the workers output the remaining
+// rows by themselves, which is still correct for partial aggregation.
+class ObHashGbySharedTable
+{
+public:
+  static const int64_t STRIPE_CNT = 64;
+  static const int64_t STRIPE_BUCKET_CNT = 1024;
+  static const int64_t MAX_GROUP_CNT = STRIPE_CNT * STRIPE_BUCKET_CNT;
+  static const uint64_t HASH_SEED = 99194853094755497L;
+
+  enum MergeType
+  {
+    MERGE_KEEP = 0, // group by columns and implicit first row aggregates
+    MERGE_ADD,
+    MERGE_MIN,
+    MERGE_MAX,
+  };
+
+  struct ColInfo
+  {
+    ColInfo() : meta_(), merge_type_(MERGE_KEEP), hash_func_(NULL), cmp_func_(NULL) {}
+    TO_STRING_KV(K_(meta), K_(merge_type));
+    ObDatumMeta meta_;
+    MergeType merge_type_;
+    ObExprHashFuncType hash_func_;
+    ObExprCmpFuncType cmp_func_;
+  };
+
+  struct Row
+  {
+    Row *next_;
+    uint64_t hash_;
+    ObDatum cells_[0];
+  };
+
+  struct Stripe
+  {
+    Stripe() : lock_(common::ObLatchIds::SQL_SHARED_HASH_GROUPBY_LOCK), alloc_(),
+               buckets_(NULL), row_cnt_(0)
+    {}
+    common::ObSpinLock lock_;
+    common::ObArenaAllocator alloc_;
+    Row **buckets_;
+    int64_t row_cnt_;
+  };
+
+  // Iterate merged rows, only used by the last finished worker.
+  struct Iterator
+  {
+    Iterator() : stripe_idx_(0), bucket_idx_(0), row_(NULL) {}
+    void reset() { new (this) Iterator(); }
+    int64_t stripe_idx_;
+    int64_t bucket_idx_;
+    Row *row_;
+  };
+
+public:
+  ObHashGbySharedTable()
+    : inited_(false), task_cnt_(0), finished_cnt_(0), group_cnt_(0), is_full_(false),
+      key_cnt_(0), col_cnt_(0), cols_(NULL), stripes_()
+  {}
+  ~ObHashGbySharedTable() { destroy(); }
+
+  // columns are group by exprs followed by the result exprs of %aggr_infos
+  int init(common::ObIAllocator &alloc,
+           const uint64_t tenant_id,
+           const int64_t task_cnt,
+           const common::ObIArray<ObExpr *> &group_exprs,
+           const AggrInfoFixedArray &aggr_infos);
+  void destroy();
+  static bool is_supported_aggr(const ObAggrInfo &aggr_info);
+
+  inline bool is_full() const { return ATOMIC_LOAD(&is_full_); }
+  inline int64_t get_col_cnt() const { return col_cnt_; }
+  inline int64_t get_group_cnt() const { return ATOMIC_LOAD(&group_cnt_); }
+  // Return true if the caller is the last worker finished merging, who should output the
+  // merged rows.
+  inline bool finish_merge() { return ATOMIC_AAF(&finished_cnt_, 1) == task_cnt_; }
+
+  // Merge the active rows of %brs from the vectors of %cols. Rows merged are marked in %skip,
+  // rows left unmerged (table is full) should be output by the caller.
+  // %hash_vals and %selector are buffers of batch size.
+  int merge_batch(ObEvalCtx &eval_ctx,
+                  const common::ObIArray<ObExpr *> &cols,
+                  const ObBatchRows &brs,
+                  uint64_t *hash_vals,
+                  uint16_t *selector,
+                  ObBitVector &skip,
+                  int64_t &merged_cnt);
+  int get_next_batch(ObEvalCtx &eval_ctx,
+                     const common::ObIArray<ObExpr *> &cols,
+                     const int64_t max_row_cnt,
+                     Iterator &iter,
+                     int64_t &read_rows);
+
+  TO_STRING_KV(K_(inited), K_(task_cnt), K_(finished_cnt), K_(group_cnt), K_(is_full),
+               K_(key_cnt), K_(col_cnt));
+
+private:
+  int merge_row(Stripe &stripe,
+                const ObDatum *datums,
+                const uint64_t hash_val,
+                bool &merged);
+  int merge_cell(common::ObIAllocator &alloc,
+                 const ColInfo &col,
+                 const ObDatum &in,
+                 ObDatum &cell);
+  int add_cell(common::ObIAllocator &alloc,
+               const ColInfo &col,
+               const ObDatum &in,
+               ObDatum &cell);
+  inline int64_t get_stripe_idx(const uint64_t hash_val) const
+  {
+    return (hash_val >> 32) & (STRIPE_CNT - 1);
+  }
+  inline int64_t get_bucket_idx(const uint64_t hash_val) const
+  {
+    return hash_val & (STRIPE_BUCKET_CNT - 1);
+  }
+
+private:
+  bool inited_;
+  int64_t task_cnt_;
+  int64_t finished_cnt_;
+  int64_t group_cnt_;
+  bool is_full_;
+  int64_t key_cnt_;
+  int64_t col_cnt_;
+  ColInfo *cols_;
+  Stripe stripes_[STRIPE_CNT];
+  DISALLOW_COPY_AND_ASSIGN(ObHashGbySharedTable);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif // OCEANBASE_SQL_ENGINE_AGGREGATE_OB_HASH_GROUPBY_SHARED_TABLE_H_
@@ -32,7 +32,41 @@ OB_SERIALIZE_MEMBER(ObGroupByDupColumnPairVec, org_expr, dup_expr);
 OB_SERIALIZE_MEMBER((ObHashGroupByVecSpec, ObGroupBySpec),
   group_exprs_,cmp_funcs_, est_group_cnt_,
   org_dup_cols_, new_dup_cols_, dist_col_group_idxs_,
-  distinct_exprs_);
+  distinct_exprs_, use_shared_table_);
+
+OB_SERIALIZE_MEMBER(ObHashGroupByVecInput, shared_table_);
+
+ObHashGroupByVecInput::~ObHashGroupByVecInput()
+{
+  if (is_owner_ && 0 != shared_table_) {
+    get_shared_table()->~ObHashGbySharedTable();
+  }
+  shared_table_ = 0;
+}
+
+int ObHashGroupByVecInput::init_shared_table(ObIAllocator &alloc, const int64_t task_cnt)
+{
+  int ret = OB_SUCCESS;
+  const ObHashGroupByVecSpec &spec = static_cast<const ObHashGroupByVecSpec &>(spec_);
+  void *buf = NULL;
+  ObHashGbySharedTable *table = NULL;
+  if (OB_ISNULL(exec_ctx_.get_my_session())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is null", K(ret));
+  } else if (OB_ISNULL(buf = alloc.alloc(sizeof(ObHashGbySharedTable)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret));
+  } else if (FALSE_IT(table = new (buf) ObHashGbySharedTable())) {
+  } else if (OB_FAIL(table->init(alloc, exec_ctx_.get_my_session()->get_effective_tenant_id(),
+                                 task_cnt, spec.group_exprs_, spec.aggr_infos_))) {
+    LOG_WARN("init shared table failed", K(ret), K(task_cnt));
+    table->~ObHashGbySharedTable();
+  } else {
+    shared_table_ = reinterpret_cast<uint64_t>(table);
+    is_owner_ = true;
+  }
+  return ret;
+}
 
 DEF_TO_STRING(ObHashGroupByVecSpec)
 {
@@ -261,6 +295,9 @@ int ObHashGroupByVecOp::inner_open()
     }
   }
 
+  if (OB_SUCC(ret) && MY_SPEC.use_shared_table_ && OB_FAIL(init_shared_table())) {
+    LOG_WARN("init shared table failed", K(ret));
+  }
   if (OB_SUCC(ret)) {
     if (ObThreeStageAggrStage::FIRST_STAGE == MY_SPEC.aggr_stage_) {
       no_non_distinct_aggr_ = (0 == MY_SPEC.aggr_infos_.count());
@@ -349,6 +386,8 @@ void ObHashGroupByVecOp::destroy()
   dup_groupby_exprs_.reset();
   all_groupby_exprs_.reset();
   distinct_origin_exprs_.reset();
+  shared_cols_.reset();
+  shared_table_ = nullptr;
   local_group_rows_.destroy();
   sql_mem_processor_.destroy();
   distinct_sql_mem_processor_.destroy();
@@ -380,6 +419,8 @@ int ObHashGroupByVecOp::inner_rescan()
   int ret = OB_SUCCESS;
   reset(true);
   llc_est_.reset();
+  // results of different iterations can not be merged, aggregate by self after rescan
+  shared_state_ = SHARED_NONE;
   if (OB_FAIL(ObGroupByVecOp::inner_rescan())) {
     LOG_WARN("failed to rescan", K(ret));
   } else {
@@ -954,6 +995,110 @@ void ObHashGroupByVecOp::destroy_all_parts()
 }
 
 int ObHashGroupByVecOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (SHARED_NONE == shared_state_) {
+    ret = local_get_next_batch(max_row_cnt);
+  } else {
+    ret = shared_get_next_batch(max_row_cnt);
+  }
+  return ret;
+}
+
+int ObHashGroupByVecOp::init_shared_table()
+{
+  int ret = OB_SUCCESS;
+  ObHashGroupByVecInput *input = static_cast<ObHashGroupByVecInput *>(input_);
+  shared_state_ = SHARED_NONE;
+  if (OB_ISNULL(input) || 0 == input->shared_table_) {
+    // not scheduled by SQC, aggregate by self
+  } else if (FALSE_IT(shared_table_ = input->get_shared_table())) {
+  } else if (OB_FAIL(append(shared_cols_, MY_SPEC.group_exprs_))) {
+    LOG_WARN("append group exprs failed", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.aggr_infos_.count(); i++) {
+      if (OB_FAIL(shared_cols_.push_back(MY_SPEC.aggr_infos_.at(i).expr_))) {
+        LOG_WARN("push back failed", K(ret));
+      }
+    }
+    const int64_t max_size = MY_SPEC.max_batch_size_;
+    char *buf = NULL;
+    if (OB_FAIL(ret)) {
+    } else if (OB_UNLIKELY(shared_cols_.count() != shared_table_->get_col_cnt())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("column count mismatch", K(ret), K(shared_cols_.count()), K(*shared_table_));
+    } else if (OB_ISNULL(buf = static_cast<char *>(mem_context_->get_arena_allocator().alloc(
+                           max_size * (sizeof(uint64_t) + sizeof(uint16_t)))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(max_size));
+    } else {
+      shared_hash_vals_ = reinterpret_cast<uint64_t *>(buf);
+      shared_selector_ = reinterpret_cast<uint16_t *>(buf + max_size * sizeof(uint64_t));
+      shared_iter_.reset();
+      shared_state_ = SHARED_MERGING;
+    }
+  }
+  return ret;
+}
+
+// Merge local results into the shared table of SQC, rows can not be merged are returned.
+// The last worker finished merging outputs all rows of the shared table.
+int ObHashGroupByVecOp::shared_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  bool got_rows = false;
+  while (OB_SUCC(ret) && !got_rows && SHARED_MERGING == shared_state_) {
+    int64_t merged_cnt = 0;
+    if (OB_FAIL(local_get_next_batch(max_row_cnt))) {
+      LOG_WARN("get next batch failed", K(ret));
+    } else if (brs_.size_ > 0
+               && OB_FAIL(shared_table_->merge_batch(eval_ctx_, shared_cols_, brs_,
+                                                     shared_hash_vals_, shared_selector_,
+                                                     *brs_.skip_, merged_cnt))) {
+      LOG_WARN("merge batch into shared table failed", K(ret));
+    } else {
+      if (merged_cnt > 0) {
+        brs_.all_rows_active_ = false;
+      }
+      if (brs_.size_ > 0 && !brs_.skip_->is_all_true(brs_.size_)) {
+        got_rows = true;
+      }
+      if (brs_.end_) {
+        shared_state_ = shared_table_->finish_merge() ? SHARED_OUTPUT : SHARED_END;
+        LOG_TRACE("finish merging into shared table", K(shared_state_), K(*shared_table_));
+        if (got_rows) {
+          // return the end flag after the shared rows are output
+          brs_.end_ = SHARED_END == shared_state_;
+        }
+      }
+    }
+  }
+  if (OB_SUCC(ret) && !got_rows) {
+    clear_evaluated_flag();
+    if (SHARED_OUTPUT == shared_state_) {
+      int64_t read_rows = 0;
+      const int64_t batch_size = min(max_row_cnt, MY_SPEC.max_batch_size_);
+      if (OB_FAIL(shared_table_->get_next_batch(eval_ctx_, shared_cols_, batch_size,
+                                                shared_iter_, read_rows))) {
+        LOG_WARN("get next batch from shared table failed", K(ret));
+      } else {
+        brs_.size_ = read_rows;
+        brs_.skip_->reset(read_rows);
+        brs_.all_rows_active_ = true;
+        brs_.end_ = (0 == read_rows);
+        if (brs_.end_) {
+          shared_state_ = SHARED_END;
+        }
+      }
+    } else {
+      brs_.size_ = 0;
+      brs_.end_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObHashGroupByVecOp::local_get_next_batch(const int64_t max_row_cnt)
 {
   int ret = OB_SUCCESS;
   bool force_by_pass = false;
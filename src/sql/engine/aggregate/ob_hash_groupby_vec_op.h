@@ -23,6 +23,7 @@
 #include "sql/engine/aggregate/ob_groupby_vec_op.h"
 #include "sql/engine/basic/ob_hp_infras_vec_op.h"
 #include "src/sql/engine/expr/ob_expr_estimate_ndv.h"
+#include "sql/engine/aggregate/ob_hash_groupby_shared_table.h"
 
 namespace oceanbase
 {
@@ -55,6 +56,34 @@ public:
   ObExpr *dup_expr;
 };
 
+class ObHashGroupByVecInput : public ObOpInput
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  ObHashGroupByVecInput(ObExecContext &ctx, const ObOpSpec &spec)
+    : ObOpInput(ctx, spec), shared_table_(0), is_owner_(false)
+  {}
+  virtual ~ObHashGroupByVecInput();
+  virtual int init(ObTaskInfo &task_info) override
+  {
+    UNUSED(task_info);
+    return common::OB_SUCCESS;
+  }
+  virtual void reset() override {}
+  // called by SQC before tasks are created, the table is destroyed with this input
+  int init_shared_table(common::ObIAllocator &alloc, const int64_t task_cnt);
+  ObHashGbySharedTable *get_shared_table()
+  {
+    return reinterpret_cast<ObHashGbySharedTable *>(shared_table_);
+  }
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObHashGroupByVecInput);
+public:
+  uint64_t shared_table_;
+  // not serialized, only the input of SQC owns the shared table
+  bool is_owner_;
+};
+
 class ObHashGroupByVecSpec : public ObGroupBySpec
 {
   OB_UNIS_VERSION_V(1);
@@ -65,7 +94,8 @@ public:
       org_dup_cols_(alloc),
       new_dup_cols_(alloc),
       dist_col_group_idxs_(alloc),
-      distinct_exprs_(alloc)
+      distinct_exprs_(alloc),
+      use_shared_table_(false)
     {
     }
 
@@ -88,6 +118,9 @@ public:
   common::ObFixedArray<ObExpr*, common::ObIAllocator> new_dup_cols_;
   common::ObFixedArray<int64_t, common::ObIAllocator> dist_col_group_idxs_;
   ExprFixedArray distinct_exprs_; // the distinct arguments of aggregate function
+  // partial group by with few groups, merge results of workers in the same SQC,
+  // see ObHashGbySharedTable
+  bool use_shared_table_;
 };
 
 // 输入数据已经按照groupby列排序
@@ -182,7 +215,13 @@ public:
       dump_add_row_selectors_item_cnt_(nullptr),
       dump_vectors_(nullptr),
       dump_rows_(nullptr),
-      need_reinit_vectors_(true)
+      need_reinit_vectors_(true),
+      shared_table_(nullptr),
+      shared_cols_(),
+      shared_iter_(),
+      shared_state_(SHARED_NONE),
+      shared_hash_vals_(nullptr),
+      shared_selector_(nullptr)
   {
   }
   void reset(bool for_rescan);
@@ -346,6 +385,9 @@ private:
   int init_by_pass_op();
 
   int process_multi_groups(aggregate::AggrRowPtr *agg_rows, const ObBatchRows &brs);
+  int local_get_next_batch(const int64_t max_row_cnt);
+  int init_shared_table();
+  int shared_get_next_batch(const int64_t max_row_cnt);
   // Alloc one batch group_row_item at a time
   static const int64_t BATCH_GROUP_ITEM_SIZE = 16;
   // const int64_t EXTEND_BKT_NUM_PUSH_DOWN = INIT_L3_CACHE_SIZE / ObExtendHashTableVec<ObGroupRowBucket>::get_sizeof_aggr_row();
@@ -431,6 +473,20 @@ private:
   common::ObFixedArray<ObIVector *, common::ObIAllocator> dump_vectors_;
   ObCompactRow **dump_rows_;
   bool need_reinit_vectors_;
+  // for merging into the table shared by workers of SQC
+  enum SharedState
+  {
+    SHARED_NONE = 0,
+    SHARED_MERGING,
+    SHARED_OUTPUT,
+    SHARED_END,
+  };
+  ObHashGbySharedTable *shared_table_;
+  ObSEArray<ObExpr *, 8> shared_cols_;
+  ObHashGbySharedTable::Iterator shared_iter_;
+  SharedState shared_state_;
+  uint64_t *shared_hash_vals_;
+  uint16_t *shared_selector_;
 };
 
 } // end namespace sql
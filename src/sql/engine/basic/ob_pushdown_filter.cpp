@@ -2431,6 +2431,16 @@ void ObDynamicFilterExecutor::locate_runtime_filter_ctx()
   runtime_filter_ctx_ = static_cast<ObExprOperatorCtx *>(eval_ctx.exec_ctx_.get_expr_op_ctx(op_id));
 }
 
+int64_t ObDynamicFilterExecutor::get_direct_topn_cnt() const
+{
+  int64_t topn_cnt = 0;
+  if (DynamicFilterType::PD_TOPN_FILTER == get_filter_node().get_dynamic_filter_type()
+      && OB_NOT_NULL(runtime_filter_ctx_)) {
+    topn_cnt = static_cast<const ObExprTopNFilterContext *>(runtime_filter_ctx_)->direct_topn_cnt_;
+  }
+  return topn_cnt;
+}
+
 int ObDynamicFilterExecutor::try_preparing_data()
 {
   int ret = OB_SUCCESS;
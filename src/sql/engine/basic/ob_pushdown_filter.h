@@ -1068,6 +1068,9 @@ public:
   inline bool is_pass_all_data() { return DynamicFilterAction::PASS_ALL == filter_action_; }
   inline bool is_check_all_data() { return DynamicFilterAction::DO_FILTER == filter_action_; }
   inline bool is_data_prepared() const { return is_data_prepared_; }
+  // for topn runtime filter, the count of rows kept by the sort directly above the table scan,
+  // 0 if the rows out of the top n can not be skipped by storage
+  int64_t get_direct_topn_cnt() const;
   inline void set_stored_data_version(int64_t data_version)
   {
     stored_data_version_ = data_version;
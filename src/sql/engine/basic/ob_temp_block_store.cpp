@@ -397,6 +397,33 @@ int ObTempBlockStore::get_block(BlockReader &reader, const int64_t block_id, con
   return ret;
 }
 
+// Only prefetch for the reader which has no block in flight, get_block() will wait the async read
+// and use the prefetched block.
+int ObTempBlockStore::prefetch_block(BlockReader &reader, const int64_t block_id)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (!reader.is_async() || block_id < 0 || block_id >= saved_block_id_cnt_) {
+    // sync reader or the block is in write buffer, nothing to prefetch
+  } else {
+    if (reader.file_size_ != file_size_) {
+      reader.reset_cursor(file_size_);
+    }
+    const int aio_buf_idx = reader.aio_buf_idx_ % BlockReader::AIO_BUF_CNT;
+    if (OB_NOT_NULL(reader.aio_blk_) || OB_NOT_NULL(reader.aio_buf_[aio_buf_idx].data())) {
+      // read is already issued
+    } else {
+      last_block_on_disk_ = true;
+      if (OB_FAIL(load_block(reader, block_id, reader.aio_blk_, last_block_on_disk_))) {
+        LOG_WARN("fail to prefetch block", K(ret), K(block_id));
+      }
+    }
+  }
+  return ret;
+}
+
 /* the compressed block is in reader.buf_.data(); we need to decompr it.
  * blk->raw_size_ is the decompressed size.  reader.read_io_handle.size is the compressd_size
  *  1. alloc a buf (decompressd size) to decompr_buf_.
@@ -1059,6 +1086,11 @@ int ObTempBlockStore::BlockReader::get_block(const int64_t block_id, const Block
   return store_->get_block(*this, block_id, blk);
 }
 
+int ObTempBlockStore::BlockReader::prefetch_block(const int64_t block_id)
+{
+  return store_->prefetch_block(*this, block_id);
+}
+
 int ObTempBlockStore::write_file(BlockIndex &bi, void *buf, int64_t size)
 {
   int ret = OB_SUCCESS;
@@ -277,8 +277,9 @@ public:
   {
     friend class ObTempBlockStore;
     friend class BlockHolder;
-    static const int AIO_BUF_CNT = 2;
   public:
+    // the block being read and the block read ahead asynchronously
+    static const int AIO_BUF_CNT = 2;
     BlockReader() : store_(NULL), idx_blk_(NULL), ib_pos_(0), file_size_(0), age_(NULL),
                     try_free_list_(NULL), blk_holder_ptr_(NULL), read_io_handle_(),
                     is_async_(true), aio_buf_idx_(0), aio_blk_(nullptr) {}
@@ -286,6 +287,8 @@ public:
 
     int init(ObTempBlockStore *store, const bool async = true);
     int get_block(const int64_t block_id, const Block *&blk);
+    // issue async read of the block without waiting, used to overlap the reads of readers
+    int prefetch_block(const int64_t block_id);
     inline int64_t get_block_cnt() const { return store_->get_block_cnt(); }
     void set_iteration_age(IterationAge *age) { age_ = age; }
     void set_blk_holder(BlockHolder *holder) { blk_holder_ptr_ = holder; }
@@ -454,6 +457,7 @@ protected:
 
 protected:
   int get_block(BlockReader &reader, const int64_t block_id, const Block *&blk);
+  int prefetch_block(BlockReader &reader, const int64_t block_id);
   /*
    * A hook interface reserved for the subclasses prepare `finish_add_row`. It can override
    * this interface to implement customized finish writing code. For example, release the memory
@@ -132,6 +132,9 @@ int ObExprCoalesce::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_expr,
   if (ob_version >= CLUSTER_VERSION_4_1_0_0) {
     rt_expr.eval_batch_func_ = calc_batch_coalesce_expr;
   }
+  if (ob_version >= CLUSTER_VERSION_4_3_2_0) {
+    rt_expr.eval_vector_func_ = calc_vector_coalesce_expr;
+  }
   return ret;
 }
 
@@ -188,6 +191,134 @@ int ObExprCoalesce::calc_batch_coalesce_expr(const ObExpr &expr, ObEvalCtx &ctx,
   return ret;
 }
 
+// copy not null values of arg to result and mark the rows done in %my_skip
+template <typename ArgVec, typename ResVec>
+static int fill_coalesce_result(const ObExpr &expr, ObEvalCtx &ctx, ObBitVector &my_skip,
+                                const EvalBound &bound, const int64_t arg_idx, int64_t &skip_cnt)
+{
+  int ret = OB_SUCCESS;
+  const ArgVec *arg_vec = static_cast<const ArgVec *>(expr.args_[arg_idx]->get_vector(ctx));
+  ResVec *res_vec = static_cast<ResVec *>(expr.get_vector(ctx));
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  for (int64_t i = bound.start(); i < bound.end(); i++) {
+    if (my_skip.at(i) || arg_vec->is_null(i)) {
+      continue;
+    }
+    res_vec->set_payload_shallow(i, arg_vec->get_payload(i), arg_vec->get_length(i));
+    eval_flags.set(i);
+    my_skip.set(i);
+    skip_cnt++;
+  }
+  return ret;
+}
+
+template <typename ResVec>
+static int dispatch_fill_coalesce_result(const ObExpr &expr, ObEvalCtx &ctx,
+                                         ObBitVector &my_skip, const EvalBound &bound,
+                                         const int64_t arg_idx, int64_t &skip_cnt)
+{
+  int ret = OB_SUCCESS;
+  switch (expr.args_[arg_idx]->get_format(ctx)) {
+    case VEC_FIXED: {
+      ret = fill_coalesce_result<ObFixedLengthBase, ResVec>(expr, ctx, my_skip, bound, arg_idx,
+                                                            skip_cnt);
+      break;
+    }
+    case VEC_DISCRETE: {
+      ret = fill_coalesce_result<ObDiscreteFormat, ResVec>(expr, ctx, my_skip, bound, arg_idx,
+                                                           skip_cnt);
+      break;
+    }
+    case VEC_CONTINUOUS: {
+      ret = fill_coalesce_result<ObContinuousFormat, ResVec>(expr, ctx, my_skip, bound, arg_idx,
+                                                             skip_cnt);
+      break;
+    }
+    case VEC_UNIFORM: {
+      ret = fill_coalesce_result<ObUniformFormat<false>, ResVec>(expr, ctx, my_skip, bound,
+                                                                 arg_idx, skip_cnt);
+      break;
+    }
+    case VEC_UNIFORM_CONST: {
+      ret = fill_coalesce_result<ObUniformFormat<true>, ResVec>(expr, ctx, my_skip, bound,
+                                                                arg_idx, skip_cnt);
+      break;
+    }
+    default: {
+      ret = fill_coalesce_result<ObVectorBase, ResVec>(expr, ctx, my_skip, bound, arg_idx,
+                                                       skip_cnt);
+    }
+  }
+  return ret;
+}
+
+template <typename ResVec>
+static int inner_calc_vector_coalesce(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  ObBitVector &my_skip = expr.get_pvt_skip(ctx);
+  EvalBound my_bound = bound;
+  const int64_t total_cnt = bound.end() - bound.start();
+  my_skip.bit_calculate(skip, eval_flags, bound,
+                        [](const uint64_t l, const uint64_t r) { return (l | r); });
+  int64_t skip_cnt = my_skip.accumulate_bit_cnt(bound);
+  // args after the first not null one are not evaluated
+  for (int64_t arg_idx = 0; OB_SUCC(ret) && skip_cnt < total_cnt && arg_idx < expr.arg_cnt_;
+       arg_idx++) {
+    if (skip_cnt > 0) {
+      my_bound.set_all_row_active(false);
+    }
+    if (OB_FAIL(expr.args_[arg_idx]->eval_vector(ctx, my_skip, my_bound))) {
+      LOG_WARN("failed to eval vector", K(ret), K(arg_idx));
+    } else if (OB_FAIL(dispatch_fill_coalesce_result<ResVec>(expr, ctx, my_skip, my_bound,
+                                                             arg_idx, skip_cnt))) {
+      LOG_WARN("failed to fill coalesce result", K(ret), K(arg_idx));
+    }
+  }
+  if (OB_SUCC(ret) && skip_cnt < total_cnt) {
+    ResVec *res_vec = static_cast<ResVec *>(expr.get_vector(ctx));
+    for (int64_t i = bound.start(); i < bound.end(); i++) {
+      if (!my_skip.at(i)) {
+        res_vec->set_null(i);
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObExprCoalesce::calc_vector_coalesce_expr(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  switch (expr.get_format(ctx)) {
+    case VEC_FIXED: {
+      ret = inner_calc_vector_coalesce<ObFixedLengthBase>(VECTOR_EVAL_FUNC_ARG_LIST);
+      break;
+    }
+    case VEC_DISCRETE: {
+      ret = inner_calc_vector_coalesce<ObDiscreteFormat>(VECTOR_EVAL_FUNC_ARG_LIST);
+      break;
+    }
+    case VEC_CONTINUOUS: {
+      ret = inner_calc_vector_coalesce<ObContinuousFormat>(VECTOR_EVAL_FUNC_ARG_LIST);
+      break;
+    }
+    case VEC_UNIFORM: {
+      ret = inner_calc_vector_coalesce<ObUniformFormat<false>>(VECTOR_EVAL_FUNC_ARG_LIST);
+      break;
+    }
+    case VEC_UNIFORM_CONST: {
+      ret = inner_calc_vector_coalesce<ObUniformFormat<true>>(VECTOR_EVAL_FUNC_ARG_LIST);
+      break;
+    }
+    default: {
+      ret = inner_calc_vector_coalesce<ObVectorBase>(VECTOR_EVAL_FUNC_ARG_LIST);
+    }
+  }
+  return ret;
+}
+
 DEF_SET_LOCAL_SESSION_VARS(ObExprCoalesce, raw_expr) {
   int ret = OB_SUCCESS;
   SET_LOCAL_SYSVAR_CAPACITY(1);
@@ -32,6 +32,7 @@ public:
                       ObExpr &rt_expr) const override;
   static int calc_batch_coalesce_expr(const ObExpr &expr, ObEvalCtx &ctx,
                                       const ObBitVector &skip, const int64_t batch_size);
+  static int calc_vector_coalesce_expr(VECTOR_EVAL_FUNC_ARG_DECL);
   DECLARE_SET_LOCAL_SESSION_VARS;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprCoalesce);
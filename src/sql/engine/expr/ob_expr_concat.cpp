@@ -359,6 +359,14 @@ int ObExprConcat::cg_expr(ObExprCGCtx &, const ObRawExpr &, ObExpr &expr) const
   }
   if (OB_SUCC(ret)) {
     expr.eval_func_ = &eval_concat;
+    // lob result or params are evaluated row by row
+    bool has_text = ob_is_text_tc(expr.datum_meta_.type_);
+    for (int64_t i = 0; !has_text && i < expr.arg_cnt_; i++) {
+      has_text = ob_is_text_tc(expr.args_[i]->datum_meta_.type_);
+    }
+    if (!has_text && GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0) {
+      expr.eval_vector_func_ = &eval_concat_vector;
+    }
   }
   return ret;
 }
@@ -497,6 +505,96 @@ int ObExprConcat::eval_concat(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_
   return ret;
 }
 
+// Same with eval_concat() for string params, params are accessed by ObIVector interface since
+// the number and formats of params are not fixed.
+template <typename ResVec>
+static int inner_eval_concat_vector(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  ResVec *res_vec = static_cast<ResVec *>(expr.get_vector(ctx));
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  int64_t max_len = 0;
+  if (is_mysql_mode()) {
+    max_len = OB_MAX_VARCHAR_LENGTH;
+  } else if (expr.is_called_in_sql_) {
+    max_len = OB_MAX_ORACLE_VARCHAR_LENGTH;
+  } else {
+    const int64_t concat_res_max_len_in_pl = 65535;
+    max_len = concat_res_max_len_in_pl;
+  }
+  for (int64_t i = bound.start(); OB_SUCC(ret) && i < bound.end(); i++) {
+    if (skip.at(i) || eval_flags.at(i)) {
+      continue;
+    }
+    ObIVector *first_not_null = NULL;
+    int64_t null_cnt = 0;
+    int64_t res_len = 0;
+    for (int64_t j = 0; j < expr.arg_cnt_; j++) {
+      ObIVector *arg_vec = expr.args_[j]->get_vector(ctx);
+      if (arg_vec->is_null(i)) {
+        null_cnt += 1;
+      } else {
+        res_len += arg_vec->get_length(i);
+        if (NULL == first_not_null) {
+          first_not_null = arg_vec;
+        }
+      }
+    }
+    if (res_len > max_len) {
+      res_vec->set_null(i);
+      ret = lib::is_oracle_mode() ? OB_ERR_TOO_LONG_STRING_IN_CONCAT : OB_SIZE_OVERFLOW;
+      LOG_WARN("size overflow", K(ret), K(res_len), K(max_len));
+    } else if (expr.arg_cnt_ == null_cnt || (!lib::is_oracle_mode() && null_cnt > 0)) {
+      res_vec->set_null(i);
+    } else if (expr.arg_cnt_ - null_cnt == 1) {
+      // only one valid input, shadow copy
+      res_vec->set_payload_shallow(i, first_not_null->get_payload(i),
+                                   first_not_null->get_length(i));
+    } else {
+      char *buf = expr.get_str_res_mem(ctx, res_len, i);
+      if (OB_ISNULL(buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate memory failed", K(ret), K(res_len));
+      } else {
+        int64_t off = 0;
+        for (int64_t j = 0; j < expr.arg_cnt_; j++) {
+          ObIVector *arg_vec = expr.args_[j]->get_vector(ctx);
+          if (!arg_vec->is_null(i)) {
+            MEMCPY(buf + off, arg_vec->get_payload(i), arg_vec->get_length(i));
+            off += arg_vec->get_length(i);
+          }
+        }
+        res_vec->set_string(i, buf, static_cast<uint32_t>(res_len));
+      }
+    }
+    eval_flags.set(i);
+  }
+  return ret;
+}
+
+int ObExprConcat::eval_concat_vector(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(expr.eval_vector_param_value(ctx, skip, bound))) {
+    LOG_WARN("evaluate parameters values failed", K(ret));
+  } else {
+    switch (expr.get_format(ctx)) {
+      case VEC_DISCRETE: {
+        ret = inner_eval_concat_vector<StrDiscVec>(VECTOR_EVAL_FUNC_ARG_LIST);
+        break;
+      }
+      case VEC_UNIFORM: {
+        ret = inner_eval_concat_vector<StrUniVec>(VECTOR_EVAL_FUNC_ARG_LIST);
+        break;
+      }
+      default: {
+        ret = inner_eval_concat_vector<ObVectorBase>(VECTOR_EVAL_FUNC_ARG_LIST);
+      }
+    }
+  }
+  return ret;
+}
+
 DEF_SET_LOCAL_SESSION_VARS(ObExprConcat, raw_expr) {
   int ret = OB_SUCCESS;
   SET_LOCAL_SYSVAR_CAPACITY(1);
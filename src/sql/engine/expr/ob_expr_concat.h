@@ -63,6 +63,7 @@ public:
                       ObExpr &rt_expr) const override;
 
   static int eval_concat(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int eval_concat_vector(VECTOR_EVAL_FUNC_ARG_DECL);
 
   DECLARE_SET_LOCAL_SESSION_VARS;
 
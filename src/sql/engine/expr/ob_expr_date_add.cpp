@@ -303,6 +303,112 @@ int ObExprDateAdjust::calc_date_adjust(const ObExpr &expr, ObEvalCtx &ctx, ObDat
   return ret;
 }
 
+// Vector version of calc_date_adjust() for datetime/timestamp/date input and datetime/date
+// result, the session variables are fetched once for the batch.
+template <typename ResVec>
+static int inner_calc_date_adjust_vector(VECTOR_EVAL_FUNC_ARG_DECL, const bool is_add)
+{
+  int ret = OB_SUCCESS;
+  ResVec *res_vec = static_cast<ResVec *>(expr.get_vector(ctx));
+  ObIVector *date_vec = expr.args_[0]->get_vector(ctx);
+  ObIVector *interval_vec = expr.args_[1]->get_vector(ctx);
+  ObIVector *unit_vec = expr.args_[2]->get_vector(ctx);
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  ObSolidifiedVarsGetter helper(expr, ctx, ctx.exec_ctx_.get_my_session());
+  ObSQLMode sql_mode = 0;
+  const ObTimeZoneInfo *tz_info = NULL;
+  if (OB_FAIL(helper.get_sql_mode(sql_mode))) {
+    LOG_WARN("get sql mode failed", K(ret));
+  } else if (OB_FAIL(helper.get_time_zone_info(tz_info))) {
+    LOG_WARN("get tz info failed", K(ret));
+  } else {
+    ObDateSqlMode date_sql_mode;
+    date_sql_mode.init(sql_mode);
+    ObTimeConvertCtx cvrt_ctx(tz_info, false);
+    const bool is_date_input = ObDateType == expr.args_[0]->datum_meta_.type_;
+    const bool is_date_res = ObDateType == expr.datum_meta_.type_;
+    for (int64_t i = bound.start(); OB_SUCC(ret) && i < bound.end(); i++) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      } else if (date_vec->is_null(i) || interval_vec->is_null(i)) {
+        res_vec->set_null(i);
+      } else {
+        int64_t dt_val = 0;
+        int64_t res_dt_val = 0;
+        ObDateUnitType unit_val = static_cast<ObDateUnitType>(unit_vec->get_int(i));
+        if (!is_date_input) {
+          dt_val = date_vec->get_datetime(i);
+        } else if (OB_FAIL(ObTimeConverter::date_to_datetime(date_vec->get_date(i), cvrt_ctx,
+                                                             dt_val))) {
+          LOG_WARN("date to datetime failed", K(ret));
+        }
+        if (OB_FAIL(ret)) {
+        } else if (OB_UNLIKELY(ObTimeConverter::ZERO_DATETIME == dt_val)) {
+          res_vec->set_null(i);
+        } else if (OB_FAIL(ObTimeConverter::date_adjust(dt_val, interval_vec->get_string(i),
+                                                        unit_val, res_dt_val, is_add,
+                                                        date_sql_mode))) {
+          if (OB_UNLIKELY(OB_INVALID_DATE_VALUE == ret || OB_TOO_MANY_DATETIME_PARTS == ret)) {
+            res_vec->set_null(i);
+            if (OB_TOO_MANY_DATETIME_PARTS == ret) {
+              LOG_USER_WARN(OB_TOO_MANY_DATETIME_PARTS);
+            }
+            ret = OB_SUCCESS;
+          }
+        } else if (is_date_res) {
+          int32_t d_val = 0;
+          if (OB_FAIL(ObTimeConverter::datetime_to_date(res_dt_val, NULL, d_val))) {
+            LOG_WARN("failed to cast datetime  to date ", K(res_dt_val), K(ret));
+          } else {
+            res_vec->set_date(i, d_val);
+          }
+        } else {
+          res_vec->set_datetime(i, res_dt_val);
+        }
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObExprDateAdjust::calc_date_adjust_vector(VECTOR_EVAL_FUNC_ARG_DECL, const bool is_add)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(expr.eval_vector_param_value(ctx, skip, bound))) {
+    LOG_WARN("evaluate parameters values failed", K(ret));
+  } else {
+    const VectorFormat res_format = expr.get_format(ctx);
+    if (VEC_FIXED == res_format && ObDateType == expr.datum_meta_.type_) {
+      ret = inner_calc_date_adjust_vector<ObFixedLengthFormat<int32_t>>(VECTOR_EVAL_FUNC_ARG_LIST,
+                                                                        is_add);
+    } else if (VEC_FIXED == res_format) {
+      ret = inner_calc_date_adjust_vector<ObFixedLengthFormat<int64_t>>(VECTOR_EVAL_FUNC_ARG_LIST,
+                                                                        is_add);
+    } else if (VEC_UNIFORM == res_format) {
+      ret = inner_calc_date_adjust_vector<ObUniformFormat<false>>(VECTOR_EVAL_FUNC_ARG_LIST,
+                                                                  is_add);
+    } else {
+      ret = inner_calc_date_adjust_vector<ObVectorBase>(VECTOR_EVAL_FUNC_ARG_LIST, is_add);
+    }
+  }
+  return ret;
+}
+
+// Only datetime/timestamp/date input with datetime/date result is vectorized, other
+// combinations need string conversions and keep the row by row evaluation.
+bool ObExprDateAdjust::can_calc_date_adjust_vector(const ObExpr &rt_expr)
+{
+  const ObObjType date_type = rt_expr.args_[0]->datum_meta_.type_;
+  const ObObjType res_type = rt_expr.datum_meta_.type_;
+  return GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0
+         && (ObDateTimeType == date_type || ObTimestampType == date_type
+             || ObDateType == date_type)
+         && (ObDateTimeType == res_type || ObDateType == res_type);
+}
+
 int ObExprDateAdjust::is_valid_for_generated_column(const ObRawExpr*expr, const common::ObIArray<ObRawExpr *> &exprs, bool &is_valid) const {
   int ret = OB_SUCCESS;
   if (OB_FAIL(check_first_param_not_time(exprs, is_valid))) {
@@ -347,6 +453,9 @@ int ObExprDateAdd::cg_expr(ObExprCGCtx &op_cg_ctx, const ObRawExpr &raw_expr, Ob
                                               K(rt_expr.args_[1]), K(rt_expr.args_[2]));
   } else {
     rt_expr.eval_func_ = ObExprDateAdd::calc_date_add;
+    if (can_calc_date_adjust_vector(rt_expr)) {
+      rt_expr.eval_vector_func_ = ObExprDateAdd::calc_date_add_vector;
+    }
   }
   return ret;
 }
@@ -356,6 +465,11 @@ int ObExprDateAdd::calc_date_add(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &ex
   return ObExprDateAdjust::calc_date_adjust(expr, ctx, expr_datum, true /* is_add */);
 }
 
+int ObExprDateAdd::calc_date_add_vector(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  return ObExprDateAdjust::calc_date_adjust_vector(VECTOR_EVAL_FUNC_ARG_LIST, true /* is_add */);
+}
+
 ObExprDateSub::ObExprDateSub(ObIAllocator &alloc)
     : ObExprDateAdjust(alloc, T_FUN_SYS_DATE_SUB, N_DATE_SUB, 3, NOT_ROW_DIMENSION)
 {}
@@ -379,6 +493,9 @@ int ObExprDateSub::cg_expr(ObExprCGCtx &op_cg_ctx, const ObRawExpr &raw_expr, Ob
               K(rt_expr.args_[1]), K(rt_expr.args_[2]));
   } else {
     rt_expr.eval_func_ = ObExprDateSub::calc_date_sub;
+    if (can_calc_date_adjust_vector(rt_expr)) {
+      rt_expr.eval_vector_func_ = ObExprDateSub::calc_date_sub_vector;
+    }
   }
   return ret;
 }
@@ -388,6 +505,11 @@ int ObExprDateSub::calc_date_sub(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &ex
   return ObExprDateAdjust::calc_date_adjust(expr, ctx, expr_datum, false /* is_add */);
 }
 
+int ObExprDateSub::calc_date_sub_vector(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  return ObExprDateAdjust::calc_date_adjust_vector(VECTOR_EVAL_FUNC_ARG_LIST, false /* is_add */);
+}
+
 ObExprAddMonths::ObExprAddMonths(ObIAllocator &alloc)
     : ObFuncExprOperator(alloc, T_FUN_SYS_ADD_MONTHS, N_ADD_MONTHS, 2, VALID_FOR_GENERATED_COL, NOT_ROW_DIMENSION)
 {
@@ -34,6 +34,8 @@ public:
                                 ObExprResType &unit,
                                 common::ObExprTypeCtx &type_ctx) const;
   static int calc_date_adjust(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum, bool is_add);
+  static int calc_date_adjust_vector(VECTOR_EVAL_FUNC_ARG_DECL, const bool is_add);
+  static bool can_calc_date_adjust_vector(const ObExpr &rt_expr);
   virtual int is_valid_for_generated_column(const ObRawExpr*expr, const common::ObIArray<ObRawExpr *> &exprs, bool &is_valid) const;
   DECLARE_SET_LOCAL_SESSION_VARS;
 private:
@@ -49,6 +51,7 @@ public:
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   static int calc_date_add(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int calc_date_add_vector(VECTOR_EVAL_FUNC_ARG_DECL);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprDateAdd);
 };
@@ -62,6 +65,7 @@ public:
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   static int calc_date_sub(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int calc_date_sub_vector(VECTOR_EVAL_FUNC_ARG_DECL);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprDateSub);
 };
@@ -63,6 +63,9 @@ int ObExprDateFormat::cg_expr(ObExprCGCtx &op_cg_ctx,
     rt_expr.eval_func_ = ObExprDateFormat::calc_date_format_invalid;
   } else {
     rt_expr.eval_func_ = ObExprDateFormat::calc_date_format;
+    if (GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0) {
+      rt_expr.eval_vector_func_ = ObExprDateFormat::calc_date_format_vector;
+    }
   }
   return ret;
 }
@@ -136,6 +139,106 @@ int ObExprDateFormat::calc_date_format(const ObExpr &expr, ObEvalCtx &ctx, ObDat
   return ret;
 }
 
+// Same with calc_date_format(), the session variables and locale are fetched once for the batch.
+template <typename ResVec>
+static int inner_calc_date_format_vector(VECTOR_EVAL_FUNC_ARG_DECL, const int64_t buf_len)
+{
+  int ret = OB_SUCCESS;
+  ResVec *res_vec = static_cast<ResVec *>(expr.get_vector(ctx));
+  ObIVector *date_vec = expr.args_[0]->get_vector(ctx);
+  ObIVector *format_vec = expr.args_[1]->get_vector(ctx);
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  const ObSQLSessionInfo *session = ctx.exec_ctx_.get_my_session();
+  ObSolidifiedVarsGetter helper(expr, ctx, session);
+  ObSQLMode sql_mode = 0;
+  const common::ObTimeZoneInfo *tz_info = NULL;
+  uint64_t cast_mode = 0;
+  ObDateSqlMode date_sql_mode;
+  ObString locale_name;
+  if (OB_ISNULL(session)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("session is null", K(ret), K(session));
+  } else if (OB_FAIL(helper.get_sql_mode(sql_mode))) {
+    LOG_WARN("get sql mode failed", K(ret));
+  } else if (OB_FAIL(helper.get_time_zone_info(tz_info))) {
+    LOG_WARN("get tz info failed", K(ret));
+  } else if (OB_FAIL(session->get_locale_name(locale_name))) {
+    LOG_WARN("failed to get locale time name", K(ret));
+  } else {
+    ObSQLUtils::get_default_cast_mode(session->get_stmt_type(), session->is_ignore_stmt(),
+                                      sql_mode, cast_mode);
+    date_sql_mode.init(sql_mode);
+    const int64_t cur_time = get_cur_time(ctx.exec_ctx_.get_physical_plan_ctx());
+    const ObObjType date_type = expr.args_[0]->datum_meta_.type_;
+    const ObScale date_scale = expr.args_[0]->datum_meta_.scale_;
+    const bool has_lob_header = expr.args_[0]->obj_meta_.has_lob_header();
+    for (int64_t i = bound.start(); OB_SUCC(ret) && i < bound.end(); i++) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      } else if (date_vec->is_null(i) || format_vec->is_null(i)) {
+        res_vec->set_null(i);
+      } else {
+        ObTime ob_time;
+        ObDatum date(date_vec->get_payload(i), date_vec->get_length(i), false);
+        ObString format = format_vec->get_string(i);
+        char *buf = NULL;
+        int64_t pos = 0;
+        bool res_null = false;
+        if (OB_FAIL(ob_datum_to_ob_time_with_date(date, date_type, date_scale, tz_info, ob_time,
+                                                  cur_time, date_sql_mode, has_lob_header))) {
+          LOG_WARN("failed to convert datum to ob time");
+          if (CM_IS_WARN_ON_FAIL(cast_mode) && OB_ALLOCATE_MEMORY_FAILED != ret) {
+            ret = OB_SUCCESS;
+            res_vec->set_null(i);
+          }
+        } else if (OB_UNLIKELY(format.empty())) {
+          res_vec->set_null(i);
+        } else if (OB_ISNULL(buf = expr.get_str_res_mem(ctx, buf_len, i))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("no more memory to alloc for buf", K(ret));
+        } else if (OB_FAIL(ObTimeConverter::ob_time_to_str_format(ob_time, format, buf, buf_len,
+                                                                  pos, res_null, locale_name))) {
+          LOG_WARN("failed to convert ob time to str with format");
+        } else if (res_null) {
+          res_vec->set_null(i);
+        } else {
+          res_vec->set_string(i, buf, static_cast<int32_t>(pos));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObExprDateFormat::calc_date_format_vector(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(expr.eval_vector_param_value(ctx, skip, bound))) {
+    LOG_WARN("evaluate parameters values failed", K(ret));
+  } else {
+    switch (expr.get_format(ctx)) {
+      case VEC_DISCRETE: {
+        ret = inner_calc_date_format_vector<StrDiscVec>(VECTOR_EVAL_FUNC_ARG_LIST,
+                                                        OB_MAX_DATE_FORMAT_BUF_LEN);
+        break;
+      }
+      case VEC_UNIFORM: {
+        ret = inner_calc_date_format_vector<StrUniVec>(VECTOR_EVAL_FUNC_ARG_LIST,
+                                                       OB_MAX_DATE_FORMAT_BUF_LEN);
+        break;
+      }
+      default: {
+        ret = inner_calc_date_format_vector<ObVectorBase>(VECTOR_EVAL_FUNC_ARG_LIST,
+                                                          OB_MAX_DATE_FORMAT_BUF_LEN);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObExprDateFormat::calc_date_format_invalid(const ObExpr &expr, ObEvalCtx &ctx,
                                                ObDatum &expr_datum)
 {
@@ -1367,6 +1367,7 @@ static ObExpr::EvalBatchFunc g_expr_eval_batch_functions[] = {
   NULL, // ObExprMinus::minus_vec_vec_batch,                          /* 134 */
   NULL, // ObExprMul::mul_vec_vec_batch,                              /* 135 */
   NULL, // ObExprDiv::div_vec_batch,                                  /* 136 */
+  ObExprRegexpLike::eval_regexp_like_batch,                           /* 137 */
 };
 
 static ObExpr::EvalVectorFunc g_expr_eval_vector_functions[] = {
@@ -1486,6 +1487,17 @@ static ObExpr::EvalVectorFunc g_expr_eval_vector_functions[] = {
   NULL,//ObRelationalExprOperator::eval_vector_min_max_compare, /* 113 */
   ObExprCeilFloor::calc_ceil_floor_vector,                      /* 114 */
   ObExprRepeat::eval_repeat_vector,                             /* 115 */
+  ObExprRegexpLike::eval_regexp_like_vector,                    /* 116 */
+  ObExprIs::calc_vector_is_null,                                /* 117 */
+  ObExprIsNot::calc_vector_is_not_null,                         /* 118 */
+  ObExprCoalesce::calc_vector_coalesce_expr,                    /* 119 */
+  ObExprNvlUtil::calc_nvl_expr_vector,                          /* 120 */
+  ObExprConcat::eval_concat_vector,                             /* 121 */
+  ObExprDateFormat::calc_date_format_vector,                    /* 122 */
+  ObExprToCharCommon::eval_oracle_to_char_vector,               /* 123 */
+  ObExprJsonExtract::eval_json_extract_vector,                  /* 124 */
+  ObExprDateAdd::calc_date_add_vector,                          /* 125 */
+  ObExprDateSub::calc_date_sub_vector,                          /* 126 */
 };
 
 REG_SER_FUNC_ARRAY(OB_SFA_SQL_EXPR_EVAL,
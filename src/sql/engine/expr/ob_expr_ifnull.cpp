@@ -17,6 +17,7 @@
 #include "share/object/ob_obj_cast.h"
 
 #include "sql/engine/expr/ob_expr_promotion_util.h"
+#include "sql/engine/expr/ob_expr_nvl.h"
 #include "sql/session/ob_sql_session_info.h"
 
 
@@ -126,6 +127,10 @@ int ObExprIfNull::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_expr,
   UNUSED(expr_cg_ctx);
   UNUSED(raw_expr);
   rt_expr.eval_func_ = calc_ifnull_expr;
+  // ifnull(arg0, arg1) is evaluated as nvl, arg1 is evaluated for null rows of arg0 only.
+  if (GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0) {
+    rt_expr.eval_vector_func_ = ObExprNvlUtil::calc_nvl_expr_vector;
+  }
   return ret;
 }
 } // namespace sql
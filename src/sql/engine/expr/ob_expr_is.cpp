@@ -284,6 +284,9 @@ int ObExprIs::cg_expr(ObExprCGCtx &op_cg_ctx, const ObRawExpr &raw_expr, ObExpr
       rt_expr.eval_func_ = ObExprIs::calc_collection_is_null;
     } else {
       rt_expr.eval_func_ = ObExprIs::calc_is_null;
+      if (GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0) {
+        rt_expr.eval_vector_func_ = ObExprIs::calc_vector_is_null;
+      }
     }
   } else if (param2->get_value().is_true()) {
     if (OB_FAIL(cg_result_type_class(param1_type, rt_expr.eval_func_, false, true))) {
@@ -329,6 +332,9 @@ int ObExprIsNot::cg_expr(ObExprCGCtx &op_cg_ctx, const ObRawExpr &raw_expr, ObEx
       if (GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_1_0_0) {
         rt_expr.eval_batch_func_ = ObExprIsNot::calc_batch_is_not_null;
       }
+      if (GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0) {
+        rt_expr.eval_vector_func_ = ObExprIsNot::calc_vector_is_not_null;
+      }
     }
   } else if (param2->get_value().is_true()) {
     if (OB_FAIL(cg_result_type_class(param1_type, rt_expr.eval_func_, true, true))) {
@@ -455,6 +461,89 @@ int ObExprIsNot::calc_batch_is_not_null(const ObExpr &expr, ObEvalCtx &ctx,
   return ret;
 }
 
+template <typename ArgVec, typename ResVec, bool IS_NOT>
+static int inner_eval_vector_is_null(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  const ArgVec *arg_vec = static_cast<const ArgVec *>(expr.args_[0]->get_vector(ctx));
+  ResVec *res_vec = static_cast<ResVec *>(expr.get_vector(ctx));
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  for (int64_t i = bound.start(); i < bound.end(); i++) {
+    if (skip.at(i) || eval_flags.at(i)) {
+      continue;
+    }
+    res_vec->set_int(i, static_cast<int64_t>(arg_vec->is_null(i) != IS_NOT));
+    eval_flags.set(i);
+  }
+  return ret;
+}
+
+template <typename ResVec, bool IS_NOT>
+static int dispatch_eval_vector_is_null(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  switch (expr.args_[0]->get_format(ctx)) {
+    case VEC_FIXED: {
+      ret = inner_eval_vector_is_null<ObFixedLengthBase, ResVec, IS_NOT>(VECTOR_EVAL_FUNC_ARG_LIST);
+      break;
+    }
+    case VEC_DISCRETE: {
+      ret = inner_eval_vector_is_null<ObDiscreteFormat, ResVec, IS_NOT>(VECTOR_EVAL_FUNC_ARG_LIST);
+      break;
+    }
+    case VEC_CONTINUOUS: {
+      ret = inner_eval_vector_is_null<ObContinuousFormat, ResVec, IS_NOT>(VECTOR_EVAL_FUNC_ARG_LIST);
+      break;
+    }
+    case VEC_UNIFORM: {
+      ret = inner_eval_vector_is_null<ObUniformFormat<false>, ResVec, IS_NOT>(VECTOR_EVAL_FUNC_ARG_LIST);
+      break;
+    }
+    case VEC_UNIFORM_CONST: {
+      ret = inner_eval_vector_is_null<ObUniformFormat<true>, ResVec, IS_NOT>(VECTOR_EVAL_FUNC_ARG_LIST);
+      break;
+    }
+    default: {
+      ret = inner_eval_vector_is_null<ObVectorBase, ResVec, IS_NOT>(VECTOR_EVAL_FUNC_ARG_LIST);
+    }
+  }
+  return ret;
+}
+
+template <bool IS_NOT>
+static int eval_vector_is_null(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(expr.args_[0]->eval_vector(ctx, skip, bound))) {
+    LOG_WARN("failed to eval vector args", K(ret));
+  } else {
+    switch (expr.get_format(ctx)) {
+      case VEC_FIXED: {
+        ret = dispatch_eval_vector_is_null<IntegerFixedVec, IS_NOT>(VECTOR_EVAL_FUNC_ARG_LIST);
+        break;
+      }
+      case VEC_UNIFORM: {
+        ret = dispatch_eval_vector_is_null<IntegerUniVec, IS_NOT>(VECTOR_EVAL_FUNC_ARG_LIST);
+        break;
+      }
+      default: {
+        ret = dispatch_eval_vector_is_null<ObVectorBase, IS_NOT>(VECTOR_EVAL_FUNC_ARG_LIST);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObExprIs::calc_vector_is_null(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  return eval_vector_is_null<false>(VECTOR_EVAL_FUNC_ARG_LIST);
+}
+
+int ObExprIsNot::calc_vector_is_not_null(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  return eval_vector_is_null<true>(VECTOR_EVAL_FUNC_ARG_LIST);
+}
+
 int ObExprIsNot::calc_is_not_infinite(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum)
 {
   int ret = OB_SUCCESS;
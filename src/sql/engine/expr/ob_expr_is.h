@@ -70,6 +70,7 @@ class ObExprIs: public ObExprIsBase
   static int calc_is_date_int_null(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
 
   static int calc_is_null(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int calc_vector_is_null(VECTOR_EVAL_FUNC_ARG_DECL);
   static int int_is_true(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
   static int int_is_false(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
   static int json_is_true(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
@@ -123,6 +124,7 @@ public:
 
   static int calc_batch_is_not_null(const ObExpr &expr, ObEvalCtx &ctx,
                                     const ObBitVector &skip, const int64_t batch_size);
+  static int calc_vector_is_not_null(VECTOR_EVAL_FUNC_ARG_DECL);
   static int decimal_int_is_not_true(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
   static int decimal_int_is_not_false(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
 private:
@@ -98,21 +98,50 @@ int ObExprJsonExtract::eval_json_extract_null(const ObExpr &expr, ObEvalCtx &ctx
 int ObExprJsonExtract::eval_json_extract(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res)
 {
   int ret = OB_SUCCESS;
-  ObDatum *json_datum = NULL;
+  ObEvalCtx::TempAllocGuard tmp_alloc_g(ctx);
+  common::ObArenaAllocator &allocator = tmp_alloc_g.get_allocator();
+  ObSEArray<ObDatum, 4> args;
+  if (expr.datum_meta_.cs_type_ != CS_TYPE_UTF8MB4_BIN) {
+    ret = OB_ERR_INVALID_JSON_CHARSET;
+    LOG_WARN("invalid out put charset", K(ret), K(expr.datum_meta_.cs_type_));
+    LOG_WARN("fail to handle json param 0 in json extract in new sql engine", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < expr.arg_cnt_; i++) {
+      ObDatum *datum = NULL;
+      if (OB_FAIL(expr.args_[i]->eval(ctx, datum))) {
+        LOG_WARN("eval json extract arg failed", K(ret), K(i));
+      } else if (OB_FAIL(args.push_back(*datum))) {
+        LOG_WARN("push back failed", K(ret));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    ObJsonPathCache ctx_cache(&allocator);
+    ObJsonPathCache* path_cache = ObJsonExprHelper::get_path_cache_ctx(expr.expr_ctx_id_, &ctx.exec_ctx_);
+    path_cache = ((path_cache != NULL) ? path_cache : &ctx_cache);
+    if (OB_FAIL(calc_json_extract(expr, ctx, allocator, *path_cache, args, res))) {
+      LOG_WARN("calc json extract failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObExprJsonExtract::calc_json_extract(const ObExpr &expr,
+                                         ObEvalCtx &ctx,
+                                         ObIAllocator &allocator,
+                                         ObJsonPathCache &path_cache,
+                                         const ObIArray<ObDatum> &args,
+                                         ObDatum &res)
+{
+  int ret = OB_SUCCESS;
+  const ObDatum &json_datum = args.at(0);
   ObExpr *json_arg = expr.args_[0];
   ObObjType val_type = json_arg->datum_meta_.type_;
   ObCollationType cs_type = json_arg->datum_meta_.cs_type_;
   ObIJsonBase *j_base = NULL;
   bool is_null_result = false;
   bool may_match_many = (expr.arg_cnt_ > 2);
-  ObEvalCtx::TempAllocGuard tmp_alloc_g(ctx);
-  common::ObArenaAllocator &allocator = tmp_alloc_g.get_allocator();
-  if (expr.datum_meta_.cs_type_ != CS_TYPE_UTF8MB4_BIN) {
-    ret = OB_ERR_INVALID_JSON_CHARSET;
-    LOG_WARN("invalid out put charset", K(ret), K(expr.datum_meta_.cs_type_));
-  } else if (OB_UNLIKELY(OB_FAIL(json_arg->eval(ctx, json_datum)))) {
-    LOG_WARN("eval json arg failed", K(ret));
-  } else if (json_datum->is_null()) {
+  if (json_datum.is_null()) {
     is_null_result = true; // mysql return NULL result
   } else if (val_type != ObJsonType && ob_is_string_type(val_type) == false) {
     ret = OB_ERR_INVALID_TYPE_FOR_JSON;
@@ -120,9 +149,11 @@ int ObExprJsonExtract::eval_json_extract(const ObExpr &expr, ObEvalCtx &ctx, ObD
   } else if (OB_FAIL(ObJsonExprHelper::ensure_collation(val_type, cs_type))) {
     LOG_WARN("fail to ensure collation", K(ret), K(val_type), K(cs_type));
   } else {
-    ObString j_str = json_datum->get_string();
+    ObString j_str;
     ObJsonInType j_in_type = ObJsonExprHelper::get_json_internal_type(val_type);
-    if (OB_FAIL(ObJsonExprHelper::get_json_or_str_data(json_arg, ctx, allocator, j_str, is_null_result))) {
+    if (OB_FAIL(ObTextStringHelper::read_real_string_data(allocator, json_datum,
+                json_arg->datum_meta_, json_arg->obj_meta_.has_lob_header(), j_str,
+                &ctx.exec_ctx_))) {
       LOG_WARN("fail to get real data.", K(ret), K(j_str));
     } else if (OB_FAIL(ObJsonBaseFactory::get_json_base(&allocator, j_str, j_in_type, j_in_type, j_base))) {
       LOG_WARN("fail to get json base", K(ret), K(j_in_type));
@@ -133,7 +164,6 @@ int ObExprJsonExtract::eval_json_extract(const ObExpr &expr, ObEvalCtx &ctx, ObD
   if (OB_UNLIKELY(OB_FAIL(ret))) {
     if (ret == OB_ERR_INVALID_TYPE_FOR_JSON) {
       LOG_USER_ERROR(OB_ERR_INVALID_TYPE_FOR_JSON, 1, "json_extract");
-    } else if (ret == OB_ERR_INVALID_JSON_CHARSET) {
     } else {
       ret = OB_ERR_INVALID_JSON_TEXT_IN_PARAM;
       LOG_USER_ERROR(OB_ERR_INVALID_JSON_TEXT_IN_PARAM);
@@ -144,22 +174,19 @@ int ObExprJsonExtract::eval_json_extract(const ObExpr &expr, ObEvalCtx &ctx, ObD
     ObJsonSeekResult hits;
     ObJsonBin res_json(&allocator);
     hit.res_point_ = &res_json;
-    ObJsonPathCache ctx_cache(&allocator);
-    ObJsonPathCache* path_cache = ObJsonExprHelper::get_path_cache_ctx(expr.expr_ctx_id_, &ctx.exec_ctx_);
-    path_cache = ((path_cache != NULL) ? path_cache : &ctx_cache);
     for (int64_t i = 1; OB_SUCC(ret) && (!is_null_result) && i < expr.arg_cnt_; i++) {
       hit.reset();
-      ObDatum *path_data = NULL;
-      if (OB_FAIL(expr.args_[i]->eval(ctx, path_data))) {
-        LOG_WARN("eval json path datum failed", K(ret));
-      } else if (path_data->is_null()) {
+      const ObDatum &path_data = args.at(i);
+      if (path_data.is_null()) {
         is_null_result = true;
       } else {
-        ObString path_text = path_data->get_string();
+        ObString path_text;
         ObJsonPath *j_path = NULL;
-        if (OB_FAIL(ObJsonExprHelper::get_json_or_str_data(expr.args_[i], ctx, allocator, path_text, is_null_result))) {
+        if (OB_FAIL(ObTextStringHelper::read_real_string_data(allocator, path_data,
+                    expr.args_[i]->datum_meta_, expr.args_[i]->obj_meta_.has_lob_header(),
+                    path_text, &ctx.exec_ctx_))) {
           LOG_WARN("fail to get real data.", K(ret), K(path_text));
-        } else if (OB_FAIL(ObJsonExprHelper::find_and_add_cache(path_cache, j_path, path_text, i, true))) {
+        } else if (OB_FAIL(ObJsonExprHelper::find_and_add_cache(&path_cache, j_path, path_text, i, true))) {
           LOG_WARN("parse text to path failed", K(path_text), K(ret));
         } else if (OB_FAIL(j_base->seek(*j_path, j_path->path_node_cnt(), true, false, hit))) {
           LOG_WARN("json seek failed", K(path_text), K(ret));
@@ -226,6 +253,59 @@ int ObExprJsonExtract::eval_json_extract(const ObExpr &expr, ObEvalCtx &ctx, ObD
   return ret;
 }
 
+// The path params are usually constants, their parsed paths are kept in the path cache, and the
+// memory of json documents is released row by row in the batch.
+int ObExprJsonExtract::eval_json_extract_vector(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  ObIVector *res_vec = expr.get_vector(ctx);
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  if (expr.datum_meta_.cs_type_ != CS_TYPE_UTF8MB4_BIN) {
+    ret = OB_ERR_INVALID_JSON_CHARSET;
+    LOG_WARN("invalid out put charset", K(ret), K(expr.datum_meta_.cs_type_));
+  } else if (OB_FAIL(expr.eval_vector_param_value(ctx, skip, bound))) {
+    LOG_WARN("evaluate parameters values failed", K(ret));
+  } else {
+    ObEvalCtx::TempAllocGuard tmp_alloc_g(ctx);
+    ObJsonPathCache ctx_cache(&tmp_alloc_g.get_allocator());
+    ObJsonPathCache* path_cache = ObJsonExprHelper::get_path_cache_ctx(expr.expr_ctx_id_, &ctx.exec_ctx_);
+    path_cache = ((path_cache != NULL) ? path_cache : &ctx_cache);
+    common::ObArenaAllocator row_allocator(ObModIds::OB_LOB_ACCESS_BUFFER,
+                                           OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID());
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+    batch_info_guard.set_batch_size(bound.batch_size());
+    ObSEArray<ObDatum, 4> args;
+    for (int64_t j = 0; OB_SUCC(ret) && j < expr.arg_cnt_; j++) {
+      if (OB_FAIL(args.push_back(ObDatum()))) {
+        LOG_WARN("push back failed", K(ret));
+      }
+    }
+    for (int64_t i = bound.start(); OB_SUCC(ret) && i < bound.end(); i++) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      ObDatum res;
+      batch_info_guard.set_batch_idx(i);
+      row_allocator.reuse();
+      for (int64_t j = 0; j < expr.arg_cnt_; j++) {
+        ObIVector *arg_vec = expr.args_[j]->get_vector(ctx);
+        args.at(j) = ObDatum(arg_vec->get_payload(i), arg_vec->get_length(i), arg_vec->is_null(i));
+      }
+      if (OB_FAIL(calc_json_extract(expr, ctx, row_allocator, *path_cache, args, res))) {
+        LOG_WARN("calc json extract failed", K(ret), K(i));
+      } else {
+        if (res.is_null()) {
+          res_vec->set_null(i);
+        } else {
+          res_vec->set_payload_shallow(i, res.ptr_, res.len_);
+        }
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObExprJsonExtract::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_expr,
                                ObExpr &rt_expr) const
 {
@@ -235,6 +315,9 @@ int ObExprJsonExtract::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_ex
       rt_expr.eval_func_ = eval_json_extract_null;
   } else {
       rt_expr.eval_func_ = eval_json_extract;
+      if (GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0) {
+        rt_expr.eval_vector_func_ = eval_json_extract_vector;
+      }
   }
   return OB_SUCCESS;
 }
@@ -20,6 +20,10 @@ using namespace oceanbase::common;
 
 namespace oceanbase
 {
+namespace common
+{
+class ObJsonPathCache;
+}
 namespace sql
 {
 class ObExprJsonExtract : public ObFuncExprOperator
@@ -34,11 +38,19 @@ public:
                                 common::ObExprTypeCtx& type_ctx) const override;
   static int eval_json_extract(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res);
   static int eval_json_extract_null(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res);
+  static int eval_json_extract_vector(VECTOR_EVAL_FUNC_ARG_DECL);
   virtual int cg_expr(ObExprCGCtx &expr_cg_ctx,
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   virtual bool need_rt_ctx() const override { return true; }
   private:
+    // extract from json doc args[0] by the paths args[1, arg_cnt_)
+    static int calc_json_extract(const ObExpr &expr,
+                                 ObEvalCtx &ctx,
+                                 common::ObIAllocator &allocator,
+                                 common::ObJsonPathCache &path_cache,
+                                 const common::ObIArray<ObDatum> &args,
+                                 ObDatum &res);
     DISALLOW_COPY_AND_ASSIGN(ObExprJsonExtract);
 };
 
@@ -18,6 +18,7 @@
 #include "sql/session/ob_sql_session_info.h"
 #include "sql/engine/expr/ob_expr_result_type_util.h"
 #include "sql/engine/expr/ob_expr_is.h"
+#include "sql/engine/expr/ob_expr_coalesce.h"
 #include <math.h>
 
 namespace oceanbase
@@ -421,6 +422,12 @@ int ObExprNvlUtil::calc_nvl_expr_batch(const ObExpr &expr,
   return ret;
 }
 
+int ObExprNvlUtil::calc_nvl_expr_vector(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  // nvl(arg0, arg1) is coalesce(arg0, arg1), arg1 is evaluated for null rows of arg0 only.
+  return ObExprCoalesce::calc_vector_coalesce_expr(VECTOR_EVAL_FUNC_ARG_LIST);
+}
+
 int ObExprNvlUtil::calc_nvl_expr2(const ObExpr &expr, ObEvalCtx &ctx,
                                   ObDatum &res_datum)
 {
@@ -448,6 +455,9 @@ int ObExprNvl::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_expr,
   UNUSED(raw_expr);
   rt_expr.eval_func_ = ObExprNvlUtil::calc_nvl_expr;
   rt_expr.eval_batch_func_ = ObExprNvlUtil::calc_nvl_expr_batch;
+  if (GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0) {
+    rt_expr.eval_vector_func_ = ObExprNvlUtil::calc_nvl_expr_vector;
+  }
   return ret;
 }
 
@@ -459,6 +469,9 @@ int ObExprOracleNvl::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_expr
   UNUSED(raw_expr);
   rt_expr.eval_func_ = ObExprNvlUtil::calc_nvl_expr;
   rt_expr.eval_batch_func_ = ObExprNvlUtil::calc_nvl_expr_batch;
+  if (GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0) {
+    rt_expr.eval_vector_func_ = ObExprNvlUtil::calc_nvl_expr_vector;
+  }
   return ret;
 }
 
@@ -33,6 +33,7 @@ public:
                                   ObEvalCtx &ctx,
                                   const ObBitVector &skip,
                                   const int64_t batch_size);
+  static int calc_nvl_expr_vector(VECTOR_EVAL_FUNC_ARG_DECL);
   // for nvl2()
   static int calc_nvl_expr2(const ObExpr &expr, ObEvalCtx &ctx,
                             ObDatum &res_datum);
@@ -504,6 +504,11 @@ int ObExprToCharCommon::cg_expr(ObExprCGCtx &expr_cg_ctx,
           && !rt_expr.args_[1]->is_batch_result()
           && !rt_expr.args_[2]->is_batch_result())) {
     rt_expr.eval_batch_func_ = eval_oracle_to_char_batch;
+    // lob result is evaluated row by row
+    if (!ob_is_text_tc(rt_expr.datum_meta_.type_)
+        && GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0) {
+      rt_expr.eval_vector_func_ = eval_oracle_to_char_vector;
+    }
   }
 
   return ret;
@@ -727,6 +732,134 @@ int ObExprToCharCommon::eval_oracle_to_char_batch(
   return ret;
 }
 
+// Same with eval_oracle_to_char_batch(), the input is accessed by ObIVector interface.
+int ObExprToCharCommon::eval_oracle_to_char_vector(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  ObIVector *res_vec = expr.get_vector(ctx);
+  ObDatum *fmt_datum = NULL;
+  ObDatum *nlsparam_datum = NULL;
+  bool is_result_all_null = false;
+  // if the second arg or the third arg is null, all the results are null
+  if (2 == expr.arg_cnt_ || 3 == expr.arg_cnt_) {
+    if (OB_FAIL(expr.args_[1]->eval(ctx, fmt_datum))) {
+      LOG_WARN("eval fmt_datum failed", K(ret));
+    } else if (fmt_datum->is_null()) {
+      is_result_all_null = true;
+    } else if (3 == expr.arg_cnt_) {
+      if (OB_FAIL(expr.args_[2]->eval(ctx, nlsparam_datum))) {
+        LOG_WARN("eval nlsparam_datum failed", K(ret));
+      } else if (nlsparam_datum->is_null()) {
+        is_result_all_null = true;
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (is_result_all_null) {
+    for (int64_t i = bound.start(); i < bound.end(); ++i) {
+      if (!skip.at(i) && !eval_flags.at(i)) {
+        res_vec->set_null(i);
+        eval_flags.set(i);
+      }
+    }
+  } else if (OB_FAIL(expr.args_[0]->eval_vector(ctx, skip, bound))) {
+    LOG_WARN("failed to eval vector result args0", K(ret));
+  } else {
+    ObIVector *input_vec = expr.args_[0]->get_vector(ctx);
+    const ObObjTypeClass input_tc = ob_obj_type_class(expr.args_[0]->datum_meta_.type_);
+    const bool is_datetime = (ObDateTimeTC == input_tc || ObOTimestampTC == input_tc);
+    const ObCollationType src_coll_type = is_datetime
+                                          ? ctx.exec_ctx_.get_my_session()->get_nls_collation()
+                                          : CS_TYPE_UTF8MB4_BIN;
+    ObString fmt;
+    ObString nlsparam;
+    ObEvalCtx::TempAllocGuard alloc_guard(ctx);
+    ObIAllocator &alloc = alloc_guard.get_allocator();
+    // convert the fmt && nlsparam to utf8 first.
+    if (NULL != fmt_datum) {
+      OZ(ObExprUtil::convert_string_collation(fmt_datum->get_string(),
+                                              expr.args_[1]->datum_meta_.cs_type_,
+                                              fmt, CS_TYPE_UTF8MB4_BIN, alloc));
+    }
+    if (OB_FAIL(ret) || NULL == nlsparam_datum) {
+    } else if (ObIntTC == input_tc || ObFloatTC == input_tc || ObDoubleTC == input_tc
+               || ObNumberTC == input_tc || ObDecimalIntTC == input_tc) {
+      nlsparam = nlsparam_datum->get_string();
+    } else {
+      OZ(ObExprUtil::convert_string_collation(nlsparam_datum->get_string(),
+                                              expr.args_[2]->datum_meta_.cs_type_,
+                                              nlsparam, CS_TYPE_UTF8MB4_BIN, alloc));
+    }
+    if (OB_FAIL(ret)) {
+    } else if (1 == expr.arg_cnt_ && (ObStringTC == input_tc || ObTextTC == input_tc)) {
+      for (int64_t i = bound.start(); i < bound.end(); ++i) {
+        if (skip.at(i) || eval_flags.at(i)) {
+          continue;
+        } else if (input_vec->is_null(i)) {
+          res_vec->set_null(i);
+        } else {
+          res_vec->set_payload_shallow(i, input_vec->get_payload(i), input_vec->get_length(i));
+        }
+        eval_flags.set(i);
+      }
+    } else {
+      ObString res;
+      ObDatum res_datum;
+      for (int64_t i = bound.start(); OB_SUCC(ret) && i < bound.end(); ++i) {
+        if (skip.at(i) || eval_flags.at(i)) {
+          continue;
+        } else if (input_vec->is_null(i)) {
+          res_vec->set_null(i);
+          eval_flags.set(i);
+        } else {
+          ObDatum input(input_vec->get_payload(i), input_vec->get_length(i), false);
+          switch (input_tc) {
+            case ObDateTimeTC:
+            case ObOTimestampTC: {
+              OZ(datetime_to_char(expr, ctx, alloc, input, fmt, nlsparam, res));
+              break;
+            }
+            case ObIntervalTC: {
+              OZ(interval_to_char(expr, ctx, alloc, input, fmt, nlsparam, res));
+              break;
+            }
+            case ObIntTC: // to support PLS_INTERGER type
+            case ObFloatTC:
+            case ObDoubleTC:
+            case ObNumberTC:
+            case ObDecimalIntTC: {
+              if (OB_FAIL(is_valid_to_char_number(expr))) {
+                LOG_WARN("fail to check num format", K(ret));
+              } else if (OB_FAIL(number_to_char(expr, ctx, alloc, input, fmt, nlsparam, res))) {
+                LOG_WARN("number to char failed", K(ret));
+              }
+              break;
+            }
+            default: {
+              ret = OB_ERR_INVALID_TYPE_FOR_OP;
+              LOG_WARN("unsupported to_char", K(ret), K(input_tc));
+            }
+          }
+          if (OB_FAIL(ret)) {
+          } else if (OB_FAIL(ObExprUtil::set_expr_ascii_result(expr, ctx, res_datum, res, i,
+                                                               !is_datetime, src_coll_type))) {
+            LOG_WARN("set expr ascii result failed", K(ret));
+          } else {
+            if (res_datum.is_null()) {
+              res_vec->set_null(i);
+            } else {
+              res_vec->set_string(i, res_datum.ptr_, res_datum.len_);
+            }
+            eval_flags.set(i);
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObExprToCharCommon::is_valid_to_char_number(const ObExpr &expr)
 {
   int ret = OB_SUCCESS;
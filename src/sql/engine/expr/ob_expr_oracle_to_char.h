@@ -49,6 +49,7 @@ public:
   // for static engine batch
   static int eval_oracle_to_char_batch(
       const ObExpr &expr, ObEvalCtx &ctx, const ObBitVector &skip, const int64_t batch_size);
+  static int eval_oracle_to_char_vector(VECTOR_EVAL_FUNC_ARG_DECL);
   DECLARE_SET_LOCAL_SESSION_VARS;
 
 protected:
@@ -54,6 +54,7 @@ void ObExprRegexContext::destroy()
       uregex_close(regexp_engine_);
       regexp_engine_ = NULL;
     }
+    dfa_.reset();
   }
 }
 
@@ -151,6 +152,16 @@ int ObExprRegexContext::init(ObExprStringBuf &string_buf,
         inited_ = true;
       }
     }
+    // the compiled DFA is worthwhile only if the pattern is reused by rows
+    bool dfa_supported = false;
+    if (OB_SUCC(ret) && reusable) {
+      dfa_allocator_.prepare(string_buf);
+      if (OB_FAIL(dfa_.init(dfa_allocator_, pattern_, cflags, dfa_supported))) {
+        LOG_WARN("failed to init regexp dfa", K(ret));
+      } else {
+        LOG_TRACE("init regexp dfa", K(dfa_supported), K_(dfa));
+      }
+    }
   }
   return ret;
 }
@@ -164,10 +175,13 @@ int ObExprRegexContext::match(ObExprStringBuf &string_buf,
   UChar *u_text = NULL;
   int32_t u_text_length = 0;
   UErrorCode m_error_code = U_ZERO_ERROR;
+  ObExprRegexDfa::MatchResult dfa_res = ObExprRegexDfa::UNDECIDED;
   result = false;
   if (OB_UNLIKELY(!inited_) || OB_ISNULL(regexp_engine_)) {
     ret = OB_NOT_INIT;
     LOG_WARN("regexp context not inited yet", K(ret), K(inited_), K(regexp_engine_));
+  } else if (0 == start && ObExprRegexDfa::UNDECIDED != (dfa_res = dfa_match(text, true))) {
+    result = (ObExprRegexDfa::MATCH == dfa_res);
   } else if (OB_FAIL(get_valid_unicode_string(string_buf, text, u_text, u_text_length))) {
     LOG_WARN("failed to get valid unicode string", K(ret));
   } else {
@@ -197,6 +211,8 @@ int ObExprRegexContext::find(ObExprStringBuf &string_buf,
   if (OB_UNLIKELY(!inited_) || OB_ISNULL(regexp_engine_)) {
     ret = OB_NOT_INIT;
     LOG_WARN("regexp context not inited yet", K(ret), K(inited_), K(regexp_engine_));
+  } else if (0 == start && ObExprRegexDfa::NOT_MATCH == dfa_match(text, true)) {
+    // no match at all
   } else if (OB_FAIL(get_valid_unicode_string(string_buf, text, u_text, u_text_length))) {
     LOG_WARN("failed to get valid unicode string", K(ret));
   } else if (0 == u_text_length) {
@@ -245,6 +261,8 @@ int ObExprRegexContext::count(ObExprStringBuf &string_buf,
   if (OB_UNLIKELY(!inited_) || OB_ISNULL(regexp_engine_)) {
     ret = OB_NOT_INIT;
     LOG_WARN("regexp context not inited yet", K(ret), K(inited_), K(regexp_engine_));
+  } else if (0 == start && ObExprRegexDfa::NOT_MATCH == dfa_match(text, true)) {
+    // no match at all
   } else if (OB_FAIL(get_valid_unicode_string(string_buf, text, u_text, u_text_length))) {
     LOG_WARN("failed to get valid unicode string", K(ret));
   } else if (0 == u_text_length) {
@@ -282,6 +300,8 @@ int ObExprRegexContext::substr(ObExprStringBuf &string_buf,
   if (OB_UNLIKELY(!inited_) || OB_ISNULL(regexp_engine_)) {
     ret = OB_NOT_INIT;
     LOG_WARN("regexp context not inited yet", K(ret), K(inited_), K(regexp_engine_));
+  } else if (0 == start && ObExprRegexDfa::NOT_MATCH == dfa_match(text, true)) {
+    // no match at all
   } else if (OB_FAIL(get_valid_unicode_string(string_buf, text, u_text, u_text_length))) {
     LOG_WARN("failed to get valid unicode string", K(ret));
   } else {
@@ -334,6 +354,8 @@ int ObExprRegexContext::replace(ObExprStringBuf &string_buf,
   if (OB_UNLIKELY(!inited_) || OB_ISNULL(regexp_engine_)) {
     ret = OB_NOT_INIT;
     LOG_WARN("regexp context not inited yet", K(ret), K(inited_), K(regexp_engine_));
+  } else if (0 == start && ObExprRegexDfa::NOT_MATCH == dfa_match(text_string, true)) {
+    result = text_string;
   } else if (OB_FAIL(get_valid_unicode_string(string_buf, text_string, u_text, u_text_length))) {
     LOG_WARN("failed to get valid unicode string", K(ret));
   } else if (0 == u_text_length) {
@@ -21,6 +21,7 @@
 #include "lib/charset/ob_charset.h"
 #include <icu/i18n/unicode/uregex.h>
 #include "sql/engine/expr/ob_expr_operator.h"
+#include "sql/engine/expr/ob_expr_regexp_dfa.h"
 
 // this regex is compatible with mysql 8.0
 
@@ -60,6 +61,13 @@ public:
            const bool reusable,
            const ObCollationType cs_type);
 
+  // Match %text by the DFA compiled from reusable pattern, UNDECIDED is returned if there is no
+  // DFA or the DFA can not decide, ICU should be used then.
+  inline ObExprRegexDfa::MatchResult dfa_match(const ObString &text, const bool is_utf16) const
+  {
+    return dfa_.is_inited() ? dfa_.match(text, is_utf16) : ObExprRegexDfa::UNDECIDED;
+  }
+
   int match(ObExprStringBuf &string_buf,
             const ObString &text,
             const int64_t start,
@@ -123,7 +131,7 @@ public:
   static inline bool is_binary_compatible(const ObExprResType &type) {
     return CS_TYPE_BINARY == type.get_collation_type() || !ob_is_string_or_lob_type(type.get_type());
   }
-  TO_STRING_KV(K_(inited));
+  TO_STRING_KV(K_(inited), K_(dfa));
 
   static int check_binary_compatible(const ObExprResType *types, int64_t num);
 
@@ -147,6 +155,8 @@ private:
   int cflags_;
   ObInplaceAllocator pattern_wc_allocator_;
   URegularExpression *regexp_engine_;
+  ObInplaceAllocator dfa_allocator_;
+  ObExprRegexDfa dfa_;
 };
 }
 }
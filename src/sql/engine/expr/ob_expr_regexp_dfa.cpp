@@ -0,0 +1,1230 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include "sql/engine/expr/ob_expr_regexp_dfa.h"
+#include <icu/i18n/unicode/uregex.h>
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_se_array.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/utility/ob_sort.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+namespace
+{
+
+struct SymSet
+{
+  SymSet() { MEMSET(bits_, 0, sizeof(bits_)); }
+  inline void add(const int64_t sym) { bits_[sym >> 6] |= (1UL << (sym & 63)); }
+  inline bool has(const int64_t sym) const { return bits_[sym >> 6] & (1UL << (sym & 63)); }
+  inline void add_range(const int64_t from, const int64_t to)
+  {
+    for (int64_t i = from; i <= to; i++) {
+      add(i);
+    }
+  }
+  void add_all()
+  {
+    add_range(0, ObExprRegexDfa::SYM_CNT - 1);
+  }
+  void negate()
+  {
+    for (int64_t i = 0; i < ObExprRegexDfa::SYM_CNT; i++) {
+      if (has(i)) {
+        bits_[i >> 6] &= ~(1UL << (i & 63));
+      } else {
+        add(i);
+      }
+    }
+  }
+  void merge(const SymSet &other)
+  {
+    for (int64_t i = 0; i < ARRAYSIZEOF(bits_); i++) {
+      bits_[i] |= other.bits_[i];
+    }
+  }
+  // add the other case of ASCII letters
+  void fold_case()
+  {
+    for (int64_t c = 'a'; c <= 'z'; c++) {
+      if (has(c) || has(c - 'a' + 'A')) {
+        add(c);
+        add(c - 'a' + 'A');
+      }
+    }
+  }
+  TO_STRING_KV(K(bits_[0]), K(bits_[1]), K(bits_[2]));
+  uint64_t bits_[3];
+};
+
+enum NodeType
+{
+  NODE_EMPTY = 0,
+  NODE_SET,
+  NODE_CONCAT,
+  NODE_ALT,
+  NODE_REPEAT,
+};
+
+struct Node
+{
+  TO_STRING_KV(K_(type), K_(left), K_(right), K_(min), K_(max), K_(set));
+  int32_t type_;
+  int32_t left_;
+  int32_t right_;
+  int32_t min_;
+  // -1 means infinite
+  int32_t max_;
+  int32_t set_;
+};
+
+enum NfaStateType
+{
+  NFA_EPS = 0,
+  NFA_SPLIT,
+  NFA_SET,
+  NFA_MATCH,
+};
+
+struct NfaState
+{
+  TO_STRING_KV(K_(type), K_(set), K_(out), K_(out1));
+  int32_t type_;
+  int32_t set_;
+  int32_t out_;
+  int32_t out1_;
+};
+
+// Parse the pattern into syntax tree, build Thompson NFA from the tree and
+// then DFA by subset construction.
+class ObRegexDfaCompiler
+{
+public:
+  static const int64_t MAX_PARSE_DEPTH = 64;
+  static const int32_t MAX_REPEAT_CNT = 256;
+  // bound the recursion of parser and NFA builder
+  static const int64_t MAX_PATTERN_LEN = 1024;
+  ObRegexDfaCompiler()
+    : supported_(true), anchored_start_(false), anchored_end_(false), ascii_only_(false),
+      class_cnt_(0), start_state_(-1), pattern_(NULL), len_(0), pos_(0), depth_(0), flags_(0),
+      nfa_start_(-1)
+  {
+    MEMSET(sym_class_, 0, sizeof(sym_class_));
+    MEMSET(class_rep_, 0, sizeof(class_rep_));
+  }
+
+  int compile(const uint16_t *pattern, const int64_t len, const uint32_t flags);
+
+  bool supported_;
+  bool anchored_start_;
+  bool anchored_end_;
+  bool ascii_only_;
+  int32_t class_cnt_;
+  int32_t start_state_;
+  uint8_t sym_class_[ObExprRegexDfa::SYM_CNT];
+  ObSEArray<uint8_t, 64> accept_;
+  ObSEArray<int16_t, 1024> trans_;
+
+private:
+  inline bool at_end() const { return pos_ >= len_; }
+  inline uint16_t peek() const { return pattern_[pos_]; }
+  int new_node(const int32_t type, const int32_t left, const int32_t right, int32_t &idx);
+  int new_set_node(const SymSet &set, int32_t &idx);
+  int parse_alt(int32_t &node);
+  int parse_concat(int32_t &node);
+  int parse_repeat(int32_t &node);
+  int parse_atom(int32_t &node);
+  int parse_interval(int32_t &min, int32_t &max);
+  int parse_class(SymSet &set);
+  // parse escape sequence after '\', %is_class is true for \d \w \s and their negations
+  void parse_escape(SymSet &set, bool &is_class);
+  void literal_set(const uint16_t c, SymSet &set) const;
+  void dot_set(SymSet &set) const;
+
+  int new_nfa_state(const int32_t type, const int32_t set, int32_t &idx);
+  int build_nfa(const int32_t node, int32_t &start, int32_t &end);
+  int build_sym_classes();
+  int closure(ObIArray<int32_t> &states);
+  int find_or_add_dfa_state(ObIArray<int32_t> &nfa_states, int32_t &dfa_state, bool &is_new);
+  int build_dfa();
+
+private:
+  const uint16_t *pattern_;
+  int64_t len_;
+  int64_t pos_;
+  int64_t depth_;
+  uint32_t flags_;
+  ObSEArray<Node, 64> nodes_;
+  ObSEArray<SymSet, 32> sets_;
+  ObSEArray<NfaState, 256> nfa_;
+  int32_t nfa_start_;
+  int32_t class_rep_[ObExprRegexDfa::SYM_CNT];
+  // NFA states of DFA states, the NFA states of DFA state i are
+  // dfa_items_[dfa_offsets_[i], dfa_offsets_[i + 1])
+  ObSEArray<int32_t, 1024> dfa_items_;
+  ObSEArray<int64_t, 64> dfa_offsets_;
+  ObSEArray<uint64_t, 64> dfa_hashes_;
+  ObSEArray<int32_t, 64> visit_stack_;
+  ObSEArray<uint8_t, 256> visited_;
+};
+
+int ObRegexDfaCompiler::new_node(const int32_t type, const int32_t left, const int32_t right,
+                                 int32_t &idx)
+{
+  int ret = OB_SUCCESS;
+  Node node;
+  node.type_ = type;
+  node.left_ = left;
+  node.right_ = right;
+  node.min_ = 0;
+  node.max_ = 0;
+  node.set_ = -1;
+  idx = static_cast<int32_t>(nodes_.count());
+  if (OB_FAIL(nodes_.push_back(node))) {
+    LOG_WARN("push back failed", K(ret));
+  }
+  return ret;
+}
+
+int ObRegexDfaCompiler::new_set_node(const SymSet &set, int32_t &idx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(new_node(NODE_SET, -1, -1, idx))) {
+    LOG_WARN("new node failed", K(ret));
+  } else if (OB_FAIL(sets_.push_back(set))) {
+    LOG_WARN("push back failed", K(ret));
+  } else {
+    nodes_.at(idx).set_ = static_cast<int32_t>(sets_.count() - 1);
+  }
+  return ret;
+}
+
+void ObRegexDfaCompiler::literal_set(const uint16_t c, SymSet &set) const
+{
+  set.add(c);
+  if (flags_ & UREGEX_CASE_INSENSITIVE) {
+    set.fold_case();
+  }
+}
+
+void ObRegexDfaCompiler::dot_set(SymSet &set) const
+{
+  set.add_all();
+  if (!(flags_ & UREGEX_DOTALL)) {
+    // '.' does not match line terminators
+    SymSet lt;
+    lt.add('\n');
+    if (!(flags_ & UREGEX_UNIX_LINES)) {
+      lt.add('\r');
+      lt.add(0x0b);
+      lt.add(0x0c);
+      lt.add(ObExprRegexDfa::SYM_NON_ASCII_LT);
+    }
+    lt.negate();
+    set = lt;
+  }
+}
+
+void ObRegexDfaCompiler::parse_escape(SymSet &set, bool &is_class)
+{
+  is_class = false;
+  if (at_end()) {
+    supported_ = false;
+  } else {
+    const uint16_t c = pattern_[pos_++];
+    bool negate = false;
+    switch (c) {
+      case 'D': negate = true; // fall through
+      case 'd': {
+        set.add_range('0', '9');
+        is_class = true;
+        break;
+      }
+      case 'W': negate = true; // fall through
+      case 'w': {
+        set.add_range('a', 'z');
+        set.add_range('A', 'Z');
+        set.add_range('0', '9');
+        set.add('_');
+        is_class = true;
+        break;
+      }
+      case 'S': negate = true; // fall through
+      case 's': {
+        set.add_range(0x09, 0x0d);
+        set.add(' ');
+        is_class = true;
+        break;
+      }
+      case 't': set.add(0x09); break;
+      case 'n': set.add(0x0a); break;
+      case 'r': set.add(0x0d); break;
+      case 'f': set.add(0x0c); break;
+      case 'a': set.add(0x07); break;
+      case 'e': set.add(0x1b); break;
+      default: {
+        // '\' quotes the following non alphanumeric character
+        if (c >= 0x20 && c < 0x7f && !isalnum(c)) {
+          literal_set(c, set);
+        } else {
+          supported_ = false;
+        }
+        break;
+      }
+    }
+    if (is_class) {
+      // \d \w \s match non-ASCII characters too
+      ascii_only_ = true;
+      if (negate) {
+        set.negate();
+      }
+    }
+  }
+}
+
+int ObRegexDfaCompiler::parse_class(SymSet &set)
+{
+  int ret = OB_SUCCESS;
+  bool negate = false;
+  bool closed = false;
+  bool first = true;
+  if (!at_end() && '^' == peek()) {
+    negate = true;
+    ++pos_;
+  }
+  // ']' as the first member is ambiguous between dialects, leave it to ICU
+  if (!at_end() && ']' == peek()) {
+    supported_ = false;
+  }
+  while (supported_ && !closed && !at_end()) {
+    uint16_t c = pattern_[pos_++];
+    int32_t from = -1;
+    if (']' == c) {
+      closed = true;
+    } else if ('[' == c || ('&' == c && !at_end() && '&' == peek())) {
+      // nested set, posix class or set operations
+      supported_ = false;
+    } else if ('\\' == c) {
+      SymSet escaped;
+      bool is_class = false;
+      parse_escape(escaped, is_class);
+      if (is_class) {
+        set.merge(escaped);
+      } else if (supported_) {
+        // escaped literal, may be the begin of a range
+        for (int64_t i = 0; i < 128 && from < 0; i++) {
+          if (escaped.has(i)) {
+            from = static_cast<int32_t>(i);
+          }
+        }
+        set.merge(escaped);
+      }
+    } else if ('-' == c && (first || (!at_end() && ']' == peek()))) {
+      set.add('-');
+    } else {
+      from = c;
+      set.add(c);
+    }
+    if (supported_ && from >= 0 && pos_ + 1 < len_ && '-' == peek() && ']' != pattern_[pos_ + 1]) {
+      // range
+      ++pos_;
+      uint16_t to = pattern_[pos_++];
+      if ('\\' == to) {
+        if (at_end()) {
+          supported_ = false;
+        } else {
+          to = pattern_[pos_++];
+          if (!(to >= 0x20 && to < 0x7f && !isalnum(to))) {
+            supported_ = false;
+          }
+        }
+      } else if ('[' == to) {
+        supported_ = false;
+      }
+      if (supported_) {
+        if (to < from) {
+          supported_ = false;
+        } else {
+          set.add_range(from, to);
+        }
+      }
+    }
+    first = false;
+  }
+  if (!closed) {
+    supported_ = false;
+  } else if (supported_) {
+    if (flags_ & UREGEX_CASE_INSENSITIVE) {
+      set.fold_case();
+    }
+    if (negate) {
+      set.negate();
+    }
+  }
+  return ret;
+}
+
+int ObRegexDfaCompiler::parse_interval(int32_t &min, int32_t &max)
+{
+  int ret = OB_SUCCESS;
+  // '{' is consumed
+  int64_t num[2] = {-1, -1};
+  int64_t idx = 0;
+  bool closed = false;
+  while (supported_ && !closed && !at_end()) {
+    const uint16_t c = pattern_[pos_++];
+    if (c >= '0' && c <= '9') {
+      num[idx] = (num[idx] < 0 ? 0 : num[idx]) * 10 + (c - '0');
+      if (num[idx] > MAX_REPEAT_CNT) {
+        supported_ = false;
+      }
+    } else if (',' == c && 0 == idx && num[0] >= 0) {
+      idx = 1;
+    } else if ('}' == c) {
+      closed = true;
+    } else {
+      supported_ = false;
+    }
+  }
+  if (!closed || num[0] < 0) {
+    supported_ = false;
+  } else if (supported_) {
+    min = static_cast<int32_t>(num[0]);
+    max = 0 == idx ? min : static_cast<int32_t>(num[1]);
+    if (max >= 0 && max < min) {
+      supported_ = false;
+    }
+  }
+  return ret;
+}
+
+int ObRegexDfaCompiler::parse_atom(int32_t &node)
+{
+  int ret = OB_SUCCESS;
+  const uint16_t c = pattern_[pos_++];
+  switch (c) {
+    case '(': {
+      if (!at_end() && '?' == peek()) {
+        if (pos_ + 1 < len_ && ':' == pattern_[pos_ + 1]) {
+          pos_ += 2;
+        } else {
+          // look around, named group, flag setting ...
+          supported_ = false;
+        }
+      }
+      if (!supported_) {
+      } else if (++depth_ > MAX_PARSE_DEPTH) {
+        supported_ = false;
+      } else if (OB_FAIL(parse_alt(node))) {
+        LOG_WARN("parse alternation failed", K(ret));
+      } else if (!supported_) {
+      } else if (at_end() || ')' != peek()) {
+        supported_ = false;
+      } else {
+        ++pos_;
+        --depth_;
+      }
+      break;
+    }
+    case '[': {
+      SymSet set;
+      if (OB_FAIL(parse_class(set))) {
+        LOG_WARN("parse class failed", K(ret));
+      } else if (supported_ && OB_FAIL(new_set_node(set, node))) {
+        LOG_WARN("new set node failed", K(ret));
+      }
+      break;
+    }
+    case '.': {
+      SymSet set;
+      dot_set(set);
+      if (OB_FAIL(new_set_node(set, node))) {
+        LOG_WARN("new set node failed", K(ret));
+      }
+      break;
+    }
+    case '\\': {
+      SymSet set;
+      bool is_class = false;
+      parse_escape(set, is_class);
+      if (supported_ && OB_FAIL(new_set_node(set, node))) {
+        LOG_WARN("new set node failed", K(ret));
+      }
+      break;
+    }
+    case '^':
+    case '$':
+    case '*':
+    case '+':
+    case '?':
+    case '{':
+    case '}':
+    case ']':
+    case ')':
+    case '|': {
+      supported_ = false;
+      break;
+    }
+    default: {
+      SymSet set;
+      literal_set(c, set);
+      if (OB_FAIL(new_set_node(set, node))) {
+        LOG_WARN("new set node failed", K(ret));
+      }
+      break;
+    }
+  }
+  return ret;
+}
+
+int ObRegexDfaCompiler::parse_repeat(int32_t &node)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(parse_atom(node))) {
+    LOG_WARN("parse atom failed", K(ret));
+  } else if (supported_ && !at_end()) {
+    int32_t min = -1;
+    int32_t max = -1;
+    const uint16_t c = peek();
+    if ('*' == c) {
+      ++pos_;
+      min = 0;
+    } else if ('+' == c) {
+      ++pos_;
+      min = 1;
+    } else if ('?' == c) {
+      ++pos_;
+      min = 0;
+      max = 1;
+    } else if ('{' == c) {
+      ++pos_;
+      if (OB_FAIL(parse_interval(min, max))) {
+        LOG_WARN("parse interval failed", K(ret));
+      }
+    }
+    if (OB_FAIL(ret) || !supported_ || min < 0) {
+    } else {
+      if (!at_end() && '?' == peek()) {
+        // lazy quantifier matches the same strings
+        ++pos_;
+      }
+      if (!at_end() && ('+' == peek() || '*' == peek() || '?' == peek() || '{' == peek())) {
+        // possessive quantifier or stacked quantifiers
+        supported_ = false;
+      } else {
+        const int32_t child = node;
+        if (OB_FAIL(new_node(NODE_REPEAT, child, -1, node))) {
+          LOG_WARN("new node failed", K(ret));
+        } else {
+          nodes_.at(node).min_ = min;
+          nodes_.at(node).max_ = max;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObRegexDfaCompiler::parse_concat(int32_t &node)
+{
+  int ret = OB_SUCCESS;
+  node = -1;
+  while (OB_SUCC(ret) && supported_ && !at_end() && '|' != peek() && ')' != peek()) {
+    int32_t item = -1;
+    if (OB_FAIL(parse_repeat(item))) {
+      LOG_WARN("parse repeat failed", K(ret));
+    } else if (!supported_) {
+    } else if (node < 0) {
+      node = item;
+    } else {
+      const int32_t left = node;
+      if (OB_FAIL(new_node(NODE_CONCAT, left, item, node))) {
+        LOG_WARN("new node failed", K(ret));
+      }
+    }
+  }
+  if (OB_SUCC(ret) && supported_ && node < 0) {
+    if (OB_FAIL(new_node(NODE_EMPTY, -1, -1, node))) {
+      LOG_WARN("new node failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObRegexDfaCompiler::parse_alt(int32_t &node)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(parse_concat(node))) {
+    LOG_WARN("parse concat failed", K(ret));
+  }
+  while (OB_SUCC(ret) && supported_ && !at_end() && '|' == peek()) {
+    ++pos_;
+    int32_t right = -1;
+    if (OB_FAIL(parse_concat(right))) {
+      LOG_WARN("parse concat failed", K(ret));
+    } else if (supported_) {
+      const int32_t left = node;
+      if (OB_FAIL(new_node(NODE_ALT, left, right, node))) {
+        LOG_WARN("new node failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObRegexDfaCompiler::new_nfa_state(const int32_t type, const int32_t set, int32_t &idx)
+{
+  int ret = OB_SUCCESS;
+  NfaState state;
+  state.type_ = type;
+  state.set_ = set;
+  state.out_ = -1;
+  state.out1_ = -1;
+  idx = static_cast<int32_t>(nfa_.count());
+  if (idx >= ObExprRegexDfa::MAX_NFA_STATE_CNT) {
+    supported_ = false;
+  } else if (OB_FAIL(nfa_.push_back(state))) {
+    LOG_WARN("push back failed", K(ret));
+  }
+  return ret;
+}
+
+// every fragment has one entry %start and one exit %end, which is epsilon state to be linked.
+int ObRegexDfaCompiler::build_nfa(const int32_t node_idx, int32_t &start, int32_t &end)
+{
+  int ret = OB_SUCCESS;
+  const Node node = nodes_.at(node_idx);
+  switch (node.type_) {
+    case NODE_EMPTY: {
+      if (OB_FAIL(new_nfa_state(NFA_EPS, -1, start))) {
+        LOG_WARN("new state failed", K(ret));
+      } else {
+        end = start;
+      }
+      break;
+    }
+    case NODE_SET: {
+      if (OB_FAIL(new_nfa_state(NFA_SET, node.set_, start))) {
+        LOG_WARN("new state failed", K(ret));
+      } else if (!supported_) {
+      } else if (OB_FAIL(new_nfa_state(NFA_EPS, -1, end))) {
+        LOG_WARN("new state failed", K(ret));
+      } else if (supported_) {
+        nfa_.at(start).out_ = end;
+      }
+      break;
+    }
+    case NODE_CONCAT: {
+      int32_t r_start = -1;
+      int32_t l_end = -1;
+      if (OB_FAIL(build_nfa(node.left_, start, l_end))) {
+        LOG_WARN("build nfa failed", K(ret));
+      } else if (!supported_) {
+      } else if (OB_FAIL(build_nfa(node.right_, r_start, end))) {
+        LOG_WARN("build nfa failed", K(ret));
+      } else if (supported_) {
+        nfa_.at(l_end).out_ = r_start;
+      }
+      break;
+    }
+    case NODE_ALT: {
+      int32_t l_start = -1;
+      int32_t l_end = -1;
+      int32_t r_start = -1;
+      int32_t r_end = -1;
+      if (OB_FAIL(build_nfa(node.left_, l_start, l_end))) {
+        LOG_WARN("build nfa failed", K(ret));
+      } else if (!supported_) {
+      } else if (OB_FAIL(build_nfa(node.right_, r_start, r_end))) {
+        LOG_WARN("build nfa failed", K(ret));
+      } else if (!supported_) {
+      } else if (OB_FAIL(new_nfa_state(NFA_SPLIT, -1, start))) {
+        LOG_WARN("new state failed", K(ret));
+      } else if (!supported_) {
+      } else if (OB_FAIL(new_nfa_state(NFA_EPS, -1, end))) {
+        LOG_WARN("new state failed", K(ret));
+      } else if (supported_) {
+        nfa_.at(start).out_ = l_start;
+        nfa_.at(start).out1_ = r_start;
+        nfa_.at(l_end).out_ = end;
+        nfa_.at(r_end).out_ = end;
+      }
+      break;
+    }
+    case NODE_REPEAT: {
+      // x{min,max} is expanded to min copies of x followed by (max - min) copies of x?,
+      // or x* if max is infinite.
+      if (OB_FAIL(new_nfa_state(NFA_EPS, -1, start))) {
+        LOG_WARN("new state failed", K(ret));
+      } else {
+        end = start;
+      }
+      for (int32_t i = 0; OB_SUCC(ret) && supported_ && i < node.min_; i++) {
+        int32_t c_start = -1;
+        int32_t c_end = -1;
+        if (OB_FAIL(build_nfa(node.left_, c_start, c_end))) {
+          LOG_WARN("build nfa failed", K(ret));
+        } else if (supported_) {
+          nfa_.at(end).out_ = c_start;
+          end = c_end;
+        }
+      }
+      const int32_t opt_cnt = node.max_ < 0 ? 1 : node.max_ - node.min_;
+      for (int32_t i = 0; OB_SUCC(ret) && supported_ && i < opt_cnt; i++) {
+        int32_t c_start = -1;
+        int32_t c_end = -1;
+        int32_t split = -1;
+        int32_t exit = -1;
+        if (OB_FAIL(build_nfa(node.left_, c_start, c_end))) {
+          LOG_WARN("build nfa failed", K(ret));
+        } else if (!supported_) {
+        } else if (OB_FAIL(new_nfa_state(NFA_SPLIT, -1, split))) {
+          LOG_WARN("new state failed", K(ret));
+        } else if (!supported_) {
+        } else if (OB_FAIL(new_nfa_state(NFA_EPS, -1, exit))) {
+          LOG_WARN("new state failed", K(ret));
+        } else if (supported_) {
+          nfa_.at(split).out_ = c_start;
+          nfa_.at(split).out1_ = exit;
+          // loop back for infinite repeat
+          nfa_.at(c_end).out_ = node.max_ < 0 ? split : exit;
+          nfa_.at(end).out_ = split;
+          end = exit;
+        }
+      }
+      break;
+    }
+    default: {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected node type", K(ret), K(node));
+      break;
+    }
+  }
+  return ret;
+}
+
+// symbols which belong to the same sets are in one class, transitions are built per class.
+int ObRegexDfaCompiler::build_sym_classes()
+{
+  int ret = OB_SUCCESS;
+  int32_t cls[ObExprRegexDfa::SYM_CNT];
+  MEMSET(cls, 0, sizeof(cls));
+  int32_t cls_cnt = 1;
+  int32_t new_ids[ObExprRegexDfa::SYM_CNT][2];
+  for (int64_t s = 0; s < sets_.count(); s++) {
+    const SymSet &set = sets_.at(s);
+    for (int64_t i = 0; i < cls_cnt; i++) {
+      new_ids[i][0] = -1;
+      new_ids[i][1] = -1;
+    }
+    int32_t new_cnt = 0;
+    for (int64_t sym = 0; sym < ObExprRegexDfa::SYM_CNT; sym++) {
+      int32_t &id = new_ids[cls[sym]][set.has(sym) ? 1 : 0];
+      if (id < 0) {
+        id = new_cnt++;
+      }
+      cls[sym] = id;
+    }
+    cls_cnt = new_cnt;
+  }
+  class_cnt_ = cls_cnt;
+  for (int64_t sym = ObExprRegexDfa::SYM_CNT - 1; sym >= 0; sym--) {
+    sym_class_[sym] = static_cast<uint8_t>(cls[sym]);
+    class_rep_[cls[sym]] = static_cast<int32_t>(sym);
+  }
+  return ret;
+}
+
+// replace %states with the sorted SET and MATCH states reachable by epsilon moves.
+int ObRegexDfaCompiler::closure(ObIArray<int32_t> &states)
+{
+  int ret = OB_SUCCESS;
+  visit_stack_.reuse();
+  for (int64_t i = 0; i < visited_.count(); i++) {
+    visited_.at(i) = 0;
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < states.count(); i++) {
+    if (!visited_.at(states.at(i))) {
+      visited_.at(states.at(i)) = 1;
+      ret = visit_stack_.push_back(states.at(i));
+    }
+  }
+  states.reuse();
+  while (OB_SUCC(ret) && !visit_stack_.empty()) {
+    int32_t idx = -1;
+    if (OB_FAIL(visit_stack_.pop_back(idx))) {
+      LOG_WARN("pop back failed", K(ret));
+    } else {
+      const NfaState &state = nfa_.at(idx);
+      if (NFA_SET == state.type_ || NFA_MATCH == state.type_) {
+        ret = states.push_back(idx);
+      }
+      const int32_t outs[2] = { NFA_SET == state.type_ ? -1 : state.out_, state.out1_ };
+      for (int64_t j = 0; OB_SUCC(ret) && j < 2; j++) {
+        if (outs[j] >= 0 && !visited_.at(outs[j])) {
+          visited_.at(outs[j]) = 1;
+          ret = visit_stack_.push_back(outs[j]);
+        }
+      }
+    }
+  }
+  if (OB_SUCC(ret) && states.count() > 1) {
+    lib::ob_sort(&states.at(0), &states.at(0) + states.count());
+  }
+  return ret;
+}
+
+int ObRegexDfaCompiler::find_or_add_dfa_state(ObIArray<int32_t> &nfa_states,
+                                              int32_t &dfa_state,
+                                              bool &is_new)
+{
+  int ret = OB_SUCCESS;
+  uint64_t hash = 0;
+  is_new = false;
+  dfa_state = -1;
+  for (int64_t i = 0; i < nfa_states.count(); i++) {
+    hash = murmurhash(&nfa_states.at(i), sizeof(int32_t), hash);
+  }
+  for (int64_t i = 0; dfa_state < 0 && i < dfa_hashes_.count(); i++) {
+    if (dfa_hashes_.at(i) == hash
+        && dfa_offsets_.at(i + 1) - dfa_offsets_.at(i) == nfa_states.count()) {
+      bool same = true;
+      for (int64_t j = 0; same && j < nfa_states.count(); j++) {
+        same = dfa_items_.at(dfa_offsets_.at(i) + j) == nfa_states.at(j);
+      }
+      if (same) {
+        dfa_state = static_cast<int32_t>(i);
+      }
+    }
+  }
+  if (dfa_state < 0) {
+    if (dfa_hashes_.count() >= ObExprRegexDfa::MAX_DFA_STATE_CNT) {
+      supported_ = false;
+    } else {
+      bool accept = false;
+      for (int64_t i = 0; OB_SUCC(ret) && i < nfa_states.count(); i++) {
+        accept = accept || NFA_MATCH == nfa_.at(nfa_states.at(i)).type_;
+        ret = dfa_items_.push_back(nfa_states.at(i));
+      }
+      if (OB_FAIL(ret)) {
+      } else if (OB_FAIL(dfa_offsets_.push_back(dfa_items_.count()))) {
+        LOG_WARN("push back failed", K(ret));
+      } else if (OB_FAIL(dfa_hashes_.push_back(hash))) {
+        LOG_WARN("push back failed", K(ret));
+      } else if (OB_FAIL(accept_.push_back(accept ? 1 : 0))) {
+        LOG_WARN("push back failed", K(ret));
+      } else {
+        dfa_state = static_cast<int32_t>(dfa_hashes_.count() - 1);
+        is_new = true;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObRegexDfaCompiler::build_dfa()
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<int32_t, 64> nfa_states;
+  int32_t state = -1;
+  bool is_new = false;
+  if (OB_FAIL(visited_.prepare_allocate(nfa_.count()))) {
+    LOG_WARN("prepare allocate failed", K(ret));
+  } else if (OB_FAIL(dfa_offsets_.push_back(0))) {
+    LOG_WARN("push back failed", K(ret));
+  // dead state is the empty set of NFA states
+  } else if (OB_FAIL(find_or_add_dfa_state(nfa_states, state, is_new))) {
+    LOG_WARN("add dead state failed", K(ret));
+  } else if (OB_FAIL(nfa_states.push_back(nfa_start_))) {
+    LOG_WARN("push back failed", K(ret));
+  } else if (OB_FAIL(closure(nfa_states))) {
+    LOG_WARN("closure failed", K(ret));
+  } else if (OB_FAIL(find_or_add_dfa_state(nfa_states, start_state_, is_new))) {
+    LOG_WARN("add start state failed", K(ret));
+  }
+  // DFA states are appended in BFS order, transitions of state i are
+  // trans_[i * class_cnt_, (i + 1) * class_cnt_)
+  for (int64_t i = 0; OB_SUCC(ret) && supported_ && i < dfa_hashes_.count(); i++) {
+    for (int32_t c = 0; OB_SUCC(ret) && supported_ && c < class_cnt_; c++) {
+      int32_t next = ObExprRegexDfa::DEAD_STATE;
+      if (accept_.at(i) && !anchored_end_) {
+        // matched already, no need to go further
+        next = static_cast<int32_t>(i);
+      } else {
+        const int32_t sym = class_rep_[c];
+        nfa_states.reuse();
+        for (int64_t j = dfa_offsets_.at(i); OB_SUCC(ret) && j < dfa_offsets_.at(i + 1); j++) {
+          const NfaState &nfa_state = nfa_.at(dfa_items_.at(j));
+          if (NFA_SET == nfa_state.type_ && sets_.at(nfa_state.set_).has(sym)) {
+            ret = nfa_states.push_back(nfa_state.out_);
+          }
+        }
+        if (OB_FAIL(ret)) {
+        } else if (OB_FAIL(closure(nfa_states))) {
+          LOG_WARN("closure failed", K(ret));
+        } else if (OB_FAIL(find_or_add_dfa_state(nfa_states, next, is_new))) {
+          LOG_WARN("add state failed", K(ret));
+        }
+      }
+      if (OB_SUCC(ret) && supported_ && OB_FAIL(trans_.push_back(static_cast<int16_t>(next)))) {
+        LOG_WARN("push back failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObRegexDfaCompiler::compile(const uint16_t *pattern, const int64_t len, const uint32_t flags)
+{
+  int ret = OB_SUCCESS;
+  const uint32_t supported_flags = UREGEX_CASE_INSENSITIVE | UREGEX_MULTILINE | UREGEX_DOTALL
+                                   | UREGEX_UNIX_LINES;
+  pattern_ = pattern;
+  len_ = len;
+  pos_ = 0;
+  flags_ = flags;
+  ascii_only_ = (flags & UREGEX_CASE_INSENSITIVE);
+  if (0 != (flags & ~supported_flags) || len > MAX_PATTERN_LEN) {
+    supported_ = false;
+  }
+  for (int64_t i = 0; supported_ && i < len; i++) {
+    if (pattern[i] >= 0x80) {
+      supported_ = false;
+    }
+  }
+  if (supported_ && len_ > 0 && '^' == pattern_[0]) {
+    anchored_start_ = true;
+    pos_ = 1;
+  }
+  if (supported_ && len_ > pos_ && '$' == pattern_[len_ - 1]) {
+    int64_t backslash_cnt = 0;
+    for (int64_t i = len_ - 2; i >= pos_ && '\\' == pattern_[i]; i--) {
+      ++backslash_cnt;
+    }
+    if (0 == backslash_cnt % 2) {
+      anchored_end_ = true;
+      len_ -= 1;
+    }
+  }
+  if (supported_ && (anchored_start_ || anchored_end_) && (flags & UREGEX_MULTILINE)) {
+    supported_ = false;
+  }
+  int32_t root = -1;
+  int32_t start = -1;
+  int32_t end = -1;
+  int32_t match = -1;
+  if (!supported_) {
+  } else if (OB_FAIL(parse_alt(root))) {
+    LOG_WARN("parse failed", K(ret));
+  } else if (!supported_) {
+  } else if (!at_end()) {
+    // unbalanced ')'
+    supported_ = false;
+  } else if (NODE_ALT == nodes_.at(root).type_ && (anchored_start_ || anchored_end_)) {
+    // '^a|b' is not '^(a|b)'
+    supported_ = false;
+  } else {
+    if (!anchored_start_) {
+      // search in text: [\s\S]*?(pattern)
+      SymSet all;
+      int32_t any = -1;
+      int32_t prefix = -1;
+      all.add_all();
+      if (OB_FAIL(new_set_node(all, any))) {
+        LOG_WARN("new set node failed", K(ret));
+      } else if (OB_FAIL(new_node(NODE_REPEAT, any, -1, prefix))) {
+        LOG_WARN("new node failed", K(ret));
+      } else {
+        nodes_.at(prefix).max_ = -1;
+        const int32_t pattern_root = root;
+        if (OB_FAIL(new_node(NODE_CONCAT, prefix, pattern_root, root))) {
+          LOG_WARN("new node failed", K(ret));
+        }
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(build_nfa(root, start, end))) {
+      LOG_WARN("build nfa failed", K(ret));
+    } else if (!supported_) {
+    } else if (OB_FAIL(new_nfa_state(NFA_MATCH, -1, match))) {
+      LOG_WARN("new state failed", K(ret));
+    } else if (supported_) {
+      nfa_.at(end).out_ = match;
+      nfa_start_ = start;
+      if (OB_FAIL(build_sym_classes())) {
+        LOG_WARN("build symbol classes failed", K(ret));
+      } else if (OB_FAIL(build_dfa())) {
+        LOG_WARN("build dfa failed", K(ret));
+      }
+    }
+  }
+  LOG_DEBUG("compile regexp dfa", K(ret), K_(supported), K(len), K(flags), K(nodes_.count()),
+            K(nfa_.count()), K(dfa_hashes_.count()), K_(class_cnt));
+  return ret;
+}
+
+} // end anonymous namespace
+
+ObExprRegexDfa::ObExprRegexDfa()
+  : inited_(false), anchored_end_(false), ascii_only_(false), unix_lines_(false),
+    state_cnt_(0), class_cnt_(0), start_state_(DEAD_STATE), accept_(NULL), trans_(NULL)
+{
+  MEMSET(sym_class_, 0, sizeof(sym_class_));
+}
+
+void ObExprRegexDfa::reset()
+{
+  // memory is released with the allocator passed to init()
+  inited_ = false;
+  anchored_end_ = false;
+  ascii_only_ = false;
+  unix_lines_ = false;
+  state_cnt_ = 0;
+  class_cnt_ = 0;
+  start_state_ = DEAD_STATE;
+  accept_ = NULL;
+  trans_ = NULL;
+}
+
+int ObExprRegexDfa::init(ObIAllocator &alloc,
+                         const ObString &pattern,
+                         const uint32_t flags,
+                         bool &supported)
+{
+  int ret = OB_SUCCESS;
+  supported = false;
+  const int64_t len = pattern.length() / sizeof(uint16_t);
+  ObArenaAllocator tmp_alloc("RegexpDfa");
+  uint16_t *u_pattern = NULL;
+  if (OB_UNLIKELY(inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_UNLIKELY(0 != pattern.length() % sizeof(uint16_t))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid utf16 pattern", K(ret), K(pattern.length()));
+  } else if (len > 0 && OB_ISNULL(u_pattern = static_cast<uint16_t *>(
+                                    tmp_alloc.alloc(len * sizeof(uint16_t))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(len));
+  } else {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(pattern.ptr());
+    for (int64_t i = 0; i < len; i++) {
+      u_pattern[i] = static_cast<uint16_t>((p[2 * i] << 8) | p[2 * i + 1]);
+    }
+    ObRegexDfaCompiler compiler;
+    if (OB_FAIL(compiler.compile(u_pattern, len, flags))) {
+      LOG_WARN("compile failed", K(ret));
+    } else if (compiler.supported_) {
+      // transitions and accept flags are allocated together, so that %alloc can be an inplace
+      // allocator which holds one piece of memory
+      const int64_t state_cnt = compiler.accept_.count();
+      const int64_t trans_size = compiler.trans_.count() * sizeof(int16_t);
+      char *buf = NULL;
+      if (OB_ISNULL(buf = static_cast<char *>(alloc.alloc(trans_size + state_cnt)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate memory failed", K(ret), K(state_cnt), K(trans_size));
+      } else {
+        trans_ = reinterpret_cast<int16_t *>(buf);
+        accept_ = reinterpret_cast<uint8_t *>(buf + trans_size);
+        MEMCPY(trans_, &compiler.trans_.at(0), trans_size);
+        MEMCPY(accept_, &compiler.accept_.at(0), state_cnt);
+        MEMCPY(sym_class_, compiler.sym_class_, sizeof(sym_class_));
+        state_cnt_ = static_cast<int32_t>(state_cnt);
+        class_cnt_ = compiler.class_cnt_;
+        start_state_ = compiler.start_state_;
+        anchored_end_ = compiler.anchored_end_;
+        ascii_only_ = compiler.ascii_only_;
+        unix_lines_ = (flags & UREGEX_UNIX_LINES);
+        inited_ = true;
+        supported = true;
+      }
+    }
+  }
+  LOG_TRACE("init regexp dfa", K(ret), K(supported), K(flags), KPC(this));
+  return ret;
+}
+
+int64_t ObExprRegexDfa::utf8_tail_start(const unsigned char *text, const int64_t len) const
+{
+  int64_t tail = len;
+  if (len <= 0) {
+  } else if (unix_lines_) {
+    tail = '\n' == text[len - 1] ? len - 1 : len;
+  } else if (len >= 2 && '\r' == text[len - 2] && '\n' == text[len - 1]) {
+    tail = len - 2;
+  } else if (('\n' <= text[len - 1] && text[len - 1] <= '\r')) {
+    tail = len - 1;
+  } else if (len >= 2 && 0xc2 == text[len - 2] && 0x85 == text[len - 1]) {
+    tail = len - 2;
+  } else if (len >= 3 && 0xe2 == text[len - 3] && 0x80 == text[len - 2]
+             && (0xa8 == text[len - 1] || 0xa9 == text[len - 1])) {
+    tail = len - 3;
+  }
+  return tail;
+}
+
+int64_t ObExprRegexDfa::utf16_tail_start(const unsigned char *text, const int64_t len) const
+{
+  int64_t tail = len;
+  const uint16_t last = len >= 2 ? static_cast<uint16_t>((text[len - 2] << 8) | text[len - 1]) : 0;
+  if (len < 2) {
+  } else if (unix_lines_) {
+    tail = '\n' == last ? len - 2 : len;
+  } else if ('\n' == last && len >= 4 && 0 == text[len - 4] && '\r' == text[len - 3]) {
+    tail = len - 4;
+  } else if (('\n' <= last && last <= '\r') || 0x85 == last || 0x2028 == last || 0x2029 == last) {
+    tail = len - 2;
+  }
+  return tail;
+}
+
+ObExprRegexDfa::MatchResult ObExprRegexDfa::match_utf8(const ObString &text) const
+{
+  MatchResult res = NOT_MATCH;
+  const unsigned char *begin = reinterpret_cast<const unsigned char *>(text.ptr());
+  const int64_t len = text.length();
+  const int64_t tail = anchored_end_ ? utf8_tail_start(begin, len) : -1;
+  int32_t state = start_state_;
+  bool done = false;
+  if (accept_[state] && !anchored_end_) {
+    res = MATCH;
+    done = true;
+  }
+  int64_t pos = 0;
+  while (!done && pos < len) {
+    if (pos == tail && accept_[state]) {
+      res = MATCH;
+      done = true;
+      break;
+    }
+    const unsigned char c = begin[pos];
+    int64_t sym = c;
+    if (OB_LIKELY(c < 0x80)) {
+      ++pos;
+    } else if (ascii_only_) {
+      res = UNDECIDED;
+      done = true;
+      break;
+    } else {
+      int64_t char_len = 0;
+      if (c >= 0xc2 && c <= 0xdf) {
+        char_len = 2;
+      } else if (c >= 0xe0 && c <= 0xef) {
+        char_len = 3;
+      } else if (c >= 0xf0 && c <= 0xf4) {
+        char_len = 4;
+      }
+      bool valid = char_len > 0 && pos + char_len <= len;
+      for (int64_t i = 1; valid && i < char_len; i++) {
+        valid = 0x80 == (begin[pos + i] & 0xc0);
+      }
+      if (valid && char_len > 2) {
+        const unsigned char c1 = begin[pos + 1];
+        // overlong, surrogate or out of range
+        valid = !((0xe0 == c && c1 < 0xa0) || (0xed == c && c1 > 0x9f)
+                  || (0xf0 == c && c1 < 0x90) || (0xf4 == c && c1 > 0x8f));
+      }
+      if (!valid) {
+        res = UNDECIDED;
+        done = true;
+        break;
+      }
+      const bool is_lt = !unix_lines_
+                         && ((2 == char_len && 0x85 == begin[pos + 1])
+                             || (3 == char_len && 0xe2 == c && 0x80 == begin[pos + 1]
+                                 && (0xa8 == begin[pos + 2] || 0xa9 == begin[pos + 2])));
+      sym = is_lt ? SYM_NON_ASCII_LT : SYM_NON_ASCII;
+      pos += char_len;
+    }
+    state = next_state(state, sym);
+    if (DEAD_STATE == state) {
+      done = true;
+    } else if (accept_[state] && !anchored_end_) {
+      res = MATCH;
+      done = true;
+    }
+  }
+  if (!done && anchored_end_ && accept_[state]) {
+    res = MATCH;
+  }
+  return res;
+}
+
+ObExprRegexDfa::MatchResult ObExprRegexDfa::match_utf16(const ObString &text) const
+{
+  MatchResult res = NOT_MATCH;
+  const unsigned char *begin = reinterpret_cast<const unsigned char *>(text.ptr());
+  const int64_t len = text.length();
+  int32_t state = start_state_;
+  bool done = false;
+  if (OB_UNLIKELY(0 != len % 2)) {
+    res = UNDECIDED;
+    done = true;
+  } else if (accept_[state] && !anchored_end_) {
+    res = MATCH;
+    done = true;
+  }
+  const int64_t tail = anchored_end_ && !done ? utf16_tail_start(begin, len) : -1;
+  int64_t pos = 0;
+  while (!done && pos < len) {
+    if (pos == tail && accept_[state]) {
+      res = MATCH;
+      done = true;
+      break;
+    }
+    const uint16_t u = static_cast<uint16_t>((begin[pos] << 8) | begin[pos + 1]);
+    int64_t sym = u;
+    if (OB_LIKELY(u < 0x80)) {
+      pos += 2;
+    } else if (ascii_only_) {
+      res = UNDECIDED;
+      done = true;
+      break;
+    } else if (u >= 0xd800 && u <= 0xdfff) {
+      const uint16_t u1 = pos + 4 <= len
+                          ? static_cast<uint16_t>((begin[pos + 2] << 8) | begin[pos + 3]) : 0;
+      if (u <= 0xdbff && u1 >= 0xdc00 && u1 <= 0xdfff) {
+        sym = SYM_NON_ASCII;
+        pos += 4;
+      } else {
+        res = UNDECIDED;
+        done = true;
+        break;
+      }
+    } else {
+      sym = (!unix_lines_ && (0x85 == u || 0x2028 == u || 0x2029 == u))
+            ? SYM_NON_ASCII_LT : SYM_NON_ASCII;
+      pos += 2;
+    }
+    state = next_state(state, sym);
+    if (DEAD_STATE == state) {
+      done = true;
+    } else if (accept_[state] && !anchored_end_) {
+      res = MATCH;
+      done = true;
+    }
+  }
+  if (!done && anchored_end_ && accept_[state]) {
+    res = MATCH;
+  }
+  return res;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
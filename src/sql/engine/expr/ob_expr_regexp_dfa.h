@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_EXPR_OB_EXPR_REGEXP_DFA_
+#define OCEANBASE_SQL_ENGINE_EXPR_OB_EXPR_REGEXP_DFA_
+
+#include "lib/allocator/ob_allocator.h"
+#include "lib/string/ob_string.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// Linear time matcher which answers whether a regular expression matches somewhere in the text,
+// compiled from the common subset of ICU syntax:
+//   literals, escaped punctuation, \t \n \r \f \a \e, \d \D \w \W \s \S, '.', bracket
+//   classes with ranges and negation, groups, (?:), alternation, greedy and lazy quantifiers,
+//   '^' at the beginning and '$' at the end of pattern.
+// Patterns out of the subset (back references, look around, word boundary, possessive
+// quantifiers, non-ASCII pattern characters ...) are not supported and ICU is used.
+//
+// The pattern is compiled into Thompson NFA and then into DFA over ASCII characters plus two
+// symbols for non-ASCII characters (line terminators and others), so the text is matched in its
+// own charset (UTF-8 or big endian UTF-16) without conversion. If the semantic of non-ASCII
+// characters is not certain (case insensitive matching, \d \w \s), or the text is not well
+// formed, UNDECIDED is returned and the caller should fall back to ICU.
+class ObExprRegexDfa
+{
+public:
+  enum MatchResult
+  {
+    NOT_MATCH = 0,
+    MATCH = 1,
+    UNDECIDED = 2,
+  };
+  // ASCII characters are symbols [0, 128)
+  static const int64_t SYM_NON_ASCII_LT = 128;
+  static const int64_t SYM_NON_ASCII = 129;
+  static const int64_t SYM_CNT = 130;
+  static const int64_t MAX_NFA_STATE_CNT = 4096;
+  static const int64_t MAX_DFA_STATE_CNT = 512;
+  static const int32_t DEAD_STATE = 0;
+
+public:
+  ObExprRegexDfa();
+  ~ObExprRegexDfa() { reset(); }
+  void reset();
+
+  // %pattern is big endian UTF-16 string and %flags is ICU flags, %supported is false if the
+  // pattern or flags can not be handled, memory of DFA is allocated from %alloc
+  // by one allocation.
+  int init(common::ObIAllocator &alloc,
+           const common::ObString &pattern,
+           const uint32_t flags,
+           bool &supported);
+  inline bool is_inited() const { return inited_; }
+  inline MatchResult match(const common::ObString &text, const bool is_utf16) const
+  {
+    return is_utf16 ? match_utf16(text) : match_utf8(text);
+  }
+
+  TO_STRING_KV(K_(inited), K_(state_cnt), K_(class_cnt), K_(start_state), K_(anchored_end),
+               K_(ascii_only), K_(unix_lines));
+
+private:
+  MatchResult match_utf8(const common::ObString &text) const;
+  MatchResult match_utf16(const common::ObString &text) const;
+  // byte offset of line terminator at the end of text, '$' also matches before it.
+  // return text length if not found.
+  int64_t utf8_tail_start(const unsigned char *text, const int64_t len) const;
+  int64_t utf16_tail_start(const unsigned char *text, const int64_t len) const;
+  inline int32_t next_state(const int32_t state, const int64_t sym) const
+  {
+    return trans_[state * class_cnt_ + sym_class_[sym]];
+  }
+
+private:
+  bool inited_;
+  bool anchored_end_;
+  // text with non-ASCII character is UNDECIDED
+  bool ascii_only_;
+  bool unix_lines_;
+  int32_t state_cnt_;
+  int32_t class_cnt_;
+  int32_t start_state_;
+  uint8_t sym_class_[SYM_CNT];
+  uint8_t *accept_;
+  int16_t *trans_;
+  DISALLOW_COPY_AND_ASSIGN(ObExprRegexDfa);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif // OCEANBASE_SQL_ENGINE_EXPR_OB_EXPR_REGEXP_DFA_
@@ -100,7 +100,12 @@ int ObExprRegexpLike::calc_result_typeN(ObExprResType &type,
       if (OB_FAIL(ret)) {
       } else if (OB_FAIL(ObExprRegexContext::check_need_utf8(raw_expr->get_param_expr(0), need_utf8))) {
         LOG_WARN("fail to check need utf8", K(ret));
-      } else if (need_utf8) {
+      } else if (need_utf8
+                 || (GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0
+                     && CHARSET_UTF8MB4 == ObCharset::charset_type_by_coll(types[0].get_collation_type()))) {
+        // utf8mb4 text is matched by DFA without conversion, and converted to utf16 in
+        // execution stage if ICU is needed. Old servers expect utf16 text, so the calc type
+        // is kept until the whole cluster is upgraded.
         types[0].set_calc_collation_type(is_case_sensitive ? CS_TYPE_UTF8MB4_BIN : CS_TYPE_UTF8MB4_GENERAL_CI);
       } else {
         types[0].set_calc_collation_type(is_case_sensitive ? CS_TYPE_UTF16_BIN : CS_TYPE_UTF16_GENERAL_CI);
@@ -127,6 +132,18 @@ int ObExprRegexpLike::cg_expr(ObExprCGCtx &op_cg_ctx, const ObRawExpr &raw_expr,
       const bool const_pattern = pattern->is_const_expr();
       rt_expr.extra_ = (!const_text && const_pattern) ? 1 : 0;
       rt_expr.eval_func_ = &eval_regexp_like;
+      // Only text is vectorized, the const pattern is compiled once per batch. Text cast in mysql
+      // mode is excluded, since invalid character of cast result is tolerated by row evaluation.
+      if (1 == rt_expr.extra_
+          && GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_2_0
+          && rt_expr.args_[0]->is_vectorize_result()
+          && !rt_expr.args_[1]->is_batch_result()
+          && (2 == rt_expr.arg_cnt_ || !rt_expr.args_[2]->is_batch_result())
+          && !ob_is_text_tc(rt_expr.args_[0]->datum_meta_.type_)
+          && !(lib::is_mysql_mode() && T_FUN_SYS_CAST == rt_expr.args_[0]->type_)) {
+        rt_expr.eval_batch_func_ = &eval_regexp_like_batch;
+        rt_expr.eval_vector_func_ = &eval_regexp_like_vector;
+      }
       LOG_DEBUG("regexp like expr cg", K(const_text), K(const_pattern), K(rt_expr.extra_));
     }
   }
@@ -240,6 +257,185 @@ int ObExprRegexpLike::eval_regexp_like(
   return ret;
 }
 
+int ObExprRegexpLike::prepare_batch_regexp_ctx(const ObExpr &expr,
+                                               ObEvalCtx &ctx,
+                                               const ObDatum &pattern,
+                                               const ObDatum *match_type,
+                                               ObExprRegexContext *&regexp_ctx)
+{
+  int ret = OB_SUCCESS;
+  regexp_ctx = NULL;
+  if (OB_UNLIKELY(ObExpr::INVALID_EXP_CTX_ID == expr.expr_ctx_id_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid expr ctx id", K(ret), K(expr));
+  } else if (lib::is_mysql_mode() && !pattern.is_null() && pattern.get_string().empty()) {
+    if (NULL == match_type || !match_type->is_null()) {
+      ret = OB_ERR_REGEXP_ERROR;
+      LOG_WARN("empty regex expression", K(ret));
+    }
+  } else if (!pattern.is_null()) {
+    ObString match_param = (NULL != match_type && !match_type->is_null())
+                           ? match_type->get_string() : ObString();
+    ObExprRegexpSessionVariables regexp_vars;
+    uint32_t flags = 0;
+    bool is_case_sensitive = ObCharset::is_bin_sort(expr.args_[0]->datum_meta_.cs_type_);
+    if (NULL == (regexp_ctx = static_cast<ObExprRegexContext *>(
+                ctx.exec_ctx_.get_expr_op_ctx(expr.expr_ctx_id_)))) {
+      if (OB_FAIL(ctx.exec_ctx_.create_expr_op_ctx(expr.expr_ctx_id_, regexp_ctx))) {
+        LOG_WARN("create expr regex context failed", K(ret), K(expr));
+      } else if (OB_ISNULL(regexp_ctx)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("NULL context returned", K(ret));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(ObExprRegexContext::get_regexp_flags(match_param, is_case_sensitive, flags))) {
+      LOG_WARN("fail to get regexp flags", K(ret), K(match_param));
+    } else if (OB_FAIL(ctx.exec_ctx_.get_my_session()->get_regexp_session_vars(regexp_vars))) {
+      LOG_WARN("fail to get regexp");
+    } else if (OB_FAIL(regexp_ctx->init(ctx.exec_ctx_.get_allocator(), regexp_vars,
+                                        pattern.get_string(), flags, true,
+                                        expr.args_[1]->datum_meta_.cs_type_))) {
+      LOG_WARN("fail to init regexp", K(pattern), K(flags), K(ret));
+    } else if (lib::is_mysql_mode() && NULL != match_type && match_type->is_null()) {
+      // pattern is checked already, result is null
+      regexp_ctx = NULL;
+    }
+  }
+  return ret;
+}
+
+int ObExprRegexpLike::match_text(const ObExpr &expr,
+                                 ObEvalCtx &ctx,
+                                 const ObExprRegexContext &regexp_ctx,
+                                 const ObString &text,
+                                 bool &match)
+{
+  int ret = OB_SUCCESS;
+  const ObCollationType cs_type = expr.args_[0]->datum_meta_.cs_type_;
+  const bool is_utf16 = (CS_TYPE_UTF16_BIN == cs_type || CS_TYPE_UTF16_GENERAL_CI == cs_type);
+  const ObExprRegexDfa::MatchResult dfa_res = regexp_ctx.dfa_match(text, is_utf16);
+  if (ObExprRegexDfa::UNDECIDED != dfa_res) {
+    match = (ObExprRegexDfa::MATCH == dfa_res);
+  } else {
+    ObEvalCtx::TempAllocGuard alloc_guard(ctx);
+    ObIAllocator &tmp_alloc = alloc_guard.get_allocator();
+    ObString text_utf16;
+    if (is_utf16) {
+      text_utf16 = text;
+    } else if (OB_FAIL(ObExprUtil::convert_string_collation(text, cs_type, text_utf16,
+                                        ObCharset::is_bin_sort(cs_type) ? CS_TYPE_UTF16_BIN : CS_TYPE_UTF16_GENERAL_CI,
+                                        tmp_alloc))) {
+      LOG_WARN("convert charset failed", K(ret));
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(regexp_ctx.match(tmp_alloc, text_utf16, 0, match))) {
+      LOG_WARN("fail to match", K(ret), K(text));
+    }
+  }
+  return ret;
+}
+
+int ObExprRegexpLike::eval_regexp_like_batch(BATCH_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  ObDatum *pattern = NULL;
+  ObDatum *match_type = NULL;
+  ObExprRegexContext *regexp_ctx = NULL;
+  if (OB_FAIL(expr.args_[1]->eval(ctx, pattern))) {
+    LOG_WARN("eval pattern failed", K(ret));
+  } else if (3 == expr.arg_cnt_ && OB_FAIL(expr.args_[2]->eval(ctx, match_type))) {
+    LOG_WARN("eval match type failed", K(ret));
+  } else if (OB_FAIL(expr.args_[0]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("eval text batch failed", K(ret));
+  } else if (OB_FAIL(prepare_batch_regexp_ctx(expr, ctx, *pattern, match_type, regexp_ctx))) {
+    LOG_WARN("prepare regexp ctx failed", K(ret));
+  } else {
+    ObDatum *res_datums = expr.locate_batch_datums(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    const ObDatum *text_datums = expr.args_[0]->locate_batch_datums(ctx);
+    const bool text_batch = expr.args_[0]->is_batch_result();
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; i++) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      const ObDatum &text = text_datums[text_batch ? i : 0];
+      bool match = false;
+      if (NULL == regexp_ctx || text.is_null()) {
+        res_datums[i].set_null();
+      } else if (OB_FAIL(match_text(expr, ctx, *regexp_ctx, text.get_string(), match))) {
+        LOG_WARN("match text failed", K(ret));
+      } else {
+        res_datums[i].set_int32(match);
+      }
+      eval_flags.set(i);
+    }
+  }
+  return ret;
+}
+
+template <typename TextVec, typename ResVec>
+int ObExprRegexpLike::vector_regexp_like(VECTOR_EVAL_FUNC_ARG_DECL,
+                                         const ObExprRegexContext *regexp_ctx)
+{
+  int ret = OB_SUCCESS;
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  const TextVec *text_vec = static_cast<const TextVec *>(expr.args_[0]->get_vector(ctx));
+  ResVec *res_vec = static_cast<ResVec *>(expr.get_vector(ctx));
+  for (int64_t i = bound.start(); OB_SUCC(ret) && i < bound.end(); i++) {
+    if (!(skip.at(i) || eval_flags.at(i))) {
+      bool match = false;
+      if (NULL == regexp_ctx || text_vec->is_null(i)) {
+        res_vec->set_null(i);
+      } else if (OB_FAIL(match_text(expr, ctx, *regexp_ctx, text_vec->get_string(i), match))) {
+        LOG_WARN("match text failed", K(ret));
+      } else {
+        res_vec->set_int(i, match);
+      }
+      eval_flags.set(i);
+    }
+  }
+  return ret;
+}
+
+int ObExprRegexpLike::eval_regexp_like_vector(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  ObExprRegexContext *regexp_ctx = NULL;
+  if (OB_FAIL(expr.args_[1]->eval_vector(ctx, skip, bound))) {
+    LOG_WARN("eval pattern failed", K(ret));
+  } else if (3 == expr.arg_cnt_ && OB_FAIL(expr.args_[2]->eval_vector(ctx, skip, bound))) {
+    LOG_WARN("eval match type failed", K(ret));
+  } else if (OB_FAIL(expr.args_[0]->eval_vector(ctx, skip, bound))) {
+    LOG_WARN("eval text failed", K(ret));
+  } else {
+    const ObDatum &pattern =
+      static_cast<ConstUniformFormat *>(expr.args_[1]->get_vector(ctx))->get_datum(0);
+    const ObDatum *match_type = 3 == expr.arg_cnt_
+      ? &static_cast<ConstUniformFormat *>(expr.args_[2]->get_vector(ctx))->get_datum(0) : NULL;
+    VectorFormat text_format = expr.args_[0]->get_format(ctx);
+    VectorFormat res_format = expr.get_format(ctx);
+    if (OB_FAIL(prepare_batch_regexp_ctx(expr, ctx, pattern, match_type, regexp_ctx))) {
+      LOG_WARN("prepare regexp ctx failed", K(ret));
+    } else if (VEC_DISCRETE == text_format && VEC_DISCRETE == res_format) {
+      ret = vector_regexp_like<StrDiscVec, StrDiscVec>(VECTOR_EVAL_FUNC_ARG_LIST, regexp_ctx);
+    } else if (VEC_UNIFORM == text_format && VEC_DISCRETE == res_format) {
+      ret = vector_regexp_like<StrUniVec, StrDiscVec>(VECTOR_EVAL_FUNC_ARG_LIST, regexp_ctx);
+    } else if (VEC_CONTINUOUS == text_format && VEC_DISCRETE == res_format) {
+      ret = vector_regexp_like<StrContVec, StrDiscVec>(VECTOR_EVAL_FUNC_ARG_LIST, regexp_ctx);
+    } else if (VEC_DISCRETE == text_format && VEC_UNIFORM == res_format) {
+      ret = vector_regexp_like<StrDiscVec, StrUniVec>(VECTOR_EVAL_FUNC_ARG_LIST, regexp_ctx);
+    } else if (VEC_UNIFORM == text_format && VEC_UNIFORM == res_format) {
+      ret = vector_regexp_like<StrUniVec, StrUniVec>(VECTOR_EVAL_FUNC_ARG_LIST, regexp_ctx);
+    } else if (VEC_CONTINUOUS == text_format && VEC_UNIFORM == res_format) {
+      ret = vector_regexp_like<StrContVec, StrUniVec>(VECTOR_EVAL_FUNC_ARG_LIST, regexp_ctx);
+    } else {
+      ret = vector_regexp_like<ObVectorBase, ObVectorBase>(VECTOR_EVAL_FUNC_ARG_LIST, regexp_ctx);
+    }
+  }
+  return ret;
+}
+
 int ObExprRegexpLike::is_valid_for_generated_column(const ObRawExpr*expr,
                                                     const common::ObIArray<ObRawExpr *> &exprs,
                                                     bool &is_valid) const {
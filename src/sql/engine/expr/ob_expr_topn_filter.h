@@ -40,7 +40,7 @@ public:
       : ObExprOperatorCtx(), topn_filter_msg_(nullptr), topn_filter_key_(), cmp_funcs_(),
         start_time_(0), ready_time_(0), filter_count_(0), total_count_(0), check_count_(0),
         n_times_(0), n_rows_(0), slide_window_(total_count_), flag_(0),
-        state_(FilterState::NOT_READY), row_selector_(nullptr)
+        state_(FilterState::NOT_READY), row_selector_(nullptr), direct_topn_cnt_(0)
   {
     is_first_ = true;
   }
@@ -146,6 +146,9 @@ public:
   };
   FilterState state_;
   uint16_t *row_selector_;
+  // the count of rows kept by the sort, only set when the sort is directly above the table scan,
+  // then the storage can skip projecting the rows which can not be in the top n.
+  int64_t direct_topn_cnt_;
 public:
   static const int64_t ROW_COUNT_CHECK_INTERVAL;
   static const int64_t EVAL_TIME_CHECK_INTERVAL;
@@ -20,43 +20,6 @@ namespace oceanbase
 {
 namespace sql
 {
-//template<typename T>
-//struct DirectItem {
-//  static const bool split_null = true;
-//  using CType = ObjTypeTrait<T>::c_type;
-//  void set_matched() { /*do nothing;*/ }
-//  bool is_matched() { /**/ }
-//  bool used() { return NULL == next_; };
-//  bool set_used(bool v);
-//  void set_next(DirectItem *item);
-//  DirectItem *get_next();
-//  DirectItem *construct(key_project, left_stored_rows[i]) {};
-//private:
-//  union {
-//    T hash_value_;
-//    T key_;
-//  }
-//  uint64_t row_ptr_;
-//  DirectItem *next_;
-//};
-//
-//template<typename T>
-//struct DirectFlagItem : public DirectItem {
-//
-//public:
-//  uint8_t flag_;
-//};
-
-//template<typename T>
-//struct DirectBucket : {
-//  using Item = DirectItem<T>;
-//public:
-//  T hash_value();
-//  Item *get_item();
-//public:
-//  Item item_;
-//};
-
 struct Int64Key {
   inline void init_data(const ObFixedArray<int64_t, common::ObIAllocator> *key_proj,
                  const RowMeta &row_meta,
@@ -235,13 +198,6 @@ private:
                               const int64_t batch_idx);
 };
 
-//template<typename Item>
-//struct DirectProber: public ProberBase<Item> {
-//  int equal(Item *item,  JoinTableCtx &ctx, const int64_t batch_idx, bool &is_equal) {
-//    return item->key_ == *(reinterpret_cast<Item::CType *>(ctx.get_probe_key(batch_idx)));
-//  }
-//}
-
 template<typename T>
 struct NormalizedProber final: public ProberBase<NormalizedItem<T>> {
   using Item = NormalizedItem<T>;
@@ -270,11 +226,15 @@ struct IHashTable {
 
   virtual int init(ObIAllocator &alloc, const int64_t max_batch_size) = 0;
   virtual int build_prepare(int64_t row_count, int64_t bucket_count) = 0;
+  // must be called before build_prepare, 0 == part_cnt means flat bucket layout
+  virtual void set_radix_partition(const int64_t part_shift, const int64_t part_cnt) = 0;
   virtual int insert_batch(JoinTableCtx &ctx,
                            ObHJStoredRow **stored_rows,
                            const int64_t size,
                            int64_t &used_buckets,
                            int64_t &collisions) = 0;
+  // called once after all rows of one build round are inserted
+  virtual int build_finish(JoinTableCtx &ctx, int64_t &used_buckets, int64_t &collisions) = 0;
   virtual int probe_prepare(JoinTableCtx &ctx, OutputInfo &output_info) = 0;
   virtual int probe_batch(JoinTableCtx &ctx, OutputInfo &output_info) = 0;
   virtual int project_matched_rows(JoinTableCtx &ctx, OutputInfo &output_info) = 0;
@@ -307,6 +267,15 @@ struct IHashTable {
 //
 // Buckets is array of <hash_value, store_row_ptr> pair, store rows linked in one bucket are
 // the same hash value.
+//
+// Radix clustered layout: if radix partition is set, buckets are split into %part_cnt regions,
+// the region is chosen by the partition bits of hash value (the same bits used by hash join to
+// split rows into partitions), and the position in region by the low bits, linear probing wraps
+// in region. Build rows are inserted partition by partition, so only one cache sized region is
+// touched at a time. Regions are disjoint, so partitions can also be inserted independently.
+// The caller must guarantee every region has empty bucket, i.e. rows of one partition are less
+// than the region size.
+// Probe rows of each batch are reordered by region in probe_prepare() for the same locality.
 template <typename Bucket, typename Prober>
 struct HashTable : public IHashTable
 {
@@ -324,16 +293,31 @@ struct HashTable : public IHashTable
         magic_(0),
         is_shared_(false),
         items_(NULL),
-        item_pos_(0)
+        item_pos_(0),
+        radix_part_shift_(0),
+        radix_part_cnt_(0),
+        radix_part_mask_(0),
+        region_bits_(0),
+        region_mask_(0)
   {
   }
   int init(ObIAllocator &alloc, const int64_t max_batch_size) override;
   int build_prepare(int64_t row_count, int64_t bucket_count) override;
+  void set_radix_partition(const int64_t part_shift, const int64_t part_cnt) override
+  {
+    radix_part_shift_ = part_shift;
+    radix_part_cnt_ = part_cnt;
+  }
   virtual int insert_batch(JoinTableCtx &ctx,
                            ObHJStoredRow **stored_rows,
                            const int64_t size,
                            int64_t &used_buckets,
                            int64_t &collisions) override;
+  virtual int build_finish(JoinTableCtx &ctx, int64_t &used_buckets, int64_t &collisions) override
+  {
+    UNUSEDx(ctx, used_buckets, collisions);
+    return common::OB_SUCCESS;
+  }
   int probe_prepare(JoinTableCtx &ctx, OutputInfo &output_info) override;
   int probe_batch(JoinTableCtx &ctx, OutputInfo &output_info) override {
     return ctx.probe_opt_  ? probe_batch_opt(ctx, output_info)
@@ -377,9 +361,21 @@ protected:
     int64_t idx = __sync_fetch_and_add(&item_pos_, 1);
     return &items_->at(idx);
   }
+  Item *new_item() { return &items_->at(item_pos_++); }
+  // set bucket layout after %nbuckets_ is decided
+  void init_bucket_layout();
+  inline uint64_t bucket_pos(const uint64_t hash_val) const
+  {
+    return (((hash_val >> radix_part_shift_) & radix_part_mask_) << region_bits_)
+           | (hash_val & region_mask_);
+  }
+  inline uint64_t next_bucket_pos(const uint64_t pos) const
+  {
+    return (pos & ~region_mask_) | ((pos + 1) & region_mask_);
+  }
 private:
   int init_probe_key_data(JoinTableCtx &ctx, OutputInfo &output_info);
-  Item *new_item() { return &items_->at(item_pos_++); }
+  void cluster_probe_rows(JoinTableCtx &ctx, OutputInfo &output_info);
   int probe_batch_opt(JoinTableCtx &ctx, OutputInfo &output_info);
   int probe_batch_normal(JoinTableCtx &ctx, OutputInfo &output_info);
   int probe_batch_del_match(JoinTableCtx &ctx, OutputInfo &output_info);
@@ -414,6 +410,12 @@ protected:
   ItemArray *items_;
   int64_t item_pos_;
   Prober prober_;
+  int64_t radix_part_shift_;
+  int64_t radix_part_cnt_;
+  // flat layout: %radix_part_mask_ is 0 and %region_mask_ is nbuckets_ - 1
+  uint64_t radix_part_mask_;
+  int64_t region_bits_;
+  uint64_t region_mask_;
 };
 
 struct GenericSharedHashTable final : public HashTable<GenericBucket, GenericProber>
@@ -455,8 +457,6 @@ private:
                         ObHJStoredRow *sr, int64_t &used_buckets, int64_t &collisions);
 };
 
-//using DirectInt8Table = HashTable<DirectBucket<int8_t>, NormalizedProber<int8_t>>;
-//using DirectInt16Table = HashTable<DirectBucket<int16_t>, NormalizedProber<int16_t>>;
 //using NormalizedInt32Table = HashTable<NormalizedBucket<int32_t>, NormalizedProber<int32_t>>;
 using NormalizedInt64Table = HashTable<NormalizedBucket<Int64Key>, NormalizedProber<Int64Key>>;
 using NormalizedInt128Table = HashTable<NormalizedBucket<Int128Key>, NormalizedProber<Int128Key>>;
@@ -466,6 +466,99 @@ using GenericTable = HashTable<GenericBucket, GenericProber>;
 using NormalizedSharedInt64Table = NormalizedSharedHashTable<NormalizedBucket<Int64Key>, NormalizedProber<Int64Key>>;
 using NormalizedSharedInt128Table = NormalizedSharedHashTable<NormalizedBucket<Int128Key>, NormalizedProber<Int128Key>>;
 
+// Direct addressed table for single integer join key with dense value range:
+//
+//   slots (key - min_key):
+//   +------------------------+
+//   | Item (key, row, next)  |------->+----------+      +----------+
+//   +------------------------+        | Item     |----->| Item     |
+//   | empty                  |        +----------+      +----------+
+//   +------------------------+
+//   ......
+//
+// Build rows are staged into %items_ and key range is collected during insert_batch,
+// build_finish() decides the layout: if the range is dense, slot array indexed by
+// (key - min_key) is built, probe needs neither hash calculation nor key comparison, all
+// items linked in one slot have the same key. Otherwise fall back to the normalized open
+// addressing buckets, staged items are linked into buckets directly.
+// Only used for none shared hash table, because build_finish need all rows are inserted.
+struct DirectInt64Table final : public NormalizedInt64Table
+{
+  using Item = NormalizedItem<Int64Key>;
+  // limit the memory of slot array, sizeof(Item) is 24 bytes
+  static const int64_t DIRECT_MAX_SLOT_CNT = 1L << 21;
+  static const int64_t DIRECT_MIN_SLOT_CNT = 1L << 10;
+  // slot count should not exceed DIRECT_DENSE_RATIO times of row count
+  static const int64_t DIRECT_DENSE_RATIO = 4;
+
+  DirectInt64Table()
+      : NormalizedInt64Table(),
+        slots_(NULL),
+        slot_cnt_(0),
+        slot_capacity_(0),
+        min_key_(INT64_MAX),
+        max_key_(INT64_MIN),
+        unallocated_mem_size_(0),
+        is_direct_(false)
+  {
+  }
+  int build_prepare(int64_t row_count, int64_t bucket_count) override;
+  int insert_batch(JoinTableCtx &ctx,
+                   ObHJStoredRow **stored_rows,
+                   const int64_t size,
+                   int64_t &used_buckets,
+                   int64_t &collisions) override;
+  int build_finish(JoinTableCtx &ctx, int64_t &used_buckets, int64_t &collisions) override;
+  int probe_batch(JoinTableCtx &ctx, OutputInfo &output_info) override {
+    return is_direct_ ? probe_batch_direct(ctx, output_info)
+                      : NormalizedInt64Table::probe_batch(ctx, output_info);
+  }
+  int get_unmatched_rows(JoinTableCtx &ctx, OutputInfo &output_info) override;
+  void reset() override;
+  void free(ObIAllocator *alloc) override;
+  // slots or buckets allocated by build_finish are reserved since build_prepare, so they are
+  // accounted by the sql memory manager before allocation.
+  int64_t get_mem_used() const override {
+    return NormalizedInt64Table::get_mem_used() + slot_capacity_ * sizeof(Item)
+           + unallocated_mem_size_;
+  }
+  bool is_direct() const { return is_direct_; }
+  static bool is_dense(const int64_t min_key, const int64_t max_key, const int64_t row_cnt)
+  {
+    // calculate in unsigned domain to avoid overflow
+    const uint64_t range = static_cast<uint64_t>(max_key) - static_cast<uint64_t>(min_key);
+    const int64_t dense_slot_cnt = row_cnt * DIRECT_DENSE_RATIO > DIRECT_MIN_SLOT_CNT
+                                   ? row_cnt * DIRECT_DENSE_RATIO : DIRECT_MIN_SLOT_CNT;
+    return min_key <= max_key
+           && range < static_cast<uint64_t>(DIRECT_MAX_SLOT_CNT)
+           && range < static_cast<uint64_t>(dense_slot_cnt);
+  }
+private:
+  int build_direct_slots(JoinTableCtx &ctx, int64_t &used_buckets);
+  int build_buckets(JoinTableCtx &ctx, int64_t &used_buckets, int64_t &collisions);
+  int probe_batch_direct(JoinTableCtx &ctx, OutputInfo &output_info);
+  void free_slots();
+  inline Item *get_slot(const int64_t key)
+  {
+    Item *item = reinterpret_cast<Item *>(END_ITEM);
+    if (key >= min_key_ && key <= max_key_) {
+      Item *slot = &slots_[key - min_key_];
+      if (0 != slot->row_ptr_) {
+        item = slot;
+      }
+    }
+    return item;
+  }
+private:
+  Item *slots_;
+  int64_t slot_cnt_;
+  int64_t slot_capacity_;
+  int64_t min_key_;
+  int64_t max_key_;
+  int64_t unallocated_mem_size_;
+  bool is_direct_;
+};
+
 } // end namespace sql
 } // end namespace oceanbase
 
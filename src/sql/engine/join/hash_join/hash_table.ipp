@@ -69,6 +69,7 @@ int HashTable<Bucket, Prober>::build_prepare(int64_t row_count, int64_t bucket_c
   collisions_ = 0;
   used_buckets_ = 0;
   buckets_->reuse();
+  init_bucket_layout();
   OZ (buckets_->init(nbuckets_));
   if (!std::is_same<Bucket, GenericBucket>::value) {
     items_->reuse();
@@ -76,17 +77,31 @@ int HashTable<Bucket, Prober>::build_prepare(int64_t row_count, int64_t bucket_c
     OZ (items_->init(row_count));
   }
 
-  LOG_DEBUG("build prepare", K(row_count), K(bucket_count), K_(nbuckets), KP(items_), K(sizeof(Bucket)));
+  LOG_DEBUG("build prepare", K(row_count), K(bucket_count), K_(nbuckets), KP(items_), K(sizeof(Bucket)),
+            K_(radix_part_cnt), K_(region_bits));
   return ret;
 }
 
+template <typename Bucket, typename Prober>
+void HashTable<Bucket, Prober>::init_bucket_layout()
+{
+  radix_part_mask_ = 0;
+  region_bits_ = 0;
+  region_mask_ = nbuckets_ - 1;
+  if (radix_part_cnt_ > 1 && nbuckets_ > radix_part_cnt_) {
+    // both are power of 2
+    region_bits_ = __builtin_ctzll(nbuckets_ / radix_part_cnt_);
+    region_mask_ = (1UL << region_bits_) - 1;
+    radix_part_mask_ = radix_part_cnt_ - 1;
+  }
+}
+
 // Get Item list which has the same hash value.
 // return NULL if not found.
 template <typename Bucket, typename Prober>
 inline typename Bucket::Item *HashTable<Bucket, Prober>::get(const uint64_t hash_val)
 {
-  uint64_t mask = nbuckets_ - 1;
-  uint64_t pos = hash_val & mask;
+  uint64_t pos = bucket_pos(hash_val);
   typename Bucket::Item *item = reinterpret_cast<typename Bucket::Item *>(END_ITEM);
   Bucket *bucket = &buckets_->at(pos);
   if (bucket->used()) {
@@ -98,8 +113,11 @@ inline typename Bucket::Item *HashTable<Bucket, Prober>::get(const uint64_t hash
       // next bucket
       ++bucket;
       ++pos;
-      if (OB_UNLIKELY(pos == ((pos >> bit_cnt_) << bit_cnt_) || pos == nbuckets_)) {
-        pos = (pos & mask);
+      if (OB_UNLIKELY(0 == (pos & region_mask_))) {
+        // wrap to the begin of region
+        pos -= region_mask_ + 1;
+        bucket = &buckets_->at(pos);
+      } else if (OB_UNLIKELY(pos == ((pos >> bit_cnt_) << bit_cnt_))) {
         bucket = &buckets_->at(pos);
       }
       // hash table must has empty bucket
@@ -114,10 +132,9 @@ void HashTable<Bucket, Prober>::get(uint64_t hash_val, Bucket *&bkt)
 {
   Bucket tmp_bucket;
   tmp_bucket.hash_value_ = hash_val;
-  uint64_t mask = nbuckets_ - 1;
-  uint64_t pos = tmp_bucket.hash_value() & mask;
+  uint64_t pos = bucket_pos(tmp_bucket.hash_value());
   bkt = NULL;
-  for (int64_t i = 0; i < nbuckets_; i += 1, pos = ((pos + 1) & mask)) {
+  for (int64_t i = 0; i < nbuckets_; i += 1, pos = next_bucket_pos(pos)) {
     Bucket &bucket = buckets_->at(pos);
     if (!bucket.used()) {
       break;
@@ -139,9 +156,8 @@ void HashTable<Bucket, Prober>::set(JoinTableCtx &ctx,
   const RowMeta &row_meta = ctx.build_row_meta_;
   Bucket tmp_bucket;
   tmp_bucket.hash_value_ = hash_val;
-  uint64_t mask = nbuckets_ - 1;
-  uint64_t pos = tmp_bucket.hash_value_ & mask;
-  for (int64_t i = 0; i < nbuckets_; i += 1, pos = ((pos + 1) & mask)) {
+  uint64_t pos = bucket_pos(tmp_bucket.hash_value_);
+  for (int64_t i = 0; i < nbuckets_; i += 1, pos = next_bucket_pos(pos)) {
     Bucket &bucket = buckets_->at(pos);
     if (!bucket.used()) {
       Item *item = NULL;
@@ -186,9 +202,8 @@ void HashTable<Bucket, Prober>::del(const uint64_t hash_val, const RowMeta &row_
 {
   Bucket tmp_bucket;
   tmp_bucket.hash_value_ = hash_val;
-  uint64_t mask = nbuckets_ - 1;
-  uint64_t pos = tmp_bucket.hash_value_ & mask;
-  for (int64_t i = 0; i < nbuckets_; i += 1, pos = ((pos + 1) & mask)) {
+  uint64_t pos = bucket_pos(tmp_bucket.hash_value_);
+  for (int64_t i = 0; i < nbuckets_; i += 1, pos = next_bucket_pos(pos)) {
     Bucket &bucket = buckets_->at(pos);
     if (!bucket.used()) {
       break;
@@ -265,9 +280,8 @@ int HashTable<Bucket, Prober>::insert_batch(JoinTableCtx &ctx,
                                             int64_t &collisions)
 {
   int ret = OB_SUCCESS;
-  auto mask = nbuckets_ - 1;
   for (auto i = 0; i < size; i++) {
-    __builtin_prefetch((&buckets_->at(stored_rows[i]->get_hash_value(ctx.build_row_meta_) & mask)),
+    __builtin_prefetch((&buckets_->at(bucket_pos(stored_rows[i]->get_hash_value(ctx.build_row_meta_)))),
                         1 /* write */, 3 /* high temporal locality*/);
   }
   for (int64_t i = 0; i < size; ++i) {
@@ -293,20 +307,46 @@ int HashTable<Bucket, Prober>::probe_prepare(JoinTableCtx &ctx, OutputInfo &outp
       LOG_WARN("fail to init probe keys", K(ret));
     }
   }
+  if (OB_SUCC(ret) && 0 != radix_part_mask_) {
+    cluster_probe_rows(ctx, output_info);
+  }
 
   return ret;
 }
 
+// Reorder the selector of probe batch by the region of bucket (stable counting sort on the
+// partition bits), so rows of the batch are probed region by region like the build rows are
+// inserted, instead of jumping over the whole bucket array for every row.
+// Only the order of rows in selector changes, the output rows are still located by batch index.
+template <typename Bucket, typename Prober>
+void HashTable<Bucket, Prober>::cluster_probe_rows(JoinTableCtx &ctx, OutputInfo &output_info)
+{
+  const uint64_t *hash_vals = ctx.probe_batch_rows_->hash_vals_;
+  uint16_t *offsets = ctx.radix_part_offsets_;
+  uint16_t *selector = ctx.radix_selector_;
+  MEMSET(offsets, 0, sizeof(*offsets) * (radix_part_mask_ + 2));
+  for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+    offsets[((hash_vals[output_info.selector_[i]] >> radix_part_shift_) & radix_part_mask_) + 1]++;
+  }
+  for (uint64_t i = 1; i <= radix_part_mask_; i++) {
+    offsets[i] += offsets[i - 1];
+  }
+  for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+    const uint16_t batch_idx = output_info.selector_[i];
+    selector[offsets[(hash_vals[batch_idx] >> radix_part_shift_) & radix_part_mask_]++] = batch_idx;
+  }
+  MEMCPY(output_info.selector_, selector, sizeof(*selector) * output_info.selector_cnt_);
+}
+
 template <typename Bucket, typename Prober>
 int HashTable<Bucket, Prober>::probe_batch_normal(JoinTableCtx &ctx, OutputInfo &output_info)
 {
   int ret = OB_SUCCESS;
   if (output_info.first_probe_) {
     uint64_t *hash_vals = ctx.probe_batch_rows_->hash_vals_;
-    uint64_t mask = nbuckets_ - 1;
     for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
       int64_t hash_val = hash_vals[output_info.selector_[i]];
-      __builtin_prefetch(&buckets_->at(hash_val & mask), 0, 1 /*low temporal locality*/);
+      __builtin_prefetch(&buckets_->at(bucket_pos(hash_val)), 0, 1 /*low temporal locality*/);
     }
     int64_t new_selector_cnt = 0;
     int64_t batch_idx = 0;
@@ -414,10 +454,9 @@ int HashTable<Bucket, Prober>::probe_batch_opt(JoinTableCtx &ctx, OutputInfo &ou
   int ret = OB_SUCCESS;
   if (output_info.first_probe_) {
     uint64_t *hash_vals = ctx.probe_batch_rows_->hash_vals_;
-    uint64_t mask = nbuckets_ - 1;
     for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
       int64_t hash_val = hash_vals[output_info.selector_[i]];
-      __builtin_prefetch(&buckets_->at(hash_val & mask), 0, 1 /*low temporal locality*/);
+      __builtin_prefetch(&buckets_->at(bucket_pos(hash_val)), 0, 1 /*low temporal locality*/);
     }
     int64_t new_selector_cnt = 0;
     int64_t batch_idx = 0;
@@ -787,5 +826,238 @@ inline int NormalizedSharedHashTable<Bucket, Prober>::atomic_set(JoinTableCtx &c
   return ret;
 }
 
+inline int DirectInt64Table::build_prepare(int64_t row_count, int64_t bucket_count)
+{
+  int ret = OB_SUCCESS;
+  // buckets are allocated lazily in build_finish if key range is not dense
+  row_count_ = row_count;
+  nbuckets_ = std::max(nbuckets_, bucket_count);
+  collisions_ = 0;
+  used_buckets_ = 0;
+  buckets_->reuse();
+  init_bucket_layout();
+  items_->reuse();
+  item_pos_ = 0;
+  OZ (items_->init(row_count));
+  slot_cnt_ = 0;
+  min_key_ = INT64_MAX;
+  max_key_ = INT64_MIN;
+  is_direct_ = false;
+  if (OB_SUCC(ret)) {
+    // the layout is unknown until build_finish, reserve the larger one of them.
+    const int64_t max_slot_cnt = std::min(DIRECT_MAX_SLOT_CNT,
+        std::max(row_count * DIRECT_DENSE_RATIO, DIRECT_MIN_SLOT_CNT));
+    const int64_t slot_mem_size = (max_slot_cnt - slot_capacity_) * static_cast<int64_t>(sizeof(Item));
+    const int64_t bucket_mem_size = nbuckets_ * static_cast<int64_t>(sizeof(NormalizedBucket<Int64Key>))
+                                    - buckets_->mem_used();
+    unallocated_mem_size_ = std::max(0L, std::max(slot_mem_size, bucket_mem_size));
+  }
+  LOG_DEBUG("direct table build prepare", K(row_count), K(bucket_count), K_(nbuckets),
+            K_(unallocated_mem_size));
+  return ret;
+}
+
+inline int DirectInt64Table::insert_batch(JoinTableCtx &ctx,
+                                          ObHJStoredRow **stored_rows,
+                                          const int64_t size,
+                                          int64_t &used_buckets,
+                                          int64_t &collisions)
+{
+  int ret = OB_SUCCESS;
+  UNUSEDx(used_buckets, collisions);
+  if (OB_UNLIKELY(item_pos_ + size > items_->count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("too many rows for direct table", K(ret), K_(item_pos), K(size), K(items_->count()));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < size; ++i) {
+    Item *item = new_item();
+    item->init(ctx, ctx.build_row_meta_, stored_rows[i], reinterpret_cast<Item *>(END_ITEM));
+    min_key_ = std::min(min_key_, item->key_.data_);
+    max_key_ = std::max(max_key_, item->key_.data_);
+  }
+  return ret;
+}
+
+inline int DirectInt64Table::build_finish(JoinTableCtx &ctx,
+                                          int64_t &used_buckets,
+                                          int64_t &collisions)
+{
+  int ret = OB_SUCCESS;
+  if (0 == item_pos_) {
+    // empty build side, every probe row misses
+    is_direct_ = true;
+  } else if (is_dense(min_key_, max_key_, item_pos_)) {
+    if (OB_FAIL(build_direct_slots(ctx, used_buckets))) {
+      LOG_WARN("failed to build direct slots", K(ret));
+    }
+  } else if (OB_FAIL(build_buckets(ctx, used_buckets, collisions))) {
+    LOG_WARN("failed to build buckets", K(ret));
+  }
+  unallocated_mem_size_ = 0;
+  LOG_TRACE("direct table build finish", K(ret), K_(is_direct), K_(item_pos), K_(min_key),
+            K_(max_key), K_(slot_cnt), K_(nbuckets));
+  return ret;
+}
+
+inline int DirectInt64Table::build_direct_slots(JoinTableCtx &ctx, int64_t &used_buckets)
+{
+  int ret = OB_SUCCESS;
+  const int64_t slot_cnt = max_key_ - min_key_ + 1;
+  if (slot_cnt > slot_capacity_) {
+    free_slots();
+    void *buf = ht_alloc_->alloc(slot_cnt * sizeof(Item));
+    if (OB_ISNULL(buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc slots", K(ret), K(slot_cnt));
+    } else {
+      slots_ = static_cast<Item *>(buf);
+      slot_capacity_ = slot_cnt;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    MEMSET(slots_, 0, slot_cnt * sizeof(Item));
+    slot_cnt_ = slot_cnt;
+    for (int64_t i = 0; i < item_pos_; i++) {
+      __builtin_prefetch(&slots_[items_->at(i).key_.data_ - min_key_],
+                         1 /* write */, 3 /* high temporal locality*/);
+    }
+    for (int64_t i = 0; i < item_pos_; i++) {
+      Item &item = items_->at(i);
+      Item &slot = slots_[item.key_.data_ - min_key_];
+      if (0 == slot.row_ptr_) {
+        slot = item;
+        slot.set_next(ctx.build_row_meta_, reinterpret_cast<Item *>(END_ITEM));
+        used_buckets += 1;
+      } else {
+        // the same key, link after the slot item, the order of equal rows does not matter
+        item.set_next(ctx.build_row_meta_, slot.get_next(ctx.build_row_meta_));
+        slot.set_next(ctx.build_row_meta_, &item);
+      }
+    }
+    is_direct_ = true;
+  }
+  return ret;
+}
+
+inline int DirectInt64Table::build_buckets(JoinTableCtx &ctx,
+                                           int64_t &used_buckets,
+                                           int64_t &collisions)
+{
+  int ret = OB_SUCCESS;
+  const RowMeta &row_meta = ctx.build_row_meta_;
+  if (OB_FAIL(buckets_->init(nbuckets_))) {
+    LOG_WARN("failed to init buckets", K(ret), K_(nbuckets));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < item_pos_; i++) {
+    Item *item = &items_->at(i);
+    NormalizedBucket<Int64Key> tmp_bucket;
+    tmp_bucket.hash_value_ = item->get_stored_row()->get_hash_value(row_meta);
+    uint64_t pos = bucket_pos(tmp_bucket.hash_value_);
+    for (int64_t j = 0; j < nbuckets_; j += 1, pos = next_bucket_pos(pos)) {
+      NormalizedBucket<Int64Key> &bucket = buckets_->at(pos);
+      if (!bucket.used()) {
+        bucket.set_item(item);
+        bucket.hash_value_ = tmp_bucket.hash_value_;
+        bucket.set_used(true);
+        used_buckets += 1;
+        break;
+      } else if (bucket.hash_value_ == tmp_bucket.hash_value_) {
+        // staged item is reused as chain item, no extra copy
+        item->set_next(row_meta, bucket.get_item()->get_next(row_meta));
+        bucket.get_item()->set_next(row_meta, item);
+        break;
+      }
+      collisions += 1;
+    }
+  }
+  return ret;
+}
+
+inline int DirectInt64Table::probe_batch_direct(JoinTableCtx &ctx, OutputInfo &output_info)
+{
+  int ret = OB_SUCCESS;
+  int64_t new_selector_cnt = 0;
+  int64_t batch_idx = 0;
+  Item *item = NULL;
+  if (OB_UNLIKELY(ctx.need_probe_del_match() || ctx.need_mark_match())) {
+    // matched items are neither deleted from slots nor marked, see JoinHashTable::use_direct_ht
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("direct table does not support join type", K(ret), K(ctx.join_type_));
+  } else if (output_info.first_probe_) {
+    const int64_t *keys = reinterpret_cast<const int64_t *>(ctx.probe_batch_rows_->key_data_);
+    for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+      const int64_t key = keys[output_info.selector_[i]];
+      if (key >= min_key_ && key <= max_key_) {
+        __builtin_prefetch(&slots_[key - min_key_], 0, 1 /*low temporal locality*/);
+      }
+    }
+    for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+      batch_idx = output_info.selector_[i];
+      item = get_slot(keys[batch_idx]);
+      if (END_ITEM != reinterpret_cast<uint64_t>(item)) {
+        // all items in one slot have the same key, no need to compare
+        output_info.left_result_rows_[new_selector_cnt] = item->get_stored_row();
+        ctx.cur_items_[new_selector_cnt] = item->get_next(ctx.build_row_meta_);
+        output_info.selector_[new_selector_cnt++] = batch_idx;
+      }
+    }
+    output_info.first_probe_ = false;
+  } else {
+    for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+      item = reinterpret_cast<Item *>(ctx.cur_items_[i]);
+      if (END_ITEM != reinterpret_cast<uint64_t>(item)) {
+        batch_idx = output_info.selector_[i];
+        output_info.left_result_rows_[new_selector_cnt] = item->get_stored_row();
+        ctx.cur_items_[new_selector_cnt] = item->get_next(ctx.build_row_meta_);
+        output_info.selector_[new_selector_cnt++] = batch_idx;
+      }
+    }
+  }
+  output_info.selector_cnt_ = new_selector_cnt;
+  LOG_DEBUG("direct probe batch", K(new_selector_cnt), K_(min_key), K_(max_key));
+  return ret;
+}
+
+inline int DirectInt64Table::get_unmatched_rows(JoinTableCtx &ctx, OutputInfo &output_info)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_direct_)) {
+    // only inner and right semi join use the direct table, see JoinHashTable::use_direct_ht
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("direct table has no unmatched rows to output", K(ret), K(ctx.join_type_));
+  } else {
+    ret = NormalizedInt64Table::get_unmatched_rows(ctx, output_info);
+  }
+  return ret;
+}
+
+inline void DirectInt64Table::free_slots()
+{
+  if (OB_NOT_NULL(slots_) && OB_NOT_NULL(ht_alloc_)) {
+    ht_alloc_->free(slots_);
+  }
+  slots_ = NULL;
+  slot_capacity_ = 0;
+  slot_cnt_ = 0;
+}
+
+inline void DirectInt64Table::reset()
+{
+  free_slots();
+  NormalizedInt64Table::reset();
+  min_key_ = INT64_MAX;
+  max_key_ = INT64_MIN;
+  unallocated_mem_size_ = 0;
+  is_direct_ = false;
+}
+
+inline void DirectInt64Table::free(ObIAllocator *alloc)
+{
+  free_slots();
+  NormalizedInt64Table::free(alloc);
+  unallocated_mem_size_ = 0;
+  is_direct_ = false;
+}
+
 } // end namespace sql
 } // end namespace oceanbase
@@ -41,6 +41,18 @@ bool JoinHashTable::use_normalized_ht(JoinTableCtx &hjt_ctx)
   return ret;
 }
 
+// direct addressed table needs all build rows before deciding the layout,
+// so it's not used for shared hash table which is built by multiple threads.
+// matched build rows are never deleted from the slots, so join types which need
+// probe_batch_del_match (left semi/anti) keep the normalized table.
+bool JoinHashTable::use_direct_ht(JoinTableCtx &hjt_ctx)
+{
+  return !hjt_ctx.is_shared_
+         && (INNER_JOIN == hjt_ctx.join_type_ || RIGHT_SEMI_JOIN == hjt_ctx.join_type_)
+         && 1 == hjt_ctx.build_keys_->count()
+         && use_normalized_ht(hjt_ctx);
+}
+
 int JoinHashTable::init(JoinTableCtx &hjt_ctx, ObIAllocator &allocator)
 {
   int ret = OB_SUCCESS;
@@ -60,7 +72,9 @@ int JoinHashTable::init(JoinTableCtx &hjt_ctx, ObIAllocator &allocator)
       hash_table_ = OB_NEWx(GenericSharedHashTable, (&allocator));
     }
   } else {
-    if (use_normalized ) {
+    if (use_direct_ht(hjt_ctx)) {
+      hash_table_ = OB_NEWx(DirectInt64Table, (&allocator));
+    } else if (use_normalized ) {
       if (1 == hjt_ctx.build_keys_->count()) {
         hash_table_ = OB_NEWx(NormalizedInt64Table, (&allocator));
       } else if (2 == hjt_ctx.build_keys_->count()) {
@@ -81,6 +95,9 @@ int JoinHashTable::init(JoinTableCtx &hjt_ctx, ObIAllocator &allocator)
 
 int JoinHashTable::build_prepare(JoinTableCtx &ctx, int64_t row_count, int64_t bucket_count) {
   ctx.reuse();
+  // shared hash table is inserted by multiple threads with atomic set, keep flat layout
+  hash_table_->set_radix_partition(ctx.radix_part_shift_,
+                                   ctx.is_shared_ ? 0 : ctx.radix_part_cnt_);
   return hash_table_->build_prepare(row_count, bucket_count);
 }
 
@@ -111,6 +128,19 @@ int JoinHashTable::build(JoinPartitionRowIter &iter, JoinTableCtx &ctx) {
   return ret;
 }
 
+// must be called once after all build rows are inserted by build()
+int JoinHashTable::build_finish(JoinTableCtx &ctx) {
+  int ret = OB_SUCCESS;
+  int64_t used_buckets = 0;
+  int64_t collisions = 0;
+  if (OB_FAIL(hash_table_->build_finish(ctx, used_buckets, collisions))) {
+    LOG_WARN("fail to finish build", K(ret));
+  } else {
+    hash_table_->set_diag_info(used_buckets, collisions);
+  }
+  return ret;
+}
+
 // init probe key
 // hash_table probe prepare
 //   * prefect bucket for probe active rows
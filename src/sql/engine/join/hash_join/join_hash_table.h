@@ -26,8 +26,10 @@ public:
   {}
   int init(JoinTableCtx &hjt_ctx, ObIAllocator &allocator);
   bool use_normalized_ht(JoinTableCtx &hjt_ctx);
+  bool use_direct_ht(JoinTableCtx &hjt_ctx);
   int build_prepare(JoinTableCtx &ctx, int64_t row_count, int64_t bucket_count);
   int build(JoinPartitionRowIter &iter, JoinTableCtx &jt_ctx);
+  int build_finish(JoinTableCtx &ctx);
   int probe_prepare(JoinTableCtx &ctx, OutputInfo &output_info);
   int probe_batch(JoinTableCtx &ctx, OutputInfo &output_info);
   int project_matched_rows(JoinTableCtx &ctx, OutputInfo &output_info) {
@@ -214,7 +214,9 @@ public:
                    build_key_proj_(NULL), probe_key_proj_(NULL), cur_bkid_(-1),
                    cur_tuple_(reinterpret_cast<void *>(END_ITEM)), max_output_cnt_(NULL),
                    cur_items_(NULL), stored_rows_(NULL), max_batch_size_(0),
-                   output_info_(NULL), probe_batch_rows_(NULL)
+                   output_info_(NULL), probe_batch_rows_(NULL),
+                   radix_part_shift_(0), radix_part_cnt_(0),
+                   radix_selector_(NULL), radix_part_offsets_(NULL)
   {}
   void reuse() {
     cur_bkid_ = -1;
@@ -275,6 +277,14 @@ public:
 
   OutputInfo *output_info_;
   ProbeBatchRows *probe_batch_rows_;
+  // partition bits of hash value used to cluster buckets of hash table by partition,
+  // set before build prepare, 0 == radix_part_cnt_ means not clustered
+  int64_t radix_part_shift_;
+  int64_t radix_part_cnt_;
+  // template buffers to cluster probe rows by partition, %radix_part_offsets_ has
+  // (max partition count + 1) elements
+  uint16_t *radix_selector_;
+  uint16_t *radix_part_offsets_;
 };
 
 struct ObHJSharedTableInfo
@@ -278,7 +278,10 @@ int ObHashJoinVecOp::inner_open()
                        probe_batch_rows_.brs_.skip_, ObBitVector::memory_size(batch_size),
                        probe_batch_rows_.key_data_, join_table_.get_normalized_key_size() * batch_size,
                        jt_ctx_.stored_rows_, sizeof(*jt_ctx_.stored_rows_) * batch_size,
-                       jt_ctx_.cur_items_, sizeof(*jt_ctx_.cur_items_) * batch_size));
+                       jt_ctx_.cur_items_, sizeof(*jt_ctx_.cur_items_) * batch_size,
+                       jt_ctx_.radix_selector_, sizeof(*jt_ctx_.radix_selector_) * batch_size,
+                       jt_ctx_.radix_part_offsets_,
+                       sizeof(*jt_ctx_.radix_part_offsets_) * (MAX_PART_COUNT_PER_LEVEL + 1)));
     const ObExprPtrIArray &left_output = left_->get_spec().output_;
     left_vectors_.set_allocator(&mem_context_->get_arena_allocator());
     OZ (left_vectors_.init(left_output.count()));
@@ -833,7 +836,11 @@ int ObHashJoinVecOp::build_hash_table_for_nest_loop(int64_t &num_left_rows)
     hj_part->set_iteration_age(iter_age_);
     iter_age_.inc();
     JoinPartitionRowIter left_iter(hj_part, row_bound, memory_bound);
-    ret = hash_table.build(left_iter, jt_ctx_);
+    if (OB_FAIL(hash_table.build(left_iter, jt_ctx_))) {
+      LOG_WARN("failed to build hash table", K(ret));
+    } else if (OB_FAIL(hash_table.build_finish(jt_ctx_))) {
+      LOG_WARN("failed to finish build hash table", K(ret));
+    }
   }
   if (OB_SUCC(ret)) {
     num_left_rows = hash_table.get_row_count();
@@ -1218,7 +1225,11 @@ int ObHashJoinVecOp::build_hash_table_in_memory(int64_t &num_left_rows)
     hj_part->set_iteration_age(iter_age_);
     iter_age_.inc();
     JoinPartitionRowIter left_iter(hj_part);
-    ret = hash_table.build(left_iter, jt_ctx_);
+    if (OB_FAIL(hash_table.build(left_iter, jt_ctx_))) {
+      LOG_WARN("failed to build hash table", K(ret));
+    } else if (OB_FAIL(hash_table.build_finish(jt_ctx_))) {
+      LOG_WARN("failed to finish build hash table", K(ret));
+    }
   }
 
   if (OB_SUCC(ret)) {
@@ -2032,6 +2043,7 @@ int ObHashJoinVecOp::prepare_hash_table()
               K(build_ht_thread_ptr), K(reinterpret_cast<uint64_t>(this)));
   }
   if (OB_SUCC(ret) && need_build_hash_table) {
+    calc_radix_partition();
     if (OB_FAIL(cur_join_table_->build_prepare(jt_ctx_, profile_.get_row_count(), profile_.get_bucket_size()))) {
       LOG_WARN("trace failed to  prepare hash table",
                K(profile_.get_expect_size()), K(profile_.get_bucket_size()), K(profile_.get_row_count()),
@@ -2040,7 +2052,7 @@ int ObHashJoinVecOp::prepare_hash_table()
       LOG_WARN("failed to update used mem size", K(ret));
     }
     LOG_TRACE("trace prepare hash table", K(ret), K(profile_.get_bucket_size()), K(profile_.get_row_count()),
-              K(part_count_), K(profile_.get_expect_size()), K(spec_.id_));
+              K(part_count_), K(profile_.get_expect_size()), K(jt_ctx_.radix_part_cnt_), K(spec_.id_));
   }
   if (OB_SUCC(ret) && is_shared_ && OB_FAIL(sync_wait_init_build_hash(build_ht_thread_ptr))) {
     LOG_WARN("failed to sync wait init hash table", K(ret));
@@ -2049,6 +2061,36 @@ int ObHashJoinVecOp::prepare_hash_table()
   return ret;
 }
 
+// In recursive mode build rows are already split into partitions by hash bits, and the hash
+// table is built partition by partition. If the hash table exceeds L2 cache, cluster its buckets
+// by partition (see HashTable), so each partition is built in its own cache sized region instead
+// of scattering over the whole bucket array. Probe batches are clustered by the same bits
+// before probing.
+// Region of one partition must never be full, so it's only used when the largest in-memory
+// partition fits in its region with the same load factor as the whole table.
+void ObHashJoinVecOp::calc_radix_partition()
+{
+  int64_t radix_part_cnt = 0;
+  if (HJProcessor::RECURSIVE == hj_processor_ && !is_shared_
+      && part_count_ > 1 && part_count_ <= MAX_PART_COUNT_PER_LEVEL && NULL != left_part_array_) {
+    const int64_t nbuckets = profile_.get_bucket_size();
+    const int64_t region_size = nbuckets / part_count_;
+    int64_t max_part_rows = 0;
+    for (int64_t i = 0; i < part_count_; ++i) {
+      max_part_rows = max(max_part_rows, left_part_array_[i]->get_row_count_in_memory());
+    }
+    if (nbuckets * cur_join_table_->get_one_bucket_size() > INIT_L2_CACHE_SIZE
+        && region_size >= RADIX_MIN_REGION_SIZE
+        && max_part_rows * RATIO_OF_BUCKETS <= region_size
+        // bucket position in region must not overlap with partition bits
+        && __builtin_ctzll(region_size) <= part_shift_) {
+      radix_part_cnt = part_count_;
+    }
+  }
+  jt_ctx_.radix_part_shift_ = part_shift_;
+  jt_ctx_.radix_part_cnt_ = radix_part_cnt;
+}
+
 void ObHashJoinVecOp::trace_hash_table_collision(int64_t row_cnt)
 {
   int64_t total_cnt = cur_join_table_->get_collisions();
@@ -2100,7 +2142,9 @@ int ObHashJoinVecOp::build_hash_table_for_recursive()
       }
     }
   } // for end
-
+  if (OB_SUCC(ret) && OB_FAIL(hash_table.build_finish(jt_ctx_))) {
+    LOG_WARN("failed to finish build hash table", K(ret));
+  }
 
   // In order to be consistent with the nest loop method, this flag indicates that
   // in recursive mode, if there is no dump, it must be in-memory.
@@ -363,6 +363,7 @@ private:
   int dump_build_table(int64_t row_count, bool force_update = false);
   int split_partition(int64_t &num_left_rows);
   int prepare_hash_table();
+  void calc_radix_partition();
   void trace_hash_table_collision(int64_t row_cnt);
   int build_hash_table_for_recursive();
   int recursive_process(int64_t &num_left_rows);
@@ -525,6 +526,8 @@ private:
   static const int64_t MIN_BATCH_ROW_CNT_NESTLOOP = 256;
   static const int64_t PRICE_PER_ROW = 48;
   static const int64_t MAX_PART_COUNT_PER_LEVEL = INIT_LTB_SIZE<< 1;
+  // min bucket count of one partition region in radix clustered hash table
+  static const int64_t RADIX_MIN_REGION_SIZE = 256;
 
   int64_t max_output_cnt_;
   HJState hj_state_;
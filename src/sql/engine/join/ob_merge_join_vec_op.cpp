@@ -0,0 +1,1136 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/join/ob_merge_join_vec_op.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "share/vector/ob_fixed_length_base.h"
+#include "share/vector/ob_uniform_base.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+OB_SERIALIZE_MEMBER((ObMergeJoinVecSpec, ObJoinVecSpec),
+                    left_keys_, right_keys_, is_ns_equal_cond_,
+                    merge_directions_, is_left_unique_,
+                    left_child_fetcher_all_exprs_,
+                    right_child_fetcher_all_exprs_);
+
+const int64_t ObMergeJoinVecSpec::MERGE_DIRECTION_ASC = 1;
+const int64_t ObMergeJoinVecSpec::MERGE_DIRECTION_DESC = -1;
+
+int ObMergeJoinVecSpec::set_merge_directions(const ObIArray<ObOrderDirection> &merge_directions)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(merge_directions_.init(merge_directions.count()))) {
+    LOG_WARN("fail to init merge direction", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < merge_directions.count(); i++) {
+    if (OB_FAIL(merge_directions_.push_back(is_ascending_direction(merge_directions.at(i))
+                                            ? MERGE_DIRECTION_ASC : MERGE_DIRECTION_DESC))) {
+      LOG_WARN("failed to add merge direction", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::ChildFetcher::init(ObOperator *child, const ExprFixedArray *all_exprs,
+                                         const ExprFixedArray *keys,
+                                         const ObIArray<int64_t> *key_proj,
+                                         const int64_t batch_size, const bool is_unique,
+                                         const lib::ObMemAttr &attr)
+{
+  int ret = OB_SUCCESS;
+  ObIAllocator &alloc = op_.ctx_.get_allocator();
+  child_ = child;
+  all_exprs_ = all_exprs;
+  keys_ = keys;
+  key_proj_ = key_proj;
+  batch_size_ = batch_size;
+  is_unique_ = is_unique;
+  for (int64_t i = 0; OB_SUCC(ret) && i < 2; i++) {
+    if (OB_FAIL(stores_[i].init(*all_exprs_, batch_size_, attr, 0 /*mem_limit*/,
+                                false /*enable_dump*/, 0 /*row_extra_size*/,
+                                NONE_COMPRESSOR))) {
+      LOG_WARN("init row store failed", K(ret));
+    } else {
+      stores_[i].set_allocator(op_.mem_context_->get_malloc_allocator());
+      stores_[i].set_callback(&op_.sql_mem_processor_);
+      stores_[i].set_io_event_observer(&op_.io_event_observer_);
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(group_store_.init(*all_exprs_, batch_size_, attr, 0 /*mem_limit*/,
+                                       true /*enable_dump*/, 0 /*row_extra_size*/,
+                                       NONE_COMPRESSOR))) {
+    LOG_WARN("init group store failed", K(ret));
+  } else {
+    group_store_.set_allocator(op_.mem_context_->get_malloc_allocator());
+    group_store_.set_callback(&op_.sql_mem_processor_);
+    group_store_.set_io_event_observer(&op_.io_event_observer_);
+    group_store_.set_dir_id(op_.sql_mem_processor_.get_dir_id());
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_ISNULL(stored_rows_ = static_cast<ObCompactRow **>(
+                       alloc.alloc(sizeof(ObCompactRow *) * batch_size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate stored rows failed", K(ret), K(batch_size_));
+  } else if (OB_ISNULL(selector_ = static_cast<uint16_t *>(
+                       alloc.alloc(sizeof(uint16_t) * batch_size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate selector failed", K(ret), K(batch_size_));
+  } else {
+    rows_.set_attr(attr);
+    group_starts_.set_attr(attr);
+  }
+  return ret;
+}
+
+void ObMergeJoinVecOp::ChildFetcher::reuse()
+{
+  stores_[0].reuse();
+  stores_[1].reuse();
+  group_reader_.reset();
+  group_store_.reuse();
+  group_dumped_ = false;
+  cur_store_ = 0;
+  rows_.reuse();
+  group_starts_.reuse();
+  child_end_ = false;
+  grp_start_ = 0;
+  grp_end_ = 0;
+  grp_complete_ = false;
+}
+
+void ObMergeJoinVecOp::ChildFetcher::reset()
+{
+  stores_[0].reset();
+  stores_[1].reset();
+  group_reader_.reset();
+  group_store_.reset();
+  group_dumped_ = false;
+  if (NULL != first_row_) {
+    op_.mem_context_->get_malloc_allocator().free(first_row_);
+    first_row_ = NULL;
+    first_row_buf_size_ = 0;
+  }
+  cur_store_ = 0;
+  rows_.reset();
+  group_starts_.reset();
+  child_end_ = false;
+  grp_start_ = 0;
+  grp_end_ = 0;
+  grp_complete_ = false;
+}
+
+int ObMergeJoinVecOp::ChildFetcher::fill_group(bool &blocked)
+{
+  int ret = OB_SUCCESS;
+  bool dumped = false;
+  blocked = false;
+  while (OB_SUCC(ret) && !grp_complete_ && !blocked) {
+    if (group_dumped_) {
+      if (OB_FAIL(append_dumped_group_rows())) {
+        LOG_WARN("append rows to dumped group failed", K(ret));
+      } else if (grp_end_ < rows_.count() || child_end_) {
+        grp_complete_ = true;
+        if (OB_FAIL(group_store_.finish_add_row(false))) {
+          LOG_WARN("finish add row to group store failed", K(ret));
+        } else if (OB_FAIL(group_reader_.init(&group_store_))) {
+          LOG_WARN("init group reader failed", K(ret));
+        }
+      } else if (op_.output_cnt_ > 0) {
+        blocked = true;
+      } else if (OB_FAIL(op_.process_dump(dumped))) {
+        LOG_WARN("process dump failed", K(ret));
+      } else if (dumped && OB_FAIL(group_store_.dump(false))) {
+        LOG_WARN("dump group store failed", K(ret));
+      } else if (OB_FAIL(load_batch())) {
+        LOG_WARN("load child batch failed", K(ret));
+      }
+    } else if (grp_end_ < rows_.count()) {
+      if (grp_end_ == grp_start_) {
+        grp_end_++;
+      }
+      if (is_unique_) {
+        grp_complete_ = true;
+      } else {
+        while (grp_end_ < rows_.count() && !group_starts_.at(grp_end_)) {
+          grp_end_++;
+        }
+        // the group is not finished until the first row of next group is seen.
+        grp_complete_ = grp_end_ < rows_.count();
+      }
+    } else if (child_end_) {
+      grp_complete_ = true;
+    } else if (op_.output_cnt_ > 0) {
+      // output rows reference the stored rows, load next batch after they are consumed.
+      blocked = true;
+    } else if (OB_FAIL(op_.process_dump(dumped))) {
+      LOG_WARN("process dump failed", K(ret));
+    } else if (dumped && OB_FAIL(spill_group())) {
+      LOG_WARN("spill group failed", K(ret));
+    } else if (OB_FAIL(load_batch())) {
+      LOG_WARN("load child batch failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+// Move rows of the unfinished group to %group_store_ and dump it, the first row is kept
+// in memory to compare with rows of next batches.
+int ObMergeJoinVecOp::ChildFetcher::spill_group()
+{
+  int ret = OB_SUCCESS;
+  if (!group_dumped_ && grp_end_ > grp_start_) {
+    const ObCompactRow *first = rows_.at(grp_start_);
+    const int64_t row_size = first->get_row_size();
+    if (row_size > first_row_buf_size_) {
+      ObIAllocator &alloc = op_.mem_context_->get_malloc_allocator();
+      void *buf = NULL;
+      if (OB_ISNULL(buf = alloc.alloc(row_size))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate first row failed", K(ret), K(row_size));
+      } else {
+        if (NULL != first_row_) {
+          alloc.free(first_row_);
+        }
+        first_row_ = static_cast<ObCompactRow *>(buf);
+        first_row_buf_size_ = row_size;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      MEMCPY(first_row_, first, row_size);
+      group_reader_.reset();
+      group_store_.reuse();
+    }
+    for (int64_t i = grp_start_; OB_SUCC(ret) && i < grp_end_; i++) {
+      ObCompactRow *sr = NULL;
+      if (OB_FAIL(group_store_.add_row(rows_.at(i), sr))) {
+        LOG_WARN("add row to group store failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      // rows before grp_end_ are consumed, released by move_group_rows() of next load.
+      grp_start_ = grp_end_;
+      group_dumped_ = true;
+      LOG_TRACE("merge join group dumped", K(group_store_.get_row_cnt()),
+                K(op_.sql_mem_processor_.get_data_size()),
+                K(op_.sql_mem_processor_.get_mem_bound()));
+    }
+  }
+  if (OB_SUCC(ret) && group_dumped_ && OB_FAIL(group_store_.dump(false))) {
+    LOG_WARN("dump group store failed", K(ret));
+  }
+  return ret;
+}
+
+// Append rows of the dumped group loaded by last batch to %group_store_, stop at the
+// first row of next group.
+int ObMergeJoinVecOp::ChildFetcher::append_dumped_group_rows()
+{
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(ret) && grp_end_ < rows_.count() && !group_starts_.at(grp_end_)) {
+    ObCompactRow *sr = NULL;
+    if (OB_FAIL(group_store_.add_row(rows_.at(grp_end_), sr))) {
+      LOG_WARN("add row to group store failed", K(ret));
+    } else {
+      grp_end_++;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    grp_start_ = grp_end_;
+  }
+  return ret;
+}
+
+// Rows returned by the reader are valid until it switches block, copy them so that the
+// output rows and candidate rows of one batch are all valid.
+int ObMergeJoinVecOp::ChildFetcher::get_dumped_group_row(const int64_t idx,
+                                                         const ObCompactRow *&row)
+{
+  int ret = OB_SUCCESS;
+  const ObCompactRow *sr = NULL;
+  void *buf = NULL;
+  if (OB_FAIL(group_reader_.get_row(idx, sr))) {
+    LOG_WARN("get row from group store failed", K(ret), K(idx));
+  } else if (OB_ISNULL(buf = op_.dumped_row_alloc_.alloc(sr->get_row_size()))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate row failed", K(ret), K(sr->get_row_size()));
+  } else {
+    MEMCPY(buf, sr, sr->get_row_size());
+    row = static_cast<const ObCompactRow *>(buf);
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::ChildFetcher::load_batch()
+{
+  int ret = OB_SUCCESS;
+  const ObBatchRows *brs = NULL;
+  if (OB_FAIL(move_group_rows())) {
+    LOG_WARN("move group rows failed", K(ret));
+  } else if (OB_FAIL(child_->get_next_batch(batch_size_, brs))) {
+    LOG_WARN("get child next batch failed", K(ret));
+  } else {
+    child_end_ = brs->end_;
+    if (brs->size_ > 0) {
+      const int64_t base = rows_.count();
+      int64_t cnt = 0;
+      op_.clear_evaluated_flag();
+      if (OB_FAIL(stores_[cur_store_].add_batch(*all_exprs_, op_.eval_ctx_, *brs, cnt,
+                                                stored_rows_))) {
+        LOG_WARN("add batch to row store failed", K(ret));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+        if (OB_FAIL(rows_.push_back(stored_rows_[i]))) {
+          LOG_WARN("push back stored row failed", K(ret));
+        } else if (OB_FAIL(group_starts_.push_back(false))) {
+          LOG_WARN("push back group flag failed", K(ret));
+        }
+      }
+      if (OB_SUCC(ret) && cnt > 0 && OB_FAIL(mark_group_starts(*brs, base, cnt))) {
+        LOG_WARN("mark group starts failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+// Rows before current group are useless, copy rows of current group to the other store and
+// release current store.
+int ObMergeJoinVecOp::ChildFetcher::move_group_rows()
+{
+  int ret = OB_SUCCESS;
+  if (grp_start_ > 0) {
+    ObTempRowStore &next_store = stores_[1 - cur_store_];
+    const int64_t pending_cnt = rows_.count() - grp_start_;
+    next_store.reuse();
+    for (int64_t i = 0; OB_SUCC(ret) && i < pending_cnt; i++) {
+      ObCompactRow *sr = NULL;
+      if (OB_FAIL(next_store.add_row(rows_.at(grp_start_ + i), sr))) {
+        LOG_WARN("add row to row store failed", K(ret));
+      } else {
+        rows_.at(i) = sr;
+        group_starts_.at(i) = group_starts_.at(grp_start_ + i);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      while (rows_.count() > pending_cnt) {
+        rows_.pop_back();
+        group_starts_.pop_back();
+      }
+      stores_[cur_store_].reuse();
+      cur_store_ = 1 - cur_store_;
+      grp_end_ -= grp_start_;
+      grp_start_ = 0;
+    }
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::ChildFetcher::cmp_with_stored_row(const ObExpr &key,
+                                                        const ObIVector &vec,
+                                                        const int64_t batch_idx,
+                                                        const ObCompactRow &stored_row,
+                                                        const int64_t col_idx,
+                                                        int &cmp)
+{
+  const char *payload = NULL;
+  ObLength len = 0;
+  stored_row.get_cell_payload(row_meta(), col_idx, payload, len);
+  return vec.null_first_cmp(key, batch_idx, stored_row.is_null(col_idx), payload, len, cmp);
+}
+
+// Detect boundaries of equal key runs in the batch just added, column by column:
+// row j starts a new group if any key differs from the previous active row. The
+// first row is compared with the last stored row of the previous batch.
+int ObMergeJoinVecOp::ChildFetcher::mark_group_starts(const ObBatchRows &brs,
+                                                      const int64_t base,
+                                                      const int64_t cnt)
+{
+  int ret = OB_SUCCESS;
+  int64_t size = 0;
+  for (int64_t i = 0; i < brs.size_; i++) {
+    if (brs.all_rows_active_ || !brs.skip_->at(i)) {
+      selector_[size++] = i;
+    }
+  }
+  if (OB_UNLIKELY(size != cnt)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected stored rows count", K(ret), K(size), K(cnt));
+  } else if (is_unique_) {
+    for (int64_t i = 0; i < cnt; i++) {
+      group_starts_.at(base + i) = true;
+    }
+  } else {
+    // rows of dumped group are not in %rows_, compare with its first row.
+    const ObCompactRow *prev_row = (0 == base) ? (group_dumped_ ? first_row_ : NULL)
+                                               : rows_.at(base - 1);
+    group_starts_.at(base) = (NULL == prev_row);
+    for (int64_t k = 0; OB_SUCC(ret) && k < keys_->count(); k++) {
+      const ObExpr &key = *keys_->at(k);
+      const ObIVector *vec = key.get_vector(op_.eval_ctx_);
+      int cmp = 0;
+      if (!group_starts_.at(base)) {
+        if (OB_FAIL(cmp_with_stored_row(key, *vec, selector_[0], *prev_row,
+                                        key_proj_->at(k), cmp))) {
+          LOG_WARN("compare with stored row failed", K(ret));
+        } else if (0 != cmp) {
+          group_starts_.at(base) = true;
+        }
+      }
+      if (OB_FAIL(ret)) {
+      } else if (VEC_FIXED == vec->get_format() && ob_is_integer_type(key.datum_meta_.type_)) {
+        // equality of integer keys is equality of the fixed length payload
+        const ObFixedLengthBase *fixed_vec = static_cast<const ObFixedLengthBase *>(vec);
+        const int64_t *data = reinterpret_cast<const int64_t *>(fixed_vec->get_data());
+        const ObBitVector *nulls = fixed_vec->get_nulls();
+        const bool has_null = fixed_vec->has_null();
+        for (int64_t i = 1; i < cnt; i++) {
+          if (!group_starts_.at(base + i)) {
+            const int64_t cur = selector_[i];
+            const int64_t prev = selector_[i - 1];
+            if (has_null && (nulls->at(cur) || nulls->at(prev))) {
+              group_starts_.at(base + i) = (nulls->at(cur) != nulls->at(prev));
+            } else {
+              group_starts_.at(base + i) = (data[cur] != data[prev]);
+            }
+          }
+        }
+      } else {
+        for (int64_t i = 1; OB_SUCC(ret) && i < cnt; i++) {
+          if (!group_starts_.at(base + i)) {
+            const int64_t prev = selector_[i - 1];
+            if (OB_FAIL(vec->null_first_cmp(key, selector_[i], vec->is_null(prev),
+                                            vec->get_payload(prev), vec->get_length(prev),
+                                            cmp))) {
+              LOG_WARN("compare key failed", K(ret));
+            } else if (0 != cmp) {
+              group_starts_.at(base + i) = true;
+            }
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+ObMergeJoinVecOp::ObMergeJoinVecOp(ObExecContext &exec_ctx, const ObOpSpec &spec,
+                                   ObOpInput *input)
+  : ObJoinVecOp(exec_ctx, spec, input),
+    state_(JS_JOIN_BEGIN),
+    mem_context_(NULL),
+    profile_(ObSqlWorkAreaType::HASH_WORK_AREA),
+    sql_mem_processor_(profile_, op_monitor_info_),
+    dumped_row_alloc_(ObModIds::OB_SQL_MERGE_JOIN),
+    left_fetcher_(*this),
+    right_fetcher_(*this),
+    left_key_proj_(exec_ctx.get_allocator()),
+    right_key_proj_(exec_ctx.get_allocator()),
+    output_left_rows_(NULL),
+    output_right_rows_(NULL),
+    output_cnt_(0),
+    proj_selector_(NULL),
+    proj_rows_(NULL),
+    left_idx_(0),
+    right_idx_(0),
+    left_match_flags_(NULL),
+    left_match_flags_size_(0),
+    right_match_flags_(NULL),
+    right_match_flags_size_(0),
+    cond_skip_(NULL),
+    cand_left_rows_(NULL),
+    cand_right_rows_(NULL),
+    cand_left_idxes_(NULL),
+    cand_right_idxes_(NULL),
+    output_right_exprs_(true)
+{
+}
+
+int ObMergeJoinVecOp::inner_open()
+{
+  int ret = OB_SUCCESS;
+  const uint64_t tenant_id = ctx_.get_my_session()->get_effective_tenant_id();
+  ObMemAttr attr(tenant_id, ObModIds::OB_SQL_MERGE_JOIN, ObCtxIds::WORK_AREA);
+  ObIAllocator &alloc = ctx_.get_allocator();
+  const int64_t batch_size = MY_SPEC.max_batch_size_;
+  // two batches of both children are kept in memory at least
+  const int64_t cache_size = 2 * batch_size
+                             * (left_->get_spec().width_ + right_->get_spec().width_);
+  bool has_ns_equal_cond = false;
+  for (int64_t i = 0; i < MY_SPEC.is_ns_equal_cond_.count(); i++) {
+    has_ns_equal_cond = has_ns_equal_cond || MY_SPEC.is_ns_equal_cond_.at(i);
+  }
+  if (OB_UNLIKELY(batch_size <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("vectorized merge join expect positive batch size", K(ret), K(batch_size));
+  } else if (OB_FAIL(ObJoinVecOp::inner_open())) {
+    LOG_WARN("failed to open in base class", K(ret));
+  } else if (OB_FAIL(init_mem_context())) {
+    LOG_WARN("fail to init memory context", K(ret));
+  } else if (OB_FAIL(sql_mem_processor_.init(&mem_context_->get_malloc_allocator(),
+                                             tenant_id,
+                                             std::max(2L << 20, cache_size),
+                                             MY_SPEC.type_,
+                                             MY_SPEC.id_,
+                                             &ctx_))) {
+    LOG_WARN("failed to init sql memory manager processor", K(ret));
+  } else if (FALSE_IT(dumped_row_alloc_.set_attr(attr))) {
+  } else if (OB_FAIL(init_key_proj(MY_SPEC.left_child_fetcher_all_exprs_, MY_SPEC.left_keys_,
+                                   left_key_proj_))) {
+    LOG_WARN("init left key projector failed", K(ret));
+  } else if (OB_FAIL(init_key_proj(MY_SPEC.right_child_fetcher_all_exprs_, MY_SPEC.right_keys_,
+                                   right_key_proj_))) {
+    LOG_WARN("init right key projector failed", K(ret));
+  } else if (OB_FAIL(left_fetcher_.init(left_, &MY_SPEC.left_child_fetcher_all_exprs_,
+                                        &MY_SPEC.left_keys_, &left_key_proj_,
+                                        left_->get_spec().max_batch_size_,
+                                        // null keys never match without null safe equal,
+                                        // so unique left rows are always single row groups.
+                                        MY_SPEC.is_left_unique_ && !has_ns_equal_cond,
+                                        attr))) {
+    LOG_WARN("init left fetcher failed", K(ret));
+  } else if (OB_FAIL(right_fetcher_.init(right_, &MY_SPEC.right_child_fetcher_all_exprs_,
+                                         &MY_SPEC.right_keys_, &right_key_proj_,
+                                         right_->get_spec().max_batch_size_, false, attr))) {
+    LOG_WARN("init right fetcher failed", K(ret));
+  } else if (OB_ISNULL(output_left_rows_ = static_cast<const ObCompactRow **>(
+                       alloc.alloc(sizeof(ObCompactRow *) * batch_size)))
+             || OB_ISNULL(output_right_rows_ = static_cast<const ObCompactRow **>(
+                          alloc.alloc(sizeof(ObCompactRow *) * batch_size)))
+             || OB_ISNULL(proj_rows_ = static_cast<const ObCompactRow **>(
+                          alloc.alloc(sizeof(ObCompactRow *) * batch_size)))
+             || OB_ISNULL(proj_selector_ = static_cast<uint16_t *>(
+                          alloc.alloc(sizeof(uint16_t) * batch_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate output buffer failed", K(ret), K(batch_size));
+  } else if (MY_SPEC.other_join_conds_.count() > 0) {
+    if (OB_ISNULL(cand_left_rows_ = static_cast<const ObCompactRow **>(
+                  alloc.alloc(sizeof(ObCompactRow *) * batch_size)))
+        || OB_ISNULL(cand_right_rows_ = static_cast<const ObCompactRow **>(
+                     alloc.alloc(sizeof(ObCompactRow *) * batch_size)))
+        || OB_ISNULL(cand_left_idxes_ = static_cast<int64_t *>(
+                     alloc.alloc(sizeof(int64_t) * batch_size)))
+        || OB_ISNULL(cand_right_idxes_ = static_cast<int64_t *>(
+                     alloc.alloc(sizeof(int64_t) * batch_size)))
+        || OB_ISNULL(cond_skip_ = to_bit_vector(
+                     alloc.alloc(ObBitVector::memory_size(batch_size))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate candidate buffer failed", K(ret), K(batch_size));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    output_right_exprs_ = !(LEFT_SEMI_JOIN == MY_SPEC.join_type_
+                            || LEFT_ANTI_JOIN == MY_SPEC.join_type_);
+  }
+  LOG_TRACE("merge join vec open", K(MY_SPEC.id_), K(MY_SPEC.join_type_),
+            K(MY_SPEC.is_left_unique_), K(has_ns_equal_cond));
+  return ret;
+}
+
+int ObMergeJoinVecOp::init_mem_context()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(mem_context_)) {
+    ObSQLSessionInfo *session = ctx_.get_my_session();
+    uint64_t tenant_id = session->get_effective_tenant_id();
+    lib::ContextParam param;
+    param.set_mem_attr(tenant_id,
+                       ObModIds::OB_SQL_MERGE_JOIN,
+                       ObCtxIds::WORK_AREA)
+      .set_properties(lib::USE_TL_PAGE_OPTIONAL);
+    if (OB_FAIL(CURRENT_CONTEXT->CREATE_CONTEXT(mem_context_, param))) {
+      LOG_WARN("create entity failed", K(ret));
+    } else if (OB_ISNULL(mem_context_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null memory entity returned", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::process_dump(bool &dumped)
+{
+  int ret = OB_SUCCESS;
+  bool updated = false;
+  dumped = false;
+  UNUSED(updated);
+  if (OB_FAIL(sql_mem_processor_.update_max_available_mem_size_periodically(
+      &mem_context_->get_malloc_allocator(),
+      [&](int64_t cur_cnt) {
+        return left_fetcher_.get_row_cnt_in_memory() + right_fetcher_.get_row_cnt_in_memory()
+               > cur_cnt;
+      },
+      updated))) {
+    LOG_WARN("failed to update max available memory size periodically", K(ret));
+  } else if (need_dump() && GCONF.is_sql_operator_dump_enabled()
+             && OB_FAIL(sql_mem_processor_.extend_max_memory_size(
+               &mem_context_->get_malloc_allocator(),
+               [&](int64_t max_memory_size) {
+                 return sql_mem_processor_.get_data_size() > max_memory_size;
+               },
+               dumped, sql_mem_processor_.get_data_size()))) {
+    LOG_WARN("failed to extend max memory size", K(ret));
+  } else if (dumped) {
+    sql_mem_processor_.set_number_pass(1);
+    LOG_TRACE("trace merge join dump", K(sql_mem_processor_.get_data_size()),
+              K(sql_mem_processor_.get_mem_bound()));
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::init_key_proj(const ExprFixedArray &all_exprs,
+                                    const ExprFixedArray &keys,
+                                    ObFixedArray<int64_t, ObIAllocator> &key_proj)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(key_proj.init(keys.count()))) {
+    LOG_WARN("init key projector failed", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < keys.count(); i++) {
+    int64_t idx = OB_INVALID_INDEX;
+    if (!has_exist_in_array(all_exprs, keys.at(i), &idx)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("join key not in fetcher exprs", K(ret), K(i));
+    } else if (OB_FAIL(key_proj.push_back(idx))) {
+      LOG_WARN("push back key projector failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+void ObMergeJoinVecOp::reset()
+{
+  state_ = JS_JOIN_BEGIN;
+  left_fetcher_.reuse();
+  right_fetcher_.reuse();
+  dumped_row_alloc_.reset_remain_one_page();
+  output_cnt_ = 0;
+  left_idx_ = 0;
+  right_idx_ = 0;
+}
+
+int ObMergeJoinVecOp::inner_rescan()
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_FAIL(ObJoinVecOp::inner_rescan())) {
+    LOG_WARN("failed to rescan", K(ret));
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::inner_switch_iterator()
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_FAIL(ObJoinVecOp::inner_switch_iterator())) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("failed to switch iterator", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::inner_close()
+{
+  reset();
+  sql_mem_processor_.unregister_profile();
+  return ObJoinVecOp::inner_close();
+}
+
+void ObMergeJoinVecOp::destroy()
+{
+  left_fetcher_.reset();
+  right_fetcher_.reset();
+  left_key_proj_.reset();
+  right_key_proj_.reset();
+  dumped_row_alloc_.reset();
+  sql_mem_processor_.unregister_profile_if_necessary();
+  destroy_mem_context();
+  ObJoinVecOp::destroy();
+}
+
+int ObMergeJoinVecOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  const int64_t batch_size = std::min(max_row_cnt, MY_SPEC.max_batch_size_);
+  bool blocked = false;
+  // rows of last output batch are consumed by parent now.
+  output_cnt_ = 0;
+  dumped_row_alloc_.reset_remain_one_page();
+  while (OB_SUCC(ret) && JS_JOIN_END != state_ && !blocked && output_cnt_ < batch_size) {
+    if (OB_FAIL(join_step(batch_size, blocked))) {
+      LOG_WARN("join step failed", K(ret), K(state_));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    clear_evaluated_flag();
+    if (output_cnt_ > 0 && OB_FAIL(project_output(output_cnt_))) {
+      LOG_WARN("project output failed", K(ret), K(output_cnt_));
+    } else {
+      brs_.size_ = output_cnt_;
+      brs_.skip_->reset(output_cnt_);
+      brs_.all_rows_active_ = true;
+      brs_.end_ = (JS_JOIN_END == state_);
+    }
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::join_step(const int64_t batch_size, bool &blocked)
+{
+  int ret = OB_SUCCESS;
+  const bool has_other_conds = MY_SPEC.other_join_conds_.count() > 0;
+  const ObJoinType join_type = MY_SPEC.join_type_;
+  bool finished = false;
+  switch (state_) {
+    case JS_JOIN_BEGIN: {
+      state_ = JS_COMPARE;
+      break;
+    }
+    case JS_COMPARE: {
+      int64_t cmp_res = 0;
+      if (OB_FAIL(left_fetcher_.fill_group(blocked))) {
+        LOG_WARN("fill left group failed", K(ret));
+      } else if (blocked) {
+      } else if (OB_FAIL(right_fetcher_.fill_group(blocked))) {
+        LOG_WARN("fill right group failed", K(ret));
+      } else if (blocked) {
+      } else if (left_fetcher_.iter_end()) {
+        if (!right_fetcher_.iter_end() && need_right_join()) {
+          right_idx_ = 0;
+          state_ = JS_RIGHT_UNMATCH;
+        } else {
+          state_ = JS_JOIN_END;
+        }
+      } else if (right_fetcher_.iter_end()) {
+        if (need_left_join() || LEFT_ANTI_JOIN == join_type) {
+          left_idx_ = 0;
+          state_ = JS_LEFT_UNMATCH;
+        } else {
+          state_ = JS_JOIN_END;
+        }
+      } else if (OB_FAIL(compare_groups(cmp_res))) {
+        LOG_WARN("compare groups failed", K(ret));
+      } else if (cmp_res < 0) {
+        if (need_left_join() || LEFT_ANTI_JOIN == join_type) {
+          left_idx_ = 0;
+          state_ = JS_LEFT_UNMATCH;
+        } else {
+          left_fetcher_.next_group();
+        }
+      } else if (cmp_res > 0) {
+        if (need_right_join()) {
+          right_idx_ = 0;
+          state_ = JS_RIGHT_UNMATCH;
+        } else {
+          right_fetcher_.next_group();
+        }
+      } else if (OB_FAIL(begin_match_group())) {
+        LOG_WARN("begin match group failed", K(ret));
+      }
+      break;
+    }
+    case JS_LEFT_UNMATCH: {
+      if (OB_FAIL(output_group_rest(left_fetcher_, true, NULL, true, batch_size, finished))) {
+        LOG_WARN("output left group failed", K(ret));
+      } else if (finished) {
+        left_fetcher_.next_group();
+        state_ = JS_COMPARE;
+      }
+      break;
+    }
+    case JS_RIGHT_UNMATCH: {
+      if (OB_FAIL(output_group_rest(right_fetcher_, false, NULL, true, batch_size, finished))) {
+        LOG_WARN("output right group failed", K(ret));
+      } else if (finished) {
+        right_fetcher_.next_group();
+        state_ = JS_COMPARE;
+      }
+      break;
+    }
+    case JS_MATCH_GROUP: {
+      if (OB_FAIL(match_group_rows(batch_size))) {
+        LOG_WARN("match group rows failed", K(ret));
+      }
+      break;
+    }
+    case JS_GROUP_LEFT_REST: {
+      // semi join outputs matched left rows, outer and anti join output the unmatched.
+      const ObBitVector *flags = has_other_conds ? left_match_flags_ : NULL;
+      const bool output_matched = (LEFT_SEMI_JOIN == join_type);
+      if (OB_FAIL(output_group_rest(left_fetcher_, true, flags, output_matched, batch_size,
+                                    finished))) {
+        LOG_WARN("output left rest rows failed", K(ret));
+      } else if (!finished) {
+      } else if (FULL_OUTER_JOIN == join_type && has_other_conds) {
+        right_idx_ = 0;
+        state_ = JS_GROUP_RIGHT_REST;
+      } else {
+        finish_match_group();
+      }
+      break;
+    }
+    case JS_GROUP_RIGHT_REST: {
+      if (OB_FAIL(output_group_rest(right_fetcher_, false, right_match_flags_, false,
+                                    batch_size, finished))) {
+        LOG_WARN("output right rest rows failed", K(ret));
+      } else if (finished) {
+        finish_match_group();
+      }
+      break;
+    }
+    default: {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected join state", K(ret), K(state_));
+    }
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::compare_groups(int64_t &cmp_res)
+{
+  int ret = OB_SUCCESS;
+  const ObCompactRow *l_row = left_fetcher_.first_row();
+  const ObCompactRow *r_row = right_fetcher_.first_row();
+  const RowMeta &l_meta = left_fetcher_.row_meta();
+  const RowMeta &r_meta = right_fetcher_.row_meta();
+  const bool null_first = (NULL_FIRST == default_null_pos());
+  cmp_res = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && 0 == cmp_res && i < MY_SPEC.left_keys_.count(); i++) {
+    const ObExpr *l_key = MY_SPEC.left_keys_.at(i);
+    const ObExpr *r_key = MY_SPEC.right_keys_.at(i);
+    const int64_t l_idx = left_key_proj_.at(i);
+    const int64_t r_idx = right_key_proj_.at(i);
+    const bool l_null = l_row->is_null(l_idx);
+    const bool r_null = r_row->is_null(r_idx);
+    if (l_null && r_null) {
+      cmp_res = MY_SPEC.is_ns_equal_cond_.at(i) ? 0 : -1;
+    } else {
+      const char *l_v = NULL;
+      const char *r_v = NULL;
+      ObLength l_len = 0;
+      ObLength r_len = 0;
+      int cmp = 0;
+      NullSafeRowCmpFunc cmp_func = null_first ? l_key->basic_funcs_->row_null_first_cmp_
+                                               : l_key->basic_funcs_->row_null_last_cmp_;
+      l_row->get_cell_payload(l_meta, l_idx, l_v, l_len);
+      r_row->get_cell_payload(r_meta, r_idx, r_v, r_len);
+      if (OB_FAIL(cmp_func(l_key->obj_meta_, r_key->obj_meta_,
+                           l_v, l_len, l_null, r_v, r_len, r_null, cmp))) {
+        LOG_WARN("compare join key failed", K(ret), K(i));
+      } else {
+        cmp_res = cmp * MY_SPEC.merge_directions_.at(i);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::begin_match_group()
+{
+  int ret = OB_SUCCESS;
+  const ObJoinType join_type = MY_SPEC.join_type_;
+  left_idx_ = 0;
+  right_idx_ = 0;
+  if (0 == MY_SPEC.other_join_conds_.count()) {
+    if (LEFT_SEMI_JOIN == join_type) {
+      state_ = JS_GROUP_LEFT_REST;
+    } else if (LEFT_ANTI_JOIN == join_type) {
+      finish_match_group();
+    } else {
+      state_ = JS_MATCH_GROUP;
+    }
+  } else {
+    const int64_t l_cnt = left_fetcher_.group_count();
+    const int64_t r_cnt = right_fetcher_.group_count();
+    if (need_left_match_flags()) {
+      if (OB_FAIL(expand_match_flags(left_match_flags_, left_match_flags_size_, l_cnt))) {
+        LOG_WARN("expand left match flags failed", K(ret), K(l_cnt));
+      } else {
+        left_match_flags_->reset(l_cnt);
+      }
+    }
+    if (OB_SUCC(ret) && need_right_join()) {
+      if (OB_FAIL(expand_match_flags(right_match_flags_, right_match_flags_size_, r_cnt))) {
+        LOG_WARN("expand right match flags failed", K(ret), K(r_cnt));
+      } else {
+        right_match_flags_->reset(r_cnt);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      state_ = JS_MATCH_GROUP;
+    }
+  }
+  return ret;
+}
+
+void ObMergeJoinVecOp::finish_match_group()
+{
+  left_fetcher_.next_group();
+  right_fetcher_.next_group();
+  state_ = JS_COMPARE;
+}
+
+// Generate (left, right) pairs of the equal groups. Without other join conditions every pair
+// is output directly, otherwise pairs are evaluated a batch at a time and the match flags
+// are maintained for outer/semi/anti join.
+int ObMergeJoinVecOp::match_group_rows(const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  const ObJoinType join_type = MY_SPEC.join_type_;
+  const int64_t l_cnt = left_fetcher_.group_count();
+  const int64_t r_cnt = right_fetcher_.group_count();
+  const ObCompactRow *l_row = NULL;
+  const ObCompactRow *r_row = NULL;
+  if (0 == MY_SPEC.other_join_conds_.count()) {
+    while (OB_SUCC(ret) && output_cnt_ < batch_size && left_idx_ < l_cnt) {
+      const int64_t cnt = std::min(batch_size - output_cnt_, r_cnt - right_idx_);
+      if (OB_FAIL(left_fetcher_.get_group_row(left_idx_, l_row))) {
+        LOG_WARN("get left group row failed", K(ret), K(left_idx_));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+        if (OB_FAIL(right_fetcher_.get_group_row(right_idx_ + i, r_row))) {
+          LOG_WARN("get right group row failed", K(ret), K(right_idx_), K(i));
+        } else {
+          add_output(l_row, r_row);
+        }
+      }
+      if (OB_SUCC(ret)) {
+        right_idx_ += cnt;
+        if (right_idx_ >= r_cnt) {
+          right_idx_ = 0;
+          left_idx_++;
+        }
+      }
+    }
+    if (OB_SUCC(ret) && left_idx_ >= l_cnt) {
+      finish_match_group();
+    }
+  } else {
+    const bool is_semi_anti = (LEFT_SEMI_JOIN == join_type || LEFT_ANTI_JOIN == join_type);
+    const bool need_left_flags = need_left_match_flags();
+    const bool need_right_flags = need_right_join();
+    const int64_t max_cnt = batch_size - output_cnt_;
+    int64_t cnt = 0;
+    while (OB_SUCC(ret) && cnt < max_cnt && left_idx_ < l_cnt) {
+      if (is_semi_anti && left_match_flags_->at(left_idx_)) {
+        // matched left row of semi/anti join need not be evaluated again.
+        left_idx_++;
+        right_idx_ = 0;
+      } else if (OB_FAIL(left_fetcher_.get_group_row(left_idx_, l_row))) {
+        LOG_WARN("get left group row failed", K(ret), K(left_idx_));
+      } else if (OB_FAIL(right_fetcher_.get_group_row(right_idx_, r_row))) {
+        LOG_WARN("get right group row failed", K(ret), K(right_idx_));
+      } else {
+        cand_left_idxes_[cnt] = left_idx_;
+        cand_right_idxes_[cnt] = right_idx_;
+        cand_left_rows_[cnt] = l_row;
+        cand_right_rows_[cnt] = r_row;
+        cnt++;
+        if (++right_idx_ >= r_cnt) {
+          right_idx_ = 0;
+          left_idx_++;
+        }
+      }
+    }
+    if (OB_SUCC(ret) && cnt > 0 && OB_FAIL(eval_other_conds(cnt))) {
+      LOG_WARN("eval other join conditions failed", K(ret), K(cnt));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+      if (!cond_skip_->at(i)) {
+        if (need_left_flags) {
+          left_match_flags_->set(cand_left_idxes_[i]);
+        }
+        if (need_right_flags) {
+          right_match_flags_->set(cand_right_idxes_[i]);
+        }
+        if (!is_semi_anti) {
+          add_output(cand_left_rows_[i], cand_right_rows_[i]);
+        }
+      }
+    }
+    if (OB_SUCC(ret) && left_idx_ >= l_cnt) {
+      if (INNER_JOIN == join_type) {
+        finish_match_group();
+      } else if (RIGHT_OUTER_JOIN == join_type) {
+        right_idx_ = 0;
+        state_ = JS_GROUP_RIGHT_REST;
+      } else {
+        left_idx_ = 0;
+        state_ = JS_GROUP_LEFT_REST;
+      }
+    }
+  }
+  return ret;
+}
+
+// Output rows of current group of %fetcher with blank row of the other side, rows are
+// filtered by %match_flags if not NULL.
+int ObMergeJoinVecOp::output_group_rest(ChildFetcher &fetcher, const bool is_left,
+                                        const ObBitVector *match_flags,
+                                        const bool output_matched,
+                                        const int64_t batch_size, bool &finished)
+{
+  int ret = OB_SUCCESS;
+  int64_t &idx = is_left ? left_idx_ : right_idx_;
+  const int64_t cnt = fetcher.group_count();
+  const ObCompactRow *row = NULL;
+  while (OB_SUCC(ret) && output_cnt_ < batch_size && idx < cnt) {
+    const bool matched = (NULL == match_flags) || match_flags->at(idx);
+    if (matched != output_matched) {
+    } else if (OB_FAIL(fetcher.get_group_row(idx, row))) {
+      LOG_WARN("get group row failed", K(ret), K(idx));
+    } else if (is_left) {
+      add_output(row, NULL);
+    } else {
+      add_output(NULL, row);
+    }
+    if (OB_SUCC(ret)) {
+      idx++;
+    }
+  }
+  finished = idx >= cnt;
+  return ret;
+}
+
+int ObMergeJoinVecOp::eval_other_conds(const int64_t cnt)
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &conds = MY_SPEC.other_join_conds_;
+  ObEvalCtx::BatchInfoScopeGuard guard(eval_ctx_);
+  guard.set_batch_size(cnt);
+  clear_evaluated_flag();
+  cond_skip_->reset(cnt);
+  if (OB_FAIL(project_rows(MY_SPEC.left_child_fetcher_all_exprs_,
+                           MY_SPEC.left_child_fetcher_all_exprs_.count(),
+                           left_fetcher_.row_meta(), cand_left_rows_, cnt))) {
+    LOG_WARN("project left rows failed", K(ret));
+  } else if (OB_FAIL(project_rows(MY_SPEC.right_child_fetcher_all_exprs_,
+                                  MY_SPEC.right_child_fetcher_all_exprs_.count(),
+                                  right_fetcher_.row_meta(), cand_right_rows_, cnt))) {
+    LOG_WARN("project right rows failed", K(ret));
+  }
+  bool all_rows_active = true;
+  for (int64_t i = 0; OB_SUCC(ret) && i < conds.count(); i++) {
+    ObExpr *cond = conds.at(i);
+    if (OB_FAIL(cond->eval_vector(eval_ctx_, *cond_skip_, EvalBound(cnt, all_rows_active)))) {
+      LOG_WARN("fail to eval other join condition", K(ret), K(*cond));
+    } else if (is_uniform_format(cond->get_format(eval_ctx_))) {
+      ObUniformBase *uni_vec = static_cast<ObUniformBase *>(cond->get_vector(eval_ctx_));
+      for (int64_t j = 0; j < cnt; j++) {
+        if (!cond_skip_->at(j) && (uni_vec->is_null(j) || 0 == uni_vec->get_int(j))) {
+          cond_skip_->set(j);
+        }
+      }
+    } else {
+      ObFixedLengthBase *fixed_vec = static_cast<ObFixedLengthBase *>(cond->get_vector(eval_ctx_));
+      for (int64_t j = 0; j < cnt; j++) {
+        if (!cond_skip_->at(j) && (fixed_vec->is_null(j) || 0 == fixed_vec->get_int(j))) {
+          cond_skip_->set(j);
+        }
+      }
+    }
+    all_rows_active = all_rows_active && cond_skip_->is_all_false(cnt);
+  }
+  return ret;
+}
+
+// Project stored rows to the first %col_cnt exprs, NULL row means blank row.
+int ObMergeJoinVecOp::project_rows(const ExprFixedArray &exprs, const int64_t col_cnt,
+                                   const RowMeta &row_meta, const ObCompactRow **rows,
+                                   const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  int64_t sel_cnt = 0;
+  for (int64_t i = 0; i < size; i++) {
+    if (NULL != rows[i]) {
+      proj_selector_[sel_cnt] = i;
+      proj_rows_[sel_cnt++] = rows[i];
+    }
+  }
+  for (int64_t col_idx = 0; OB_SUCC(ret) && col_idx < col_cnt; col_idx++) {
+    ObExpr *expr = exprs.at(col_idx);
+    if (OB_FAIL(expr->init_vector_default(eval_ctx_, size))) {
+      LOG_WARN("fail to init vector", K(ret));
+    } else {
+      ObIVector *vec = expr->get_vector(eval_ctx_);
+      if (sel_cnt == size) {
+        if (OB_FAIL(vec->from_rows(row_meta, rows, size, col_idx))) {
+          LOG_WARN("fail to project rows", K(ret), K(col_idx));
+        }
+      } else {
+        if (sel_cnt > 0
+            && OB_FAIL(vec->from_rows(row_meta, proj_rows_, proj_selector_, sel_cnt, col_idx))) {
+          LOG_WARN("fail to project rows", K(ret), K(col_idx));
+        }
+        for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+          if (NULL == rows[i]) {
+            vec->set_null(i);
+          }
+        }
+      }
+      expr->set_evaluated_projected(eval_ctx_);
+    }
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::project_output(const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &left_output = left_->get_spec().output_;
+  const ExprFixedArray &right_output = right_->get_spec().output_;
+  if (OB_FAIL(project_rows(left_output, left_output.count(), left_fetcher_.row_meta(),
+                           output_left_rows_, size))) {
+    LOG_WARN("project left output failed", K(ret));
+  } else if (output_right_exprs_
+             && OB_FAIL(project_rows(right_output, right_output.count(),
+                                     right_fetcher_.row_meta(), output_right_rows_, size))) {
+    LOG_WARN("project right output failed", K(ret));
+  }
+  return ret;
+}
+
+int ObMergeJoinVecOp::expand_match_flags(ObBitVector *&flags, int64_t &flags_size,
+                                         const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(size > flags_size)) {
+    ObIAllocator &allocator = ctx_.get_allocator();
+    const int64_t new_size = std::max(static_cast<int64_t>(ObBitVector::WORD_BITS),
+                                      next_pow2(size));
+    ObBitVector *new_flags = NULL;
+    if (OB_ISNULL(new_flags = to_bit_vector(allocator.alloc(ObBitVector::memory_size(new_size))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate match flags failed", K(ret), K(new_size));
+    } else {
+      if (NULL != flags) {
+        allocator.free(flags);
+      }
+      flags = new_flags;
+      flags_size = new_size;
+    }
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
@@ -0,0 +1,278 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_JOIN_OB_MERGE_JOIN_VEC_OP_
+#define OCEANBASE_SQL_ENGINE_JOIN_OB_MERGE_JOIN_VEC_OP_
+
+#include "sql/engine/join/ob_join_vec_op.h"
+#include "sql/engine/basic/ob_temp_row_store.h"
+#include "sql/engine/ob_sql_mem_mgr_processor.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+class ObMergeJoinVecSpec: public ObJoinVecSpec
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  ObMergeJoinVecSpec(common::ObIAllocator &alloc, const ObPhyOperatorType type)
+    : ObJoinVecSpec(alloc, type),
+      left_keys_(alloc),
+      right_keys_(alloc),
+      is_ns_equal_cond_(alloc),
+      merge_directions_(alloc),
+      is_left_unique_(false),
+      left_child_fetcher_all_exprs_(alloc),
+      right_child_fetcher_all_exprs_(alloc)
+  {}
+  virtual ~ObMergeJoinVecSpec() {}
+
+  int set_merge_directions(const common::ObIArray<ObOrderDirection> &merge_directions);
+
+public:
+  static const int64_t MERGE_DIRECTION_ASC;
+  static const int64_t MERGE_DIRECTION_DESC;
+
+  // equal join keys, left_keys_[i] comes from left child and right_keys_[i] from right child
+  ExprFixedArray left_keys_;
+  ExprFixedArray right_keys_;
+  common::ObFixedArray<bool, common::ObIAllocator> is_ns_equal_cond_;
+  common::ObFixedArray<int64_t, common::ObIAllocator> merge_directions_;
+  bool is_left_unique_;
+  // child output exprs followed by the join keys which are not in child output,
+  // these are the columns materialized by the child fetchers.
+  ExprFixedArray left_child_fetcher_all_exprs_;
+  ExprFixedArray right_child_fetcher_all_exprs_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObMergeJoinVecSpec);
+};
+
+// Batch native merge join.
+//
+// Every child batch is appended to a per child ObTempRowStore with one add_batch call and
+// the boundaries of equal key runs are detected column by column on the child vectors.
+// The join itself works on runs (groups) of stored rows: groups of the two children are
+// compared by their first row, matched groups generate (left, right) row pairs and the
+// output is projected back to vectors with from_rows(), a batch at a time.
+//
+//      left rows:  [1][1][3][4][4][4]       right rows: [1][2][4][4]
+//                  |grp||g||  grp   |                   |g||g||grp |
+//
+// Rows of a group may span child batches, each child keeps two stores and moves the rows of
+// the unfinished group to the other store before loading the next batch, so memory is bounded
+// by one batch plus the largest equal key group. A child batch is only loaded when no output
+// row references the stores.
+//
+// When the memory exceeds the bound of sql memory manager while an unfinished group is still
+// growing (skewed equal keys), the group is moved to a random access store which is allowed to
+// dump, the rest rows of the group are appended to it directly. Rows of a dumped group are
+// copied to %dumped_row_alloc_ when accessed, which is reused after the output batch is consumed.
+class ObMergeJoinVecOp: public ObJoinVecOp
+{
+private:
+  enum JoinState {
+    JS_JOIN_BEGIN = 0,
+    JS_COMPARE,           // both groups are complete, compare them.
+    JS_LEFT_UNMATCH,      // output rows of left group which has no equal right group.
+    JS_RIGHT_UNMATCH,     // output rows of right group which has no equal left group.
+    JS_MATCH_GROUP,       // generate row pairs of equal groups.
+    JS_GROUP_LEFT_REST,   // output left rows of the matched groups according to match flags.
+    JS_GROUP_RIGHT_REST,  // output right rows of the matched groups according to match flags.
+    JS_JOIN_END
+  };
+
+  class ChildFetcher
+  {
+  public:
+    ChildFetcher(ObMergeJoinVecOp &op)
+      : op_(op), child_(NULL), all_exprs_(NULL), keys_(NULL), key_proj_(NULL),
+        cur_store_(0), rows_(), group_starts_(), stored_rows_(NULL), selector_(NULL),
+        batch_size_(0), is_unique_(false), child_end_(false), grp_start_(0), grp_end_(0),
+        grp_complete_(false), group_dumped_(false), first_row_(NULL), first_row_buf_size_(0)
+    {}
+    int init(ObOperator *child, const ExprFixedArray *all_exprs,
+             const ExprFixedArray *keys, const common::ObIArray<int64_t> *key_proj,
+             const int64_t batch_size, const bool is_unique, const lib::ObMemAttr &attr);
+    // find the end of current group, may load next child batch.
+    // %blocked is set when next batch is needed but there are output rows not consumed.
+    int fill_group(bool &blocked);
+    void next_group()
+    {
+      if (group_dumped_) {
+        group_reader_.reset();
+        group_store_.reuse();
+        group_dumped_ = false;
+      }
+      grp_start_ = grp_end_;
+      grp_complete_ = false;
+    }
+    // reach end when the complete group is empty.
+    bool iter_end() const { return grp_complete_ && 0 == group_count(); }
+    int64_t group_count() const
+    {
+      return group_dumped_ ? group_store_.get_row_cnt() : grp_end_ - grp_start_;
+    }
+    // get the %idx th row of current group
+    inline int get_group_row(const int64_t idx, const ObCompactRow *&row)
+    {
+      int ret = common::OB_SUCCESS;
+      if (!group_dumped_) {
+        row = rows_.at(grp_start_ + idx);
+      } else {
+        ret = get_dumped_group_row(idx, row);
+      }
+      return ret;
+    }
+    const ObCompactRow *first_row() const
+    {
+      return group_dumped_ ? first_row_ : rows_.at(grp_start_);
+    }
+    const RowMeta &row_meta() const { return stores_[cur_store_].get_row_meta(); }
+    int64_t get_row_cnt_in_memory() const
+    {
+      return stores_[0].get_row_cnt_in_memory() + stores_[1].get_row_cnt_in_memory()
+             + group_store_.get_row_cnt_in_memory();
+    }
+    void reuse();
+    void reset();
+
+  private:
+    int load_batch();
+    int move_group_rows();
+    int spill_group();
+    int append_dumped_group_rows();
+    int get_dumped_group_row(const int64_t idx, const ObCompactRow *&row);
+    int mark_group_starts(const ObBatchRows &brs, const int64_t base, const int64_t cnt);
+    int cmp_with_stored_row(const ObExpr &key, const ObIVector &vec, const int64_t batch_idx,
+                            const ObCompactRow &stored_row, const int64_t col_idx, int &cmp);
+
+  public:
+    ObMergeJoinVecOp &op_;
+    ObOperator *child_;
+    const ExprFixedArray *all_exprs_;
+    const ExprFixedArray *keys_;
+    const common::ObIArray<int64_t> *key_proj_;
+    ObTempRowStore stores_[2];
+    int64_t cur_store_;
+    common::ObSEArray<ObCompactRow *, 256> rows_;
+    // whether the row starts a new equal key group
+    common::ObSEArray<bool, 256> group_starts_;
+    ObCompactRow **stored_rows_;
+    uint16_t *selector_;
+    int64_t batch_size_;
+    // child rows are unique on join keys, every row is a group.
+    bool is_unique_;
+    bool child_end_;
+    int64_t grp_start_;
+    int64_t grp_end_;
+    bool grp_complete_;
+    // rows of current group are in %group_store_ instead of %rows_.
+    bool group_dumped_;
+    ObRATempRowStore group_store_;
+    ObRATempRowStore::RAReader group_reader_;
+    // copy of the first row of dumped group, used to compare keys
+    ObCompactRow *first_row_;
+    int64_t first_row_buf_size_;
+  };
+
+public:
+  ObMergeJoinVecOp(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOpInput *input);
+  virtual ~ObMergeJoinVecOp() {}
+
+  virtual int inner_open() override;
+  virtual int inner_rescan() override;
+  virtual int inner_switch_iterator() override;
+  virtual int inner_get_next_row() override { return common::OB_NOT_IMPLEMENT; }
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
+  virtual int inner_close() override;
+  virtual void destroy() override;
+
+private:
+  void reset();
+  int init_mem_context();
+  int process_dump(bool &dumped);
+  inline bool need_dump() const
+  { return sql_mem_processor_.get_data_size() > sql_mem_processor_.get_mem_bound(); }
+  int init_key_proj(const ExprFixedArray &all_exprs, const ExprFixedArray &keys,
+                    common::ObFixedArray<int64_t, common::ObIAllocator> &key_proj);
+  int join_step(const int64_t batch_size, bool &blocked);
+  int compare_groups(int64_t &cmp_res);
+  int begin_match_group();
+  void finish_match_group();
+  int match_group_rows(const int64_t batch_size);
+  int output_group_rest(ChildFetcher &fetcher, const bool is_left,
+                        const ObBitVector *match_flags, const bool output_matched,
+                        const int64_t batch_size, bool &finished);
+  int eval_other_conds(const int64_t cnt);
+  int project_rows(const ExprFixedArray &exprs, const int64_t col_cnt,
+                   const RowMeta &row_meta, const ObCompactRow **rows, const int64_t size);
+  int project_output(const int64_t size);
+  int expand_match_flags(ObBitVector *&flags, int64_t &flags_size, const int64_t size);
+  inline bool need_left_match_flags() const
+  {
+    return need_left_join() || LEFT_SEMI_JOIN == get_spec().join_type_
+           || LEFT_ANTI_JOIN == get_spec().join_type_;
+  }
+  inline void add_output(const ObCompactRow *l_row, const ObCompactRow *r_row)
+  {
+    output_left_rows_[output_cnt_] = l_row;
+    output_right_rows_[output_cnt_] = r_row;
+    output_cnt_++;
+  }
+  void destroy_mem_context()
+  {
+    if (nullptr != mem_context_) {
+      DESTROY_CONTEXT(mem_context_);
+      mem_context_ = nullptr;
+    }
+  }
+private:
+  JoinState state_;
+  lib::MemoryContext mem_context_;
+  ObSqlWorkAreaProfile profile_;
+  ObSqlMemMgrProcessor sql_mem_processor_;
+  // copies of rows read from dumped groups, reused for every output batch.
+  common::ObArenaAllocator dumped_row_alloc_;
+  ChildFetcher left_fetcher_;
+  ChildFetcher right_fetcher_;
+  common::ObFixedArray<int64_t, common::ObIAllocator> left_key_proj_;
+  common::ObFixedArray<int64_t, common::ObIAllocator> right_key_proj_;
+  // output rows of current batch, NULL means blank row.
+  const ObCompactRow **output_left_rows_;
+  const ObCompactRow **output_right_rows_;
+  int64_t output_cnt_;
+  // selector and rows buffer used for projection.
+  uint16_t *proj_selector_;
+  const ObCompactRow **proj_rows_;
+  // cursor of the left/right group while generating pairs or outputting rest rows,
+  // offset to the group start.
+  int64_t left_idx_;
+  int64_t right_idx_;
+  // match flags of rows in current matched groups, indexed by offset to group start.
+  ObBitVector *left_match_flags_;
+  int64_t left_match_flags_size_;
+  ObBitVector *right_match_flags_;
+  int64_t right_match_flags_size_;
+  ObBitVector *cond_skip_;
+  // candidate pairs before evaluating other join conditions.
+  const ObCompactRow **cand_left_rows_;
+  const ObCompactRow **cand_right_rows_;
+  int64_t *cand_left_idxes_;
+  int64_t *cand_right_idxes_;
+  bool output_right_exprs_;
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+#endif // OCEANBASE_SQL_ENGINE_JOIN_OB_MERGE_JOIN_VEC_OP_
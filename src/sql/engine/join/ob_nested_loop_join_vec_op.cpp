@@ -0,0 +1,590 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/join/ob_nested_loop_join_vec_op.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/ob_physical_plan_ctx.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "share/vector/ob_fixed_length_base.h"
+#include "share/vector/ob_uniform_base.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+OB_SERIALIZE_MEMBER((ObNestedLoopJoinVecSpec, ObJoinVecSpec),
+                    rescan_params_, group_rescan_, group_size_);
+
+ObNestedLoopJoinVecOp::ObNestedLoopJoinVecOp(ObExecContext &exec_ctx,
+                                             const ObOpSpec &spec,
+                                             ObOpInput *input)
+  : ObJoinVecOp(exec_ctx, spec, input),
+    state_(JS_FILL_LEFT), mem_context_(nullptr), left_store_(), left_rows_(NULL),
+    left_cnt_(0), left_idx_(-1), left_end_(false), max_group_size_(0), group_scan_size_(0),
+    op_max_batch_size_(0), left_matched_(NULL), cur_row_matched_(false), right_end_(false),
+    output_idx_(0), proj_rows_(NULL), group_params_(), rescan_params_info_(),
+    group_rescan_cnt_(0)
+{
+}
+
+int ObNestedLoopJoinVecOp::inner_open()
+{
+  int ret = OB_SUCCESS;
+  ObIAllocator &alloc = ctx_.get_allocator();
+  int64_t simulate_group_size = - EVENT_CALL(EventTable::EN_DAS_SIMULATE_GROUP_SIZE);
+  if (OB_ISNULL(left_) || OB_ISNULL(right_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("nlj child is null", KP(left_), KP(right_), K(ret));
+  } else if (OB_UNLIKELY(MY_SPEC.max_batch_size_ <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("vectorized nlj expect positive batch size", K(ret), K(MY_SPEC.max_batch_size_));
+  } else if (OB_FAIL(ObJoinVecOp::inner_open())) {
+    LOG_WARN("failed to open in base class", K(ret));
+  } else if (OB_FAIL(init_mem_context())) {
+    LOG_WARN("fail to init memory context", K(ret));
+  } else {
+    if (!MY_SPEC.group_rescan_) {
+      group_scan_size_ = MY_SPEC.max_batch_size_;
+    } else if (simulate_group_size > 0) {
+      group_scan_size_ = simulate_group_size;
+      LOG_TRACE("simulate group size is", K(simulate_group_size));
+    } else {
+      group_scan_size_ = MY_SPEC.group_size_;
+    }
+    // the last left batch may exceed the group size
+    max_group_size_ = group_scan_size_ + MY_SPEC.max_batch_size_;
+    ObMemAttr attr(ctx_.get_my_session()->get_effective_tenant_id(),
+                   ObModIds::OB_SQL_NLJ_CACHE, ObCtxIds::WORK_AREA);
+    if (OB_FAIL(left_store_.init(left_->get_spec().output_, MY_SPEC.max_batch_size_, attr,
+                                 0 /*mem_limit*/, false /*enable_dump*/, 0 /*row_extra_size*/,
+                                 NONE_COMPRESSOR))) {
+      LOG_WARN("init left row store failed", K(ret));
+    } else if (FALSE_IT(left_store_.set_allocator(mem_context_->get_malloc_allocator()))) {
+    } else if (OB_ISNULL(left_rows_ = static_cast<ObCompactRow **>(
+                         alloc.alloc(sizeof(ObCompactRow *) * max_group_size_)))
+               || OB_ISNULL(proj_rows_ = static_cast<const ObCompactRow **>(
+                            alloc.alloc(sizeof(ObCompactRow *) * MY_SPEC.max_batch_size_)))
+               || OB_ISNULL(left_matched_ = to_bit_vector(
+                            alloc.alloc(ObBitVector::memory_size(max_group_size_))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(max_group_size_));
+    } else if (OB_FAIL(init_group_params())) {
+      LOG_WARN("init group params failed", K(ret));
+    } else {
+      left_matched_->reset(max_group_size_);
+      LOG_TRACE("group size of vectorized NLJ is", K(group_scan_size_), K(max_group_size_),
+                K(MY_SPEC.group_rescan_));
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::init_mem_context()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(mem_context_)) {
+    ObSQLSessionInfo *session = ctx_.get_my_session();
+    uint64_t tenant_id = session->get_effective_tenant_id();
+    lib::ContextParam param;
+    param.set_mem_attr(tenant_id,
+                       ObModIds::OB_SQL_NLJ_CACHE,
+                       ObCtxIds::WORK_AREA)
+      .set_properties(lib::USE_TL_PAGE_OPTIONAL);
+    if (OB_FAIL(CURRENT_CONTEXT->CREATE_CONTEXT(mem_context_, param))) {
+      LOG_WARN("create entity failed", K(ret));
+    } else if (OB_ISNULL(mem_context_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null memory entity returned", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::init_group_params()
+{
+  int ret = OB_SUCCESS;
+  const ObIArray<ObDynamicParamSetter> &rescan_params = MY_SPEC.rescan_params_;
+  ObIAllocator &alloc = ctx_.get_allocator();
+  if (rescan_params.empty()) {
+    // do nothing
+  } else if (OB_FAIL(group_params_.allocate_array(alloc, rescan_params.count()))) {
+    LOG_WARN("allocate group params array failed", K(ret), K(rescan_params.count()));
+  } else if (OB_FAIL(rescan_params_info_.allocate_array(alloc, rescan_params.count()))) {
+    LOG_WARN("allocate group param info failed", K(ret), K(rescan_params.count()));
+  } else {
+    const int64_t obj_buf_size = sizeof(ObObjParam) * max_group_size_;
+    for (int64_t i = 0; OB_SUCC(ret) && i < group_params_.count(); ++i) {
+      ObExpr *dst_expr = rescan_params.at(i).dst_;
+      void *buf = alloc.alloc(obj_buf_size);
+      if (OB_ISNULL(buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc memory failed", K(ret), K(obj_buf_size));
+      } else {
+        group_params_.at(i).data_ = reinterpret_cast<ObObjParam *>(buf);
+        group_params_.at(i).count_ = 0;
+        group_params_.at(i).element_.set_meta_type(dst_expr->obj_meta_);
+        rescan_params_info_.at(i).param_idx_ = rescan_params.at(i).param_idx_;
+        rescan_params_info_.at(i).gr_param_ = &group_params_.at(i);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::rescan()
+{
+  int ret = OB_SUCCESS;
+  // NLJ's rescan only drives left child's rescan, the right child is rescanned for
+  // every left row.
+  if (OB_FAIL(left_->rescan())) {
+    LOG_WARN("rescan left child operator failed", K(ret), "child op_type", left_->op_name());
+  } else if (OB_FAIL(inner_rescan())) {
+    LOG_WARN("failed to inner rescan", K(ret));
+  }
+
+#ifndef NDEBUG
+  OX(OB_ASSERT(false == brs_.end_));
+#endif
+
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::switch_iterator()
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(ObOperator::inner_switch_iterator())) {
+    LOG_WARN("failed to inner switch iterator", K(ret));
+  } else if (OB_FAIL(left_->switch_iterator())) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("switch left child iterator failed", K(ret));
+    }
+  } else {
+    reset();
+  }
+
+#ifndef NDEBUG
+  OX(OB_ASSERT(false == brs_.end_));
+#endif
+
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::inner_rescan()
+{
+  int ret = OB_SUCCESS;
+  reset();
+  set_param_null();
+  if (OB_FAIL(ObJoinVecOp::inner_rescan())) {
+    LOG_WARN("failed to rescan", K(ret));
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::inner_close()
+{
+  reset();
+  left_store_.reset();
+  return ObJoinVecOp::inner_close();
+}
+
+void ObNestedLoopJoinVecOp::destroy()
+{
+  left_store_.reset();
+  destroy_mem_context();
+  ObJoinVecOp::destroy();
+}
+
+void ObNestedLoopJoinVecOp::reset()
+{
+  state_ = JS_FILL_LEFT;
+  left_store_.reuse();
+  left_cnt_ = 0;
+  left_idx_ = -1;
+  left_end_ = false;
+  cur_row_matched_ = false;
+  right_end_ = false;
+  output_idx_ = 0;
+}
+
+void ObNestedLoopJoinVecOp::set_param_null()
+{
+  set_pushdown_param_null(MY_SPEC.rescan_params_);
+}
+
+int ObNestedLoopJoinVecOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  bool produced = false;
+  op_max_batch_size_ = min(max_row_cnt, MY_SPEC.max_batch_size_);
+  brs_.size_ = 0;
+  while (OB_SUCC(ret) && !produced && JS_JOIN_END != state_) {
+    clear_evaluated_flag();
+    switch (state_) {
+      case JS_FILL_LEFT: {
+        if (left_end_) {
+          state_ = JS_JOIN_END;
+        } else if (OB_FAIL(fill_left_group())) {
+          LOG_WARN("fill left group failed", K(ret));
+        } else if (0 == left_cnt_) {
+          state_ = JS_JOIN_END;
+        } else {
+          state_ = JS_RESCAN_RIGHT;
+        }
+        break;
+      }
+      case JS_RESCAN_RIGHT: {
+        left_idx_++;
+        if (left_idx_ >= left_cnt_) {
+          if (is_left_semi_anti()) {
+            output_idx_ = 0;
+            state_ = JS_OUTPUT_LEFT;
+          } else {
+            state_ = JS_FILL_LEFT;
+          }
+        } else if (OB_FAIL(rescan_right())) {
+          LOG_WARN("rescan right failed", K(ret), K(left_idx_));
+        } else {
+          state_ = JS_PROCESS_RIGHT;
+        }
+        break;
+      }
+      case JS_PROCESS_RIGHT: {
+        if (OB_FAIL(process_right_batch(produced))) {
+          LOG_WARN("process right batch failed", K(ret));
+        } else if (right_end_) {
+          state_ = JS_RESCAN_RIGHT;
+        }
+        break;
+      }
+      case JS_OUTPUT_LEFT: {
+        if (OB_FAIL(output_left_rows(produced))) {
+          LOG_WARN("output left rows failed", K(ret));
+        } else if (output_idx_ >= left_cnt_) {
+          state_ = JS_FILL_LEFT;
+        }
+        break;
+      }
+      default: {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected join state", K(ret), K(state_));
+      }
+    }
+  }
+  if (OB_SUCC(ret) && !produced && JS_JOIN_END == state_) {
+    brs_.size_ = 0;
+    brs_.end_ = true;
+    set_param_null();
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::fill_left_group()
+{
+  int ret = OB_SUCCESS;
+  const ObBatchRows *left_brs = NULL;
+  left_store_.reuse();
+  mem_context_->get_arena_allocator().reset();
+  left_cnt_ = 0;
+  left_idx_ = -1;
+  for (int64_t i = 0; i < group_params_.count(); ++i) {
+    group_params_.at(i).count_ = 0;
+  }
+  left_matched_->reset(max_group_size_);
+  while (OB_SUCC(ret) && !left_end_ && left_cnt_ < group_scan_size_) {
+    // need clear evaluated flag, since rescan params are evaluated for every left batch.
+    clear_evaluated_flag();
+    // Reset exec param before get left row, because the exec param still reference
+    // to the previous row, when get next left row, it may become wild pointer.
+    set_param_null();
+    {
+      DASGroupScanMarkGuard mark_guard(ctx_.get_das_ctx(), MY_SPEC.group_rescan_);
+      if (OB_FAIL(left_->get_next_batch(op_max_batch_size_, left_brs))) {
+        LOG_WARN("get next batch from left failed", K(ret));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (FALSE_IT(left_end_ = left_brs->end_)) {
+    } else if (left_brs->size_ > 0 && OB_FAIL(add_left_batch(*left_brs))) {
+      LOG_WARN("add left batch failed", K(ret));
+    }
+  }
+  set_param_null();
+  clear_evaluated_flag();
+  if (OB_SUCC(ret) && left_cnt_ > 0 && MY_SPEC.group_rescan_) {
+    // new group: the first right rescan performs the multi-range scan of the whole group.
+    group_rescan_cnt_++;
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::add_left_batch(const ObBatchRows &brs)
+{
+  int ret = OB_SUCCESS;
+  int64_t stored_cnt = 0;
+  if (OB_FAIL(left_store_.add_batch(left_->get_spec().output_, eval_ctx_, brs, stored_cnt,
+                                    left_rows_ + left_cnt_))) {
+    LOG_WARN("add batch to left store failed", K(ret));
+  } else if (OB_FAIL(save_rescan_params(brs))) {
+    LOG_WARN("save rescan params failed", K(ret));
+  } else {
+    left_cnt_ += stored_cnt;
+  }
+  return ret;
+}
+
+// Calculate rescan params of the left batch and deep copy them to group params,
+// group_params_.at(i).data_[j] is the i-th param of the j-th left row in group.
+int ObNestedLoopJoinVecOp::save_rescan_params(const ObBatchRows &brs)
+{
+  int ret = OB_SUCCESS;
+  ObIAllocator &arena = mem_context_->get_arena_allocator();
+  for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.rescan_params_.count(); i++) {
+    const ObDynamicParamSetter &setter = MY_SPEC.rescan_params_.at(i);
+    ObSqlArrayObj &arr = group_params_.at(i);
+    if (OB_ISNULL(setter.src_) || OB_ISNULL(setter.dst_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("invalid rescan param", K(ret), K(setter));
+    } else if (OB_FAIL(setter.src_->eval_vector(eval_ctx_, brs))) {
+      LOG_WARN("fail to calc rescan params", K(ret), K(setter));
+    } else {
+      const ObIVector *vec = setter.src_->get_vector(eval_ctx_);
+      for (int64_t j = 0; OB_SUCC(ret) && j < brs.size_; j++) {
+        if (!brs.all_rows_active_ && brs.skip_->at(j)) {
+          continue;
+        }
+        const bool is_null = vec->is_null(j);
+        ObDatum datum(is_null ? NULL : vec->get_payload(j),
+                      is_null ? 0 : vec->get_length(j),
+                      is_null);
+        ObObj obj;
+        if (OB_FAIL(datum.to_obj(obj, setter.dst_->obj_meta_, setter.dst_->obj_datum_map_))) {
+          LOG_WARN("convert datum to obj failed", K(ret), K(i), K(j));
+        } else if (OB_FAIL(ob_write_obj(arena, obj, arr.data_[arr.count_]))) {
+          LOG_WARN("deep copy dynamic param failed", K(ret), K(i), K(j));
+        } else {
+          arr.data_[arr.count_].set_param_meta();
+          arr.count_++;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::fill_cur_row_rescan_params()
+{
+  int ret = OB_SUCCESS;
+  ObPhysicalPlanCtx *plan_ctx = ctx_.get_physical_plan_ctx();
+  if (OB_ISNULL(plan_ctx)) {
+    ret = OB_BAD_NULL_ERROR;
+    LOG_WARN("plan ctx is null", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < group_params_.count(); i++) {
+    const ObDynamicParamSetter &rescan_param = MY_SPEC.rescan_params_.at(i);
+    ObExpr *dst = rescan_param.dst_;
+    ObSqlArrayObj &arr = group_params_.at(i);
+    if (OB_UNLIKELY(left_idx_ >= arr.count_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("row idx is unexpected", K(ret), K(left_idx_), K(arr.count_));
+    } else {
+      ObDatum &param_datum = dst->locate_datum_for_write(eval_ctx_);
+      dst->get_eval_info(eval_ctx_).clear_evaluated_flag();
+      ObDynamicParamSetter::clear_parent_evaluated_flag(eval_ctx_, *dst);
+      if (OB_FAIL(param_datum.from_obj(arr.data_[left_idx_], dst->obj_datum_map_))) {
+        LOG_WARN("fail to cast datum", K(ret));
+      } else {
+        plan_ctx->get_param_store_for_update().at(rescan_param.param_idx_) = arr.data_[left_idx_];
+        dst->set_evaluated_projected(eval_ctx_);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::rescan_right()
+{
+  int ret = OB_SUCCESS;
+  cur_row_matched_ = false;
+  right_end_ = false;
+  if (OB_FAIL(fill_cur_row_rescan_params())) {
+    LOG_WARN("fill cur row rescan params failed", K(ret));
+  } else if (MY_SPEC.group_rescan_) {
+    GroupParamBackupGuard guard(right_->get_exec_ctx().get_das_ctx());
+    guard.bind_batch_rescan_params(left_idx_, group_rescan_cnt_, &rescan_params_info_);
+    if (OB_FAIL(right_->rescan())) {
+      LOG_WARN("rescan right failed", K(ret), K(left_idx_), K(group_rescan_cnt_));
+    }
+  } else if (OB_FAIL(right_->rescan())) {
+    LOG_WARN("rescan right failed", K(ret));
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::get_next_right_batch(const ObBatchRows *&right_brs)
+{
+  int ret = OB_SUCCESS;
+  DASGroupScanMarkGuard mark_guard(ctx_.get_das_ctx(), MY_SPEC.group_rescan_);
+  if (MY_SPEC.group_rescan_) {
+    GroupParamBackupGuard guard(right_->get_exec_ctx().get_das_ctx());
+    guard.bind_batch_rescan_params(left_idx_, group_rescan_cnt_, &rescan_params_info_);
+    ret = right_->get_next_batch(op_max_batch_size_, right_brs);
+  } else {
+    ret = right_->get_next_batch(op_max_batch_size_, right_brs);
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::process_right_batch(bool &produced)
+{
+  int ret = OB_SUCCESS;
+  const ObBatchRows *right_brs = NULL;
+  const bool has_other_conds = MY_SPEC.other_join_conds_.count() > 0;
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+  if (OB_FAIL(get_next_right_batch(right_brs))) {
+    LOG_WARN("get next right batch failed", K(ret));
+  } else if (FALSE_IT(right_end_ = right_brs->end_)) {
+  } else if (right_brs->size_ > 0) {
+    const int64_t size = right_brs->size_;
+    int64_t match_cnt = 0;
+    batch_info_guard.set_batch_size(size);
+    brs_.skip_->deep_copy(*right_brs->skip_, size);
+    if (!is_left_semi_anti() || has_other_conds) {
+      // left row is needed by output and other join conditions
+      for (int64_t i = 0; i < size; i++) {
+        proj_rows_[i] = left_rows_[left_idx_];
+      }
+      if (OB_FAIL(project_left_rows(proj_rows_, size))) {
+        LOG_WARN("project left rows failed", K(ret));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (has_other_conds) {
+      if (OB_FAIL(eval_other_conds(size, match_cnt))) {
+        LOG_WARN("eval other join conditions failed", K(ret));
+      }
+    } else {
+      match_cnt = right_brs->all_rows_active_
+                  ? size : size - brs_.skip_->accumulate_bit_cnt(size);
+    }
+    if (OB_FAIL(ret) || 0 == match_cnt) {
+    } else if (is_left_semi_anti()) {
+      // matched, no need to read the rest right rows.
+      left_matched_->set(left_idx_);
+      right_end_ = true;
+    } else {
+      brs_.size_ = size;
+      brs_.all_rows_active_ = (match_cnt == size);
+      cur_row_matched_ = true;
+      produced = true;
+    }
+  }
+  // outer join: generate a blank row for LEFT OUTER JOIN
+  // Note: optimizer guarantee there is NO RIGHT/FULL OUTER JOIN for NLJ
+  if (OB_SUCC(ret) && right_end_ && !produced && !cur_row_matched_ && need_left_join()) {
+    batch_info_guard.set_batch_size(1);
+    proj_rows_[0] = left_rows_[left_idx_];
+    clear_evaluated_flag();
+    if (OB_FAIL(project_left_rows(proj_rows_, 1))) {
+      LOG_WARN("project left rows failed", K(ret));
+    } else if (OB_FAIL(blank_row_batch(right_->get_spec().output_, 1))) {
+      LOG_WARN("blank right row failed", K(ret));
+    } else {
+      brs_.size_ = 1;
+      brs_.skip_->reset(1);
+      brs_.all_rows_active_ = true;
+      produced = true;
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::output_left_rows(bool &produced)
+{
+  int ret = OB_SUCCESS;
+  const bool output_matched = (LEFT_SEMI_JOIN == MY_SPEC.join_type_);
+  int64_t cnt = 0;
+  while (output_idx_ < left_cnt_ && cnt < op_max_batch_size_) {
+    if (output_matched == left_matched_->at(output_idx_)) {
+      proj_rows_[cnt++] = left_rows_[output_idx_];
+    }
+    output_idx_++;
+  }
+  if (cnt > 0) {
+    if (OB_FAIL(project_left_rows(proj_rows_, cnt))) {
+      LOG_WARN("project left rows failed", K(ret));
+    } else {
+      brs_.size_ = cnt;
+      brs_.skip_->reset(cnt);
+      brs_.all_rows_active_ = true;
+      produced = true;
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::eval_other_conds(const int64_t size, int64_t &match_cnt)
+{
+  int ret = OB_SUCCESS;
+  const ObIArray<ObExpr *> &conds = MY_SPEC.other_join_conds_;
+  ObBitVector &skip = *brs_.skip_;
+  bool all_rows_active = skip.is_all_false(size);
+  for (int64_t i = 0; OB_SUCC(ret) && i < conds.count(); i++) {
+    ObExpr *cond = conds.at(i);
+    if (OB_FAIL(cond->eval_vector(eval_ctx_, skip, EvalBound(size, all_rows_active)))) {
+      LOG_WARN("fail to eval other join condition", K(ret), K(*cond));
+    } else if (is_uniform_format(cond->get_format(eval_ctx_))) {
+      ObUniformBase *uni_vec = static_cast<ObUniformBase *>(cond->get_vector(eval_ctx_));
+      for (int64_t j = 0; j < size; j++) {
+        if (!skip.at(j) && (uni_vec->is_null(j) || 0 == uni_vec->get_int(j))) {
+          skip.set(j);
+        }
+      }
+    } else {
+      ObFixedLengthBase *fixed_vec = static_cast<ObFixedLengthBase *>(cond->get_vector(eval_ctx_));
+      for (int64_t j = 0; j < size; j++) {
+        if (!skip.at(j) && (fixed_vec->is_null(j) || 0 == fixed_vec->get_int(j))) {
+          skip.set(j);
+        }
+      }
+    }
+    all_rows_active = all_rows_active && skip.is_all_false(size);
+  }
+  if (OB_SUCC(ret)) {
+    match_cnt = size - skip.accumulate_bit_cnt(size);
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinVecOp::project_left_rows(const ObCompactRow **rows, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &exprs = left_->get_spec().output_;
+  for (int64_t col_idx = 0; OB_SUCC(ret) && col_idx < exprs.count(); col_idx++) {
+    ObExpr *expr = exprs.at(col_idx);
+    if (OB_FAIL(expr->init_vector_default(eval_ctx_, size))) {
+      LOG_WARN("fail to init vector", K(ret));
+    } else if (OB_FAIL(expr->get_vector(eval_ctx_)->from_rows(left_store_.get_row_meta(),
+                                                             rows, size, col_idx))) {
+      LOG_WARN("fail to project left rows", K(ret), K(col_idx));
+    } else {
+      expr->set_evaluated_projected(eval_ctx_);
+    }
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
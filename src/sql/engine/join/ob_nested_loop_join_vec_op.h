@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_JOIN_OB_NESTED_LOOP_JOIN_VEC_OP_
+#define OCEANBASE_SQL_ENGINE_JOIN_OB_NESTED_LOOP_JOIN_VEC_OP_
+
+#include "sql/engine/join/ob_join_vec_op.h"
+#include "sql/engine/basic/ob_temp_row_store.h"
+#include "sql/das/ob_das_context.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+class ObNestedLoopJoinVecSpec : public ObJoinVecSpec
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  ObNestedLoopJoinVecSpec(common::ObIAllocator &alloc, const ObPhyOperatorType type)
+    : ObJoinVecSpec(alloc, type),
+      rescan_params_(alloc),
+      group_rescan_(false),
+      group_size_(OB_MAX_BULK_JOIN_ROWS)
+  {}
+  virtual ~ObNestedLoopJoinVecSpec() {}
+
+public:
+  common::ObFixedArray<ObDynamicParamSetter, common::ObIAllocator> rescan_params_;
+  // rescan right child with the params of a group of left rows in one DAS scan
+  bool group_rescan_;
+  int64_t group_size_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObNestedLoopJoinVecSpec);
+};
+
+// Vectorized nested loop join.
+//
+// Left rows are read a batch at a time and kept in an ObTempRowStore until a group is filled
+// (group_size_ rows with group rescan, one left batch otherwise). The rescan params of the whole
+// group are calculated with eval_vector() and deep copied into ObSqlArrayObj arrays. With group
+// rescan the arrays are bound to the DAS context, the first right rescan of a group pushes all
+// params down as one multi-range scan and the following rescans only switch to the result of
+// next group id, so there is no per row re-open of the right child.
+//
+// Join results are produced per right batch: the current left row is projected to the positions
+// of the right batch and other join conditions are evaluated with eval_vector(). Semi/anti join
+// only record the match flags and output the left rows after the whole group is processed.
+//
+// Only single level group rescan is supported, the code generator falls back to
+// ObNestedLoopJoinOp when params are pushed down from the above NLJ, or px batch rescan
+// or GI partition pruning is enabled.
+class ObNestedLoopJoinVecOp : public ObJoinVecOp
+{
+private:
+  enum JoinState {
+    JS_FILL_LEFT = 0,
+    JS_RESCAN_RIGHT,
+    JS_PROCESS_RIGHT,
+    JS_OUTPUT_LEFT,   // output left rows of the group for semi/anti join
+    JS_JOIN_END
+  };
+public:
+  ObNestedLoopJoinVecOp(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOpInput *input);
+  virtual ~ObNestedLoopJoinVecOp() {}
+
+  virtual int inner_open() override;
+  virtual int rescan() override;
+  virtual int switch_iterator() override;
+  virtual int inner_rescan() override;
+  virtual int inner_get_next_row() override { return common::OB_NOT_IMPLEMENT; }
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
+  virtual int inner_close() override;
+  virtual void destroy() override;
+  virtual OperatorOpenOrder get_operator_open_order() const override final
+  { return OPEN_SELF_FIRST; }
+
+private:
+  void reset();
+  int init_mem_context();
+  int init_group_params();
+  int fill_left_group();
+  int add_left_batch(const ObBatchRows &brs);
+  int save_rescan_params(const ObBatchRows &brs);
+  int fill_cur_row_rescan_params();
+  int rescan_right();
+  int get_next_right_batch(const ObBatchRows *&right_brs);
+  int process_right_batch(bool &produced);
+  int output_left_rows(bool &produced);
+  int eval_other_conds(const int64_t size, int64_t &match_cnt);
+  int project_left_rows(const ObCompactRow **rows, const int64_t size);
+  void set_param_null();
+  inline bool is_left_semi_anti() const
+  {
+    return LEFT_SEMI_JOIN == get_spec().join_type_ || LEFT_ANTI_JOIN == get_spec().join_type_;
+  }
+  void destroy_mem_context()
+  {
+    if (nullptr != mem_context_) {
+      DESTROY_CONTEXT(mem_context_);
+      mem_context_ = nullptr;
+    }
+  }
+
+private:
+  JoinState state_;
+  lib::MemoryContext mem_context_;
+  // left rows of current group
+  ObTempRowStore left_store_;
+  ObCompactRow **left_rows_;
+  int64_t left_cnt_;
+  int64_t left_idx_;
+  bool left_end_;
+  int64_t max_group_size_;
+  int64_t group_scan_size_;
+  int64_t op_max_batch_size_;
+  // match flags of left rows in group, for semi/anti join
+  ObBitVector *left_matched_;
+  // current left row matched any right row, for left outer join
+  bool cur_row_matched_;
+  bool right_end_;
+  int64_t output_idx_;
+  const ObCompactRow **proj_rows_;
+  // rescan params of left rows in group, one array per param.
+  common::ObArrayWrap<ObSqlArrayObj> group_params_;
+  GroupParamArray rescan_params_info_;
+  int64_t group_rescan_cnt_;
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+#endif // OCEANBASE_SQL_ENGINE_JOIN_OB_NESTED_LOOP_JOIN_VEC_OP_
@@ -127,6 +127,8 @@
 #include "sql/engine/subquery/ob_subplan_scan_op.h"
 #include "sql/engine/subquery/ob_unpivot_op.h"
 #include "sql/engine/join/ob_merge_join_op.h"
+#include "sql/engine/join/ob_merge_join_vec_op.h"
+#include "sql/engine/join/ob_nested_loop_join_vec_op.h"
 #include "sql/code_generator/ob_static_engine_cg.h"
 #include "sql/engine/basic/ob_monitoring_dump_op.h"
 #include "sql/engine/join/ob_join_filter_op.h"
@@ -462,6 +462,12 @@ class ObNestedLoopJoinOp;
 REGISTER_OPERATOR(ObLogJoin, PHY_NESTED_LOOP_JOIN, ObNestedLoopJoinSpec,
                   ObNestedLoopJoinOp, NOINPUT, VECTORIZED_OP);
 
+class ObNestedLoopJoinVecSpec;
+class ObNestedLoopJoinVecOp;
+REGISTER_OPERATOR(ObLogJoin, PHY_VEC_NESTED_LOOP_JOIN, ObNestedLoopJoinVecSpec,
+                  ObNestedLoopJoinVecOp, NOINPUT, VECTORIZED_OP, 0 /*+version*/,
+                  SUPPORT_RICH_FORMAT);
+
 class ObLogSubPlanFilter;
 class ObSubPlanFilterSpec;
 class ObSubPlanFilterOp;
@@ -524,11 +530,13 @@ class ObHashGroupBySpec;
 class ObHashGroupByOp;
 class ObHashGroupByVecSpec;
 class ObHashGroupByVecOp;
+class ObHashGroupByVecInput;
 REGISTER_OPERATOR(ObLogGroupBy, PHY_HASH_GROUP_BY, ObHashGroupBySpec,
                   ObHashGroupByOp, NOINPUT, VECTORIZED_OP);
 
 REGISTER_OPERATOR(ObLogGroupBy, PHY_VEC_HASH_GROUP_BY, ObHashGroupByVecSpec,
-                  ObHashGroupByVecOp, NOINPUT, VECTORIZED_OP, 0, SUPPORT_RICH_FORMAT);
+                  ObHashGroupByVecOp, ObHashGroupByVecInput, VECTORIZED_OP, 0,
+                  SUPPORT_RICH_FORMAT);
 
 class ObLogWindowFunction;
 class ObWindowFunctionSpec;
@@ -550,6 +558,11 @@ class ObMergeJoinOp;
 REGISTER_OPERATOR(ObLogJoin, PHY_MERGE_JOIN, ObMergeJoinSpec, ObMergeJoinOp,
                   NOINPUT, VECTORIZED_OP);
 
+class ObMergeJoinVecSpec;
+class ObMergeJoinVecOp;
+REGISTER_OPERATOR(ObLogJoin, PHY_VEC_MERGE_JOIN, ObMergeJoinVecSpec, ObMergeJoinVecOp,
+                  NOINPUT, VECTORIZED_OP, 0 /*+version*/, SUPPORT_RICH_FORMAT);
+
 class ObLogTopk;
 class ObTopKSpec;
 class ObTopKOp;
@@ -139,6 +139,8 @@ PHY_OP_DEF(PHY_VEC_HASH_UNION)
 PHY_OP_DEF(PHY_VEC_HASH_INTERSECT)
 PHY_OP_DEF(PHY_VEC_HASH_EXCEPT)
 PHY_OP_DEF(PHY_VEC_WINDOW_FUNCTION)
+PHY_OP_DEF(PHY_VEC_MERGE_JOIN)
+PHY_OP_DEF(PHY_VEC_NESTED_LOOP_JOIN)
 PHY_OP_DEF(PHY_END)
 #endif /*PHY_OP_DEF*/
 
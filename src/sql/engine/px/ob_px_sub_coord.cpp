@@ -47,6 +47,7 @@
 #include "sql/das/ob_das_utils.h"
 #include "sql/engine/px/p2p_datahub/ob_p2p_dh_mgr.h"
 #include "sql/engine/window_function/ob_window_function_vec_op.h"
+#include "sql/engine/aggregate/ob_hash_groupby_vec_op.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::sql;
@@ -536,6 +537,23 @@ int ObPxSubCoord::setup_op_input(ObExecContext &ctx,
       LOG_DEBUG("debug wf input", K(wf_spec->role_type_), K(sqc.get_task_count()),
                 K(sqc.get_total_task_count()));
     }
+  } else if (root.get_type() == PHY_VEC_HASH_GROUP_BY) {
+    ObPxSqcMeta &sqc = sqc_arg_.sqc_;
+    ObHashGroupByVecInput *gby_input = NULL;
+    ObOperatorKit *kit = ctx.get_operator_kit(root.id_);
+    ObHashGroupByVecSpec *gby_spec = reinterpret_cast<ObHashGroupByVecSpec *>(&root);
+    if (!gby_spec->use_shared_table_) {
+    } else if (OB_ISNULL(kit) || OB_ISNULL(kit->input_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("operator is NULL", K(ret), KP(kit));
+    } else if (FALSE_IT(gby_input = static_cast<ObHashGroupByVecInput *>(kit->input_))) {
+    } else if (sqc.get_task_count() > 1
+               && OB_FAIL(gby_input->init_shared_table(ctx.get_allocator(),
+                                                       sqc.get_task_count()))) {
+      LOG_WARN("failed to init shared group table", K(ret));
+    } else {
+      LOG_TRACE("debug hash group by input", K(sqc.get_task_count()));
+    }
   } else if (root.get_type() == PHY_VEC_SORT) {
     // TODO XUNSI: if shared topn filter, init the shared topn msg here
   } else if (root.get_type() == PHY_VEC_WINDOW_FUNCTION) {
@@ -21,6 +21,7 @@
 #include "share/rc/ob_context.h"
 #include "sql/engine/expr/ob_expr_topn_filter.h"
 #include "sql/engine/px/ob_px_sqc_handler.h"
+#include "sql/engine/table/ob_table_scan_op.h"
 #include "sql/engine/ob_exec_context.h"
 #include "observer/ob_server_struct.h"
 #include "src/observer/ob_server.h"
@@ -58,14 +59,35 @@ inline int ObPushDownTopNFilter::init(const ObSortVecOpContext &ctx,
                                       lib::MemoryContext &mem_context)
 {
   return init(ctx.pd_topn_filter_info_, ctx.tenant_id_, ctx.sk_collations_, ctx.exec_ctx_,
-              mem_context, true /*use_rich_format*/);
+              mem_context, true /*use_rich_format*/, get_direct_topn_cnt(ctx));
+}
+
+int64_t ObPushDownTopNFilter::get_direct_topn_cnt(const ObSortVecOpContext &ctx)
+{
+  // The rows out of the top n can be skipped by storage only if no operator filters rows between
+  // the sort and the storage, that is the sort is directly above a table scan without index back,
+  // and all the filters of the table scan are pushed down to storage.
+  int64_t topn_cnt = 0;
+  const ObOpSpec *child_spec = nullptr;
+  if (INT64_MAX == ctx.topn_cnt_ || ctx.prefix_pos_ > 0 || ctx.part_cnt_ > 0
+      || nullptr == ctx.op_) {
+  } else if (OB_ISNULL(child_spec = ctx.op_->get_spec().get_child())) {
+  } else if (PHY_TABLE_SCAN == child_spec->type_) {
+    const ObTableScanSpec *tsc_spec = static_cast<const ObTableScanSpec *>(child_spec);
+    if (!tsc_spec->is_index_back() && 0 == tsc_spec->filters_.count()
+        && nullptr == tsc_spec->tsc_ctdef_.attach_spec_.attach_ctdef_) {
+      topn_cnt = ctx.topn_cnt_;
+    }
+  }
+  return topn_cnt;
 }
 
 int ObPushDownTopNFilter::init(const ObPushDownTopNFilterInfo *pd_topn_filter_info,
                                uint64_t tenant_id,
                                const ObIArray<ObSortFieldCollation> *sort_collations,
                                ObExecContext *exec_ctx, lib::MemoryContext &mem_context,
-                               bool use_rich_format /*=false*/)
+                               bool use_rich_format /*=false*/,
+                               int64_t direct_topn_cnt /*=0*/)
 {
   int ret = OB_SUCCESS;
   ObP2PDatahubMsgBase *p2p_msg = nullptr;
@@ -95,7 +117,7 @@ int ObPushDownTopNFilter::init(const ObPushDownTopNFilterInfo *pd_topn_filter_in
     LOG_WARN("failed to init pushdown topn filter msg");
   } else if (!pd_topn_filter_info_->is_shuffle_
              && OB_FAIL(create_pd_topn_filter_ctx(pd_topn_filter_info, exec_ctx, use_rich_format,
-                                                  px_seq_id))) {
+                                                  px_seq_id, direct_topn_cnt))) {
     // for local topn filter pushdown, we directly create filter_ctx here;
     // for global topn filter pushdown, we need add a topn filter use operator and
     // create filter_ctx in topn filter use operator;
@@ -137,7 +159,7 @@ int ObPushDownTopNFilter::update_filter_data(ObChunkDatumStore::StoredRow *store
 
 int ObPushDownTopNFilter::create_pd_topn_filter_ctx(
     const ObPushDownTopNFilterInfo *pd_topn_filter_info, ObExecContext *exec_ctx,
-    bool use_rich_format, int64_t px_seq_id)
+    bool use_rich_format, int64_t px_seq_id, int64_t direct_topn_cnt)
 {
   int ret = OB_SUCCESS;
   // TODO XUNSI: if pushdown to the right table with join key but not sort key not from right table,
@@ -183,6 +205,10 @@ int ObPushDownTopNFilter::create_pd_topn_filter_ctx(
       topn_filter_ctx_->topn_filter_key_ = dh_key;
     }
   }
+  if (OB_SUCC(ret)) {
+    // the topn count may change in rescan, e.g. limit with a parameter
+    topn_filter_ctx_->direct_topn_cnt_ = direct_topn_cnt;
+  }
   return ret;
 }
 
@@ -49,7 +49,8 @@ public:
   inline int init(const ObSortVecOpContext &ctx, lib::MemoryContext &mem_context);
   int init(const ObPushDownTopNFilterInfo *pd_topn_filter_info, uint64_t tenant_id,
            const ObIArray<ObSortFieldCollation> *sort_collations, ObExecContext *exec_ctx,
-           lib::MemoryContext &mem_context, bool use_rich_format = false);
+           lib::MemoryContext &mem_context, bool use_rich_format = false,
+           int64_t direct_topn_cnt = 0);
 
   int update_filter_data(ObCompactRow *compact_row, const RowMeta *row_meta_);
   int update_filter_data(ObChunkDatumStore::StoredRow *store_row);
@@ -61,7 +62,8 @@ public:
 private:
   int create_pd_topn_filter_ctx(const ObPushDownTopNFilterInfo *pd_topn_filter_info,
                                 ObExecContext *exec_ctx, bool use_rich_format,
-                                int64_t px_seq_id);
+                                int64_t px_seq_id, int64_t direct_topn_cnt);
+  static int64_t get_direct_topn_cnt(const ObSortVecOpContext &ctx);
   // publish topn msg to consumer
   int publish_topn_msg();
 
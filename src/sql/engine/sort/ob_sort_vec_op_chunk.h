@@ -38,6 +38,18 @@ struct ObSortVecOpChunk : public common::ObDLinkBase<ObSortVecOpChunk<Store_Row,
     }
     return ret;
   }
+  // issue the async read of the first blocks, so that the first reads of all the merging
+  // chunks are overlapped, the following blocks are read ahead by the row iterators.
+  int prefetch_first_block()
+  {
+    int ret = common::OB_SUCCESS;
+    if (OB_FAIL(sk_row_iter_.prefetch_block(0))) {
+      SQL_ENG_LOG(WARN, "prefetch block failed", K(ret));
+    } else if (has_addon && OB_FAIL(addon_row_iter_.prefetch_block(0))) {
+      SQL_ENG_LOG(WARN, "prefetch block failed", K(ret));
+    }
+    return ret;
+  }
   int get_next_row()
   {
     int ret = common::OB_SUCCESS;
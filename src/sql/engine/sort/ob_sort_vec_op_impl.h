@@ -24,6 +24,7 @@
 #include "sql/engine/sort/ob_sort_key_vec_op.h"
 #include "sql/engine/sort/ob_sort_key_fetcher_vec_op.h"
 #include "sql/engine/sort/ob_sort_vec_op_eager_filter.h"
+#include "sql/engine/sort/ob_sort_vec_op_loser_tree.h"
 #include "sql/engine/sort/ob_sort_vec_op_store_row_factory.h"
 #include "observer/omt/ob_tenant_config_mgr.h"
 #include "sql/engine/sort/ob_pd_topn_sort_filter.h"
@@ -53,7 +54,7 @@ public:
     all_exprs_(allocator_), sk_vec_ptrs_(allocator_), addon_vec_ptrs_(allocator_),
     eval_ctx_(nullptr), comp_(allocator_), sk_store_(&allocator_), addon_store_(&allocator_),
     inmem_row_size_(0), mem_check_interval_mask_(1), row_idx_(0), quick_sort_array_(),
-    heap_iter_begin_(false), imms_heap_(nullptr), ems_heap_(nullptr),
+    heap_iter_begin_(false), imms_heap_(nullptr), ems_tree_(nullptr),
     next_stored_row_func_(&ObSortVecOpImpl::array_next_stored_row), exec_ctx_(nullptr),
     sk_rows_(nullptr), addon_rows_(nullptr), buckets_(nullptr), max_bucket_cnt_(0),
     part_hash_nodes_(nullptr), max_node_cnt_(0), part_cnt_(0), topn_cnt_(INT64_MAX),
@@ -187,14 +188,16 @@ protected:
   typedef int (ObSortVecOpImpl::*NextStoredRowFunc)(const Store_Row *&sr);
   int sort_inmem_data();
   int do_dump();
-  int build_ems_heap(int64_t &merge_ways);
+  // plan merge ways of next merge round according to the memory of the read buffers.
+  int plan_merge_ways(int64_t &merge_ways);
+  int build_ems_tree(int64_t &merge_ways);
   template <typename Heap, typename NextFunc, typename Item>
   int heap_next(Heap &heap, const NextFunc &func, Item &item);
-  int ems_heap_next(SortVecOpChunk *&chunk);
+  int ems_tree_next(SortVecOpChunk *&chunk);
   int imms_heap_next(const Store_Row *&sk_row);
   int array_next_stored_row(const Store_Row *&sk_row);
   int imms_heap_next_stored_row(const Store_Row *&sr);
-  int ems_heap_next_stored_row(const Store_Row *&sr);
+  int ems_tree_next_stored_row(const Store_Row *&sr);
   int build_row(const common::ObIArray<ObExpr *> &exprs, const RowMeta &row_meta,
                 const int64_t row_size, ObEvalCtx &ctx, ObCompactRow *&stored_row);
   bool need_dump()
@@ -374,7 +377,7 @@ protected:
   static const int64_t MAX_MERGE_WAYS = 256;
   static const int64_t INMEMORY_MERGE_SORT_WARN_WAYS = 10000;
   typedef common::ObBinaryHeap<Store_Row **, Compare, 16> IMMSHeap;
-  typedef common::ObBinaryHeap<SortVecOpChunk *, Compare, MAX_MERGE_WAYS> EMSHeap;
+  typedef ObSortVecOpLoserTree<SortVecOpChunk *, Compare> EMSLoserTree;
   typedef common::ObBinaryHeap<Store_Row *, Compare> TopnHeap;
 
   union
@@ -417,8 +420,8 @@ protected:
   bool heap_iter_begin_;
   // heap for in-memory merge sort local order rows
   IMMSHeap *imms_heap_;
-  // heap for external merge sort
-  EMSHeap *ems_heap_;
+  // loser tree for external merge sort
+  EMSLoserTree *ems_tree_;
   NextStoredRowFunc next_stored_row_func_;
   ObExecContext *exec_ctx_;
   Store_Row **sk_rows_;
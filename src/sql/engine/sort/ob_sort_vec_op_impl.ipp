@@ -51,10 +51,10 @@ void ObSortVecOpImpl<Compare, Store_Row, has_addon>::reset()
       mem_context_->get_malloc_allocator().free(imms_heap_);
       imms_heap_ = nullptr;
     }
-    if (nullptr != ems_heap_) {
-      ems_heap_->~EMSHeap();
-      mem_context_->get_malloc_allocator().free(ems_heap_);
-      ems_heap_ = nullptr;
+    if (nullptr != ems_tree_) {
+      ems_tree_->~EMSLoserTree();
+      mem_context_->get_malloc_allocator().free(ems_tree_);
+      ems_tree_ = nullptr;
     }
     if (nullptr != sk_rows_) {
       mem_context_->get_malloc_allocator().free(sk_rows_);
@@ -135,8 +135,8 @@ void ObSortVecOpImpl<Compare, Store_Row, has_addon>::reuse()
     imms_heap_->reset();
   }
   heap_iter_begin_ = false;
-  if (nullptr != ems_heap_) {
-    ems_heap_->reset();
+  if (nullptr != ems_tree_) {
+    ems_tree_->reuse();
   }
   if (nullptr != topn_heap_) {
     for (int64_t i = 0; i < topn_heap_->count(); ++i) {
@@ -1715,7 +1715,41 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::before_add_row()
 }
 
 template <typename Compare, typename Store_Row, bool has_addon>
-int ObSortVecOpImpl<Compare, Store_Row, has_addon>::build_ems_heap(int64_t &merge_ways)
+int ObSortVecOpImpl<Compare, Store_Row, has_addon>::plan_merge_ways(int64_t &merge_ways)
+{
+  int ret = OB_SUCCESS;
+  // every merging chunk holds the block being read and the block read ahead for each row store.
+  const int64_t way_mem_size = (has_addon ? 2 : 1) * ObTempBlockStore::BlockReader::AIO_BUF_CNT
+                               * ObTempBlockStore::BLOCK_SIZE;
+  const int64_t chunk_cnt = sort_chunks_.get_size();
+  const int64_t max_ways = chunk_cnt < MAX_MERGE_WAYS ? chunk_cnt : MAX_MERGE_WAYS;
+  merge_ways = get_memory_limit() / way_mem_size;
+  if (merge_ways < max_ways) {
+    bool dumped = false;
+    int64_t need_size = max_ways * way_mem_size;
+    if (OB_FAIL(sql_mem_processor_.extend_max_memory_size(
+          &mem_context_->get_malloc_allocator(),
+          [&](int64_t max_memory_size) { return max_memory_size < need_size; }, dumped,
+          mem_context_->used()))) {
+      SQL_ENG_LOG(WARN, "failed to extend memory size", K(ret));
+    } else {
+      merge_ways = std::max(merge_ways, get_memory_limit() / way_mem_size);
+    }
+  }
+  if (OB_SUCC(ret)) {
+    merge_ways = std::max(2L, std::min(merge_ways, max_ways));
+    if (merge_ways < chunk_cnt) {
+      // Not the last round. Only merge the smallest chunks needed in this round, so that
+      // every following round merges %merge_ways chunks and the final round is a full fan-in
+      // merge, rows of the big chunks are not rewritten by a partial round.
+      merge_ways = (chunk_cnt - 2) % (merge_ways - 1) + 2;
+    }
+  }
+  return ret;
+}
+
+template <typename Compare, typename Store_Row, bool has_addon>
+int ObSortVecOpImpl<Compare, Store_Row, has_addon>::build_ems_tree(int64_t &merge_ways)
 {
   int ret = OB_SUCCESS;
   if (!is_inited()) {
@@ -1727,69 +1761,55 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::build_ems_heap(int64_t &merg
   } else if (OB_FAIL(sql_mem_processor_.get_max_available_mem_size(
                &mem_context_->get_malloc_allocator()))) {
     SQL_ENG_LOG(WARN, "failed to get max available memory size", K(ret));
+  } else if (OB_FAIL(plan_merge_ways(merge_ways))) {
+    SQL_ENG_LOG(WARN, "failed to plan merge ways", K(ret));
   } else {
-    SortVecOpChunk *first = sort_chunks_.get_first();
-    if (first->level_ != first->get_next()->level_) {
-      LOG_TRACE("only one chunk in current level, move to next level directly", K(first->level_));
-      first->level_ = first->get_next()->level_;
-    }
-    int64_t max_ways = 1;
-    SortVecOpChunk *c = first->get_next();
-    // get max merge ways in same level
-    for (int64_t i = 0; first->level_ == c->level_
-         && i < std::min(sort_chunks_.get_size(), (int32_t)MAX_MERGE_WAYS) - 1; i++) {
-      max_ways += 1;
-      c = c->get_next();
-    }
-
-    if (nullptr == ems_heap_) {
-      if (OB_ISNULL(ems_heap_ = OB_NEWx(EMSHeap, (&mem_context_->get_malloc_allocator()), comp_,
-                                        &mem_context_->get_malloc_allocator()))) {
+    if (nullptr == ems_tree_) {
+      if (OB_ISNULL(ems_tree_ = OB_NEWx(EMSLoserTree, (&mem_context_->get_malloc_allocator()),
+                                        comp_, &mem_context_->get_malloc_allocator()))) {
         ret = OB_ALLOCATE_MEMORY_FAILED;
         SQL_ENG_LOG(WARN, "allocate memory failed", K(ret));
       }
-    } else {
-      ems_heap_->reset();
     }
-    if (OB_SUCC(ret)) {
-      merge_ways = get_memory_limit() / ObTempBlockStore::BLOCK_SIZE;
-      merge_ways = std::max(2L, merge_ways);
-      if (merge_ways < max_ways) {
-        bool dumped = false;
-        int64_t need_size = max_ways * ObTempBlockStore::BLOCK_SIZE;
-        if (OB_FAIL(sql_mem_processor_.extend_max_memory_size(
-              &mem_context_->get_malloc_allocator(),
-              [&](int64_t max_memory_size) { return max_memory_size < need_size; }, dumped,
-              mem_context_->used()))) {
-          SQL_ENG_LOG(WARN, "failed to extend memory size", K(ret));
-        }
-        merge_ways = std::max(merge_ways, get_memory_limit() / ObTempBlockStore::BLOCK_SIZE);
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(ems_tree_->init(merge_ways))) {
+      SQL_ENG_LOG(WARN, "init loser tree failed", K(ret), K(merge_ways));
+    } else {
+      LOG_TRACE("do merge sort ", K(sort_chunks_.get_first()->level_), K(merge_ways),
+                K(sort_chunks_.get_size()), K(get_memory_limit()),
+                K(sql_mem_processor_.get_profile()));
+    }
+
+    // issue the first reads of all the merging chunks before waiting any of them.
+    SortVecOpChunk *chunk = sort_chunks_.get_first();
+    for (int64_t i = 0; i < merge_ways && OB_SUCC(ret); i++) {
+      chunk->reset_row_iter();
+      if (OB_FAIL(chunk->init_row_iter())) {
+        SQL_ENG_LOG(WARN, "init iterator failed", K(ret));
+      } else if (OB_FAIL(chunk->prefetch_first_block())) {
+        SQL_ENG_LOG(WARN, "prefetch first block failed", K(ret));
+      } else {
+        chunk = chunk->get_next();
       }
-      merge_ways = std::min(merge_ways, max_ways);
-      LOG_TRACE("do merge sort ", K(first->level_), K(merge_ways), K(sort_chunks_.get_size()),
-                K(get_memory_limit()), K(sql_mem_processor_.get_profile()));
     }
-
-    if (OB_SUCC(ret)) {
-      SortVecOpChunk *chunk = sort_chunks_.get_first();
-      for (int64_t i = 0; i < merge_ways && OB_SUCC(ret); i++) {
-        chunk->reset_row_iter();
-        if (OB_FAIL(chunk->init_row_iter())) {
-          SQL_ENG_LOG(WARN, "init iterator failed", K(ret));
-        } else if (OB_FAIL(chunk->get_next_row()) || nullptr == chunk->sk_row_) {
-          if (OB_ITER_END == ret || OB_SUCCESS == ret) {
-            ret = OB_ERR_UNEXPECTED;
-            SQL_ENG_LOG(WARN, "row store is not empty, iterate end is unexpected", K(ret),
-                        KP(chunk->sk_row_));
-          }
-          SQL_ENG_LOG(WARN, "get next row failed", K(ret));
-        } else if (OB_FAIL(ems_heap_->push(chunk))) {
-          SQL_ENG_LOG(WARN, "heap push failed", K(ret));
-        } else {
-          chunk = chunk->get_next();
+    chunk = sort_chunks_.get_first();
+    for (int64_t i = 0; i < merge_ways && OB_SUCC(ret); i++) {
+      if (OB_FAIL(chunk->get_next_row()) || nullptr == chunk->sk_row_) {
+        if (OB_ITER_END == ret || OB_SUCCESS == ret) {
+          ret = OB_ERR_UNEXPECTED;
+          SQL_ENG_LOG(WARN, "row store is not empty, iterate end is unexpected", K(ret),
+                      KP(chunk->sk_row_));
         }
+        SQL_ENG_LOG(WARN, "get next row failed", K(ret));
+      } else if (OB_FAIL(ems_tree_->push(chunk))) {
+        SQL_ENG_LOG(WARN, "loser tree push failed", K(ret));
+      } else {
+        chunk = chunk->get_next();
       }
     }
+    if (OB_SUCC(ret) && OB_FAIL(ems_tree_->build())) {
+      SQL_ENG_LOG(WARN, "build loser tree failed", K(ret));
+    }
   }
   if (OB_SUCC(ret)) {
     heap_iter_begin_ = false;
@@ -1840,21 +1860,36 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::heap_next(Heap &heap, const
 }
 
 template <typename Compare, typename Store_Row, bool has_addon>
-int ObSortVecOpImpl<Compare, Store_Row, has_addon>::ems_heap_next(SortVecOpChunk *&chunk)
+int ObSortVecOpImpl<Compare, Store_Row, has_addon>::ems_tree_next(SortVecOpChunk *&chunk)
 {
-  const auto f = [](SortVecOpChunk *&c, bool &is_end) {
-    int ret = OB_SUCCESS;
-    if (OB_FAIL(c->get_next_row())) {
-      if (OB_ITER_END == ret) {
-        is_end = true;
-        ret = OB_SUCCESS;
-      } else {
-        SQL_ENG_LOG(WARN, "get next row failed", K(ret));
+  int ret = OB_SUCCESS;
+  if (!is_inited()) {
+    ret = OB_NOT_INIT;
+    SQL_ENG_LOG(WARN, "not init", K(ret));
+  } else if (heap_iter_begin_) {
+    if (!ems_tree_->empty()) {
+      SortVecOpChunk *top = ems_tree_->top();
+      if (OB_FAIL(top->get_next_row())) {
+        if (OB_ITER_END != ret) {
+          SQL_ENG_LOG(WARN, "get next row failed", K(ret));
+        } else if (OB_FAIL(ems_tree_->pop())) {
+          SQL_ENG_LOG(WARN, "loser tree pop failed", K(ret));
+        }
+      } else if (OB_FAIL(ems_tree_->replace_top(top))) {
+        SQL_ENG_LOG(WARN, "loser tree replace failed", K(ret));
       }
     }
-    return ret;
-  };
-  return heap_next(*ems_heap_, f, chunk);
+  } else {
+    heap_iter_begin_ = true;
+  }
+  if (OB_SUCC(ret)) {
+    if (ems_tree_->empty()) {
+      ret = OB_ITER_END;
+    } else {
+      chunk = ems_tree_->top();
+    }
+  }
+  return ret;
 }
 
 template <typename Compare, typename Store_Row, bool has_addon>
@@ -1887,11 +1922,11 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::imms_heap_next_stored_row(co
 }
 
 template <typename Compare, typename Store_Row, bool has_addon>
-int ObSortVecOpImpl<Compare, Store_Row, has_addon>::ems_heap_next_stored_row(const Store_Row *&sr)
+int ObSortVecOpImpl<Compare, Store_Row, has_addon>::ems_tree_next_stored_row(const Store_Row *&sr)
 {
   int ret = OB_SUCCESS;
   SortVecOpChunk *chunk = nullptr;
-  if (OB_FAIL(ems_heap_next(chunk))) {
+  if (OB_FAIL(ems_tree_next(chunk))) {
     if (OB_ITER_END != ret) {
       SQL_ENG_LOG(WARN, "get next heap row failed", K(ret));
     }
@@ -1939,7 +1974,7 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::sort()
     // do merge sort
     int64_t ways = 0;
     while (OB_SUCC(ret)) {
-      if (OB_FAIL(build_ems_heap(ways))) {
+      if (OB_FAIL(build_ems_tree(ways))) {
         SQL_ENG_LOG(WARN, "build heap failed", K(ret));
       } else {
         // last merge round,
@@ -1949,7 +1984,7 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::sort()
         auto input = [&](const Store_Row *&sk_row, const Store_Row *&addon_row) {
           int ret = OB_SUCCESS;
           SortVecOpChunk *chunk = nullptr;
-          if (OB_FAIL(ems_heap_next(chunk))) {
+          if (OB_FAIL(ems_tree_next(chunk))) {
             if (OB_ITER_END != ret) {
               SQL_ENG_LOG(WARN, "get next heap row failed", K(ret));
             }
@@ -1964,7 +1999,11 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::sort()
           }
           return ret;
         };
-        const int64_t level = sort_chunks_.get_first()->level_ + 1;
+        SortVecOpChunk *last_merged = sort_chunks_.get_first();
+        for (int64_t i = 1; i < ways; i++) {
+          last_merged = last_merged->get_next();
+        }
+        const int64_t level = last_merged->level_ + 1;
         op_monitor_info_.otherstat_2_id_ = ObSqlMonitorStatIds::SORT_MERGE_SORT_ROUND;
         op_monitor_info_.otherstat_2_value_ = level;
         if (OB_FAIL(build_chunk(level, input))) {
@@ -1982,7 +2021,7 @@ int ObSortVecOpImpl<Compare, Store_Row, has_addon>::sort()
 
     if (OB_SUCC(ret)) {
       set_blk_holder(&blk_holder_);
-      next_stored_row_func_ = &ObSortVecOpImpl::ems_heap_next_stored_row;
+      next_stored_row_func_ = &ObSortVecOpImpl::ems_tree_next_stored_row;
     }
   }
   return ret;
@@ -0,0 +1,186 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_SORT_SORT_VEC_OP_LOSER_TREE_H_
+#define OCEANBASE_SQL_ENGINE_SORT_SORT_VEC_OP_LOSER_TREE_H_
+
+#include "lib/allocator/ob_allocator.h"
+
+namespace oceanbase {
+namespace sql {
+
+// Tree of losers for external merge sort.
+//
+// The players are pointers (sort chunks), NULL player means the chunk is exhausted and always
+// loses. Compare has the same semantic with the one of ObBinaryHeap:
+// cmp(l, r) returns true if r should be output before l.
+//
+// For k players, the leaves are nodes [k, 2k) and the internal nodes [1, k) keep the loser of
+// the match, node 0 keeps the champion. Replacing the champion only replays the matches on the
+// path from its leaf to the root, which is log(k) comparisons, while sift down of binary heap
+// needs 2 * log(k).
+template <typename Item, typename Compare>
+class ObSortVecOpLoserTree
+{
+public:
+  ObSortVecOpLoserTree(Compare &cmp, common::ObIAllocator *allocator)
+    : cmp_(cmp), allocator_(allocator), max_player_cnt_(0), player_cnt_(0),
+      players_(nullptr), nodes_(nullptr), winners_(nullptr)
+  {}
+  ~ObSortVecOpLoserTree() { reset(); }
+
+  int init(const int64_t max_player_cnt)
+  {
+    int ret = common::OB_SUCCESS;
+    if (OB_ISNULL(allocator_) || OB_UNLIKELY(max_player_cnt <= 0)) {
+      ret = common::OB_INVALID_ARGUMENT;
+      SQL_ENG_LOG(WARN, "invalid argument", K(ret), KP(allocator_), K(max_player_cnt));
+    } else if (max_player_cnt <= max_player_cnt_) {
+      reuse();
+    } else {
+      reset();
+      if (OB_ISNULL(players_ = static_cast<Item *>(
+                      allocator_->alloc(sizeof(Item) * max_player_cnt)))
+          || OB_ISNULL(nodes_ = static_cast<int64_t *>(
+                         allocator_->alloc(sizeof(int64_t) * max_player_cnt)))
+          || OB_ISNULL(winners_ = static_cast<int64_t *>(
+                         allocator_->alloc(sizeof(int64_t) * max_player_cnt * 2)))) {
+        ret = common::OB_ALLOCATE_MEMORY_FAILED;
+        SQL_ENG_LOG(WARN, "allocate memory failed", K(ret), K(max_player_cnt));
+        reset();
+      } else {
+        max_player_cnt_ = max_player_cnt;
+        player_cnt_ = 0;
+      }
+    }
+    return ret;
+  }
+
+  void reuse() { player_cnt_ = 0; }
+
+  void reset()
+  {
+    if (nullptr != allocator_) {
+      if (nullptr != players_) {
+        allocator_->free(players_);
+      }
+      if (nullptr != nodes_) {
+        allocator_->free(nodes_);
+      }
+      if (nullptr != winners_) {
+        allocator_->free(winners_);
+      }
+    }
+    players_ = nullptr;
+    nodes_ = nullptr;
+    winners_ = nullptr;
+    max_player_cnt_ = 0;
+    player_cnt_ = 0;
+  }
+
+  int push(Item player)
+  {
+    int ret = common::OB_SUCCESS;
+    if (OB_UNLIKELY(player_cnt_ >= max_player_cnt_)) {
+      ret = common::OB_SIZE_OVERFLOW;
+      SQL_ENG_LOG(WARN, "too many players", K(ret), K(player_cnt_), K(max_player_cnt_));
+    } else {
+      players_[player_cnt_++] = player;
+    }
+    return ret;
+  }
+
+  // play all the matches after players are pushed.
+  int build()
+  {
+    int ret = common::OB_SUCCESS;
+    if (player_cnt_ > 0) {
+      const int64_t k = player_cnt_;
+      for (int64_t i = 0; i < k; i++) {
+        winners_[k + i] = i;
+      }
+      for (int64_t n = k - 1; n > 0; n--) {
+        const int64_t l = winners_[2 * n];
+        const int64_t r = winners_[2 * n + 1];
+        if (beat(l, r)) {
+          winners_[n] = l;
+          nodes_[n] = r;
+        } else {
+          winners_[n] = r;
+          nodes_[n] = l;
+        }
+      }
+      nodes_[0] = k > 1 ? winners_[1] : 0;
+      ret = cmp_.get_error_code();
+    }
+    return ret;
+  }
+
+  bool empty() const { return 0 == player_cnt_ || nullptr == players_[nodes_[0]]; }
+  Item top() const { return players_[nodes_[0]]; }
+
+  // the champion moves to its next row, replay its path.
+  int replace_top(Item player)
+  {
+    players_[nodes_[0]] = player;
+    return replay(nodes_[0]);
+  }
+
+  // the champion is exhausted
+  int pop() { return replace_top(nullptr); }
+
+private:
+  OB_INLINE bool beat(const int64_t l, const int64_t r)
+  {
+    bool res = false;
+    if (nullptr == players_[r]) {
+      res = true;
+    } else if (nullptr == players_[l]) {
+      res = false;
+    } else {
+      res = cmp_(players_[r], players_[l]);
+    }
+    return res;
+  }
+
+  int replay(const int64_t player)
+  {
+    int64_t winner = player;
+    for (int64_t n = (player + player_cnt_) / 2; n > 0; n /= 2) {
+      if (beat(nodes_[n], winner)) {
+        const int64_t tmp = nodes_[n];
+        nodes_[n] = winner;
+        winner = tmp;
+      }
+    }
+    nodes_[0] = winner;
+    return cmp_.get_error_code();
+  }
+
+private:
+  Compare &cmp_;
+  common::ObIAllocator *allocator_;
+  int64_t max_player_cnt_;
+  int64_t player_cnt_;
+  Item *players_;
+  // nodes_[0] is the champion, nodes_[1, player_cnt_) are the losers of matches.
+  int64_t *nodes_;
+  // winners of matches, only used in build()
+  int64_t *winners_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObSortVecOpLoserTree);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif /* OCEANBASE_SQL_ENGINE_SORT_SORT_VEC_OP_LOSER_TREE_H_ */
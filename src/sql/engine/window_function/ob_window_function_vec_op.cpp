@@ -2187,6 +2187,7 @@ int ObWindowFunctionVecOp::compute_wf_values(WinFuncColExpr *end, int64_t &check
       winfunc::AggrExpr *agg_expr = static_cast<winfunc::AggrExpr *>(it->wf_expr_);
       agg_expr->last_valid_frame_.reset();
       agg_expr->last_aggr_row_ = nullptr;
+      agg_expr->seg_tree_.reset();
     }
     while (OB_SUCC(ret) && total_size > 0) {
       clear_evaluated_flag();
@@ -3318,7 +3319,9 @@ bool ObWindowFunctionVecOp::all_supported_winfuncs(const ObIArray<ObWinFunRawExp
   for (int i = 0; ret && i < win_exprs.count(); i++) {
     ObWinFunRawExpr *win_expr = win_exprs.at(i);
     if (win_expr->get_agg_expr() != nullptr) {
+      // aggregates on all rows of group do not support removal of rows yet
       ret = aggregate::supported_aggregate_function(win_expr->get_func_type())
+            && !aggregate::is_ordered_aggregate_function(win_expr->get_func_type())
             && !win_expr->get_agg_expr()->is_param_distinct();
     }
   }
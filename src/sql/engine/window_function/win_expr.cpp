@@ -109,6 +109,16 @@ int WinExprWrapper<Derived>::process_partition(WinExprEvalCtx &ctx, const int64_
             if (OB_FAIL(copy_aggr_row(ctx, copied_row, agg_row))) {
               LOG_WARN("copy aggr row failed", K(ret));
             }
+          } else if (agg_expr->seg_tree_.is_built(part_start, part_end)
+                     || (whole_frame
+                         && agg_expr->need_seg_tree(ctx, prev_frame, cur_frame, part_start,
+                                                    part_end))) {
+            // once the segment tree is built, rest frames of partition are all evaluated with it,
+            // because removal info of incremental aggregation is not maintained any more.
+            if (OB_FAIL(agg_expr->seg_tree_process_window(ctx, cur_frame, part_start, part_end,
+                                                          row_idx, agg_row))) {
+              LOG_WARN("eval aggregate function with segment tree failed", K(ret));
+            }
           } else if (whole_frame) {
             ctx.win_col_.agg_ctx_->removal_info_.reset_for_new_frame();
             if (OB_FAIL(static_cast<Derived *>(this)->process_window(ctx, cur_frame, row_idx, agg_row, is_null))) {
@@ -1286,6 +1296,185 @@ void AggrExpr::destroy()
   if (aggr_processor_ != nullptr) {
     aggr_processor_->destroy();
   }
+  seg_tree_.reset();
+}
+
+bool AggrExpr::need_seg_tree(WinExprEvalCtx &ctx, const Frame &prev_frame,
+                             const Frame &cur_frame, const int64_t part_start,
+                             const int64_t part_end) const
+{
+  // restart caused by sliding frame, and frame is not the whole partition
+  return prev_frame.is_valid()
+         && cur_frame.tail_ - cur_frame.head_ >= AggrSegmentTree::MIN_FRAME_SIZE
+         && cur_frame.tail_ - cur_frame.head_ < part_end - part_start
+         && AggrSegmentTree::is_supported(ctx);
+}
+
+int AggrExpr::seg_tree_process_window(WinExprEvalCtx &ctx, const Frame &frame,
+                                      const int64_t part_start, const int64_t part_end,
+                                      const int64_t row_idx, char *agg_row)
+{
+  int ret = OB_SUCCESS;
+  int64_t extremum_idx = -1;
+  bool is_null = false;
+  if (!seg_tree_.is_built(part_start, part_end)
+      && OB_FAIL(seg_tree_.build(ctx, part_start, part_end))) {
+    LOG_WARN("build segment tree failed", K(ret), K(part_start), K(part_end));
+  } else if (OB_FAIL(seg_tree_.query(frame, extremum_idx))) {
+    LOG_WARN("query segment tree failed", K(ret), K(frame));
+  } else {
+    ctx.win_col_.agg_ctx_->removal_info_.reset_for_new_frame();
+    Frame extremum_frame(extremum_idx, extremum_idx + 1);
+    if (OB_FAIL(process_window(ctx, extremum_frame, row_idx, agg_row, is_null))) {
+      LOG_WARN("eval aggregate function failed", K(ret), K(extremum_frame));
+    }
+  }
+  return ret;
+}
+
+bool AggrSegmentTree::is_supported(WinExprEvalCtx &ctx)
+{
+  const ObWindowFunctionVecSpec &spec =
+    static_cast<const ObWindowFunctionVecSpec &>(ctx.win_col_.op_.get_spec());
+  const WinFuncInfo &wf_info = ctx.win_col_.wf_info_;
+  return (T_FUN_MIN == wf_info.func_type_ || T_FUN_MAX == wf_info.func_type_)
+         && 1 == wf_info.aggr_info_.param_exprs_.count()
+         && !wf_info.aggr_info_.has_distinct_
+         && !spec.is_push_down()
+         && !spec.single_part_parallel_;
+}
+
+int AggrSegmentTree::build(WinExprEvalCtx &ctx, const int64_t part_start, const int64_t part_end)
+{
+  int ret = OB_SUCCESS;
+  ObWindowFunctionVecOp &op = ctx.win_col_.op_;
+  ObEvalCtx &eval_ctx = op.get_eval_ctx();
+  ObEvalCtx::BatchInfoScopeGuard guard(eval_ctx);
+  const int64_t cnt = part_end - part_start;
+  reset();
+  if (OB_UNLIKELY(cnt <= 0 || !is_supported(ctx))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid partition for segment tree", K(ret), K(part_start), K(part_end));
+  } else if (OB_ISNULL(payloads_ = static_cast<const char **>(
+                         ctx.allocator_.alloc(sizeof(const char *) * cnt)))
+             || OB_ISNULL(lens_ = static_cast<int32_t *>(
+                            ctx.allocator_.alloc(sizeof(int32_t) * cnt)))
+             || OB_ISNULL(nodes_ = static_cast<int64_t *>(
+                            ctx.allocator_.alloc(sizeof(int64_t) * cnt * 2)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(cnt));
+  } else {
+    is_min_ = (T_FUN_MIN == ctx.win_col_.wf_info_.func_type_);
+    param_expr_ = ctx.win_col_.wf_info_.aggr_info_.param_exprs_.at(0);
+    ObBitVector &eval_skip = *op.get_batch_ctx().bound_eval_skip_;
+    ObBatchRows tmp_brs;
+    // evaluate params of partition rows batch by batch, values are copied because the
+    // attached rows are invalid after next `attach_rows`
+    for (int64_t start = part_start; OB_SUCC(ret) && start < part_end;) {
+      const int64_t batch_size = std::min(part_end - start, op.get_spec().max_batch_size_);
+      op.clear_evaluated_flag();
+      guard.set_batch_size(batch_size);
+      eval_skip.unset_all(0, batch_size);
+      tmp_brs.size_ = batch_size;
+      tmp_brs.end_ = false;
+      tmp_brs.skip_ = &eval_skip;
+      tmp_brs.all_rows_active_ = true;
+      if (OB_FAIL(ctx.input_rows_.attach_rows(op.get_all_expr(), op.get_input_row_meta(),
+                                              eval_ctx, start, start + batch_size, false))) {
+        LOG_WARN("attach rows failed", K(ret), K(start), K(batch_size));
+      } else if (OB_FAIL(param_expr_->eval_vector(eval_ctx, tmp_brs))) {
+        LOG_WARN("eval param failed", K(ret));
+      } else {
+        ObIVector *data = param_expr_->get_vector(eval_ctx);
+        for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; i++) {
+          const int64_t idx = start - part_start + i;
+          bool is_null = false;
+          const char *payload = nullptr;
+          common::ObLength len = 0;
+          data->get_payload(i, is_null, payload, len);
+          if (is_null) {
+            payloads_[idx] = nullptr;
+            lens_[idx] = -1;
+          } else if (len <= 0) {
+            payloads_[idx] = nullptr;
+            lens_[idx] = 0;
+          } else {
+            char *buf = static_cast<char *>(ctx.allocator_.alloc(len));
+            if (OB_ISNULL(buf)) {
+              ret = OB_ALLOCATE_MEMORY_FAILED;
+              LOG_WARN("allocate memory failed", K(ret), K(len));
+            } else {
+              MEMCPY(buf, payload, len);
+              payloads_[idx] = buf;
+              lens_[idx] = len;
+            }
+          }
+        }
+        start += batch_size;
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+      nodes_[cnt + i] = i;
+    }
+    for (int64_t i = cnt - 1; OB_SUCC(ret) && i > 0; i--) {
+      if (OB_FAIL(pick(nodes_[2 * i], nodes_[2 * i + 1], nodes_[i]))) {
+        LOG_WARN("pick extremum failed", K(ret));
+      }
+    }
+    if (OB_FAIL(ret)) {
+      reset();
+    } else {
+      part_start_ = part_start;
+      part_end_ = part_end;
+      LOG_TRACE("segment tree built", K(*this));
+    }
+  }
+  return ret;
+}
+
+int AggrSegmentTree::query(const Frame &frame, int64_t &row_idx) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = part_end_ - part_start_;
+  int64_t res = -1;
+  if (OB_ISNULL(nodes_)
+      || OB_UNLIKELY(frame.head_ < part_start_ || frame.tail_ > part_end_
+                     || frame.head_ >= frame.tail_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid frame for segment tree", K(ret), K(frame), K(*this));
+  } else {
+    // bottom-up query of range [l, r)
+    for (int64_t l = frame.head_ - part_start_ + cnt, r = frame.tail_ - part_start_ + cnt;
+         OB_SUCC(ret) && l < r; l >>= 1, r >>= 1) {
+      if ((l & 1) && OB_FAIL(pick(res, nodes_[l++], res))) {
+        LOG_WARN("pick extremum failed", K(ret));
+      } else if ((r & 1) && OB_FAIL(pick(res, nodes_[--r], res))) {
+        LOG_WARN("pick extremum failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      row_idx = (res < 0 ? frame.head_ : res + part_start_);
+    }
+  }
+  return ret;
+}
+
+int AggrSegmentTree::pick(const int64_t l, const int64_t r, int64_t &res) const
+{
+  int ret = OB_SUCCESS;
+  int cmp_ret = 0;
+  if (l < 0 || lens_[l] < 0) {
+    res = r;
+  } else if (r < 0 || lens_[r] < 0) {
+    res = l;
+  } else if (OB_FAIL(param_expr_->basic_funcs_->row_null_first_cmp_(
+               param_expr_->obj_meta_, param_expr_->obj_meta_, payloads_[l], lens_[l], false,
+               payloads_[r], lens_[r], false, cmp_ret))) {
+    LOG_WARN("compare failed", K(ret));
+  } else {
+    res = (is_min_ ? (cmp_ret <= 0 ? l : r) : (cmp_ret >= 0 ? l : r));
+  }
+  return ret;
 }
 
 int AggrExpr::collect_part_results(WinExprEvalCtx &ctx, const int64_t row_start,
@@ -295,10 +295,62 @@ public:
   virtual int generate_extra(ObIAllocator &allocator, void *&extra) override;
 };
 
+// Segment tree over the aggregate param of partition rows, used for MIN/MAX on sliding frames.
+//
+// MIN/MAX can not remove the extremum row from the aggregate result, once the extremum slides
+// out of the frame the aggregation restarts (see `Frame::need_restart_aggr`), which costs
+// O(n * frame_size) for the partition. The params of partition rows are evaluated once and
+// copied out of `RowStore`, leaves of the tree are the rows and every inner node keeps the
+// index of the extremum row of its range. The extremum row of a frame is found in O(log(n)),
+// then aggregating this single row gives the result of the frame.
+class AggrSegmentTree
+{
+public:
+  // build tree only if the aggregation restarts for frames not smaller than this
+  static const int64_t MIN_FRAME_SIZE = 16;
+  AggrSegmentTree()
+    : part_start_(-1), part_end_(-1), is_min_(true), param_expr_(nullptr), payloads_(nullptr),
+      lens_(nullptr), nodes_(nullptr)
+  {}
+  static bool is_supported(WinExprEvalCtx &ctx);
+  int build(WinExprEvalCtx &ctx, const int64_t part_start, const int64_t part_end);
+  bool is_built(const int64_t part_start, const int64_t part_end) const
+  {
+    return nullptr != nodes_ && part_start_ == part_start && part_end_ == part_end;
+  }
+  // get extremum row of frame, returns any row of frame if all params are null.
+  int query(const Frame &frame, int64_t &row_idx) const;
+  // memory is allocated from `WinExprEvalCtx::allocator_`, which is freed after partition
+  void reset()
+  {
+    part_start_ = -1;
+    part_end_ = -1;
+    param_expr_ = nullptr;
+    payloads_ = nullptr;
+    lens_ = nullptr;
+    nodes_ = nullptr;
+  }
+  TO_STRING_KV(K_(part_start), K_(part_end), K_(is_min));
+
+private:
+  int pick(const int64_t l, const int64_t r, int64_t &res) const;
+
+private:
+  int64_t part_start_;
+  int64_t part_end_;
+  bool is_min_;
+  const ObExpr *param_expr_;
+  // param of rows, length -1 means null
+  const char **payloads_;
+  int32_t *lens_;
+  // nodes_[cnt, 2 * cnt) are leaves, [1, cnt) are extremum of children
+  int64_t *nodes_;
+};
+
 class AggrExpr final: public WinExprWrapper<AggrExpr>
 {
 public:
-  AggrExpr(): aggr_processor_(nullptr), last_valid_frame_(), last_aggr_row_(nullptr) {}
+  AggrExpr(): aggr_processor_(nullptr), last_valid_frame_(), last_aggr_row_(nullptr), seg_tree_() {}
   int process_window(WinExprEvalCtx &ctx, const Frame &frame, const int64_t row_idx,
                      char *res, bool &is_null) override;
 
@@ -314,6 +366,12 @@ public:
 
   static int set_result_for_invalid_frame(WinExprEvalCtx &ctx, char *agg_row);
 
+  // whether to evaluate the restarted frame with segment tree
+  bool need_seg_tree(WinExprEvalCtx &ctx, const Frame &prev_frame, const Frame &cur_frame,
+                     const int64_t part_start, const int64_t part_end) const;
+  int seg_tree_process_window(WinExprEvalCtx &ctx, const Frame &frame, const int64_t part_start,
+                              const int64_t part_end, const int64_t row_idx, char *agg_row);
+
   virtual void destroy() override;
 
 private:
@@ -328,6 +386,7 @@ public:
   Frame last_valid_frame_;
   aggregate::RemovalInfo last_removal_info_;
   char *last_aggr_row_;
+  AggrSegmentTree seg_tree_;
 };
 
 } // end winfunc
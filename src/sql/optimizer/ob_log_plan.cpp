@@ -5894,11 +5894,10 @@ int ObLogPlan::check_storage_groupby_pushdown(const ObIArray<ObAggFunRawExpr *>
   } else if (!is_only_full_group_by) {
     OPT_TRACE("not only full group by disable storage pushdwon");
   } else if (static_cast<const ObSelectStmt*>(stmt)->has_rollup() ||
-             group_exprs.count() > 1) {
+             group_exprs.count() > MAX_PUSHDOWN_GROUP_BY_COLUMN_CNT) {
     /*do nothing*/
   } else {
     const ObIArray<ObRawExpr *> &filters = stmt->get_condition_exprs();
-    ObRawExpr* groupby_column = NULL;
     can_push = true;
     if (static_cast<const ObSelectStmt*>(stmt)->is_scala_group_by()) {
       if (OB_FAIL(check_scalar_aggr_can_storage_pushdown(table_item->table_id_,
@@ -5912,24 +5911,34 @@ int ObLogPlan::check_storage_groupby_pushdown(const ObIArray<ObAggFunRawExpr *>
       }
     } else if (GET_MIN_CLUSTER_VERSION() < CLUSTER_VERSION_4_3_0_0) {
       can_push = false;
-    } else if (group_exprs.count() != 1) {
+    } else if (group_exprs.empty()) {
       can_push = false;
-    } else if (aggrs.count() > 5) {
+    } else if (group_exprs.count() > 1 && GET_MIN_CLUSTER_VERSION() < CLUSTER_VERSION_4_3_2_0) {
+      // storage of old version only groups by a single column
       can_push = false;
-    } else if (OB_ISNULL(groupby_column = group_exprs.at(0))) {
-      ret = OB_ERR_UNEXPECTED;
-      LOG_WARN("get unexpected null", K(ret));
-    } else if (!groupby_column->is_column_ref_expr() ||
-               table_item->table_id_ != static_cast<ObColumnRefRawExpr*>(groupby_column)->get_table_id()) {
+    } else if (aggrs.count() > 5) {
       can_push = false;
     } else if (OB_FAIL(check_normal_aggr_can_storage_pushdown(table_item->table_id_,
                                                               aggrs,
                                                               can_push))) {
       LOG_WARN("failed to check normal aggr can storage pushdown", K(ret));
-    } else if (!can_push) {
-      // do nothing
-    } else if (OB_FAIL(pushdown_groupby_columns.push_back(groupby_column))) {
-      LOG_WARN("failed to push back column", K(ret));
+    }
+    // the first column is the primary group by column in storage, the others are grouped
+    // together with it by the composite of dictionary codes
+    for (int64_t i = 0; OB_SUCC(ret) && can_push && i < group_exprs.count(); i++) {
+      ObRawExpr *groupby_column = group_exprs.at(i);
+      if (OB_ISNULL(groupby_column)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("get unexpected null", K(ret));
+      } else if (!groupby_column->is_column_ref_expr() ||
+                 table_item->table_id_ != static_cast<ObColumnRefRawExpr*>(groupby_column)->get_table_id()) {
+        can_push = false;
+      } else if (OB_FAIL(pushdown_groupby_columns.push_back(groupby_column))) {
+        LOG_WARN("failed to push back column", K(ret));
+      }
+    }
+    if (OB_SUCC(ret) && !can_push) {
+      pushdown_groupby_columns.reset();
     }
     /*do not push down when filters contain pl udf*/
     for (int64_t i = 0; OB_SUCC(ret) && can_push && i < filters.count(); i++) {
@@ -5976,38 +5985,56 @@ int ObLogPlan::check_table_columns_can_storage_pushdown(const uint64_t tenant_id
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("get unexpected null", K(ret));
   } else if (OB_FALSE_IT(column = static_cast<ObColumnRefRawExpr*>(pushdown_groupby_columns.at(0)))) {
-  } else if (!ObColumnStatParam::is_valid_opt_col_type(column->get_data_type())) {
-    can_push = false;
   } else if (NULL == (table_meta =
                      get_basic_table_metas().get_table_meta_by_table_id(column->get_table_id()))) {
     can_push = false;
   } else if (table_meta->get_version() <= 0) {
     can_push = false;
-  } else if (OB_ISNULL(column_meta = table_meta->get_column_meta(column->get_column_id()))) {
-    ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("column meta not find", K(ret), K(*table_meta), K(column));
   } else if (table_meta->get_micro_block_count() <= 0) {
     can_push = false;
+  } else {
+    can_push = true;
+    // the ndv of multiple group by columns is estimated as the product of their ndv
+    for (int64_t i = 0; OB_SUCC(ret) && can_push && i < pushdown_groupby_columns.count(); ++i) {
+      if (OB_ISNULL(pushdown_groupby_columns.at(i)) ||
+          OB_UNLIKELY(!pushdown_groupby_columns.at(i)->is_column_ref_expr())) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected group by column", K(ret), K(i));
+      } else if (OB_FALSE_IT(column = static_cast<ObColumnRefRawExpr*>(pushdown_groupby_columns.at(i)))) {
+      } else if (!ObColumnStatParam::is_valid_opt_col_type(column->get_data_type())) {
+        can_push = false;
+      } else if (OB_ISNULL(column_meta = table_meta->get_column_meta(column->get_column_id()))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("column meta not find", K(ret), K(*table_meta), K(column));
+      } else {
+        group_ndv = MIN(group_ndv * column_meta->get_ndv(), table_meta->get_rows());
+      }
+    }
+  }
+  if (OB_FAIL(ret) || !can_push) {
+    can_push = false;
   } else if (FALSE_IT(schema_guard = get_optimizer_context().get_schema_guard())) {
   } else if (OB_FAIL(schema_guard->get_table_schema(tenant_id, table_id, table_schema))) {
     LOG_WARN("get table schema failed", K(ret));
   } else {
+    can_push = false;
     double micro_block_avg_count = table_meta->get_rows() / table_meta->get_micro_block_count();
     // TODO it's better to use stat of column group in column store
     if (table_schema->is_column_store_supported()) {
       const int64_t column_cnt = table_schema->get_column_count();
       micro_block_avg_count *= (AVG_COLUMN_STORE_COLUMN_RATIO * column_cnt);
-      can_push = column_cnt >= COLUMN_STORE_WIDE_TABLE && column_meta->get_ndv() < MAX_NDV_RATIO * table_meta->get_rows();
+      can_push = column_cnt >= COLUMN_STORE_WIDE_TABLE && group_ndv < MAX_NDV_RATIO * table_meta->get_rows();
     }
     if (!can_push) {
-      can_push = (micro_block_avg_count * table_meta->get_rows()) > (MAX_MICRO_NDV_FACTOR * column_meta->get_ndv()) &&
-                 column_meta->get_ndv() < MAX_NDV_RATIO * table_meta->get_rows();
+      can_push = (micro_block_avg_count * table_meta->get_rows()) > (MAX_MICRO_NDV_FACTOR * group_ndv) &&
+                 group_ndv < MAX_NDV_RATIO * table_meta->get_rows();
     }
   }
   LOG_TRACE("check pushdown", K(ret), K(can_push),
       "total rows", table_meta ? table_meta->get_rows() : -1,
       "micro cnt", table_meta ? table_meta->get_micro_block_count() : -1,
-      "ndv", column_meta ? column_meta->get_ndv() : -1);
+      "column cnt", pushdown_groupby_columns.count(),
+      K(group_ndv));
   return ret;
 }
 
@@ -161,6 +161,8 @@ class ObLogPlan
 public:
   static const int64_t RELORDER_HASHBUCKET_SIZE = 256;
   static const int64_t JOINPATH_SET_HASHBUCKET_SIZE = 3000;
+  // group by columns are grouped together by the composite of dictionary codes in storage
+  static const int64_t MAX_PUSHDOWN_GROUP_BY_COLUMN_CNT = 4;
   friend class ::test::ObLogPlanTest_ob_explain_test_Test;
 
   typedef common::ObList<common::ObAddr, common::ObArenaAllocator> ObAddrList;
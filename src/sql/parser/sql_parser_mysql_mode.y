@@ -21628,6 +21628,10 @@ MIN_MAX
 {
   malloc_terminal_node($$, result->malloc_pool_, T_COL_SKIP_INDEX_SUM)
 }
+| BLOOM_FILTER
+{
+  malloc_terminal_node($$, result->malloc_pool_, T_COL_SKIP_INDEX_BLOOM_FILTER);
+}
 ;
 
 lob_chunk_size:
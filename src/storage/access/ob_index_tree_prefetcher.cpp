@@ -453,6 +453,7 @@ void ObIndexTreeMultiPrefetcher::reclaim()
 void ObIndexTreeMultiPrefetcher::inner_reset()
 {
   is_rowkey_sorted_ = false;
+  is_sorted_batch_get_ = false;
   fetch_rowkey_idx_ = 0;
   prefetch_rowkey_idx_ = 0;
   prefetched_rowkey_cnt_ = 0;
@@ -473,10 +474,10 @@ int ObIndexTreeMultiPrefetcher::init(
   } else if (OB_FAIL(init_basic_info(iter_type, sstable, iter_param, access_ctx))) {
     LOG_WARN("Fail to init basic info", K(ret));
   } else {
-    is_rowkey_sorted_ = access_ctx.query_flag_.is_ordered_scan() &&
-                        !access_ctx.query_flag_.is_reverse_scan() &&
+    is_rowkey_sorted_ = (is_sorted_batch_get_ ||
+                         (access_ctx.query_flag_.is_ordered_scan() && !access_ctx.query_flag_.is_reverse_scan())) &&
                         ObStoreRowIterator::IteratorMultiGet == iter_type_ &&
-                        !sstable.is_ddl_sstable();;
+                        !sstable.is_ddl_sstable();
     ext_read_handles_.set_allocator(long_life_allocator_);
     rowkeys_ = static_cast<const common::ObIArray<blocksstable::ObDatumRowkey> *> (query_range);
     const int32_t range_count = rowkeys_->count();
@@ -519,8 +520,8 @@ int ObIndexTreeMultiPrefetcher::switch_context(
   } else if (OB_FAIL(init_basic_info(iter_type, sstable, iter_param, access_ctx))) {
     LOG_WARN("Fail to init basic info", K(ret));
   } else {
-    is_rowkey_sorted_ = access_ctx.query_flag_.is_ordered_scan() &&
-                        !access_ctx.query_flag_.is_reverse_scan() &&
+    is_rowkey_sorted_ = (is_sorted_batch_get_ ||
+                         (access_ctx.query_flag_.is_ordered_scan() && !access_ctx.query_flag_.is_reverse_scan())) &&
                         ObStoreRowIterator::IteratorMultiGet == iter_type_ &&
                         !sstable.is_ddl_sstable();
     rowkeys_ = static_cast<const common::ObIArray<blocksstable::ObDatumRowkey> *> (query_range);
@@ -796,6 +797,7 @@ void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::
   multi_io_params_.reset();
   max_range_prefetching_cnt_ = 0;
   max_micro_handle_cnt_ = 0;
+  max_data_prefetch_depth_ = DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
   ObIndexTreePrefetcher::reset();
 }
 
@@ -808,6 +810,7 @@ void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::
   clean_blockscan_check_info();
   inner_reset();
   multi_io_params_.reuse();
+  // max_data_prefetch_depth_ is not reset, the adaptive window is kept when reused by rescan
   ObIndexTreePrefetcher::reuse();
 }
 
@@ -845,6 +848,7 @@ void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::
   row_lock_check_version_ = transaction::ObTransVersion::INVALID_TRANS_VERSION;
   agg_row_store_ = nullptr;
   prefetch_depth_ = 1;
+  data_ready_cnt_ = 0;
   total_micro_data_cnt_ = 0;
   query_range_ = nullptr;
   border_rowkey_.reset();
@@ -888,7 +892,7 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::g
 {
   int ret = OB_SUCCESS;
   depth = 0;
-  prefetch_depth_ = MIN(2 * prefetch_depth_, DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT);
+  prefetch_depth_ = MIN(2 * prefetch_depth_, max_data_prefetch_depth_);
   if (need_check_prefetch_depth_) {
     int64_t prefetch_micro_cnt = MAX(1,
                                      (access_ctx_->limit_param_->offset_ + access_ctx_->limit_param_->limit_ - access_ctx_->out_cnt_ + \
@@ -1099,6 +1103,32 @@ void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::
 {
   current_micro_handle().reset();
   ++cur_micro_data_fetch_idx_;
+  if (cur_micro_data_fetch_idx_ < micro_data_prefetch_idx_) {
+    adjust_data_prefetch_depth();
+  }
+}
+
+template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
+void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::adjust_data_prefetch_depth()
+{
+  const int16_t max_depth = DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  const int16_t min_adaptive_depth = MIN_ADAPTIVE_DATA_PREFETCH_DEPTH;
+  const int16_t min_depth = MIN(min_adaptive_depth, max_depth);
+  const ObMicroBlockDataHandle &micro_handle = current_micro_handle();
+  if (ObSSTableMicroBlockState::IN_BLOCK_IO == micro_handle.block_state_
+      && !micro_handle.io_handle_.is_finished()) {
+    // io is slower than consumer, multiplicative increase
+    max_data_prefetch_depth_ = MIN(2 * max_data_prefetch_depth_, max_depth);
+    data_ready_cnt_ = 0;
+  } else if (access_ctx_->micro_block_handle_mgr_.reach_hold_limit()) {
+    max_data_prefetch_depth_ = MAX(max_data_prefetch_depth_ / 2, min_depth);
+    data_ready_cnt_ = 0;
+  } else if (++data_ready_cnt_ >= max_data_prefetch_depth_) {
+    // a whole window is ready before read, additive decrease
+    max_data_prefetch_depth_ = MAX(max_data_prefetch_depth_ - 1, min_depth);
+    data_ready_cnt_ = 0;
+  }
+  prefetch_depth_ = MIN(prefetch_depth_, max_data_prefetch_depth_);
 }
 
 /*
@@ -1260,6 +1290,8 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::p
   } else if (OB_FAIL(get_prefetch_depth(prefetch_depth))) {
     LOG_WARN("Fail to get prefetch depth", K(ret));
   } else {
+    EVENT_INC(ObStatEventIds::DATA_PREFETCH_ROUND_CNT);
+    EVENT_ADD(ObStatEventIds::DATA_PREFETCH_DEPTH, prefetch_depth_);
     while (OB_SUCC(ret) && prefetched_cnt < prefetch_depth) {
       if (OB_FAIL(drill_down())) {
         if (OB_UNLIKELY(OB_ITER_END != ret)) {
@@ -313,6 +313,7 @@ public:
   typedef ObReallocatedFixedArray<ObSSTableReadHandleExt> ReadHandleExtArray;
   ObIndexTreeMultiPrefetcher() :
       is_rowkey_sorted_(false),
+      is_sorted_batch_get_(false),
       fetch_rowkey_idx_(0),
       prefetch_rowkey_idx_(0),
       prefetched_rowkey_cnt_(0),
@@ -337,6 +338,9 @@ public:
       ObTableAccessContext &access_ctx,
       const void *query_range) override;
   int multi_prefetch();
+  // The rowkeys of the next init/switch_context are sorted by the caller for batch get, use the
+  // sorted multi get path though the query is unordered.
+  OB_INLINE void set_sorted_batch_get(const bool is_sorted_batch_get) { is_sorted_batch_get_ = is_sorted_batch_get; }
   OB_INLINE bool is_prefetch_end() { return prefetched_rowkey_cnt_ >= rowkeys_->count(); }
   OB_INLINE void mark_cur_rowkey_prefetched(ObSSTableReadHandleExt &read_handle)
   {
@@ -352,8 +356,9 @@ public:
   OB_INLINE ObMicroBlockDataHandle &current_micro_handle()
   { return *ext_read_handles_[fetch_rowkey_idx_ % MAX_MULTIGET_MICRO_DATA_HANDLE_CNT].micro_handle_; }
   INHERIT_TO_STRING_KV("ObIndexTreePrefetcher", ObIndexTreePrefetcher, K_(index_tree_height), K_(is_rowkey_sorted),
-      K_(fetch_rowkey_idx), K_(prefetch_rowkey_idx), K_(prefetched_rowkey_cnt), K_(max_handle_prefetching_cnt));
+      K_(is_sorted_batch_get), K_(fetch_rowkey_idx), K_(prefetch_rowkey_idx), K_(prefetched_rowkey_cnt), K_(max_handle_prefetching_cnt));
   bool is_rowkey_sorted_;
+  bool is_sorted_batch_get_;
   int64_t fetch_rowkey_idx_;
   int64_t prefetch_rowkey_idx_;
   int64_t prefetched_rowkey_cnt_;
@@ -392,6 +397,8 @@ public:
       need_submit_io_(true),
       tree_handle_cap_(0),
       prefetch_depth_(1),
+      max_data_prefetch_depth_(DATA_PREFETCH_DEPTH),
+      data_ready_cnt_(0),
       max_range_prefetching_cnt_(0),
       max_micro_handle_cnt_(0),
       total_micro_data_cnt_(0),
@@ -489,6 +496,7 @@ public:
                        K_(is_prefetch_end), K_(cur_range_fetch_idx), K_(cur_range_prefetch_idx), K_(max_range_prefetching_cnt),
                        K_(cur_micro_data_fetch_idx), K_(micro_data_prefetch_idx), K_(max_micro_handle_cnt),
                        K_(iter_type), K_(cur_level), K_(index_tree_height), K_(max_rescan_height), KP_(long_life_allocator), K_(prefetch_depth),
+                       K_(max_data_prefetch_depth), K_(data_ready_cnt),
                        K_(total_micro_data_cnt), KP_(query_range), K_(tree_handle_cap),
                        K_(can_blockscan), K_(need_check_prefetch_depth), K_(use_multi_block_prefetch), K_(need_submit_io),
                        K(ObArrayWrap<ObIndexTreeLevelHandle>(tree_handles_, index_tree_height_)), K_(multi_io_params));
@@ -525,6 +533,10 @@ protected:
   void inner_reset();
   virtual int init_tree_handles(const int64_t count);
   int get_prefetch_depth(int64_t &depth);
+  // Adjust the data prefetch window by the state of the micro block to be read next:
+  // grow when its io is not finished (the scan stalls on io), shrink when the micro blocks are
+  // always ready before read (the consumer is cpu bound) or the held io buffers reach limit.
+  void adjust_data_prefetch_depth();
   int prefetch_data_block(
       const int64_t prefetch_idx,
       ObMicroIndexInfo &index_block_info,
@@ -535,6 +547,7 @@ protected:
   static const int32_t DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT = DATA_PREFETCH_DEPTH;
   static const int32_t INDEX_TREE_PREFETCH_DEPTH = INDEX_PREFETCH_DEPTH;
   static const int32_t SSTABLE_MICRO_AVG_COUNT = 100;
+  static const int32_t MIN_ADAPTIVE_DATA_PREFETCH_DEPTH = 2;
   struct ObIndexBlockReadHandle {
     ObIndexBlockReadHandle() :
         end_prefetched_row_idx_(-1),
@@ -708,6 +721,10 @@ protected:
   bool need_submit_io_;
   int16_t tree_handle_cap_;
   int16_t prefetch_depth_;
+  // upper bound of prefetch_depth_, adaptive in [MIN_ADAPTIVE_DATA_PREFETCH_DEPTH, DATA_PREFETCH_DEPTH]
+  int16_t max_data_prefetch_depth_;
+  // count of micro blocks ready before read since last adjustment
+  int16_t data_ready_cnt_;
   int32_t max_range_prefetching_cnt_;
   int32_t max_micro_handle_cnt_;
   int64_t total_micro_data_cnt_;
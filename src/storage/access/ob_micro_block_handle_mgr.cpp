@@ -14,6 +14,7 @@
 #include "storage/blocksstable/ob_micro_block_info.h"
 #include "storage/blocksstable/ob_storage_cache_suite.h"
 #include "share/cache/ob_kvcache_pointer_swizzle.h"
+#include "lib/stat/ob_diagnose_info.h"
 #include "ob_micro_block_handle_mgr.h"
 
 
@@ -39,7 +40,8 @@ ObMicroBlockDataHandle::ObMicroBlockDataHandle()
     handle_mgr_(nullptr),
     allocator_(nullptr),
     loaded_block_data_(),
-    is_loaded_block_(false)
+    is_loaded_block_(false),
+    shared_dict_handle_()
 {
   des_meta_.encrypt_key_ = encrypt_key_;
 }
@@ -77,6 +79,7 @@ void ObMicroBlockDataHandle::reset()
   io_handle_.reset();
   try_release_loaded_block();
   allocator_ = nullptr;
+  shared_dict_handle_.reset();
 }
 
 bool ObMicroBlockDataHandle::match(const blocksstable::MacroBlockId &macro_id,
@@ -128,6 +131,24 @@ int ObMicroBlockDataHandle::get_micro_block_data(
       }
     }
   }
+  if (OB_SUCC(ret) && is_data_block && OB_FAIL(attach_shared_dict(block_data))) {
+    LOG_WARN("Fail to attach shared dict", K(ret), K_(tenant_id), K_(macro_block_id), K_(micro_info));
+  }
+  return ret;
+}
+
+int ObMicroBlockDataHandle::attach_shared_dict(ObMicroBlockData &block_data)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockHeader *micro_header = block_data.get_micro_header();
+  if (nullptr == micro_header || !micro_header->has_shared_dict()) {
+    block_data.shared_dict_ = nullptr;
+  } else if (!shared_dict_handle_.is_valid() && OB_FAIL(ObStorageCacheSuite::get_instance().get_shared_dict_cache()
+      .get_or_load_shared_dict(tenant_id_, macro_block_id_, shared_dict_handle_))) {
+    LOG_WARN("Fail to get shared dict", K(ret), K_(tenant_id), K_(macro_block_id));
+  } else {
+    block_data.shared_dict_ = shared_dict_handle_.get_shared_dict();
+  }
   return ret;
 }
 
@@ -180,6 +201,7 @@ ObMicroBlockDataHandle & ObMicroBlockDataHandle::operator=(const ObMicroBlockDat
     allocator_ = other.allocator_;
     loaded_block_data_ = other.loaded_block_data_;
     is_loaded_block_ = other.is_loaded_block_;
+    shared_dict_handle_ = other.shared_dict_handle_;
   }
   return *this;
 }
@@ -197,8 +219,13 @@ int ObMicroBlockDataHandle::get_loaded_block_data(ObMicroBlockData &block_data)
       block_data = *pblock;
     }
   } else if (ObSSTableMicroBlockState::IN_BLOCK_IO == block_state_) {
+    // time waiting for the prefetched io, the prefetch window of scan is not deep enough
+    const int64_t stall_begin_time = io_handle_.is_finished() ? 0 : ObTimeUtility::current_time();
     if (OB_FAIL(io_handle_.wait())) {
       LOG_WARN("Fail to wait micro block io", K(ret));
+    } else if (0 != stall_begin_time
+               && FALSE_IT(EVENT_ADD(ObStatEventIds::MICRO_BLOCK_IO_STALL_TIME,
+                                     ObTimeUtility::current_time() - stall_begin_time))) {
     } else if (NULL == (io_buf = io_handle_.get_buffer())) {
       ret = OB_INVALID_IO_BUFFER;
       LOG_WARN("Fail to get block data, io may be failed", K(ret));
@@ -428,7 +455,8 @@ int ObMicroBlockHandleMgr::get_micro_block_handle(
     cache->cache_hit(table_store_stat_->block_cache_hit_cnt_);
     LOG_DEBUG("Access memory pointer successfully", K(tenant_id), K(macro_id), K(offset), KPC(ps_node),
                                                     K(micro_block_handle.cache_handle_), K(cur_level));
-  } else if (OB_FAIL(cache->get_cache_block(tenant_id, macro_id, offset, size, micro_block_handle.cache_handle_))) {
+  } else if (OB_FAIL(cache->get_cache_block(tenant_id, macro_id, offset, size, micro_block_handle.cache_handle_,
+                                            &micro_block_handle.des_meta_))) {
     // get data / index block cache from disk
     if (!need_submit_io) {
     } else if (cache_mem_ctrl_.need_sync_io(*query_flag_, micro_block_handle, cache, block_io_allocator_)) {
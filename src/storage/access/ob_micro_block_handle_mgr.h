@@ -18,6 +18,7 @@
 #include "storage/blocksstable/ob_imicro_block_reader.h"
 #include "storage/blocksstable/ob_macro_block_reader.h"
 #include "storage/blocksstable/ob_micro_block_cache.h"
+#include "storage/blocksstable/ob_shared_dict_cache.h"
 #include "storage/blocksstable/index_block/ob_index_block_row_scanner.h"
 #include "storage/ob_handle_mgr.h"
 
@@ -80,6 +81,9 @@ struct ObMicroBlockDataHandle {
 private:
   int get_loaded_block_data(blocksstable::ObMicroBlockData &block_data);
   void try_release_loaded_block();
+  int attach_shared_dict(blocksstable::ObMicroBlockData &block_data);
+  // shared dict of the macro block, held while the micro block data is in use
+  blocksstable::ObSharedDictValueHandle shared_dict_handle_;
 };
 
 class ObCacheMemController final
@@ -3090,6 +3090,7 @@ int ObSumAggCell::collect_result_to_decimal_int(
 ObFirstRowAggCell::ObFirstRowAggCell(const ObAggCellBasicInfo &basic_info, common::ObIAllocator &allocator)
     : ObAggCell(basic_info, allocator),
       is_determined_value_(false),
+      is_group_by_key_(false),
       aggregated_flag_cnt_(0),
       aggregated_flag_buf_(),
       datum_allocator_("ObStorageAgg", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID())
@@ -3100,6 +3101,7 @@ ObFirstRowAggCell::ObFirstRowAggCell(const ObAggCellBasicInfo &basic_info, commo
 void ObFirstRowAggCell::reset()
 {
   is_determined_value_ = false;
+  is_group_by_key_ = false;
   aggregated_flag_cnt_ = 0;
   free_group_by_buf(allocator_, aggregated_flag_buf_);
   if (nullptr != agg_datum_buf_) {
@@ -3444,6 +3446,12 @@ ObGroupByCell::ObGroupByCell(const int64_t batch_size, common::ObIAllocator &all
     agg_datum_buf_(nullptr),
     is_processing_(false),
     projected_cnt_(0),
+    group_by_keys_(),
+    cur_group_by_key_(nullptr),
+    first_distinct_cnt_(0),
+    group_key_buf_(nullptr),
+    key_datum_buf_(nullptr),
+    group_ids_buf_(nullptr),
     agg_cell_factory_(allocator),
     padding_allocator_("PDGroupByPad", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID()),
     allocator_(allocator)
@@ -3476,6 +3484,7 @@ void ObGroupByCell::reset()
   padding_allocator_.reset();
   is_processing_ = false;
   projected_cnt_ = 0;
+  reset_group_by_keys();
 }
 
 void ObGroupByCell::reuse()
@@ -3492,6 +3501,38 @@ void ObGroupByCell::reuse()
   padding_allocator_.reuse();
   is_processing_ = false;
   projected_cnt_ = 0;
+  cur_group_by_key_ = nullptr;
+  first_distinct_cnt_ = 0;
+}
+
+void ObGroupByCell::reset_group_by_keys()
+{
+  for (int64_t i = 0; i < group_by_keys_.count(); ++i) {
+    ObGroupByKey &group_by_key = group_by_keys_.at(i);
+    free_group_by_buf(allocator_, group_by_key.dict_datum_buf_);
+    if (nullptr != group_by_key.agg_datum_buf_) {
+      group_by_key.agg_datum_buf_->reset();
+      allocator_.free(group_by_key.agg_datum_buf_);
+      group_by_key.agg_datum_buf_ = nullptr;
+    }
+    if (nullptr != group_by_key.refs_buf_) {
+      allocator_.free(group_by_key.refs_buf_);
+      group_by_key.refs_buf_ = nullptr;
+    }
+  }
+  group_by_keys_.reset();
+  cur_group_by_key_ = nullptr;
+  first_distinct_cnt_ = 0;
+  free_group_by_buf(allocator_, group_key_buf_);
+  if (nullptr != key_datum_buf_) {
+    key_datum_buf_->reset();
+    allocator_.free(key_datum_buf_);
+    key_datum_buf_ = nullptr;
+  }
+  if (nullptr != group_ids_buf_) {
+    allocator_.free(group_ids_buf_);
+    group_ids_buf_ = nullptr;
+  }
 }
 
 int ObGroupByCell::init(const ObTableAccessParam &param, const ObTableAccessContext &context, sql::ObEvalCtx &eval_ctx)
@@ -3556,11 +3597,65 @@ int ObGroupByCell::init(const ObTableAccessParam &param, const ObTableAccessCont
         refs_buf_ = reinterpret_cast<uint32_t*>(buf);
       }
     }
+    if (OB_SUCC(ret) && param.iter_param_.group_by_cols_project_->count() > 1 &&
+        OB_FAIL(init_group_by_keys(param))) {
+      LOG_WARN("Failed to init group by keys", K(ret));
+    }
   }
   LOG_DEBUG("[GROUP BY PUSHDOWN]", K(ret), KPC(this));
   return ret;
 }
 
+int ObGroupByCell::init_group_by_keys(const ObTableAccessParam &param)
+{
+  int ret = OB_SUCCESS;
+  const common::ObIArray<int32_t> &group_by_cols_project = *param.iter_param_.group_by_cols_project_;
+  void *buf = nullptr;
+  for (int64_t i = 1; OB_SUCC(ret) && i < group_by_cols_project.count(); ++i) {
+    ObGroupByKey group_by_key;
+    group_by_key.col_offset_ = group_by_cols_project.at(i);
+    for (int64_t j = 0; j < agg_cells_.count(); ++j) {
+      ObAggCell *agg_cell = agg_cells_.at(j);
+      if (ObPDAggType::PD_FIRST_ROW == agg_cell->get_type() && group_by_key.col_offset_ == agg_cell->get_col_offset()) {
+        group_by_key.agg_idx_ = static_cast<int32_t>(j);
+        group_by_key.col_expr_ = agg_cell->get_agg_expr();
+        break;
+      }
+    }
+    if (OB_UNLIKELY(group_by_key.agg_idx_ < 0)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("Unexpected group by column, not output", K(ret), K(i), K(group_by_key), K(group_by_cols_project));
+    } else if (OB_FAIL(ObAggDatumBuf::new_agg_datum_buf(batch_size_, false, allocator_, group_by_key.agg_datum_buf_))) {
+      LOG_WARN("Failed to alloc agg datum buf", K(ret));
+    } else if (OB_FAIL(new_group_by_buf(group_by_key.agg_datum_buf_->get_datums(), batch_size_,
+        common::OBJ_DATUM_NUMBER_RES_SIZE, allocator_, group_by_key.dict_datum_buf_))) {
+      LOG_WARN("Failed to new buf", K(ret));
+    } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(uint32_t) * batch_size_))) {
+      ret = common::OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Failed to alloc memory", K(ret));
+    } else if (FALSE_IT(group_by_key.refs_buf_ = reinterpret_cast<uint32_t*>(buf))) {
+    } else if (OB_FAIL(group_by_keys_.push_back(group_by_key))) {
+      LOG_WARN("Failed to push back", K(ret));
+    } else {
+      static_cast<ObFirstRowAggCell*>(agg_cells_.at(group_by_key.agg_idx_))->set_group_by_key();
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(new_group_by_buf((uint32_t*)nullptr, 0, sizeof(uint32_t), allocator_, group_key_buf_))) {
+    LOG_WARN("Failed to new buf", K(ret));
+  } else if (OB_FAIL(group_key_buf_->reserve(batch_size_))) {
+    LOG_WARN("Failed to reserve buf", K(ret));
+  } else if (OB_FAIL(ObAggDatumBuf::new_agg_datum_buf(batch_size_, false, allocator_, key_datum_buf_))) {
+    LOG_WARN("Failed to alloc agg datum buf", K(ret));
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(uint32_t) * batch_size_))) {
+    ret = common::OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("Failed to alloc memory", K(ret));
+  } else {
+    group_ids_buf_ = reinterpret_cast<uint32_t*>(buf);
+  }
+  return ret;
+}
+
 int ObGroupByCell::init_for_single_row(const ObTableAccessParam &param, const ObTableAccessContext &context, sql::ObEvalCtx &eval_ctx)
 {
   int ret = OB_SUCCESS;
@@ -3656,13 +3751,15 @@ int ObGroupByCell::collect_result()
 int ObGroupByCell::add_distinct_null_value()
 {
   int ret = OB_SUCCESS;
-  if (distinct_cnt_ + 1 > group_by_col_datum_buf_->get_capacity()) {
+  int64_t &distinct_cnt = nullptr == cur_group_by_key_ ? distinct_cnt_ : cur_group_by_key_->distinct_cnt_;
+  const ObAggGroupByDatumBuf *datum_buf = nullptr == cur_group_by_key_ ? group_by_col_datum_buf_ : cur_group_by_key_->dict_datum_buf_;
+  if (distinct_cnt + 1 > datum_buf->get_capacity()) {
     ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("Unexpected distinct cnt", K(ret), K(distinct_cnt_), K(batch_size_), KPC(group_by_col_datum_buf_));
+    LOG_WARN("Unexpected distinct cnt", K(ret), K(distinct_cnt), K(batch_size_), KPC(datum_buf));
   } else {
     common::ObDatum *datums = get_group_by_col_datums_to_fill();
-    datums[distinct_cnt_].set_null();
-    distinct_cnt_++;
+    datums[distinct_cnt].set_null();
+    distinct_cnt++;
   }
   return ret;
 }
@@ -3705,6 +3802,9 @@ int ObGroupByCell::reserve_group_by_buf(const int64_t size)
       LOG_WARN("Failed to reserve buf", K(ret));
     }
   }
+  if (OB_SUCC(ret) && nullptr != group_key_buf_ && OB_FAIL(group_key_buf_->reserve(size))) {
+    LOG_WARN("Failed to reserve buf", K(ret));
+  }
   for (int64_t i = 0; OB_SUCC(ret) && i < agg_cells_.count(); ++i) {
     if (OB_FAIL(agg_cells_.at(i)->reserve_group_by_buf(size))) {
       LOG_WARN("Failed to prepare extra buf", K(ret), K(i), KPC(agg_cells_.at(i)));
@@ -3786,6 +3886,8 @@ int ObGroupByCell::extract_distinct()
   } else {
     common::ObDatum *group_by_col_datums = group_by_col_datum_buf_->get_group_by_datums();
     common::ObDatum *tmp_group_by_datums = tmp_group_by_datum_buf_->get_group_by_datums();
+    const bool has_keys = has_group_by_keys();
+    const int64_t start = distinct_cnt_;
     for (int64_t i = 0; OB_SUCC(ret) && i < ref_cnt_; ++i) {
       uint32_t &ref = refs_buf_[i];
       if (OB_UNLIKELY(ref >= group_by_col_datum_buf_->get_capacity())) {
@@ -3795,9 +3897,14 @@ int ObGroupByCell::extract_distinct()
         int16_t &distinct_projector = distinct_projector_buf_->at(ref);
         if (-1 == distinct_projector) {
           // distinct val is not extracted yet
-          if (OB_FAIL(group_by_col_datums[distinct_cnt_].from_storage_datum(tmp_group_by_datums[ref], group_by_col_expr_->obj_datum_map_))) {
-            LOG_WARN("Failed to clone datum", K(ret), K(tmp_group_by_datums[ref]), K(group_by_col_expr_->obj_datum_map_));
+          // the ref is group key if there are multiple group by columns
+          const uint32_t datum_idx = has_keys ? ref % first_distinct_cnt_ : ref;
+          if (OB_FAIL(group_by_col_datums[distinct_cnt_].from_storage_datum(tmp_group_by_datums[datum_idx], group_by_col_expr_->obj_datum_map_))) {
+            LOG_WARN("Failed to clone datum", K(ret), K(tmp_group_by_datums[datum_idx]), K(group_by_col_expr_->obj_datum_map_));
           } else {
+            if (has_keys) {
+              group_key_buf_->at(distinct_cnt_) = ref;
+            }
             distinct_projector = distinct_cnt_;
             ref = distinct_cnt_;
             distinct_cnt_++;
@@ -3809,11 +3916,150 @@ int ObGroupByCell::extract_distinct()
 
       }
     }
+    if (OB_SUCC(ret) && has_keys && distinct_cnt_ > start && OB_FAIL(fill_group_by_key_values(start))) {
+      LOG_WARN("Failed to fill group by key values", K(ret), K(start), K(distinct_cnt_));
+    }
     LOG_DEBUG("[GROUP BY PUSHDOWN]", K(ret), K(ref_cnt_), K(distinct_cnt_));
   }
   return ret;
 }
 
+void ObGroupByCell::switch_group_by_key(const int64_t key_idx)
+{
+  cur_group_by_key_ = key_idx < 0 ? nullptr : &group_by_keys_.at(key_idx);
+}
+
+int ObGroupByCell::set_group_by_key_distinct_cnt(const int64_t key_idx, const int64_t distinct_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(key_idx < 0 || key_idx >= group_by_keys_.count() || distinct_cnt < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), K(key_idx), K(distinct_cnt), K(group_by_keys_.count()));
+  } else {
+    ObGroupByKey &group_by_key = group_by_keys_.at(key_idx);
+    group_by_key.max_distinct_cnt_ = distinct_cnt;
+    // too many distinct values, can not use group by anyway
+    if (distinct_cnt < USE_GROUP_BY_MAX_DISTINCT_CNT &&
+        OB_FAIL(group_by_key.dict_datum_buf_->reserve(distinct_cnt + 1))) {
+      LOG_WARN("Failed to reserve buf", K(ret), K(distinct_cnt));
+    }
+  }
+  return ret;
+}
+
+int64_t ObGroupByCell::get_group_by_key_space(const int64_t distinct_cnt) const
+{
+  int64_t key_space = distinct_cnt;
+  if (has_group_by_keys()) {
+    // the null value is not included in distinct count
+    key_space = distinct_cnt + 1;
+    for (int64_t i = 0; i < group_by_keys_.count() && key_space < USE_GROUP_BY_MAX_DISTINCT_CNT; ++i) {
+      key_space *= (group_by_keys_.at(i).max_distinct_cnt_ + 1);
+    }
+    key_space = MIN(key_space, USE_GROUP_BY_MAX_DISTINCT_CNT);
+  }
+  return key_space;
+}
+
+int ObGroupByCell::prepare_group_by_keys()
+{
+  int ret = OB_SUCCESS;
+  int64_t stride = distinct_cnt_;
+  first_distinct_cnt_ = distinct_cnt_;
+  if (OB_UNLIKELY(nullptr == distinct_projector_buf_ || distinct_cnt_ <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected state", K(ret), KP_(distinct_projector_buf), K_(distinct_cnt));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < group_by_keys_.count(); ++i) {
+    ObGroupByKey &group_by_key = group_by_keys_.at(i);
+    if (OB_UNLIKELY(group_by_key.distinct_cnt_ <= 0 || group_by_key.distinct_cnt_ > group_by_key.max_distinct_cnt_ + 1)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("Unexpected distinct cnt of group by key", K(ret), K(i), K(group_by_key));
+    } else {
+      group_by_key.stride_ = stride;
+      stride *= group_by_key.distinct_cnt_;
+    }
+  }
+  if (OB_SUCC(ret) && OB_UNLIKELY(stride > distinct_projector_buf_->get_capacity())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected group key space", K(ret), K(stride), KPC_(distinct_projector_buf), K_(group_by_keys));
+  }
+  LOG_DEBUG("[GROUP BY PUSHDOWN]", K(ret), K_(first_distinct_cnt), K_(group_by_keys));
+  return ret;
+}
+
+int ObGroupByCell::combine_group_by_keys()
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < ref_cnt_; ++i) {
+    if (OB_UNLIKELY(refs_buf_[i] >= first_distinct_cnt_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("Unexpected ref", K(ret), K(i), K(refs_buf_[i]), K_(first_distinct_cnt));
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < group_by_keys_.count(); ++i) {
+    const ObGroupByKey &group_by_key = group_by_keys_.at(i);
+    if (group_by_key.distinct_cnt_ <= 1) {
+      // all refs are 0
+    } else if (OB_UNLIKELY(group_by_key.ref_cnt_ != ref_cnt_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("Unexpected ref cnt of group by key", K(ret), K(i), K_(ref_cnt), K(group_by_key));
+    } else {
+      const uint32_t stride = static_cast<uint32_t>(group_by_key.stride_);
+      const uint32_t distinct_cnt = static_cast<uint32_t>(group_by_key.distinct_cnt_);
+      const uint32_t *key_refs = group_by_key.refs_buf_;
+      for (int64_t j = 0; OB_SUCC(ret) && j < ref_cnt_; ++j) {
+        if (OB_UNLIKELY(key_refs[j] >= distinct_cnt)) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("Unexpected ref of group by key", K(ret), K(i), K(j), K(key_refs[j]), K(group_by_key));
+        } else {
+          refs_buf_[j] += key_refs[j] * stride;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int64_t ObGroupByCell::find_group_by_key(const sql::ObExpr *col_expr) const
+{
+  int64_t key_idx = -1;
+  for (int64_t i = 0; i < group_by_keys_.count(); ++i) {
+    if (col_expr == group_by_keys_.at(i).col_expr_) {
+      key_idx = i;
+      break;
+    }
+  }
+  return key_idx;
+}
+
+int ObGroupByCell::fill_group_by_key_values(const int64_t start)
+{
+  int ret = OB_SUCCESS;
+  common::ObDatum *key_datums = key_datum_buf_->get_datums();
+  for (int64_t offset = start; OB_SUCC(ret) && offset < distinct_cnt_; offset += batch_size_) {
+    const int64_t count = MIN(batch_size_, distinct_cnt_ - offset);
+    for (int64_t i = 0; i < count; ++i) {
+      group_ids_buf_[i] = static_cast<uint32_t>(offset + i);
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < group_by_keys_.count(); ++i) {
+      const ObGroupByKey &group_by_key = group_by_keys_.at(i);
+      const common::ObDatum *dict_datums = group_by_key.dict_datum_buf_->get_group_by_datums();
+      ObAggCell *agg_cell = agg_cells_.at(group_by_key.agg_idx_);
+      for (int64_t j = 0; j < count; ++j) {
+        const uint32_t code = (group_key_buf_->at(offset + j) / group_by_key.stride_) % group_by_key.distinct_cnt_;
+        key_datums[j] = dict_datums[code];
+      }
+      if (OB_FAIL(agg_cell->eval_batch_in_group_by(key_datums, count, group_ids_buf_, distinct_cnt_))) {
+        LOG_WARN("Failed to eval batch in group by", K(ret), K(i), K(group_by_key));
+      } else {
+        agg_cell->set_group_by_result_cnt(distinct_cnt_);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObGroupByCell::assign_agg_cells(const sql::ObExpr *col_expr, common::ObIArray<int32_t> &agg_idxs)
 {
   int ret = OB_SUCCESS;
@@ -3901,6 +4147,7 @@ int64_t ObGroupByCell::to_string(char *buf, const int64_t buf_len) const
        K_(ref_cnt),
        K_(is_processing),
        K_(projected_cnt),
+       K_(group_by_keys),
        KPC_(group_by_col_datum_buf));
   J_COMMA();
   J_KV(K(ObArrayWrap<uint32_t>(refs_buf_, ref_cnt_)));
@@ -690,7 +690,8 @@ public:
   virtual int collect_result(sql::ObEvalCtx &ctx) override;
   virtual int collect_batch_result_in_group_by(const int64_t distinct_cnt) override;
   virtual bool need_access_data() const override { return !finished(); }
-  virtual bool finished() const override { return aggregated_; }
+  // the values of secondary group by column are output from the dictionary by ObGroupByCell
+  virtual bool finished() const override { return aggregated_ || is_group_by_key_; }
   virtual int reserve_group_by_buf(const int64_t size) override;
   virtual int output_extra_group_by_result(const int64_t start, const int64_t count) override;
   virtual int can_use_index_info(const blocksstable::ObMicroIndexInfo &index_info,
@@ -702,11 +703,14 @@ public:
     result_datum_.set_null();
     aggregated_ = true;
   }
-  INHERIT_TO_STRING_KV("ObAggCell", ObAggCell, K_(is_determined_value), K_(aggregated_flag_cnt));
+  OB_INLINE void set_group_by_key() { is_group_by_key_ = true; }
+  OB_INLINE bool is_group_by_key() const { return is_group_by_key_; }
+  INHERIT_TO_STRING_KV("ObAggCell", ObAggCell, K_(is_determined_value), K_(is_group_by_key), K_(aggregated_flag_cnt));
 private:
-  virtual bool can_use_index_info() const override { return finished(); }
+  virtual bool can_use_index_info() const override { return aggregated_; }
   void clear_group_by_info();
   bool is_determined_value_;
+  bool is_group_by_key_;
   int64_t aggregated_flag_cnt_;
   ObGroupByExtendableBuf<bool> *aggregated_flag_buf_;
   common::ObArenaAllocator datum_allocator_;
@@ -770,30 +774,78 @@ public:
   // for column store, assign aggregate cells to column group scanner(ObCGGroupByScanner)
   int assign_agg_cells(const sql::ObExpr *col_expr, common::ObIArray<int32_t> &agg_idxs);
   int check_distinct_and_ref_valid();
+  // for multiple group by columns, the dictionary codes of the secondary group by columns(group by keys)
+  // are combined with the codes of the first group by column into one dense group key,
+  // key = ref_0 + ref_1 * distinct_cnt_0 + ref_2 * distinct_cnt_0 * distinct_cnt_1 + ...
+  // the values of the group by keys are translated from the group key once for each group.
+  //
+  // redirect the distinct values and references read by decoder to the group by key, -1 for the first one
+  void switch_group_by_key(const int64_t key_idx);
+  // set the max distinct count of group by key in current micro block, before deciding use group by
+  int set_group_by_key_distinct_cnt(const int64_t key_idx, const int64_t distinct_cnt);
+  // the count of all possible group keys, the product of the distinct count of all group by columns
+  int64_t get_group_by_key_space(const int64_t distinct_cnt) const;
+  // calc strides of group by keys after read distinct values of all group by columns
+  int prepare_group_by_keys();
+  // combine the references of group by keys into 'refs_buf_'
+  int combine_group_by_keys();
+  int64_t find_group_by_key(const sql::ObExpr *col_expr) const;
+  OB_INLINE int64_t get_group_by_key_cnt() const { return group_by_keys_.count(); }
+  OB_INLINE bool has_group_by_keys() const { return group_by_keys_.count() > 0; }
+  OB_INLINE int32_t get_group_by_key_col_offset(const int64_t key_idx) const { return group_by_keys_.at(key_idx).col_offset_; }
+  // the references need not to be read if there is only one distinct value
+  OB_INLINE bool need_read_key_reference(const int64_t key_idx) const { return group_by_keys_.at(key_idx).distinct_cnt_ > 1; }
   OB_INLINE int64_t get_batch_size() const { return batch_size_; }
   OB_INLINE int32_t get_group_by_col_offset() const { return group_by_col_offset_; }
-  OB_INLINE ObObjDatumMapType get_obj_datum_map_type() const {return group_by_col_expr_->obj_datum_map_; }
+  OB_INLINE ObObjDatumMapType get_obj_datum_map_type() const
+  { return nullptr == cur_group_by_key_ ? group_by_col_expr_->obj_datum_map_ : cur_group_by_key_->col_expr_->obj_datum_map_; }
   OB_INLINE bool is_exceed_sql_batch() const { return group_by_col_datum_buf_->is_use_extra_buf(); }
   OB_INLINE common::ObDatum *get_group_by_col_datums_to_fill()
-  { return need_extract_distinct_ ? tmp_group_by_datum_buf_->get_group_by_datums() : group_by_col_datum_buf_->get_group_by_datums(); }
+  {
+    return nullptr != cur_group_by_key_ ? cur_group_by_key_->dict_datum_buf_->get_group_by_datums() :
+        need_extract_distinct_ ? tmp_group_by_datum_buf_->get_group_by_datums() : group_by_col_datum_buf_->get_group_by_datums();
+  }
   OB_INLINE const char **get_cell_datas()
-  { return need_extract_distinct_ ? tmp_group_by_datum_buf_->get_group_by_cell_datas() : group_by_col_datum_buf_->get_group_by_cell_datas(); }
+  {
+    return nullptr != cur_group_by_key_ ? cur_group_by_key_->dict_datum_buf_->get_group_by_cell_datas() :
+        need_extract_distinct_ ? tmp_group_by_datum_buf_->get_group_by_cell_datas() : group_by_col_datum_buf_->get_group_by_cell_datas();
+  }
   OB_INLINE common::ObDatum *get_group_by_col_datums() const { return group_by_col_datum_buf_->get_group_by_datums(); }
   OB_INLINE common::ObIArray<ObAggCell*> &get_agg_cells() { return agg_cells_; }
   OB_INLINE int64_t get_ref_cnt() const { return ref_cnt_; }
-  OB_INLINE void set_ref_cnt(const int64_t ref_cnt) { ref_cnt_ = ref_cnt; }
-  OB_INLINE uint32_t *get_refs_buf() { return refs_buf_; }
+  OB_INLINE void set_ref_cnt(const int64_t ref_cnt)
+  {
+    if (nullptr == cur_group_by_key_) {
+      ref_cnt_ = ref_cnt;
+    } else {
+      cur_group_by_key_->ref_cnt_ = ref_cnt;
+    }
+  }
+  OB_INLINE uint32_t *get_refs_buf() { return nullptr == cur_group_by_key_ ? refs_buf_ : cur_group_by_key_->refs_buf_; }
   OB_INLINE bool need_read_reference() const { return need_extract_distinct_ || agg_cells_.count() > 0; }
   OB_INLINE bool need_do_aggregate() const { return agg_cells_.count() > 0; }
   OB_INLINE int64_t get_distinct_cnt() const { return distinct_cnt_; }
-  OB_INLINE void set_distinct_cnt(const int64_t distinct_cnt) { distinct_cnt_ = distinct_cnt; }
+  OB_INLINE void set_distinct_cnt(const int64_t distinct_cnt)
+  {
+    if (nullptr == cur_group_by_key_) {
+      distinct_cnt_ = distinct_cnt;
+    } else {
+      cur_group_by_key_->distinct_cnt_ = distinct_cnt;
+    }
+  }
   OB_INLINE bool need_extract_distinct() const { return need_extract_distinct_; }
   OB_INLINE bool is_processing() const { return is_processing_; }
   OB_INLINE void set_is_processing(const bool is_processing) { is_processing_ = is_processing; }
   OB_INLINE void reset_projected_cnt() { projected_cnt_ = 0; }
   OB_INLINE void set_row_capacity(const int64_t row_capacity) { row_capacity_ = row_capacity; }
   template <typename T>
-  int decide_use_group_by(const int64_t row_cnt, const int64_t read_cnt, const int64_t distinct_cnt, const T *bitmap, bool &use_group_by)
+  int decide_use_group_by(
+      const int64_t row_cnt,
+      const int64_t read_cnt,
+      const int64_t distinct_cnt,
+      const T *bitmap,
+      bool &use_group_by,
+      const bool is_sparse_dict = false)
   {
     int ret = OB_SUCCESS;
     const bool is_valid_bitmap = nullptr != bitmap && !bitmap->is_all_true();
@@ -804,13 +856,17 @@ public:
                    (!is_valid_bitmap ||
                     bitmap->popcnt() * USE_GROUP_BY_FILTER_FACTOR > bitmap->size());
     if (use_group_by) {
-      if ((is_valid_bitmap || read_cnt < row_cnt) && OB_FAIL(prepare_tmp_group_by_buf())) {
+      // the group keys are always extracted to dense group ids, so are the refs of shared dict which
+      // may reference values not in the micro block
+      if ((is_sparse_dict || is_valid_bitmap || read_cnt < row_cnt || has_group_by_keys())
+          && OB_FAIL(prepare_tmp_group_by_buf())) {
         LOG_WARN("Failed to init extra info", K(ret));
       } else if (OB_FAIL(reserve_group_by_buf(distinct_cnt + 1))) {
         LOG_WARN("Failed to prepare group by datum buf", K(ret));
       }
     }
     LOG_TRACE("[GROUP BY PUSHDOWN]", K(ret), K(row_cnt), K(read_cnt), K(distinct_cnt), K(is_valid_bitmap), K(use_group_by),
+        K(is_sparse_dict),
         K_(batch_size), K_(row_capacity),
         "popcnt", is_valid_bitmap ? bitmap->popcnt() : 0,
         "size", is_valid_bitmap ? bitmap->size() : 0);
@@ -824,8 +880,34 @@ public:
       const bool init_output = true);
   DECLARE_TO_STRING;
 private:
+  struct ObGroupByKey
+  {
+    ObGroupByKey()
+      : col_offset_(-1), agg_idx_(-1), col_expr_(nullptr), agg_datum_buf_(nullptr), dict_datum_buf_(nullptr),
+        refs_buf_(nullptr), max_distinct_cnt_(0), distinct_cnt_(0), ref_cnt_(0), stride_(0)
+    {}
+    TO_STRING_KV(K_(col_offset), K_(agg_idx), KP_(col_expr), K_(max_distinct_cnt), K_(distinct_cnt),
+                 K_(ref_cnt), K_(stride), KPC_(dict_datum_buf));
+    int32_t col_offset_;
+    // the first row aggregate cell to output this column
+    int32_t agg_idx_;
+    const sql::ObExpr *col_expr_;
+    ObAggDatumBuf *agg_datum_buf_;
+    // distinct values in current micro block
+    ObAggGroupByDatumBuf *dict_datum_buf_;
+    uint32_t *refs_buf_;
+    int64_t max_distinct_cnt_;
+    int64_t distinct_cnt_;
+    int64_t ref_cnt_;
+    int64_t stride_;
+  };
+  int init_group_by_keys(const ObTableAccessParam &param);
+  void reset_group_by_keys();
+  // output values of group by keys for the groups in [start, distinct_cnt_)
+  int fill_group_by_key_values(const int64_t start);
   int init_agg_cells(const ObTableAccessParam &param, const ObTableAccessContext &context, sql::ObEvalCtx &eval_ctx, const bool is_for_single_row);
   static const int64_t DEFAULT_AGG_CELL_CNT = 2;
+  static const int64_t DEFAULT_GROUP_BY_KEY_CNT = 2;
   static const int64_t USE_GROUP_BY_READ_CNT_FACTOR = 2;
   static constexpr double USE_GROUP_BY_DISTINCT_RATIO = 0.5;
   static const int64_t USE_GROUP_BY_FILTER_FACTOR = 2;
@@ -850,6 +932,14 @@ private:
   ObAggDatumBuf *agg_datum_buf_;
   bool is_processing_;
   int64_t projected_cnt_;
+  // for multiple group by columns
+  common::ObSEArray<ObGroupByKey, DEFAULT_GROUP_BY_KEY_CNT> group_by_keys_;
+  ObGroupByKey *cur_group_by_key_;
+  int64_t first_distinct_cnt_;
+  // group key of each group
+  ObGroupByExtendableBuf<uint32_t> *group_key_buf_;
+  ObAggDatumBuf *key_datum_buf_;
+  uint32_t *group_ids_buf_;
   ObPDAggFactory agg_cell_factory_;
   common::ObArenaAllocator padding_allocator_;
   common::ObIAllocator &allocator_;
@@ -116,6 +116,8 @@ int ObSSTableIndexFilter::is_filtered_by_skipping_index(
   } else if (index_info.apply_skipping_filter_result(node.filter_)) {
     // There is no need to check skipping index because filter result is contant already.
     node.is_already_determinate_ = true;
+  } else if (node.filter_->is_filter_constant()) {
+    // Filter result is determined by the previous skipping index of the same filter.
   } else {
     const uint32_t col_offset = node.filter_->get_col_offsets(is_cg_).at(0);
     const uint32_t col_idx = static_cast<uint32_t>(read_info->get_columns_index().at(col_offset));
@@ -204,8 +206,11 @@ int ObSSTableIndexFilter::find_skipping_index(
       LOG_WARN("Unexpected column meta", K(column_id), K(index), KPC(read_info));
     } else {
       const bool has_min_max = column_extend->at(index).skip_index_attr_.has_min_max();
+      const bool has_bloom_filter = column_extend->at(index).skip_index_attr_.has_bloom_filter();
       if (has_min_max && OB_FAIL(index_list.push_back(blocksstable::ObSkipIndexType::MIN_MAX))) {
         LOG_WARN("Fail to push back skip index type", K(ret));
+      } else if (has_bloom_filter && OB_FAIL(index_list.push_back(blocksstable::ObSkipIndexType::BLOOM_FILTER))) {
+        LOG_WARN("Fail to push back skip index type", K(ret));
       }
     }
   }
@@ -286,6 +291,16 @@ int ObSSTableIndexFilterExtracter::extract_skipping_filter(
     case blocksstable::ObSkipIndexType::MIN_MAX:
       node.skip_index_type_ = blocksstable::ObSkipIndexType::MIN_MAX;
       break;
+    case blocksstable::ObSkipIndexType::BLOOM_FILTER:
+      // Bloom filter only falsifies equal and in filter.
+      if (filter.is_filter_white_node()) {
+        const sql::ObWhiteFilterOperatorType op_type =
+            static_cast<const sql::ObWhiteFilterExecutor &>(filter).get_op_type();
+        if (sql::WHITE_OP_EQ == op_type || sql::WHITE_OP_IN == op_type) {
+          node.skip_index_type_ = blocksstable::ObSkipIndexType::BLOOM_FILTER;
+        }
+      }
+      break;
     default:
       // There are more skipping index types in the future.
       ret = OB_ERR_UNEXPECTED;
@@ -21,12 +21,14 @@ ObSSTableRowMultiGetter::~ObSSTableRowMultiGetter()
 {
   FREE_ITER_FROM_ALLOCATOR(long_life_allocator_, micro_getter_, ObMicroBlockRowGetter);
   FREE_ITER_FROM_ALLOCATOR(long_life_allocator_, macro_block_reader_, ObMacroBlockReader);
+  reset_sorted_batch();
 }
 
 void ObSSTableRowMultiGetter::reset()
 {
   FREE_ITER_FROM_ALLOCATOR(long_life_allocator_, micro_getter_, ObMicroBlockRowGetter);
   FREE_ITER_FROM_ALLOCATOR(long_life_allocator_, macro_block_reader_, ObMacroBlockReader);
+  reset_sorted_batch();
   is_opened_ = false;
   iter_param_ = nullptr;
   access_ctx_ = nullptr;
@@ -39,17 +41,42 @@ void ObSSTableRowMultiGetter::reuse()
   ObStoreRowIterator::reuse();
   is_opened_ = false;
   sstable_ = nullptr;
+  reuse_sorted_batch();
   prefetcher_.reuse();
 }
 
 void ObSSTableRowMultiGetter::reclaim()
 {
   is_opened_ = false;
+  reset_sorted_batch();
   prefetcher_.reclaim();
   ObStoreRowIterator::reset();
   is_reclaimed_ = true;
 }
 
+void ObSSTableRowMultiGetter::reuse_sorted_batch()
+{
+  for (int64_t i = 0; i < batch_rows_.count(); ++i) {
+    if (nullptr != batch_rows_.at(i)) {
+      batch_rows_.at(i)->~ObDatumRow();
+      batch_rows_.at(i) = nullptr;
+    }
+  }
+  batch_row_allocator_.reuse();
+  is_sorted_batch_ = false;
+  is_batch_fetched_ = false;
+  batch_output_idx_ = 0;
+}
+
+void ObSSTableRowMultiGetter::reset_sorted_batch()
+{
+  reuse_sorted_batch();
+  sorted_rowkeys_.reset();
+  sorted_rowkey_idxs_.reset();
+  batch_rows_.reset();
+  batch_row_allocator_.reset();
+}
+
 int ObSSTableRowMultiGetter::inner_open(
     const ObTableIterParam &iter_param,
     ObTableAccessContext &access_ctx,
@@ -69,13 +96,21 @@ int ObSSTableRowMultiGetter::inner_open(
     sstable_ = static_cast<ObSSTable *>(table);
     iter_param_ = &iter_param;
     access_ctx_ = &access_ctx;
-    if (!prefetcher_.is_valid()) {
+    const void *prefetch_range = query_range;
+    if (OB_FAIL(init_sorted_batch(*static_cast<const ObIArray<ObDatumRowkey> *>(query_range)))) {
+      LOG_WARN("Fail to init sorted batch", K(ret));
+    } else if (FALSE_IT(prefetcher_.set_sorted_batch_get(is_sorted_batch_))) {
+    } else if (is_sorted_batch_) {
+      prefetch_range = &sorted_rowkeys_;
+    }
+    if (OB_FAIL(ret)) {
+    } else if (!prefetcher_.is_valid()) {
       if (OB_FAIL(prefetcher_.init(
-                  type_, *sstable_, iter_param, access_ctx, query_range))) {
+                  type_, *sstable_, iter_param, access_ctx, prefetch_range))) {
         LOG_WARN("fail to init prefetcher, ", K(ret));
       }
     } else if (OB_FAIL(prefetcher_.switch_context(
-        type_, *sstable_, iter_param, access_ctx, query_range))) {
+        type_, *sstable_, iter_param, access_ctx, prefetch_range))) {
       LOG_WARN("fail to switch context for prefetcher, ", K(ret));
     }
     if (OB_SUCC(ret)) {
@@ -93,48 +128,159 @@ int ObSSTableRowMultiGetter::inner_open(
   return ret;
 }
 
+int ObSSTableRowMultiGetter::init_sorted_batch(const ObIArray<ObDatumRowkey> &rowkeys)
+{
+  int ret = OB_SUCCESS;
+  const int64_t rowkey_cnt = rowkeys.count();
+  reuse_sorted_batch();
+  if (ObStoreRowIterator::IteratorMultiGet != type_ ||
+      access_ctx_->query_flag_.is_ordered_scan() ||
+      rowkey_cnt < SORTED_BATCH_GET_MIN_ROWKEY_CNT ||
+      rowkey_cnt > SORTED_BATCH_GET_MAX_ROWKEY_CNT ||
+      sstable_->is_ddl_sstable() ||
+      nullptr == iter_param_->get_read_info()) {
+    // get rowkeys in the order of the caller
+  } else {
+    sorted_rowkeys_.set_allocator(long_life_allocator_);
+    sorted_rowkey_idxs_.set_allocator(long_life_allocator_);
+    batch_rows_.set_allocator(long_life_allocator_);
+    if (OB_FAIL(sorted_rowkeys_.prepare_reallocate(rowkey_cnt))) {
+      LOG_WARN("Fail to prepare sorted rowkeys", K(ret), K(rowkey_cnt));
+    } else if (OB_FAIL(sorted_rowkey_idxs_.prepare_reallocate(rowkey_cnt))) {
+      LOG_WARN("Fail to prepare sorted rowkey idxs", K(ret), K(rowkey_cnt));
+    } else if (OB_FAIL(batch_rows_.prepare_reallocate(rowkey_cnt))) {
+      LOG_WARN("Fail to prepare batch rows", K(ret), K(rowkey_cnt));
+    } else {
+      for (int64_t i = 0; i < rowkey_cnt; ++i) {
+        sorted_rowkey_idxs_.at(i) = i;
+        batch_rows_.at(i) = nullptr;
+      }
+      RowkeyIdxCompare compare(rowkeys, iter_param_->get_read_info()->get_datum_utils(), ret);
+      lib::ob_sort(sorted_rowkey_idxs_.begin(), sorted_rowkey_idxs_.end(), compare);
+      if (OB_FAIL(ret)) {
+        LOG_WARN("Fail to sort rowkeys", K(ret), K(rowkey_cnt));
+      } else {
+        for (int64_t i = 0; i < rowkey_cnt; ++i) {
+          sorted_rowkeys_.at(i) = rowkeys.at(sorted_rowkey_idxs_.at(i));
+        }
+        is_sorted_batch_ = true;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObSSTableRowMultiGetter::fetch_sorted_batch()
+{
+  int ret = OB_SUCCESS;
+  const ObDatumRow *store_row = nullptr;
+  while (OB_SUCC(ret)) {
+    void *buf = nullptr;
+    ObDatumRow *batch_row = nullptr;
+    if (OB_FAIL(get_next_prefetched_row(store_row))) {
+      if (OB_UNLIKELY(OB_ITER_END != ret)) {
+        LOG_WARN("Fail to get next prefetched row", K(ret));
+      }
+    } else {
+      // the row is of the rowkey just fetched
+      const int64_t sorted_idx = prefetcher_.fetch_rowkey_idx_ - 1;
+      if (OB_UNLIKELY(nullptr == store_row || sorted_idx < 0 || sorted_idx >= sorted_rowkey_idxs_.count())) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("Unexpected fetched row", K(ret), KP(store_row), K(sorted_idx), K_(prefetcher));
+      } else if (OB_ISNULL(buf = batch_row_allocator_.alloc(sizeof(ObDatumRow)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("Fail to allocate datum row", K(ret));
+      } else if (FALSE_IT(batch_row = new (buf) ObDatumRow())) {
+      } else if (FALSE_IT(batch_rows_.at(sorted_rowkey_idxs_.at(sorted_idx)) = batch_row)) {
+      } else if (OB_FAIL(batch_row->init(batch_row_allocator_, store_row->count_))) {
+        LOG_WARN("Fail to init datum row", K(ret), KPC(store_row));
+      } else if (OB_FAIL(batch_row->deep_copy(*store_row, batch_row_allocator_))) {
+        LOG_WARN("Fail to deep copy datum row", K(ret), KPC(store_row));
+      }
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+    is_batch_fetched_ = true;
+  }
+  return ret;
+}
+
+int ObSSTableRowMultiGetter::get_next_batch_row(const blocksstable::ObDatumRow *&store_row)
+{
+  int ret = OB_SUCCESS;
+  store_row = nullptr;
+  if (!is_batch_fetched_ && OB_FAIL(fetch_sorted_batch())) {
+    LOG_WARN("Fail to fetch sorted batch", K(ret));
+  }
+  // rowkeys without row are skipped, the same as the unsorted path
+  while (OB_SUCC(ret) && nullptr == store_row) {
+    if (batch_output_idx_ >= batch_rows_.count()) {
+      ret = OB_ITER_END;
+    } else {
+      store_row = batch_rows_.at(batch_output_idx_++);
+    }
+  }
+  return ret;
+}
+
 int ObSSTableRowMultiGetter::inner_get_next_row(const blocksstable::ObDatumRow *&store_row)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(!is_opened_)) {
     ret = OB_NOT_INIT;
     LOG_WARN("The ObSSTableRowMultiGetter has not been opened", K(ret), KP(this));
-  } else {
-    while (OB_SUCC(ret)) {
-      if (OB_FAIL(prefetcher_.multi_prefetch())) {
-        LOG_WARN("Fail to prefetch micro block", K(ret), K_(prefetcher));
-      } else if (prefetcher_.fetch_rowkey_idx_ >= prefetcher_.prefetch_rowkey_idx_) {
-        if (OB_LIKELY(prefetcher_.is_prefetch_end())) {
-          ret = OB_ITER_END;
-        } else {
-          ret = OB_ERR_UNEXPECTED;
-          LOG_WARN("Current fetch handle idx exceed prefetching idx", K(ret), K_(prefetcher));
-        }
-      } else if (!prefetcher_.current_read_handle().cur_prefetch_end_) {
-        continue;
-      } else if (OB_FAIL(fetch_row(prefetcher_.current_read_handle(), store_row))) {
-        if (OB_LIKELY(OB_ITER_END == ret)) {
-          prefetcher_.mark_cur_rowkey_fetched(prefetcher_.current_read_handle());
-          ret = OB_SUCCESS;
-        } else {
-          LOG_WARN("Fail to fetch row", K(ret));
-        }
+  } else if (is_sorted_batch_) {
+    if (OB_FAIL(get_next_batch_row(store_row))) {
+      if (OB_UNLIKELY(OB_ITER_END != ret)) {
+        LOG_WARN("Fail to get next batch row", K(ret));
+      }
+    }
+  } else if (OB_FAIL(get_next_prefetched_row(store_row))) {
+    if (OB_UNLIKELY(OB_ITER_END != ret)) {
+      LOG_WARN("Fail to get next prefetched row", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObSSTableRowMultiGetter::get_next_prefetched_row(const blocksstable::ObDatumRow *&store_row)
+{
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(ret)) {
+    if (OB_FAIL(prefetcher_.multi_prefetch())) {
+      LOG_WARN("Fail to prefetch micro block", K(ret), K_(prefetcher));
+    } else if (prefetcher_.fetch_rowkey_idx_ >= prefetcher_.prefetch_rowkey_idx_) {
+      if (OB_LIKELY(prefetcher_.is_prefetch_end())) {
+        ret = OB_ITER_END;
       } else {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("Current fetch handle idx exceed prefetching idx", K(ret), K_(prefetcher));
+      }
+    } else if (!prefetcher_.current_read_handle().cur_prefetch_end_) {
+      continue;
+    } else if (OB_FAIL(fetch_row(prefetcher_.current_read_handle(), store_row))) {
+      if (OB_LIKELY(OB_ITER_END == ret)) {
         prefetcher_.mark_cur_rowkey_fetched(prefetcher_.current_read_handle());
-        break;
+        ret = OB_SUCCESS;
+      } else {
+        LOG_WARN("Fail to fetch row", K(ret));
       }
+    } else {
+      prefetcher_.mark_cur_rowkey_fetched(prefetcher_.current_read_handle());
+      break;
     }
+  }
 
-    if (OB_SUCC(ret) && nullptr != store_row) {
-      ObDatumRow &datum_row = *const_cast<ObDatumRow *>(store_row);
-      if (!store_row->row_flag_.is_not_exist() &&
-          iter_param_->need_scn_ &&
-          OB_FAIL(set_row_scn(*iter_param_, store_row))) {
-        LOG_WARN("failed to set row scn", K(ret));
-      }
-      EVENT_INC(ObStatEventIds::SSSTORE_READ_ROW_COUNT);
-      LOG_DEBUG("inner get next row", K(*store_row));
+  if (OB_SUCC(ret) && nullptr != store_row) {
+    ObDatumRow &datum_row = *const_cast<ObDatumRow *>(store_row);
+    if (!store_row->row_flag_.is_not_exist() &&
+        iter_param_->need_scn_ &&
+        OB_FAIL(set_row_scn(*iter_param_, store_row))) {
+      LOG_WARN("failed to set row scn", K(ret));
     }
+    EVENT_INC(ObStatEventIds::SSSTORE_READ_ROW_COUNT);
+    LOG_DEBUG("inner get next row", K(*store_row));
   }
   return ret;
 }
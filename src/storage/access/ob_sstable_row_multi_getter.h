@@ -18,9 +18,15 @@
 
 namespace oceanbase {
 namespace storage {
+// Unordered multi get with many rowkeys runs in sorted batch mode: the rowkeys are sorted before
+// prefetching, so that rowkeys in the same index or data micro block share one index tree descent
+// and one block handle, and the data blocks are read in the physical order. The rows are buffered
+// and returned in the rowkey order of the caller.
 class ObSSTableRowMultiGetter : public ObStoreRowIterator
 {
 public:
+  static const int64_t SORTED_BATCH_GET_MIN_ROWKEY_CNT = 16;
+  static const int64_t SORTED_BATCH_GET_MAX_ROWKEY_CNT = 2048;
   ObSSTableRowMultiGetter() :
       ObStoreRowIterator(),
       sstable_(nullptr),
@@ -29,7 +35,14 @@ public:
       prefetcher_(),
       macro_block_reader_(nullptr),
       is_opened_(false),
-      micro_getter_(nullptr)
+      micro_getter_(nullptr),
+      is_sorted_batch_(false),
+      is_batch_fetched_(false),
+      batch_output_idx_(0),
+      sorted_rowkeys_(),
+      sorted_rowkey_idxs_(),
+      batch_rows_(),
+      batch_row_allocator_("SortedMultiGet", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID())
   {
     type_ = ObStoreRowIterator::IteratorMultiGet;
   }
@@ -38,7 +51,8 @@ public:
   virtual void reset() override;
   virtual void reuse() override;
   virtual void reclaim() override;
-  TO_STRING_KV(K_(is_opened), K_(prefetcher), KP_(macro_block_reader));
+  TO_STRING_KV(K_(is_opened), K_(prefetcher), KP_(macro_block_reader), K_(is_sorted_batch),
+               K_(is_batch_fetched), K_(batch_output_idx));
 protected:
   int inner_open(
       const ObTableIterParam &access_param,
@@ -54,9 +68,46 @@ protected:
   ObTableAccessContext *access_ctx_;
   ObIndexTreeMultiPrefetcher prefetcher_;
   ObMacroBlockReader *macro_block_reader_;
+private:
+  struct RowkeyIdxCompare
+  {
+    RowkeyIdxCompare(const common::ObIArray<blocksstable::ObDatumRowkey> &rowkeys,
+                     const blocksstable::ObStorageDatumUtils &datum_utils,
+                     int &ret)
+      : rowkeys_(rowkeys), datum_utils_(datum_utils), ret_(ret)
+    {}
+    OB_INLINE bool operator() (const int64_t left, const int64_t right)
+    {
+      int cmp_ret = 0;
+      int &ret = ret_;
+      if (OB_FAIL(ret)) {
+      } else if (OB_FAIL(rowkeys_.at(left).compare(rowkeys_.at(right), datum_utils_, cmp_ret))) {
+        STORAGE_LOG(WARN, "Failed to compare datum rowkey", K(ret), K(rowkeys_.at(left)), K(rowkeys_.at(right)));
+      }
+      return cmp_ret < 0;
+    }
+    const common::ObIArray<blocksstable::ObDatumRowkey> &rowkeys_;
+    const blocksstable::ObStorageDatumUtils &datum_utils_;
+    int &ret_;
+  };
+  int get_next_prefetched_row(const blocksstable::ObDatumRow *&store_row);
+  int init_sorted_batch(const common::ObIArray<blocksstable::ObDatumRowkey> &rowkeys);
+  int fetch_sorted_batch();
+  int get_next_batch_row(const blocksstable::ObDatumRow *&store_row);
+  void reuse_sorted_batch();
+  void reset_sorted_batch();
 private:
   bool is_opened_;
   blocksstable::ObMicroBlockRowGetter *micro_getter_;
+  bool is_sorted_batch_;
+  bool is_batch_fetched_;
+  int64_t batch_output_idx_;
+  // rowkeys in ascending order and their positions in the rowkeys of the caller
+  ObReallocatedFixedArray<blocksstable::ObDatumRowkey> sorted_rowkeys_;
+  ObReallocatedFixedArray<int64_t> sorted_rowkey_idxs_;
+  // buffered rows in the rowkey order of the caller
+  ObReallocatedFixedArray<blocksstable::ObDatumRow *> batch_rows_;
+  common::ObArenaAllocator batch_row_allocator_;
 };
 
 }
@@ -396,15 +396,34 @@ int ObVectorStore::check_can_group_by(
       LOG_WARN("Failed to get micro row count", K(ret));
     } else {
       int64_t distinct_cnt = 0;
+      bool is_dict_encoded = true;
       const int64_t covered_row_count = end_index - begin_index;
       if (OB_FAIL(reader->get_distinct_count(group_by_cell_->get_group_by_col_offset(), distinct_cnt))) {
         if (OB_UNLIKELY(OB_NOT_SUPPORTED != ret)) {
           LOG_WARN("Failed to get distinct cnt", K(ret));
         } else {
           ret = OB_SUCCESS;
+          is_dict_encoded = false;
         }
+      }
+      // all the group by columns should be encoded with dictionary
+      for (int64_t i = 0; OB_SUCC(ret) && is_dict_encoded && i < group_by_cell_->get_group_by_key_cnt(); ++i) {
+        int64_t key_distinct_cnt = 0;
+        if (OB_FAIL(reader->get_distinct_count(group_by_cell_->get_group_by_key_col_offset(i), key_distinct_cnt))) {
+          if (OB_UNLIKELY(OB_NOT_SUPPORTED != ret)) {
+            LOG_WARN("Failed to get distinct cnt", K(ret), K(i));
+          } else {
+            ret = OB_SUCCESS;
+            is_dict_encoded = false;
+          }
+        } else if (OB_FAIL(group_by_cell_->set_group_by_key_distinct_cnt(i, key_distinct_cnt))) {
+          LOG_WARN("Failed to set distinct cnt of group by key", K(ret), K(i), K(key_distinct_cnt));
+        }
+      }
+      if (OB_FAIL(ret) || !is_dict_encoded) {
       } else if (OB_FAIL(group_by_cell_->decide_use_group_by(
-          micro_row_count, covered_row_count, distinct_cnt, res.bitmap_, can_group_by))) {
+          micro_row_count, covered_row_count, group_by_cell_->get_group_by_key_space(distinct_cnt), res.bitmap_, can_group_by,
+          reader->has_shared_dict()))) {
         LOG_WARN("Failed to decide use group by", K(ret));
       }
     }
@@ -427,6 +446,8 @@ int ObVectorStore::do_group_by(
   if (OB_FAIL(decoder->read_distinct(group_by_col_offset,
       nullptr == cell_data ? cell_data_ptrs_ : cell_data, *group_by_cell_))) {
     LOG_WARN("Failed to read distinct", K(ret));
+  } else if (group_by_cell_->has_group_by_keys() && OB_FAIL(read_group_by_keys_distinct(decoder))) {
+    LOG_WARN("Failed to read distinct of group by keys", K(ret));
   } else if (group_by_cell_->need_read_reference()) {
     const bool need_extract_distinct = group_by_cell_->need_extract_distinct();
     const bool need_do_aggregate = group_by_cell_->need_do_aggregate();
@@ -441,6 +462,8 @@ int ObVectorStore::do_group_by(
       } else if (0 == row_capacity) {
       } else if (OB_FAIL(decoder->read_reference(group_by_col_offset, row_ids_, row_capacity, *group_by_cell_))) {
         LOG_WARN("Failed to read reference", K(ret));
+      } else if (group_by_cell_->has_group_by_keys() && OB_FAIL(read_group_by_keys_reference(decoder, row_capacity))) {
+        LOG_WARN("Failed to read reference of group by keys", K(ret));
       } else if (need_extract_distinct && OB_FAIL(group_by_cell_->extract_distinct())) {
         LOG_WARN("Failed to extract distinct", K(ret));
       } else if (need_do_aggregate) {
@@ -462,6 +485,42 @@ int ObVectorStore::do_group_by(
   return ret;
 }
 
+int ObVectorStore::read_group_by_keys_distinct(blocksstable::ObIMicroBlockDecoder *decoder)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < group_by_cell_->get_group_by_key_cnt(); ++i) {
+    group_by_cell_->switch_group_by_key(i);
+    const char **cell_data = group_by_cell_->get_cell_datas();
+    if (OB_FAIL(decoder->read_distinct(group_by_cell_->get_group_by_key_col_offset(i),
+        nullptr == cell_data ? cell_data_ptrs_ : cell_data, *group_by_cell_))) {
+      LOG_WARN("Failed to read distinct", K(ret), K(i));
+    }
+  }
+  group_by_cell_->switch_group_by_key(-1);
+  if (OB_SUCC(ret) && OB_FAIL(group_by_cell_->prepare_group_by_keys())) {
+    LOG_WARN("Failed to prepare group by keys", K(ret));
+  }
+  return ret;
+}
+
+int ObVectorStore::read_group_by_keys_reference(blocksstable::ObIMicroBlockDecoder *decoder, const int64_t row_cap)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < group_by_cell_->get_group_by_key_cnt(); ++i) {
+    if (group_by_cell_->need_read_key_reference(i)) {
+      group_by_cell_->switch_group_by_key(i);
+      if (OB_FAIL(decoder->read_reference(group_by_cell_->get_group_by_key_col_offset(i), row_ids_, row_cap, *group_by_cell_))) {
+        LOG_WARN("Failed to read reference", K(ret), K(i));
+      }
+    }
+  }
+  group_by_cell_->switch_group_by_key(-1);
+  if (OB_SUCC(ret) && OB_FAIL(group_by_cell_->combine_group_by_keys())) {
+    LOG_WARN("Failed to combine group by keys", K(ret));
+  }
+  return ret;
+}
+
 int ObVectorStore::fill_rows(const int64_t group_idx, const int64_t row_count)
 {
   int ret = OB_SUCCESS;
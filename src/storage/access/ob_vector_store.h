@@ -25,7 +25,7 @@ namespace oceanbase
 namespace blocksstable
 {
 class ObIMicroBlockReader;
-class ObIMicroBlockReader;
+class ObIMicroBlockDecoder;
 }
 
 namespace storage
@@ -88,6 +88,9 @@ private:
       int64_t begin_index,
       const int64_t end_index,
       const ObFilterResult &res);
+  // for multiple group by columns
+  int read_group_by_keys_distinct(blocksstable::ObIMicroBlockDecoder *decoder);
+  int read_group_by_keys_reference(blocksstable::ObIMicroBlockDecoder *decoder, const int64_t row_cap);
 
   int64_t count_;
   // exprs needed fill in
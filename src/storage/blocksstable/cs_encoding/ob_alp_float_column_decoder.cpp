@@ -0,0 +1,382 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_alp_float_column_decoder.h"
+#include "ob_alp_float_util.h"
+#include "ob_cs_decoding_util.h"
+#include "storage/blocksstable/encoding/ob_vector_decode_util.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+using namespace oceanbase::common;
+
+// exception row ids are stored in ascending order
+static OB_INLINE bool find_exception(const ObALPFloatMeta &meta, const int64_t row_id, int64_t &idx)
+{
+  const char *row_ids = meta.get_exception_row_ids();
+  int64_t low = 0;
+  int64_t high = meta.exception_cnt_;
+  uint32_t cur_row_id = 0;
+  while (low < high) {
+    const int64_t mid = (low + high) / 2;
+    MEMCPY(&cur_row_id, row_ids + mid * sizeof(uint32_t), sizeof(uint32_t));
+    if (cur_row_id < row_id) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  idx = low;
+  bool found = false;
+  if (low < meta.exception_cnt_) {
+    MEMCPY(&cur_row_id, row_ids + low * sizeof(uint32_t), sizeof(uint32_t));
+    found = cur_row_id == row_id;
+  }
+  return found;
+}
+
+// decode the float or double of %row_id into %buf, return false if the row is null
+static OB_INLINE bool decode_row(const ObALPFloatColumnDecoderCtx &ctx, const int64_t row_id, char *buf)
+{
+  const ObALPFloatMeta &meta = *ctx.alp_meta_;
+  const ObIntegerStreamMeta &stream_meta = ctx.ctx_->meta_;
+  const uint32_t width_size = stream_meta.get_uint_width_size();
+  const uint64_t base = stream_meta.is_use_base() * stream_meta.base_value_;
+  bool is_null = false;
+  uint64_t encoded = 0;
+  ENCODING_ADAPT_MEMCPY(&encoded, ctx.data_ + row_id * width_size, width_size);
+  encoded += base;
+  if (ctx.has_null_bitmap()) {
+    is_null = ObCSDecodingUtil::test_bit(ctx.null_bitmap_, row_id);
+  } else if (ctx.is_null_replaced()) {
+    is_null = encoded == static_cast<uint64_t>(ctx.null_replaced_value_);
+  }
+  if (!is_null) {
+    int64_t exception_idx = 0;
+    if (meta.exception_cnt_ > 0 && find_exception(meta, row_id, exception_idx)) {
+      const int64_t value_size = meta.get_value_size();
+      MEMCPY(buf, meta.get_exception_values() + exception_idx * value_size, value_size);
+    } else {
+      const double value = ObALPFloatUtil::decode(
+          static_cast<int64_t>(encoded), meta.exponent_, meta.factor_);
+      if (meta.is_float()) {
+        const float float_value = static_cast<float>(value);
+        MEMCPY(buf, &float_value, sizeof(float));
+      } else {
+        MEMCPY(buf, &value, sizeof(double));
+      }
+    }
+  }
+  return !is_null;
+}
+
+static OB_INLINE bool decode_row_to_double(
+    const ObALPFloatColumnDecoderCtx &ctx, const int64_t row_id, double &value)
+{
+  bool not_null = false;
+  if (ctx.alp_meta_->is_float()) {
+    float float_value = 0;
+    not_null = decode_row(ctx, row_id, reinterpret_cast<char *>(&float_value));
+    value = float_value;
+  } else {
+    not_null = decode_row(ctx, row_id, reinterpret_cast<char *>(&value));
+  }
+  return not_null;
+}
+
+int ObALPFloatColumnDecoder::decode(
+  const ObColumnCSDecoderCtx &ctx, const int32_t row_id, common::ObDatum &datum) const
+{
+  int ret = OB_SUCCESS;
+  const ObALPFloatColumnDecoderCtx &alp_ctx = ctx.alp_float_ctx_;
+  if (decode_row(alp_ctx, row_id, const_cast<char *>(datum.ptr_))) {
+    datum.pack_ = static_cast<uint32_t>(alp_ctx.alp_meta_->get_value_size());
+  } else {
+    datum.set_null();
+  }
+  return ret;
+}
+
+int ObALPFloatColumnDecoder::batch_decode(const ObColumnCSDecoderCtx &ctx,
+    const int32_t *row_ids, const int64_t row_cap, common::ObDatum *datums) const
+{
+  int ret = OB_SUCCESS;
+  const ObALPFloatColumnDecoderCtx &alp_ctx = ctx.alp_float_ctx_;
+  const uint32_t value_size = static_cast<uint32_t>(alp_ctx.alp_meta_->get_value_size());
+  for (int64_t i = 0; i < row_cap; ++i) {
+    ObDatum &datum = datums[i];
+    if (decode_row(alp_ctx, row_ids[i], const_cast<char *>(datum.ptr_))) {
+      datum.pack_ = value_size;
+    } else {
+      datum.set_null();
+    }
+  }
+  return ret;
+}
+
+int ObALPFloatColumnDecoder::decode_vector(
+    const ObColumnCSDecoderCtx &ctx, ObVectorDecodeCtx &vector_ctx) const
+{
+  int ret = OB_SUCCESS;
+  const ObALPFloatColumnDecoderCtx &alp_ctx = ctx.alp_float_ctx_;
+  const int64_t value_size = alp_ctx.alp_meta_->get_value_size();
+  char *buf = nullptr;
+  bool has_null = false;
+
+  if (OB_ISNULL(buf = static_cast<char *>(alp_ctx.allocator_->alloc(value_size * vector_ctx.row_cap_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc decode buf", K(ret), K(value_size), K(vector_ctx));
+  } else {
+    for (int64_t i = 0; i < vector_ctx.row_cap_; ++i) {
+      char *value_buf = buf + i * value_size;
+      if (decode_row(alp_ctx, vector_ctx.row_ids_[i], value_buf)) {
+        vector_ctx.ptr_arr_[i] = value_buf;
+        vector_ctx.len_arr_[i] = static_cast<uint32_t>(value_size);
+      } else {
+        vector_ctx.ptr_arr_[i] = nullptr;
+        vector_ctx.len_arr_[i] = 0;
+        has_null = true;
+      }
+    }
+    const int64_t fixed_packing_len = 0;
+    DataDiscreteLocator discrete_locator(vector_ctx.ptr_arr_, vector_ctx.len_arr_);
+    if (OB_FAIL(ObVecDecodeUtils::load_byte_aligned_vector<DataDiscreteLocator>(
+        alp_ctx.obj_meta_, alp_ctx.col_header_->get_store_obj_type(), fixed_packing_len,
+        has_null, discrete_locator, vector_ctx.row_cap_,
+        vector_ctx.vec_offset_, vector_ctx.vec_header_))) {
+      LOG_WARN("failed to load byte aligned data to vector", K(ret), K(alp_ctx));
+    }
+  }
+  return ret;
+}
+
+int ObALPFloatColumnDecoder::get_null_count(const ObColumnCSDecoderCtx &col_ctx,
+    const int32_t *row_ids, const int64_t row_cap, int64_t &null_count) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(row_ids) || row_cap < 1) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", KR(ret), K(row_cap));
+  } else {
+    const ObALPFloatColumnDecoderCtx &alp_ctx = col_ctx.alp_float_ctx_;
+    double value = 0;
+    null_count = 0;
+    if (!alp_ctx.has_no_null()) {
+      for (int64_t i = 0; i < row_cap; ++i) {
+        if (!decode_row_to_double(alp_ctx, row_ids[i], value)) {
+          ++null_count;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObALPFloatColumnDecoder::pushdown_operator(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnCSDecoderCtx &col_ctx,
+    const sql::ObWhiteFilterExecutor &filter,
+    const sql::PushdownFilterInfo &pd_filter_info,
+    ObBitmap &result_bitmap) const
+{
+  UNUSED(parent);
+  int ret = OB_SUCCESS;
+  const ObALPFloatColumnDecoderCtx &alp_ctx = col_ctx.alp_float_ctx_;
+  const int64_t row_cnt = pd_filter_info.count_;
+  if (OB_UNLIKELY(row_cnt < 1 || row_cnt != result_bitmap.size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", KR(ret), K(row_cnt), K(alp_ctx), K(result_bitmap.size()));
+  } else {
+    const int64_t row_start = pd_filter_info.start_;
+    const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+    switch (op_type) {
+      case sql::WHITE_OP_NU:
+      case sql::WHITE_OP_NN: {
+        if (OB_FAIL(nu_nn_operator(alp_ctx, row_start, row_cnt, filter, result_bitmap))) {
+          LOG_WARN("fail to handle nu_nn operator", KR(ret), K(pd_filter_info), K(alp_ctx));
+        }
+        break;
+      }
+      case sql::WHITE_OP_EQ:
+      case sql::WHITE_OP_NE:
+      case sql::WHITE_OP_GT:
+      case sql::WHITE_OP_GE:
+      case sql::WHITE_OP_LT:
+      case sql::WHITE_OP_LE:
+      case sql::WHITE_OP_BT: {
+        if (OB_FAIL(comparison_operator(alp_ctx, row_start, row_cnt, filter, result_bitmap))) {
+          if (OB_NOT_SUPPORTED != ret) {
+            LOG_WARN("fail to handle comparison operator", KR(ret), K(pd_filter_info), K(alp_ctx));
+          }
+        }
+        break;
+      }
+      default: {
+        ret = OB_NOT_SUPPORTED;
+      }
+    }
+    LOG_TRACE("alp float white filter pushdown", K(ret), K(alp_ctx),
+        K(filter.get_op_type()), K(pd_filter_info), K(result_bitmap.popcnt()));
+  }
+  return ret;
+}
+
+int ObALPFloatColumnDecoder::nu_nn_operator(
+    const ObALPFloatColumnDecoderCtx &ctx,
+    const int64_t row_start,
+    const int64_t row_count,
+    const sql::ObWhiteFilterExecutor &filter,
+    common::ObBitmap &result_bitmap)
+{
+  int ret = OB_SUCCESS;
+  double value = 0;
+  if (!ctx.has_no_null()) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      if (!decode_row_to_double(ctx, row_start + i, value) && OB_FAIL(result_bitmap.set(i))) {
+        LOG_WARN("fail to set", KR(ret), K(i), K(row_start));
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+    LOG_WARN("nu_nn_operator failed", KR(ret), K(ctx));
+  } else if (sql::WHITE_OP_NN == filter.get_op_type()) {
+    if (OB_FAIL(result_bitmap.bit_not())) {
+      LOG_WARN("fail to execute bit not", KR(ret), K(ctx));
+    }
+  }
+  return ret;
+}
+
+int ObALPFloatColumnDecoder::get_filter_values(
+    const ObALPFloatColumnDecoderCtx &ctx,
+    const sql::ObWhiteFilterExecutor &filter,
+    double &left,
+    double &right,
+    bool &is_supported)
+{
+  int ret = OB_SUCCESS;
+  const int64_t expect_cnt = sql::WHITE_OP_BT == filter.get_op_type() ? 2 : 1;
+  const ObObjTypeClass col_tc = ctx.obj_meta_.get_type_class();
+  const sql::ObExpr *expr = filter.get_filter_node().expr_;
+  bool is_same_tc = true;
+  is_supported = false;
+  if (OB_UNLIKELY(filter.get_datums().count() != expect_cnt)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", KR(ret), K(expect_cnt), K(filter));
+  } else if (OB_ISNULL(expr) || OB_UNLIKELY(expr->arg_cnt_ != expect_cnt + 1)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected filter expr", KR(ret), KP(expr), K(expect_cnt));
+  }
+  // get_filter_val_meta only supports one filter value, check the values of BT here
+  for (int64_t i = 0; OB_SUCC(ret) && is_same_tc && i < expr->arg_cnt_; ++i) {
+    if (OB_ISNULL(expr->args_[i])) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected null expr argument", KR(ret), K(i));
+    } else if (T_REF_COLUMN != expr->args_[i]->type_) {
+      is_same_tc = expr->args_[i]->obj_meta_.get_type_class() == col_tc;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (!is_same_tc) {
+    // compare with other types needs the cast rules of sql, leave it to the retro path
+  } else {
+    const ObDatum &left_datum = filter.get_datums().at(0);
+    const ObDatum &right_datum = filter.get_datums().at(expect_cnt - 1);
+    if (!left_datum.is_null() && !right_datum.is_null()) {
+      is_supported = true;
+      if (ObFloatTC == col_tc) {
+        left = left_datum.get_float();
+        right = right_datum.get_float();
+      } else {
+        left = left_datum.get_double();
+        right = right_datum.get_double();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObALPFloatColumnDecoder::comparison_operator(
+    const ObALPFloatColumnDecoderCtx &ctx,
+    const int64_t row_start,
+    const int64_t row_count,
+    const sql::ObWhiteFilterExecutor &filter,
+    common::ObBitmap &result_bitmap)
+{
+  int ret = OB_SUCCESS;
+  const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  const ObALPFloatMeta &meta = *ctx.alp_meta_;
+  double left = 0;
+  double right = 0;
+  bool is_supported = false;
+  if (OB_FAIL(get_filter_values(ctx, filter, left, right, is_supported))) {
+    LOG_WARN("fail to get filter values", KR(ret), K(filter));
+  } else if (!is_supported) {
+    ret = OB_NOT_SUPPORTED;
+  } else {
+    // no row can match if the filter value is out of the block value range,
+    // NaN is the biggest value as sql compare does
+    const double min = meta.has_value() ? meta.min_ : NAN;
+    const double max = meta.has_nan() ? NAN : meta.max_;
+    bool all_false = !meta.has_value() && !meta.has_nan();
+    if (!all_false) {
+      switch (op_type) {
+        case sql::WHITE_OP_EQ: {
+          all_false = ObALPFloatUtil::compare(left, min) < 0 || ObALPFloatUtil::compare(left, max) > 0;
+          break;
+        }
+        case sql::WHITE_OP_GT: { all_false = ObALPFloatUtil::compare(max, left) <= 0; break; }
+        case sql::WHITE_OP_GE: { all_false = ObALPFloatUtil::compare(max, left) < 0; break; }
+        case sql::WHITE_OP_LT: { all_false = ObALPFloatUtil::compare(min, left) >= 0; break; }
+        case sql::WHITE_OP_LE: { all_false = ObALPFloatUtil::compare(min, left) > 0; break; }
+        case sql::WHITE_OP_BT: {
+          all_false = ObALPFloatUtil::compare(right, min) < 0 || ObALPFloatUtil::compare(left, max) > 0;
+          break;
+        }
+        default: { break; }
+      }
+    }
+    if (all_false) {
+      result_bitmap.reuse();
+    } else {
+      double value = 0;
+      bool is_match = false;
+      for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+        if (decode_row_to_double(ctx, row_start + i, value)) {
+          switch (op_type) {
+            case sql::WHITE_OP_EQ: { is_match = ObALPFloatUtil::compare(value, left) == 0; break; }
+            case sql::WHITE_OP_NE: { is_match = ObALPFloatUtil::compare(value, left) != 0; break; }
+            case sql::WHITE_OP_GT: { is_match = ObALPFloatUtil::compare(value, left) > 0; break; }
+            case sql::WHITE_OP_GE: { is_match = ObALPFloatUtil::compare(value, left) >= 0; break; }
+            case sql::WHITE_OP_LT: { is_match = ObALPFloatUtil::compare(value, left) < 0; break; }
+            case sql::WHITE_OP_LE: { is_match = ObALPFloatUtil::compare(value, left) <= 0; break; }
+            case sql::WHITE_OP_BT: {
+              is_match = ObALPFloatUtil::compare(value, left) >= 0 && ObALPFloatUtil::compare(value, right) <= 0;
+              break;
+            }
+            default: { is_match = false; break; }
+          }
+          if (is_match && OB_FAIL(result_bitmap.set(i))) {
+            LOG_WARN("fail to set", KR(ret), K(i), K(row_start));
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -0,0 +1,349 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_alp_float_column_encoder.h"
+#include "ob_column_datum_iter.h"
+#include "ob_cs_encoding_util.h"
+#include "lib/codec/ob_codecs.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+using namespace common;
+
+ObALPFloatColumnEncoder::ObALPFloatColumnEncoder()
+  : alp_meta_(),
+    enc_ctx_(),
+    integer_stream_encoder_(),
+    encoded_values_(nullptr),
+    encoded_datums_(nullptr),
+    exception_row_ids_(nullptr),
+    integer_range_(0)
+{
+}
+
+ObALPFloatColumnEncoder::~ObALPFloatColumnEncoder() {}
+
+bool ObALPFloatColumnEncoder::is_applicable(
+    const ObColumnCSEncodingCtx &ctx, const ObObjMeta &column_type)
+{
+  const ObObjTypeClass tc = column_type.get_type_class();
+  return (ObFloatTC == tc || ObDoubleTC == tc)
+      && !ctx.force_raw_encoding_
+      && nullptr != ctx.col_datums_
+      && ctx.col_datums_->count() > ctx.null_cnt_;
+}
+
+int ObALPFloatColumnEncoder::init(
+  const ObColumnCSEncodingCtx &ctx, const int64_t column_index, const int64_t row_count)
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_FAIL(ObIColumnCSEncoder::init(ctx, column_index, row_count))) {
+    LOG_WARN("init base column encoder failed", K(ret), K(ctx), K(column_index), K(row_count));
+  } else {
+    column_header_.type_ = type_;
+    column_header_.set_is_fixed_length();
+    const ObObjTypeClass tc = column_type_.get_type_class();
+    if (ObFloatTC != tc && ObDoubleTC != tc) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("not supported column type", K(ret), K_(column_type), K_(column_index));
+    } else if (FALSE_IT(alp_meta_.reuse(ObFloatTC == tc))) {
+    } else if (OB_FAIL(do_init_())) {
+      LOG_WARN("fail to do init", K(ret));
+    } else {
+      LOG_DEBUG("init alp float column encoder", K(ret), K_(column_type),
+          K_(column_index), K_(alp_meta), K_(integer_range));
+    }
+  }
+  return ret;
+}
+
+void ObALPFloatColumnEncoder::reuse()
+{
+  ObIColumnCSEncoder::reuse();
+  alp_meta_.reuse(false);
+  integer_stream_encoder_.reuse();
+  enc_ctx_.reset();
+  encoded_values_ = nullptr;
+  encoded_datums_ = nullptr;
+  exception_row_ids_ = nullptr;
+  integer_range_ = 0;
+}
+
+OB_INLINE double ObALPFloatColumnEncoder::get_value_(const ObDatum &datum) const
+{
+  double value = 0;
+  if (alp_meta_.is_float()) {
+    float float_value = 0;
+    MEMCPY(&float_value, datum.ptr_, sizeof(float));
+    value = float_value;
+  } else {
+    MEMCPY(&value, datum.ptr_, sizeof(double));
+  }
+  return value;
+}
+
+OB_INLINE bool ObALPFloatColumnEncoder::encode_value_(
+    const ObDatum &datum, const int64_t exponent, const int64_t factor, int64_t &encoded) const
+{
+  bool succ = false;
+  if (alp_meta_.is_float()) {
+    float value = 0;
+    MEMCPY(&value, datum.ptr_, sizeof(float));
+    succ = ObALPFloatUtil::encode_float(value, exponent, factor, encoded);
+  } else {
+    double value = 0;
+    MEMCPY(&value, datum.ptr_, sizeof(double));
+    succ = ObALPFloatUtil::encode_double(value, exponent, factor, encoded);
+  }
+  return succ;
+}
+
+int ObALPFloatColumnEncoder::do_init_()
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(choose_exponent_and_factor_())) {
+    LOG_WARN("fail to choose exponent and factor", K(ret));
+  } else if (OB_FAIL(encode_datums_())) {
+    LOG_WARN("fail to encode datums", K(ret), K_(alp_meta));
+  } else {
+    // null is always replaced since the encoded integers are far from the int64 bound
+    int_stream_count_ = 1;
+    if (OB_FAIL(enc_ctx_.build_stream_encoder_info(
+        ctx_->null_cnt_ > 0/*has_null*/,
+        false/*not monotonic*/,
+        &ctx_->encoding_ctx_->cs_encoding_opt_,
+        ctx_->encoding_ctx_->previous_cs_encoding_.get_column_encoding(column_index_),
+        0/*stream_idx*/, ctx_->encoding_ctx_->compressor_type_, ctx_->allocator_))) {
+      LOG_WARN("fail to build_stream_encoder_info", K(ret));
+    }
+  }
+  return ret;
+}
+
+// Try every (exponent, factor) on the sample and choose the one with minimal estimated bits,
+// the encoded integers are bit packed by width of range, exceptions take the row id and raw value.
+int ObALPFloatColumnEncoder::choose_exponent_and_factor_()
+{
+  int ret = OB_SUCCESS;
+  const ObColDatums &datums = *ctx_->col_datums_;
+  const int64_t max_exponent = alp_meta_.is_float()
+      ? static_cast<int64_t>(ObALPFloatUtil::MAX_FLOAT_EXPONENT)
+      : static_cast<int64_t>(ObALPFloatUtil::MAX_DOUBLE_EXPONENT);
+  const int64_t exception_bits = (sizeof(uint32_t) + alp_meta_.get_value_size()) * CHAR_BIT;
+  const int64_t not_null_cnt = row_count_ - ctx_->null_cnt_;
+  const int64_t step = not_null_cnt > SAMPLE_CNT ? row_count_ / SAMPLE_CNT : 1;
+  const ObDatum *samples[SAMPLE_CNT];
+  int64_t sample_cnt = 0;
+  for (int64_t row_id = 0; row_id < row_count_ && sample_cnt < SAMPLE_CNT; row_id += step) {
+    if (!datums.at(row_id).is_null()) {
+      samples[sample_cnt++] = &datums.at(row_id);
+    }
+  }
+
+  int64_t best_cost = INT64_MAX;
+  for (int64_t exponent = 0; exponent <= max_exponent; ++exponent) {
+    for (int64_t factor = 0; factor <= exponent; ++factor) {
+      int64_t exception_cnt = 0;
+      int64_t min = INT64_MAX;
+      int64_t max = INT64_MIN;
+      int64_t encoded = 0;
+      for (int64_t i = 0; i < sample_cnt; ++i) {
+        if (encode_value_(*samples[i], exponent, factor, encoded)) {
+          min = MIN(min, encoded);
+          max = MAX(max, encoded);
+        } else {
+          ++exception_cnt;
+        }
+      }
+      const uint64_t range = exception_cnt == sample_cnt ? 0 : static_cast<uint64_t>(max - min);
+      const int64_t cost = ObCSEncodingUtil::get_bit_size(range) * sample_cnt
+          + exception_cnt * exception_bits;
+      // prefer the smaller exponent when the cost is same, which has smaller integers
+      if (cost < best_cost) {
+        best_cost = cost;
+        alp_meta_.exponent_ = static_cast<uint8_t>(exponent);
+        alp_meta_.factor_ = static_cast<uint8_t>(factor);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObALPFloatColumnEncoder::encode_datums_()
+{
+  int ret = OB_SUCCESS;
+  const ObColDatums &datums = *ctx_->col_datums_;
+  const int64_t exponent = alp_meta_.exponent_;
+  const int64_t factor = alp_meta_.factor_;
+  if (OB_ISNULL(encoded_values_ = static_cast<int64_t *>(
+      ctx_->allocator_->alloc(sizeof(int64_t) * row_count_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc encoded values", K(ret), K_(row_count));
+  } else if (OB_ISNULL(encoded_datums_ = static_cast<ObDatum *>(
+      ctx_->allocator_->alloc(sizeof(ObDatum) * row_count_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc encoded datums", K(ret), K_(row_count));
+  } else if (OB_ISNULL(exception_row_ids_ = static_cast<uint32_t *>(
+      ctx_->allocator_->alloc(sizeof(uint32_t) * row_count_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc exception row ids", K(ret), K_(row_count));
+  } else {
+    int64_t int_min = INT64_MAX;
+    int64_t int_max = INT64_MIN;
+    uint32_t exception_cnt = 0;
+    for (int64_t row_id = 0; row_id < row_count_; ++row_id) {
+      const ObDatum &datum = datums.at(row_id);
+      ObDatum &encoded_datum = encoded_datums_[row_id];
+      new (&encoded_datum) ObDatum();
+      if (datum.is_null()) {
+        encoded_datum.set_null();
+      } else {
+        const double value = get_value_(datum);
+        // NaN is not counted in min and max
+        if (std::isnan(value)) {
+          alp_meta_.set_has_nan();
+        } else if (!alp_meta_.has_value()) {
+          alp_meta_.min_ = value;
+          alp_meta_.max_ = value;
+          alp_meta_.set_has_value();
+        } else if (value < alp_meta_.min_) {
+          alp_meta_.min_ = value;
+        } else if (value > alp_meta_.max_) {
+          alp_meta_.max_ = value;
+        }
+        if (encode_value_(datum, exponent, factor, encoded_values_[row_id])) {
+          int_min = MIN(int_min, encoded_values_[row_id]);
+          int_max = MAX(int_max, encoded_values_[row_id]);
+        } else {
+          exception_row_ids_[exception_cnt++] = static_cast<uint32_t>(row_id);
+        }
+        encoded_datum.ptr_ = reinterpret_cast<const char *>(&encoded_values_[row_id]);
+        encoded_datum.pack_ = sizeof(int64_t);
+      }
+    }
+    if (INT64_MAX == int_min) { // all rows are null or exception
+      int_min = 0;
+      int_max = 0;
+    }
+    // fill the exception rows with a existed value to keep the range
+    for (int64_t i = 0; i < exception_cnt; ++i) {
+      encoded_values_[exception_row_ids_[i]] = int_min;
+    }
+    alp_meta_.exception_cnt_ = exception_cnt;
+
+    const bool is_replace_null = ctx_->null_cnt_ > 0;
+    const int64_t new_int_max = is_replace_null ? int_max + 1 : int_max;
+    if (OB_FAIL(enc_ctx_.build_signed_stream_meta(int_min, new_int_max, is_replace_null,
+        new_int_max, -1/*precision_width_size*/, is_force_raw_, integer_range_))) {
+      LOG_WARN("fail to build_signed_stream_meta", K(ret), K(int_min), K(new_int_max));
+    }
+  }
+  return ret;
+}
+
+int ObALPFloatColumnEncoder::store_column(ObMicroBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    // first stream offset include the column meta
+    if (OB_FAIL(store_column_meta_(buf_writer))) {
+      LOG_WARN("fail to store column meta", K(ret));
+    } else {
+      ObDatumArrayIter iter(encoded_datums_, row_count_);
+      if (OB_FAIL(integer_stream_encoder_.encode(enc_ctx_, iter, buf_writer))) {
+        LOG_WARN("fail to encode stream", K(ret), K_(enc_ctx));
+      } else if (OB_FAIL(stream_offsets_.push_back(buf_writer.length()))) {
+        LOG_WARN("fail to push back", K(ret));
+      } else {
+        int_stream_encoding_types_[0] = enc_ctx_.meta_.get_encoding_type();
+      }
+    }
+  }
+
+  return ret;
+}
+
+int ObALPFloatColumnEncoder::store_column_meta_(ObMicroBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  const ObColDatums &datums = *ctx_->col_datums_;
+  const int64_t value_size = alp_meta_.get_value_size();
+  if (OB_FAIL(store_null_bitamp(buf_writer))) {
+    LOG_WARN("fail to store null bitmap", K(ret));
+  } else if (OB_FAIL(buf_writer.write(&alp_meta_, sizeof(ObALPFloatMeta)))) {
+    LOG_WARN("fail to write alp meta", K(ret), K_(alp_meta));
+  } else if (alp_meta_.exception_cnt_ > 0
+      && OB_FAIL(buf_writer.write(exception_row_ids_, sizeof(uint32_t) * alp_meta_.exception_cnt_))) {
+    LOG_WARN("fail to write exception row ids", K(ret), K_(alp_meta));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < alp_meta_.exception_cnt_; ++i) {
+    if (OB_FAIL(buf_writer.write(datums.at(exception_row_ids_[i]).ptr_, value_size))) {
+      LOG_WARN("fail to write exception value", K(ret), K(i), K_(alp_meta));
+    }
+  }
+  return ret;
+}
+
+int64_t ObALPFloatColumnEncoder::estimate_store_size() const
+{
+  int64_t size = INT64_MAX;
+  if (!is_inited_) {
+  } else if (is_force_raw_) {
+  } else {
+    size = ObCSEncodingUtil::get_bit_size(integer_range_) * row_count_ / CHAR_BIT
+        + alp_meta_.get_size();
+  }
+  return size;
+}
+
+int ObALPFloatColumnEncoder::get_identifier_and_stream_types(
+    ObColumnEncodingIdentifier &identifier, const ObIntegerStream::EncodingType *&types) const
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    identifier.set(type_, int_stream_count_, 0);
+    types = int_stream_encoding_types_;
+  }
+  return ret;
+}
+
+int ObALPFloatColumnEncoder::get_maximal_encoding_store_size(int64_t &size) const
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    size = alp_meta_.get_size() + sizeof(ObIntegerStreamMeta) +
+        common::ObCodec::get_moderate_encoding_size(enc_ctx_.meta_.get_uint_width_size() * row_count_);
+    size = std::min(size, ObCSEncodingUtil::MAX_COLUMN_ENCODING_STORE_SIZE);
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
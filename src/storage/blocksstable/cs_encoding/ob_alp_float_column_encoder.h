@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_ALP_FLOAT_COLUMN_ENCODER_H_
+#define OCEANBASE_ENCODING_OB_ALP_FLOAT_COLUMN_ENCODER_H_
+
+#include "ob_icolumn_cs_encoder.h"
+#include "ob_integer_stream_encoder.h"
+#include "ob_alp_float_util.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// Encode float and double column as decimal integers with one integer stream,
+// see ObALPFloatUtil for the details.
+class ObALPFloatColumnEncoder : public ObIColumnCSEncoder
+{
+public:
+  static const ObCSColumnHeader::Type type_ = ObCSColumnHeader::ALP_FLOAT;
+  // number of not null values used to choose exponent and factor
+  static const int64_t SAMPLE_CNT = 64;
+
+  ObALPFloatColumnEncoder();
+  virtual ~ObALPFloatColumnEncoder();
+
+  ObALPFloatColumnEncoder(const ObALPFloatColumnEncoder&) = delete;
+  ObALPFloatColumnEncoder &operator=(const ObALPFloatColumnEncoder&) = delete;
+
+  static bool is_applicable(const ObColumnCSEncodingCtx &ctx, const common::ObObjMeta &column_type);
+
+  int init(
+    const ObColumnCSEncodingCtx &ctx, const int64_t column_index, const int64_t row_count) override;
+  void reuse() override;
+  int store_column(ObMicroBufferWriter &buf_writer) override;
+  int64_t estimate_store_size() const override;
+  ObCSColumnHeader::Type get_type() const override { return type_; }
+  int get_identifier_and_stream_types(
+      ObColumnEncodingIdentifier &identifier, const ObIntegerStream::EncodingType *&types) const override;
+  int get_maximal_encoding_store_size(int64_t &size) const override;
+  int get_string_data_len(uint32_t &len) const override
+  {
+    len = 0;
+    return OB_SUCCESS;
+  }
+
+  INHERIT_TO_STRING_KV("ICSColumnEncoder", ObIColumnCSEncoder,
+    K_(alp_meta), K_(enc_ctx), K_(integer_range));
+
+private:
+  int do_init_();
+  int choose_exponent_and_factor_();
+  int encode_datums_();
+  int store_column_meta_(ObMicroBufferWriter &buf_writer);
+  OB_INLINE double get_value_(const ObDatum &datum) const;
+  OB_INLINE bool encode_value_(const ObDatum &datum, const int64_t exponent,
+                               const int64_t factor, int64_t &encoded) const;
+
+private:
+  ObALPFloatMeta alp_meta_;
+  ObIntegerStreamEncoderCtx enc_ctx_;
+  ObIntegerStreamEncoder integer_stream_encoder_;
+  int64_t *encoded_values_;
+  ObDatum *encoded_datums_;
+  uint32_t *exception_row_ids_;
+  uint64_t integer_range_;
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_ENCODING_OB_ALP_FLOAT_COLUMN_ENCODER_H_
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_ALP_FLOAT_UTIL_H_
+#define OCEANBASE_ENCODING_OB_ALP_FLOAT_UTIL_H_
+
+#include <cmath>
+#include "lib/ob_define.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// Column meta of ALP_FLOAT column, stored after the null bitmap.
+// Layout: ObALPFloatMeta | uint32_t exception_row_ids[exception_cnt] | values[exception_cnt],
+// exception values are the original float or double bits, all fields may be unaligned.
+struct ObALPFloatMeta final
+{
+  static constexpr uint8_t OB_ALP_FLOAT_META_V1 = 0;
+  enum Attribute
+  {
+    IS_FLOAT = 0x1,
+    HAS_VALUE = 0x2, // min_ and max_ are valid, false if all rows are null or NaN
+    HAS_NAN = 0x4, // NaN is not counted in min_ and max_
+  };
+  ObALPFloatMeta()
+    : version_(OB_ALP_FLOAT_META_V1), attrs_(0), exponent_(0), factor_(0),
+      exception_cnt_(0), min_(0), max_(0) {}
+  void reuse(const bool is_float)
+  {
+    version_ = OB_ALP_FLOAT_META_V1;
+    attrs_ = is_float ? IS_FLOAT : 0;
+    exponent_ = 0;
+    factor_ = 0;
+    exception_cnt_ = 0;
+    min_ = 0;
+    max_ = 0;
+  }
+
+  OB_INLINE bool is_float() const { return attrs_ & IS_FLOAT; }
+  OB_INLINE void set_is_float() { attrs_ |= IS_FLOAT; }
+  OB_INLINE bool has_value() const { return attrs_ & HAS_VALUE; }
+  OB_INLINE void set_has_value() { attrs_ |= HAS_VALUE; }
+  OB_INLINE bool has_nan() const { return attrs_ & HAS_NAN; }
+  OB_INLINE void set_has_nan() { attrs_ |= HAS_NAN; }
+  OB_INLINE int64_t get_value_size() const { return is_float() ? sizeof(float) : sizeof(double); }
+
+  static OB_INLINE int64_t get_size(const int64_t exception_cnt, const int64_t value_size)
+  {
+    return sizeof(ObALPFloatMeta) + exception_cnt * (sizeof(uint32_t) + value_size);
+  }
+  OB_INLINE int64_t get_size() const { return get_size(exception_cnt_, get_value_size()); }
+  OB_INLINE const char *get_exception_row_ids() const
+  {
+    return reinterpret_cast<const char *>(this) + sizeof(ObALPFloatMeta);
+  }
+  OB_INLINE const char *get_exception_values() const
+  {
+    return get_exception_row_ids() + exception_cnt_ * sizeof(uint32_t);
+  }
+
+  TO_STRING_KV(K_(version), K_(attrs), K_(exponent), K_(factor), K_(exception_cnt), K_(min), K_(max));
+
+  uint8_t version_;
+  uint8_t attrs_; // bitwise-or of Attribute
+  uint8_t exponent_;
+  uint8_t factor_;
+  uint32_t exception_cnt_;
+  double min_; // min of not null and not NaN values, exceptions included
+  double max_;
+} __attribute__((packed));
+
+// ALP(Adaptive Lossless floating-Point) encodes a decimal-like value v as the integer
+// n = round(v * 10^e * 10^-f), and restores it by n * 10^f * 10^-e. One pair of (e, f)
+// is chosen for a micro block, values which can not be restored bit by bit (such as
+// NaN, inf, -0.0 and values with too many significant digits) are kept as exceptions.
+class ObALPFloatUtil
+{
+public:
+  static const int64_t MAX_DOUBLE_EXPONENT = 18;
+  static const int64_t MAX_FLOAT_EXPONENT = 10;
+  // adding and subtracting ROUND_MAGIC rounds a double to integer when its absolute value
+  // is less than ENCODE_LIMIT
+  static constexpr double ENCODE_LIMIT = 2251799813685248.0; // 2^51
+  static constexpr double ROUND_MAGIC = 6755399441055744.0; // 2^52 + 2^51
+
+  // same as the datum compare of float and double: NaN is bigger than any number
+  // and equal to NaN, so filter results of pushdown are the same as sql
+  static OB_INLINE int compare(const double l, const double r)
+  {
+    int cmp_ret = 0;
+    if (std::isnan(l) || std::isnan(r)) {
+      cmp_ret = std::isnan(l) ? (std::isnan(r) ? 0 : 1) : -1;
+    } else {
+      cmp_ret = l < r ? -1 : (l == r ? 0 : 1);
+    }
+    return cmp_ret;
+  }
+
+  static OB_INLINE double exp10(const int64_t i)
+  {
+    static const double EXP10[] = {
+      1.0, 10.0, 100.0, 1000.0, 10000.0, 100000.0, 1000000.0, 10000000.0, 100000000.0,
+      1000000000.0, 10000000000.0, 100000000000.0, 1000000000000.0, 10000000000000.0,
+      100000000000000.0, 1000000000000000.0, 10000000000000000.0, 100000000000000000.0,
+      1000000000000000000.0
+    };
+    return EXP10[i];
+  }
+  static OB_INLINE double frac10(const int64_t i)
+  {
+    static const double FRAC10[] = {
+      1.0, 0.1, 0.01, 0.001, 0.0001, 0.00001, 0.000001, 0.0000001, 0.00000001,
+      0.000000001, 0.0000000001, 0.00000000001, 0.000000000001, 0.0000000000001,
+      0.00000000000001, 0.000000000000001, 0.0000000000000001, 0.00000000000000001,
+      0.000000000000000001
+    };
+    return FRAC10[i];
+  }
+
+  static OB_INLINE double decode(const int64_t encoded, const int64_t exponent, const int64_t factor)
+  {
+    return static_cast<double>(encoded) * exp10(factor) * frac10(exponent);
+  }
+
+  // return false if %value can not be restored from the encoded integer
+  static OB_INLINE bool encode_double(
+      const double value, const int64_t exponent, const int64_t factor, int64_t &encoded)
+  {
+    bool succ = false;
+    const double scaled = value * exp10(exponent) * frac10(factor);
+    // NaN fails the range check
+    if (scaled < ENCODE_LIMIT && scaled > -ENCODE_LIMIT) {
+      encoded = static_cast<int64_t>(scaled + ROUND_MAGIC - ROUND_MAGIC);
+      const double restored = decode(encoded, exponent, factor);
+      succ = 0 == MEMCMP(&restored, &value, sizeof(double));
+    }
+    return succ;
+  }
+
+  static OB_INLINE bool encode_float(
+      const float value, const int64_t exponent, const int64_t factor, int64_t &encoded)
+  {
+    bool succ = false;
+    const double scaled = static_cast<double>(value) * exp10(exponent) * frac10(factor);
+    if (scaled < ENCODE_LIMIT && scaled > -ENCODE_LIMIT) {
+      encoded = static_cast<int64_t>(scaled + ROUND_MAGIC - ROUND_MAGIC);
+      const float restored = static_cast<float>(decode(encoded, exponent, factor));
+      succ = 0 == MEMCMP(&restored, &value, sizeof(float));
+    }
+    return succ;
+  }
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_ENCODING_OB_ALP_FLOAT_UTIL_H_
@@ -47,5 +47,19 @@ int ObDictDatumIter::get_next(const ObDatum *&datum)
   return ret;
 }
 
+int ObDatumArrayIter::get_next(const ObDatum *&datum)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(count_ == idx_)) {
+    ret = OB_ITER_END;
+  } else {
+    datum = datums_ + idx_;
+    idx_++;
+  }
+
+  return ret;
+}
+
 }  // namespace blocksstable
 }  // namespace oceanbase
@@ -67,6 +67,25 @@ private:
   ObEncodingHashTable::ConstIterator iter_;
 };
 
+class ObDatumArrayIter : public ObIDatumIter
+{
+public:
+  ObDatumArrayIter(const ObDatum *datums, const int64_t count)
+    : datums_(datums), count_(count), idx_(0) { }
+  ~ObDatumArrayIter() {}
+  ObDatumArrayIter(const ObDatumArrayIter&) = delete;
+  ObDatumArrayIter &operator=(const ObDatumArrayIter&) = delete;
+
+  int get_next(const ObDatum *&datum) override;
+  int64_t size() const override { return count_; }
+  virtual void reset() override { idx_ = 0; }
+
+private:
+  const ObDatum *datums_;
+  int64_t count_;
+  int64_t idx_;
+};
+
 
 }  // namespace blocksstable
 }  // namespace oceanbase
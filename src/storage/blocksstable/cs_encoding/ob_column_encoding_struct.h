@@ -36,6 +36,8 @@ struct ObCSColumnHeader
     STRING = 1,
     INT_DICT = 2,
     STR_DICT = 3,
+    FSST_STRING = 4,
+    ALP_FLOAT = 5,
     MAX_TYPE
   };
 
@@ -46,6 +48,8 @@ struct ObCSColumnHeader
       case STRING :  { return "STRING"; }
       case INT_DICT: { return "INT_DICT"; }
       case STR_DICT: { return "STR_DICT"; }
+      case FSST_STRING: { return "FSST_STRING"; }
+      case ALP_FLOAT: { return "ALP_FLOAT"; }
       default:       { return "MAX_TYPE"; }
     }
   }
@@ -161,6 +165,7 @@ struct ObDictEncodingMeta final
     IS_SORTED = 0x1,
     HAS_NULL = 0x2,
     CONST_ENCODING_REF = 0x4,
+    SHARED_DICT = 0x8, // dict values are in the shared dict of macro block, see ObCSSharedDictBuilder
   };
   ObDictEncodingMeta()
     : version_(OB_DICT_ENCODING_META_V1), attrs_(0),
@@ -183,6 +188,8 @@ struct ObDictEncodingMeta final
     // 1(exception_cnt) + 1(const_ref) + exception_cnt(exception_row_ids) + exception_cnt(exception_refs)
     ref_row_cnt_ = 2 + 2 * exception_cnt;
   }
+  bool is_shared_dict() const { return attrs_ & SHARED_DICT; }
+  void set_shared_dict() { attrs_ |= SHARED_DICT; }
 
   uint8_t version_;
   uint8_t attrs_; // bitwise-or of Attribute
@@ -408,6 +415,26 @@ struct ObStringColumnDecoderCtx : public ObBaseColumnDecoderCtx
       KP_(str_data), KPC_(str_ctx), KP_(offset_data), KPC_(offset_ctx), K_(need_copy));
 };
 
+struct ObFSSTSymbolTableMeta;
+struct ObFSSTStringColumnDecoderCtx : public ObStringColumnDecoderCtx
+{
+  ObFSSTStringColumnDecoderCtx()
+    : ObStringColumnDecoderCtx(), symbol_table_(nullptr) {}
+  const ObFSSTSymbolTableMeta *symbol_table_; // point to column meta, after the null bitmap
+
+  INHERIT_TO_STRING_KV("ObStringColumnDecoderCtx", ObStringColumnDecoderCtx, KP_(symbol_table));
+};
+
+struct ObALPFloatMeta;
+struct ObALPFloatColumnDecoderCtx : public ObIntegerColumnDecoderCtx
+{
+  ObALPFloatColumnDecoderCtx()
+    : ObIntegerColumnDecoderCtx(), alp_meta_(nullptr) {}
+  const ObALPFloatMeta *alp_meta_; // point to column meta, after the null bitmap
+
+  INHERIT_TO_STRING_KV("ObIntegerColumnDecoderCtx", ObIntegerColumnDecoderCtx, KP_(alp_meta));
+};
+
 struct ObDictColumnDecoderCtx : public ObBaseColumnDecoderCtx
 {
   ObDictColumnDecoderCtx()
@@ -451,12 +478,16 @@ struct ObColumnCSDecoderCtx
     ObIntegerColumnDecoderCtx integer_ctx_;
     ObStringColumnDecoderCtx string_ctx_;
     ObDictColumnDecoderCtx dict_ctx_;
+    ObFSSTStringColumnDecoderCtx fsst_string_ctx_;
+    ObALPFloatColumnDecoderCtx alp_float_ctx_;
   };
   void reset() { MEMSET(this, 0, sizeof(ObColumnCSDecoderCtx));}
   OB_INLINE bool is_integer_type() const { return ObCSColumnHeader::INTEGER == type_; }
   OB_INLINE bool is_string_type() const { return ObCSColumnHeader::STRING == type_; }
   OB_INLINE bool is_int_dict_type() const { return ObCSColumnHeader::INT_DICT == type_; }
   OB_INLINE bool is_string_dict_type() const { return ObCSColumnHeader::STR_DICT == type_; }
+  OB_INLINE bool is_fsst_string_type() const { return ObCSColumnHeader::FSST_STRING == type_; }
+  OB_INLINE bool is_alp_float_type() const { return ObCSColumnHeader::ALP_FLOAT == type_; }
 
   ObBaseColumnDecoderCtx& get_base_ctx()
   {
@@ -467,6 +498,10 @@ struct ObColumnCSDecoderCtx
       base_ctx = &string_ctx_;
     } else if (is_int_dict_type() || is_string_dict_type()) {
       base_ctx = &dict_ctx_;
+    } else if (is_fsst_string_type()) {
+      base_ctx = &fsst_string_ctx_;
+    } else if (is_alp_float_type()) {
+      base_ctx = &alp_float_ctx_;
     }
     return *base_ctx;
   }
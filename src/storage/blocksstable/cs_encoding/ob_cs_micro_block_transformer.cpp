@@ -16,6 +16,9 @@
 #include "lib/compress/ob_compressor_pool.h"
 #include "ob_int_dict_column_encoder.h"
 #include "ob_str_dict_column_encoder.h"
+#include "ob_fsst_symbol_table.h"
+#include "ob_alp_float_util.h"
+#include "ob_cs_shared_dict.h"
 #include "ob_cs_encoding_util.h"
 #include "ob_cs_decoding_util.h"
 #include "storage/blocksstable/ob_sstable_printer.h"
@@ -283,6 +286,37 @@ int ObCSMicroBlockTransformer::build_original_transform_desc_(
         }
         pre_streams_len = stream_offsets_arr_[stream_idx] - first_stream_begin_offset;
 
+      } else if (ObCSColumnHeader::Type::FSST_STRING == column_header.type_) {
+        // column meta is null bitmap + symbol table, streams are same as variable length string
+        const int64_t bitmap_size = column_header.has_null_bitmap()
+          ? ObCSEncodingUtil::get_bitmap_byte_size(header_->row_count_)
+          : 0;
+        original_desc_.column_meta_pos_arr_[i].offset_ = column_meta_begin_offset_ + pre_streams_len;
+        const ObFSSTSymbolTableMeta *symbol_table = reinterpret_cast<const ObFSSTSymbolTableMeta *>(
+          payload_buf_ + original_desc_.column_meta_pos_arr_[i].offset_ + bitmap_size);
+        original_desc_.column_meta_pos_arr_[i].len_ = bitmap_size + symbol_table->get_size();
+        stream_idx = stream_idx + 1;
+        original_desc_.column_first_stream_idx_arr_[i] = stream_idx;
+        stream_idx = stream_idx + 1;
+        original_desc_.set_is_integer_stream(stream_idx);
+        stream_row_cnt_arr_[stream_idx] = header_->row_count_;
+        pre_streams_len = stream_offsets_arr_[stream_idx] - first_stream_begin_offset;
+
+      } else if (ObCSColumnHeader::Type::ALP_FLOAT == column_header.type_) {
+        // column meta is null bitmap + alp meta with exceptions, stream is same as integer
+        const int64_t bitmap_size = column_header.has_null_bitmap()
+          ? ObCSEncodingUtil::get_bitmap_byte_size(header_->row_count_)
+          : 0;
+        original_desc_.column_meta_pos_arr_[i].offset_ = column_meta_begin_offset_ + pre_streams_len;
+        const ObALPFloatMeta *alp_meta = reinterpret_cast<const ObALPFloatMeta *>(
+          payload_buf_ + original_desc_.column_meta_pos_arr_[i].offset_ + bitmap_size);
+        original_desc_.column_meta_pos_arr_[i].len_ = bitmap_size + alp_meta->get_size();
+        stream_idx = stream_idx + 1;
+        original_desc_.column_first_stream_idx_arr_[i] = stream_idx;
+        original_desc_.set_is_integer_stream(stream_idx);
+        stream_row_cnt_arr_[stream_idx] = header_->row_count_;
+        pre_streams_len = stream_offsets_arr_[stream_idx] - first_stream_begin_offset;
+
       } else if (ObCSColumnHeader::Type::INT_DICT == column_header.type_) {
         original_desc_.column_meta_pos_arr_[i].offset_ = column_meta_begin_offset_ + pre_streams_len;
         // must has no null bitmap for dict encoding
@@ -317,6 +351,13 @@ int ObCSMicroBlockTransformer::build_original_transform_desc_(
           // or the stream count if this column is the last column.
           original_desc_.column_first_stream_idx_arr_[i] = stream_idx + 1;
           pre_streams_len += sizeof(ObDictEncodingMeta);
+        } else if (dict_meta->is_shared_dict()) {
+          // dict values are in the shared dict of macro block, only has dict ref stream
+          stream_idx = stream_idx + 1;
+          original_desc_.column_first_stream_idx_arr_[i] = stream_idx;
+          original_desc_.set_is_integer_stream(stream_idx);
+          stream_row_cnt_arr_[stream_idx] = dict_meta->ref_row_cnt_;
+          pre_streams_len = stream_offsets_arr_[stream_idx] - first_stream_begin_offset;
         } else {
           // is string dict, bytes stream has nothing to set, keep default value
           stream_idx = stream_idx + 1;
@@ -1189,6 +1230,38 @@ int ObCSMicroBlockTransformHelper::build_column_decoder_ctx(
         }
         break;
       }
+      case ObCSColumnHeader::Type::FSST_STRING : {
+        ObFSSTStringColumnDecoderCtx &fsst_ctx = decoder_ctx.fsst_string_ctx_;
+        if (OB_FAIL(build_string_column_decoder_ctx_(obj_meta, col_first_stream_idx,
+            col_end_stream_idx, col_idx, fsst_ctx))) {
+          LOG_WARN("fail to build_fsst_string_decoder_ctx",
+              K(ret), K(col_first_stream_idx), K(col_end_stream_idx), K(col_idx),
+              "transform_desc", ObMicroBlockTransformDescPrinter(col_cnt, stream_cnt, transform_desc_));
+        } else {
+          const int64_t bitmap_size = fsst_ctx.col_header_->has_null_bitmap()
+            ? ObCSEncodingUtil::get_bitmap_byte_size(fsst_ctx.micro_block_header_->row_count_)
+            : 0;
+          fsst_ctx.symbol_table_ = reinterpret_cast<const ObFSSTSymbolTableMeta *>(
+            get_column_meta(col_idx) + bitmap_size);
+        }
+        break;
+      }
+      case ObCSColumnHeader::Type::ALP_FLOAT : {
+        ObALPFloatColumnDecoderCtx &alp_ctx = decoder_ctx.alp_float_ctx_;
+        if (OB_FAIL(build_integer_column_decoder_ctx_(obj_meta, col_first_stream_idx,
+            col_end_stream_idx, col_idx, alp_ctx))) {
+          LOG_WARN("fail to build_alp_float_decoder_ctx", K(ret), K(col_first_stream_idx),
+              K(col_end_stream_idx), K(col_idx),
+              "transform_desc", ObMicroBlockTransformDescPrinter(col_cnt, stream_cnt, transform_desc_));
+        } else {
+          const int64_t bitmap_size = alp_ctx.col_header_->has_null_bitmap()
+            ? ObCSEncodingUtil::get_bitmap_byte_size(alp_ctx.micro_block_header_->row_count_)
+            : 0;
+          alp_ctx.alp_meta_ = reinterpret_cast<const ObALPFloatMeta *>(
+            get_column_meta(col_idx) + bitmap_size);
+        }
+        break;
+      }
       case ObCSColumnHeader::Type::INT_DICT : {
         if (OB_FAIL(build_integer_dict_decoder_ctx_(obj_meta, col_first_stream_idx,
             col_end_stream_idx, col_idx, decoder_ctx.dict_ctx_))) {
@@ -1424,6 +1497,37 @@ int ObCSMicroBlockTransformHelper::build_string_dict_decoder_ctx_(const ObObjMet
     }
     if (col_stream_cnt == 0) {  // empty dict, has no stream
       // set nothing
+    } else if (col_stream_cnt == 1) {
+      // shared dict, dict values are in the shared dict of macro block, only has ref_stream
+      const ObCSSharedDictColumn *shared_dict = nullptr;
+      GET_STREAM_BUF(col_first_stream_idx);
+      if (OB_FAIL(ret)) {
+      } else if (OB_UNLIKELY(!ctx.dict_meta_->is_shared_dict())) {
+        ret = OB_INNER_STAT_ERROR;
+        LOG_WARN("dict string has one stream, must be shared dict", K(ret), KPC(ctx.dict_meta_));
+      } else if (OB_ISNULL(block_data_.shared_dict_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("shared dict of micro block is not provided", K(ret), K(col_idx), K_(block_data));
+      } else if (OB_FAIL(block_data_.shared_dict_->get_column_dict(col_idx, shared_dict))) {
+        LOG_WARN("fail to get shared dict", K(ret), K(col_idx));
+      } else if (OB_ISNULL(shared_dict) || OB_UNLIKELY(shared_dict->dict_cnt_ < ctx.dict_meta_->distinct_val_cnt_)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("shared dict not match", K(ret), K(col_idx), KPC(shared_dict), KPC(ctx.dict_meta_));
+      } else {
+        const ObObjTypeStoreClass store_class =
+            get_store_class_map()[ob_obj_type_class(static_cast<common::ObObjType>(ctx.col_header_->obj_type_))];
+        ctx.need_copy_ = ObCSEncodingUtil::is_store_class_need_copy(store_class);
+        ctx.str_ctx_ = &shared_dict->str_ctx_;
+        ctx.str_data_ = shared_dict->str_data_;
+        ctx.offset_ctx_ = &shared_dict->offset_ctx_;
+        ctx.offset_data_ = shared_dict->offset_data_;
+        ctx.ref_ctx_ = reinterpret_cast<const ObIntegerStreamDecoderCtx *>(ctx_buf +
+            transform_desc_.column_first_stream_decoding_ctx_offset_arr_[col_idx]);
+        ctx.ref_data_ = buf + transform_desc_.stream_data_pos_arr_[col_first_stream_idx].offset_;
+
+        LOG_TRACE("build_string_dict_decoder_ctx",
+            K(col_first_stream_idx), K(col_end_stream_idx), K(col_idx), K(ctx));
+      }
     } else if (col_stream_cnt == 2) {
       GET_STREAM_BUF(col_first_stream_idx);
       if (OB_SUCC(ret)) {
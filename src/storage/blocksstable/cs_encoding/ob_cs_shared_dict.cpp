@@ -0,0 +1,467 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_cs_shared_dict.h"
+#include "lib/checksum/ob_crc64.h"
+#include "share/config/ob_server_config.h"
+#include "share/rc/ob_tenant_base.h"
+#include "storage/blocksstable/encoding/ob_encoding_hash_util.h"
+#include "storage/blocksstable/ob_data_store_desc.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+using namespace common;
+
+//========================== ObCSSharedDictColumn ===================================//
+void ObCSSharedDictColumn::reset()
+{
+  dict_cnt_ = 0;
+  offset_data_ = nullptr;
+  str_data_ = nullptr;
+  str_ctx_.meta_.reset();
+  offset_ctx_.meta_.reset();
+  offset_ctx_.count_ = 0;
+  offset_ctx_.compressor_type_ = ObCompressorType::NONE_COMPRESSOR;
+}
+
+void ObCSSharedDictColumn::set(
+    const uint32_t dict_cnt,
+    const char *offset_data,
+    const char *str_data,
+    const uint32_t str_len)
+{
+  dict_cnt_ = dict_cnt;
+  offset_data_ = offset_data;
+  str_data_ = str_data;
+  str_ctx_.meta_.reset();
+  str_ctx_.meta_.uncompressed_len_ = str_len;
+  offset_ctx_.meta_.reset();
+  offset_ctx_.meta_.set_raw_encoding();
+  offset_ctx_.meta_.set_4_byte_width();
+  offset_ctx_.count_ = dict_cnt;
+  offset_ctx_.compressor_type_ = ObCompressorType::NONE_COMPRESSOR;
+}
+
+//========================== ObCSSharedDictReader ===================================//
+ObCSSharedDictReader::ObCSSharedDictReader()
+  : column_cnt_(0), is_inited_(false)
+{
+}
+
+void ObCSSharedDictReader::reset()
+{
+  for (int64_t i = 0; i < column_cnt_; ++i) {
+    columns_[i].reset();
+  }
+  column_cnt_ = 0;
+  is_inited_ = false;
+}
+
+int ObCSSharedDictReader::init(const char *buf, const int64_t buf_len)
+{
+  int ret = OB_SUCCESS;
+  const ObCSSharedDictHeader *header = nullptr;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len < static_cast<int64_t>(sizeof(ObCSSharedDictHeader)))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(buf_len));
+  } else if (FALSE_IT(header = reinterpret_cast<const ObCSSharedDictHeader *>(buf))) {
+  } else if (OB_UNLIKELY(!header->is_valid()
+      || header->column_cnt_ > static_cast<uint32_t>(MAX_COLUMN_CNT)
+      || static_cast<int64_t>(sizeof(ObCSSharedDictHeader)
+          + header->column_cnt_ * sizeof(ObCSSharedDictColumnMeta)) > buf_len)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid shared dict header", K(ret), KPC(header), K(buf_len));
+  } else if (OB_UNLIKELY(header->data_checksum_ != static_cast<int64_t>(ob_crc64(
+      buf + sizeof(ObCSSharedDictHeader), buf_len - sizeof(ObCSSharedDictHeader))))) {
+    ret = OB_CHECKSUM_ERROR;
+    LOG_ERROR("shared dict checksum error", K(ret), KPC(header), K(buf_len));
+  } else {
+    const ObCSSharedDictColumnMeta *metas =
+        reinterpret_cast<const ObCSSharedDictColumnMeta *>(buf + sizeof(ObCSSharedDictHeader));
+    for (int64_t i = 0; OB_SUCC(ret) && i < header->column_cnt_; ++i) {
+      const ObCSSharedDictColumnMeta &meta = metas[i];
+      if (OB_UNLIKELY(meta.data_offset_ + meta.get_column_data_size() > buf_len)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("invalid shared dict column meta", K(ret), K(i), K(meta), K(buf_len));
+      } else {
+        const char *offset_data = buf + meta.data_offset_;
+        column_idxs_[i] = meta.column_idx_;
+        columns_[i].set(meta.dict_cnt_, offset_data,
+            offset_data + meta.dict_cnt_ * sizeof(uint32_t), meta.data_len_);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      column_cnt_ = header->column_cnt_;
+      is_inited_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObCSSharedDictReader::get_column_dict(const int64_t col_idx, const ObCSSharedDictColumn *&col) const
+{
+  int ret = OB_SUCCESS;
+  col = nullptr;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    for (int64_t i = 0; nullptr == col && i < column_cnt_; ++i) {
+      if (col_idx == column_idxs_[i]) {
+        col = &columns_[i];
+      }
+    }
+  }
+  return ret;
+}
+
+//========================== ObCSSharedDictBuilder ===================================//
+void ObCSSharedDictBuilder::ColumnDict::reset()
+{
+  column_idx_ = -1;
+  committed_cnt_ = 0;
+  cnt_ = 0;
+  offsets_ = nullptr;
+  data_ = nullptr;
+  value_map_ = nullptr;
+  view_.reset();
+}
+
+void ObCSSharedDictBuilder::ColumnDict::refresh_view()
+{
+  view_.set(cnt_, reinterpret_cast<const char *>(offsets_), data_, get_data_len(cnt_));
+}
+
+bool ObCSSharedDictBuilder::is_enabled(const ObDataStoreDesc &desc, const bool has_flush_callback)
+{
+  // servers of older data version can not read the shared dict position in macro block header
+  return GCONF._enable_cs_shared_dict
+      && desc.is_major_merge_type()
+      && desc.get_major_working_cluster_version() >= DATA_VERSION_4_3_2_0
+      && ObStoreFormat::is_row_store_type_with_cs_encoding(desc.get_row_store_type())
+      && desc.get_encrypt_id() <= 0
+      && !has_flush_callback;
+}
+
+ObCSSharedDictBuilder::ObCSSharedDictBuilder()
+  : allocator_(nullptr), column_cnt_(0), committed_column_cnt_(0), committed_size_(0),
+    is_inited_(false)
+{
+}
+
+ObCSSharedDictBuilder::~ObCSSharedDictBuilder()
+{
+  reset();
+}
+
+int ObCSSharedDictBuilder::init(ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else {
+    allocator_ = &allocator;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObCSSharedDictBuilder::reset()
+{
+  for (int64_t i = 0; i < column_cnt_; ++i) {
+    ColumnDict &col = columns_[i];
+    if (nullptr != col.value_map_) {
+      col.value_map_->~ValueMap();
+    }
+    if (nullptr != allocator_) {
+      allocator_->free(col.value_map_);
+      allocator_->free(col.offsets_);
+      allocator_->free(col.data_);
+    }
+    col.reset();
+  }
+  allocator_ = nullptr;
+  column_cnt_ = 0;
+  committed_column_cnt_ = 0;
+  committed_size_ = 0;
+  is_inited_ = false;
+}
+
+const ObCSSharedDictBuilder::ColumnDict *ObCSSharedDictBuilder::find_column_(const int64_t col_idx) const
+{
+  const ColumnDict *col = nullptr;
+  for (int64_t i = 0; nullptr == col && i < column_cnt_; ++i) {
+    if (col_idx == columns_[i].column_idx_) {
+      col = &columns_[i];
+    }
+  }
+  return col;
+}
+
+int ObCSSharedDictBuilder::get_or_create_column_(const int64_t col_idx, ColumnDict *&col)
+{
+  int ret = OB_SUCCESS;
+  void *map_buf = nullptr;
+  col = const_cast<ColumnDict *>(find_column_(col_idx));
+  if (nullptr != col) {
+  } else if (OB_UNLIKELY(column_cnt_ >= MAX_COLUMN_CNT)) {
+    ret = OB_SIZE_OVERFLOW;
+    LOG_WARN("too many shared dict columns", K(ret), K(col_idx), K_(column_cnt));
+  } else {
+    ColumnDict &new_col = columns_[column_cnt_];
+    if (OB_ISNULL(new_col.offsets_ = static_cast<uint32_t *>(
+        allocator_->alloc(sizeof(uint32_t) * MAX_DICT_CNT)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc dict offsets", K(ret));
+    } else if (OB_ISNULL(new_col.data_ = static_cast<char *>(allocator_->alloc(MAX_DICT_DATA_LEN)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc dict data", K(ret));
+    } else if (OB_ISNULL(map_buf = allocator_->alloc(sizeof(ValueMap)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc dict value map", K(ret));
+    } else if (FALSE_IT(new_col.value_map_ = new (map_buf) ValueMap())) {
+    } else if (OB_FAIL(new_col.value_map_->create(MAX_DICT_CNT, ObMemAttr(MTL_ID(), "CSSharedDict")))) {
+      LOG_WARN("fail to create dict value map", K(ret));
+    } else {
+      new_col.column_idx_ = col_idx;
+      new_col.refresh_view();
+      col = &new_col;
+    }
+    // the slot is always kept, reset() releases its memory
+    ++column_cnt_;
+  }
+  return ret;
+}
+
+int ObCSSharedDictBuilder::check_column(
+    const int64_t col_idx,
+    const ObEncodingHashTable &ht,
+    bool &is_shared,
+    int64_t &dict_cnt) const
+{
+  int ret = OB_SUCCESS;
+  is_shared = false;
+  dict_cnt = 0;
+  const ColumnDict *col = nullptr;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (FALSE_IT(col = find_column_(col_idx))) {
+  } else if (nullptr == col && column_cnt_ >= MAX_COLUMN_CNT) {
+    // no slot for a new column
+  } else {
+    int64_t new_cnt = 0;
+    int64_t new_len = 0;
+    FOREACH(l, ht) {
+      const ObString str = l->header_->datum_->get_string();
+      uint32_t ref = 0;
+      if (nullptr == col || OB_SUCCESS != col->value_map_->get_refactored(str, ref)) {
+        ++new_cnt;
+        new_len += str.length();
+      }
+    }
+    const int64_t cnt = (nullptr == col ? 0 : col->cnt_) + new_cnt;
+    const int64_t data_len = (nullptr == col ? 0 : col->get_data_len(col->cnt_)) + new_len;
+    if (cnt <= MAX_DICT_CNT && data_len <= MAX_DICT_DATA_LEN) {
+      is_shared = true;
+      dict_cnt = cnt;
+    }
+  }
+  return ret;
+}
+
+int ObCSSharedDictBuilder::append_column(
+    const int64_t col_idx,
+    ObEncodingHashTable &ht,
+    int64_t &dict_cnt)
+{
+  int ret = OB_SUCCESS;
+  ColumnDict *col = nullptr;
+  dict_cnt = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_FAIL(get_or_create_column_(col_idx, col))) {
+    LOG_WARN("fail to get shared dict column", K(ret), K(col_idx));
+  } else {
+    FOREACH_X(l, ht, OB_SUCC(ret)) {
+      const ObString str = l->header_->datum_->get_string();
+      uint32_t ref = 0;
+      if (OB_SUCC(col->value_map_->get_refactored(str, ref))) {
+      } else if (OB_UNLIKELY(OB_HASH_NOT_EXIST != ret)) {
+        LOG_WARN("fail to get dict value", K(ret), K(str));
+      } else {
+        const uint32_t start = col->get_data_len(col->cnt_);
+        if (OB_UNLIKELY(col->cnt_ >= MAX_DICT_CNT || start + str.length() > MAX_DICT_DATA_LEN)) {
+          ret = OB_SIZE_OVERFLOW;
+          LOG_WARN("shared dict is full", K(ret), K(col_idx), K(col->cnt_), K(start), K(str.length()));
+        } else if (FALSE_IT(MEMCPY(col->data_ + start, str.ptr(), str.length()))) {
+        } else if (OB_FAIL(col->value_map_->set_refactored(
+            ObString(static_cast<int64_t>(str.length()), col->data_ + start), col->cnt_))) {
+          LOG_WARN("fail to add dict value", K(ret), K(str));
+        } else {
+          ref = col->cnt_;
+          col->offsets_[col->cnt_++] = start + str.length();
+        }
+      }
+      if (OB_SUCC(ret)) {
+        FOREACH(n, *l) {
+          n->dict_ref_ = ref;
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      FOREACH(n, ht.get_null_list()) {
+        n->dict_ref_ = col->cnt_;
+      }
+      dict_cnt = col->cnt_;
+    }
+    col->refresh_view();
+  }
+  return ret;
+}
+
+void ObCSSharedDictBuilder::reset_pending()
+{
+  for (int64_t i = 0; i < column_cnt_; ++i) {
+    ColumnDict &col = columns_[i];
+    if (col.cnt_ > col.committed_cnt_) {
+      for (uint32_t j = col.committed_cnt_; j < col.cnt_; ++j) {
+        const uint32_t start = col.get_data_len(j);
+        // erase fails only if the value is not in map, which is harmless
+        IGNORE_RETURN col.value_map_->erase_refactored(ObString(
+            static_cast<int64_t>(col.offsets_[j] - start), col.data_ + start));
+      }
+      col.cnt_ = col.committed_cnt_;
+      col.refresh_view();
+    }
+  }
+}
+
+void ObCSSharedDictBuilder::commit()
+{
+  bool changed = false;
+  for (int64_t i = 0; i < column_cnt_; ++i) {
+    ColumnDict &col = columns_[i];
+    if (col.cnt_ != col.committed_cnt_) {
+      col.committed_cnt_ = col.cnt_;
+      changed = true;
+    }
+  }
+  if (changed) {
+    update_committed_size_();
+  }
+}
+
+int64_t ObCSSharedDictBuilder::calc_column_serialize_size_(const ColumnDict &col, const uint32_t cnt)
+{
+  return 0 == cnt ? 0
+      : sizeof(ObCSSharedDictColumnMeta) + cnt * sizeof(uint32_t) + col.get_data_len(cnt);
+}
+
+void ObCSSharedDictBuilder::update_committed_size_()
+{
+  committed_column_cnt_ = 0;
+  committed_size_ = 0;
+  for (int64_t i = 0; i < column_cnt_; ++i) {
+    const ColumnDict &col = columns_[i];
+    if (col.committed_cnt_ > 0) {
+      ++committed_column_cnt_;
+      committed_size_ += calc_column_serialize_size_(col, col.committed_cnt_);
+    }
+  }
+  if (committed_column_cnt_ > 0) {
+    committed_size_ += sizeof(ObCSSharedDictHeader);
+  }
+}
+
+int64_t ObCSSharedDictBuilder::get_reserve_size() const
+{
+  int64_t size = 0;
+  for (int64_t i = 0; i < column_cnt_; ++i) {
+    size += calc_column_serialize_size_(columns_[i], columns_[i].cnt_);
+  }
+  return 0 == size ? 0 : size + sizeof(ObCSSharedDictHeader);
+}
+
+int ObCSSharedDictBuilder::serialize(char *buf, const int64_t buf_len, int64_t &pos) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_ISNULL(buf) || OB_UNLIKELY(0 == committed_column_cnt_ || pos < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K_(committed_column_cnt), K(pos));
+  } else if (OB_UNLIKELY(pos + committed_size_ > buf_len)) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LOG_WARN("buffer not enough for shared dict", K(ret), K(pos), K(buf_len), K_(committed_size));
+  } else {
+    char *dict_buf = buf + pos;
+    ObCSSharedDictHeader *header = reinterpret_cast<ObCSSharedDictHeader *>(dict_buf);
+    ObCSSharedDictColumnMeta *metas =
+        reinterpret_cast<ObCSSharedDictColumnMeta *>(dict_buf + sizeof(ObCSSharedDictHeader));
+    int64_t data_offset = sizeof(ObCSSharedDictHeader) + committed_column_cnt_ * sizeof(ObCSSharedDictColumnMeta);
+    int64_t meta_idx = 0;
+    *header = ObCSSharedDictHeader();
+    header->column_cnt_ = static_cast<uint32_t>(committed_column_cnt_);
+    for (int64_t i = 0; i < column_cnt_; ++i) {
+      const ColumnDict &col = columns_[i];
+      if (col.committed_cnt_ > 0) {
+        ObCSSharedDictColumnMeta &meta = metas[meta_idx++];
+        meta.column_idx_ = static_cast<uint32_t>(col.column_idx_);
+        meta.dict_cnt_ = col.committed_cnt_;
+        meta.data_offset_ = static_cast<uint32_t>(data_offset);
+        meta.data_len_ = col.get_data_len(col.committed_cnt_);
+        MEMCPY(dict_buf + data_offset, col.offsets_, col.committed_cnt_ * sizeof(uint32_t));
+        data_offset += col.committed_cnt_ * sizeof(uint32_t);
+        MEMCPY(dict_buf + data_offset, col.data_, meta.data_len_);
+        data_offset += meta.data_len_;
+      }
+    }
+    if (OB_UNLIKELY(data_offset != committed_size_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected shared dict size", K(ret), K(data_offset), K_(committed_size));
+    } else {
+      header->data_checksum_ = static_cast<int64_t>(ob_crc64(
+          dict_buf + sizeof(ObCSSharedDictHeader), committed_size_ - sizeof(ObCSSharedDictHeader)));
+      pos += committed_size_;
+    }
+  }
+  return ret;
+}
+
+int ObCSSharedDictBuilder::get_column_dict(const int64_t col_idx, const ObCSSharedDictColumn *&col) const
+{
+  int ret = OB_SUCCESS;
+  col = nullptr;
+  const ColumnDict *col_dict = nullptr;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (nullptr != (col_dict = find_column_(col_idx)) && col_dict->cnt_ > 0) {
+    col = &col_dict->view_;
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_CS_SHARED_DICT_H_
+#define OCEANBASE_ENCODING_OB_CS_SHARED_DICT_H_
+
+#include "lib/hash/ob_hashmap.h"
+#include "lib/string/ob_string.h"
+#include "lib/allocator/ob_allocator.h"
+#include "ob_stream_encoding_struct.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+class ObDataStoreDesc;
+class ObEncodingHashTable;
+
+// Shared string dictionary of cs encoding.
+//
+// In major compaction the distinct values of low cardinality STR_DICT columns can be kept
+// in one dictionary owned by the macro block writer instead of the dictionary of every
+// micro block, such micro blocks only store the references. The dictionary is append only,
+// so a reference stays valid for all the following micro blocks of the writer, and every
+// macro block stores the snapshot of the dictionary at its flush time behind its micro
+// blocks, see ObSSTableMacroBlockHeader::shared_dict_offset_.
+//
+// Layout: ObCSSharedDictHeader | ObCSSharedDictColumnMeta[column_cnt] | column data...
+// column data: uint32_t end_offsets[dict_cnt] | string data, all fields may be unaligned.
+struct ObCSSharedDictHeader final
+{
+  static constexpr uint16_t OB_CS_SHARED_DICT_MAGIC = 0x5344;
+  static constexpr uint8_t OB_CS_SHARED_DICT_V1 = 0;
+  ObCSSharedDictHeader()
+    : magic_(OB_CS_SHARED_DICT_MAGIC), version_(OB_CS_SHARED_DICT_V1), reserved_(0),
+      column_cnt_(0), data_checksum_(0) {}
+  OB_INLINE bool is_valid() const
+  {
+    return OB_CS_SHARED_DICT_MAGIC == magic_ && OB_CS_SHARED_DICT_V1 == version_;
+  }
+
+  TO_STRING_KV(K_(magic), K_(version), K_(column_cnt), K_(data_checksum));
+
+  uint16_t magic_;
+  uint8_t version_;
+  uint8_t reserved_;
+  uint32_t column_cnt_;
+  int64_t data_checksum_; // crc64 of the bytes after the header
+} __attribute__((packed));
+
+struct ObCSSharedDictColumnMeta final
+{
+  ObCSSharedDictColumnMeta() : column_idx_(0), dict_cnt_(0), data_offset_(0), data_len_(0) {}
+  OB_INLINE int64_t get_column_data_size() const
+  {
+    return dict_cnt_ * sizeof(uint32_t) + data_len_;
+  }
+
+  TO_STRING_KV(K_(column_idx), K_(dict_cnt), K_(data_offset), K_(data_len));
+
+  uint32_t column_idx_;
+  uint32_t dict_cnt_;
+  uint32_t data_offset_; // offset of the column data from the start of the shared dict
+  uint32_t data_len_; // length of the string data
+} __attribute__((packed));
+
+// Dictionary of one column, str_ctx_ and offset_ctx_ describe it in the same way as the
+// string stream and offset stream of a STR_DICT column, so the dict decoders can use it
+// directly.
+struct ObCSSharedDictColumn final
+{
+  ObCSSharedDictColumn() { reset(); }
+  void reset();
+  void set(const uint32_t dict_cnt, const char *offset_data,
+           const char *str_data, const uint32_t str_len);
+
+  TO_STRING_KV(K_(dict_cnt), KP_(offset_data), KP_(str_data), K_(str_ctx), K_(offset_ctx));
+
+  uint32_t dict_cnt_;
+  const char *offset_data_;
+  const char *str_data_;
+  ObStringStreamDecoderCtx str_ctx_;
+  ObIntegerStreamDecoderCtx offset_ctx_;
+};
+
+class ObICSSharedDictProvider
+{
+public:
+  virtual ~ObICSSharedDictProvider() {}
+  // %col is nullptr if column %col_idx has no shared dictionary
+  virtual int get_column_dict(const int64_t col_idx, const ObCSSharedDictColumn *&col) const = 0;
+};
+
+// Parsed view of a serialized shared dictionary, the buffer must outlive the reader.
+class ObCSSharedDictReader final : public ObICSSharedDictProvider
+{
+public:
+  static const int64_t MAX_COLUMN_CNT = 16;
+
+  ObCSSharedDictReader();
+  virtual ~ObCSSharedDictReader() {}
+
+  ObCSSharedDictReader(const ObCSSharedDictReader&) = delete;
+  ObCSSharedDictReader &operator=(const ObCSSharedDictReader&) = delete;
+
+  int init(const char *buf, const int64_t buf_len);
+  void reset();
+  OB_INLINE bool is_inited() const { return is_inited_; }
+  virtual int get_column_dict(const int64_t col_idx, const ObCSSharedDictColumn *&col) const override;
+
+  TO_STRING_KV(K_(column_cnt), K_(is_inited));
+
+private:
+  int64_t column_cnt_;
+  uint32_t column_idxs_[MAX_COLUMN_CNT];
+  ObCSSharedDictColumn columns_[MAX_COLUMN_CNT];
+  bool is_inited_;
+};
+
+// Builds the shared dictionary of a macro block writer.
+//
+// The values referenced by the micro block being built are pending until commit() is called
+// after the micro block has been written into a macro block, reset_pending() drops them when
+// the micro block is rebuilt. The builder is also a provider over committed and pending values,
+// so the micro block can be verified before it is written.
+class ObCSSharedDictBuilder final : public ObICSSharedDictProvider
+{
+public:
+  static const int64_t MAX_COLUMN_CNT = ObCSSharedDictReader::MAX_COLUMN_CNT;
+  static const int64_t MAX_DICT_CNT = 512; // per column
+  static const int64_t MAX_DICT_DATA_LEN = 8 << 10; // per column
+
+  // shared dictionary is only built by major compaction with cs encoding, and is not used for
+  // encrypted sstables or writers with flush callback (ddl) whose macro blocks are also
+  // written by other paths.
+  static bool is_enabled(const ObDataStoreDesc &desc, const bool has_flush_callback);
+
+  ObCSSharedDictBuilder();
+  virtual ~ObCSSharedDictBuilder();
+
+  ObCSSharedDictBuilder(const ObCSSharedDictBuilder&) = delete;
+  ObCSSharedDictBuilder &operator=(const ObCSSharedDictBuilder&) = delete;
+
+  int init(common::ObIAllocator &allocator);
+  void reset();
+  OB_INLINE bool is_inited() const { return is_inited_; }
+
+  // Check whether the distinct values of %ht can be referenced from the shared dictionary
+  // of column %col_idx, %dict_cnt is the count of dictionary values after they are added.
+  int check_column(const int64_t col_idx, const ObEncodingHashTable &ht,
+                   bool &is_shared, int64_t &dict_cnt) const;
+  // Add the values of %ht which are not in the dictionary as pending values, and set the
+  // dict_ref_ of every node to its reference in the shared dictionary.
+  int append_column(const int64_t col_idx, ObEncodingHashTable &ht, int64_t &dict_cnt);
+  void reset_pending();
+  void commit();
+
+  // serialize size of the committed values
+  OB_INLINE int64_t get_serialize_size() const { return committed_size_; }
+  // space to reserve in macro block for the dictionary with the pending values
+  int64_t get_reserve_size() const;
+  int serialize(char *buf, const int64_t buf_len, int64_t &pos) const;
+
+  virtual int get_column_dict(const int64_t col_idx, const ObCSSharedDictColumn *&col) const override;
+
+  TO_STRING_KV(K_(column_cnt), K_(committed_column_cnt), K_(committed_size), K_(is_inited));
+
+private:
+  typedef common::hash::ObHashMap<common::ObString, uint32_t, common::hash::NoPthreadDefendMode> ValueMap;
+  struct ColumnDict
+  {
+    ColumnDict() { reset(); }
+    void reset();
+    void refresh_view();
+    OB_INLINE uint32_t get_data_len(const uint32_t cnt) const { return 0 == cnt ? 0 : offsets_[cnt - 1]; }
+
+    int64_t column_idx_;
+    uint32_t committed_cnt_;
+    uint32_t cnt_;
+    uint32_t *offsets_; // end offsets, MAX_DICT_CNT
+    char *data_; // MAX_DICT_DATA_LEN
+    ValueMap *value_map_;
+    ObCSSharedDictColumn view_;
+  };
+
+  int get_or_create_column_(const int64_t col_idx, ColumnDict *&col);
+  const ColumnDict *find_column_(const int64_t col_idx) const;
+  void update_committed_size_();
+  static int64_t calc_column_serialize_size_(const ColumnDict &col, const uint32_t cnt);
+
+private:
+  common::ObIAllocator *allocator_;
+  int64_t column_cnt_;
+  int64_t committed_column_cnt_;
+  int64_t committed_size_;
+  ColumnDict columns_[MAX_COLUMN_CNT];
+  bool is_inited_;
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_ENCODING_OB_CS_SHARED_DICT_H_
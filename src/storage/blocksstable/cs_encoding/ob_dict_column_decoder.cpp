@@ -2273,7 +2273,8 @@ int ObDictColumnDecoder::get_aggregate_result(
     bool all_null = false;
     if (dict_val_cnt == 0) {
       // skip if all null
-    } else if (row_cap == dict_ctx.micro_block_header_->row_count_) { // cover whole microblock
+    } else if (row_cap == dict_ctx.micro_block_header_->row_count_
+        && !dict_ctx.dict_meta_->is_shared_dict()) { // cover whole microblock, shared dict may have values not in it
       if (dict_ctx.dict_meta_->is_sorted() && (agg_cell.is_min_agg() || agg_cell.is_max_agg())) { // int dict must be sorted
         ObDictValueIterator res_iter = ObDictValueIterator(&dict_ctx, agg_cell.is_min_agg() ? 0 : dict_val_cnt - 1);
         if (OB_FAIL(agg_cell.eval(*res_iter))) {
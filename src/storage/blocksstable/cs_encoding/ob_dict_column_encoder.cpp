@@ -82,6 +82,9 @@ int ObDictColumnEncoder::get_identifier_and_stream_types(
     if (dict_encoding_meta_.is_const_encoding_ref()) {
       flags |= IdentifierFlag::IS_CONST_REF;
     }
+    if (dict_encoding_meta_.is_shared_dict()) {
+      flags |= IdentifierFlag::IS_SHARED_DICT;
+    }
     identifier.set(get_type(), int_stream_count_, flags);
     types = int_stream_encoding_types_;
   }
@@ -116,6 +119,12 @@ int ObDictColumnEncoder::build_ref_encoder_ctx_()
     } else {
       if (OB_FAIL(try_const_encoding_ref_())) {
         LOG_WARN("fail to try_use_const_ref", K(ret));
+      } else if (dict_encoding_meta_.is_shared_dict()) {
+        // refs are replaced by the shared dict refs in store_column, the const ref may be any
+        // value not greater than max_ref_
+        ref_stream_max_value_ = MAX(ref_stream_max_value_, max_ref_);
+      }
+      if (OB_FAIL(ret)) {
       } else if (OB_FAIL(ref_enc_ctx_.build_unsigned_stream_meta(0, ref_stream_max_value_,
           is_replace_null, null_replaced_value, false, range))) {
         LOG_WARN("fail to build_unsigned_stream_meta", K(ret));
@@ -124,7 +133,9 @@ int ObDictColumnEncoder::build_ref_encoder_ctx_()
 
     if (OB_SUCC(ret)) {
       int32_t ref_stream_idx = 0;
-      if (column_header_.is_integer_dict()) {
+      if (dict_encoding_meta_.is_shared_dict()) {
+        // ref stream is the only stream
+      } else if (column_header_.is_integer_dict()) {
         ref_stream_idx = 1;
       } else if (!column_header_.is_fixed_length()) {
         ref_stream_idx = 1;
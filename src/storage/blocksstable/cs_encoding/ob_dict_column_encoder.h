@@ -50,6 +50,7 @@ protected:
   enum IdentifierFlag
   {
     IS_CONST_REF = 0x1,
+    IS_SHARED_DICT = 0x2,
   };
 
   int build_ref_encoder_ctx_();
@@ -0,0 +1,406 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_fsst_string_column_decoder.h"
+#include "ob_fsst_symbol_table.h"
+#include "ob_cs_decoding_util.h"
+#include "lib/utility/ob_sort.h"
+#include "storage/blocksstable/encoding/ob_vector_decode_util.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// locate the compressed bytes of %row_id in string stream
+static OB_INLINE void locate_compressed_string(
+    const ObFSSTStringColumnDecoderCtx &ctx,
+    const int64_t row_id,
+    const char *&ptr,
+    uint32_t &len,
+    bool &is_null)
+{
+  const uint32_t width_size = ctx.offset_ctx_->meta_.get_uint_width_size();
+  uint64_t pre_offset = 0;
+  uint64_t cur_offset = 0;
+  ENCODING_ADAPT_MEMCPY(&cur_offset, ctx.offset_data_ + row_id * width_size, width_size);
+  if (row_id > 0) {
+    ENCODING_ADAPT_MEMCPY(&pre_offset, ctx.offset_data_ + (row_id - 1) * width_size, width_size);
+  }
+  ptr = ctx.str_data_ + pre_offset;
+  len = static_cast<uint32_t>(cur_offset - pre_offset);
+  if (ctx.has_null_bitmap()) {
+    is_null = ObCSDecodingUtil::test_bit(ctx.null_bitmap_, row_id);
+  } else if (ctx.is_null_replaced()) {
+    is_null = 0 == len;
+  } else {
+    is_null = false;
+  }
+}
+
+int ObFSSTStringColumnDecoder::decode(
+  const ObColumnCSDecoderCtx &ctx, const int32_t row_id, common::ObDatum &datum) const
+{
+  int ret = OB_SUCCESS;
+  const ObFSSTStringColumnDecoderCtx &fsst_ctx = ctx.fsst_string_ctx_;
+  const char *ptr = nullptr;
+  uint32_t len = 0;
+  bool is_null = false;
+  char *buf = nullptr;
+
+  locate_compressed_string(fsst_ctx, row_id, ptr, len, is_null);
+  if (is_null) {
+    datum.set_null();
+  } else {
+    const int64_t out_len = ObFSSTSymbolTable::get_decompress_len(*fsst_ctx.symbol_table_, ptr, len);
+    if (OB_ISNULL(buf = static_cast<char *>(fsst_ctx.allocator_->alloc(
+        out_len + ObFSSTSymbolTable::DECOMPRESS_PADDING_SIZE)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc decompress buf", K(ret), K(out_len));
+    } else {
+      datum.ptr_ = buf;
+      datum.pack_ = static_cast<uint32_t>(
+          ObFSSTSymbolTable::decompress(*fsst_ctx.symbol_table_, ptr, len, buf));
+    }
+  }
+
+  return ret;
+}
+
+int ObFSSTStringColumnDecoder::batch_decode(const ObColumnCSDecoderCtx &ctx,
+    const int32_t *row_ids, const int64_t row_cap, common::ObDatum *datums) const
+{
+  int ret = OB_SUCCESS;
+  const ObFSSTStringColumnDecoderCtx &fsst_ctx = ctx.fsst_string_ctx_;
+  const char *ptr = nullptr;
+  uint32_t len = 0;
+  bool is_null = false;
+  int64_t total_len = 0;
+  char *buf = nullptr;
+
+  // locate all rows first to decompress into one buffer
+  for (int64_t i = 0; i < row_cap; ++i) {
+    locate_compressed_string(fsst_ctx, row_ids[i], ptr, len, is_null);
+    if (is_null) {
+      datums[i].set_null();
+    } else {
+      datums[i].ptr_ = ptr;
+      datums[i].pack_ = len;
+      total_len += ObFSSTSymbolTable::get_decompress_len(*fsst_ctx.symbol_table_, ptr, len);
+    }
+  }
+  if (OB_ISNULL(buf = static_cast<char *>(fsst_ctx.allocator_->alloc(
+      total_len + ObFSSTSymbolTable::DECOMPRESS_PADDING_SIZE)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc decompress buf", K(ret), K(total_len), K(row_cap));
+  } else {
+    int64_t pos = 0;
+    for (int64_t i = 0; i < row_cap; ++i) {
+      ObDatum &datum = datums[i];
+      if (!datum.is_null()) {
+        const int64_t out_len = ObFSSTSymbolTable::decompress(
+            *fsst_ctx.symbol_table_, datum.ptr_, datum.len_, buf + pos);
+        datum.ptr_ = buf + pos;
+        datum.pack_ = static_cast<uint32_t>(out_len);
+        pos += out_len;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFSSTStringColumnDecoder::decompress_rows_(
+    const ObFSSTStringColumnDecoderCtx &ctx,
+    const int32_t *row_ids,
+    const int64_t row_cap,
+    const char **ptr_arr,
+    uint32_t *len_arr,
+    bool &has_null)
+{
+  int ret = OB_SUCCESS;
+  bool is_null = false;
+  int64_t total_len = 0;
+  char *buf = nullptr;
+  has_null = false;
+
+  for (int64_t i = 0; i < row_cap; ++i) {
+    locate_compressed_string(ctx, row_ids[i], ptr_arr[i], len_arr[i], is_null);
+    if (is_null) {
+      ptr_arr[i] = nullptr;
+      len_arr[i] = 0;
+      has_null = true;
+    } else {
+      total_len += ObFSSTSymbolTable::get_decompress_len(*ctx.symbol_table_, ptr_arr[i], len_arr[i]);
+    }
+  }
+  if (OB_ISNULL(buf = static_cast<char *>(ctx.allocator_->alloc(
+      total_len + ObFSSTSymbolTable::DECOMPRESS_PADDING_SIZE)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc decompress buf", K(ret), K(total_len), K(row_cap));
+  } else {
+    int64_t pos = 0;
+    for (int64_t i = 0; i < row_cap; ++i) {
+      if (nullptr != ptr_arr[i]) {
+        const int64_t out_len = ObFSSTSymbolTable::decompress(
+            *ctx.symbol_table_, ptr_arr[i], len_arr[i], buf + pos);
+        ptr_arr[i] = buf + pos;
+        len_arr[i] = static_cast<uint32_t>(out_len);
+        pos += out_len;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFSSTStringColumnDecoder::decode_vector(
+    const ObColumnCSDecoderCtx &ctx, ObVectorDecodeCtx &vector_ctx) const
+{
+  int ret = OB_SUCCESS;
+  const ObFSSTStringColumnDecoderCtx &fsst_ctx = ctx.fsst_string_ctx_;
+  bool has_null = false;
+
+  if (OB_FAIL(decompress_rows_(fsst_ctx, vector_ctx.row_ids_, vector_ctx.row_cap_,
+      vector_ctx.ptr_arr_, vector_ctx.len_arr_, has_null))) {
+    LOG_WARN("fail to decompress rows", K(ret), K(vector_ctx));
+  } else {
+    const int64_t fixed_packing_len = 0;
+    DataDiscreteLocator discrete_locator(vector_ctx.ptr_arr_, vector_ctx.len_arr_);
+    if (OB_FAIL(ObVecDecodeUtils::load_byte_aligned_vector<DataDiscreteLocator>(
+        fsst_ctx.obj_meta_, fsst_ctx.col_header_->get_store_obj_type(), fixed_packing_len,
+        has_null, discrete_locator, vector_ctx.row_cap_,
+        vector_ctx.vec_offset_, vector_ctx.vec_header_))) {
+      LOG_WARN("failed to load byte aligned data to vector", K(ret), K(fsst_ctx));
+    }
+  }
+  return ret;
+}
+
+int ObFSSTStringColumnDecoder::get_null_count(const ObColumnCSDecoderCtx &col_ctx,
+    const int32_t *row_ids, const int64_t row_cap, int64_t &null_count) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(row_ids) || row_cap < 1) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", KR(ret), K(row_cap));
+  } else {
+    const ObFSSTStringColumnDecoderCtx &fsst_ctx = col_ctx.fsst_string_ctx_;
+    const char *ptr = nullptr;
+    uint32_t len = 0;
+    bool is_null = false;
+    null_count = 0;
+    if (!fsst_ctx.has_no_null()) {
+      for (int64_t i = 0; i < row_cap; ++i) {
+        locate_compressed_string(fsst_ctx, row_ids[i], ptr, len, is_null);
+        if (is_null) {
+          ++null_count;
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+
+//===============================filter on compressed data===================================//
+
+bool ObFSSTStringColumnDecoder::can_filter_on_compressed_(const ObFSSTStringColumnDecoderCtx &ctx)
+{
+  // same string is always compressed to same bytes, so equality is preserved only when
+  // the comparison is bytewise and no padding is involved
+  return ObVarcharType == ctx.obj_meta_.get_type()
+      && CS_TYPE_BINARY == ctx.obj_meta_.get_collation_type();
+}
+
+int ObFSSTStringColumnDecoder::pushdown_operator(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnCSDecoderCtx &col_ctx,
+    const sql::ObWhiteFilterExecutor &filter,
+    const sql::PushdownFilterInfo &pd_filter_info,
+    ObBitmap &result_bitmap) const
+{
+  UNUSED(parent);
+  int ret = OB_SUCCESS;
+  const ObFSSTStringColumnDecoderCtx &fsst_ctx = col_ctx.fsst_string_ctx_;
+  const int64_t row_cnt = pd_filter_info.count_;
+  if (OB_UNLIKELY(row_cnt < 1 || row_cnt != result_bitmap.size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", KR(ret), K(row_cnt), K(fsst_ctx), K(result_bitmap.size()));
+  } else {
+    const int64_t row_start = pd_filter_info.start_;
+    const int64_t row_count = pd_filter_info.count_;
+    const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+    switch(op_type) {
+      case sql::WHITE_OP_NU:
+      case sql::WHITE_OP_NN: {
+        if (OB_FAIL(nunn_operator(fsst_ctx, row_start, row_count, filter, result_bitmap))) {
+          LOG_WARN("fail to handle nunn operator", KR(ret), K(pd_filter_info), K(fsst_ctx));
+        }
+        break;
+      }
+      case sql::WHITE_OP_EQ:
+      case sql::WHITE_OP_NE: {
+        if (!can_filter_on_compressed_(fsst_ctx)) {
+          ret = OB_NOT_SUPPORTED;
+        } else if (OB_UNLIKELY(filter.get_datums().count() != 1)) {
+          ret = OB_INVALID_ARGUMENT;
+          LOG_WARN("invalid argument", KR(ret), K(filter));
+        } else if (OB_FAIL(eq_ne_operator(fsst_ctx, row_start, row_count, filter, result_bitmap))) {
+          LOG_WARN("fail to handle eq ne operator", KR(ret), K(pd_filter_info), K(fsst_ctx));
+        }
+        break;
+      }
+      case sql::WHITE_OP_IN: {
+        if (!can_filter_on_compressed_(fsst_ctx)) {
+          ret = OB_NOT_SUPPORTED;
+        } else if (OB_UNLIKELY(filter.get_datums().count() < 1)) {
+          ret = OB_INVALID_ARGUMENT;
+          LOG_WARN("invalid argument", KR(ret), K(filter));
+        } else if (OB_FAIL(in_operator(fsst_ctx, row_start, row_count, filter, result_bitmap))) {
+          LOG_WARN("fail to handle in operator", KR(ret), K(pd_filter_info), K(fsst_ctx));
+        }
+        break;
+      }
+      default: {
+        // range comparison can not be evaluated on compressed data
+        ret = OB_NOT_SUPPORTED;
+      }
+    }
+    LOG_TRACE("fsst string white filter pushdown", K(ret), K(fsst_ctx),
+        K(filter.get_op_type()), K(pd_filter_info), K(result_bitmap.popcnt()));
+  }
+  return ret;
+}
+
+int ObFSSTStringColumnDecoder::nunn_operator(
+    const ObFSSTStringColumnDecoderCtx &ctx,
+    const int64_t row_start,
+    const int64_t row_count,
+    const sql::ObWhiteFilterExecutor &filter,
+    common::ObBitmap &result_bitmap)
+{
+  int ret = OB_SUCCESS;
+  const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  const char *ptr = nullptr;
+  uint32_t len = 0;
+  bool is_null = false;
+
+  if (!ctx.has_no_null()) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      locate_compressed_string(ctx, row_start + i, ptr, len, is_null);
+      if (is_null && OB_FAIL(result_bitmap.set(i))) {
+        LOG_WARN("fail to set", KR(ret), K(i), K(row_start));
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+    LOG_WARN("nunn_operator failed", KR(ret), K(ctx));
+  } else if (sql::WHITE_OP_NN == op_type) {
+    if (OB_FAIL(result_bitmap.bit_not())) {
+      LOG_WARN("fail to execute bit not", KR(ret), K(ctx));
+    }
+  }
+
+  return ret;
+}
+
+int ObFSSTStringColumnDecoder::eq_ne_operator(
+    const ObFSSTStringColumnDecoderCtx &ctx,
+    const int64_t row_start,
+    const int64_t row_count,
+    const sql::ObWhiteFilterExecutor &filter,
+    common::ObBitmap &result_bitmap)
+{
+  int ret = OB_SUCCESS;
+  const bool is_eq = sql::WHITE_OP_EQ == filter.get_op_type();
+  const ObDatum &filter_datum = filter.get_datums().at(0);
+  ObFSSTSymbolTable symbol_table;
+  char *literal = nullptr;
+  int64_t literal_len = 0;
+
+  if (OB_FAIL(symbol_table.load(*ctx.symbol_table_))) {
+    LOG_WARN("fail to load symbol table", KR(ret), KPC(ctx.symbol_table_));
+  } else if (OB_ISNULL(literal = static_cast<char *>(
+      ctx.allocator_->alloc(2 * filter_datum.len_ + 1)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc compressed literal", KR(ret), K(filter_datum));
+  } else {
+    literal_len = symbol_table.compress(filter_datum.ptr_, filter_datum.len_, literal);
+    const char *ptr = nullptr;
+    uint32_t len = 0;
+    bool is_null = false;
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      locate_compressed_string(ctx, row_start + i, ptr, len, is_null);
+      if (is_null) {
+      } else if (is_eq == (len == literal_len && 0 == MEMCMP(ptr, literal, len))) {
+        if (OB_FAIL(result_bitmap.set(i))) {
+          LOG_WARN("fail to set", KR(ret), K(i), K(row_start));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFSSTStringColumnDecoder::in_operator(
+    const ObFSSTStringColumnDecoderCtx &ctx,
+    const int64_t row_start,
+    const int64_t row_count,
+    const sql::ObWhiteFilterExecutor &filter,
+    common::ObBitmap &result_bitmap)
+{
+  int ret = OB_SUCCESS;
+  const int64_t literal_cnt = filter.get_datums().count();
+  ObFSSTSymbolTable symbol_table;
+  ObString *literals = nullptr;
+
+  if (OB_FAIL(symbol_table.load(*ctx.symbol_table_))) {
+    LOG_WARN("fail to load symbol table", KR(ret), KPC(ctx.symbol_table_));
+  } else if (OB_ISNULL(literals = static_cast<ObString *>(
+      ctx.allocator_->alloc(sizeof(ObString) * literal_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc compressed literals", KR(ret), K(literal_cnt));
+  } else {
+    // compress all literals and sort them to binary search the compressed rows
+    for (int64_t i = 0; OB_SUCC(ret) && i < literal_cnt; ++i) {
+      const ObDatum &filter_datum = filter.get_datums().at(i);
+      char *buf = nullptr;
+      if (OB_ISNULL(buf = static_cast<char *>(ctx.allocator_->alloc(2 * filter_datum.len_ + 1)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to alloc compressed literal", KR(ret), K(filter_datum));
+      } else {
+        const int64_t len = symbol_table.compress(filter_datum.ptr_, filter_datum.len_, buf);
+        new (literals + i) ObString(len, buf);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      lib::ob_sort(literals, literals + literal_cnt);
+      const char *ptr = nullptr;
+      uint32_t len = 0;
+      bool is_null = false;
+      for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+        locate_compressed_string(ctx, row_start + i, ptr, len, is_null);
+        if (!is_null) {
+          const ObString cur(static_cast<int64_t>(len), ptr);
+          if (std::binary_search(literals, literals + literal_cnt, cur)
+              && OB_FAIL(result_bitmap.set(i))) {
+            LOG_WARN("fail to set", KR(ret), K(i), K(row_start));
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
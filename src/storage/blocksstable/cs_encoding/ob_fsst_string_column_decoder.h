@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_FSST_STRING_COLUMN_DECODER_H_
+#define OCEANBASE_ENCODING_OB_FSST_STRING_COLUMN_DECODER_H_
+
+#include "ob_icolumn_cs_decoder.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+class ObFSSTStringColumnDecoder : public ObIColumnCSDecoder
+{
+public:
+  static const ObCSColumnHeader::Type type_ = ObCSColumnHeader::FSST_STRING;
+  ObFSSTStringColumnDecoder() {}
+  virtual ~ObFSSTStringColumnDecoder() {}
+
+  ObFSSTStringColumnDecoder(const ObFSSTStringColumnDecoder&) = delete;
+  ObFSSTStringColumnDecoder &operator=(const ObFSSTStringColumnDecoder&) = delete;
+
+  virtual int decode(const ObColumnCSDecoderCtx &ctx,
+    const int32_t row_id, common::ObDatum &datum) const override;
+  virtual int batch_decode(const ObColumnCSDecoderCtx &ctx, const int32_t *row_ids,
+      const int64_t row_cap, common::ObDatum *datums) const override;
+  virtual int decode_vector(const ObColumnCSDecoderCtx &ctx, ObVectorDecodeCtx &vector_ctx) const override;
+
+  virtual int get_null_count(const ObColumnCSDecoderCtx &ctx,
+     const int32_t *row_ids, const int64_t row_cap, int64_t &null_count) const override;
+
+  // Only null check and equality on binary collation are evaluated on the compressed bytes,
+  // other filters return OB_NOT_SUPPORTED and are evaluated on the decoded rows.
+  virtual int pushdown_operator(
+      const sql::ObPushdownFilterExecutor *parent,
+      const ObColumnCSDecoderCtx &col_ctx,
+      const sql::ObWhiteFilterExecutor &filter,
+      const sql::PushdownFilterInfo &pd_filter_info,
+      common::ObBitmap &result_bitmap) const override;
+
+  virtual ObCSColumnHeader::Type get_type() const override { return type_; }
+
+private:
+  static int decompress_rows_(const ObFSSTStringColumnDecoderCtx &ctx,
+                              const int32_t *row_ids,
+                              const int64_t row_cap,
+                              const char **ptr_arr,
+                              uint32_t *len_arr,
+                              bool &has_null);
+  static bool can_filter_on_compressed_(const ObFSSTStringColumnDecoderCtx &ctx);
+  static int nunn_operator(const ObFSSTStringColumnDecoderCtx &ctx,
+                           const int64_t row_start,
+                           const int64_t row_count,
+                           const sql::ObWhiteFilterExecutor &filter,
+                           common::ObBitmap &result_bitmap);
+  static int eq_ne_operator(const ObFSSTStringColumnDecoderCtx &ctx,
+                            const int64_t row_start,
+                            const int64_t row_count,
+                            const sql::ObWhiteFilterExecutor &filter,
+                            common::ObBitmap &result_bitmap);
+  static int in_operator(const ObFSSTStringColumnDecoderCtx &ctx,
+                         const int64_t row_start,
+                         const int64_t row_count,
+                         const sql::ObWhiteFilterExecutor &filter,
+                         common::ObBitmap &result_bitmap);
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_ENCODING_OB_FSST_STRING_COLUMN_DECODER_H_
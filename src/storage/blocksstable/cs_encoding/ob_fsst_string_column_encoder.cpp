@@ -0,0 +1,277 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_fsst_string_column_encoder.h"
+#include "ob_column_datum_iter.h"
+#include "ob_cs_encoding_util.h"
+#include "lib/codec/ob_codecs.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+using namespace common;
+
+ObFSSTStringColumnEncoder::ObFSSTStringColumnEncoder()
+  : enc_ctx_(),
+    string_stream_encoder_(),
+    symbol_table_(),
+    compressed_datums_(nullptr),
+    compressed_data_size_(0)
+{
+}
+
+ObFSSTStringColumnEncoder::~ObFSSTStringColumnEncoder() {}
+
+bool ObFSSTStringColumnEncoder::is_applicable(
+    const ObColumnCSEncodingCtx &ctx, const ObObjTypeStoreClass store_class)
+{
+  bool applicable = false;
+  if ((ObStringSC == store_class || ObTextSC == store_class)
+      && !ctx.force_raw_encoding_
+      && nullptr != ctx.col_datums_
+      && ctx.var_data_size_ >= MIN_VAR_DATA_SIZE) {
+    const int64_t not_null_cnt = ctx.col_datums_->count() - ctx.null_cnt_;
+    applicable = not_null_cnt > 0 && ctx.var_data_size_ / not_null_cnt >= MIN_AVG_STRING_LEN;
+  }
+  return applicable;
+}
+
+int ObFSSTStringColumnEncoder::init(
+  const ObColumnCSEncodingCtx &ctx, const int64_t column_index, const int64_t row_count)
+{
+  int ret = OB_SUCCESS;
+
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_FAIL(ObIColumnCSEncoder::init(ctx, column_index, row_count))) {
+    LOG_WARN("init base column encoder failed", K(ret), K(ctx), K(column_index), K(row_count));
+  } else {
+    column_header_.type_ = type_;
+    if (OB_FAIL(do_init_())) {
+      LOG_WARN("fail to pre_handle", K(ret));
+    }
+  }
+
+  return ret;
+}
+
+void ObFSSTStringColumnEncoder::reuse()
+{
+  ObIColumnCSEncoder::reuse();
+  enc_ctx_.reset();
+  string_stream_encoder_.reuse();
+  symbol_table_.reset();
+  compressed_datums_ = nullptr;
+  compressed_data_size_ = 0;
+}
+
+int ObFSSTStringColumnEncoder::do_init_()
+{
+  int ret = OB_SUCCESS;
+  bool is_use_zero_len_as_null = false;
+  const int32_t int_stream_idx = 0;
+  // A non-empty string is never compressed to empty, so zero length can still represent null
+  // if there is no empty string. Compressed strings are always stored as variable length.
+  if (ctx_->null_cnt_ > 0) {
+    if (ctx_->has_zero_length_datum_) {
+      column_header_.set_has_null_bitmap();
+    } else {
+      is_use_zero_len_as_null = true;
+    }
+  }
+  int_stream_count_ = 1;
+
+  if (OB_FAIL(symbol_table_.build(*ctx_->col_datums_, ctx_->var_data_size_, *ctx_->allocator_))) {
+    LOG_WARN("fail to build fsst symbol table", K(ret), KPC_(ctx));
+  } else if (OB_FAIL(compress_datums_())) {
+    LOG_WARN("fail to compress datums", K(ret));
+  } else if (OB_FAIL(enc_ctx_.build_string_stream_meta(
+      -1/*fixed_len*/, is_use_zero_len_as_null, static_cast<uint32_t>(compressed_data_size_)))) {
+    LOG_WARN("fail to build_string_stream_meta", K(ret));
+  } else if (OB_FAIL(enc_ctx_.build_string_stream_encoder_info(
+      ctx_->encoding_ctx_->compressor_type_,
+      is_force_raw_, &ctx_->encoding_ctx_->cs_encoding_opt_,
+      ctx_->encoding_ctx_->previous_cs_encoding_.get_column_encoding(column_index_),
+      int_stream_idx, ctx_->allocator_))) {
+    LOG_WARN("fail to build_string_stream_encoder_info", K(ret));
+  }
+
+  return ret;
+}
+
+int ObFSSTStringColumnEncoder::compress_datums_()
+{
+  int ret = OB_SUCCESS;
+  const ObColDatums &datums = *ctx_->col_datums_;
+  char *buf = nullptr;
+  // each byte is escaped in the worst case, reserve one byte to avoid empty allocation
+  const int64_t buf_size = 2 * ctx_->var_data_size_ + 1;
+  if (OB_ISNULL(compressed_datums_ = static_cast<ObDatum *>(
+      ctx_->allocator_->alloc(sizeof(ObDatum) * row_count_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc compressed datums", K(ret), K_(row_count));
+  } else if (OB_ISNULL(buf = static_cast<char *>(ctx_->allocator_->alloc(buf_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc compressed buf", K(ret), K(buf_size));
+  } else {
+    int64_t pos = 0;
+    for (int64_t row_id = 0; OB_SUCC(ret) && row_id < row_count_; ++row_id) {
+      const ObDatum &datum = datums.at(row_id);
+      ObDatum &compressed = compressed_datums_[row_id];
+      new (&compressed) ObDatum();
+      if (datum.is_null()) {
+        compressed.set_null();
+      } else if (OB_UNLIKELY(pos + 2 * datum.len_ > buf_size)) {
+        ret = OB_BUF_NOT_ENOUGH;
+        LOG_WARN("compressed buf not enough", K(ret), K(pos), K(buf_size), K(datum));
+      } else {
+        const int64_t len = symbol_table_.compress(datum.ptr_, datum.len_, buf + pos);
+        compressed.ptr_ = buf + pos;
+        compressed.pack_ = static_cast<uint32_t>(len);
+        pos += len;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      compressed_data_size_ = pos;
+    }
+  }
+  return ret;
+}
+
+int ObFSSTStringColumnEncoder::store_column(ObMicroBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<uint32_t, 2> offsets;
+
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    // first stream offset include the column optional meta
+    if (OB_FAIL(store_column_meta_(buf_writer))) {
+      LOG_WARN("fail to store column optional meta", K(ret));
+    } else {
+      ObDatumArrayIter iter(compressed_datums_, row_count_);
+      if (OB_FAIL(string_stream_encoder_.encode(
+          enc_ctx_, iter, buf_writer, ctx_->all_string_buf_writer_, offsets))) {
+        LOG_WARN("fail to store stream", K(ret), K_(enc_ctx));
+      } else if (OB_UNLIKELY(offsets.count() != 2)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("stream offset count unexpected", K(ret), K(offsets));
+      } else if (OB_UNLIKELY(buf_writer.length() != offsets.at(offsets.count() - 1))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("last offset must equal to buf pos", K(ret), K(offsets), K(buf_writer.length()));
+      } else {
+        int_stream_encoding_types_[0] = string_stream_encoder_.get_offset_encoder_ctx().meta_.get_encoding_type();
+      }
+    }
+
+    for (int64_t i = 0; OB_SUCC(ret) && i < offsets.count(); i++) {
+      if (OB_FAIL(stream_offsets_.push_back(offsets.at(i)))) {
+        LOG_WARN("fail to push back", K(ret));
+      }
+    }
+  }
+
+  return ret;
+}
+
+int ObFSSTStringColumnEncoder::store_column_meta_(ObMicroBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  const int64_t table_size = symbol_table_.get_serialize_size();
+  char *table_buf = nullptr;
+  if (OB_FAIL(store_null_bitamp(buf_writer))) {
+    LOG_WARN("fail to store null bitmap", K(ret));
+  } else if (FALSE_IT(table_buf = buf_writer.current())) {
+  } else if (OB_FAIL(buf_writer.advance(table_size))) {
+    LOG_WARN("buffer advance failed", K(ret), K(table_size));
+  } else if (OB_FAIL(symbol_table_.serialize(static_cast<uint32_t>(MAX(ctx_->max_string_size_, 0)),
+      table_buf, table_size, pos))) {
+    LOG_WARN("fail to serialize symbol table", K(ret), K_(symbol_table));
+  }
+  return ret;
+}
+
+int64_t ObFSSTStringColumnEncoder::estimate_store_size() const
+{
+  int64_t size = INT64_MAX;
+  if (!is_inited_) {
+  } else if (is_force_raw_) {
+  } else {
+    int64_t avg_length = compressed_data_size_ / row_count_;
+    int64_t length_byte_size = ObCSEncodingUtil::get_bit_size(avg_length) * row_count_ / CHAR_BIT;
+    size = compressed_data_size_ + length_byte_size + symbol_table_.get_serialize_size();
+    if (column_header_.has_null_bitmap()) {
+      size += ObCSEncodingUtil::get_bitmap_byte_size(row_count_);
+    }
+  }
+
+  return size;
+}
+
+int ObFSSTStringColumnEncoder::get_identifier_and_stream_types(
+    ObColumnEncodingIdentifier &identifier, const ObIntegerStream::EncodingType *&types) const
+{
+  int ret = OB_SUCCESS;
+
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    identifier.set(type_, int_stream_count_, 0);
+    types = int_stream_encoding_types_;
+  }
+  return ret;
+}
+
+int ObFSSTStringColumnEncoder::get_maximal_encoding_store_size(int64_t &size) const
+{
+  int ret = OB_SUCCESS;
+
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    int64_t offset_arry_orig_size = get_byte_packed_int_size(compressed_data_size_) * row_count_;
+    size = sizeof(ObStringStreamMeta) + symbol_table_.get_serialize_size();
+    size += sizeof(ObIntegerStreamMeta);
+    size += common::ObCodec::get_moderate_encoding_size(offset_arry_orig_size);
+    if (column_header_.has_null_bitmap()) {
+      size += ObCSEncodingUtil::get_bitmap_byte_size(row_count_);
+    }
+    size = std::min(size, ObCSEncodingUtil::MAX_COLUMN_ENCODING_STORE_SIZE);
+  }
+  return ret;
+}
+
+int ObFSSTStringColumnEncoder::get_string_data_len(uint32_t &len) const
+{
+  int ret = OB_SUCCESS;
+
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    len = enc_ctx_.meta_.uncompressed_len_;
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_FSST_STRING_COLUMN_ENCODER_H_
+#define OCEANBASE_ENCODING_OB_FSST_STRING_COLUMN_ENCODER_H_
+
+#include "ob_icolumn_cs_encoder.h"
+#include "ob_string_stream_encoder.h"
+#include "ob_fsst_symbol_table.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// Variable length string column whose values are compressed by FSST symbol table.
+// The column meta is the optional null bitmap followed by the symbol table, the streams are the
+// same as variable length STRING column, but hold the compressed bytes.
+class ObFSSTStringColumnEncoder : public ObIColumnCSEncoder
+{
+public:
+  static const ObCSColumnHeader::Type type_ = ObCSColumnHeader::FSST_STRING;
+  // skip the columns too small or too short to pay off the symbol table
+  static const int64_t MIN_VAR_DATA_SIZE = 4 << 10; // 4KB
+  static const int64_t MIN_AVG_STRING_LEN = 8;
+
+  ObFSSTStringColumnEncoder();
+  virtual ~ObFSSTStringColumnEncoder();
+
+  ObFSSTStringColumnEncoder(const ObFSSTStringColumnEncoder&) = delete;
+  ObFSSTStringColumnEncoder &operator=(const ObFSSTStringColumnEncoder&) = delete;
+
+  static bool is_applicable(const ObColumnCSEncodingCtx &ctx, const ObObjTypeStoreClass store_class);
+
+  int init(
+    const ObColumnCSEncodingCtx &ctx, const int64_t column_index, const int64_t row_count) override;
+  void reuse() override;
+  int store_column(ObMicroBufferWriter &buf_writer) override;
+  int64_t estimate_store_size() const override;
+  ObCSColumnHeader::Type get_type() const override { return type_; }
+  int get_identifier_and_stream_types(
+      ObColumnEncodingIdentifier &identifier, const ObIntegerStream::EncodingType *&types) const override;
+  int get_maximal_encoding_store_size(int64_t &size) const override;
+  int get_string_data_len(uint32_t &len) const override;
+
+  INHERIT_TO_STRING_KV("ICSColumnEncoder", ObIColumnCSEncoder, K_(enc_ctx), K_(symbol_table),
+      K_(compressed_data_size));
+
+private:
+  int do_init_();
+  int compress_datums_();
+  int store_column_meta_(ObMicroBufferWriter &buf_writer);
+
+private:
+  ObStringStreamEncoderCtx enc_ctx_;
+  ObStringStreamEncoder string_stream_encoder_;
+  ObFSSTSymbolTable symbol_table_;
+  ObDatum *compressed_datums_;
+  int64_t compressed_data_size_;
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_ENCODING_OB_FSST_STRING_COLUMN_ENCODER_H_
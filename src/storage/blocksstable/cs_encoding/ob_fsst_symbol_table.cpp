@@ -0,0 +1,326 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_fsst_symbol_table.h"
+#include "lib/utility/ob_sort.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+using namespace common;
+
+void ObFSSTSymbolTable::reset()
+{
+  symbol_cnt_ = 0;
+  MEMSET(symbols_, 0, sizeof(symbols_));
+  MEMSET(lens_, 0, sizeof(lens_));
+  MEMSET(first_byte_start_, 0, sizeof(first_byte_start_));
+}
+
+int ObFSSTSymbolTable::build(
+    const ObColDatums &datums, const int64_t var_data_size, ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  ObString *samples = nullptr;
+  int64_t sample_cnt = 0;
+  uint32_t *code_cnts = nullptr;
+  PairSlot *pair_slots = nullptr;
+  uint32_t *touched_slots = nullptr;
+  Candidate *candidates = nullptr;
+  reset();
+  if (OB_UNLIKELY(var_data_size < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(var_data_size));
+  } else if (0 == var_data_size) {
+    // all strings are null or empty, keep the symbol table empty
+  } else if (OB_FAIL(collect_samples(datums, var_data_size, allocator, samples, sample_cnt))) {
+    LOG_WARN("fail to collect samples", K(ret), K(var_data_size));
+  } else if (OB_ISNULL(code_cnts = static_cast<uint32_t *>(
+      allocator.alloc(sizeof(uint32_t) * CODE_SPACE)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc code counts", K(ret));
+  } else if (OB_ISNULL(pair_slots = static_cast<PairSlot *>(
+      allocator.alloc(sizeof(PairSlot) * PAIR_SLOT_CNT)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc pair slots", K(ret));
+  } else if (OB_ISNULL(touched_slots = static_cast<uint32_t *>(
+      allocator.alloc(sizeof(uint32_t) * SAMPLE_SIZE)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc touched slots", K(ret));
+  } else if (OB_ISNULL(candidates = static_cast<Candidate *>(
+      allocator.alloc(sizeof(Candidate) * (CODE_SPACE + SAMPLE_SIZE))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc candidates", K(ret));
+  } else {
+    // pair slots are cleared by train_round after use, only need to be zeroed once
+    MEMSET(pair_slots, 0, sizeof(PairSlot) * PAIR_SLOT_CNT);
+    for (int64_t i = 0; OB_SUCC(ret) && i < TRAIN_ROUNDS; ++i) {
+      if (OB_FAIL(train_round(samples, sample_cnt, code_cnts, pair_slots, touched_slots, candidates))) {
+        LOG_WARN("fail to train symbol table", K(ret), K(i));
+      }
+    }
+  }
+  LOG_DEBUG("build fsst symbol table", K(ret), K(sample_cnt), K_(symbol_cnt));
+  return ret;
+}
+
+int ObFSSTSymbolTable::collect_samples(
+    const ObColDatums &datums,
+    const int64_t var_data_size,
+    ObIAllocator &allocator,
+    ObString *&samples,
+    int64_t &sample_cnt)
+{
+  int ret = OB_SUCCESS;
+  // pick rows evenly to get about SAMPLE_SIZE bytes
+  const int64_t row_cnt = datums.count();
+  const int64_t step = var_data_size > SAMPLE_SIZE ? (var_data_size + SAMPLE_SIZE - 1) / SAMPLE_SIZE : 1;
+  const int64_t max_sample_cnt = row_cnt / step + 1;
+  sample_cnt = 0;
+  if (OB_ISNULL(samples = static_cast<ObString *>(allocator.alloc(sizeof(ObString) * max_sample_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc samples", K(ret), K(max_sample_cnt));
+  } else {
+    int64_t total_len = 0;
+    for (int64_t row_id = 0; row_id < row_cnt && total_len < SAMPLE_SIZE; row_id += step) {
+      const ObDatum &datum = datums.at(row_id);
+      if (!datum.is_null() && datum.len_ > 0) {
+        const int64_t len = MIN(static_cast<int64_t>(datum.len_), SAMPLE_SIZE - total_len);
+        samples[sample_cnt++].assign_ptr(datum.ptr_, static_cast<int32_t>(len));
+        total_len += len;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFSSTSymbolTable::train_round(
+    const ObString *samples,
+    const int64_t sample_cnt,
+    uint32_t *code_cnts,
+    PairSlot *pair_slots,
+    uint32_t *touched_slots,
+    Candidate *candidates)
+{
+  int ret = OB_SUCCESS;
+  int64_t touched_cnt = 0;
+  MEMSET(code_cnts, 0, sizeof(uint32_t) * CODE_SPACE);
+  // <1> compress samples with current table and count codes and adjacent code pairs
+  for (int64_t i = 0; i < sample_cnt; ++i) {
+    const char *ptr = samples[i].ptr();
+    const int64_t len = samples[i].length();
+    int64_t pos = 0;
+    int64_t prev = -1;
+    while (pos < len) {
+      const int64_t byte_code = LITERAL_CODE_BASE + static_cast<uint8_t>(ptr[pos]);
+      const int64_t symbol_code = find_longest_symbol(ptr + pos, len - pos);
+      int64_t cur = byte_code;
+      int64_t cur_len = 1;
+      if (symbol_code >= 0) {
+        cur = symbol_code;
+        cur_len = lens_[symbol_code];
+        if (cur_len > 1) {
+          // single byte still competes for a slot in next round
+          ++code_cnts[byte_code];
+        }
+      }
+      ++code_cnts[cur];
+      if (prev >= 0) {
+        add_pair(prev, cur, pair_slots, touched_slots, touched_cnt);
+      }
+      prev = cur;
+      pos += cur_len;
+    }
+  }
+
+  // <2> gain of a candidate is the bytes it covers
+  int64_t candidate_cnt = 0;
+  uint64_t symbol = 0;
+  int64_t symbol_len = 0;
+  for (int64_t code = 0; code < CODE_SPACE; ++code) {
+    if (code_cnts[code] > 0) {
+      get_code_symbol(code, symbol, symbol_len);
+      Candidate &candidate = candidates[candidate_cnt++];
+      candidate.symbol_ = symbol;
+      candidate.len_ = static_cast<uint8_t>(symbol_len);
+      candidate.gain_ = code_cnts[code] * static_cast<uint32_t>(symbol_len);
+    }
+  }
+  uint64_t second_symbol = 0;
+  int64_t second_len = 0;
+  for (int64_t i = 0; i < touched_cnt; ++i) {
+    PairSlot &slot = pair_slots[touched_slots[i]];
+    const uint32_t key = slot.key_ - 1;
+    get_code_symbol(key >> 9, symbol, symbol_len);
+    get_code_symbol(key & (CODE_SPACE - 1), second_symbol, second_len);
+    if (symbol_len + second_len <= MAX_SYMBOL_LEN) {
+      Candidate &candidate = candidates[candidate_cnt++];
+      candidate.symbol_ = symbol | (second_symbol << (symbol_len * CHAR_BIT));
+      candidate.len_ = static_cast<uint8_t>(symbol_len + second_len);
+      candidate.gain_ = slot.cnt_ * static_cast<uint32_t>(symbol_len + second_len);
+    }
+    slot.key_ = 0;
+    slot.cnt_ = 0;
+  }
+
+  // <3> pick the candidates with max gain as new table
+  lib::ob_sort(candidates, candidates + candidate_cnt,
+      [](const Candidate &left, const Candidate &right) { return left.gain_ > right.gain_; });
+  static const int64_t DEDUP_SLOT_CNT = 1024;
+  uint64_t dedup_symbols[DEDUP_SLOT_CNT];
+  uint8_t dedup_lens[DEDUP_SLOT_CNT];
+  MEMSET(dedup_lens, 0, sizeof(dedup_lens));
+  symbol_cnt_ = 0;
+  for (int64_t i = 0; i < candidate_cnt && symbol_cnt_ < MAX_SYMBOL_CNT; ++i) {
+    const Candidate &candidate = candidates[i];
+    int64_t slot = static_cast<int64_t>(((candidate.symbol_ + candidate.len_) * 0x9E3779B97F4A7C15UL) >> 54);
+    bool exist = false;
+    while (0 != dedup_lens[slot] && !exist) {
+      exist = dedup_lens[slot] == candidate.len_ && dedup_symbols[slot] == candidate.symbol_;
+      slot = (slot + 1) & (DEDUP_SLOT_CNT - 1);
+    }
+    if (!exist) {
+      dedup_symbols[slot] = candidate.symbol_;
+      dedup_lens[slot] = candidate.len_;
+      symbols_[symbol_cnt_] = candidate.symbol_;
+      lens_[symbol_cnt_] = candidate.len_;
+      ++symbol_cnt_;
+    }
+  }
+  sort_symbols();
+  build_first_byte_index();
+  return ret;
+}
+
+void ObFSSTSymbolTable::add_pair(
+    const int64_t first,
+    const int64_t second,
+    PairSlot *pair_slots,
+    uint32_t *touched_slots,
+    int64_t &touched_cnt)
+{
+  const uint32_t key = static_cast<uint32_t>((first << 9) | second) + 1;
+  uint32_t slot = (key * 2654435761U) & (PAIR_SLOT_CNT - 1);
+  // there are at most SAMPLE_SIZE pairs, which is less than slot count, so empty slot always exists
+  while (0 != pair_slots[slot].key_ && key != pair_slots[slot].key_) {
+    slot = (slot + 1) & (PAIR_SLOT_CNT - 1);
+  }
+  if (0 == pair_slots[slot].key_) {
+    pair_slots[slot].key_ = key;
+    touched_slots[touched_cnt++] = slot;
+  }
+  ++pair_slots[slot].cnt_;
+}
+
+void ObFSSTSymbolTable::get_code_symbol(const int64_t code, uint64_t &symbol, int64_t &len) const
+{
+  if (code >= LITERAL_CODE_BASE) {
+    symbol = static_cast<uint64_t>(code - LITERAL_CODE_BASE);
+    len = 1;
+  } else {
+    symbol = symbols_[code];
+    len = lens_[code];
+  }
+}
+
+void ObFSSTSymbolTable::sort_symbols()
+{
+  Candidate sorted[MAX_SYMBOL_CNT];
+  for (int64_t i = 0; i < symbol_cnt_; ++i) {
+    sorted[i].symbol_ = symbols_[i];
+    sorted[i].len_ = lens_[i];
+  }
+  lib::ob_sort(sorted, sorted + symbol_cnt_, [](const Candidate &left, const Candidate &right) {
+    const uint8_t left_first = static_cast<uint8_t>(left.symbol_ & 0xFF);
+    const uint8_t right_first = static_cast<uint8_t>(right.symbol_ & 0xFF);
+    return left_first < right_first
+        || (left_first == right_first && left.len_ > right.len_)
+        || (left_first == right_first && left.len_ == right.len_ && left.symbol_ < right.symbol_);
+  });
+  for (int64_t i = 0; i < symbol_cnt_; ++i) {
+    symbols_[i] = sorted[i].symbol_;
+    lens_[i] = sorted[i].len_;
+  }
+}
+
+void ObFSSTSymbolTable::build_first_byte_index()
+{
+  MEMSET(first_byte_start_, 0, sizeof(first_byte_start_));
+  for (int64_t i = 0; i < symbol_cnt_; ++i) {
+    ++first_byte_start_[(symbols_[i] & 0xFF) + 1];
+  }
+  for (int64_t i = 1; i < UINT8_MAX + 2; ++i) {
+    first_byte_start_[i] += first_byte_start_[i - 1];
+  }
+}
+
+int ObFSSTSymbolTable::load(const ObFSSTSymbolTableMeta &meta)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_UNLIKELY(ObFSSTSymbolTableMeta::OB_FSST_SYMBOL_TABLE_META_V1 != meta.version_
+      || meta.symbol_cnt_ > MAX_SYMBOL_CNT)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid fsst symbol table", K(ret), K(meta));
+  } else {
+    // symbols are serialized in sorted order, codes must be kept
+    symbol_cnt_ = meta.symbol_cnt_;
+    MEMCPY(lens_, meta.get_lens(), symbol_cnt_);
+    MEMCPY(symbols_, meta.get_symbols(), symbol_cnt_ * sizeof(uint64_t));
+    build_first_byte_index();
+  }
+  return ret;
+}
+
+int64_t ObFSSTSymbolTable::compress(const char *in, const int64_t len, char *out) const
+{
+  int64_t out_len = 0;
+  int64_t pos = 0;
+  while (pos < len) {
+    const int64_t code = find_longest_symbol(in + pos, len - pos);
+    if (code < 0) {
+      out[out_len++] = static_cast<char>(ESCAPE_CODE);
+      out[out_len++] = in[pos++];
+    } else {
+      out[out_len++] = static_cast<char>(code);
+      pos += lens_[code];
+    }
+  }
+  return out_len;
+}
+
+int ObFSSTSymbolTable::serialize(
+    const uint32_t max_string_len, char *buf, const int64_t buf_len, int64_t &pos) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t size = get_serialize_size();
+  if (OB_ISNULL(buf) || OB_UNLIKELY(pos < 0 || pos + size > buf_len)) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LOG_WARN("buf not enough", K(ret), KP(buf), K(buf_len), K(pos), K(size));
+  } else {
+    ObFSSTSymbolTableMeta meta;
+    meta.symbol_cnt_ = static_cast<uint8_t>(symbol_cnt_);
+    meta.max_string_len_ = max_string_len;
+    MEMCPY(buf + pos, &meta, sizeof(meta));
+    MEMCPY(buf + pos + sizeof(meta), lens_, symbol_cnt_);
+    MEMCPY(buf + pos + sizeof(meta) + symbol_cnt_, symbols_, symbol_cnt_ * sizeof(uint64_t));
+    pos += size;
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
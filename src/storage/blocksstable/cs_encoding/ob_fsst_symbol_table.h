@@ -0,0 +1,203 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_FSST_SYMBOL_TABLE_H_
+#define OCEANBASE_ENCODING_OB_FSST_SYMBOL_TABLE_H_
+
+#include "lib/allocator/ob_allocator.h"
+#include "lib/utility/ob_print_utils.h"
+#include "storage/blocksstable/encoding/ob_encoding_util.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// Symbol table of FSST_STRING column, stored in column meta after the null bitmap.
+// Layout: ObFSSTSymbolTableMeta | uint8_t lens[symbol_cnt] | uint64_t symbols[symbol_cnt],
+// symbols are stored in little endian with zero high bytes and may be unaligned.
+struct ObFSSTSymbolTableMeta final
+{
+  static constexpr uint8_t OB_FSST_SYMBOL_TABLE_META_V1 = 0;
+  ObFSSTSymbolTableMeta()
+    : version_(OB_FSST_SYMBOL_TABLE_META_V1), symbol_cnt_(0), reserved_(0), max_string_len_(0) {}
+
+  static OB_INLINE int64_t get_size(const int64_t symbol_cnt)
+  {
+    return sizeof(ObFSSTSymbolTableMeta) + symbol_cnt * (sizeof(uint8_t) + sizeof(uint64_t));
+  }
+  OB_INLINE int64_t get_size() const { return get_size(symbol_cnt_); }
+  OB_INLINE const uint8_t *get_lens() const
+  {
+    return reinterpret_cast<const uint8_t *>(this) + sizeof(ObFSSTSymbolTableMeta);
+  }
+  OB_INLINE const char *get_symbols() const
+  {
+    return reinterpret_cast<const char *>(get_lens()) + symbol_cnt_;
+  }
+
+  TO_STRING_KV(K_(version), K_(symbol_cnt), K_(max_string_len));
+
+  uint8_t version_;
+  uint8_t symbol_cnt_;
+  uint16_t reserved_;
+  uint32_t max_string_len_; // max length of the original strings
+} __attribute__((packed));
+
+// FSST(Fast Static Symbol Table) compresses strings by replacing the frequent substrings of
+// at most 8 bytes with 1 byte codes, the bytes not covered by symbols are stored as escape code
+// and the literal byte. Each string is compressed independently, so any row can be decompressed
+// without touching others, and the same string is always compressed to the same bytes with one
+// symbol table, which makes equality filter can be evaluated on compressed data.
+class ObFSSTSymbolTable
+{
+public:
+  static const int64_t MAX_SYMBOL_CNT = 255;
+  static const int64_t MAX_SYMBOL_LEN = 8;
+  static const uint8_t ESCAPE_CODE = 255;
+  // out buffer of decompress must has this extra size, since symbols are copied in 8 bytes
+  static const int64_t DECOMPRESS_PADDING_SIZE = 8;
+
+  ObFSSTSymbolTable() { reset(); }
+  ~ObFSSTSymbolTable() {}
+  void reset();
+
+  // train the symbol table on the sample of non-null datums
+  int build(const ObColDatums &datums, const int64_t var_data_size, common::ObIAllocator &allocator);
+  // load the symbol table serialized in block for compressing filter literals
+  int load(const ObFSSTSymbolTableMeta &meta);
+  // the size of %out must be at least 2 * %len
+  int64_t compress(const char *in, const int64_t len, char *out) const;
+  OB_INLINE int64_t get_symbol_cnt() const { return symbol_cnt_; }
+  OB_INLINE int64_t get_serialize_size() const { return ObFSSTSymbolTableMeta::get_size(symbol_cnt_); }
+  int serialize(const uint32_t max_string_len, char *buf, const int64_t buf_len, int64_t &pos) const;
+
+  static OB_INLINE int64_t get_decompress_len(
+      const ObFSSTSymbolTableMeta &meta, const char *in, const int64_t len)
+  {
+    const uint8_t *lens = meta.get_lens();
+    const uint8_t *codes = reinterpret_cast<const uint8_t *>(in);
+    int64_t out_len = 0;
+    int64_t pos = 0;
+    while (pos < len) {
+      if (ESCAPE_CODE == codes[pos]) {
+        out_len += 1;
+        pos += 2;
+      } else {
+        out_len += lens[codes[pos]];
+        pos += 1;
+      }
+    }
+    return out_len;
+  }
+
+  // %out must have DECOMPRESS_PADDING_SIZE bytes after the decompressed string
+  static OB_INLINE int64_t decompress(
+      const ObFSSTSymbolTableMeta &meta, const char *in, const int64_t len, char *out)
+  {
+    const uint8_t *lens = meta.get_lens();
+    const char *symbols = meta.get_symbols();
+    const uint8_t *codes = reinterpret_cast<const uint8_t *>(in);
+    int64_t out_len = 0;
+    int64_t pos = 0;
+    while (pos < len) {
+      const uint8_t code = codes[pos];
+      if (ESCAPE_CODE == code) {
+        out[out_len++] = in[pos + 1];
+        pos += 2;
+      } else {
+        MEMCPY(out + out_len, symbols + code * sizeof(uint64_t), sizeof(uint64_t));
+        out_len += lens[code];
+        pos += 1;
+      }
+    }
+    return out_len;
+  }
+
+  TO_STRING_KV(K_(symbol_cnt));
+
+private:
+  static const int64_t SAMPLE_SIZE = 16 << 10; // 16KB
+  static const int64_t TRAIN_ROUNDS = 5;
+  // code space used in training, [0, MAX_SYMBOL_CNT) are symbols and
+  // [LITERAL_CODE_BASE, LITERAL_CODE_BASE + 256) are single bytes
+  static const int64_t LITERAL_CODE_BASE = 256;
+  static const int64_t CODE_SPACE = 512;
+  static const int64_t PAIR_SLOT_CNT = 1 << 15;
+
+  struct Candidate
+  {
+    uint64_t symbol_;
+    uint32_t gain_;
+    uint8_t len_;
+  };
+  struct PairSlot
+  {
+    uint32_t key_; // (first_code << 9 | second_code) + 1, 0 means empty
+    uint32_t cnt_;
+  };
+
+  static OB_INLINE uint64_t load_word(const char *in, const int64_t len)
+  {
+    uint64_t word = 0;
+    MEMCPY(&word, in, len < MAX_SYMBOL_LEN ? len : static_cast<int64_t>(MAX_SYMBOL_LEN));
+    return word;
+  }
+  static OB_INLINE uint64_t get_symbol_mask(const int64_t len)
+  {
+    return len >= MAX_SYMBOL_LEN ? UINT64_MAX : ((1UL << (len * CHAR_BIT)) - 1);
+  }
+  // return the code of longest symbol matches the prefix of %in, -1 if not found
+  OB_INLINE int64_t find_longest_symbol(const char *in, const int64_t len) const
+  {
+    int64_t code = -1;
+    const uint8_t first_byte = static_cast<uint8_t>(in[0]);
+    const uint64_t word = load_word(in, len);
+    for (int64_t i = first_byte_start_[first_byte]; i < first_byte_start_[first_byte + 1]; ++i) {
+      if (lens_[i] <= len && (word & get_symbol_mask(lens_[i])) == symbols_[i]) {
+        code = i;
+        break;
+      }
+    }
+    return code;
+  }
+  int collect_samples(
+      const ObColDatums &datums,
+      const int64_t var_data_size,
+      common::ObIAllocator &allocator,
+      common::ObString *&samples,
+      int64_t &sample_cnt);
+  int train_round(
+      const common::ObString *samples,
+      const int64_t sample_cnt,
+      uint32_t *code_cnts,
+      PairSlot *pair_slots,
+      uint32_t *touched_slots,
+      Candidate *candidates);
+  void add_pair(const int64_t first, const int64_t second, PairSlot *pair_slots,
+                uint32_t *touched_slots, int64_t &touched_cnt);
+  void get_code_symbol(const int64_t code, uint64_t &symbol, int64_t &len) const;
+  // sort symbols by first byte and length desc, so greedy search stops at the longest match
+  void sort_symbols();
+  void build_first_byte_index();
+
+private:
+  int64_t symbol_cnt_;
+  uint64_t symbols_[MAX_SYMBOL_CNT];
+  uint8_t lens_[MAX_SYMBOL_CNT];
+  uint16_t first_byte_start_[UINT8_MAX + 2];
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_ENCODING_OB_FSST_SYMBOL_TABLE_H_
@@ -18,6 +18,8 @@
 #include "ob_dict_column_decoder.h"
 #include "ob_integer_column_decoder.h"
 #include "ob_string_column_decoder.h"
+#include "ob_fsst_string_column_decoder.h"
+#include "ob_alp_float_column_decoder.h"
 #include "share/rc/ob_tenant_base.h"
 #include "storage/access/ob_pushdown_aggregate.h"
 #include "storage/access/ob_table_access_context.h"
@@ -232,6 +234,8 @@ static local_decode_acquire_func acquire_local_funcs_[ObCSColumnHeader::MAX_TYPE
     acquire_local_decoder<ObStringColumnDecoder>,
     acquire_local_decoder<ObIntDictColumnDecoder>,
     acquire_local_decoder<ObStrDictColumnDecoder>,
+    acquire_local_decoder<ObFSSTStringColumnDecoder>,
+    acquire_local_decoder<ObALPFloatColumnDecoder>,
 };
 
 static local_decode_release_func release_local_funcs_[ObCSColumnHeader::MAX_TYPE] = {
@@ -239,6 +243,8 @@ static local_decode_release_func release_local_funcs_[ObCSColumnHeader::MAX_TYPE
     release_local_decoder<ObStringColumnDecoder>,
     release_local_decoder<ObIntDictColumnDecoder>,
     release_local_decoder<ObStrDictColumnDecoder>,
+    release_local_decoder<ObFSSTStringColumnDecoder>,
+    release_local_decoder<ObALPFloatColumnDecoder>,
 };
 
 template <class Decoder>
@@ -789,6 +795,24 @@ int ObMicroBlockCSDecoder::acquire(
     }
     break;
   }
+  case ObCSColumnHeader::FSST_STRING: {
+    ObFSSTStringColumnDecoder *d = NULL;
+    if (OB_FAIL(allocator.alloc(d))) {
+      LOG_WARN("alloc failed", K(ret));
+    } else {
+      decoder = d;
+    }
+    break;
+  }
+  case ObCSColumnHeader::ALP_FLOAT: {
+    ObALPFloatColumnDecoder *d = NULL;
+    if (OB_FAIL(allocator.alloc(d))) {
+      LOG_WARN("alloc failed", K(ret));
+    } else {
+      decoder = d;
+    }
+    break;
+  }
   default:
     ret = OB_INNER_STAT_ERROR;
     LOG_WARN("unsupported encoding type", K(ret), K(type));
@@ -269,6 +269,8 @@ public:
       sql::ObExprPtrIArray &exprs) override;
   virtual bool has_lob_out_row() const override final
   { return transform_helper_.get_micro_block_header()->has_lob_out_row(); }
+  virtual bool has_shared_dict() const override final
+  { return transform_helper_.get_micro_block_header()->has_shared_dict(); }
 
 private:
   // use inner_reset to reuse the decoder buffer
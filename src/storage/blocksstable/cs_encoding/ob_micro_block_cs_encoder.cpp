@@ -15,9 +15,11 @@
 #include "ob_micro_block_cs_encoder.h"
 #include "lib/container/ob_array_iterator.h"
 #include "ob_cs_encoding_util.h"
+#include "ob_cs_shared_dict.h"
 #include "ob_icolumn_cs_encoder.h"
 #include "ob_integer_column_encoder.h"
 #include "ob_integer_stream_encoder.h"
+#include "ob_str_dict_column_encoder.h"
 #include "share/config/ob_server_config.h"
 #include "share/ob_force_print_log.h"
 #include "share/ob_task_define.h"
@@ -601,6 +603,7 @@ int ObMicroBlockCSEncoder::build_block(char *&buf, int64_t &size)
     LOG_WARN("empty micro block", K(ret));
   } else if (OB_FAIL(set_datum_rows_ptr_())) {
     LOG_WARN("fail to set datum rows ptr", K(ret));
+  } else if (FALSE_IT(reset_shared_dict_pending_())) {
   } else if (OB_FAIL(encoder_detection_())) {
     LOG_WARN("detect column encoding failed", K(ret));
   } else if (OB_FAIL(data_buffer_.write_nop(all_column_header_size + column_headers_size))) {
@@ -647,6 +650,7 @@ int ObMicroBlockCSEncoder::build_block(char *&buf, int64_t &size)
       header->has_string_out_row_ = has_string_out_row_;
       header->all_lob_in_row_ = !has_lob_out_row_;
       header->max_merged_trans_version_ = max_merged_trans_version_;
+      header->has_shared_dict_ = has_shared_dict_column_();
 
       // update encoding context
       ctx_.estimate_block_size_ += estimate_size_;
@@ -671,6 +675,25 @@ int ObMicroBlockCSEncoder::build_block(char *&buf, int64_t &size)
   return ret;
 }
 
+void ObMicroBlockCSEncoder::reset_shared_dict_pending_()
+{
+  // values appended by the last build of this micro block are not referenced any more
+  if (nullptr != ctx_.shared_dict_builder_) {
+    ctx_.shared_dict_builder_->reset_pending();
+  }
+}
+
+bool ObMicroBlockCSEncoder::has_shared_dict_column_() const
+{
+  bool has_shared_dict = false;
+  for (int64_t i = 0; !has_shared_dict && i < encoders_.count(); ++i) {
+    const ObIColumnCSEncoder *e = encoders_.at(i);
+    has_shared_dict = ObCSColumnHeader::STR_DICT == e->get_type()
+        && static_cast<const ObStrDictColumnEncoder *>(e)->is_shared_dict();
+  }
+  return has_shared_dict;
+}
+
 int ObMicroBlockCSEncoder::init_column_ctxs_()
 {
   int ret = OB_SUCCESS;
@@ -1087,6 +1110,10 @@ int ObMicroBlockCSEncoder::choose_specified_encoder_(const int64_t column_idx,
       if (OB_FAIL(alloc_and_init_encoder_<ObIntDictColumnEncoder>(column_idx, e))) {
         LOG_WARN("fail to alloc encoder", K(ret), K(column_idx), K(store_class));
       }
+    } else if (ObCSColumnHeader::Type::ALP_FLOAT == type) {
+      if (OB_FAIL(alloc_and_init_encoder_<ObALPFloatColumnEncoder>(column_idx, e))) {
+        LOG_WARN("fail to alloc encoder", K(ret), K(column_idx), K(store_class));
+      }
     } else {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("specified unexpected econding type", K(ret), K(column_idx), K(store_class), K(col_ctx));
@@ -1100,6 +1127,10 @@ int ObMicroBlockCSEncoder::choose_specified_encoder_(const int64_t column_idx,
       if (OB_FAIL(alloc_and_init_encoder_<ObStrDictColumnEncoder>(column_idx, e))) {
         LOG_WARN("fail to alloc encoder", K(ret), K(column_idx), K(store_class));
       }
+    } else if (ObCSColumnHeader::Type::FSST_STRING == type) {
+      if (OB_FAIL(alloc_and_init_encoder_<ObFSSTStringColumnEncoder>(column_idx, e))) {
+        LOG_WARN("fail to alloc encoder", K(ret), K(column_idx), K(store_class));
+      }
     } else {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("specified unexpected econding type", K(ret), K(type), K(store_class), K(col_ctx));
@@ -1158,13 +1189,20 @@ int ObMicroBlockCSEncoder::choose_encoder_for_integer_(
   int ret = OB_SUCCESS;
   ObIColumnCSEncoder *integer_encoder = nullptr;
   ObIColumnCSEncoder *dict_encoder = nullptr;
+  ObIColumnCSEncoder *alp_encoder = nullptr;
+  const ObObjMeta column_type = ctx_.col_descs_->at(column_idx).col_type_;
   if (OB_FAIL(alloc_and_init_encoder_<ObIntegerColumnEncoder>(column_idx, integer_encoder))) {
     LOG_WARN("fail to alloc encoder", K(ret), K(column_idx));
   } else if (OB_FAIL(alloc_and_init_encoder_<ObIntDictColumnEncoder>(column_idx, dict_encoder))) {
     LOG_WARN("fail to alloc encoder", K(ret), K(column_idx));
+  } else if (ctx_.major_working_cluster_version_ >= DATA_VERSION_4_3_2_0
+      && ObALPFloatColumnEncoder::is_applicable(col_ctxs_.at(column_idx), column_type)
+      && OB_FAIL(alloc_and_init_encoder_<ObALPFloatColumnEncoder>(column_idx, alp_encoder))) {
+    LOG_WARN("fail to alloc encoder", K(ret), K(column_idx));
   } else {
     int64_t integer_estimate_size = integer_encoder->estimate_store_size();
     int64_t dict_estimate_size = dict_encoder->estimate_store_size();
+    int64_t alp_estimate_size = nullptr == alp_encoder ? INT64_MAX : alp_encoder->estimate_store_size();
     if (dict_estimate_size < integer_estimate_size) {
       e = dict_encoder;
       free_encoder_(integer_encoder);
@@ -1174,11 +1212,27 @@ int ObMicroBlockCSEncoder::choose_encoder_for_integer_(
       free_encoder_(dict_encoder);
       dict_encoder = nullptr;
     }
+    if (nullptr != alp_encoder) {
+      if (alp_estimate_size < MIN(integer_estimate_size, dict_estimate_size)) {
+        free_encoder_(e);
+        integer_encoder = nullptr;
+        dict_encoder = nullptr;
+        e = alp_encoder;
+      } else {
+        free_encoder_(alp_encoder);
+        alp_encoder = nullptr;
+      }
+    }
     LOG_DEBUG("choose encoder for integer", K(ret), K(column_idx),
-       K(integer_estimate_size), K(dict_estimate_size), KPC(integer_encoder), KPC(dict_encoder));
+       K(integer_estimate_size), K(dict_estimate_size), K(alp_estimate_size),
+       KPC(integer_encoder), KPC(dict_encoder), KPC(alp_encoder));
   }
 
   if (OB_FAIL(ret)) {
+    if (nullptr != alp_encoder) {
+      free_encoder_(alp_encoder);
+      alp_encoder = nullptr;
+    }
     if (nullptr != integer_encoder) {
       free_encoder_(integer_encoder);
       integer_encoder = nullptr;
@@ -1199,13 +1253,22 @@ int ObMicroBlockCSEncoder::choose_encoder_for_string_(
   int ret = OB_SUCCESS;
   ObIColumnCSEncoder *string_encoder = nullptr;
   ObIColumnCSEncoder *dict_encoder = nullptr;
+  ObIColumnCSEncoder *fsst_encoder = nullptr;
+  const ObObjMeta column_type = ctx_.col_descs_->at(column_idx).col_type_;
+  const ObObjTypeStoreClass store_class =
+    get_store_class_map()[ob_obj_type_class(column_type.get_type())];
   if (OB_FAIL(alloc_and_init_encoder_<ObStringColumnEncoder>(column_idx, string_encoder))) {
     LOG_WARN("fail to alloc encoder", K(ret), K(column_idx));
   } else if (OB_FAIL(alloc_and_init_encoder_<ObStrDictColumnEncoder>(column_idx, dict_encoder))) {
     LOG_WARN("fail to alloc encoder", K(ret), K(column_idx));
+  } else if (ctx_.major_working_cluster_version_ >= DATA_VERSION_4_3_2_0
+      && ObFSSTStringColumnEncoder::is_applicable(col_ctxs_.at(column_idx), store_class)
+      && OB_FAIL(alloc_and_init_encoder_<ObFSSTStringColumnEncoder>(column_idx, fsst_encoder))) {
+    LOG_WARN("fail to alloc encoder", K(ret), K(column_idx));
   } else {
     int64_t string_estimate_size = string_encoder->estimate_store_size();
     int64_t dict_estimate_size = dict_encoder->estimate_store_size();
+    int64_t fsst_estimate_size = nullptr == fsst_encoder ? INT64_MAX : fsst_encoder->estimate_store_size();
     if (dict_estimate_size < string_estimate_size) {
       e = dict_encoder;
       free_encoder_(string_encoder);
@@ -1215,11 +1278,29 @@ int ObMicroBlockCSEncoder::choose_encoder_for_string_(
       free_encoder_(dict_encoder);
       dict_encoder = nullptr;
     }
+    // fsst output is hard to compress by the block compressor, while the plain string
+    // stream is usually well compressed, so fsst must win by a clear margin
+    if (nullptr != fsst_encoder) {
+      if (fsst_estimate_size < MIN(string_estimate_size, dict_estimate_size) / 5 * 4) {
+        free_encoder_(e);
+        string_encoder = nullptr;
+        dict_encoder = nullptr;
+        e = fsst_encoder;
+      } else {
+        free_encoder_(fsst_encoder);
+        fsst_encoder = nullptr;
+      }
+    }
     LOG_DEBUG("choose encoder for var length type", K(ret), K(column_idx),
-      K(string_estimate_size), K(dict_estimate_size), KPC(string_encoder), KPC(dict_encoder));
+      K(string_estimate_size), K(dict_estimate_size), K(fsst_estimate_size),
+      KPC(string_encoder), KPC(dict_encoder), KPC(fsst_encoder));
   }
 
   if (OB_FAIL(ret)) {
+    if (nullptr != fsst_encoder) {
+      free_encoder_(fsst_encoder);
+      fsst_encoder = nullptr;
+    }
     if (nullptr != string_encoder) {
       free_encoder_(string_encoder);
       string_encoder = nullptr;
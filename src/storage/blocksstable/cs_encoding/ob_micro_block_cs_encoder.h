@@ -102,6 +102,8 @@ private:
   void update_estimate_size_limit_(const ObMicroBlockEncodingCtx &ctx);
   int init_all_col_values_(const ObMicroBlockEncodingCtx &ctx);
   void print_micro_block_encoder_status_();
+  void reset_shared_dict_pending_();
+  bool has_shared_dict_column_() const;
   int store_columns_(int64_t &column_data_offset);
   int store_all_string_data_(uint32_t &data_size, bool &use_compress);
   int store_stream_offsets_(int64_t &stream_offsets_length);
@@ -16,6 +16,7 @@
 #include "ob_cs_encoding_util.h"
 #include "ob_string_stream_encoder.h"
 #include "ob_column_datum_iter.h"
+#include "ob_cs_shared_dict.h"
 #include "storage/blocksstable/ob_imicro_block_writer.h"
 #include "lib/codec/ob_codecs.h"
 
@@ -42,7 +43,9 @@ int ObStrDictColumnEncoder::init(
     if (ctx_->null_cnt_ > 0) {
       dict_encoding_meta_.set_has_null();
     }
-    if (OB_FAIL(build_string_dict_encoder_ctx_())) {
+    if (OB_FAIL(try_use_shared_dict_())) {
+      LOG_WARN("fail to try use shared dict", K(ret));
+    } else if (!is_shared_dict() && OB_FAIL(build_string_dict_encoder_ctx_())) {
       LOG_WARN("fail to build string dict encoder ctx", K(ret));
     } else if (OB_FAIL(build_ref_encoder_ctx_())) {
       LOG_WARN("fail to build ref encoder ctx", K(ret));
@@ -51,6 +54,28 @@ int ObStrDictColumnEncoder::init(
   return ret;
 }
 
+// Only the refs are stored if the distinct values fit into the shared dict of the macro block
+// writer, distinct_val_cnt_ becomes the count of shared dict values including the ones added
+// by this column, which are appended to the shared dict in store_column.
+int ObStrDictColumnEncoder::try_use_shared_dict_()
+{
+  int ret = OB_SUCCESS;
+  ObCSSharedDictBuilder *builder = ctx_->encoding_ctx_->shared_dict_builder_;
+  bool is_shared = false;
+  int64_t dict_cnt = 0;
+  if (nullptr == builder || is_force_raw_ || ObStringSC != store_class_
+      || ctx_->encoding_ctx_->major_working_cluster_version_ < DATA_VERSION_4_3_2_0
+      || 0 == dict_encoding_meta_.distinct_val_cnt_ || ctx_->nope_cnt_ > 0) {
+    // not use shared dict
+  } else if (OB_FAIL(builder->check_column(column_index_, *ctx_->ht_, is_shared, dict_cnt))) {
+    LOG_WARN("fail to check shared dict", K(ret), K_(column_index));
+  } else if (is_shared) {
+    dict_encoding_meta_.distinct_val_cnt_ = static_cast<uint32_t>(dict_cnt);
+    dict_encoding_meta_.set_shared_dict();
+  }
+  return ret;
+}
+
 void ObStrDictColumnEncoder::reuse()
 {
   ObDictColumnEncoder::reuse();
@@ -96,6 +121,19 @@ int ObStrDictColumnEncoder::store_column(ObMicroBufferWriter &buf_writer)
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
     LOG_WARN("not init", K(ret));
+  } else if (is_shared_dict()) {
+    int64_t dict_cnt = 0;
+    if (OB_FAIL(ctx_->encoding_ctx_->shared_dict_builder_->append_column(
+        column_index_, *ctx_->ht_, dict_cnt))) {
+      LOG_WARN("fail to append shared dict", K(ret), K_(column_index));
+    } else if (OB_UNLIKELY(dict_cnt != dict_encoding_meta_.distinct_val_cnt_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("shared dict count changed", K(ret), K(dict_cnt), K_(dict_encoding_meta));
+    } else if (OB_FAIL(store_dict_encoding_meta_(buf_writer))) {
+      LOG_WARN("fail to store dict encoding meta", K(ret), K_(dict_encoding_meta));
+    } else if (OB_FAIL(store_dict_ref_(buf_writer))) {
+      LOG_WARN("fail to store dict ref", K(ret), K_(dict_encoding_meta));
+    }
   } else if (OB_FAIL(sort_dict_())) {
     LOG_WARN("fail to do_sort_dict", K(ret));
   } else if (OB_FAIL(store_dict_encoding_meta_(buf_writer))) {
@@ -166,7 +204,9 @@ int64_t ObStrDictColumnEncoder::estimate_store_size() const
     if (distinct == 0) {
       // has no dict
     } else {
-      if (string_dict_enc_ctx_.meta_.is_fixed_len_string()) {
+      if (is_shared_dict()) {
+        // dict is stored in macro block
+      } else if (string_dict_enc_ctx_.meta_.is_fixed_len_string()) {
         size += string_dict_enc_ctx_.meta_.get_fixed_string_len() * distinct;
       } else {
         // dict_data_size +  dict_string_offset_array_size
@@ -196,7 +236,7 @@ int ObStrDictColumnEncoder::get_maximal_encoding_store_size(int64_t &size) const
       // has no stream
     } else {
       int64_t offset_arry_orig_size = 0;
-      if (!string_dict_enc_ctx_.meta_.is_fixed_len_string()) {
+      if (!is_shared_dict() && !string_dict_enc_ctx_.meta_.is_fixed_len_string()) {
         offset_arry_orig_size = get_byte_packed_int_size(ctx_->dict_var_data_size_) * distinct_cnt;
         size += sizeof(ObIntegerStreamMeta);
         size += common::ObCodec::get_moderate_encoding_size(offset_arry_orig_size);
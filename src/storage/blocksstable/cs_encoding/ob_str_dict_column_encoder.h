@@ -36,10 +36,12 @@ public:
   ObCSColumnHeader::Type get_type() const override { return type_; }
   int get_maximal_encoding_store_size(int64_t &size) const override;
   int get_string_data_len(uint32_t &len) const override;
+  bool is_shared_dict() const { return dict_encoding_meta_.is_shared_dict(); }
 
   INHERIT_TO_STRING_KV("ObDictColumnEncoder", ObDictColumnEncoder, K_(string_dict_enc_ctx));
 
 private:
+  int try_use_shared_dict_();
   int build_string_dict_encoder_ctx_();
   int sort_dict_();
   int store_dict_(ObMicroBufferWriter &buf_writer);
@@ -477,6 +477,82 @@ int ObColSumAggregator::eval_double(const common::ObDatum &datum)
   return ret;
 }
 
+int ObColBloomFilterAggregator::init(const ObColDesc &col_desc, ObStorageDatum &result)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(ObIColAggregator::init(col_desc, result))) {
+    LOG_WARN("fail to init ObIColAggregator", K(ret));
+  } else if (!can_agg_bloom_filter(col_desc.col_type_.get_type())) {
+    set_not_aggregate();
+  } else {
+    const ObObjType type = col_desc.col_type_.get_type();
+    const ObPrecision precision = ob_is_decimal_int(type)
+        ? col_desc.col_type_.get_stored_precision() : PRECISION_UNKNOWN_YET;
+    sql::ObExprBasicFuncs *basic_funcs = ObDatumFuncs::get_basic_func(
+        type, col_desc.col_type_.get_collation_type(), SCALE_UNKNOWN_YET,
+        lib::is_oracle_mode(), true/*is_lob_locator*/, precision);
+    hash_func_ = basic_funcs->murmur_hash_v2_;
+    bloom_filter_.reset();
+  }
+  LOG_DEBUG("[SKIP INDEX] init bloom filter aggregator", K(col_desc_), K(can_aggregate_));
+  return ret;
+}
+
+void ObColBloomFilterAggregator::reuse()
+{
+  ObIColAggregator::reuse();
+  bloom_filter_.reset();
+  if (!can_agg_bloom_filter(col_desc_.col_type_.get_type())) {
+    set_not_aggregate();
+  }
+}
+
+int ObColBloomFilterAggregator::eval(const ObStorageDatum &datum, const bool is_data)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(result_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not init", K(ret));
+  } else if (!can_aggregate_ || datum.is_nop()) {
+    // Skip
+  } else if (is_data) {
+    uint64_t hash = 0;
+    if (datum.is_null()) {
+      // null never matches equal or in filter
+    } else if (OB_FAIL(hash_func_(datum, ObSkipIndexBloomFilter::HASH_SEED, hash))) {
+      LOG_WARN("Failed to calc hash of datum", K(ret), K(datum), K(col_desc_));
+    } else {
+      bloom_filter_.insert(hash);
+    }
+  } else if (datum.is_null()) {
+    // filter of child block is not aggregated
+    set_not_aggregate();
+  } else if (OB_FAIL(bloom_filter_.merge(datum.ptr_, datum.len_))) {
+    LOG_WARN("Failed to merge bloom filter of child block", K(ret), K(datum), K(col_desc_));
+  }
+  return ret;
+}
+
+int ObColBloomFilterAggregator::get_result(const ObStorageDatum *&result)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(result_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not init", K(ret));
+  } else {
+    int64_t pos = 0;
+    if (!can_aggregate_ || bloom_filter_.is_saturated()) {
+      result_->set_nop();
+    } else if (OB_FAIL(bloom_filter_.serialize(buf_, sizeof(buf_), pos))) {
+      LOG_WARN("Failed to serialize bloom filter", K(ret), K_(bloom_filter));
+    } else {
+      result_->set_string(buf_, static_cast<uint32_t>(pos));
+    }
+    result = result_;
+  }
+  return ret;
+}
+
 ObSkipIndexAggregator::ObSkipIndexAggregator()
   : allocator_(nullptr),
     col_aggs_(),
@@ -655,13 +731,16 @@ int ObSkipIndexAggregator::get_aggregated_row(const ObDatumRow *&aggregated_row)
   } else {
     for (int64_t i = 0; OB_SUCC(ret) && i < full_agg_metas_->count(); ++i) {
       const ObStorageDatum *result = nullptr;
+      int64_t max_result_len = ObSkipIndexColMeta::MAX_SKIP_INDEX_COL_LENGTH;
+      if (SK_IDX_BLOOM_FILTER == full_agg_metas_->at(i).col_type_) {
+        max_result_len = ObSkipIndexBloomFilter::MAX_SERIALIZE_SIZE;
+      }
       if (OB_FAIL(col_aggs_.at(i)->get_result(result))) {
         LOG_WARN("Fail to get result from column aggregator", K(ret));
       } else if (OB_ISNULL(result)) {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("Fail to get aggregated column result", K(ret), K(i));
-      } else if (OB_UNLIKELY(result->len_ > ObSkipIndexColMeta::MAX_SKIP_INDEX_COL_LENGTH
-          || result->is_outrow())) {
+      } else if (OB_UNLIKELY(result->len_ > max_result_len || result->is_outrow())) {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("Unexpected aggregated result datum", K(ret), K(result), K(i), K_(full_agg_metas));
       }
@@ -726,6 +805,10 @@ int ObSkipIndexAggregator::calc_max_agg_size(
             cur_max_cell_size += sum_store_size;
             break;
           }
+          case ObSkipIndexColType::SK_IDX_BLOOM_FILTER: {
+            cur_max_cell_size += ObSkipIndexBloomFilter::MAX_SERIALIZE_SIZE;
+            break;
+          }
           default: {
             ret = OB_NOT_SUPPORTED;
             LOG_WARN("Not support skip index aggregate type", K(ret), K(idx_type));
@@ -792,6 +875,13 @@ int ObSkipIndexAggregator::init_col_aggregators(
         }
         break;
       }
+      case ObSkipIndexColType::SK_IDX_BLOOM_FILTER: {
+        if (OB_FAIL(init_col_aggregator<ObColBloomFilterAggregator>(
+            full_col_descs.at(col_idx), agg_result_->storage_datums_[i], allocator))) {
+          LOG_WARN("Fail to allocate column aggregator", K(ret));
+        }
+        break;
+      }
       default: {
         ret = OB_NOT_SUPPORTED;
         LOG_WARN("Not supported skip index aggregate type", K(ret), K(idx_type));
@@ -14,6 +14,7 @@
 #define OCEANBASE_BLOCKSSTABLE_OB_INDEX_BLOCK_AGGREGATOR_
 
 #include "share/schema/ob_table_param.h"
+#include "sql/engine/expr/ob_expr.h"
 #include "ob_index_block_util.h"
 #include "ob_index_block_row_struct.h"
 
@@ -128,6 +129,24 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObColSumAggregator);
 };
 
+class ObColBloomFilterAggregator : public ObIColAggregator
+{
+public:
+  ObColBloomFilterAggregator() : hash_func_(nullptr), bloom_filter_() {}
+  virtual ~ObColBloomFilterAggregator() {}
+
+  int init(const ObColDesc &col_desc, ObStorageDatum &result) override;
+  void reset() override { new (this) ObColBloomFilterAggregator(); }
+  void reuse() override;
+  int eval(const ObStorageDatum &datum, const bool is_data) override;
+  int get_result(const ObStorageDatum *&result) override;
+private:
+  sql::ObExprHashFuncType hash_func_;
+  ObSkipIndexBloomFilter bloom_filter_;
+  char buf_[ObSkipIndexBloomFilter::MAX_SERIALIZE_SIZE];
+  DISALLOW_COPY_AND_ASSIGN(ObColBloomFilterAggregator);
+};
+
 class ObSkipIndexAggregator final
 {
 public:
@@ -50,6 +50,12 @@ int ObSkipIndexColMeta::append_skip_index_meta(
       STORAGE_LOG(WARN, "failed to push sum skip index meta", K(ret));
     }
   }
+
+  if (OB_SUCC(ret) && skip_idx_attr.has_bloom_filter()) {
+    if (OB_FAIL(skip_idx_metas.push_back(ObSkipIndexColMeta(col_idx, ObSkipIndexColType::SK_IDX_BLOOM_FILTER)))) {
+      STORAGE_LOG(WARN, "failed to push bloom filter skip index meta", K(ret));
+    }
+  }
   return ret;
 }
 
@@ -78,6 +84,7 @@ int ObSkipIndexColMeta::calc_skip_index_maximum_size(
       has_null_count_column = true;
     }
     const int64_t null_count_column_cnt = has_null_count_column ? 1 : 0;
+    const int64_t bloom_filter_column_cnt = skip_idx_attr.has_bloom_filter() ? 1 : 0;
     uint32_t data_type_upper_size = 0;
     uint32_t null_count_upper_size = 0;
     uint32_t sum_store_size = 0;
@@ -89,11 +96,171 @@ int ObSkipIndexColMeta::calc_skip_index_maximum_size(
       LOG_WARN("failed to get sum store size", K(ret), K(obj_type));
     } else {
       max_size = normal_agg_column_cnt * data_type_upper_size + sum_column_cnt * sum_store_size
-          + null_count_column_cnt * null_count_upper_size;
+          + null_count_column_cnt * null_count_upper_size
+          + bloom_filter_column_cnt * ObSkipIndexBloomFilter::MAX_SERIALIZE_SIZE;
     }
   }
   return ret;
 }
 
+void ObSkipIndexBloomFilter::reset()
+{
+  is_bitmap_ = false;
+  hash_cnt_ = 0;
+}
+
+void ObSkipIndexBloomFilter::insert(const uint64_t hash)
+{
+  if (is_bitmap_) {
+    set_bits(hash);
+  } else {
+    int64_t pos = 0;
+    while (pos < hash_cnt_ && hashes_[pos] < hash) {
+      ++pos;
+    }
+    if (pos < hash_cnt_ && hashes_[pos] == hash) {
+      // exists
+    } else if (hash_cnt_ < MAX_HASH_SET_CNT) {
+      for (int64_t i = hash_cnt_; i > pos; --i) {
+        hashes_[i] = hashes_[i - 1];
+      }
+      hashes_[pos] = hash;
+      ++hash_cnt_;
+    } else {
+      to_bitmap();
+      set_bits(hash);
+    }
+  }
+}
+
+int ObSkipIndexBloomFilter::merge(const char *buf, const int64_t buf_len)
+{
+  int ret = OB_SUCCESS;
+  const Header *header = nullptr;
+  if (OB_FAIL(check_header(buf, buf_len, header))) {
+    LOG_WARN("invalid serialized bloom filter", K(ret), KP(buf), K(buf_len));
+  } else if (BITMAP == header->format_) {
+    const uint8_t *bitmap = reinterpret_cast<const uint8_t *>(buf + sizeof(Header));
+    to_bitmap();
+    for (int64_t i = 0; i < BITMAP_SIZE; ++i) {
+      bitmap_[i] |= bitmap[i];
+    }
+  } else {
+    uint64_t hash = 0;
+    for (int64_t i = 0; i < header->hash_cnt_; ++i) {
+      MEMCPY(&hash, buf + sizeof(Header) + i * sizeof(uint64_t), sizeof(uint64_t));
+      insert(hash);
+    }
+  }
+  return ret;
+}
+
+bool ObSkipIndexBloomFilter::is_saturated() const
+{
+  int64_t set_bit_cnt = 0;
+  if (is_bitmap_) {
+    for (int64_t i = 0; i < BITMAP_SIZE; ++i) {
+      set_bit_cnt += __builtin_popcount(bitmap_[i]);
+    }
+  }
+  return set_bit_cnt > MAX_SET_BIT_CNT;
+}
+
+int64_t ObSkipIndexBloomFilter::get_serialize_size() const
+{
+  return sizeof(Header) + (is_bitmap_ ? BITMAP_SIZE : hash_cnt_ * sizeof(uint64_t));
+}
+
+int ObSkipIndexBloomFilter::serialize(char *buf, const int64_t buf_len, int64_t &pos) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t size = get_serialize_size();
+  if (OB_UNLIKELY(nullptr == buf || pos + size > buf_len)) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LOG_WARN("buffer not enough for bloom filter", K(ret), KP(buf), K(buf_len), K(pos), K(size));
+  } else {
+    Header header;
+    header.version_ = FILTER_VERSION;
+    header.format_ = is_bitmap_ ? BITMAP : HASH_SET;
+    header.hash_cnt_ = is_bitmap_ ? 0 : static_cast<uint16_t>(hash_cnt_);
+    MEMCPY(buf + pos, &header, sizeof(Header));
+    if (is_bitmap_) {
+      MEMCPY(buf + pos + sizeof(Header), bitmap_, BITMAP_SIZE);
+    } else {
+      MEMCPY(buf + pos + sizeof(Header), hashes_, hash_cnt_ * sizeof(uint64_t));
+    }
+    pos += size;
+  }
+  return ret;
+}
+
+int ObSkipIndexBloomFilter::may_contain(
+    const char *buf,
+    const int64_t buf_len,
+    const uint64_t hash,
+    bool &contain)
+{
+  int ret = OB_SUCCESS;
+  const Header *header = nullptr;
+  contain = true;
+  if (OB_FAIL(check_header(buf, buf_len, header))) {
+    LOG_WARN("invalid serialized bloom filter", K(ret), KP(buf), K(buf_len));
+  } else if (BITMAP == header->format_) {
+    const uint8_t *bitmap = reinterpret_cast<const uint8_t *>(buf + sizeof(Header));
+    for (int64_t i = 0; contain && i < PROBE_CNT; ++i) {
+      const uint64_t bit_pos = get_bit_pos(hash, i);
+      contain = 0 != (bitmap[bit_pos >> 3] & (1 << (bit_pos & 7)));
+    }
+  } else {
+    uint64_t stored_hash = 0;
+    contain = false;
+    for (int64_t i = 0; !contain && i < header->hash_cnt_; ++i) {
+      MEMCPY(&stored_hash, buf + sizeof(Header) + i * sizeof(uint64_t), sizeof(uint64_t));
+      contain = stored_hash == hash;
+    }
+  }
+  return ret;
+}
+
+int ObSkipIndexBloomFilter::check_header(const char *buf, const int64_t buf_len, const Header *&header)
+{
+  int ret = OB_SUCCESS;
+  header = reinterpret_cast<const Header *>(buf);
+  if (OB_UNLIKELY(nullptr == buf || buf_len < static_cast<int64_t>(sizeof(Header)))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid bloom filter buffer", K(ret), KP(buf), K(buf_len));
+  } else if (OB_UNLIKELY(FILTER_VERSION != header->version_
+      || (BITMAP == header->format_ && buf_len != MAX_SERIALIZE_SIZE)
+      || (HASH_SET == header->format_
+          && (header->hash_cnt_ > MAX_HASH_SET_CNT
+              || buf_len != static_cast<int64_t>(sizeof(Header) + header->hash_cnt_ * sizeof(uint64_t))))
+      || header->format_ > BITMAP)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected bloom filter header", K(ret), K(header->version_), K(header->format_),
+        K(header->hash_cnt_), K(buf_len));
+  }
+  return ret;
+}
+
+void ObSkipIndexBloomFilter::to_bitmap()
+{
+  if (!is_bitmap_) {
+    MEMSET(bitmap_, 0, BITMAP_SIZE);
+    is_bitmap_ = true;
+    for (int64_t i = 0; i < hash_cnt_; ++i) {
+      set_bits(hashes_[i]);
+    }
+    hash_cnt_ = 0;
+  }
+}
+
+void ObSkipIndexBloomFilter::set_bits(const uint64_t hash)
+{
+  for (int64_t i = 0; i < PROBE_CNT; ++i) {
+    const uint64_t bit_pos = get_bit_pos(hash, i);
+    bitmap_[bit_pos >> 3] |= static_cast<uint8_t>(1 << (bit_pos & 7));
+  }
+}
+
 } // namespace blocksstable
 } // namespace oceanbase
\ No newline at end of file
@@ -27,7 +27,7 @@ struct ObSkipIndexColumnAttr;
 namespace blocksstable
 {
 
-// Only MIN_MAX skipping index is supported now.
+// MIN_MAX and BLOOM_FILTER skipping index are supported now.
 enum ObSkipIndexType : uint8_t
 {
   MIN_MAX,
@@ -43,6 +43,7 @@ enum ObSkipIndexColType : uint8_t
   SK_IDX_MAX,
   SK_IDX_NULL_COUNT,
   SK_IDX_SUM,
+  SK_IDX_BLOOM_FILTER,
   SK_IDX_MAX_COL_TYPE
 };
 
@@ -51,7 +52,7 @@ struct ObSkipIndexColMeta
   // For data with length larger than 40 bytes(normally string), we will store the prefix as min/max
   static constexpr int64_t MAX_SKIP_INDEX_COL_LENGTH = 40;
   static constexpr int64_t SKIP_INDEX_ROW_SIZE_LIMIT = 1 << 10; // 1kb
-  static constexpr int64_t MAX_AGG_COLUMN_PER_ROW = 4; // min / max / null count / sum
+  static constexpr int64_t MAX_AGG_COLUMN_PER_ROW = 5; // min / max / null count / sum / bloom filter
   static constexpr ObObjDatumMapType NULL_CNT_COL_TYPE = OBJ_DATUM_8BYTE_DATA;
   static_assert(common::OBJ_DATUM_NUMBER_RES_SIZE == MAX_SKIP_INDEX_COL_LENGTH,
       "Buffer size of ObStorageDatum and maximum size of skip index data is equal to maximum size of ObNumber");
@@ -98,6 +99,71 @@ struct ObSkipIndexColMeta
   };
 };
 
+// Membership filter of column data in a block, stored as skip index aggregate data of
+// SK_IDX_BLOOM_FILTER type. It keeps the exact set of value hashes when there are few distinct
+// values and turns into a bloom filter of fixed size otherwise, so the filters of child blocks
+// can always be merged into the filter of parent block.
+//
+// Serialized format:
+//   | version(1) | format(1) | hash_cnt(2) | sorted hash values (8 * hash_cnt) or bitmap |
+class ObSkipIndexBloomFilter final
+{
+public:
+  static constexpr int64_t MAX_HASH_SET_CNT = 16;
+  static constexpr int64_t BITMAP_SIZE = 256;
+  static constexpr int64_t BITMAP_BIT_CNT = BITMAP_SIZE * 8;
+  static constexpr int64_t PROBE_CNT = 3;
+  // false positive rate of bitmap with half bits set is 12.5%, stop aggregating beyond that
+  static constexpr int64_t MAX_SET_BIT_CNT = BITMAP_BIT_CNT / 2;
+  static constexpr uint64_t HASH_SEED = 0;
+  static constexpr uint8_t FILTER_VERSION = 1;
+  enum Format : uint8_t
+  {
+    HASH_SET = 0,
+    BITMAP = 1,
+  };
+  struct Header
+  {
+    uint8_t version_;
+    uint8_t format_;
+    uint16_t hash_cnt_;
+  };
+  static constexpr int64_t MAX_SERIALIZE_SIZE = sizeof(Header) + BITMAP_SIZE;
+  static_assert(MAX_HASH_SET_CNT * sizeof(uint64_t) <= BITMAP_SIZE,
+      "serialized hash set should not be larger than bitmap");
+
+public:
+  ObSkipIndexBloomFilter() { reset(); }
+  ~ObSkipIndexBloomFilter() = default;
+  void reset();
+  void insert(const uint64_t hash);
+  // union with a serialized filter
+  int merge(const char *buf, const int64_t buf_len);
+  bool is_saturated() const;
+  int64_t get_serialize_size() const;
+  int serialize(char *buf, const int64_t buf_len, int64_t &pos) const;
+  // check a hash value with a serialized filter, false positive is possible.
+  static int may_contain(const char *buf, const int64_t buf_len, const uint64_t hash, bool &contain);
+  TO_STRING_KV(K_(is_bitmap), K_(hash_cnt));
+
+private:
+  static int check_header(const char *buf, const int64_t buf_len, const Header *&header);
+  static OB_INLINE uint64_t get_bit_pos(const uint64_t hash, const int64_t probe_idx)
+  {
+    const uint64_t h1 = hash & UINT32_MAX;
+    const uint64_t h2 = (hash >> 32) | 1;
+    return (h1 + probe_idx * h2) % BITMAP_BIT_CNT;
+  }
+  void to_bitmap();
+  void set_bits(const uint64_t hash);
+
+private:
+  bool is_bitmap_;
+  int64_t hash_cnt_;
+  uint64_t hashes_[MAX_HASH_SET_CNT];
+  uint8_t bitmap_[BITMAP_SIZE];
+};
+
 enum ObSkipIndexUpperStoreSize {
   SKIP_INDEX_NULL_UPPER_SIZE = 0,
   SKIP_INDEX_8BYTE_UPPER_SIZE = 8,
@@ -172,6 +238,14 @@ OB_INLINE static bool can_agg_sum(const ObObjType &obj_type)
       && ob_obj_type_class(obj_type) != ObObjTypeClass::ObBitTC;
 }
 
+// Float and double are not supported since values equal in comparison may differ in binary.
+OB_INLINE static bool can_agg_bloom_filter(const ObObjType &obj_type)
+{
+  const ObObjTypeClass tc = ob_obj_type_class(obj_type);
+  return is_skip_index_while_list_type(obj_type) && !is_lob_storage(obj_type)
+      && ObFloatTC != tc && ObDoubleTC != tc;
+}
+
 OB_INLINE static int get_sum_store_size(const ObObjType &obj_type, uint32_t &sum_size)
 {
   int ret = OB_SUCCESS;
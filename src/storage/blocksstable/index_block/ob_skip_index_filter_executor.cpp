@@ -116,6 +116,16 @@ int ObSkipIndexFilterExecutor::falsifiable_pushdown_filter(
         }
         break;
       }
+      case ObSkipIndexType::BLOOM_FILTER: {
+        if (filter.is_filter_white_node()) {
+          sql::ObWhiteFilterExecutor &white_filter =
+            static_cast<sql::ObWhiteFilterExecutor &>(filter);
+          if (OB_FAIL(filter_on_bloom_filter(col_idx, white_filter))) {
+            LOG_WARN("Failed to filter on bloom filter", K(ret), K(col_idx));
+          }
+        }
+        break;
+      }
       default :
         ret = OB_NOT_SUPPORTED;
         LOG_WARN("unsupported skip index type", K(ret), K(index_type));
@@ -273,6 +283,105 @@ int ObSkipIndexFilterExecutor::filter_on_min_max(
   return ret;
 }
 
+// Bloom filter can only falsify equal and in filter, rows with hash of filter params absent from
+// the filter of block can not match.
+int ObSkipIndexFilterExecutor::filter_on_bloom_filter(
+    const uint32_t col_idx,
+    sql::ObWhiteFilterExecutor &filter)
+{
+  int ret = OB_SUCCESS;
+  sql::ObBoolMask &fal_desc = filter.get_filter_bool_mask();
+  const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  const sql::ObExpr *col_expr = nullptr;
+  ObStorageDatum bf_datum;
+  fal_desc.set_uncertain();
+  if (sql::WHITE_OP_EQ != op_type && sql::WHITE_OP_IN != op_type) {
+  } else if (filter.is_cmp_op_with_null_ref_value()
+             || (sql::WHITE_OP_IN == op_type && filter.null_param_contained())) {
+    fal_desc.set_always_false();
+  } else if (filter.null_param_contained()) {
+  } else if (OB_ISNULL(col_expr = get_bloom_filter_col_expr(filter))) {
+    // hash of params can not be used to probe
+  } else if (FALSE_IT(meta_.col_idx_ = col_idx)) {
+  } else if (FALSE_IT(meta_.col_type_ = SK_IDX_BLOOM_FILTER)) {
+  } else if (OB_FAIL(agg_row_reader_.read(meta_, bf_datum))) {
+    LOG_WARN("Failed read agg bloom filter", K(ret), K(meta_));
+  } else if (bf_datum.is_null()) {
+    // not aggregated
+  } else {
+    const common::ObIArray<common::ObDatum> &datums = filter.get_datums();
+    const sql::ObExprHashFuncType hash_func = col_expr->basic_funcs_->murmur_hash_v2_;
+    bool may_contain = false;
+    uint64_t hash = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && !may_contain && i < datums.count(); ++i) {
+      if (OB_FAIL(hash_func(datums.at(i), ObSkipIndexBloomFilter::HASH_SEED, hash))) {
+        LOG_WARN("Failed to calc hash of filter param", K(ret), K(datums.at(i)));
+      } else if (OB_FAIL(ObSkipIndexBloomFilter::may_contain(bf_datum.ptr_, bf_datum.len_,
+                                                             hash, may_contain))) {
+        LOG_WARN("Failed to probe bloom filter", K(ret), K(bf_datum));
+      }
+    }
+    if (OB_SUCC(ret) && !may_contain) {
+      fal_desc.set_always_false();
+    }
+    LOG_DEBUG("[SKIP INDEX] filter on bloom filter", K(ret), K(op_type), K(datums.count()),
+              K(may_contain), K(fal_desc));
+  }
+  return ret;
+}
+
+const sql::ObExpr *ObSkipIndexFilterExecutor::get_bloom_filter_col_expr(
+    const sql::ObWhiteFilterExecutor &filter)
+{
+  const sql::ObExpr *filter_expr = filter.get_filter_node().expr_;
+  const sql::ObExpr *col_expr = nullptr;
+  bool is_compatible = true;
+  if (OB_ISNULL(filter_expr)) {
+    is_compatible = false;
+  } else if (sql::WHITE_OP_IN == filter.get_op_type()) {
+    const sql::ObExpr *row_expr = filter_expr->arg_cnt_ == 2 ? filter_expr->args_[1] : nullptr;
+    col_expr = filter_expr->arg_cnt_ == 2 ? filter_expr->args_[0] : nullptr;
+    is_compatible = nullptr != col_expr && nullptr != row_expr && T_REF_COLUMN == col_expr->type_;
+    for (int64_t i = 0; is_compatible && i < row_expr->arg_cnt_; ++i) {
+      is_compatible = nullptr != row_expr->args_[i]
+          && is_bloom_filter_param_compatible(*col_expr, *row_expr->args_[i]);
+    }
+  } else {
+    for (int64_t i = 0; nullptr == col_expr && i < filter_expr->arg_cnt_; ++i) {
+      if (nullptr != filter_expr->args_[i] && T_REF_COLUMN == filter_expr->args_[i]->type_) {
+        col_expr = filter_expr->args_[i];
+      }
+    }
+    for (int64_t i = 0; nullptr != col_expr && is_compatible && i < filter_expr->arg_cnt_; ++i) {
+      const sql::ObExpr *param_expr = filter_expr->args_[i];
+      if (col_expr != param_expr) {
+        is_compatible = nullptr != param_expr && is_bloom_filter_param_compatible(*col_expr, *param_expr);
+      }
+    }
+  }
+  return is_compatible ? col_expr : nullptr;
+}
+
+// Hash values are equal for equal datums of the same type only, and the fixed length char
+// stored without padding is excluded.
+bool ObSkipIndexFilterExecutor::is_bloom_filter_param_compatible(
+    const sql::ObExpr &col_expr,
+    const sql::ObExpr &param_expr)
+{
+  const ObObjMeta &col_meta = col_expr.obj_meta_;
+  const ObObjMeta &param_meta = param_expr.obj_meta_;
+  bool is_compatible = can_agg_bloom_filter(col_meta.get_type())
+      && !col_meta.is_fixed_len_char_type()
+      && col_meta.get_type() == param_meta.get_type()
+      && col_meta.get_collation_type() == param_meta.get_collation_type();
+  if (is_compatible && col_meta.is_decimal_int()) {
+    is_compatible = col_expr.datum_meta_.scale_ == param_expr.datum_meta_.scale_
+        && get_decimalint_type(col_expr.datum_meta_.precision_)
+           == get_decimalint_type(param_expr.datum_meta_.precision_);
+  }
+  return is_compatible;
+}
+
 inline int ObSkipIndexFilterExecutor::pad_column(const ObObjMeta &obj_meta,
                                           const share::schema::ObColumnParam *col_param,
                                           common::ObIAllocator &padding_alloc,
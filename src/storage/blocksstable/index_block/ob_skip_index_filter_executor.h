@@ -58,6 +58,14 @@ private:
                         sql::ObWhiteFilterExecutor &filter,
                         common::ObIAllocator &allocator);
 
+  int filter_on_bloom_filter(const uint32_t col_idx,
+                             sql::ObWhiteFilterExecutor &filter);
+  // Return the column expr if the bloom filter built with hash of column type can be probed by
+  // the params of filter, otherwise return nullptr.
+  static const sql::ObExpr *get_bloom_filter_col_expr(const sql::ObWhiteFilterExecutor &filter);
+  static bool is_bloom_filter_param_compatible(const sql::ObExpr &col_expr,
+                                               const sql::ObExpr &param_expr);
+
   int read_aggregate_data(const uint32_t col_idx,
                    common::ObIAllocator &allocator,
                    const share::schema::ObColumnParam *col_param,
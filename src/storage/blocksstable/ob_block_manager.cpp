@@ -27,6 +27,7 @@
 #include "storage/blocksstable/ob_block_manager.h"
 #include "storage/blocksstable/ob_macro_block_struct.h"
 #include "storage/blocksstable/ob_sstable_meta.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
 #include "storage/blocksstable/ob_tmp_file_store.h"
 #include "storage/slog_ckpt/ob_server_checkpoint_slog_handler.h"
 #include "storage/slog_ckpt/ob_tenant_checkpoint_slog_handler.h"
@@ -968,6 +969,7 @@ int ObBlockManager::sweep_one_block(const MacroBlockId& macro_id)
     LOG_WARN("fail to erase block info from block map", K(ret), K(macro_id));
   } else {
     io_device_->free_block(io_fd);
+    OB_STORE_CACHE.get_flash_cache().invalidate_macro_block(macro_id);
     FLOG_INFO("block manager free block", K(macro_id), K(io_fd));
   }
   return ret;
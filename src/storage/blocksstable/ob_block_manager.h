@@ -233,6 +233,8 @@ public:
   int first_mark_device();
 
   bool is_started() { return is_started_; }
+  // the macro blocks in use are known after first mark, i.e. slog replay is finished
+  bool is_mark_sweep_enabled() { return ATOMIC_LOAD(&is_mark_sweep_enabled_); }
 private:
   struct BlockInfo
   {
@@ -408,7 +410,6 @@ private:
   void update_marker_status(const ObMacroBlockMarkerStatus &tmp_status);
   void disable_mark_sweep() { ATOMIC_SET(&is_mark_sweep_enabled_, false); }
   void enable_mark_sweep() { ATOMIC_SET(&is_mark_sweep_enabled_, true); }
-  bool is_mark_sweep_enabled() { return ATOMIC_LOAD(&is_mark_sweep_enabled_); }
 
   int  extend_file_size_if_need();
   bool check_can_be_extend(
@@ -40,6 +40,7 @@ namespace blocksstable
 
 class ObEncodingHashTable;
 class ObMultiPrefixTree;
+class ObCSSharedDictBuilder;
 
 extern const char *BLOCK_SSTBALE_DIR_NAME;
 extern const char *BLOCK_SSTBALE_FILE_NAME;
@@ -462,6 +463,7 @@ struct ObMicroBlockEncodingCtx
   common::ObRowStoreType row_store_type_;
   bool need_calc_column_chksum_;
   ObCompressorType compressor_type_;
+  ObCSSharedDictBuilder *shared_dict_builder_; // only for cs encoding in major merge
 
   ObMicroBlockEncodingCtx() : macro_block_size_(0), micro_block_size_(0),
     rowkey_column_cnt_(0), column_cnt_(0), col_descs_(nullptr),
@@ -470,7 +472,7 @@ struct ObMicroBlockEncodingCtx
     previous_encodings_(), previous_cs_encoding_(),
     column_encodings_(nullptr), major_working_cluster_version_(0),
     row_store_type_(ENCODING_ROW_STORE), need_calc_column_chksum_(false),
-    compressor_type_(INVALID_COMPRESSOR)
+    compressor_type_(INVALID_COMPRESSOR), shared_dict_builder_(nullptr)
   {
     previous_encodings_.set_attr(ObMemAttr(MTL_ID(), "MicroEncodeCtx"));
   }
@@ -479,7 +481,7 @@ struct ObMicroBlockEncodingCtx
       K_(column_cnt), KP_(col_descs), K_(estimate_block_size), K_(real_block_size),
       K_(micro_block_cnt), K_(encoder_opt), K_(previous_encodings), KP_(column_encodings),
       K_(major_working_cluster_version), K_(row_store_type), K_(need_calc_column_chksum),
-      K_(compressor_type));
+      K_(compressor_type), KP_(shared_dict_builder));
 };
 
 template <typename T, int64_t MAX_COUNT, int64_t BLOCK_SIZE>
@@ -19,6 +19,11 @@
 #include "storage/blocksstable/ob_storage_cache_suite.h"
 #include "ob_datum_rowkey.h"
 #include "storage/access/ob_empty_read_bucket.h"
+#include "common/ob_target_specific.h"
+
+#if OB_USE_MULTITARGET_CODE
+#include <immintrin.h>
+#endif
 
 namespace oceanbase
 {
@@ -26,7 +31,85 @@ using namespace common;
 namespace blocksstable
 {
 
-ObBloomFilter::ObBloomFilter() : allocator_(ObModIds::OB_BLOOM_FILTER), nhash_(0), nbit_(0), bits_(NULL)
+// Probe i of the blocked filter sets bit (key_hash * BLOCKED_BF_SALTS[i]) >> 26 of word i
+alignas(32) static const uint32_t BLOCKED_BF_SALTS[ObBloomFilter::BLOCK_NWORD] = {
+  0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+  0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+// blocks of the keys checked later in a batch are prefetched
+static const int64_t BLOCKED_BF_PREFETCH_DISTANCE = 8;
+
+OB_DECLARE_DEFAULT_CODE(
+inline static bool blocked_bf_probe(const uint64_t *block, const uint32_t key_hash)
+{
+  bool is_contain = true;
+  for (int64_t i = 0; is_contain && i < ObBloomFilter::BLOCK_NWORD; ++i) {
+    const uint64_t mask = 1ULL << ((key_hash * BLOCKED_BF_SALTS[i]) >> 26);
+    is_contain = (block[i] & mask) == mask;
+  }
+  return is_contain;
+}
+)
+
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+inline static bool blocked_bf_probe(const uint64_t *block, const uint32_t key_hash)
+{
+  const __m256i salts = _mm256_load_si256(reinterpret_cast<const __m256i *>(BLOCKED_BF_SALTS));
+  const __m256i ones = _mm256_set1_epi64x(1);
+  __m256i bit_pos = _mm256_mullo_epi32(_mm256_set1_epi32(key_hash), salts);
+  bit_pos = _mm256_srli_epi32(bit_pos, 26);
+  const __m256i lo_mask = _mm256_sllv_epi64(ones, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(bit_pos)));
+  const __m256i hi_mask = _mm256_sllv_epi64(ones, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(bit_pos, 1)));
+  const __m256i lo_words = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+  const __m256i hi_words = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 4));
+  return _mm256_testc_si256(lo_words, lo_mask) && _mm256_testc_si256(hi_words, hi_mask);
+}
+)
+
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+inline static bool blocked_bf_probe(const uint64_t *block, const uint32_t key_hash)
+{
+  const __m256i salts = _mm256_load_si256(reinterpret_cast<const __m256i *>(BLOCKED_BF_SALTS));
+  __m256i bit_pos = _mm256_mullo_epi32(_mm256_set1_epi32(key_hash), salts);
+  bit_pos = _mm256_srli_epi32(bit_pos, 26);
+  const __m512i mask = _mm512_sllv_epi64(_mm512_set1_epi64(1), _mm512_cvtepu32_epi64(bit_pos));
+  const __m512i words = _mm512_loadu_si512(block);
+  return 0xFF == _mm512_mask_cmpeq_epi64_mask(0xFF, _mm512_and_si512(words, mask), mask);
+}
+)
+
+#define DEFINE_BLOCKED_BF_PROBE_BATCH(arch)                                                    \
+  OB_DECLARE_##arch(                                                                           \
+  inline static void blocked_bf_probe_batch(const uint64_t *words,                             \
+                                            const uint64_t nblock,                             \
+                                            const uint32_t *key_hashes,                        \
+                                            const int64_t count,                               \
+                                            uint64_t *contain_bitmap)                          \
+  {                                                                                            \
+    MEMSET(contain_bitmap, 0, sizeof(uint64_t) * ((count + 63) / 64));                         \
+    for (int64_t i = 0; i < MIN(count, BLOCKED_BF_PREFETCH_DISTANCE); ++i) {                   \
+      __builtin_prefetch(words + ((key_hashes[i] * nblock) >> 32) * ObBloomFilter::BLOCK_NWORD); \
+    }                                                                                          \
+    for (int64_t i = 0; i < count; ++i) {                                                      \
+      if (i + BLOCKED_BF_PREFETCH_DISTANCE < count) {                                          \
+        const uint64_t next_hash = key_hashes[i + BLOCKED_BF_PREFETCH_DISTANCE];               \
+        __builtin_prefetch(words + ((next_hash * nblock) >> 32) * ObBloomFilter::BLOCK_NWORD); \
+      }                                                                                        \
+      const uint64_t *block = words + ((key_hashes[i] * nblock) >> 32) * ObBloomFilter::BLOCK_NWORD; \
+      if (blocked_bf_probe(block, key_hashes[i])) {                                            \
+        contain_bitmap[i / 64] |= 1ULL << (i % 64);                                            \
+      }                                                                                        \
+    }                                                                                          \
+  }                                                                                            \
+  )
+
+DEFINE_BLOCKED_BF_PROBE_BATCH(DEFAULT_CODE)
+DEFINE_BLOCKED_BF_PROBE_BATCH(AVX2_SPECIFIC_CODE)
+DEFINE_BLOCKED_BF_PROBE_BATCH(AVX512_SPECIFIC_CODE)
+#undef DEFINE_BLOCKED_BF_PROBE_BATCH
+
+ObBloomFilter::ObBloomFilter()
+  : allocator_(ObModIds::OB_BLOOM_FILTER), nhash_(0), nbit_(0), bits_(NULL), is_blocked_(false)
 {
 }
 
@@ -48,6 +131,7 @@ int ObBloomFilter::deep_copy(const ObBloomFilter &other)
   } else {
     nbit_ = other.nbit_;
     nhash_ = other.nhash_;
+    is_blocked_ = other.is_blocked_;
     MEMCPY(bits_, other.bits_, calc_nbyte(nbit_));
   }
 
@@ -64,6 +148,7 @@ int ObBloomFilter::deep_copy(const ObBloomFilter &other, char *buffer)
   } else {
     nbit_ = other.nbit_;
     nhash_ = other.nhash_;
+    is_blocked_ = other.is_blocked_;
     bits_ = reinterpret_cast<uint8_t*>(buffer);
     MEMCPY(bits_, other.bits_, calc_nbyte(nbit_));
   }
@@ -82,7 +167,9 @@ int64_t ObBloomFilter::calc_nbyte(const int64_t nbit) const
   return (nbit / CHAR_BIT + (nbit % CHAR_BIT ? 1 : 0));
 }
 
-int ObBloomFilter::init(const int64_t element_count, const double false_positive_prob)
+int ObBloomFilter::init(const int64_t element_count,
+                        const double false_positive_prob,
+                        const bool is_blocked)
 {
   int ret = OB_SUCCESS;
   if (element_count <= 0) {
@@ -95,6 +182,10 @@ int ObBloomFilter::init(const int64_t element_count, const double false_positive
     double num_hashes = -std::log(false_positive_prob) / std::log(2);
     int64_t num_bits = static_cast<int64_t>((static_cast<double>(element_count)
                                              * num_hashes / static_cast<double>(std::log(2))));
+    if (is_blocked) {
+      num_hashes = BLOCKED_NHASH;
+      num_bits = (num_bits + BLOCK_NBIT - 1) / BLOCK_NBIT * BLOCK_NBIT;
+    }
     int64_t num_bytes = calc_nbyte(num_bits);
     bits_ = (uint8_t *)allocator_.alloc(static_cast<int32_t>(num_bytes));
     if (NULL == bits_) {
@@ -104,6 +195,7 @@ int ObBloomFilter::init(const int64_t element_count, const double false_positive
       memset(bits_, 0, num_bytes);
       nhash_ = static_cast<int64_t>(num_hashes);
       nbit_ = num_bits;
+      is_blocked_ = is_blocked;
     }
   }
   return ret;
@@ -117,6 +209,7 @@ void ObBloomFilter::destroy()
     nhash_ = 0;
     nbit_ = 0;
   }
+  is_blocked_ = false;
 }
 
 void ObBloomFilter::clear()
@@ -132,6 +225,11 @@ int ObBloomFilter::insert(const uint32_t key_hash)
   if (!is_valid()) {
     ret = OB_NOT_INIT;
     LIB_LOG(WARN, "bloom filter has not inited", K_(bits), K_(nbit), K_(nhash), K(ret));
+  } else if (is_blocked_) {
+    uint64_t *block = reinterpret_cast<uint64_t *>(bits_) + get_block_idx(key_hash) * BLOCK_NWORD;
+    for (int64_t i = 0; i < BLOCK_NWORD; ++i) {
+      block[i] |= 1ULL << ((key_hash * BLOCKED_BF_SALTS[i]) >> 26);
+    }
   } else {
     const uint64_t hash = key_hash;
     const uint64_t delta = ((hash >> 17) | (hash << 15)) % nbit_;
@@ -151,6 +249,9 @@ int ObBloomFilter::may_contain(const uint32_t key_hash, bool &is_contain) const
   if (!is_valid()) {
     ret = OB_NOT_INIT;
     LIB_LOG(WARN, "bloom filter has not inited, ", K_(bits), K_(nbit), K_(nhash), K(ret));
+  } else if (is_blocked_) {
+    const uint64_t *block = reinterpret_cast<const uint64_t *>(bits_) + get_block_idx(key_hash) * BLOCK_NWORD;
+    is_contain = specific::normal::blocked_bf_probe(block, key_hash);
   } else {
     const uint64_t hash = key_hash;
     const uint64_t delta = ((hash >> 17) | (hash << 15)) % nbit_;
@@ -166,6 +267,60 @@ int ObBloomFilter::may_contain(const uint32_t key_hash, bool &is_contain) const
   return ret;
 }
 
+int ObBloomFilter::may_contain(const uint32_t *key_hashes,
+                               const int64_t count,
+                               uint64_t *contain_bitmap) const
+{
+  int ret = OB_SUCCESS;
+  if (!is_valid()) {
+    ret = OB_NOT_INIT;
+    LIB_LOG(WARN, "bloom filter has not inited, ", K_(bits), K_(nbit), K_(nhash), K(ret));
+  } else if (OB_UNLIKELY(NULL == key_hashes || count <= 0 || NULL == contain_bitmap)) {
+    ret = OB_INVALID_ARGUMENT;
+    LIB_LOG(WARN, "Invalid argument", KP(key_hashes), K(count), KP(contain_bitmap), K(ret));
+  } else if (is_blocked_) {
+    const uint64_t *words = reinterpret_cast<const uint64_t *>(bits_);
+    const uint64_t nblock = nbit_ / BLOCK_NBIT;
+#if OB_USE_MULTITARGET_CODE
+    if (common::is_arch_supported(ObTargetArch::AVX512)) {
+      specific::avx512::blocked_bf_probe_batch(words, nblock, key_hashes, count, contain_bitmap);
+    } else if (common::is_arch_supported(ObTargetArch::AVX2)) {
+      specific::avx2::blocked_bf_probe_batch(words, nblock, key_hashes, count, contain_bitmap);
+    } else {
+      specific::normal::blocked_bf_probe_batch(words, nblock, key_hashes, count, contain_bitmap);
+    }
+#else
+    specific::normal::blocked_bf_probe_batch(words, nblock, key_hashes, count, contain_bitmap);
+#endif
+  } else {
+    MEMSET(contain_bitmap, 0, sizeof(uint64_t) * ((count + 63) / 64));
+    bool is_contain = true;
+    for (int64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+      if (OB_FAIL(may_contain(key_hashes[i], is_contain))) {
+        LIB_LOG(WARN, "Fail to check bloom filter", K(i), K(ret));
+      } else if (is_contain) {
+        contain_bitmap[i / 64] |= 1ULL << (i % 64);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObBloomFilter::set_blocked(const bool is_blocked)
+{
+  int ret = OB_SUCCESS;
+  if (!is_valid()) {
+    ret = OB_NOT_INIT;
+    LIB_LOG(WARN, "bloom filter has not inited, ", K_(bits), K_(nbit), K_(nhash), K(ret));
+  } else if (is_blocked && OB_UNLIKELY(0 != nbit_ % BLOCK_NBIT || BLOCKED_NHASH != nhash_)) {
+    ret = OB_INVALID_DATA;
+    LIB_LOG(WARN, "Unexpected blocked bloom filter", K_(nbit), K_(nhash), K(ret));
+  } else {
+    is_blocked_ = is_blocked;
+  }
+  return ret;
+}
+
 int ObBloomFilter::serialize(char *buf, const int64_t buf_len, int64_t &pos) const
 {
   int ret = OB_SUCCESS;
@@ -218,6 +373,7 @@ int ObBloomFilter::deserialize(const char *buf, const int64_t data_len, int64_t
       int64_t decode_byte = 0;
       nhash_ = decode_nhash;
       nbit_ = decode_nbit;
+      is_blocked_ = false;
       clear();
       if (OB_ISNULL(serialization::decode_vstr(buf, data_len, pos,
                                                reinterpret_cast<char*>(bits_), nbyte, &decode_byte))) {
@@ -393,9 +549,12 @@ int ObBloomFilterCacheValue::init(const int64_t rowkey_column_cnt, const int64_t
   } else if (OB_UNLIKELY(is_inited_)) {
     ret = OB_INIT_TWICE;
     STORAGE_LOG(WARN, "The bloom filter cache value has been inited, ", K(ret));
-  } else if (OB_FAIL(bloom_filter_.init(row_cnt))) {
+  } else if (OB_FAIL(bloom_filter_.init(row_cnt,
+                                        ObBloomFilter::BLOOM_FILTER_FALSE_POSITIVE_PROB,
+                                        true/*is_blocked*/))) {
     STORAGE_LOG(WARN, "Fail to init bloom filter, ", K(ret));
   } else {
+    version_ = BLOOM_FILTER_CACHE_VALUE_BLOCKED_VERSION;
     rowkey_column_cnt_ = static_cast<int16_t>(rowkey_column_cnt);
     row_count_ = 0;
     is_inited_ = true;
@@ -430,6 +589,20 @@ int ObBloomFilterCacheValue::may_contain(const uint32_t hash, bool &is_contain)
   return ret;
 }
 
+int ObBloomFilterCacheValue::may_contain(const uint32_t *hashes,
+                                         const int64_t count,
+                                         uint64_t *contain_bitmap) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The bloom filter cache value has not been inited, ", K(ret));
+  } else if (OB_FAIL(bloom_filter_.may_contain(hashes, count, contain_bitmap))) {
+    STORAGE_LOG(WARN, "The bloom filter judge failed, ", K(count), K(ret));
+  }
+  return ret;
+}
+
 bool ObBloomFilterCacheValue::is_valid() const
 {
   return is_inited_ && rowkey_column_cnt_ > 0;
@@ -519,8 +692,14 @@ DEFINE_DESERIALIZE(ObBloomFilterCacheValue)
       STORAGE_LOG(WARN, "Unexpected deserialize rowkey column cnt", K_(rowkey_column_cnt), K(ret));
     } else if (OB_FAIL(serialization::decode_vi32(buf, data_len, pos, &row_count_))) {
       STORAGE_LOG(WARN, "Failed to decode row cnt", K(data_len), K(pos), K(ret));
+    } else if (OB_UNLIKELY(BLOOM_FILTER_CACHE_VALUE_VERSION != version_
+                           && BLOOM_FILTER_CACHE_VALUE_BLOCKED_VERSION != version_)) {
+      ret = OB_NOT_SUPPORTED;
+      STORAGE_LOG(WARN, "Unexpected bloom filter cache value version", K_(version), K(ret));
     } else if (OB_FAIL(bloom_filter_.deserialize(buf, data_len, pos))) {
       STORAGE_LOG(WARN, "Failed to deserialize bloom_filter", K(data_len), K(pos), K(ret));
+    } else if (OB_FAIL(bloom_filter_.set_blocked(BLOOM_FILTER_CACHE_VALUE_BLOCKED_VERSION == version_))) {
+      STORAGE_LOG(WARN, "Failed to set bloom filter format", K_(version), K(ret));
     } else {
       is_inited_ = true;
     }
@@ -660,26 +839,41 @@ int ObBloomFilterCache::may_contain(
       ret = OB_ERR_UNEXPECTED;
       STORAGE_LOG(WARN, "Unexpected null bf value", K(ret));
     } else {
-      for (int64_t i = rowkey_begin_idx; OB_SUCC(ret) && i < rowkey_end_idx; ++i) {
-        bool tmp_contain = false;
-        const ObDatumRowkey &rowkey = rows_info->get_rowkey(i);
-        if (rows_info->is_row_skipped(i)) {
-          continue;
-        } else if (OB_FAIL(rowkey.murmurhash(0, datum_utils, key_hash))) {
-          STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(rowkey));
-        } else if (OB_FAIL(bf_value->may_contain(static_cast<uint32_t>(key_hash), tmp_contain))) {
-          STORAGE_LOG(WARN, "Fail to check rowkey exist from bloom filter, ", K(ret));
-        } else {
-          if (tmp_contain) {
-            is_contain = true;
-            EVENT_INC(ObStatEventIds::BLOOM_FILTER_PASSES);
+      uint32_t key_hashes[BF_BATCH_CHECK_SIZE];
+      int64_t row_idxs[BF_BATCH_CHECK_SIZE];
+      uint64_t contain_bitmap[BF_BATCH_CHECK_SIZE / 64];
+      int64_t i = rowkey_begin_idx;
+      while (OB_SUCC(ret) && i < rowkey_end_idx) {
+        int64_t batch_cnt = 0;
+        int64_t pass_cnt = 0;
+        for (; OB_SUCC(ret) && i < rowkey_end_idx && batch_cnt < BF_BATCH_CHECK_SIZE; ++i) {
+          const ObDatumRowkey &rowkey = rows_info->get_rowkey(i);
+          if (rows_info->is_row_skipped(i)) {
+          } else if (OB_FAIL(rowkey.murmurhash(0, datum_utils, key_hash))) {
+            STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(rowkey));
           } else {
-            if (!my_rows_info->is_row_bf_checked(i)) {
-              my_rows_info->set_row_non_existent(i);
+            key_hashes[batch_cnt] = static_cast<uint32_t>(key_hash);
+            row_idxs[batch_cnt++] = i;
+          }
+        }
+        if (OB_FAIL(ret) || 0 == batch_cnt) {
+        } else if (OB_FAIL(bf_value->may_contain(key_hashes, batch_cnt, contain_bitmap))) {
+          STORAGE_LOG(WARN, "Fail to check rowkeys exist from bloom filter, ", K(ret), K(batch_cnt));
+        } else {
+          for (int64_t j = 0; j < batch_cnt; ++j) {
+            const int64_t row_idx = row_idxs[j];
+            if (contain_bitmap[j / 64] & (1ULL << (j % 64))) {
+              ++pass_cnt;
+            } else if (!my_rows_info->is_row_bf_checked(row_idx)) {
+              my_rows_info->set_row_non_existent(row_idx);
             }
-            EVENT_INC(ObStatEventIds::BLOOM_FILTER_FILTS);
+            my_rows_info->set_row_bf_checked(row_idx);
+          }
+          if (pass_cnt > 0) {
+            is_contain = true;
           }
-          my_rows_info->set_row_bf_checked(i);
+          EVENT_ADD(ObStatEventIds::BLOOM_FILTER_PASSES, pass_cnt);
+          EVENT_ADD(ObStatEventIds::BLOOM_FILTER_FILTS, batch_cnt - pass_cnt);
         }
       }
     }
@@ -719,25 +913,40 @@ int ObBloomFilterCache::may_contain(
       ret = OB_ERR_UNEXPECTED;
       STORAGE_LOG(WARN, "Unexpected null bf value", K(ret));
     } else {
-      for (int64_t i = rowkey_begin_idx; OB_SUCC(ret) && i < rowkey_end_idx; ++i) {
-        bool tmp_contain = false;
-        const ObDatumRowkey &rowkey = rowkeys_info->get_rowkey(i);
-        if (rowkeys_info->is_rowkey_not_exist(i)) {
-          continue;
-        } else if (OB_FAIL(rowkey.murmurhash(0, datum_utils, key_hash))) {
-          STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(rowkey));
-        } else if (OB_FAIL(bf_value->may_contain(static_cast<uint32_t>(key_hash), tmp_contain))) {
-          STORAGE_LOG(WARN, "Fail to check rowkey exist from bloom filter, ", K(ret));
+      uint32_t key_hashes[BF_BATCH_CHECK_SIZE];
+      int64_t row_idxs[BF_BATCH_CHECK_SIZE];
+      uint64_t contain_bitmap[BF_BATCH_CHECK_SIZE / 64];
+      int64_t i = rowkey_begin_idx;
+      while (OB_SUCC(ret) && i < rowkey_end_idx) {
+        int64_t batch_cnt = 0;
+        int64_t pass_cnt = 0;
+        for (; OB_SUCC(ret) && i < rowkey_end_idx && batch_cnt < BF_BATCH_CHECK_SIZE; ++i) {
+          const ObDatumRowkey &rowkey = rowkeys_info->get_rowkey(i);
+          if (rowkeys_info->is_rowkey_not_exist(i)) {
+          } else if (OB_FAIL(rowkey.murmurhash(0, datum_utils, key_hash))) {
+            STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(rowkey));
+          } else {
+            key_hashes[batch_cnt] = static_cast<uint32_t>(key_hash);
+            row_idxs[batch_cnt++] = i;
+          }
+        }
+        if (OB_FAIL(ret) || 0 == batch_cnt) {
+        } else if (OB_FAIL(bf_value->may_contain(key_hashes, batch_cnt, contain_bitmap))) {
+          STORAGE_LOG(WARN, "Fail to check rowkeys exist from bloom filter, ", K(ret), K(batch_cnt));
         } else {
-          if (tmp_contain) {
-            EVENT_INC(ObStatEventIds::BLOOM_FILTER_PASSES);
-            if (i == rowkey_begin_idx) {
-              is_contain = true;
+          for (int64_t j = 0; j < batch_cnt; ++j) {
+            const int64_t row_idx = row_idxs[j];
+            if (contain_bitmap[j / 64] & (1ULL << (j % 64))) {
+              ++pass_cnt;
+              if (row_idx == rowkey_begin_idx) {
+                is_contain = true;
+              }
+            } else {
+              my_rowkeys_info->set_rowkey_not_exist(row_idx);
             }
-          } else {
-            my_rowkeys_info->set_rowkey_not_exist(i);
-            EVENT_INC(ObStatEventIds::BLOOM_FILTER_FILTS);
           }
+          EVENT_ADD(ObStatEventIds::BLOOM_FILTER_PASSES, pass_cnt);
+          EVENT_ADD(ObStatEventIds::BLOOM_FILTER_FILTS, batch_cnt - pass_cnt);
         }
       }
     }
@@ -501,7 +501,7 @@ int ObColDataStoreDesc::generate_skip_index_meta(
     }
   } else if (cg_schema->is_single_column_group()) {
     // build min_max and sum aggregate for single column group by default;
-    if (OB_FAIL(generate_single_cg_skip_index_meta(*cg_schema))) {
+    if (OB_FAIL(generate_single_cg_skip_index_meta(skip_idx_attrs, *cg_schema))) {
       STORAGE_LOG(WARN, "failed to generate skip index meta for single column group", K(ret), KPC(cg_schema));
     }
   } else {
@@ -519,7 +519,9 @@ int ObColDataStoreDesc::generate_skip_index_meta(
   return ret;
 }
 
-int ObColDataStoreDesc::generate_single_cg_skip_index_meta(const storage::ObStorageColumnGroupSchema &cg_schema)
+int ObColDataStoreDesc::generate_single_cg_skip_index_meta(
+    const ObIArray<ObSkipIndexColumnAttr> &skip_idx_attrs,
+    const storage::ObStorageColumnGroupSchema &cg_schema)
 {
   int ret = OB_SUCCESS;
 
@@ -534,6 +536,9 @@ int ObColDataStoreDesc::generate_single_cg_skip_index_meta(const storage::ObStor
     ObSkipIndexColumnAttr single_cg_skip_idx_attr;
     single_cg_skip_idx_attr.set_min_max();
     single_cg_skip_idx_attr.set_sum();
+    if (skip_idx_attrs.at(column_idx).has_bloom_filter()) {
+      single_cg_skip_idx_attr.set_bloom_filter();
+    }
     if (OB_FAIL(blocksstable::ObSkipIndexColMeta::append_skip_index_meta(
         single_cg_skip_idx_attr, 0, agg_meta_array_))) {
       STORAGE_LOG(WARN, "failed to append skip index meta array", K(ret), K(column_idx), K(cg_schema));
@@ -30,6 +30,7 @@ namespace share
 namespace schema
 {
 class ObMergeSchema;
+struct ObSkipIndexColumnAttr;
 }
 }
 
@@ -145,7 +146,9 @@ private:
       const share::schema::ObMergeSchema &merge_schema);
   int init_col_default_checksum_array(
       const int64_t column_cnt);
-  int generate_single_cg_skip_index_meta(const storage::ObStorageColumnGroupSchema &cg_schema);
+  int generate_single_cg_skip_index_meta(
+      const ObIArray<share::schema::ObSkipIndexColumnAttr> &skip_idx_attrs,
+      const storage::ObStorageColumnGroupSchema &cg_schema);
   int add_col_desc_from_cg_schema(
     const share::schema::ObMergeSchema &merge_schema,
     const storage::ObStorageColumnGroupSchema &cg_schema);
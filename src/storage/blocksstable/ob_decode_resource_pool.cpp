@@ -54,6 +54,8 @@ void ObDecodeResourcePool::destroy()
     cs_string_pool_.destroy();
     cs_int_dict_pool_.destroy();
     cs_str_dict_pool_.destroy();
+    cs_fsst_string_pool_.destroy();
+    cs_alp_float_pool_.destroy();
     cs_ctx_block_pool_.destroy();
     is_inited_ = false;
   }
@@ -79,6 +81,8 @@ int ObDecodeResourcePool::init() {
         || OB_FAIL(cs_string_pool_.init(MAX_CS_DECODER_CNT, "CsStrPl", tenant_id))
         || OB_FAIL(cs_int_dict_pool_.init(MAX_CS_DECODER_CNT, "CsDictPl", tenant_id))
         || OB_FAIL(cs_str_dict_pool_.init(MAX_CS_DECODER_CNT, "CsDictPl", tenant_id))
+        || OB_FAIL(cs_fsst_string_pool_.init(MAX_CS_DECODER_CNT, "CsFsstPl", tenant_id))
+        || OB_FAIL(cs_alp_float_pool_.init(MAX_CS_DECODER_CNT, "CsAlpPl", tenant_id))
         || OB_FAIL(cs_ctx_block_pool_.init(MAX_CS_CTX_BLOCK_CNT, "CsCtxBlockPl", tenant_id))
         )) {
       STORAGE_LOG(WARN, "failed to init decode resource pool", K(ret));
@@ -180,6 +184,18 @@ ObSmallObjPool<ObStrDictColumnDecoder>& ObDecodeResourcePool::get_pool()
   return cs_str_dict_pool_;
 }
 
+template<>
+ObSmallObjPool<ObFSSTStringColumnDecoder>& ObDecodeResourcePool::get_pool()
+{
+  return cs_fsst_string_pool_;
+}
+
+template<>
+ObSmallObjPool<ObALPFloatColumnDecoder>& ObDecodeResourcePool::get_pool()
+{
+  return cs_alp_float_pool_;
+}
+
 template<>
 ObSmallObjPool<ObColumnCSDecoderCtxBlock>& ObDecodeResourcePool::get_pool()
 {
@@ -232,7 +248,10 @@ ObCSDecoderPool::ObCSDecoderPool()
     cs_string_pool_(),
     cs_int_dict_pool_(),
     cs_str_dict_pool_(),
-    pools_{cs_integer_pool_, cs_string_pool_, cs_int_dict_pool_, cs_str_dict_pool_}
+    cs_fsst_string_pool_(),
+    cs_alp_float_pool_(),
+    pools_{cs_integer_pool_, cs_string_pool_, cs_int_dict_pool_, cs_str_dict_pool_,
+        cs_fsst_string_pool_, cs_alp_float_pool_}
 {
   memset(free_cnts_, 0, sizeof(free_cnts_));
 }
@@ -248,6 +267,8 @@ void ObCSDecoderPool::reset()
     (void)free_decoders<ObStringColumnDecoder>(*decode_res_pool, ObCSColumnHeader::STRING);
     (void)free_decoders<ObIntDictColumnDecoder>(*decode_res_pool, ObCSColumnHeader::INT_DICT);
     (void)free_decoders<ObStrDictColumnDecoder>(*decode_res_pool, ObCSColumnHeader::STR_DICT);
+    (void)free_decoders<ObFSSTStringColumnDecoder>(*decode_res_pool, ObCSColumnHeader::FSST_STRING);
+    (void)free_decoders<ObALPFloatColumnDecoder>(*decode_res_pool, ObCSColumnHeader::ALP_FLOAT);
   }
 }
 
@@ -47,6 +47,7 @@ class ObIMvccCtx;
 namespace blocksstable
 {
 struct ObMicroIndexInfo;
+class ObICSSharedDictProvider;
 
 #define FREE_PTR_FROM_CONTEXT(ctx, ptr, T)                                  \
   do {                                                                      \
@@ -111,7 +112,7 @@ public:
   ObMicroBlockData()
     : buf_(NULL), size_(0),
       extra_buf_(0), extra_size_(0),
-      type_(DATA_BLOCK) {}
+      type_(DATA_BLOCK), shared_dict_(nullptr), compress_dict_() {}
 
   ObMicroBlockData(const char *buf,
                    const int64_t size,
@@ -120,7 +121,7 @@ public:
                    const Type block_type = DATA_BLOCK)
       : buf_(buf), size_(size),
         extra_buf_(extra_buf), extra_size_(extra_size),
-        type_(block_type) {}
+        type_(block_type), shared_dict_(nullptr), compress_dict_() {}
   bool is_valid() const { return NULL != buf_ && size_ > 0 && type_ < MAX_TYPE; }
   const char *&get_buf() { return buf_; }
   const char *get_buf() const { return buf_; }
@@ -155,13 +156,18 @@ public:
       : MAX_ROW_STORE;
   }
 
-  TO_STRING_KV(KP_(buf), K_(size), KP_(extra_buf), K_(extra_size), K_(type));
+  TO_STRING_KV(KP_(buf), K_(size), KP_(extra_buf), K_(extra_size), K_(type), KP_(shared_dict),
+      "compress_dict_size", compress_dict_.length());
 
   const char *buf_;
   int64_t size_;
   const char *extra_buf_;
   int64_t extra_size_;
   Type type_;
+  // shared dict of the macro block, only for cs encoding micro block with shared dict
+  const ObICSSharedDictProvider *shared_dict_;
+  // compress dict of the macro block, only for compressed micro block with compress dict
+  common::ObString compress_dict_;
 
   static const uint64_t ALIGN_SIZE = 8;
   static const int64_t ALIGN_REDUNDANCY_SIZE = ALIGN_SIZE - 1;
@@ -397,6 +403,7 @@ public:
       const common::ObDatum &datum,
       bool &filtered);
   virtual bool has_lob_out_row() const = 0;
+  virtual bool has_shared_dict() const { return false; }
 
 protected:
   virtual int find_bound(const ObDatumRange &range,
@@ -28,6 +28,8 @@
 #include "ob_macro_block_struct.h"
 #include "ob_macro_block_handle.h"
 #include "storage/blocksstable/ob_data_store_desc.h"
+#include "storage/blocksstable/cs_encoding/ob_cs_shared_dict.h"
+#include "storage/blocksstable/ob_micro_block_compress_dict.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::share;
@@ -87,9 +89,17 @@ int ObMicroBlockCompressor::init(const int64_t micro_block_size, const ObCompres
 
 int ObMicroBlockCompressor::compress(const char *in, const int64_t in_size, const char *&out,
                                      int64_t &out_size)
+{
+  bool with_dict = false;
+  return compress(in, in_size, ObString(), out, out_size, with_dict);
+}
+
+int ObMicroBlockCompressor::compress(const char *in, const int64_t in_size, const ObString &dict,
+                                     const char *&out, int64_t &out_size, bool &with_dict)
 {
   int ret = OB_SUCCESS;
   int64_t max_overflow_size = 0;
+  with_dict = false;
   if (is_none_) {
     out = in;
     out_size = in_size;
@@ -105,9 +115,14 @@ int ObMicroBlockCompressor::compress(const char *in, const int64_t in_size, cons
     if (OB_FAIL(comp_buf_.ensure_space(need_size))) {
       STORAGE_LOG(WARN, "macro block writer fail to allocate memory for comp_buf_.", K(ret),
                   K(need_size));
-    } else if (OB_FAIL(compressor_->compress(in, in_size, comp_buf_.data(), max_comp_size, comp_size))) {
+    } else if (dict.empty()
+        && OB_FAIL(compressor_->compress(in, in_size, comp_buf_.data(), max_comp_size, comp_size))) {
       STORAGE_LOG(WARN, "compressor fail to compress.", K(in), K(in_size),
                   "comp_ptr", comp_buf_.data(), K(max_comp_size), K(comp_size));
+    } else if (!dict.empty() && OB_FAIL(compressor_->compress_with_dict(in, in_size,
+        dict.ptr(), dict.length(), comp_buf_.data(), max_comp_size, comp_size))) {
+      STORAGE_LOG(WARN, "compressor fail to compress with dict.", K(in), K(in_size), "dict_size", dict.length(),
+                  "comp_ptr", comp_buf_.data(), K(max_comp_size), K(comp_size));
     } else if (comp_size >= in_size) {
       STORAGE_LOG(TRACE, "compressed_size is larger than origin_size",
                   K(comp_size), K(in_size));
@@ -116,6 +131,7 @@ int ObMicroBlockCompressor::compress(const char *in, const int64_t in_size, cons
     } else {
       out = comp_buf_.data();
       out_size = comp_size;
+      with_dict = !dict.empty();
       comp_buf_.reuse();
     }
   }
@@ -125,6 +141,13 @@ int ObMicroBlockCompressor::compress(const char *in, const int64_t in_size, cons
 int ObMicroBlockCompressor::decompress(const char *in, const int64_t in_size,
                                        const int64_t uncomp_size,
                                        const char *&out, int64_t &out_size)
+{
+  return decompress(in, in_size, uncomp_size, ObString(), out, out_size);
+}
+
+int ObMicroBlockCompressor::decompress(const char *in, const int64_t in_size,
+                                       const int64_t uncomp_size, const ObString &dict,
+                                       const char *&out, int64_t &out_size)
 {
   int ret = OB_SUCCESS;
   int64_t decomp_size = 0;
@@ -134,9 +157,12 @@ int ObMicroBlockCompressor::decompress(const char *in, const int64_t in_size,
     out_size = in_size;
   } else if (OB_FAIL(decomp_buf_.ensure_space(uncomp_size))) {
     STORAGE_LOG(WARN, "failed to ensure decomp space", K(ret), K(uncomp_size));
-  } else if (OB_FAIL(compressor_->decompress(in, in_size, decomp_buf_.data(), uncomp_size,
-                                             decomp_size))) {
+  } else if (dict.empty() && OB_FAIL(compressor_->decompress(in, in_size, decomp_buf_.data(), uncomp_size,
+                                                            decomp_size))) {
     STORAGE_LOG(WARN, "failed to decompress data", K(ret), K(in_size), K(uncomp_size));
+  } else if (!dict.empty() && OB_FAIL(compressor_->decompress_with_dict(in, in_size, dict.ptr(), dict.length(),
+                                                                       decomp_buf_.data(), uncomp_size, decomp_size))) {
+    STORAGE_LOG(WARN, "failed to decompress data with dict", K(ret), K(in_size), K(uncomp_size), "dict_size", dict.length());
   } else {
     out = decomp_buf_.data();
     out_size = decomp_size;
@@ -162,6 +188,11 @@ ObMacroBlock::ObMacroBlock()
     data_size_(0),
     data_zsize_(0),
     cur_macro_seq_(-1),
+    shared_dict_builder_(nullptr),
+    is_shared_dict_written_(false),
+    compress_dict_builder_(nullptr),
+    has_compress_dict_micro_(false),
+    is_compress_dict_written_(false),
     is_inited_(false)
 {
 }
@@ -171,14 +202,21 @@ ObMacroBlock::~ObMacroBlock()
 }
 
 
-int ObMacroBlock::init(const ObDataStoreDesc &spec, const int64_t &cur_macro_seq)
+int ObMacroBlock::init(
+    const ObDataStoreDesc &spec,
+    const int64_t &cur_macro_seq,
+    const ObCSSharedDictBuilder *shared_dict_builder,
+    const ObMicroBlockCompressDictBuilder *compress_dict_builder)
 {
   int ret = OB_SUCCESS;
   reuse();
   spec_ = &spec;
   cur_macro_seq_ = cur_macro_seq;
+  shared_dict_builder_ = shared_dict_builder;
+  compress_dict_builder_ = compress_dict_builder;
   data_base_offset_ = calc_basic_micro_block_data_offset(
-    spec.get_row_column_count(), spec.get_rowkey_column_count(), spec.get_fixed_header_version());
+    spec.get_row_column_count(), spec.get_rowkey_column_count(), spec.get_fixed_header_version(),
+    nullptr != shared_dict_builder_, nullptr != compress_dict_builder_);
   is_inited_ = true;
   return ret;
 }
@@ -222,18 +260,28 @@ int64_t ObMacroBlock::get_remain_size() const {
   } else {
     remain_size = data_.remain();
   }
+  if (nullptr != shared_dict_builder_ && !is_shared_dict_written_) {
+    // reserve space for the shared dict with values of the micro block being written
+    remain_size -= shared_dict_builder_->get_reserve_size();
+  }
+  if (nullptr != compress_dict_builder_ && !is_compress_dict_written_) {
+    remain_size -= compress_dict_builder_->get_reserve_size();
+  }
   return remain_size;
 }
 
 int64_t ObMacroBlock::calc_basic_micro_block_data_offset(
   const int64_t column_cnt,
   const int64_t rowkey_col_cnt,
-  const uint16_t fixed_header_version)
+  const uint16_t fixed_header_version,
+  const bool with_shared_dict,
+  const bool with_compress_dict)
 {
   return sizeof(ObMacroBlockCommonHeader)
         + ObSSTableMacroBlockHeader::get_fixed_header_size()
         + sizeof(bool) /* is_normal_cg */
-        + ObSSTableMacroBlockHeader::get_variable_size_in_header(column_cnt, rowkey_col_cnt, fixed_header_version);
+        + ObSSTableMacroBlockHeader::get_variable_size_in_header(column_cnt, rowkey_col_cnt, fixed_header_version)
+        + ObSSTableMacroBlockHeader::get_dict_pos_size(with_shared_dict, with_compress_dict);
 }
 
 int ObMacroBlock::check_micro_block(const ObMicroBlockDesc &micro_block_desc) const
@@ -296,6 +344,9 @@ int ObMacroBlock::write_micro_block(const ObMicroBlockDesc &micro_block_desc, in
       if (micro_block_desc.contain_uncommitted_row_) {
         set_contain_uncommitted_row();
       }
+      if (header->has_compress_dict()) {
+        has_compress_dict_micro_ = true;
+      }
       if (header->has_column_checksum_) {
         if (OB_FAIL(add_column_checksum(header->column_checksums_,
                                         header->column_count_,
@@ -343,6 +394,71 @@ int ObMacroBlock::write_index_micro_block(
   return ret;
 }
 
+int ObMacroBlock::write_shared_dict()
+{
+  int ret = OB_SUCCESS;
+  const int64_t dict_size = nullptr == shared_dict_builder_ ? 0 : shared_dict_builder_->get_serialize_size();
+  int64_t pos = 0;
+  if (OB_UNLIKELY(!is_dirty_ || is_shared_dict_written_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected macro block state to write shared dict", K(ret), K_(is_dirty),
+        K_(is_shared_dict_written));
+  } else if (0 == dict_size) {
+    // no column uses the shared dict
+  } else if (OB_UNLIKELY(dict_size > data_.remain())) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "space of shared dict is not reserved", K(ret), K(dict_size), "remain", data_.remain());
+  } else if (OB_FAIL(shared_dict_builder_->serialize(data_.current(), dict_size, pos))) {
+    STORAGE_LOG(WARN, "fail to serialize shared dict", K(ret), K(dict_size), KPC_(shared_dict_builder));
+  } else {
+    macro_header_.shared_dict_offset_ = static_cast<int32_t>(data_.length());
+    macro_header_.shared_dict_size_ = static_cast<int32_t>(dict_size);
+    macro_header_.fixed_header_.occupy_size_ = static_cast<int32_t>(data_.length() + dict_size);
+    if (OB_FAIL(data_.advance(dict_size))) {
+      STORAGE_LOG(WARN, "data advance failed", K(ret), K(dict_size));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    is_shared_dict_written_ = true;
+  }
+  return ret;
+}
+
+int ObMacroBlock::write_compress_dict()
+{
+  int ret = OB_SUCCESS;
+  int64_t dict_size = 0;
+  if (OB_UNLIKELY(!is_dirty_ || is_compress_dict_written_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected macro block state to write compress dict", K(ret), K_(is_dirty),
+        K_(is_compress_dict_written));
+  } else if (!has_compress_dict_micro_) {
+    // no micro block is compressed with the dict
+  } else if (OB_ISNULL(compress_dict_builder_) || OB_UNLIKELY(!compress_dict_builder_->is_ready())) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "compress dict is not ready", K(ret), KPC_(compress_dict_builder));
+  } else {
+    const ObString dict = compress_dict_builder_->get_dict();
+    dict_size = dict.length();
+    if (OB_UNLIKELY(dict_size > data_.remain())) {
+      ret = OB_ERR_UNEXPECTED;
+      STORAGE_LOG(WARN, "space of compress dict is not reserved", K(ret), K(dict_size), "remain", data_.remain());
+    } else {
+      MEMCPY(data_.current(), dict.ptr(), dict_size);
+      macro_header_.compress_dict_offset_ = static_cast<int32_t>(data_.length());
+      macro_header_.compress_dict_size_ = static_cast<int32_t>(dict_size);
+      macro_header_.fixed_header_.occupy_size_ = static_cast<int32_t>(data_.length() + dict_size);
+      if (OB_FAIL(data_.advance(dict_size))) {
+        STORAGE_LOG(WARN, "data advance failed", K(ret), K(dict_size));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    is_compress_dict_written_ = true;
+  }
+  return ret;
+}
+
 int ObMacroBlock::flush(ObMacroBlockHandle &macro_handle,
                         ObMacroBlocksWriteCtx &block_write_ctx)
 {
@@ -413,6 +529,11 @@ void ObMacroBlock::reset()
   data_zsize_ = 0;
   last_rowkey_.reset();
   rowkey_allocator_.reset();
+  shared_dict_builder_ = nullptr;
+  is_shared_dict_written_ = false;
+  compress_dict_builder_ = nullptr;
+  has_compress_dict_micro_ = false;
+  is_compress_dict_written_ = false;
   is_inited_ = false;
 }
 
@@ -429,6 +550,11 @@ void ObMacroBlock::reuse()
   data_zsize_ = 0;
   last_rowkey_.reset();
   rowkey_allocator_.reuse();
+  shared_dict_builder_ = nullptr;
+  is_shared_dict_written_ = false;
+  compress_dict_builder_ = nullptr;
+  has_compress_dict_micro_ = false;
+  is_compress_dict_written_ = false;
   is_inited_ = false;
 }
 int ObMacroBlock::reserve_header(const ObDataStoreDesc &spec, const int64_t &cur_macro_seq)
@@ -450,7 +576,9 @@ int ObMacroBlock::reserve_header(const ObDataStoreDesc &spec, const int64_t &cur
     if (OB_FAIL(macro_header_.init(spec,
                                    reinterpret_cast<ObObjMeta *>(col_types_buf),
                                    reinterpret_cast<ObOrderType *>(col_orders_buf),
-                                   reinterpret_cast<int64_t *>(col_checksum_buf)))){
+                                   reinterpret_cast<int64_t *>(col_checksum_buf),
+                                   nullptr != shared_dict_builder_,
+                                   nullptr != compress_dict_builder_))){
       STORAGE_LOG(WARN, "fail to init macro block header", K(ret), K(spec));
     } else {
       macro_header_.fixed_header_.data_seq_ = cur_macro_seq;
@@ -35,6 +35,8 @@ struct ObMicroBlockDesc;
 struct ObMacroBlocksWriteCtx;
 class ObMacroBlockHandle;
 struct ObDataStoreDesc;
+class ObCSSharedDictBuilder;
+class ObMicroBlockCompressDictBuilder;
 
 class ObMicroBlockCompressor
 {
@@ -46,6 +48,12 @@ public:
   int compress(const char *in, const int64_t in_size, const char *&out, int64_t &out_size);
   int decompress(const char *in, const int64_t in_size, const int64_t uncomp_size,
       const char *&out, int64_t &out_size);
+  // compress with %dict if it is not empty, %with_dict is false if the data is not compressed
+  int compress(const char *in, const int64_t in_size, const common::ObString &dict,
+      const char *&out, int64_t &out_size, bool &with_dict);
+  int decompress(const char *in, const int64_t in_size, const int64_t uncomp_size,
+      const common::ObString &dict, const char *&out, int64_t &out_size);
+  OB_INLINE bool support_dict() const { return nullptr != compressor_ && compressor_->support_dict(); }
 private:
   bool is_none_;
   int64_t micro_block_size_;
@@ -60,12 +68,22 @@ class ObMacroBlock
 public:
   ObMacroBlock();
   virtual ~ObMacroBlock();
-  int init(const ObDataStoreDesc &spec, const int64_t &cur_macro_seq);
+  int init(
+      const ObDataStoreDesc &spec,
+      const int64_t &cur_macro_seq,
+      const ObCSSharedDictBuilder *shared_dict_builder = nullptr,
+      const ObMicroBlockCompressDictBuilder *compress_dict_builder = nullptr);
   int write_micro_block(const ObMicroBlockDesc &micro_block_desc, int64_t &data_offset);
   int write_index_micro_block(
       const ObMicroBlockDesc &micro_block_desc,
       const bool is_leaf_index_block,
       int64_t &data_offset);
+  // write the committed shared dict behind the data micro blocks, must be called before
+  // the index micro blocks are written
+  int write_shared_dict();
+  // write the compress dict behind the data micro blocks if any of them is compressed with it,
+  // must be called before the index micro blocks are written
+  int write_compress_dict();
   int get_macro_block_meta(ObDataMacroBlockMeta &macro_meta);
   int flush(ObMacroBlockHandle &macro_handle, ObMacroBlocksWriteCtx &block_write_ctx);
   void reset();
@@ -94,7 +112,9 @@ public:
   static int64_t calc_basic_micro_block_data_offset(
     const int64_t column_cnt,
     const int64_t rowkey_col_cnt,
-    const uint16_t fixed_header_version);
+    const uint16_t fixed_header_version,
+    const bool with_shared_dict = false,
+    const bool with_compress_dict = false);
 private:
   int inner_init();
   int reserve_header(const ObDataStoreDesc &spec, const int64_t &cur_macro_seq);
@@ -122,6 +142,11 @@ private:
   int64_t data_size_;
   int64_t data_zsize_;
   int64_t cur_macro_seq_;
+  const ObCSSharedDictBuilder *shared_dict_builder_;
+  bool is_shared_dict_written_;
+  const ObMicroBlockCompressDictBuilder *compress_dict_builder_;
+  bool has_compress_dict_micro_;
+  bool is_compress_dict_written_;
   bool is_inited_;
 };
 
@@ -28,7 +28,7 @@ ObMicroBlockBareIterator::ObMicroBlockBareIterator(const uint64_t tenant_id)
   : allocator_(), macro_block_buf_(nullptr), macro_block_buf_size_(0),
     macro_reader_(tenant_id), index_reader_(tenant_id), common_header_(),
     macro_block_header_(), reader_(nullptr), micro_reader_helper_(),
-    index_rowkey_cnt_(0),
+    shared_dict_reader_(), index_rowkey_cnt_(0),
     begin_idx_(0), end_idx_(0), iter_idx_(0), read_pos_(0),
     need_deserialize_(false), is_inited_(false)
 {
@@ -47,6 +47,8 @@ void ObMicroBlockBareIterator::reset()
   common_header_.reset();
   macro_block_header_.reset();
   micro_reader_helper_.reset();
+  shared_dict_reader_.reset();
+  macro_reader_.reset_compress_dict();
   reader_ = nullptr;
   begin_idx_ = 0;
   end_idx_ = 0;
@@ -63,6 +65,8 @@ void ObMicroBlockBareIterator::reuse()
   macro_block_buf_size_ = 0;
   common_header_.reset();
   macro_block_header_.reset();
+  shared_dict_reader_.reset();
+  macro_reader_.reset_compress_dict();
   begin_idx_ = 0;
   end_idx_ = 0;
   iter_idx_ = 0;
@@ -99,9 +103,13 @@ int ObMicroBlockBareIterator::open(
         K(macro_block_buf_size), K(read_pos_));
   } else if (FALSE_IT(index_rowkey_cnt_ = macro_block_header_.fixed_header_.rowkey_column_count_ == 0 ?
       1 : macro_block_header_.fixed_header_.rowkey_column_count_)) { // for cg
+  } else if (FALSE_IT(macro_block_buf_ = macro_block_buf)) {
+  } else if (FALSE_IT(macro_block_buf_size_ = macro_block_buf_size)) {
+  } else if (OB_FAIL(init_shared_dict())) {
+    LOG_WARN("fail to init shared dict", K(ret), K_(macro_block_header));
+  } else if (OB_FAIL(init_compress_dict())) {
+    LOG_WARN("fail to init compress dict", K(ret), K_(macro_block_header));
   } else {
-    macro_block_buf_ = macro_block_buf;
-    macro_block_buf_size_ = macro_block_buf_size;
     iter_idx_ = 0;
     begin_idx_ = 0;
     end_idx_ = macro_block_header_.fixed_header_.micro_block_count_ - 1;
@@ -141,9 +149,13 @@ int ObMicroBlockBareIterator::open(
         K(macro_block_buf_size), K(read_pos_));
   } else if (FALSE_IT(index_rowkey_cnt_ = macro_block_header_.fixed_header_.rowkey_column_count_ == 0 ?
       1 : macro_block_header_.fixed_header_.rowkey_column_count_)) { // for cg
+  } else if (FALSE_IT(macro_block_buf_ = macro_block_buf)) {
+  } else if (FALSE_IT(macro_block_buf_size_ = macro_block_buf_size)) {
+  } else if (OB_FAIL(init_shared_dict())) {
+    LOG_WARN("fail to init shared dict", K(ret), K_(macro_block_header));
+  } else if (OB_FAIL(init_compress_dict())) {
+    LOG_WARN("fail to init compress dict", K(ret), K_(macro_block_header));
   } else {
-    macro_block_buf_ = macro_block_buf;
-    macro_block_buf_size_ = macro_block_buf_size;
     need_deserialize_ = need_deserialize;
   }
 
@@ -197,6 +209,7 @@ int ObMicroBlockBareIterator::get_next_micro_block_data(ObMicroBlockData &micro_
     } else if (!need_deserialize_) {
       micro_block.get_buf() = micro_buf;
       micro_block.get_buf_size() = micro_buf_size;
+      micro_block.compress_dict_ = macro_reader_.get_compress_dict();
     } else if (OB_FAIL(macro_reader_.decrypt_and_decompress_data(
         macro_block_header_,
         micro_buf,
@@ -205,6 +218,8 @@ int ObMicroBlockBareIterator::get_next_micro_block_data(ObMicroBlockData &micro_
         micro_block.get_buf_size(),
         is_compressed))) {
       LOG_WARN("Fail to decrypt and decompress micro block data", K(ret), K(macro_block_header_));
+    } else if (shared_dict_reader_.is_inited()) {
+      micro_block.shared_dict_ = &shared_dict_reader_;
     }
 
     if (OB_SUCC(ret)) {
@@ -348,6 +363,38 @@ int ObMicroBlockBareIterator::get_index_block(ObMicroBlockData &micro_block, con
   return ret;
 }
 
+int ObMicroBlockBareIterator::init_shared_dict()
+{
+  int ret = OB_SUCCESS;
+  const int64_t dict_offset = macro_block_header_.shared_dict_offset_;
+  const int64_t dict_size = macro_block_header_.shared_dict_size_;
+  shared_dict_reader_.reset();
+  if (!macro_block_header_.has_shared_dict()) {
+  } else if (OB_UNLIKELY(dict_offset <= 0 || dict_offset + dict_size > macro_block_buf_size_)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid shared dict position", K(ret), K(dict_offset), K(dict_size), K_(macro_block_buf_size));
+  } else if (OB_FAIL(shared_dict_reader_.init(macro_block_buf_ + dict_offset, dict_size))) {
+    LOG_WARN("fail to init shared dict reader", K(ret), K(dict_offset), K(dict_size));
+  }
+  return ret;
+}
+
+int ObMicroBlockBareIterator::init_compress_dict()
+{
+  int ret = OB_SUCCESS;
+  const int64_t dict_offset = macro_block_header_.compress_dict_offset_;
+  const int64_t dict_size = macro_block_header_.compress_dict_size_;
+  macro_reader_.reset_compress_dict();
+  if (!macro_block_header_.has_compress_dict()) {
+  } else if (OB_UNLIKELY(dict_offset <= 0 || dict_offset + dict_size > macro_block_buf_size_)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid compress dict position", K(ret), K(dict_offset), K(dict_size), K_(macro_block_buf_size));
+  } else {
+    macro_reader_.set_compress_dict(ObString(static_cast<int32_t>(dict_size), macro_block_buf_ + dict_offset));
+  }
+  return ret;
+}
+
 int ObMicroBlockBareIterator::set_end_iter_idx(const bool is_reverse)
 {
   int ret = OB_SUCCESS;
@@ -15,6 +15,7 @@
 
 #include "ob_macro_block_reader.h"
 #include "ob_micro_block_reader_helper.h"
+#include "cs_encoding/ob_cs_shared_dict.h"
 
 
 namespace oceanbase
@@ -71,6 +72,8 @@ private:
       const bool is_left_border,
       const bool is_right_border);
   int set_reader(const ObRowStoreType store_type);
+  int init_shared_dict();
+  int init_compress_dict();
 private:
   ObArenaAllocator allocator_;
   const char *macro_block_buf_;
@@ -81,6 +84,7 @@ private:
   ObSSTableMacroBlockHeader macro_block_header_;
   ObIMicroBlockReader *reader_;
   ObMicroBlockReaderHelper micro_reader_helper_;
+  ObCSSharedDictReader shared_dict_reader_;
   int64_t index_rowkey_cnt_;
   int64_t begin_idx_;
   int64_t end_idx_;
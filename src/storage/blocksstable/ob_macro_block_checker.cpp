@@ -109,6 +109,7 @@ int ObSSTableMacroBlockChecker::check_logical_checksum(
       if (OB_FAIL(ObMicroBlockHeader::deserialize_and_check_record(raw_micro_data.get_buf(),
           raw_micro_data.get_buf_size(), MICRO_BLOCK_HEADER_MAGIC))) {
         STORAGE_LOG(ERROR, "micro block data is corrupted", K(ret), K(raw_micro_data));
+      } else if (FALSE_IT(reader.set_compress_dict(raw_micro_data.compress_dict_))) {
       } else if (OB_FAIL(reader.decrypt_and_decompress_data(sstable_header,
           raw_micro_data.get_buf(), raw_micro_data.get_buf_size(),
           micro_data.get_buf(), micro_data.get_buf_size(), is_compressed))) {
@@ -41,7 +41,8 @@ ObMacroBlockReader::ObMacroBlockReader(const uint64_t tenant_id)
      decrypt_buf_(NULL),
      decrypt_buf_size_(0),
      allocator_(ObModIds::OB_CS_SSTABLE_READER, OB_MALLOC_NORMAL_BLOCK_SIZE, tenant_id),
-     encryption_(nullptr)
+     encryption_(nullptr),
+     compress_dict_()
 {
   if (share::is_reserve_mode()) {
     allocator_.set_ctx_id(ObCtxIds::MERGE_RESERVE_CTX_ID);
@@ -148,7 +149,7 @@ int ObMacroBlockReader::decompress_data_buf(
       if (OB_FAIL(alloc_buf(*ext_allocator, uncomp_size, ext_uncomp_buf))) {
         LOG_WARN("Fail to allocate buf", K(ret), K(uncomp_size), K(header));
       } else {
-        if (OB_FAIL(compressor_->decompress(data_buf, data_buf_size,
+        if (OB_FAIL(do_decompress(header, data_buf, data_buf_size,
             ext_uncomp_buf + header_size, data_length, uncomp_size))) {
           LOG_WARN("compressor fail to decompress.", K(ret));
         } else if (OB_FAIL(header.deep_copy(ext_uncomp_buf, header_size, pos, copied_header))) {
@@ -164,7 +165,7 @@ int ObMacroBlockReader::decompress_data_buf(
       }
     } else if (OB_FAIL(alloc_buf(uncomp_size, uncomp_buf_, uncomp_buf_size_))) {
       LOG_WARN("Fail to allocate buf", K(ret));
-    } else if (OB_FAIL(compressor_->decompress(data_buf, data_buf_size,
+    } else if (OB_FAIL(do_decompress(header, data_buf, data_buf_size,
         uncomp_buf_ + header_size, data_length, uncomp_size))) {
       LOG_WARN("Fail to decompress", K(ret));
     } else if (OB_FAIL(header.deep_copy(uncomp_buf_, header_size, pos, copied_header))) {
@@ -177,6 +178,32 @@ int ObMacroBlockReader::decompress_data_buf(
   return ret;
 }
 
+int ObMacroBlockReader::do_decompress(
+    const ObMicroBlockHeader &header,
+    const char *comp_buf,
+    const int64_t comp_size,
+    char *uncomp_buf,
+    const int64_t uncomp_buf_size,
+    int64_t &uncomp_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(compressor_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected null compressor", K(ret));
+  } else if (!header.has_compress_dict()) {
+    if (OB_FAIL(compressor_->decompress(comp_buf, comp_size, uncomp_buf, uncomp_buf_size, uncomp_size))) {
+      LOG_WARN("compressor fail to decompress.", K(ret));
+    }
+  } else if (OB_UNLIKELY(compress_dict_.empty())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("compress dict is not set for micro block compressed with dict", K(ret), K(header));
+  } else if (OB_FAIL(compressor_->decompress_with_dict(comp_buf, comp_size, compress_dict_.ptr(),
+      compress_dict_.length(), uncomp_buf, uncomp_buf_size, uncomp_size))) {
+    LOG_WARN("compressor fail to decompress with dict.", K(ret), "dict_size", compress_dict_.length());
+  }
+  return ret;
+}
+
 int ObMacroBlockReader::decompress_payload_buf(
     const common::ObCompressorType compressor_type,
     const char *payload_buf,
@@ -248,7 +275,8 @@ int ObMacroBlockReader::decompress_data_with_prealloc_buf(
     const char *buf,
     const int64_t size,
     char *uncomp_buf,
-    const int64_t uncomp_buf_size)
+    const int64_t uncomp_buf_size,
+    const bool with_compress_dict)
 {
   int ret = OB_SUCCESS;
   int64_t uncomp_size = 0;
@@ -270,9 +298,19 @@ int ObMacroBlockReader::decompress_data_with_prealloc_buf(
       }
     }
 
-    if (FAILEDx(compressor_->decompress(buf, size, uncomp_buf, uncomp_buf_size, uncomp_size))) {
-      LOG_WARN("Fail to decompress data", K(ret));
-    } else {
+    if (OB_FAIL(ret)) {
+    } else if (!with_compress_dict) {
+      if (OB_FAIL(compressor_->decompress(buf, size, uncomp_buf, uncomp_buf_size, uncomp_size))) {
+        LOG_WARN("Fail to decompress data", K(ret));
+      }
+    } else if (OB_UNLIKELY(compress_dict_.empty())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("compress dict is not set for micro block compressed with dict", K(ret));
+    } else if (OB_FAIL(compressor_->decompress_with_dict(buf, size, compress_dict_.ptr(),
+        compress_dict_.length(), uncomp_buf, uncomp_buf_size, uncomp_size))) {
+      LOG_WARN("Fail to decompress data with dict", K(ret), "dict_size", compress_dict_.length());
+    }
+    if (OB_SUCC(ret)) {
       if (OB_UNLIKELY(uncomp_size != uncomp_buf_size)) {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("Uncompressed size is not equal to buffer size",
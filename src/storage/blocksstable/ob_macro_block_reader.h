@@ -73,7 +73,8 @@ public:
       const char *buf,
       const int64_t size,
       char *uncomp_buf,
-      const int64_t uncomp_buf_size);
+      const int64_t uncomp_buf_size,
+      const bool with_compress_dict = false);
   int decompress_data_with_prealloc_buf(
       const char *compressor_name,
       const char *buf,
@@ -125,7 +126,19 @@ public:
       const char *&decrypt_buf,
       int64_t &decrypt_size);
 #endif
+  // compress dict of the macro block which the following micro blocks belong to,
+  // the dict buffer is not copied and must be valid during decompression.
+  OB_INLINE void set_compress_dict(const common::ObString &dict) { compress_dict_ = dict; }
+  OB_INLINE void reset_compress_dict() { compress_dict_.reset(); }
+  OB_INLINE const common::ObString &get_compress_dict() const { return compress_dict_; }
 private:
+  int do_decompress(
+      const ObMicroBlockHeader &header,
+      const char *comp_buf,
+      const int64_t comp_size,
+      char *uncomp_buf,
+      const int64_t uncomp_buf_size,
+      int64_t &uncomp_size);
   int alloc_buf(const int64_t req_size, char *&buf, int64_t &buf_size);
   int alloc_buf(ObIAllocator &allocator, const int64_t buf_size, char *&buf);
 #ifdef OB_BUILD_TDE_SECURITY
@@ -140,6 +153,7 @@ private:
   int64_t decrypt_buf_size_;
   common::ObArenaAllocator allocator_;
   ObMicroBlockEncryption *encryption_;
+  common::ObString compress_dict_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObMacroBlockReader);
 };
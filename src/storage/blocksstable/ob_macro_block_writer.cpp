@@ -48,6 +48,8 @@ ObMicroBlockBufferHelper::ObMicroBlockBufferHelper()
     check_reader_helper_(),
     checksum_helper_(),
     check_datum_row_(),
+    shared_dict_(nullptr),
+    compress_dict_builder_(nullptr),
     allocator_("BlockBufHelper")
 {
 }
@@ -103,6 +105,8 @@ void ObMicroBlockBufferHelper::reset()
 #endif
   check_reader_helper_.reset();
   check_datum_row_.reset();
+  shared_dict_ = nullptr;
+  compress_dict_builder_ = nullptr;
 }
 
 int ObMicroBlockBufferHelper::compress_encrypt_micro_block(ObMicroBlockDesc &micro_block_desc,
@@ -114,15 +118,22 @@ int ObMicroBlockBufferHelper::compress_encrypt_micro_block(ObMicroBlockDesc &mic
   int64_t block_size = micro_block_desc.buf_size_;
   const char *compress_buf = NULL;
   int64_t compress_buf_size = 0;
+  // micro blocks sampled into the compress dict are compressed without it
+  const ObString compress_dict = nullptr == compress_dict_builder_ ? ObString() : compress_dict_builder_->get_dict();
+  bool with_compress_dict = false;
   if (OB_UNLIKELY(!micro_block_desc.is_valid())) {
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "invalid micro block desc", K(ret), K(micro_block_desc));
-  } else if (OB_FAIL(compressor_.compress(block_buffer, block_size, compress_buf, compress_buf_size))) {
+  } else if (nullptr != compress_dict_builder_ && !compress_dict_builder_->is_ready()
+      && OB_FAIL(compress_dict_builder_->add_sample(block_buffer, block_size))) {
+    STORAGE_LOG(WARN, "fail to sample micro block for compress dict", K(ret), K(block_size));
+  } else if (OB_FAIL(compressor_.compress(block_buffer, block_size, compress_dict,
+      compress_buf, compress_buf_size, with_compress_dict))) {
     STORAGE_LOG(WARN, "macro block writer fail to compress.",
         K(ret), K(OB_P(block_buffer)), K(block_size));
   } else if (MICRO_BLOCK_MERGE_VERIFY_LEVEL::NONE != micro_block_merge_verify_level_
       && OB_FAIL(check_micro_block(compress_buf, compress_buf_size,
-            block_buffer, block_size, micro_block_desc))) {
+            block_buffer, block_size, with_compress_dict ? compress_dict : ObString(), micro_block_desc))) {
     STORAGE_LOG(WARN, "failed to check micro block", K(ret));
 #ifndef OB_BUILD_TDE_SECURITY
   } else {
@@ -142,6 +153,7 @@ int ObMicroBlockBufferHelper::compress_encrypt_micro_block(ObMicroBlockDesc &mic
     header->data_zlength_ = micro_block_desc.buf_size_;
     header->data_checksum_ = ob_crc64_sse42(0, micro_block_desc.buf_, micro_block_desc.buf_size_);
     header->original_length_ = micro_block_desc.original_size_;
+    header->has_compress_dict_ = with_compress_dict;
     header->set_header_checksum();
   }
   return ret;
@@ -152,6 +164,7 @@ int ObMicroBlockBufferHelper::check_micro_block(
     const int64_t compressed_size,
     const char *uncompressed_buf,
     const int64_t uncompressed_size,
+    const ObString &compress_dict,
     const ObMicroBlockDesc &micro_desc)
 {
   int ret = OB_SUCCESS;
@@ -160,7 +173,7 @@ int ObMicroBlockBufferHelper::check_micro_block(
   if (MICRO_BLOCK_MERGE_VERIFY_LEVEL::ENCODING == micro_block_merge_verify_level_) {
     decomp_buf = const_cast<char *>(uncompressed_buf);
   } else if (OB_FAIL(compressor_.decompress(compressed_buf, compressed_size, uncompressed_size,
-          decomp_buf, real_decomp_size))) {
+          compress_dict, decomp_buf, real_decomp_size))) {
     STORAGE_LOG(WARN, "failed to decompress data", K(ret));
   } else if (uncompressed_size != real_decomp_size) {
     ret = OB_CHECKSUM_ERROR;
@@ -241,6 +254,7 @@ int ObMicroBlockBufferHelper::prepare_micro_block_reader(
   ObMicroBlockData block_data;
   block_data.buf_ = buf;
   block_data.size_ = size;
+  block_data.shared_dict_ = shared_dict_;
   const ObMicroBlockHeader *header = reinterpret_cast<const ObMicroBlockHeader *>(buf);
   ObRowStoreType row_store_type = static_cast<ObRowStoreType>(header->row_store_type_);
   if (OB_FAIL(check_reader_helper_.get_reader(row_store_type, micro_reader))) {
@@ -425,6 +439,8 @@ ObMacroBlockWriter::ObMacroBlockWriter(const bool is_need_macro_buffer)
     callback_(nullptr),
     builder_(NULL),
     data_block_pre_warmer_(),
+    shared_dict_builder_(),
+    compress_dict_builder_(),
     io_buf_(nullptr)
 {
 }
@@ -467,6 +483,8 @@ void ObMacroBlockWriter::reset()
   }
   micro_block_adaptive_splitter_.reset();
   release_pre_agg_util();
+  shared_dict_builder_.reset();
+  compress_dict_builder_.reset();
   allocator_.reset();
   rowkey_allocator_.reset();
   io_buf_ = nullptr;
@@ -500,15 +518,22 @@ int ObMacroBlockWriter::open(
       STORAGE_LOG(WARN, "Failed to build hash_index builder", K(ret));
     } else if (OB_FAIL(init_data_pre_warmer(start_seq))) {
       STORAGE_LOG(WARN, "Failed to build data pre warmer", K(ret));
+    } else if (OB_FAIL(init_shared_dict_builder(data_store_desc))) {
+      STORAGE_LOG(WARN, "Failed to init shared dict builder", K(ret));
+    } else if (OB_FAIL(init_compress_dict_builder(data_store_desc))) {
+      STORAGE_LOG(WARN, "Failed to init compress dict builder", K(ret));
     } else if (OB_FAIL(build_micro_writer(data_store_desc_,
                                           allocator_,
                                           micro_writer_,
-                                          GCONF.micro_block_merge_verify_level))) {
+                                          GCONF.micro_block_merge_verify_level,
+                                          get_shared_dict_builder()))) {
       STORAGE_LOG(WARN, "fail to build micro writer", K(ret));
     } else if (OB_FAIL(datum_row_.init(allocator_, data_store_desc.get_row_column_count()))) {
       STORAGE_LOG(WARN, "Failed to init datum row", K(ret), K(data_store_desc.get_row_column_count()));
     } else if (OB_FAIL(micro_helper_.open(data_store_desc, allocator_))) {
       STORAGE_LOG(WARN, "Failed to open micro helper", K(ret), K(data_store_desc));
+    } else if (FALSE_IT(micro_helper_.set_shared_dict(get_shared_dict_builder()))) {
+    } else if (FALSE_IT(micro_helper_.set_compress_dict_builder(get_compress_dict_builder()))) {
     } else if (OB_FAIL(reader_helper_.init(allocator_))) {
       STORAGE_LOG(WARN, "Failed to init reader helper", K(ret));
     } else if (OB_FAIL(init_pre_agg_util(data_store_desc))) {
@@ -527,9 +552,11 @@ int ObMacroBlockWriter::open(
       }
     }
     if (OB_FAIL(ret)) {
-    } else if (OB_FAIL(macro_blocks_[0].init(data_store_desc, start_seq.get_data_seq()))) {
+    } else if (OB_FAIL(macro_blocks_[0].init(data_store_desc, start_seq.get_data_seq(),
+        get_shared_dict_builder(), get_compress_dict_builder()))) {
       STORAGE_LOG(WARN, "Fail to init 0th macro block, ", K(ret));
-    } else if (is_need_macro_buffer_ && OB_FAIL(macro_blocks_[1].init(data_store_desc, start_seq.get_data_seq() + 1))) {
+    } else if (is_need_macro_buffer_ && OB_FAIL(macro_blocks_[1].init(data_store_desc, start_seq.get_data_seq() + 1,
+        get_shared_dict_builder(), get_compress_dict_builder()))) {
       STORAGE_LOG(WARN, "Fail to init 1th macro block, ", K(ret));
     } else if (data_store_desc_->is_major_merge_type()) {
       if (OB_ISNULL(curr_micro_column_checksum_ = static_cast<int64_t *>(
@@ -755,6 +782,17 @@ int ObMacroBlockWriter::append_micro_block(
   if (OB_ISNULL(data_store_desc_)) {
     ret = OB_NOT_INIT;
     STORAGE_LOG(WARN, "The ObMacroBlockWriter has not been opened, ", K(ret), KP(data_store_desc_));
+  } else if (OB_ISNULL(micro_block_desc.header_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid micro block desc", K(ret), K(micro_block_desc));
+  } else if (OB_UNLIKELY(micro_block_desc.header_->has_shared_dict())) {
+    // references of shared dict are only valid in the macro block they are written
+    ret = OB_NOT_SUPPORTED;
+    STORAGE_LOG(WARN, "micro block with shared dict can not be appended directly", K(ret), K(micro_block_desc));
+  } else if (OB_UNLIKELY(micro_block_desc.header_->has_compress_dict())) {
+    // compress dict is stored in the macro block the micro block is written
+    ret = OB_NOT_SUPPORTED;
+    STORAGE_LOG(WARN, "micro block with compress dict can not be appended directly", K(ret), K(micro_block_desc));
   } else if (OB_FAIL(save_last_key(micro_block_desc.last_rowkey_))) {
     STORAGE_LOG(WARN, "fail to save last ke", K(ret), K(micro_block_desc));
   } else if (OB_FAIL(agg_micro_block(micro_index_info))) {
@@ -1241,7 +1279,7 @@ int ObMacroBlockWriter::build_micro_block_desc_with_rewrite(
   } else {
     bool is_compressed = false;
     reader->reset();
-
+    macro_reader_.set_compress_dict(micro_block.data_.compress_dict_);
     if (OB_FAIL(macro_reader_.decrypt_and_decompress_data(micro_des_meta, micro_block.data_.get_buf(),
         micro_block.data_.get_buf_size(), decompressed_data.get_buf(), decompressed_data.get_buf_size(), is_compressed))) {
       LOG_WARN("fail to decrypt and decompress data", K(ret));
@@ -1314,6 +1352,8 @@ int ObMacroBlockWriter::write_micro_block(ObMicroBlockDesc &micro_block_desc)
     } else if (OB_UNLIKELY(micro_block_desc.block_offset_ != data_offset)) {
       ret = OB_ERR_UNEXPECTED;
       STORAGE_LOG(WARN, "expect block offset equal ", K(ret), K(micro_block_desc), K(data_offset));
+    } else if (shared_dict_builder_.is_inited()) {
+      shared_dict_builder_.commit();
     }
   } else {
     // we use macro_block.write_micro_block() to judge whether the micro_block can be added
@@ -1333,6 +1373,9 @@ int ObMacroBlockWriter::write_micro_block(ObMicroBlockDesc &micro_block_desc)
     if (OB_SUCC(ret)) {
       micro_block_desc.macro_id_ = macro_handles_[current_index_].get_macro_id();
       micro_block_desc.block_offset_ = data_offset;
+      if (shared_dict_builder_.is_inited()) {
+        shared_dict_builder_.commit();
+      }
     }
   }
 
@@ -1401,6 +1444,10 @@ int ObMacroBlockWriter::flush_macro_block(ObMacroBlock &macro_block)
     STORAGE_LOG(WARN, "fail to wait callback flush", K(ret));
   } else if (is_need_macro_buffer_ && OB_FAIL(wait_io_finish(prev_handle))) {
     STORAGE_LOG(WARN, "Fail to wait io finish, ", K(ret));
+  } else if (shared_dict_builder_.is_inited() && OB_FAIL(macro_block.write_shared_dict())) {
+    STORAGE_LOG(WARN, "fail to write shared dict", K(ret), K_(shared_dict_builder));
+  } else if (compress_dict_builder_.is_inited() && OB_FAIL(macro_block.write_compress_dict())) {
+    STORAGE_LOG(WARN, "fail to write compress dict", K(ret), K_(compress_dict_builder));
   } else if (OB_NOT_NULL(builder_)
       && OB_FAIL(builder_->generate_macro_row(macro_block, macro_handle.get_macro_id(), ddl_start_row_offset))) {
     STORAGE_LOG(WARN, "fail to generate macro row", K(ret), K_(current_macro_seq));
@@ -1420,13 +1467,38 @@ int ObMacroBlockWriter::flush_macro_block(ObMacroBlock &macro_block)
     ++current_macro_seq_;
     const int64_t current_macro_seq = is_need_macro_buffer_ ? current_macro_seq_ + 1 :
         current_macro_seq_;
-    if (OB_FAIL(macro_block.init(*data_store_desc_, current_macro_seq))) {
+    if (OB_FAIL(macro_block.init(*data_store_desc_, current_macro_seq, get_shared_dict_builder(),
+        get_compress_dict_builder()))) {
       STORAGE_LOG(WARN, "macro block writer fail to init.", K(ret));
     }
   }
   return ret;
 }
 
+int ObMacroBlockWriter::init_shared_dict_builder(const ObDataStoreDesc &data_store_desc)
+{
+  int ret = OB_SUCCESS;
+  shared_dict_builder_.reset();
+  if (!ObCSSharedDictBuilder::is_enabled(data_store_desc, nullptr != callback_)) {
+  } else if (OB_FAIL(shared_dict_builder_.init(allocator_))) {
+    STORAGE_LOG(WARN, "fail to init shared dict builder", K(ret));
+  }
+  return ret;
+}
+
+int ObMacroBlockWriter::init_compress_dict_builder(const ObDataStoreDesc &data_store_desc)
+{
+  int ret = OB_SUCCESS;
+  compress_dict_builder_.reset();
+  if (nullptr == data_store_desc.sstable_index_builder_) {
+    // only for data macro blocks
+  } else if (!ObMicroBlockCompressDictBuilder::is_enabled(data_store_desc, nullptr != callback_)) {
+  } else if (OB_FAIL(compress_dict_builder_.init(allocator_))) {
+    STORAGE_LOG(WARN, "fail to init compress dict builder", K(ret));
+  }
+  return ret;
+}
+
 int ObMacroBlockWriter::flush_reuse_macro_block(const ObDataMacroBlockMeta &macro_meta)
 {
   int ret = OB_SUCCESS;
@@ -1547,6 +1619,12 @@ int ObMacroBlockWriter::check_micro_block_need_merge(
     ObRowStoreType row_store_type = static_cast<ObRowStoreType>(micro_block.header_.row_store_type_);
     if (row_store_type != data_store_desc_->get_row_store_type()) {
       need_merge = true;
+    } else if (micro_block.header_.has_shared_dict()) {
+      // references of shared dict are only valid in the macro block they are written
+      need_merge = true;
+    } else if (micro_block.header_.has_compress_dict()) {
+      // compress dict of the new macro block may be different
+      need_merge = true;
     } else if (micro_writer_->get_row_count() <= 0
         && micro_block.header_.data_length_ > data_store_desc_->get_micro_block_size() / 2) {
       need_merge = false;
@@ -1600,9 +1678,11 @@ int ObMacroBlockWriter::merge_micro_block(const ObMicroBlock &micro_block)
     }
 
     micro_reader->reset();
+    macro_reader_.set_compress_dict(micro_block.data_.compress_dict_);
     if (OB_FAIL(macro_reader_.decrypt_and_decompress_data(micro_des_meta, micro_block.data_.get_buf(),
         micro_block.data_.get_buf_size(), decompressed_data.get_buf(), decompressed_data.get_buf_size(), is_compressed))) {
       STORAGE_LOG(WARN, "fail to decrypt and decompress data", K(ret));
+    } else if (FALSE_IT(decompressed_data.shared_dict_ = micro_block.data_.shared_dict_)) {
     } else if (OB_FAIL(micro_reader->init(decompressed_data, nullptr))) {
       STORAGE_LOG(WARN, "micro_block_reader init failed", K(micro_block), K(ret));
     } else {
@@ -1682,7 +1762,8 @@ int ObMacroBlockWriter::calc_micro_column_checksum(const int64_t column_cnt,
 int ObMacroBlockWriter::build_micro_writer(const ObDataStoreDesc *data_store_desc,
                                            ObIAllocator &allocator,
                                            ObIMicroBlockWriter *&micro_writer,
-                                           const int64_t verify_level)
+                                           const int64_t verify_level,
+                                           ObCSSharedDictBuilder *shared_dict_builder)
 {
   int ret = OB_SUCCESS;
   void *buf = nullptr;
@@ -1702,6 +1783,7 @@ int ObMacroBlockWriter::build_micro_writer(const ObDataStoreDesc *data_store_des
     encoding_ctx.row_store_type_ = data_store_desc->get_row_store_type();
     encoding_ctx.need_calc_column_chksum_ = data_store_desc->is_major_merge_type();
     encoding_ctx.compressor_type_ = data_store_desc->get_compressor_type();
+    encoding_ctx.shared_dict_builder_ = shared_dict_builder;
     if (ObStoreFormat::is_row_store_type_with_pax_encoding(data_store_desc->get_row_store_type())) {
       if (OB_ISNULL(buf = allocator.alloc(sizeof(ObMicroBlockEncoder)))) {
         ret = OB_ALLOCATE_MEMORY_FAILED;
@@ -1816,7 +1898,9 @@ void ObMacroBlockWriter::dump_macro_block(ObMacroBlock &macro_block)
         ObMacroBlock::calc_basic_micro_block_data_offset(
           data_store_desc_->get_row_column_count(),
           data_store_desc_->get_rowkey_column_count(),
-          data_store_desc_->get_fixed_header_version());
+          data_store_desc_->get_fixed_header_version(),
+          shared_dict_builder_.is_inited(),
+          compress_dict_builder_.is_inited());
     const char *data_buf = macro_block.get_data_buf() + data_offset;
     const int64_t data_size = macro_block.get_data_size() - data_offset;
     int64_t pos = 0;
@@ -1827,6 +1911,7 @@ void ObMacroBlockWriter::dump_macro_block(ObMacroBlock &macro_block)
     ObMicroBlockData micro_data;
     ObMicroBlockData decompressed_data;
     int64_t block_idx = 0;
+    macro_reader_.set_compress_dict(compress_dict_builder_.get_dict());
     while (OB_SUCC(ret) && pos < data_size && block_idx < block_cnt) {
       const char *buf = data_buf + pos;
       if (OB_FAIL(header.deserialize(data_buf, data_size, pos))) {
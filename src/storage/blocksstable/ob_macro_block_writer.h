@@ -32,6 +32,8 @@
 #include "share/cache/ob_kvcache_pre_warmer.h"
 #include "ob_macro_block_bare_iterator.h"
 #include "ob_micro_block_checksum_helper.h"
+#include "cs_encoding/ob_cs_shared_dict.h"
+#include "ob_micro_block_compress_dict.h"
 #include "storage/compaction/ob_compaction_memory_context.h"
 
 namespace oceanbase
@@ -53,6 +55,8 @@ class ObIMacroBlockFlushCallback;
 //  |- MicroBlock 1
 //  |- MicroBlock 2
 //  |- MicroBlock N
+//  |- Shared Dict (optional, cs encoding)
+//  |- Compress Dict (optional, micro block compression)
 class ObMicroBlockBufferHelper
 {
 public:
@@ -63,6 +67,8 @@ public:
       common::ObIAllocator &allocator);
   int compress_encrypt_micro_block(ObMicroBlockDesc &micro_block_desc, const int64_t macro_seq, const int64_t micro_offset);
   int dump_micro_block_writer_buffer(const char *buf, const int64_t size);
+  void set_shared_dict(const ObICSSharedDictProvider *shared_dict) { shared_dict_ = shared_dict; }
+  void set_compress_dict_builder(ObMicroBlockCompressDictBuilder *builder) { compress_dict_builder_ = builder; }
   void reset();
 private:
   int prepare_micro_block_reader(
@@ -78,6 +84,7 @@ private:
       const int64_t compressed_size,
       const char *uncompressed_buf,
       const int64_t uncompressed_size,
+      const common::ObString &compress_dict,
       const ObMicroBlockDesc &micro_block_desc/*check for this micro block*/);
   void print_micro_block_row(ObIMicroBlockReader *micro_reader);
 
@@ -89,6 +96,8 @@ private:
   ObMicroBlockReaderHelper check_reader_helper_;
   ObMicroBlockChecksumHelper checksum_helper_;
   blocksstable::ObDatumRow check_datum_row_;
+  const ObICSSharedDictProvider *shared_dict_;
+  ObMicroBlockCompressDictBuilder *compress_dict_builder_;
   compaction::ObLocalArena allocator_;
 };
 
@@ -163,7 +172,8 @@ public:
   static int build_micro_writer(const ObDataStoreDesc *data_store_desc,
                                 ObIAllocator &allocator,
                                 ObIMicroBlockWriter *&micro_writer,
-                                const int64_t verify_level = MICRO_BLOCK_MERGE_VERIFY_LEVEL::ENCODING_AND_COMPRESSION);
+                                const int64_t verify_level = MICRO_BLOCK_MERGE_VERIFY_LEVEL::ENCODING_AND_COMPRESSION,
+                                ObCSSharedDictBuilder *shared_dict_builder = nullptr);
   inline int64_t get_macro_data_size() const { return macro_blocks_[current_index_].get_data_size() + micro_writer_->get_block_size(); }
 
 protected:
@@ -198,6 +208,16 @@ private:
   int check_micro_block_need_merge(const ObMicroBlock &micro_block, bool &need_merge);
   int merge_micro_block(const ObMicroBlock &micro_block);
   int flush_macro_block(ObMacroBlock &macro_block);
+  int init_shared_dict_builder(const ObDataStoreDesc &data_store_desc);
+  int init_compress_dict_builder(const ObDataStoreDesc &data_store_desc);
+  OB_INLINE ObMicroBlockCompressDictBuilder *get_compress_dict_builder()
+  {
+    return compress_dict_builder_.is_inited() ? &compress_dict_builder_ : nullptr;
+  }
+  OB_INLINE ObCSSharedDictBuilder *get_shared_dict_builder()
+  {
+    return shared_dict_builder_.is_inited() ? &shared_dict_builder_ : nullptr;
+  }
   int try_active_flush_macro_block();
   int wait_io_finish(ObMacroBlockHandle &macro_handle);
   int alloc_block();
@@ -255,6 +275,8 @@ private:
   ObDataIndexBlockBuilder *builder_;
   ObMicroBlockAdaptiveSplitter micro_block_adaptive_splitter_;
   ObDataBlockCachePreWarmer data_block_pre_warmer_;
+  ObCSSharedDictBuilder shared_dict_builder_;
+  ObMicroBlockCompressDictBuilder compress_dict_builder_;
   char *io_buf_;
 };
 
@@ -19,6 +19,7 @@
 #include "storage/blocksstable/ob_macro_block_handle.h"
 #include "storage/blocksstable/ob_shared_macro_block_manager.h"
 #include "storage/blocksstable/cs_encoding/ob_cs_micro_block_transformer.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
 
 namespace oceanbase
 {
@@ -422,6 +423,20 @@ int ObIMicroBlockIOCallback::process_block(
       } else if (OB_FAIL(cache_->put_cache_block(
           block_des_meta_, buffer, key, *reader, *allocator_, micro_block, cache_handle, rowkey_col_descs_))) {
         LOG_WARN("Failed to put block to cache", K(ret));
+      } else {
+        int tmp_ret = OB_SUCCESS;
+        if (ObMicroBlockData::DATA_BLOCK == cache_->get_type()
+            && header.is_compressed_data()
+            && ObCompressedMicroBlockCache::is_enabled()) {
+          if (OB_TMP_FAIL(OB_STORE_CACHE.get_compressed_block_cache().put_block(key, buffer, size))) {
+            LOG_WARN("Fail to put block to compressed block cache", K(tmp_ret), K(key));
+          }
+        }
+        if (OB_STORE_CACHE.get_flash_cache().is_enabled()) {
+          if (OB_TMP_FAIL(OB_STORE_CACHE.get_flash_cache().put_block(key.get_micro_block_id(), buffer))) {
+            LOG_WARN("Fail to put block to flash cache", K(tmp_ret), K(key));
+          }
+        }
       }
     }
 
@@ -455,7 +470,10 @@ int ObIMicroBlockIOCallback::read_block_and_copy(
     }
   } else {
     bool is_compressed = false;
-    if (OB_FAIL(reader.do_decrypt_and_decompress_data(
+    ObCompressDictReaderGuard dict_guard(reader);
+    if (OB_FAIL(dict_guard.prepare(header, tenant_id_, block_id_))) {
+      LOG_WARN("fail to prepare compress dict", K(ret), K(header), K_(block_id));
+    } else if (OB_FAIL(reader.do_decrypt_and_decompress_data(
         header, block_des_meta_, buffer, size,
         block_data.get_buf(), block_data.get_buf_size(),
         is_compressed, false/*need deep copy*/, nullptr))) {
@@ -741,7 +759,10 @@ int ObSyncSingleMicroBLockIOCallback::inner_process(const char *data_buffer, con
           LOG_WARN("fail to decrypt_and_full_transform_data", K(ret), K(header), K(block_des_meta_), K(is_data_block_));
         }
       } else { // not cs_encoding
-        if (OB_FAIL(macro_reader_->do_decrypt_and_decompress_data(
+        ObCompressDictReaderGuard dict_guard(*macro_reader_);
+        if (OB_FAIL(dict_guard.prepare(header, tenant_id_, block_id_))) {
+          LOG_WARN("fail to prepare compress dict", K(ret), K(header), K_(block_id));
+        } else if (OB_FAIL(macro_reader_->do_decrypt_and_decompress_data(
             header, block_des_meta_, src_block_buf, src_buf_size, block_data_->get_buf(),
             block_data_->get_buf_size(), is_compressed, true /* need_deep_copy */, allocator_))) {
           LOG_WARN("Fail to decrypt and decompress micro block data buf", K(ret));
@@ -765,7 +786,8 @@ int ObIMicroBlockCache::get_cache_block(
     const MacroBlockId block_id,
     const int64_t offset,
     const int64_t size,
-    ObMicroBlockBufferHandle &handle)
+    ObMicroBlockBufferHandle &handle,
+    const ObMicroBlockDesMeta *des_meta)
 {
   int ret = OB_SUCCESS;
   BaseBlockCache *cache = NULL;
@@ -781,6 +803,15 @@ int ObIMicroBlockCache::get_cache_block(
     if (OB_FAIL(cache->get(key, handle.micro_block_, handle.handle_))) {
       if (OB_ENTRY_NOT_EXIST != ret) {
         STORAGE_LOG(WARN, "Fail to get micro block from block cache, ", K(ret));
+      } else if (nullptr != des_meta
+          && ObMicroBlockData::DATA_BLOCK == get_type()
+          && ObCompressedMicroBlockCache::is_enabled()) {
+        ret = get_compressed_cache_block(key, *des_meta, handle);
+      }
+      if (OB_ENTRY_NOT_EXIST == ret
+          && nullptr != des_meta
+          && OB_STORE_CACHE.get_flash_cache().is_enabled()) {
+        ret = get_flash_cache_block(key, *des_meta, handle);
       }
     } else {
       EVENT_INC(ObStatEventIds::BLOCK_CACHE_HIT);
@@ -789,6 +820,87 @@ int ObIMicroBlockCache::get_cache_block(
   return ret;
 }
 
+int ObIMicroBlockCache::get_compressed_cache_block(
+    const ObMicroBlockCacheKey &key,
+    const ObMicroBlockDesMeta &des_meta,
+    ObMicroBlockBufferHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  const ObCompressedMicroBlockCacheValue *compressed_block = nullptr;
+  ObKVCacheHandle compressed_handle;
+  ObMacroBlockReader *reader = nullptr;
+  ObIAllocator *allocator = nullptr;
+  if (OB_FAIL(OB_STORE_CACHE.get_compressed_block_cache().get_block(key, compressed_block, compressed_handle))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      STORAGE_LOG(WARN, "Fail to get micro block from compressed block cache", K(ret), K(key));
+    }
+    EVENT_INC(ObStatEventIds::COMPRESSED_BLOCK_CACHE_MISS);
+  } else if (OB_ISNULL(compressed_block)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "Unexpected null compressed block", K(ret), K(key));
+  } else if (OB_ISNULL(reader = GET_TSI_MULT(ObMacroBlockReader, 1))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "Fail to allocate ObMacroBlockReader", K(ret));
+  } else if (OB_FAIL(get_allocator(allocator))) {
+    STORAGE_LOG(WARN, "Fail to get allocator", K(ret));
+  } else {
+    // promote the block into this cache, the compressed one is left to be washed by kvcache
+    const int64_t begin_time = ObTimeUtility::current_time();
+    if (OB_FAIL(put_cache_block(des_meta, compressed_block->get_buf(), key, *reader, *allocator,
+                                handle.micro_block_, handle.handle_))) {
+      STORAGE_LOG(WARN, "Fail to promote micro block from compressed block cache", K(ret), K(key));
+    } else {
+      EVENT_INC(ObStatEventIds::COMPRESSED_BLOCK_CACHE_HIT);
+      EVENT_ADD(ObStatEventIds::COMPRESSED_BLOCK_CACHE_DECOMPRESS_TIME,
+                ObTimeUtility::current_time() - begin_time);
+    }
+  }
+  if (OB_FAIL(ret)) {
+    handle.reset();
+    // fall back to disk io
+    ret = OB_ENTRY_NOT_EXIST;
+  }
+  return ret;
+}
+
+int ObIMicroBlockCache::get_flash_cache_block(
+    const ObMicroBlockCacheKey &key,
+    const ObMicroBlockDesMeta &des_meta,
+    ObMicroBlockBufferHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockId micro_id = key.get_micro_block_id();
+  ObArenaAllocator read_allocator("FlashCacheRead", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID());
+  char *buf = nullptr;
+  ObMacroBlockReader *reader = nullptr;
+  ObIAllocator *allocator = nullptr;
+  if (OB_ISNULL(buf = static_cast<char *>(read_allocator.alloc(micro_id.size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "Fail to allocate read buffer", K(ret), K(micro_id));
+  } else if (OB_FAIL(OB_STORE_CACHE.get_flash_cache().get_block(micro_id, buf))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      STORAGE_LOG(WARN, "Fail to get micro block from flash cache", K(ret), K(key));
+    }
+    EVENT_INC(ObStatEventIds::MICRO_BLOCK_FLASH_CACHE_MISS);
+  } else if (OB_ISNULL(reader = GET_TSI_MULT(ObMacroBlockReader, 1))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "Fail to allocate ObMacroBlockReader", K(ret));
+  } else if (OB_FAIL(get_allocator(allocator))) {
+    STORAGE_LOG(WARN, "Fail to get allocator", K(ret));
+  } else if (OB_FAIL(put_cache_block(des_meta, buf, key, *reader, *allocator,
+                                     handle.micro_block_, handle.handle_))) {
+    STORAGE_LOG(WARN, "Fail to promote micro block from flash cache", K(ret), K(key));
+  } else {
+    EVENT_INC(ObStatEventIds::MICRO_BLOCK_FLASH_CACHE_HIT);
+  }
+  if (OB_FAIL(ret)) {
+    handle.reset();
+    // fall back to disk io
+    ret = OB_ENTRY_NOT_EXIST;
+  }
+  return ret;
+}
+
 int ObIMicroBlockCache::prefetch(
     const uint64_t tenant_id,
     const MacroBlockId &macro_id,
@@ -1011,7 +1123,7 @@ int ObMicroBlockBufTransformer::transfrom(char *block_buf, const int64_t buf_siz
       if (OB_SUCC(ret)) {
         if (OB_FAIL(reader_->decompress_data_with_prealloc_buf(
             block_des_meta_.compressor_type_, payload_buf_, payload_size_,
-            block_buf + pos, buf_size - pos))) {
+            block_buf + pos, buf_size - pos, header_.has_compress_dict()))) {
           LOG_WARN("Fail to decompress data with preallocated buffer", K(ret), K_(header));
         }
       }
@@ -1029,6 +1141,62 @@ int ObMicroBlockBufTransformer::transfrom(char *block_buf, const int64_t buf_siz
   return ret;
 }
 
+/*---------------------------------ObCompressedMicroBlockCache------------------------------------*/
+int ObCompressedMicroBlockCacheValue::deep_copy(
+    char *buf,
+    const int64_t buf_len,
+    ObIKVCacheValue *&value) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(nullptr == buf || buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), KP(buf), K(buf_len), "size", size());
+  } else if (OB_UNLIKELY(nullptr == buf_ || buf_size_ <= 0)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("Invalid compressed micro block", K(ret), K(*this));
+  } else {
+    char *block_buf = buf + sizeof(*this);
+    MEMCPY(block_buf, buf_, buf_size_);
+    value = new (buf) ObCompressedMicroBlockCacheValue(block_buf, buf_size_);
+  }
+  return ret;
+}
+
+bool ObCompressedMicroBlockCache::is_enabled()
+{
+  return GCONF._enable_compressed_block_cache;
+}
+
+int ObCompressedMicroBlockCache::put_block(
+    const ObMicroBlockCacheKey &key,
+    const char *block_buf,
+    const int64_t block_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(nullptr == block_buf || block_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), KP(block_buf), K(block_size));
+  } else {
+    ObCompressedMicroBlockCacheValue value(block_buf, block_size);
+    if (OB_FAIL(put(key, value, false/*overwrite*/))) {
+      if (OB_ENTRY_EXIST != ret) {
+        LOG_WARN("Fail to put compressed micro block", K(ret), K(key));
+      } else {
+        ret = OB_SUCCESS;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObCompressedMicroBlockCache::get_block(
+    const ObMicroBlockCacheKey &key,
+    const ObCompressedMicroBlockCacheValue *&value,
+    ObKVCacheHandle &handle)
+{
+  return get(key, value, handle);
+}
+
 /*-------------------------------------ObDataMicroBlockCache--------------------------------------*/
 int ObDataMicroBlockCache::init(const char *cache_name, const int64_t priority)
 {
@@ -1117,6 +1285,8 @@ int ObDataMicroBlockCache::load_block(
       callback->block_data_ = &block_data;
       callback->macro_reader_ = macro_reader;
       callback->is_data_block_ = true;
+      callback->tenant_id_ = MTL_ID();
+      callback->block_id_ = micro_block_id.macro_id_;
 
       macro_read_info.macro_block_id_ = micro_block_id.macro_id_;
       macro_read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
@@ -1233,8 +1403,11 @@ int ObDataMicroBlockCache::put_cache_block(
     int64_t value_size = 0;
     int64_t extra_size = 0;
     bool need_decoder = false;
+    ObCompressDictReaderGuard dict_guard(reader);
     ObMicroBlockBufTransformer buf_transformer(des_meta, &reader, header, payload_buf, payload_size);
-    if (OB_FAIL(buf_transformer.init())) {
+    if (OB_FAIL(dict_guard.prepare(header, key.get_tenant_id(), micro_id.macro_id_))) {
+      LOG_WARN("Fail to prepare compress dict", K(ret), K(header), K(key));
+    } else if (OB_FAIL(buf_transformer.init())) {
       LOG_WARN("Fail to init buf transformer", K(ret));
     } else if (OB_FAIL(buf_transformer.get_buf_size(block_size))) {
       LOG_WARN("Fail to get block buf size", K(ret));
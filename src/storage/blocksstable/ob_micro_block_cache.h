@@ -90,6 +90,44 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObMicroBlockCacheValue);
 };
 
+class ObCompressedMicroBlockCacheValue : public common::ObIKVCacheValue
+{
+public:
+  ObCompressedMicroBlockCacheValue() : buf_(nullptr), buf_size_(0) {}
+  ObCompressedMicroBlockCacheValue(const char *buf, const int64_t buf_size)
+    : buf_(buf), buf_size_(buf_size) {}
+  virtual ~ObCompressedMicroBlockCacheValue() {}
+  virtual int64_t size() const override { return sizeof(*this) + buf_size_; }
+  virtual int deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const override;
+  inline const char *get_buf() const { return buf_; }
+  inline int64_t get_buf_size() const { return buf_size_; }
+  TO_STRING_KV(KP_(buf), K_(buf_size));
+private:
+  const char *buf_;
+  int64_t buf_size_;
+  DISALLOW_COPY_AND_ASSIGN(ObCompressedMicroBlockCacheValue);
+};
+
+// Second tier of user block cache, keeps data micro blocks as stored on disk (compressed, and
+// encrypted if so), which takes several times less memory than the decompressed blocks.
+// Blocks are admitted when read from disk, a miss of user block cache looks up this tier and
+// promotes the block by decompressing it into user block cache instead of reading disk again.
+class ObCompressedMicroBlockCache
+  : public common::ObKVCache<ObMicroBlockCacheKey, ObCompressedMicroBlockCacheValue>
+{
+public:
+  ObCompressedMicroBlockCache() {}
+  virtual ~ObCompressedMicroBlockCache() {}
+  int put_block(const ObMicroBlockCacheKey &key, const char *block_buf, const int64_t block_size);
+  int get_block(
+      const ObMicroBlockCacheKey &key,
+      const ObCompressedMicroBlockCacheValue *&value,
+      common::ObKVCacheHandle &handle);
+  static bool is_enabled();
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObCompressedMicroBlockCache);
+};
+
 class ObIMicroBlockCache;
 
 class ObMicroBlockBufferHandle
@@ -340,12 +378,15 @@ public:
   typedef common::ObIKVCache<ObMicroBlockCacheKey, ObMicroBlockCacheValue> BaseBlockCache;
   ObIMicroBlockCache() {}
   virtual ~ObIMicroBlockCache() {}
+  // %des_meta is required to promote the block from compressed block cache (only for data
+  // block) or flash cache on miss.
   int get_cache_block(
       const uint64_t tenant_id,
       const MacroBlockId block_id,
       const int64_t offset,
       const int64_t size,
-      ObMicroBlockBufferHandle &handle);
+      ObMicroBlockBufferHandle &handle,
+      const ObMicroBlockDesMeta *des_meta = nullptr);
   int prefetch(
       const uint64_t tenant_id,
       const MacroBlockId &macro_id,
@@ -384,6 +425,14 @@ public:
   virtual void cache_miss(int64_t &miss_cnt) = 0;
 
 protected:
+  int get_compressed_cache_block(
+      const ObMicroBlockCacheKey &key,
+      const ObMicroBlockDesMeta &des_meta,
+      ObMicroBlockBufferHandle &handle);
+  int get_flash_cache_block(
+      const ObMicroBlockCacheKey &key,
+      const ObMicroBlockDesMeta &des_meta,
+      ObMicroBlockBufferHandle &handle);
   int prefetch(
       const uint64_t tenant_id,
       const MacroBlockId &macro_id,
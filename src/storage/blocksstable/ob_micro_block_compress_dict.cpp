@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_block_compress_dict.h"
+#include "lib/compress/ob_compressor_pool.h"
+#include "share/config/ob_server_config.h"
+#include "storage/blocksstable/ob_data_store_desc.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+
+bool ObMicroBlockCompressDictBuilder::is_enabled(const ObDataStoreDesc &desc, const bool has_flush_callback)
+{
+  bool bret = false;
+  ObCompressor *compressor = nullptr;
+  if (!GCONF._enable_micro_block_compress_dict
+      || !desc.is_major_merge_type()
+      || desc.get_major_working_cluster_version() < DATA_VERSION_4_3_2_0
+      || ObStoreFormat::is_row_store_type_with_cs_encoding(desc.get_row_store_type())
+      || desc.get_encrypt_id() > 0
+      || has_flush_callback) {
+    // the dict is stored in plain text, cs encoding has no block level compression, and servers
+    // of older data version can not read the dict position in macro block header
+  } else if (OB_SUCCESS != ObCompressorPool::get_instance().get_compressor(desc.get_compressor_type(), compressor)) {
+  } else {
+    bret = nullptr != compressor && compressor->support_dict();
+  }
+  return bret;
+}
+
+ObMicroBlockCompressDictBuilder::ObMicroBlockCompressDictBuilder()
+  : allocator_(nullptr), dict_buf_(nullptr), dict_size_(0), sample_cnt_(0), is_inited_(false)
+{
+}
+
+ObMicroBlockCompressDictBuilder::~ObMicroBlockCompressDictBuilder()
+{
+  reset();
+}
+
+int ObMicroBlockCompressDictBuilder::init(ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_ISNULL(dict_buf_ = static_cast<char *>(allocator.alloc(MAX_DICT_SIZE)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc compress dict buffer", K(ret));
+  } else {
+    allocator_ = &allocator;
+    dict_size_ = 0;
+    sample_cnt_ = 0;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObMicroBlockCompressDictBuilder::reset()
+{
+  if (nullptr != allocator_ && nullptr != dict_buf_) {
+    allocator_->free(dict_buf_);
+  }
+  allocator_ = nullptr;
+  dict_buf_ = nullptr;
+  dict_size_ = 0;
+  sample_cnt_ = 0;
+  is_inited_ = false;
+}
+
+int ObMicroBlockCompressDictBuilder::add_sample(const char *buf, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_ISNULL(buf) || OB_UNLIKELY(size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(size));
+  } else if (is_ready()) {
+    // dict is frozen
+  } else {
+    // the leading bytes of a micro block contain the most common layout of the row store
+    const int64_t sample_size = MIN(MIN(size, MAX_SAMPLE_SIZE), MAX_DICT_SIZE - dict_size_);
+    MEMCPY(dict_buf_ + dict_size_, buf, sample_size);
+    dict_size_ += sample_size;
+    ++sample_cnt_;
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_COMPRESS_DICT_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_COMPRESS_DICT_H_
+
+#include "lib/allocator/ob_allocator.h"
+#include "lib/string/ob_string.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+struct ObDataStoreDesc;
+
+// Compress dict of data micro blocks.
+//
+// Small micro blocks compress poorly on their own since the compressor has no history to
+// match against. In major compaction the macro block writer samples the leading bytes of
+// its first uncompressed data micro blocks into a raw content dictionary, and compresses
+// the following data micro blocks with it once the sampling is finished. The dictionary
+// is frozen after that, and every macro block containing micro blocks compressed with it
+// stores a copy behind its micro blocks, see ObSSTableMacroBlockHeader::compress_dict_offset_.
+class ObMicroBlockCompressDictBuilder final
+{
+public:
+  ObMicroBlockCompressDictBuilder();
+  ~ObMicroBlockCompressDictBuilder();
+  static bool is_enabled(const ObDataStoreDesc &desc, const bool has_flush_callback);
+  int init(common::ObIAllocator &allocator);
+  void reset();
+  OB_INLINE bool is_inited() const { return is_inited_; }
+  // sample the uncompressed payload of a data micro block, ignored after the dict is ready
+  int add_sample(const char *buf, const int64_t size);
+  OB_INLINE bool is_ready() const
+  {
+    return is_inited_ && (sample_cnt_ >= SAMPLE_MICRO_BLOCK_CNT || dict_size_ >= MAX_DICT_SIZE);
+  }
+  // empty before the dict is ready
+  OB_INLINE common::ObString get_dict() const
+  {
+    return is_ready() ? common::ObString(static_cast<int32_t>(dict_size_), dict_buf_) : common::ObString();
+  }
+  // space reserved in every macro block for the dict
+  OB_INLINE int64_t get_reserve_size() const { return is_ready() ? dict_size_ : MAX_DICT_SIZE; }
+  TO_STRING_KV(KP_(dict_buf), K_(dict_size), K_(sample_cnt), K_(is_inited));
+private:
+  static const int64_t MAX_DICT_SIZE = 16L << 10; // 16KB
+  static const int64_t SAMPLE_MICRO_BLOCK_CNT = 8;
+  static const int64_t MAX_SAMPLE_SIZE = MAX_DICT_SIZE / SAMPLE_MICRO_BLOCK_CNT;
+  common::ObIAllocator *allocator_;
+  char *dict_buf_;
+  int64_t dict_size_;
+  int64_t sample_cnt_;
+  bool is_inited_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockCompressDictBuilder);
+};
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+#endif // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_COMPRESS_DICT_H_
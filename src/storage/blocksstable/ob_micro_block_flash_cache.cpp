@@ -0,0 +1,583 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "ob_micro_block_flash_cache.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/checksum/ob_crc64.h"
+#include "lib/container/ob_se_array.h"
+#include "lib/stat/ob_diagnose_info.h"
+#include "lib/thread/ob_thread_name.h"
+#include "lib/utility/utility.h"
+#include "lib/wait_event/ob_wait_event.h"
+#include "storage/blocksstable/ob_block_manager.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+
+ObMicroBlockFlashCache::ObMicroBlockFlashCache()
+  : is_inited_(false),
+    fd_(-1),
+    segment_cnt_(0),
+    segment_seqs_(nullptr),
+    next_segment_idx_(0),
+    max_seq_(INVALID_SEQ),
+    need_check_loaded_blocks_(false),
+    meta_buf_(nullptr),
+    index_map_(),
+    invalid_macro_ids_(),
+    cond_(),
+    flush_pending_(false),
+    active_segment_(),
+    flushing_segment_()
+{
+}
+
+ObMicroBlockFlashCache::~ObMicroBlockFlashCache()
+{
+  destroy();
+}
+
+int ObMicroBlockFlashCache::init(const char *file_path, const int64_t file_size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t segment_cnt = file_size / SEGMENT_SIZE;
+  const ObMemAttr attr(OB_SERVER_TENANT_ID, "FlashCache");
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("flash cache has been inited", K(ret));
+  } else if (OB_ISNULL(file_path) || OB_UNLIKELY(segment_cnt < MIN_SEGMENT_CNT)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid arguments", K(ret), KP(file_path), K(file_size));
+  } else if (FALSE_IT(segment_cnt_ = segment_cnt)) {
+  } else if (OB_ISNULL(segment_seqs_ = static_cast<int64_t *>(
+      ob_malloc(segment_cnt_ * sizeof(int64_t), attr)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate segment seqs", K(ret), K_(segment_cnt));
+  } else if (OB_ISNULL(meta_buf_ = static_cast<char *>(ob_malloc(SEGMENT_META_SIZE, attr)))
+      || OB_ISNULL(active_segment_.buf_ = static_cast<char *>(ob_malloc(SEGMENT_SIZE, attr)))
+      || OB_ISNULL(flushing_segment_.buf_ = static_cast<char *>(ob_malloc(SEGMENT_SIZE, attr)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate segment buffers", K(ret));
+  } else if (OB_FAIL(index_map_.create(segment_cnt_ * AVG_BLOCK_CNT_PER_SEGMENT,
+                                       "FlashCacheIdx", "FlashCacheIdx"))) {
+    LOG_WARN("fail to create index map", K(ret), K_(segment_cnt));
+  } else if (OB_FAIL(invalid_macro_ids_.create(INVALIDATE_BATCH_CNT * 2, "FlashCacheInv", "FlashCacheInv"))) {
+    LOG_WARN("fail to create invalid macro id set", K(ret));
+  } else if (OB_FAIL(cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    LOG_WARN("fail to init thread cond", K(ret));
+  } else if (OB_FAIL(open_file(file_path, file_size))) {
+    LOG_WARN("fail to open flash cache file", K(ret), K(file_path), K(file_size));
+  } else if (OB_FAIL(load_segments())) {
+    LOG_WARN("fail to load segments", K(ret), K(file_path));
+  } else {
+    lib::ThreadPool::set_thread_count(1);
+    is_inited_ = true;
+    LOG_INFO("flash cache inited", K(file_path), K(file_size), K_(segment_cnt),
+             K_(max_seq), "block_cnt", index_map_.size());
+  }
+  if (OB_FAIL(ret)) {
+    destroy();
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::open_file(const char *file_path, const int64_t file_size)
+{
+  int ret = OB_SUCCESS;
+  struct stat st;
+  if (OB_UNLIKELY((fd_ = ::open(file_path, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR)) < 0)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to open file", K(ret), K(file_path), K(errno));
+  } else if (OB_UNLIKELY(0 != ::fstat(fd_, &st))) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to stat file", K(ret), K(file_path), K(errno));
+  } else if (st.st_size < file_size && 0 != ::ftruncate(fd_, file_size)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to extend file", K(ret), K(file_path), K(file_size), K(errno));
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::load_segments()
+{
+  int ret = OB_SUCCESS;
+  int64_t last_segment_idx = -1;
+  for (int64_t i = 0; OB_SUCC(ret) && i < segment_cnt_; ++i) {
+    int64_t seq = INVALID_SEQ;
+    if (OB_FAIL(load_segment(i, seq))) {
+      LOG_WARN("fail to load segment", K(ret), K(i));
+    } else {
+      segment_seqs_[i] = seq;
+      if (seq > max_seq_) {
+        max_seq_ = seq;
+        last_segment_idx = i;
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    // continue writing after the latest segment, the ring is overwritten from the oldest
+    next_segment_idx_ = (last_segment_idx + 1) % segment_cnt_;
+    // some macro blocks of the loaded entries may have been freed before restart
+    need_check_loaded_blocks_ = index_map_.size() > 0;
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::load_segment(const int64_t segment_idx, int64_t &seq)
+{
+  int ret = OB_SUCCESS;
+  seq = INVALID_SEQ;
+  if (OB_FAIL(pread_all(meta_buf_, SEGMENT_META_SIZE, get_segment_offset(segment_idx)))) {
+    LOG_WARN("fail to read segment meta", K(ret), K(segment_idx));
+  } else if (!check_segment_meta(meta_buf_)) {
+    // never written or torn, reused as empty
+  } else {
+    const SegmentHeader *header = reinterpret_cast<const SegmentHeader *>(meta_buf_);
+    const SegmentEntry *entries = reinterpret_cast<const SegmentEntry *>(meta_buf_ + sizeof(SegmentHeader));
+    for (int64_t i = 0; OB_SUCC(ret) && i < header->entry_cnt_; ++i) {
+      const Key key(entries[i].block_id_);
+      Location loc;
+      if (OB_FAIL(index_map_.get_refactored(key, loc))) {
+        if (OB_HASH_NOT_EXIST == ret) {
+          ret = OB_SUCCESS;
+        } else {
+          LOG_WARN("fail to get location", K(ret), K(key));
+        }
+      } else if (loc.seq_ > header->seq_) {
+        // keep the newer copy
+        continue;
+      }
+      if (OB_SUCC(ret)) {
+        loc.segment_idx_ = segment_idx;
+        loc.seq_ = header->seq_;
+        loc.data_offset_ = entries[i].data_offset_;
+        loc.checksum_ = entries[i].checksum_;
+        if (OB_FAIL(index_map_.set_refactored(key, loc, 1/*overwrite*/))) {
+          LOG_WARN("fail to set location", K(ret), K(key), K(loc));
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      seq = header->seq_;
+    }
+  }
+  return ret;
+}
+
+bool ObMicroBlockFlashCache::check_segment_meta(const char *meta_buf) const
+{
+  bool is_valid = false;
+  const SegmentHeader *header = reinterpret_cast<const SegmentHeader *>(meta_buf);
+  if (SEGMENT_MAGIC == header->magic_
+      && SEGMENT_VERSION == header->version_
+      && header->seq_ > INVALID_SEQ
+      && header->entry_cnt_ > 0
+      && header->entry_cnt_ <= MAX_ENTRY_CNT
+      && header->data_size_ > 0
+      && header->data_size_ <= MAX_BLOCK_SIZE) {
+    const int64_t entries_size = header->entry_cnt_ * static_cast<int64_t>(sizeof(SegmentEntry));
+    is_valid = header->checksum_ == static_cast<int64_t>(ob_crc64(meta_buf + sizeof(SegmentHeader), entries_size));
+  }
+  return is_valid;
+}
+
+int ObMicroBlockFlashCache::start()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("flash cache not init", K(ret));
+  } else if (OB_FAIL(lib::ThreadPool::start())) {
+    LOG_WARN("fail to start flash cache thread", K(ret));
+  }
+  return ret;
+}
+
+void ObMicroBlockFlashCache::stop()
+{
+  if (is_inited_) {
+    lib::ThreadPool::stop();
+    ObThreadCondGuard guard(cond_);
+    cond_.signal();
+  }
+}
+
+void ObMicroBlockFlashCache::wait()
+{
+  if (is_inited_) {
+    lib::ThreadPool::wait();
+  }
+}
+
+void ObMicroBlockFlashCache::destroy()
+{
+  stop();
+  wait();
+  ATOMIC_STORE(&is_inited_, false);
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  index_map_.destroy();
+  invalid_macro_ids_.destroy();
+  cond_.destroy();
+  if (nullptr != segment_seqs_) {
+    ob_free(segment_seqs_);
+    segment_seqs_ = nullptr;
+  }
+  if (nullptr != meta_buf_) {
+    ob_free(meta_buf_);
+    meta_buf_ = nullptr;
+  }
+  if (nullptr != active_segment_.buf_) {
+    ob_free(active_segment_.buf_);
+    active_segment_.buf_ = nullptr;
+  }
+  if (nullptr != flushing_segment_.buf_) {
+    ob_free(flushing_segment_.buf_);
+    flushing_segment_.buf_ = nullptr;
+  }
+  active_segment_.reuse();
+  flushing_segment_.reuse();
+  flush_pending_ = false;
+  segment_cnt_ = 0;
+  next_segment_idx_ = 0;
+  max_seq_ = INVALID_SEQ;
+  need_check_loaded_blocks_ = false;
+}
+
+int ObMicroBlockFlashCache::put_block(const ObMicroBlockId &block_id, const char *buf)
+{
+  int ret = OB_SUCCESS;
+  const int64_t size = block_id.size_;
+  Location loc;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("flash cache not init", K(ret));
+  } else if (OB_UNLIKELY(!block_id.is_valid() || nullptr == buf)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid arguments", K(ret), K(block_id), KP(buf));
+  } else if (size > MAX_BLOCK_SIZE) {
+    // too large to cache
+  } else if (OB_SUCCESS == index_map_.get_refactored(Key(block_id), loc)) {
+    // already cached
+  } else {
+    bool is_dropped = false;
+    {
+      ObThreadCondGuard guard(cond_);
+      if (!active_segment_.can_hold(size)) {
+        if (flush_pending_) {
+          is_dropped = true;
+        } else {
+          // seal the active segment and hand it over to the background thread
+          StagingSegment tmp = flushing_segment_;
+          flushing_segment_ = active_segment_;
+          active_segment_ = tmp;
+          active_segment_.reuse();
+          flush_pending_ = true;
+          cond_.signal();
+        }
+      }
+      if (!is_dropped) {
+        SegmentEntry &entry = active_segment_.get_entries()[active_segment_.entry_cnt_++];
+        entry.block_id_ = block_id;
+        entry.data_offset_ = SEGMENT_META_SIZE + active_segment_.data_size_;
+        entry.checksum_ = static_cast<int64_t>(ob_crc64(buf, size));
+        MEMCPY(active_segment_.buf_ + entry.data_offset_, buf, size);
+        active_segment_.data_size_ += size;
+      }
+    }
+    if (is_dropped) {
+      EVENT_INC(ObStatEventIds::MICRO_BLOCK_FLASH_CACHE_PUT_DROP_COUNT);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::get_block(const ObMicroBlockId &block_id, char *buf)
+{
+  int ret = OB_SUCCESS;
+  Location loc;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else if (OB_UNLIKELY(!block_id.is_valid() || nullptr == buf)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid arguments", K(ret), K(block_id), KP(buf));
+  } else if (OB_FAIL(index_map_.get_refactored(Key(block_id), loc))) {
+    if (OB_HASH_NOT_EXIST == ret) {
+      ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      LOG_WARN("fail to get location", K(ret), K(block_id));
+    }
+  } else if (loc.seq_ != ATOMIC_LOAD(&segment_seqs_[loc.segment_idx_])) {
+    // segment is being overwritten
+    ret = OB_ENTRY_NOT_EXIST;
+  } else if (OB_FAIL(pread_all(buf, block_id.size_, get_segment_offset(loc.segment_idx_) + loc.data_offset_))) {
+    LOG_WARN("fail to read micro block", K(ret), K(block_id), K(loc));
+  } else if (loc.seq_ != ATOMIC_LOAD(&segment_seqs_[loc.segment_idx_])) {
+    // segment was overwritten during the read
+    ret = OB_ENTRY_NOT_EXIST;
+  } else if (OB_UNLIKELY(loc.checksum_ != static_cast<int64_t>(ob_crc64(buf, block_id.size_)))) {
+    ret = OB_CHECKSUM_ERROR;
+    LOG_WARN("flash cached micro block is corrupted", K(ret), K(block_id), K(loc));
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(index_map_.erase_refactored(Key(block_id)))) {
+      LOG_WARN("fail to erase corrupted block", K(tmp_ret), K(block_id));
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockFlashCache::invalidate_macro_block(const MacroBlockId &macro_id)
+{
+  int ret = OB_SUCCESS;
+  if (is_enabled() && invalid_macro_ids_.size() < INVALIDATE_BATCH_CNT * 2) {
+    // entries left behind when the set is full are overwritten with their segment
+    if (OB_FAIL(invalid_macro_ids_.set_refactored(macro_id))) {
+      LOG_WARN("fail to add invalid macro block", K(ret), K(macro_id));
+    }
+  }
+}
+
+void ObMicroBlockFlashCache::run1()
+{
+  int ret = OB_SUCCESS;
+  lib::set_thread_name("FlashCacheFlush");
+  while (!has_set_stop()) {
+    bool need_flush = false;
+    {
+      ObThreadCondGuard guard(cond_);
+      if (!flush_pending_ && !has_set_stop()) {
+        cond_.wait(FLUSH_WAIT_TIME_MS);
+      }
+      need_flush = flush_pending_;
+    }
+    if (need_flush) {
+      // the flushing segment is only touched by this thread until flush_pending_ is reset
+      if (OB_FAIL(flush_segment(flushing_segment_))) {
+        LOG_WARN("fail to flush segment", K(ret), K_(flushing_segment));
+      }
+      ObThreadCondGuard guard(cond_);
+      flushing_segment_.reuse();
+      flush_pending_ = false;
+    }
+    if (OB_FAIL(purge_invalid_macro_blocks())) {
+      LOG_WARN("fail to purge invalid macro blocks", K(ret));
+    }
+    // the macro blocks in use are known after the block manager finishes replay and first mark
+    if (need_check_loaded_blocks_ && OB_SERVER_BLOCK_MGR.is_mark_sweep_enabled()) {
+      if (OB_FAIL(purge_freed_macro_blocks())) {
+        LOG_WARN("fail to purge freed macro blocks", K(ret));
+      } else {
+        need_check_loaded_blocks_ = false;
+      }
+    }
+  }
+}
+
+int ObMicroBlockFlashCache::flush_segment(StagingSegment &segment)
+{
+  int ret = OB_SUCCESS;
+  const int64_t segment_idx = next_segment_idx_;
+  const int64_t seq = max_seq_ + 1;
+  const int64_t entries_size = segment.entry_cnt_ * static_cast<int64_t>(sizeof(SegmentEntry));
+  const int64_t write_size = SEGMENT_META_SIZE + segment.data_size_;
+  SegmentHeader *header = segment.get_header();
+  const SegmentEntry *entries = segment.get_entries();
+  if (segment.is_empty()) {
+    // do nothing
+  } else if (FALSE_IT(ATOMIC_STORE(&segment_seqs_[segment_idx], INVALID_SEQ))) {
+    // readers of the old blocks in this segment miss from now on
+  } else if (OB_FAIL(drop_segment_entries(segment_idx))) {
+    LOG_WARN("fail to drop segment entries", K(ret), K(segment_idx));
+  } else {
+    header->magic_ = SEGMENT_MAGIC;
+    header->version_ = SEGMENT_VERSION;
+    header->seq_ = seq;
+    header->entry_cnt_ = segment.entry_cnt_;
+    header->data_size_ = segment.data_size_;
+    header->checksum_ = static_cast<int64_t>(ob_crc64(entries, entries_size));
+    if (OB_FAIL(pwrite_all(segment.buf_, write_size, get_segment_offset(segment_idx)))) {
+      LOG_WARN("fail to write segment", K(ret), K(segment_idx), K(write_size));
+    } else {
+      // cached blocks are read rarely, keep them out of page cache
+      (void)::posix_fadvise(fd_, get_segment_offset(segment_idx), write_size, POSIX_FADV_DONTNEED);
+      EVENT_ADD(ObStatEventIds::MICRO_BLOCK_FLASH_CACHE_WRITE_SIZE, write_size);
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < segment.entry_cnt_; ++i) {
+      Location loc;
+      loc.segment_idx_ = segment_idx;
+      loc.seq_ = seq;
+      loc.data_offset_ = entries[i].data_offset_;
+      loc.checksum_ = entries[i].checksum_;
+      if (OB_FAIL(index_map_.set_refactored(Key(entries[i].block_id_), loc, 1/*overwrite*/))) {
+        LOG_WARN("fail to set location", K(ret), K(loc));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      max_seq_ = seq;
+      ATOMIC_STORE(&segment_seqs_[segment_idx], seq);
+    }
+    next_segment_idx_ = (segment_idx + 1) % segment_cnt_;
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::drop_segment_entries(const int64_t segment_idx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(pread_all(meta_buf_, SEGMENT_META_SIZE, get_segment_offset(segment_idx)))) {
+    LOG_WARN("fail to read segment meta", K(ret), K(segment_idx));
+  } else if (!check_segment_meta(meta_buf_)) {
+    // empty segment
+  } else {
+    const SegmentHeader *header = reinterpret_cast<const SegmentHeader *>(meta_buf_);
+    const SegmentEntry *entries = reinterpret_cast<const SegmentEntry *>(meta_buf_ + sizeof(SegmentHeader));
+    for (int64_t i = 0; OB_SUCC(ret) && i < header->entry_cnt_; ++i) {
+      const Key key(entries[i].block_id_);
+      Location loc;
+      if (OB_FAIL(index_map_.get_refactored(key, loc))) {
+        if (OB_HASH_NOT_EXIST == ret) {
+          ret = OB_SUCCESS;
+        } else {
+          LOG_WARN("fail to get location", K(ret), K(key));
+        }
+      } else if (loc.segment_idx_ != segment_idx) {
+        // cached again in another segment
+      } else if (OB_FAIL(index_map_.erase_refactored(key))) {
+        if (OB_HASH_NOT_EXIST == ret) {
+          ret = OB_SUCCESS;
+        } else {
+          LOG_WARN("fail to erase location", K(ret), K(key));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::PurgeOp::operator()(hash::HashMapPair<Key, Location> &entry)
+{
+  int ret = OB_SUCCESS;
+  if (OB_HASH_EXIST == macro_ids_.exist_refactored(entry.first.block_id_.macro_id_)) {
+    if (OB_FAIL(keys_.push_back(entry.first))) {
+      LOG_WARN("fail to push back key", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::purge_invalid_macro_blocks()
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<Key, 64> keys;
+  PurgeOp op(invalid_macro_ids_, keys);
+  if (invalid_macro_ids_.size() < INVALIDATE_BATCH_CNT) {
+    // wait for more freed macro blocks, a scan of index is expensive
+  } else if (OB_FAIL(index_map_.foreach_refactored(op))) {
+    LOG_WARN("fail to collect entries of invalid macro blocks", K(ret));
+  } else {
+    // ids added during the scan are dropped too, their entries are overwritten with the segments
+    invalid_macro_ids_.clear();
+    for (int64_t i = 0; i < keys.count(); ++i) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(index_map_.erase_refactored(keys.at(i)))) {
+        if (OB_HASH_NOT_EXIST != tmp_ret) {
+          LOG_WARN("fail to erase location", K(tmp_ret), K(keys.at(i)));
+        }
+      }
+    }
+    LOG_INFO("purge invalid macro blocks from flash cache", "purged_cnt", keys.count());
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::PurgeFreedOp::operator()(hash::HashMapPair<Key, Location> &entry)
+{
+  int ret = OB_SUCCESS;
+  bool is_free = false;
+  if (OB_FAIL(OB_SERVER_BLOCK_MGR.check_macro_block_free(entry.first.block_id_.macro_id_, is_free))) {
+    LOG_WARN("fail to check macro block free", K(ret), K(entry.first));
+  } else if (is_free && OB_FAIL(keys_.push_back(entry.first))) {
+    LOG_WARN("fail to push back key", K(ret));
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::purge_freed_macro_blocks()
+{
+  int ret = OB_SUCCESS;
+  ObArray<Key> keys;
+  PurgeFreedOp op(keys);
+  if (OB_FAIL(index_map_.foreach_refactored(op))) {
+    LOG_WARN("fail to collect entries of freed macro blocks", K(ret));
+  } else {
+    for (int64_t i = 0; i < keys.count(); ++i) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(index_map_.erase_refactored(keys.at(i)))) {
+        if (OB_HASH_NOT_EXIST != tmp_ret) {
+          LOG_WARN("fail to erase location", K(tmp_ret), K(keys.at(i)));
+        }
+      }
+    }
+    LOG_INFO("purge freed macro blocks from flash cache", "purged_cnt", keys.count(),
+             "block_cnt", index_map_.size());
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::pread_all(char *buf, const int64_t size, const int64_t offset)
+{
+  int ret = OB_SUCCESS;
+  int64_t read_size = 0;
+  while (OB_SUCC(ret) && read_size < size) {
+    const ssize_t n = ::pread(fd_, buf + read_size, size - read_size, offset + read_size);
+    if (n > 0) {
+      read_size += n;
+    } else if (0 == n) {
+      // beyond the end of file, read as zero
+      MEMSET(buf + read_size, 0, size - read_size);
+      read_size = size;
+    } else if (EINTR != errno) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to pread", K(ret), K(size), K(offset), K(read_size), K(errno));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockFlashCache::pwrite_all(const char *buf, const int64_t size, const int64_t offset)
+{
+  int ret = OB_SUCCESS;
+  int64_t write_size = 0;
+  while (OB_SUCC(ret) && write_size < size) {
+    const ssize_t n = ::pwrite(fd_, buf + write_size, size - write_size, offset + write_size);
+    if (n >= 0) {
+      write_size += n;
+    } else if (EINTR != errno) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to pwrite", K(ret), K(size), K(offset), K(write_size), K(errno));
+    }
+  }
+  return ret;
+}
+
+}//end namespace blocksstable
+}//end namespace oceanbase
@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_BLOCKSSTABLE_OB_MICRO_BLOCK_FLASH_CACHE_H_
+#define OCEANBASE_BLOCKSSTABLE_OB_MICRO_BLOCK_FLASH_CACHE_H_
+
+#include "lib/hash/ob_hashmap.h"
+#include "lib/hash/ob_hashset.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "lib/thread/thread_pool.h"
+#include "storage/blocksstable/ob_block_sstable_struct.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// Micro block cache on a local flash device, the tier below the memory block caches for the
+// deployments whose data files are on HDD.
+//
+// The cache file is a ring of fixed size segments. Micro blocks are staged in memory as stored
+// on disk (compressed, and encrypted if so), and a full staging segment is written by the
+// background thread with one large IO over the oldest segment of the ring, so the device only
+// sees sequential writes. The index from micro block id to its location in the file is kept in
+// memory and rebuilt from the segment metas on restart. Blocks read from the file are verified
+// by checksum, a torn or stale segment only causes cache misses.
+//
+// Blocks are keyed by macro block id which contains the write sequence, so a reused macro block
+// never hits the blocks cached before. The entries of freed macro blocks are purged from the
+// index in batch by the background thread. The macro blocks freed before restart are not known
+// when the index is loaded, so the loaded entries are checked against the block manager once it
+// finishes replay.
+class ObMicroBlockFlashCache : public lib::ThreadPool
+{
+public:
+  static const int64_t SEGMENT_SIZE = 8L << 20; // 8MB
+  static const int64_t SEGMENT_META_SIZE = 128L << 10; // 128KB
+  static const int64_t MAX_BLOCK_SIZE = SEGMENT_SIZE - SEGMENT_META_SIZE;
+  static const int64_t MIN_SEGMENT_CNT = 4;
+  static const int64_t AVG_BLOCK_CNT_PER_SEGMENT = 256;
+  static const int64_t INVALIDATE_BATCH_CNT = 1024;
+  static const int64_t FLUSH_WAIT_TIME_MS = 1000;
+  static const int64_t SEGMENT_MAGIC = 0x4653454D; // "FSEM"
+  static const int64_t SEGMENT_VERSION = 1;
+  static const int64_t INVALID_SEQ = 0;
+
+  struct SegmentHeader
+  {
+    int64_t magic_;
+    int64_t version_;
+    int64_t seq_;
+    int64_t entry_cnt_;
+    int64_t data_size_;
+    int64_t checksum_; // of the entries
+  };
+
+  struct SegmentEntry
+  {
+    ObMicroBlockId block_id_;
+    int64_t data_offset_; // from the start of segment
+    int64_t checksum_; // of the block
+  };
+
+  static const int64_t MAX_ENTRY_CNT =
+      (SEGMENT_META_SIZE - static_cast<int64_t>(sizeof(SegmentHeader))) / static_cast<int64_t>(sizeof(SegmentEntry));
+
+  struct Key
+  {
+    Key() : block_id_() {}
+    explicit Key(const ObMicroBlockId &block_id) : block_id_(block_id) {}
+    inline uint64_t hash() const
+    {
+      uint64_t hash_val = block_id_.macro_id_.hash();
+      hash_val = common::murmurhash(&block_id_.offset_, sizeof(block_id_.offset_), hash_val);
+      return hash_val;
+    }
+    inline int hash(uint64_t &hash_val) const { hash_val = hash(); return common::OB_SUCCESS; }
+    inline bool operator ==(const Key &other) const { return block_id_ == other.block_id_; }
+    TO_STRING_KV(K_(block_id));
+    ObMicroBlockId block_id_;
+  };
+
+  struct Location
+  {
+    Location() : segment_idx_(0), seq_(INVALID_SEQ), data_offset_(0), checksum_(0) {}
+    TO_STRING_KV(K_(segment_idx), K_(seq), K_(data_offset), K_(checksum));
+    int64_t segment_idx_;
+    int64_t seq_;
+    int64_t data_offset_;
+    int64_t checksum_;
+  };
+
+  // Segment being filled in memory, laid out as in file.
+  struct StagingSegment
+  {
+    StagingSegment() : buf_(nullptr), entry_cnt_(0), data_size_(0) {}
+    inline void reuse() { entry_cnt_ = 0; data_size_ = 0; }
+    inline bool is_empty() const { return 0 == entry_cnt_; }
+    inline bool can_hold(const int64_t size) const
+    {
+      return entry_cnt_ < MAX_ENTRY_CNT && data_size_ + size <= MAX_BLOCK_SIZE;
+    }
+    inline SegmentHeader *get_header() { return reinterpret_cast<SegmentHeader *>(buf_); }
+    inline SegmentEntry *get_entries() { return reinterpret_cast<SegmentEntry *>(buf_ + sizeof(SegmentHeader)); }
+    TO_STRING_KV(KP_(buf), K_(entry_cnt), K_(data_size));
+    char *buf_;
+    int64_t entry_cnt_;
+    int64_t data_size_;
+  };
+
+  typedef common::hash::ObHashMap<Key, Location> IndexMap;
+  typedef common::hash::ObHashSet<MacroBlockId> MacroIdSet;
+
+public:
+  ObMicroBlockFlashCache();
+  virtual ~ObMicroBlockFlashCache();
+  // the file is created if not exist, blocks cached before restart are loaded
+  int init(const char *file_path, const int64_t file_size);
+  int start();
+  void stop();
+  void wait();
+  void destroy();
+  inline bool is_enabled() const { return ATOMIC_LOAD(&is_inited_); }
+  // Stage the micro block read from disk, the block is dropped if the background thread falls
+  // behind since this is only a cache.
+  int put_block(const ObMicroBlockId &block_id, const char *buf);
+  // Read the micro block into %buf of %block_id.size_ bytes, OB_ENTRY_NOT_EXIST if not cached.
+  int get_block(const ObMicroBlockId &block_id, char *buf);
+  void invalidate_macro_block(const MacroBlockId &macro_id);
+  virtual void run1() override;
+  TO_STRING_KV(K_(is_inited), K_(fd), K_(segment_cnt), K_(next_segment_idx), K_(max_seq),
+               K_(need_check_loaded_blocks), K_(flush_pending), K_(active_segment), K_(flushing_segment));
+
+private:
+  struct PurgeOp
+  {
+    PurgeOp(MacroIdSet &macro_ids, common::ObIArray<Key> &keys) : macro_ids_(macro_ids), keys_(keys) {}
+    int operator()(common::hash::HashMapPair<Key, Location> &entry);
+    MacroIdSet &macro_ids_;
+    common::ObIArray<Key> &keys_;
+  };
+  struct PurgeFreedOp
+  {
+    explicit PurgeFreedOp(common::ObIArray<Key> &keys) : keys_(keys) {}
+    int operator()(common::hash::HashMapPair<Key, Location> &entry);
+    common::ObIArray<Key> &keys_;
+  };
+
+  int open_file(const char *file_path, const int64_t file_size);
+  int load_segments();
+  int load_segment(const int64_t segment_idx, int64_t &seq);
+  bool check_segment_meta(const char *meta_buf) const;
+  int flush_segment(StagingSegment &segment);
+  int drop_segment_entries(const int64_t segment_idx);
+  int purge_invalid_macro_blocks();
+  // drop the entries whose macro blocks are not in use, for the entries loaded on restart
+  int purge_freed_macro_blocks();
+  int pread_all(char *buf, const int64_t size, const int64_t offset);
+  int pwrite_all(const char *buf, const int64_t size, const int64_t offset);
+  inline int64_t get_segment_offset(const int64_t segment_idx) const { return segment_idx * SEGMENT_SIZE; }
+
+private:
+  bool is_inited_;
+  int fd_;
+  int64_t segment_cnt_;
+  int64_t *segment_seqs_; // INVALID_SEQ while the segment is being rewritten
+  int64_t next_segment_idx_;
+  int64_t max_seq_;
+  bool need_check_loaded_blocks_;
+  char *meta_buf_; // for reading the meta of segment to overwrite
+  IndexMap index_map_;
+  MacroIdSet invalid_macro_ids_;
+  common::ObThreadCond cond_; // protects the staging segments
+  bool flush_pending_;
+  StagingSegment active_segment_;
+  StagingSegment flushing_segment_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockFlashCache);
+};
+
+}//end namespace blocksstable
+}//end namespace oceanbase
+
+#endif //OCEANBASE_BLOCKSSTABLE_OB_MICRO_BLOCK_FLASH_CACHE_H_
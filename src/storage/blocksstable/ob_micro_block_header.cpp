@@ -27,7 +27,7 @@ ObMicroBlockHeader::ObMicroBlockHeader()
     header_checksum_(0),
     column_count_(0),
     has_column_checksum_(0),
-    reserved16_(0),
+    has_compress_dict_(0),
     row_count_(0),
     row_store_type_(common::MAX_ROW_STORE),
     opt_(0),
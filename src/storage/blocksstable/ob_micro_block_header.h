@@ -14,6 +14,7 @@
 #define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_H_
 #include "stdint.h"
 #include  "lib/utility/ob_print_utils.h"
+#include "common/ob_store_format.h"
 namespace oceanbase
 {
 namespace blocksstable
@@ -35,7 +36,7 @@ public:
     uint16_t contains_hash_index_   : 1;
     uint16_t hash_index_offset_from_end_ : 10;
     uint16_t has_min_merged_trans_version_   : 1;
-    uint16_t reserved16_          : 1;
+    uint16_t has_compress_dict_   : 1; // compressed with the compress dict of macro block
   };
   uint32_t row_count_;
   uint8_t row_store_type_;
@@ -57,7 +58,8 @@ public:
     uint16_t var_column_count_; // For pax encoding format
     struct { // For cs encoding format
       uint8_t compressor_type_;
-      uint8_t cs_reserved_;
+      uint8_t has_shared_dict_ : 1; // some columns reference the shared dict of macro block
+      uint8_t cs_reserved_ : 7;
     };
     uint16_t opt2_;
   };
@@ -113,6 +115,13 @@ public:
   bool contain_uncommitted_rows() const { return contain_uncommitted_rows_; }
   OB_INLINE bool has_string_out_row() const { return has_string_out_row_; }
   OB_INLINE bool has_lob_out_row() const { return !all_lob_in_row_; }
+  OB_INLINE bool has_shared_dict() const
+  {
+    return common::ObStoreFormat::is_row_store_type_with_cs_encoding(
+        static_cast<common::ObRowStoreType>(row_store_type_))
+        && has_shared_dict_;
+  }
+  OB_INLINE bool has_compress_dict() const { return has_compress_dict_; }
   bool is_last_row_last_flag() const { return is_last_row_last_flag_; }
   bool is_contain_hash_index() const;
 }__attribute__((packed));
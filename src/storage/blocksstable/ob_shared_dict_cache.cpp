@@ -0,0 +1,357 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_shared_dict_cache.h"
+#include "lib/allocator/page_arena.h"
+#include "share/config/ob_server_config.h"
+#include "storage/blocksstable/ob_block_manager.h"
+#include "storage/blocksstable/ob_macro_block_common_header.h"
+#include "storage/blocksstable/ob_macro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_header.h"
+#include "storage/blocksstable/ob_sstable_macro_block_header.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+namespace
+{
+// large enough for the macro block header of a table with max column count
+const int64_t MACRO_HEADER_READ_SIZE = 128L << 10;
+
+int read_macro_block(
+    const MacroBlockId &macro_id,
+    const int64_t offset,
+    const int64_t size,
+    ObIAllocator &allocator,
+    const char *&buf)
+{
+  int ret = OB_SUCCESS;
+  ObMacroBlockHandle macro_handle;
+  ObMacroBlockReadInfo read_info;
+  buf = nullptr;
+  read_info.macro_block_id_ = macro_id;
+  read_info.offset_ = offset;
+  read_info.size_ = size;
+  read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+  read_info.io_desc_.set_resource_group_id(THIS_WORKER.get_group_id());
+  read_info.io_desc_.set_sys_module_id(ObIOModule::MICRO_BLOCK_CACHE_IO);
+  read_info.io_timeout_ms_ = GCONF._data_storage_io_timeout / 1000L;
+  if (OB_ISNULL(read_info.buf_ = static_cast<char *>(allocator.alloc(size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc read buffer", K(ret), K(size));
+  } else if (OB_FAIL(ObBlockManager::read_block(read_info, macro_handle))) {
+    LOG_WARN("fail to read macro block", K(ret), K(read_info));
+  } else if (OB_UNLIKELY(macro_handle.get_data_size() < size)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected read size", K(ret), K(size), K(macro_handle));
+  } else {
+    buf = read_info.buf_;
+  }
+  return ret;
+}
+
+// %macro_header references the buffer allocated from %allocator
+int read_macro_header(
+    const MacroBlockId &macro_id,
+    ObIAllocator &allocator,
+    ObSSTableMacroBlockHeader &macro_header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t header_read_size = MIN(MACRO_HEADER_READ_SIZE, OB_SERVER_BLOCK_MGR.get_macro_block_size());
+  const char *header_buf = nullptr;
+  ObMacroBlockCommonHeader common_header;
+  int64_t pos = 0;
+  if (OB_FAIL(read_macro_block(macro_id, 0, header_read_size, allocator, header_buf))) {
+    LOG_WARN("fail to read macro block header", K(ret), K(macro_id));
+  } else if (OB_FAIL(common_header.deserialize(header_buf, header_read_size, pos))) {
+    LOG_WARN("fail to deserialize common header", K(ret), K(macro_id));
+  } else if (OB_FAIL(common_header.check_integrity())) {
+    LOG_ERROR("invalid common header", K(ret), K(common_header), K(macro_id));
+  } else if (OB_UNLIKELY(!common_header.is_sstable_data_block())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected macro block type", K(ret), K(common_header), K(macro_id));
+  } else if (OB_FAIL(macro_header.deserialize(header_buf, header_read_size, pos))) {
+    LOG_WARN("fail to deserialize macro block header", K(ret), K(macro_id));
+  }
+  return ret;
+}
+} // namespace
+
+/**
+ * -----------------------------------------------------ObSharedDictCacheKey------------------------------------------------------
+ */
+ObSharedDictCacheKey::ObSharedDictCacheKey()
+  : tenant_id_(OB_INVALID_TENANT_ID), macro_id_()
+{
+}
+
+ObSharedDictCacheKey::ObSharedDictCacheKey(const uint64_t tenant_id, const MacroBlockId &macro_id)
+  : tenant_id_(tenant_id), macro_id_(macro_id)
+{
+}
+
+int ObSharedDictCacheKey::equal(const ObIKVCacheKey &other, bool &equal) const
+{
+  int ret = OB_SUCCESS;
+  const ObSharedDictCacheKey &other_key = reinterpret_cast<const ObSharedDictCacheKey &>(other);
+  equal = tenant_id_ == other_key.tenant_id_ && macro_id_ == other_key.macro_id_;
+  return ret;
+}
+
+int ObSharedDictCacheKey::hash(uint64_t &hash_value) const
+{
+  int ret = OB_SUCCESS;
+  hash_value = murmurhash(&tenant_id_, sizeof(tenant_id_), macro_id_.hash());
+  return ret;
+}
+
+int ObSharedDictCacheKey::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheKey *&key) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(buf_len));
+  } else if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid shared dict cache key", K(ret), K(*this));
+  } else {
+    key = new (buf) ObSharedDictCacheKey(tenant_id_, macro_id_);
+  }
+  return ret;
+}
+
+/**
+ * -----------------------------------------------------ObSharedDictCacheValue------------------------------------------------------
+ */
+ObSharedDictCacheValue::ObSharedDictCacheValue()
+  : buf_(nullptr), size_(0), reader_()
+{
+}
+
+int ObSharedDictCacheValue::init(const char *buf, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  reader_.reset();
+  if (OB_ISNULL(buf) || OB_UNLIKELY(size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(size));
+  } else if (OB_FAIL(reader_.init(buf, size))) {
+    LOG_WARN("fail to init shared dict reader", K(ret), K(size));
+  } else {
+    buf_ = buf;
+    size_ = size;
+  }
+  return ret;
+}
+
+int ObSharedDictCacheValue::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const
+{
+  int ret = OB_SUCCESS;
+  ObSharedDictCacheValue *pvalue = nullptr;
+  if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(buf_len));
+  } else if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid shared dict cache value", K(ret), K(*this));
+  } else if (FALSE_IT(pvalue = new (buf) ObSharedDictCacheValue())) {
+  } else if (FALSE_IT(MEMCPY(buf + sizeof(*this), buf_, size_))) {
+  } else if (OB_FAIL(pvalue->init(buf + sizeof(*this), size_))) {
+    LOG_WARN("fail to init shared dict cache value", K(ret), K_(size));
+    pvalue->~ObSharedDictCacheValue();
+  } else {
+    value = pvalue;
+  }
+  return ret;
+}
+
+/**
+ * -----------------------------------------------------ObSharedDictCache------------------------------------------------------
+ */
+int ObSharedDictCache::get_or_load_shared_dict(
+    const uint64_t tenant_id,
+    const MacroBlockId &macro_id,
+    ObSharedDictValueHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  ObSharedDictCacheKey key(tenant_id, macro_id);
+  handle.reset();
+  if (OB_UNLIKELY(!key.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key));
+  } else if (OB_SUCC(get(key, handle.value_, handle.handle_))) {
+  } else if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
+    LOG_WARN("fail to get shared dict from cache", K(ret), K(key));
+  } else if (OB_FAIL(load_shared_dict(key, macro_id, handle))) {
+    LOG_WARN("fail to load shared dict", K(ret), K(key));
+  }
+  return ret;
+}
+
+int ObSharedDictCache::load_shared_dict(
+    const ObSharedDictCacheKey &key,
+    const MacroBlockId &macro_id,
+    ObSharedDictValueHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator allocator("SharedDictLoad", OB_MALLOC_NORMAL_BLOCK_SIZE, key.get_tenant_id());
+  const char *dict_buf = nullptr;
+  ObSSTableMacroBlockHeader macro_header;
+  ObSharedDictCacheValue value;
+  if (OB_FAIL(read_macro_header(macro_id, allocator, macro_header))) {
+    LOG_WARN("fail to read macro block header", K(ret), K(macro_id));
+  } else if (OB_UNLIKELY(!macro_header.has_shared_dict())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("macro block has no shared dict", K(ret), K(macro_header), K(macro_id));
+  } else if (OB_FAIL(read_macro_block(macro_id, macro_header.shared_dict_offset_,
+      macro_header.shared_dict_size_, allocator, dict_buf))) {
+    LOG_WARN("fail to read shared dict", K(ret), K(macro_header), K(macro_id));
+  } else if (OB_FAIL(value.init(dict_buf, macro_header.shared_dict_size_))) {
+    LOG_WARN("fail to init shared dict cache value", K(ret), K(macro_header), K(macro_id));
+  } else if (OB_FAIL(put_and_fetch(key, value, handle.value_, handle.handle_, false/*overwrite*/))) {
+    if (OB_ENTRY_EXIST != ret) {
+      LOG_WARN("fail to put shared dict into cache", K(ret), K(key));
+    } else if (OB_FAIL(get(key, handle.value_, handle.handle_))) {
+      LOG_WARN("fail to get shared dict from cache", K(ret), K(key));
+    }
+  }
+  return ret;
+}
+
+/**
+ * -----------------------------------------------------ObCompressDictCacheValue------------------------------------------------------
+ */
+ObCompressDictCacheValue::ObCompressDictCacheValue()
+  : buf_(nullptr), size_(0)
+{
+}
+
+int ObCompressDictCacheValue::init(const char *buf, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(buf) || OB_UNLIKELY(size <= 0 || size > INT32_MAX)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(size));
+  } else {
+    buf_ = buf;
+    size_ = size;
+  }
+  return ret;
+}
+
+int ObCompressDictCacheValue::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const
+{
+  int ret = OB_SUCCESS;
+  ObCompressDictCacheValue *pvalue = nullptr;
+  if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(buf_len));
+  } else if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid compress dict cache value", K(ret), K(*this));
+  } else if (FALSE_IT(pvalue = new (buf) ObCompressDictCacheValue())) {
+  } else if (FALSE_IT(MEMCPY(buf + sizeof(*this), buf_, size_))) {
+  } else if (OB_FAIL(pvalue->init(buf + sizeof(*this), size_))) {
+    LOG_WARN("fail to init compress dict cache value", K(ret), K_(size));
+    pvalue->~ObCompressDictCacheValue();
+  } else {
+    value = pvalue;
+  }
+  return ret;
+}
+
+/**
+ * -----------------------------------------------------ObCompressDictCache------------------------------------------------------
+ */
+int ObCompressDictCache::get_or_load_compress_dict(
+    const uint64_t tenant_id,
+    const MacroBlockId &macro_id,
+    ObCompressDictValueHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  ObSharedDictCacheKey key(tenant_id, macro_id);
+  handle.reset();
+  if (OB_UNLIKELY(!key.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key));
+  } else if (OB_SUCC(get(key, handle.value_, handle.handle_))) {
+  } else if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
+    LOG_WARN("fail to get compress dict from cache", K(ret), K(key));
+  } else if (OB_FAIL(load_compress_dict(key, macro_id, handle))) {
+    LOG_WARN("fail to load compress dict", K(ret), K(key));
+  }
+  return ret;
+}
+
+int ObCompressDictCache::load_compress_dict(
+    const ObSharedDictCacheKey &key,
+    const MacroBlockId &macro_id,
+    ObCompressDictValueHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator allocator("CompDictLoad", OB_MALLOC_NORMAL_BLOCK_SIZE, key.get_tenant_id());
+  const char *dict_buf = nullptr;
+  ObSSTableMacroBlockHeader macro_header;
+  ObCompressDictCacheValue value;
+  if (OB_FAIL(read_macro_header(macro_id, allocator, macro_header))) {
+    LOG_WARN("fail to read macro block header", K(ret), K(macro_id));
+  } else if (OB_UNLIKELY(!macro_header.has_compress_dict())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("macro block has no compress dict", K(ret), K(macro_header), K(macro_id));
+  } else if (OB_FAIL(read_macro_block(macro_id, macro_header.compress_dict_offset_,
+      macro_header.compress_dict_size_, allocator, dict_buf))) {
+    LOG_WARN("fail to read compress dict", K(ret), K(macro_header), K(macro_id));
+  } else if (OB_FAIL(value.init(dict_buf, macro_header.compress_dict_size_))) {
+    LOG_WARN("fail to init compress dict cache value", K(ret), K(macro_header), K(macro_id));
+  } else if (OB_FAIL(put_and_fetch(key, value, handle.value_, handle.handle_, false/*overwrite*/))) {
+    if (OB_ENTRY_EXIST != ret) {
+      LOG_WARN("fail to put compress dict into cache", K(ret), K(key));
+    } else if (OB_FAIL(get(key, handle.value_, handle.handle_))) {
+      LOG_WARN("fail to get compress dict from cache", K(ret), K(key));
+    }
+  }
+  return ret;
+}
+
+/**
+ * -----------------------------------------------------ObCompressDictReaderGuard------------------------------------------------------
+ */
+ObCompressDictReaderGuard::~ObCompressDictReaderGuard()
+{
+  if (handle_.is_valid()) {
+    reader_.reset_compress_dict();
+  }
+}
+
+int ObCompressDictReaderGuard::prepare(
+    const ObMicroBlockHeader &header,
+    const uint64_t tenant_id,
+    const MacroBlockId &macro_id)
+{
+  int ret = OB_SUCCESS;
+  if (!header.has_compress_dict()) {
+  } else if (OB_FAIL(ObStorageCacheSuite::get_instance().get_compress_dict_cache().get_or_load_compress_dict(
+      tenant_id, macro_id, handle_))) {
+    LOG_WARN("fail to get compress dict", K(ret), K(tenant_id), K(macro_id));
+  } else {
+    reader_.set_compress_dict(handle_.get_dict());
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
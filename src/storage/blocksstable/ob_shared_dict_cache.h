@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_SHARED_DICT_CACHE_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_SHARED_DICT_CACHE_H_
+
+#include "share/cache/ob_kv_storecache.h"
+#include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "storage/blocksstable/cs_encoding/ob_cs_shared_dict.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+struct ObMicroBlockHeader;
+class ObMacroBlockReader;
+
+// Cache of the cs encoding shared dicts stored in data macro blocks, see ObCSSharedDictBuilder.
+class ObSharedDictCacheKey : public common::ObIKVCacheKey
+{
+public:
+  ObSharedDictCacheKey();
+  ObSharedDictCacheKey(const uint64_t tenant_id, const MacroBlockId &macro_id);
+  virtual ~ObSharedDictCacheKey() {}
+  virtual int equal(const ObIKVCacheKey &other, bool &equal) const override;
+  virtual int hash(uint64_t &hash_value) const override;
+  virtual uint64_t get_tenant_id() const override { return tenant_id_; }
+  virtual int64_t size() const override { return sizeof(*this); }
+  virtual int deep_copy(char *buf, const int64_t buf_len, ObIKVCacheKey *&key) const override;
+  bool is_valid() const { return common::OB_INVALID_TENANT_ID != tenant_id_ && macro_id_.is_valid(); }
+  TO_STRING_KV(K_(tenant_id), K_(macro_id));
+private:
+  uint64_t tenant_id_;
+  MacroBlockId macro_id_;
+  DISALLOW_COPY_AND_ASSIGN(ObSharedDictCacheKey);
+};
+
+class ObSharedDictCacheValue : public common::ObIKVCacheValue
+{
+public:
+  ObSharedDictCacheValue();
+  virtual ~ObSharedDictCacheValue() {}
+  // %buf is referenced until the value is deep copied into cache
+  int init(const char *buf, const int64_t size);
+  virtual int64_t size() const override { return sizeof(*this) + size_; }
+  virtual int deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const override;
+  bool is_valid() const { return nullptr != buf_ && size_ > 0 && reader_.is_inited(); }
+  const ObICSSharedDictProvider &get_shared_dict() const { return reader_; }
+  TO_STRING_KV(KP_(buf), K_(size), K_(reader));
+private:
+  const char *buf_;
+  int64_t size_;
+  ObCSSharedDictReader reader_;
+  DISALLOW_COPY_AND_ASSIGN(ObSharedDictCacheValue);
+};
+
+struct ObSharedDictValueHandle
+{
+  ObSharedDictValueHandle() : value_(nullptr), handle_() {}
+  ~ObSharedDictValueHandle() {}
+  inline bool is_valid() const { return nullptr != value_ && handle_.is_valid(); }
+  inline void reset() { value_ = nullptr; handle_.reset(); }
+  inline const ObICSSharedDictProvider *get_shared_dict() const
+  {
+    return nullptr == value_ ? nullptr : &value_->get_shared_dict();
+  }
+  TO_STRING_KV(KP_(value), K_(handle));
+  const ObSharedDictCacheValue *value_;
+  common::ObKVCacheHandle handle_;
+};
+
+class ObSharedDictCache : public common::ObKVCache<ObSharedDictCacheKey, ObSharedDictCacheValue>
+{
+public:
+  ObSharedDictCache() {}
+  virtual ~ObSharedDictCache() {}
+  // get the shared dict of data macro block %macro_id, load it with sync io if it is not in cache
+  int get_or_load_shared_dict(
+      const uint64_t tenant_id,
+      const MacroBlockId &macro_id,
+      ObSharedDictValueHandle &handle);
+private:
+  int load_shared_dict(
+      const ObSharedDictCacheKey &key,
+      const MacroBlockId &macro_id,
+      ObSharedDictValueHandle &handle);
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObSharedDictCache);
+};
+
+// Cache of the micro block compress dicts stored in data macro blocks, see
+// ObMicroBlockCompressDictBuilder, keyed by macro block as the shared dict cache.
+class ObCompressDictCacheValue : public common::ObIKVCacheValue
+{
+public:
+  ObCompressDictCacheValue();
+  virtual ~ObCompressDictCacheValue() {}
+  // %buf is referenced until the value is deep copied into cache
+  int init(const char *buf, const int64_t size);
+  virtual int64_t size() const override { return sizeof(*this) + size_; }
+  virtual int deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const override;
+  bool is_valid() const { return nullptr != buf_ && size_ > 0; }
+  common::ObString get_dict() const { return common::ObString(static_cast<int32_t>(size_), buf_); }
+  TO_STRING_KV(KP_(buf), K_(size));
+private:
+  const char *buf_;
+  int64_t size_;
+  DISALLOW_COPY_AND_ASSIGN(ObCompressDictCacheValue);
+};
+
+struct ObCompressDictValueHandle
+{
+  ObCompressDictValueHandle() : value_(nullptr), handle_() {}
+  ~ObCompressDictValueHandle() {}
+  inline bool is_valid() const { return nullptr != value_ && handle_.is_valid(); }
+  inline void reset() { value_ = nullptr; handle_.reset(); }
+  inline common::ObString get_dict() const
+  {
+    return nullptr == value_ ? common::ObString() : value_->get_dict();
+  }
+  TO_STRING_KV(KP_(value), K_(handle));
+  const ObCompressDictCacheValue *value_;
+  common::ObKVCacheHandle handle_;
+};
+
+class ObCompressDictCache : public common::ObKVCache<ObSharedDictCacheKey, ObCompressDictCacheValue>
+{
+public:
+  ObCompressDictCache() {}
+  virtual ~ObCompressDictCache() {}
+  // get the compress dict of data macro block %macro_id, load it with sync io if it is not in cache
+  int get_or_load_compress_dict(
+      const uint64_t tenant_id,
+      const MacroBlockId &macro_id,
+      ObCompressDictValueHandle &handle);
+private:
+  int load_compress_dict(
+      const ObSharedDictCacheKey &key,
+      const MacroBlockId &macro_id,
+      ObCompressDictValueHandle &handle);
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObCompressDictCache);
+};
+
+// Pins the compress dict of a micro block in cache and sets it to the macro block reader
+// during decompression, the dict of the reader is reset when the guard is destructed.
+class ObCompressDictReaderGuard final
+{
+public:
+  explicit ObCompressDictReaderGuard(ObMacroBlockReader &reader) : reader_(reader), handle_() {}
+  ~ObCompressDictReaderGuard();
+  // do nothing if the micro block is not compressed with dict
+  int prepare(const ObMicroBlockHeader &header, const uint64_t tenant_id, const MacroBlockId &macro_id);
+private:
+  ObMacroBlockReader &reader_;
+  ObCompressDictValueHandle handle_;
+  DISALLOW_COPY_AND_ASSIGN(ObCompressDictReaderGuard);
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_SHARED_DICT_CACHE_H_
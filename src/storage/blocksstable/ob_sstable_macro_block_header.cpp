@@ -29,6 +29,12 @@ ObSSTableMacroBlockHeader::ObSSTableMacroBlockHeader()
     column_orders_(nullptr),
     column_checksum_(nullptr),
     is_normal_cg_(false),
+    with_shared_dict_(false),
+    shared_dict_offset_(0),
+    shared_dict_size_(0),
+    with_compress_dict_(false),
+    compress_dict_offset_(0),
+    compress_dict_size_(0),
     is_inited_(false)
 {
 }
@@ -45,6 +51,12 @@ void ObSSTableMacroBlockHeader::reset()
   column_orders_ = nullptr;
   column_checksum_ = nullptr;
   is_normal_cg_ = false;
+  with_shared_dict_ = false;
+  shared_dict_offset_ = 0;
+  shared_dict_size_ = 0;
+  with_compress_dict_ = false;
+  compress_dict_offset_ = 0;
+  compress_dict_size_ = 0;
   is_inited_ = false;
 }
 
@@ -54,7 +66,9 @@ int64_t ObSSTableMacroBlockHeader::to_string(char* buf, const int64_t buf_len) c
   if (OB_ISNULL(buf) || buf_len <= 0) {
   } else {
     J_OBJ_START();
-    J_KV(K_(fixed_header), KP_(column_types), KP_(column_orders), KP_(column_checksum), K_(is_normal_cg));
+    J_KV(K_(fixed_header), KP_(column_types), KP_(column_orders), KP_(column_checksum), K_(is_normal_cg),
+        K_(with_shared_dict), K_(shared_dict_offset), K_(shared_dict_size),
+        K_(with_compress_dict), K_(compress_dict_offset), K_(compress_dict_size));
     J_COMMA();
     J_NAME("column_checksum");
     J_COLON();
@@ -191,6 +205,18 @@ int ObSSTableMacroBlockHeader::serialize(char *buf, const int64_t buf_len, int64
     bool *is_normal_cg = reinterpret_cast<bool *>(buf + tmp_pos);
     *is_normal_cg = is_normal_cg_;
     tmp_pos += sizeof(is_normal_cg_);
+    if (with_shared_dict_ || with_compress_dict_) {
+      MEMCPY(buf + tmp_pos, &shared_dict_offset_, sizeof(shared_dict_offset_));
+      tmp_pos += sizeof(shared_dict_offset_);
+      MEMCPY(buf + tmp_pos, &shared_dict_size_, sizeof(shared_dict_size_));
+      tmp_pos += sizeof(shared_dict_size_);
+    }
+    if (with_compress_dict_) {
+      MEMCPY(buf + tmp_pos, &compress_dict_offset_, sizeof(compress_dict_offset_));
+      tmp_pos += sizeof(compress_dict_offset_);
+      MEMCPY(buf + tmp_pos, &compress_dict_size_, sizeof(compress_dict_size_));
+      tmp_pos += sizeof(compress_dict_size_);
+    }
     if (OB_UNLIKELY(get_serialize_size() != tmp_pos - pos)) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("serialize size doesn't match get_serialize_size func", K(ret), K(tmp_pos), K(pos),
@@ -230,6 +256,12 @@ int ObSSTableMacroBlockHeader::deserialize(const char *buf, const int64_t data_l
     column_orders_ = nullptr;
     column_checksum_ = nullptr;
     is_normal_cg_ = false;
+    with_shared_dict_ = false;
+    shared_dict_offset_ = 0;
+    shared_dict_size_ = 0;
+    with_compress_dict_ = false;
+    compress_dict_offset_ = 0;
+    compress_dict_size_ = 0;
     if (tmp_pos + obj_metas_size <= max_pos) {
       column_types_ = reinterpret_cast<ObObjMeta *>(const_cast<char *>(buf + tmp_pos));
     }
@@ -249,6 +281,20 @@ int ObSSTableMacroBlockHeader::deserialize(const char *buf, const int64_t data_l
       is_normal_cg_ = *(reinterpret_cast<bool *>(const_cast<char *>(buf + tmp_pos)));
       tmp_pos += sizeof(is_normal_cg_);
     }
+    if (tmp_pos + get_shared_dict_pos_size() <= max_pos) {
+      with_shared_dict_ = true;
+      MEMCPY(&shared_dict_offset_, buf + tmp_pos, sizeof(shared_dict_offset_));
+      tmp_pos += sizeof(shared_dict_offset_);
+      MEMCPY(&shared_dict_size_, buf + tmp_pos, sizeof(shared_dict_size_));
+      tmp_pos += sizeof(shared_dict_size_);
+    }
+    if (tmp_pos + get_compress_dict_pos_size() <= max_pos) {
+      with_compress_dict_ = true;
+      MEMCPY(&compress_dict_offset_, buf + tmp_pos, sizeof(compress_dict_offset_));
+      tmp_pos += sizeof(compress_dict_offset_);
+      MEMCPY(&compress_dict_size_, buf + tmp_pos, sizeof(compress_dict_size_));
+      tmp_pos += sizeof(compress_dict_size_);
+    }
     fixed_header_.header_size_ = get_serialize_size();
     if (OB_UNLIKELY(!is_valid())) {
       ret = OB_ERR_UNEXPECTED;
@@ -265,7 +311,8 @@ int64_t ObSSTableMacroBlockHeader::get_serialize_size() const
 {
   return get_fixed_header_size() + get_variable_size_in_header(
     fixed_header_.column_count_, fixed_header_.rowkey_column_count_, fixed_header_.version_)
-    + sizeof(is_normal_cg_);
+    + sizeof(is_normal_cg_)
+    + get_dict_pos_size(with_shared_dict_, with_compress_dict_);
 }
 
 int64_t ObSSTableMacroBlockHeader::get_fixed_header_size()
@@ -288,7 +335,9 @@ int ObSSTableMacroBlockHeader::init(
     const ObDataStoreDesc &desc,
     common::ObObjMeta *col_types,
     common::ObOrderType *col_orders,
-    int64_t *col_checksum)
+    int64_t *col_checksum,
+    const bool with_shared_dict,
+    const bool with_compress_dict)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(is_inited_)) {
@@ -304,7 +353,8 @@ int ObSSTableMacroBlockHeader::init(
     fixed_header_.version_ = desc.get_fixed_header_version();
     fixed_header_.header_size_ = static_cast<int32_t>(get_fixed_header_size()
         + get_variable_size_in_header(desc.get_row_column_count(), desc.get_rowkey_column_count(), fixed_header_.version_))
-        + sizeof(is_normal_cg_);
+        + sizeof(is_normal_cg_)
+        + get_dict_pos_size(with_shared_dict, with_compress_dict);
     fixed_header_.tablet_id_ = desc.get_tablet_id().id();
     fixed_header_.logical_version_ = desc.get_logical_version();
     fixed_header_.column_count_ =  static_cast<int32_t>(desc.get_row_column_count());
@@ -338,6 +388,12 @@ int ObSSTableMacroBlockHeader::init(
       column_checksum_[i] = 0;
     }
     is_normal_cg_ = desc.is_cg();
+    with_shared_dict_ = with_shared_dict;
+    shared_dict_offset_ = 0;
+    shared_dict_size_ = 0;
+    with_compress_dict_ = with_compress_dict;
+    compress_dict_offset_ = 0;
+    compress_dict_size_ = 0;
     is_inited_ = true;
   }
   if (OB_UNLIKELY(!is_inited_)) {
@@ -77,7 +77,9 @@ public:
       const ObDataStoreDesc &desc,
       common::ObObjMeta *col_types,
       common::ObOrderType *col_orders,
-      int64_t *col_checksum);
+      int64_t *col_checksum,
+      const bool with_shared_dict = false,
+      const bool with_compress_dict = false);
   int serialize(char *buf, const int64_t buf_len, int64_t& pos) const;
   int deserialize(const char *buf, const int64_t data_len, int64_t& pos);
   int64_t get_serialize_size() const;
@@ -91,6 +93,21 @@ public:
     const int64_t column_cnt,
     const int64_t rowkey_col_cnt,
     const uint16_t version);
+  static int64_t get_shared_dict_pos_size()
+  {
+    return sizeof(shared_dict_offset_) + sizeof(shared_dict_size_);
+  }
+  bool has_shared_dict() const { return with_shared_dict_ && shared_dict_size_ > 0; }
+  static int64_t get_compress_dict_pos_size()
+  {
+    return sizeof(compress_dict_offset_) + sizeof(compress_dict_size_);
+  }
+  bool has_compress_dict() const { return with_compress_dict_ && compress_dict_size_ > 0; }
+  static int64_t get_dict_pos_size(const bool with_shared_dict, const bool with_compress_dict)
+  {
+    return (with_shared_dict || with_compress_dict ? get_shared_dict_pos_size() : 0)
+        + (with_compress_dict ? get_compress_dict_pos_size() : 0);
+  }
 public:
   static const uint16_t SSTABLE_MACRO_BLOCK_HEADER_VERSION_V1 = 1;
   static const uint16_t SSTABLE_MACRO_BLOCK_HEADER_VERSION_V2 = 2; // only store rowkey type/order
@@ -104,6 +121,17 @@ public:
   common::ObOrderType *column_orders_;
   int64_t *column_checksum_;
   bool is_normal_cg_;
+  // shared dict position is only serialized after is_normal_cg_ for macro blocks written with
+  // shared dict of cs encoding, shared_dict_size_ is 0 if no column uses the shared dict.
+  bool with_shared_dict_;
+  int32_t shared_dict_offset_;
+  int32_t shared_dict_size_;
+  // compress dict position is serialized after the shared dict position (which is always
+  // serialized then) for macro blocks written with the micro block compress dict,
+  // compress_dict_size_ is 0 if no micro block is compressed with the dict.
+  bool with_compress_dict_;
+  int32_t compress_dict_offset_;
+  int32_t compress_dict_size_;
   bool is_inited_;
 };
 
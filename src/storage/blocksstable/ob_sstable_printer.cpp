@@ -291,6 +291,14 @@ void ObSSTablePrinter::print_macro_block_header(const ObSSTableMacroBlockHeader
   print_line("compressor_type", sstable_header->fixed_header_.compressor_type_);
   print_line("master_key_id", sstable_header->fixed_header_.master_key_id_);
   print_line("is_normal_cg", sstable_header->is_normal_cg_);
+  if (sstable_header->with_shared_dict_) {
+    print_line("shared_dict_offset", sstable_header->shared_dict_offset_);
+    print_line("shared_dict_size", sstable_header->shared_dict_size_);
+  }
+  if (sstable_header->with_compress_dict_) {
+    print_line("compress_dict_offset", sstable_header->compress_dict_offset_);
+    print_line("compress_dict_size", sstable_header->compress_dict_size_);
+  }
   print_end_line();
 }
 
@@ -665,6 +673,8 @@ void ObSSTablePrinter::print_cs_encoding_column_meta(
     print_line("dict_meta.attrs", dict_meta->attrs_);
     print_line("dict_meta.distinct_val_cnt", dict_meta->distinct_val_cnt_);
     print_line("dict_meta.ref_row_cnt", dict_meta->ref_row_cnt_);
+  } else if (ObCSColumnHeader::Type::FSST_STRING == type || ObCSColumnHeader::Type::ALP_FLOAT == type) {
+    // optional null bitmap + fsst symbol table or alp meta, only printed in hex
   } else {
     print_line("has_nullbitmap", (0 != len));
   }
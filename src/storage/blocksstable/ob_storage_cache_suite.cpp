@@ -21,9 +21,13 @@ namespace blocksstable
 ObStorageCacheSuite::ObStorageCacheSuite()
   : index_block_cache_(),
     user_block_cache_(),
+    user_compressed_block_cache_(),
+    flash_cache_(),
     user_row_cache_(),
     bf_cache_(),
     fuse_row_cache_(),
+    shared_dict_cache_(),
+    compress_dict_cache_(),
     storage_meta_cache_(),
     is_inited_(false)
 {
@@ -57,6 +61,8 @@ int ObStorageCacheSuite::init(
     STORAGE_LOG(ERROR, "init infrc block cache failed", K(ret));
   } else if (OB_FAIL(user_block_cache_.init("user_block_cache", user_block_cache_priority))) {
     STORAGE_LOG(ERROR, "init user block cache failed, ", K(ret));
+  } else if (OB_FAIL(user_compressed_block_cache_.init("user_compressed_block_cache", user_block_cache_priority))) {
+    STORAGE_LOG(ERROR, "init user compressed block cache failed, ", K(ret));
   } else if (OB_FAIL(user_row_cache_.init("user_row_cache", user_row_cache_priority))) {
     STORAGE_LOG(ERROR, "init user sstable row cache failed, ", K(ret));
   } else if (OB_FAIL(bf_cache_.init("bf_cache", bf_cache_priority))) {
@@ -65,6 +71,10 @@ int ObStorageCacheSuite::init(
     STORAGE_LOG(ERROR, "failed to set bf_cache_miss_count_threshold", K(ret));
   } else if (OB_FAIL(fuse_row_cache_.init("fuse_row_cache", fuse_row_cache_priority))) {
     STORAGE_LOG(ERROR, "fail to init fuse row cache", K(ret));
+  } else if (OB_FAIL(shared_dict_cache_.init("shared_dict_cache", bf_cache_priority))) {
+    STORAGE_LOG(ERROR, "fail to init shared dict cache", K(ret));
+  } else if (OB_FAIL(compress_dict_cache_.init("compress_dict_cache", bf_cache_priority))) {
+    STORAGE_LOG(ERROR, "fail to init compress dict cache", K(ret));
   } else if (OB_FAIL(storage_meta_cache_.init("storage_meta_cache", storage_meta_cache_priority))) {
     STORAGE_LOG(ERROR, "fail to init storage meta cache", K(ret), K(storage_meta_cache_priority));
   } else {
@@ -94,12 +104,18 @@ int ObStorageCacheSuite::reset_priority(
     STORAGE_LOG(ERROR, "set priority for index block cache failed", K(ret));
   } else if (OB_FAIL(user_block_cache_.set_priority(user_block_cache_priority))) {
     STORAGE_LOG(ERROR, "set priority for user block cache failed, ", K(ret));
+  } else if (OB_FAIL(user_compressed_block_cache_.set_priority(user_block_cache_priority))) {
+    STORAGE_LOG(ERROR, "set priority for user compressed block cache failed, ", K(ret));
   } else if (OB_FAIL(user_row_cache_.set_priority(user_row_cache_priority))) {
     STORAGE_LOG(ERROR, "set priority for user sstable row cache failed, ", K(ret));
   } else if (OB_FAIL(bf_cache_.set_priority(bf_cache_priority))) {
     STORAGE_LOG(ERROR, "set priority for bloom filter cache failed, ", K(ret));
   } else if (OB_FAIL(fuse_row_cache_.set_priority(fuse_row_cache_priority))) {
     STORAGE_LOG(ERROR, "fail to set priority for fuse row cache", K(ret));
+  } else if (OB_FAIL(shared_dict_cache_.set_priority(bf_cache_priority))) {
+    STORAGE_LOG(ERROR, "fail to set priority for shared dict cache", K(ret));
+  } else if (OB_FAIL(compress_dict_cache_.set_priority(bf_cache_priority))) {
+    STORAGE_LOG(ERROR, "fail to set priority for compress dict cache", K(ret));
   } else if (OB_FAIL(storage_meta_cache_.set_priority(storage_meta_cache_priority))) {
     STORAGE_LOG(ERROR, "fail to set priority for storage cache", K(ret), K(storage_meta_cache_priority));
   }
@@ -115,13 +131,50 @@ int ObStorageCacheSuite::set_bf_cache_miss_count_threshold(const int64_t bf_cach
   return ret;
 }
 
+int ObStorageCacheSuite::set_block_cache_admission(const bool enable_admission)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The cashe suite has not been inited, ", K(ret));
+  } else if (OB_FAIL(index_block_cache_.set_admission(enable_admission))) {
+    STORAGE_LOG(WARN, "set admission for index block cache failed", K(ret), K(enable_admission));
+  } else if (OB_FAIL(user_block_cache_.set_admission(enable_admission))) {
+    STORAGE_LOG(WARN, "set admission for user block cache failed", K(ret), K(enable_admission));
+  } else if (OB_FAIL(user_compressed_block_cache_.set_admission(enable_admission))) {
+    STORAGE_LOG(WARN, "set admission for user compressed block cache failed", K(ret), K(enable_admission));
+  }
+  return ret;
+}
+
+int ObStorageCacheSuite::init_flash_cache(const char *file_path, const int64_t file_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The cashe suite has not been inited, ", K(ret));
+  } else if (OB_ISNULL(file_path) || 0 == STRLEN(file_path) || 0 == file_size) {
+    // flash cache is disabled
+  } else if (OB_FAIL(flash_cache_.init(file_path, file_size))) {
+    STORAGE_LOG(WARN, "init micro block flash cache failed", K(ret), K(file_path), K(file_size));
+  } else if (OB_FAIL(flash_cache_.start())) {
+    STORAGE_LOG(WARN, "start micro block flash cache failed", K(ret));
+    flash_cache_.destroy();
+  }
+  return ret;
+}
+
 void ObStorageCacheSuite::destroy()
 {
+  flash_cache_.destroy();
   index_block_cache_.destroy();
   user_block_cache_.destroy();
+  user_compressed_block_cache_.destroy();
   user_row_cache_.destroy();
   bf_cache_.destroy();
   fuse_row_cache_.destroy();
+  shared_dict_cache_.destroy();
+  compress_dict_cache_.destroy();
   storage_meta_cache_.destory();
   is_inited_ = false;
 }
@@ -16,9 +16,11 @@
 #include "storage/meta_mem/ob_storage_meta_cache.h"
 #include "share/schema/ob_table_schema.h"
 #include "ob_micro_block_cache.h"
+#include "ob_micro_block_flash_cache.h"
 #include "ob_row_cache.h"
 #include "ob_fuse_row_cache.h"
 #include "ob_bloom_filter_cache.h"
+#include "ob_shared_dict_cache.h"
 
 #define OB_STORE_CACHE oceanbase::blocksstable::ObStorageCacheSuite::get_instance()
 
@@ -47,13 +49,21 @@ public:
       const int64_t bf_cache_priority,
       const int64_t storage_meta_cache_priority);
   int set_bf_cache_miss_count_threshold(const int64_t bf_cache_miss_count_threshold);
+  // keep the micro blocks read once by large scan from flushing hot blocks out of block caches
+  int set_block_cache_admission(const bool enable_admission);
+  // optional flash tier of block caches, should be inited after block manager
+  int init_flash_cache(const char *file_path, const int64_t file_size);
   ObDataMicroBlockCache &get_block_cache() { return user_block_cache_; }
   ObIndexMicroBlockCache &get_index_block_cache() { return index_block_cache_; }
+  ObCompressedMicroBlockCache &get_compressed_block_cache() { return user_compressed_block_cache_; }
+  ObMicroBlockFlashCache &get_flash_cache() { return flash_cache_; }
   ObDataMicroBlockCache &get_micro_block_cache(const bool is_data_block)
   { return is_data_block ? user_block_cache_ : index_block_cache_; }
   ObRowCache &get_row_cache() { return user_row_cache_; }
   ObBloomFilterCache &get_bf_cache() { return bf_cache_; }
   ObFuseRowCache &get_fuse_row_cache() { return fuse_row_cache_; }
+  ObSharedDictCache &get_shared_dict_cache() { return shared_dict_cache_; }
+  ObCompressDictCache &get_compress_dict_cache() { return compress_dict_cache_; }
   ObStorageMetaCache &get_storage_meta_cache() { return storage_meta_cache_; }
   void destroy();
   inline bool is_inited() const { return is_inited_; }
@@ -63,9 +73,13 @@ private:
   virtual ~ObStorageCacheSuite();
   ObIndexMicroBlockCache index_block_cache_;
   ObDataMicroBlockCache user_block_cache_;
+  ObCompressedMicroBlockCache user_compressed_block_cache_;
+  ObMicroBlockFlashCache flash_cache_;
   ObRowCache user_row_cache_;
   ObBloomFilterCache bf_cache_;
   ObFuseRowCache fuse_row_cache_;
+  ObSharedDictCache shared_dict_cache_;
+  ObCompressDictCache compress_dict_cache_;
   ObStorageMetaCache storage_meta_cache_;
   bool is_inited_;
 private:
@@ -14,6 +14,7 @@
 #include "ob_tmp_file_cache.h"
 #include "observer/ob_server_struct.h"
 #include "share/ob_task_define.h"
+#include "lib/stat/ob_diagnose_info.h"
 
 namespace oceanbase
 {
@@ -273,6 +274,7 @@ int ObTmpFileIOHandle::do_read_wait(const int64_t timeout_ms)
   }
   page_cache_handles_.reset();
 
+  const int64_t begin_us = ObTimeUtility::fast_current_time();
   for (int32_t i = 0; OB_SUCC(ret) && i < io_handles_.count(); i++) {
     ObIOReadHandle &tmp = io_handles_.at(i);
     if (OB_FAIL(tmp.macro_handle_.wait())) {
@@ -282,6 +284,9 @@ int ObTmpFileIOHandle::do_read_wait(const int64_t timeout_ms)
       tmp.macro_handle_.reset();
     }
   }
+  if (0 != io_handles_.count()) {
+    EVENT_ADD(ObStatEventIds::TMP_FILE_READ_IO_WAIT_TIME, ObTimeUtility::fast_current_time() - begin_us);
+  }
   io_handles_.reset();
   return ret;
 }
@@ -271,7 +271,7 @@ int ObTmpPageCache::get_cache_page(const ObTmpPageCacheKey &key, ObTmpPageValueH
 }
 
 ObTmpPageCache::ObITmpPageIOCallback::ObITmpPageIOCallback()
-  : cache_(NULL), allocator_(NULL), offset_(0), data_buf_(NULL)
+  : cache_(NULL), allocator_(NULL), offset_(0), data_buf_(NULL), comp_page_nums_(0)
 {
   static_assert(sizeof(*this) <= CALLBACK_BUF_SIZE, "IOCallback buf size not enough");
 }
@@ -287,7 +287,24 @@ ObTmpPageCache::ObITmpPageIOCallback::~ObITmpPageIOCallback()
 
 int ObTmpPageCache::ObITmpPageIOCallback::alloc_data_buf(const char *io_data_buffer, const int64_t data_size)
 {
-  int ret = alloc_and_copy_data(io_data_buffer, data_size, allocator_, data_buf_);
+  int ret = OB_SUCCESS;
+  if (0 == comp_page_nums_) {
+    ret = alloc_and_copy_data(io_data_buffer, data_size, allocator_, data_buf_);
+  } else {
+    const int64_t buf_size = comp_page_nums_ * ObTmpMacroBlock::get_default_page_size();
+    if (OB_ISNULL(allocator_) || OB_ISNULL(io_data_buffer)) {
+      ret = OB_ERR_UNEXPECTED;
+      STORAGE_LOG(WARN, "invalid data, the allocator is nullptr", K(ret), KP(io_data_buffer), KP_(allocator));
+    } else if (OB_ISNULL(data_buf_ = static_cast<char *>(allocator_->alloc(buf_size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      STORAGE_LOG(WARN, "fail to allocate memory", K(ret), K(buf_size));
+    } else if (OB_FAIL(ObTmpFilePageCompressor::decompress_pages(
+        io_data_buffer, data_size, comp_page_nums_, data_buf_, buf_size))) {
+      STORAGE_LOG(WARN, "fail to decompress tmp pages", K(ret), K(data_size), K_(comp_page_nums));
+      allocator_->free(data_buf_);
+      data_buf_ = NULL;
+    }
+  }
   return ret;
 }
 
@@ -452,7 +469,24 @@ int ObTmpPageCache::read_io(const ObTmpBlockIOInfo &io_info, ObITmpPageIOCallbac
   read_info.size_ = io_info.size_;
   read_info.io_desc_.set_resource_group_id(THIS_WORKER.get_group_id());
   read_info.io_desc_.set_sys_module_id(ObIOModule::TMP_PAGE_CACHE_IO);
-  if (OB_FAIL(ObBlockManager::async_read_block(read_info, handle))) {
+  if (NULL != io_info.comp_page_offsets_) {
+    // read the records of the pages instead, they are decompressed in the callback.
+    const int64_t page_size = ObTmpMacroBlock::get_default_page_size();
+    const int64_t start_page_id = (io_info.offset_ - ObTmpMacroBlock::get_header_padding()) / page_size;
+    const int64_t page_nums = io_info.size_ / page_size;
+    if (OB_ISNULL(callback) || OB_UNLIKELY(start_page_id < 0 || page_nums <= 0
+        || start_page_id + page_nums > ObTmpFilePageBuddy::MAX_PAGE_NUMS)) {
+      ret = OB_INVALID_ARGUMENT;
+      STORAGE_LOG(WARN, "invalid compressed tmp page io", K(ret), K(io_info), KP(callback));
+    } else {
+      read_info.offset_ = ObTmpMacroBlock::get_header_padding() + io_info.comp_page_offsets_[start_page_id];
+      read_info.size_ = io_info.comp_page_offsets_[start_page_id + page_nums]
+          - io_info.comp_page_offsets_[start_page_id];
+      callback->comp_page_nums_ = page_nums;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(ObBlockManager::async_read_block(read_info, handle))) {
     STORAGE_LOG(WARN, "fail to async read block", K(ret), K(read_info), KP(callback));
   }
   return ret;
@@ -1146,7 +1180,8 @@ int ObTmpTenantMemBlockManager::check_memory_limit()
     if (OB_FAIL(guard.get_ret())) {
       STORAGE_LOG(ERROR, "fail to guard request condition", K(ret));
     } else {
-      int64_t wait_ms = (timeout_ts - ObTimeUtility::current_time()) / 1000;
+      const int64_t begin_us = ObTimeUtility::current_time();
+      int64_t wait_ms = (timeout_ts - begin_us) / 1000;
       while (OB_SUCC(ret)
           && get_tenant_mem_block_num() < t_mblk_map_.size()
           && !wait_info_queue_.is_empty()
@@ -1157,6 +1192,7 @@ int ObTmpTenantMemBlockManager::check_memory_limit()
           wait_ms = (timeout_ts - ObTimeUtility::current_time()) / 1000;
         }
       }
+      EVENT_ADD(ObStatEventIds::TMP_FILE_WRITE_IO_WAIT_TIME, ObTimeUtility::current_time() - begin_us);
 
       if (OB_SUCC(ret) && OB_UNLIKELY(wait_ms <= 0)) {
         ret = OB_TIMEOUT;
@@ -1397,10 +1433,15 @@ int ObTmpTenantMemBlockManager::wash_block(const int64_t block_id, ObIOWaitInfoH
   } else {
     ObTmpBlockIOInfo info;
     char *buf = NULL;
-    SpinWLockGuard io_guard(io_lock_);
+    char *comp_buf = NULL;
     ObMacroBlockHandle &mb_handle = m_blk->get_macro_block_handle();
     if (OB_FAIL(m_blk->get_wash_io_info(info))) {
       STORAGE_LOG(WARN, "fail to get wash io info", K(ret), K_(tenant_id), K(m_blk));
+    } else if (OB_FAIL(compress_wash_block(*m_blk, info, comp_buf))) {
+      STORAGE_LOG(WARN, "fail to compress wash block", K(ret), K_(tenant_id), K(*m_blk));
+    }
+    SpinWLockGuard io_guard(io_lock_);
+    if (OB_FAIL(ret)) {
     } else if (OB_FAIL(write_io(info, mb_handle))) {
       STORAGE_LOG(WARN, "fail to write tmp block", K(ret), K_(tenant_id), K(info), K(*m_blk));
     } else if(OB_ISNULL(buf = static_cast<char *>(allocator_->alloc(sizeof(IOWaitInfo))))) {
@@ -1420,9 +1461,18 @@ int ObTmpTenantMemBlockManager::wash_block(const int64_t block_id, ObIOWaitInfoH
       }
     } else {
       ATOMIC_INC(&washing_count_);
+      EVENT_INC(ObStatEventIds::TMP_FILE_WASH_BLOCK_COUNT);
+      EVENT_ADD(ObStatEventIds::TMP_FILE_WASH_RAW_BYTES, ObTmpFileStore::get_block_size());
+      EVENT_ADD(ObStatEventIds::TMP_FILE_WASH_WRITE_BYTES, info.size_);
+    }
+    if (OB_NOT_NULL(comp_buf)) {
+      // the write io has copied the data.
+      ob_free(comp_buf);
+      comp_buf = NULL;
     }
     if (OB_FAIL(ret) && OB_NOT_NULL(m_blk)) {
       mb_handle.reset();
+      m_blk->reset_comp_page_offsets();
       // don't release wait info unless ObIOWaitInfoHandle doesn't hold its ref
       if (OB_NOT_NULL(wait_info) && OB_ISNULL(handle.get_wait_info())) {
         wait_info->~IOWaitInfo();
@@ -1440,6 +1490,60 @@ int ObTmpTenantMemBlockManager::wash_block(const int64_t block_id, ObIOWaitInfoH
   return ret;
 }
 
+int ObTmpTenantMemBlockManager::compress_wash_block(
+    ObTmpMacroBlock &blk,
+    ObTmpBlockIOInfo &info,
+    char *&comp_buf)
+{
+  int ret = OB_SUCCESS;
+  common::ObCompressor *compressor = NULL;
+  int64_t buf_size = 0;
+  int64_t data_size = 0;
+  bool is_compressed = false;
+  comp_buf = NULL;
+  // the block may be washed before and rolled back to memory.
+  blk.reset_comp_page_offsets();
+  if (!is_compress_enabled()) {
+  } else if (OB_FAIL(ObTmpFilePageCompressor::get_compressor(compressor))) {
+    STORAGE_LOG(WARN, "fail to get tmp page compressor", K(ret));
+  } else if (OB_FAIL(ObTmpFilePageCompressor::get_compress_buf_size(*compressor, buf_size))) {
+    STORAGE_LOG(WARN, "fail to get compress buf size", K(ret));
+  } else if (OB_ISNULL(comp_buf = static_cast<char *>(ob_malloc(buf_size, ObMemAttr(tenant_id_, "TmpFileComp"))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to alloc compress buf", K(ret), K(buf_size));
+  } else {
+    const int64_t begin_us = ObTimeUtility::fast_current_time();
+    if (OB_FAIL(blk.compress_pages(*compressor, comp_buf, buf_size, data_size, is_compressed))) {
+      STORAGE_LOG(WARN, "fail to compress tmp pages", K(ret), K(blk));
+    } else if (is_compressed) {
+      const int64_t write_size = common::upper_align(data_size, DIO_ALIGN_SIZE);
+      MEMSET(comp_buf + data_size, 0, write_size - data_size);
+      info.buf_ = comp_buf;
+      info.size_ = write_size;
+      EVENT_INC(ObStatEventIds::TMP_FILE_WASH_COMPRESSED_BLOCK_COUNT);
+    }
+    EVENT_ADD(ObStatEventIds::TMP_FILE_COMPRESS_TIME, ObTimeUtility::fast_current_time() - begin_us);
+  }
+  if (OB_FAIL(ret)) {
+    // compression is optional, write the block uncompressed.
+    STORAGE_LOG(WARN, "fail to compress wash block, write it uncompressed", K(ret), K(blk));
+    blk.reset_comp_page_offsets();
+    is_compressed = false;
+    ret = OB_SUCCESS;
+  }
+  if (!is_compressed && OB_NOT_NULL(comp_buf)) {
+    ob_free(comp_buf);
+    comp_buf = NULL;
+  }
+  return ret;
+}
+
+bool ObTmpTenantMemBlockManager::is_compress_enabled()
+{
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id_));
+  return tenant_config.is_valid() && tenant_config->_enable_temporary_file_compression;
+}
+
 int ObTmpTenantMemBlockManager::write_io(
     const ObTmpBlockIOInfo &io_info,
     ObMacroBlockHandle &handle)
@@ -1641,9 +1745,11 @@ int ObTmpTenantMemBlockManager::wait_write_finish(const int64_t block_id, const
     }
 
     if (OB_SUCC(ret) && is_found) {
+      const int64_t begin_us = ObTimeUtility::fast_current_time();
       if (OB_FAIL(handle.get_wait_info()->wait(timeout_ms))) {
         STORAGE_LOG(WARN, "wait write io finish failed", K(ret), K(block_id));
       }
+      EVENT_ADD(ObStatEventIds::TMP_FILE_WRITE_IO_WAIT_TIME, ObTimeUtility::fast_current_time() - begin_us);
     }
   }
 
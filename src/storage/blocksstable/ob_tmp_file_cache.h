@@ -137,6 +137,7 @@ public:
     common::ObIAllocator *allocator_;
     int64_t offset_;   // offset in block
     char *data_buf_;   // actual data buffer
+    int64_t comp_page_nums_; // page nums decompressed into data buffer if the block is compressed
   };
 
   class ObTmpPageIOCallback final : public ObITmpPageIOCallback
@@ -437,6 +438,10 @@ private:
   int write_io(
       const ObTmpBlockIOInfo &io_info,
       ObMacroBlockHandle &handle);
+  // compress the pages of washing block %blk if enabled, %info is updated to write the
+  // compressed records in %comp_buf, which is freed by caller.
+  int compress_wash_block(ObTmpMacroBlock &blk, ObTmpBlockIOInfo &info, char *&comp_buf);
+  bool is_compress_enabled();
   int64_t get_tenant_mem_block_num();
   int check_memory_limit();
   int get_block_from_dir_cache(const int64_t dir_id, const int64_t tenant_id,
@@ -14,6 +14,7 @@
 #include "ob_tmp_file.h"
 #include "share/ob_task_define.h"
 #include "observer/omt/ob_tenant_config_mgr.h"
+#include "lib/compress/ob_compressor_pool.h"
 
 using namespace oceanbase::share;
 
@@ -413,6 +414,106 @@ void ObTmpFileMacroBlockHeader::reset()
   free_page_nums_ = 0;
 }
 
+int ObTmpFilePageCompressor::get_compressor(common::ObCompressor *&compressor)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(common::ObCompressorPool::get_instance().get_compressor(common::LZ4_COMPRESSOR, compressor))) {
+    STORAGE_LOG(WARN, "fail to get lz4 compressor", K(ret));
+  } else if (OB_ISNULL(compressor)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "compressor is null", K(ret));
+  }
+  return ret;
+}
+
+int ObTmpFilePageCompressor::get_compress_buf_size(common::ObCompressor &compressor, int64_t &buf_size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t page_size = ObTmpMacroBlock::get_default_page_size();
+  int64_t max_overflow_size = 0;
+  if (OB_FAIL(compressor.get_max_overflow_size(page_size, max_overflow_size))) {
+    STORAGE_LOG(WARN, "fail to get max overflow size", K(ret), K(page_size));
+  } else {
+    // the write size is aligned by dio, and the last page needs the overflow size to compress.
+    buf_size = common::upper_align(
+        ObTmpFilePageBuddy::MAX_PAGE_NUMS * (PAGE_RECORD_HEADER_SIZE + page_size) + max_overflow_size,
+        DIO_ALIGN_SIZE);
+  }
+  return ret;
+}
+
+int ObTmpFilePageCompressor::compress_page(common::ObCompressor &compressor, const char *page,
+    const bool is_written, char *buf, const int64_t buf_size, int64_t &pos)
+{
+  int ret = OB_SUCCESS;
+  const int64_t page_size = ObTmpMacroBlock::get_default_page_size();
+  int64_t data_size = 0;
+  if (OB_ISNULL(page) || OB_ISNULL(buf)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), KP(page), KP(buf));
+  } else if (OB_UNLIKELY(pos + PAGE_RECORD_HEADER_SIZE + page_size > buf_size)) {
+    ret = OB_BUF_NOT_ENOUGH;
+    STORAGE_LOG(WARN, "compress buf not enough", K(ret), K(pos), K(buf_size));
+  } else if (!is_written) {
+    // page not written by any extent will never be read.
+  } else if (OB_FAIL(compressor.compress(page, page_size, buf + pos + PAGE_RECORD_HEADER_SIZE,
+      buf_size - pos - PAGE_RECORD_HEADER_SIZE, data_size))) {
+    STORAGE_LOG(WARN, "fail to compress tmp page", K(ret), K(pos), K(buf_size));
+  } else if (data_size >= page_size) {
+    MEMCPY(buf + pos + PAGE_RECORD_HEADER_SIZE, page, page_size);
+    data_size = page_size;
+  }
+  if (OB_SUCC(ret)) {
+    const int32_t record_size = static_cast<int32_t>(data_size);
+    MEMCPY(buf + pos, &record_size, PAGE_RECORD_HEADER_SIZE);
+    pos += PAGE_RECORD_HEADER_SIZE + data_size;
+  }
+  return ret;
+}
+
+int ObTmpFilePageCompressor::decompress_pages(const char *buf, const int64_t size,
+    const int64_t page_nums, char *out_buf, const int64_t out_size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t page_size = ObTmpMacroBlock::get_default_page_size();
+  common::ObCompressor *compressor = NULL;
+  int64_t pos = 0;
+  if (OB_ISNULL(buf) || OB_ISNULL(out_buf) || OB_UNLIKELY(size <= 0 || page_nums <= 0
+      || out_size < page_nums * page_size)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), KP(buf), K(size), K(page_nums), KP(out_buf), K(out_size));
+  } else if (OB_FAIL(get_compressor(compressor))) {
+    STORAGE_LOG(WARN, "fail to get compressor", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < page_nums; ++i) {
+    char *page = out_buf + i * page_size;
+    int32_t data_size = 0;
+    int64_t decomp_size = 0;
+    if (OB_UNLIKELY(pos + PAGE_RECORD_HEADER_SIZE > size)) {
+      ret = OB_INVALID_DATA;
+      STORAGE_LOG(WARN, "tmp page record is incomplete", K(ret), K(i), K(pos), K(size));
+    } else if (FALSE_IT(MEMCPY(&data_size, buf + pos, PAGE_RECORD_HEADER_SIZE))) {
+    } else if (FALSE_IT(pos += PAGE_RECORD_HEADER_SIZE)) {
+    } else if (OB_UNLIKELY(data_size < 0 || data_size > page_size || pos + data_size > size)) {
+      ret = OB_INVALID_DATA;
+      STORAGE_LOG(WARN, "invalid tmp page record", K(ret), K(i), K(pos), K(data_size), K(size));
+    } else if (0 == data_size) {
+      // page not written.
+    } else if (page_size == data_size) {
+      MEMCPY(page, buf + pos, page_size);
+    } else if (OB_FAIL(compressor->decompress(buf + pos, data_size, page, page_size, decomp_size))) {
+      STORAGE_LOG(WARN, "fail to decompress tmp page", K(ret), K(i), K(data_size));
+    } else if (OB_UNLIKELY(page_size != decomp_size)) {
+      ret = OB_INVALID_DATA;
+      STORAGE_LOG(WARN, "unexpected decompressed page size", K(ret), K(i), K(decomp_size));
+    }
+    if (OB_SUCC(ret)) {
+      pos += data_size;
+    }
+  }
+  return ret;
+}
+
 ObTmpMacroBlock::ObTmpMacroBlock()
   : buffer_(NULL),
     handle_(),
@@ -424,7 +525,9 @@ ObTmpMacroBlock::ObTmpMacroBlock()
     is_sealed_(false),
     is_inited_(false),
     alloc_time_(0),
-    access_time_(0)
+    access_time_(0),
+    allocator_(NULL),
+    comp_page_offsets_(NULL)
 {
   using_extents_.set_attr(ObMemAttr(MTL_ID(), "TMP_US_META"));
 }
@@ -449,6 +552,7 @@ int ObTmpMacroBlock::init(const int64_t block_id, const int64_t dir_id, const ui
     tmp_file_header_.tenant_id_ = tenant_id;
     tmp_file_header_.free_page_nums_ = ObTmpFilePageBuddy::MAX_PAGE_NUMS;
     ATOMIC_STORE(&block_status_, MEMORY);
+    allocator_ = &allocator;
     is_inited_ = true;
     alloc_time_ = 0;
     ATOMIC_STORE(&access_time_, 0);
@@ -461,6 +565,8 @@ int ObTmpMacroBlock::init(const int64_t block_id, const int64_t dir_id, const ui
 
 void ObTmpMacroBlock::destroy()
 {
+  reset_comp_page_offsets();
+  allocator_ = NULL;
   using_extents_.reset();
   page_buddy_.destroy();
   macro_block_handle_.reset();
@@ -596,6 +702,74 @@ int ObTmpMacroBlock::give_back_buf_into_cache(const bool is_wash)
   return ret;
 }
 
+int ObTmpMacroBlock::compress_pages(common::ObCompressor &compressor, char *buf, const int64_t buf_size,
+    int64_t &data_size, bool &is_compressed)
+{
+  int ret = OB_SUCCESS;
+  const int64_t page_nums = ObTmpFilePageBuddy::MAX_PAGE_NUMS;
+  bool is_written[ObTmpFilePageBuddy::MAX_PAGE_NUMS];
+  uint32_t *page_offsets = NULL;
+  int64_t pos = 0;
+  data_size = 0;
+  is_compressed = false;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "ObTmpMacroBlock has not been inited", K(ret));
+  } else if (OB_UNLIKELY(!is_washing() || NULL != comp_page_offsets_)) {
+    ret = OB_STATE_NOT_MATCH;
+    STORAGE_LOG(WARN, "the block is not washing or has been compressed", K(ret), KPC(this));
+  } else if (OB_ISNULL(buf) || OB_UNLIKELY(buf_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), KP(buf), K(buf_size));
+  } else if (OB_ISNULL(page_offsets = static_cast<uint32_t *>(
+      allocator_->alloc(sizeof(uint32_t) * (page_nums + 1))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to alloc page offsets", K(ret));
+  } else {
+    MEMSET(is_written, 0, sizeof(is_written));
+    {
+      SpinRLockGuard guard(lock_);
+      for (int64_t i = 0; i < using_extents_.count(); ++i) {
+        const ObTmpFileExtent *extent = using_extents_.at(i);
+        const int64_t written_page_nums = common::upper_align(extent->get_offset(), DEFAULT_PAGE_SIZE)
+            / DEFAULT_PAGE_SIZE;
+        const int64_t end_page_id = extent->get_start_page_id()
+            + MIN(written_page_nums, static_cast<int64_t>(extent->get_page_nums()));
+        for (int64_t j = extent->get_start_page_id(); j < end_page_id && j < page_nums; ++j) {
+          is_written[j] = true;
+        }
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < page_nums; ++i) {
+      page_offsets[i] = static_cast<uint32_t>(pos);
+      if (OB_FAIL(ObTmpFilePageCompressor::compress_page(compressor, buffer_ + i * DEFAULT_PAGE_SIZE,
+          is_written[i], buf, buf_size, pos))) {
+        STORAGE_LOG(WARN, "fail to compress tmp page", K(ret), K(i), K(pos), K(buf_size));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      page_offsets[page_nums] = static_cast<uint32_t>(pos);
+      if (ObTmpFilePageCompressor::is_worth_compressing(pos, ObTmpFileStore::get_block_size())) {
+        comp_page_offsets_ = page_offsets;
+        data_size = pos;
+        is_compressed = true;
+      }
+    }
+  }
+  if (!is_compressed && NULL != page_offsets) {
+    allocator_->free(page_offsets);
+  }
+  return ret;
+}
+
+void ObTmpMacroBlock::reset_comp_page_offsets()
+{
+  if (NULL != comp_page_offsets_ && NULL != allocator_) {
+    allocator_->free(comp_page_offsets_);
+  }
+  comp_page_offsets_ = NULL;
+}
+
 int ObTmpMacroBlock::alloc_all_pages(ObTmpFileExtent &extent)
 {
   int ret = OB_SUCCESS;
@@ -1372,6 +1546,7 @@ int ObTmpTenantFileStore::read_page(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io
       info.offset_ = p_offset + ObTmpMacroBlock::get_header_padding();
       info.size_ = page_nums * ObTmpMacroBlock::get_default_page_size();
       info.macro_block_id_ = block->get_macro_block_id();
+      info.comp_page_offsets_ = block->get_comp_page_offsets();
       if (handle.is_disable_page_cache()) {
         if (OB_FAIL(page_cache_->direct_read(info, mb_handle, io_allocator_))) {
           STORAGE_LOG(WARN, "fail to direct read multi page", K(ret));
@@ -1398,6 +1573,7 @@ int ObTmpTenantFileStore::read_page(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io
         info.offset_ += ObTmpMacroBlock::get_header_padding();
         info.size_ = ObTmpMacroBlock::get_default_page_size();
         info.macro_block_id_ = block->get_macro_block_id();
+        info.comp_page_offsets_ = block->get_comp_page_offsets();
         if (handle.is_disable_page_cache()) {
           if (OB_FAIL(page_cache_->direct_read(info, mb_handle, io_allocator_))) {
             STORAGE_LOG(WARN, "fail to direct read tmp page", K(ret));
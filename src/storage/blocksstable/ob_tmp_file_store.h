@@ -17,6 +17,7 @@
 #include "storage/blocksstable/ob_macro_block_handle.h"
 #include "storage/blocksstable/ob_block_manager.h"
 #include "storage/blocksstable/ob_tmp_file_cache.h"
+#include "lib/compress/ob_compressor.h"
 
 namespace oceanbase
 {
@@ -111,14 +112,14 @@ struct ObTmpBlockIOInfo final
 public:
   ObTmpBlockIOInfo()
     : block_id_(0), offset_(0), size_(0), io_timeout_ms_(DEFAULT_IO_WAIT_TIME_MS), tenant_id_(0),
-      buf_(NULL), io_desc_(), macro_block_id_() {}
+      buf_(NULL), io_desc_(), macro_block_id_(), comp_page_offsets_(NULL) {}
   ObTmpBlockIOInfo(const int64_t block_id, const int64_t offset, const int64_t size,
       const uint64_t tenant_id, const MacroBlockId macro_block_id, char *buf,
       const common::ObIOFlag io_desc)
     : block_id_(block_id), offset_(offset), size_(size), tenant_id_(tenant_id),
-      buf_(buf), io_desc_(io_desc), macro_block_id_(macro_block_id) {}
+      buf_(buf), io_desc_(io_desc), macro_block_id_(macro_block_id), comp_page_offsets_(NULL) {}
   TO_STRING_KV(K_(block_id), K_(offset), K_(size), K_(io_timeout_ms), K_(tenant_id), K_(macro_block_id), KP_(buf),
-      K_(io_desc));
+      K_(io_desc), KP_(comp_page_offsets));
   int64_t block_id_;
   int64_t offset_;
   int64_t size_;
@@ -127,6 +128,31 @@ public:
   char *buf_;
   common::ObIOFlag io_desc_;
   MacroBlockId macro_block_id_;
+  // page offsets of a compressed disked block, the offset and size above are still the ones of
+  // the uncompressed pages and are translated when the io is issued.
+  const uint32_t *comp_page_offsets_;
+};
+
+// Pages of a tmp macro block can be compressed with LZ4 when the block is washed, see
+// _enable_temporary_file_compression. Every page is stored as a record of its data size
+// followed by the data: 0 for the pages not written by any extent, the page size for the
+// pages not compressible, and the compressed size otherwise. The records are packed behind
+// the header padding, and the record offsets are kept in memory by ObTmpMacroBlock.
+class ObTmpFilePageCompressor final
+{
+public:
+  static int get_compressor(common::ObCompressor *&compressor);
+  static int get_compress_buf_size(common::ObCompressor &compressor, int64_t &buf_size);
+  static int compress_page(common::ObCompressor &compressor, const char *page, const bool is_written,
+      char *buf, const int64_t buf_size, int64_t &pos);
+  static int decompress_pages(const char *buf, const int64_t size, const int64_t page_nums,
+      char *out_buf, const int64_t out_size);
+  // less io is not worth the decompression on read unless 1/8 of the block is saved at least.
+  static bool is_worth_compressing(const int64_t comp_size, const int64_t raw_size)
+  {
+    return comp_size <= raw_size - raw_size / 8;
+  }
+  static const int64_t PAGE_RECORD_HEADER_SIZE = sizeof(int32_t);
 };
 
 class ObTmpMacroBlock final
@@ -190,9 +216,17 @@ public:
   int seal(bool &is_sealed);
   int is_extents_closed(bool &is_extents_closed);
   int give_back_buf_into_cache(const bool is_wash = false);
+  // compress the written pages of the washing block into %buf, %is_compressed is false and
+  // nothing is kept if the pages are not compressible enough.
+  int compress_pages(common::ObCompressor &compressor, char *buf, const int64_t buf_size,
+      int64_t &data_size, bool &is_compressed);
+  void reset_comp_page_offsets();
+  // offsets of the page records behind the header padding, MAX_PAGE_NUMS + 1 entries, NULL if
+  // the block is washed without compression.
+  OB_INLINE const uint32_t *get_comp_page_offsets() const { return comp_page_offsets_; }
 
   TO_STRING_KV(KP_(buffer), K_(page_buddy), K_(handle), K_(macro_block_handle), K_(tmp_file_header),
-      K_(io_desc), K_(block_status), K_(is_inited), K_(alloc_time), K_(access_time));
+      K_(io_desc), K_(block_status), K_(is_inited), K_(alloc_time), K_(access_time), KP_(comp_page_offsets));
 private:
   bool is_sealed() const { return ATOMIC_LOAD(&is_sealed_); }
 private:
@@ -210,6 +244,8 @@ private:
   bool is_inited_;
   int64_t alloc_time_;
   int64_t access_time_;
+  common::ObIAllocator *allocator_;
+  uint32_t *comp_page_offsets_;
   DISALLOW_COPY_AND_ASSIGN(ObTmpMacroBlock);
 };
 
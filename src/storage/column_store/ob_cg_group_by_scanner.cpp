@@ -133,6 +133,56 @@ int ObCGGroupByScanner::decide_group_size(int64_t &group_size)
 }
 
 int ObCGGroupByScanner::decide_can_group_by(const int32_t group_by_col, bool &can_group_by)
+{
+  int ret = OB_SUCCESS;
+  int64_t row_cnt = 0;
+  int64_t read_cnt = 0;
+  int64_t distinct_cnt = 0;
+  if (OB_FAIL(open_group_by_micro_block())) {
+    LOG_WARN("Failed to open micro block", K(ret));
+  } else if (OB_FAIL(micro_scanner_->check_can_group_by(group_by_col, row_cnt, read_cnt, distinct_cnt, can_group_by))) {
+    LOG_WARN("Failed to check group by", K(ret));
+  } else if (can_group_by && OB_FAIL(group_by_cell_->decide_use_group_by(
+              row_cnt, read_cnt, group_by_cell_->get_group_by_key_space(distinct_cnt), filter_bitmap_, can_group_by,
+              nullptr != micro_scanner_->get_reader() && micro_scanner_->get_reader()->has_shared_dict()))) {
+    LOG_WARN("Failed to decide use group by", K(ret));
+  }
+  return ret;
+}
+
+int ObCGGroupByScanner::get_group_by_distinct_cnt(const int32_t group_by_col, int64_t &distinct_cnt)
+{
+  int ret = OB_SUCCESS;
+  int64_t row_cnt = 0;
+  int64_t read_cnt = 0;
+  bool can_group_by = false;
+  distinct_cnt = -1;
+  if (OB_FAIL(open_group_by_micro_block())) {
+    LOG_WARN("Failed to open micro block", K(ret));
+  } else if (OB_FAIL(micro_scanner_->check_can_group_by(group_by_col, row_cnt, read_cnt, distinct_cnt, can_group_by))) {
+    LOG_WARN("Failed to check group by", K(ret));
+  } else if (!can_group_by) {
+    distinct_cnt = -1;
+  }
+  return ret;
+}
+
+int ObCGGroupByScanner::get_group_by_key_info(int64_t &key_idx, bool &is_key_only)
+{
+  int ret = OB_SUCCESS;
+  key_idx = -1;
+  is_key_only = false;
+  if (OB_ISNULL(output_exprs_) || OB_UNLIKELY(1 != output_exprs_->count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected output exprs", K(ret), KPC_(output_exprs));
+  } else {
+    key_idx = group_by_cell_->find_group_by_key(output_exprs_->at(0));
+    is_key_only = key_idx >= 0 && 1 == group_by_agg_idxs_.count() && 1 == group_by_agg_idxs_.at(0).count();
+  }
+  return ret;
+}
+
+int ObCGGroupByScanner::open_group_by_micro_block()
 {
   int ret = OB_SUCCESS;
   // must have been located
@@ -152,16 +202,8 @@ int ObCGGroupByScanner::decide_can_group_by(const int32_t group_by_col, bool &ca
         prefetcher_.cur_micro_data_fetch_idx_++;
         prefetcher_.cur_micro_data_read_idx_++;
         is_new_range_ = false;
-        int64_t row_cnt = 0;
-        int64_t read_cnt = 0;
-        int64_t distinct_cnt = 0;
         if (OB_FAIL(open_cur_data_block())) {
           LOG_WARN("Failed to open data block", K(ret));
-        } else if (OB_FAIL(micro_scanner_->check_can_group_by(group_by_col, row_cnt, read_cnt, distinct_cnt, can_group_by))) {
-          LOG_WARN("Failed to check group by", K(ret));
-        } else if (can_group_by && OB_FAIL(group_by_cell_->decide_use_group_by(
-                    row_cnt, read_cnt, distinct_cnt, filter_bitmap_, can_group_by))) {
-          LOG_WARN("Failed to decide use group by", K(ret));
         }
         break;
       }
@@ -40,11 +40,14 @@ public:
   virtual int read_distinct(const int32_t group_by_col) override;
   virtual int read_reference(const int32_t group_by_col) override;
   virtual int calc_aggregate(const bool is_group_by_col) override;
+  virtual int get_group_by_distinct_cnt(const int32_t group_by_col, int64_t &distinct_cnt) override;
+  virtual int get_group_by_key_info(int64_t &key_idx, bool &is_key_only) override;
   virtual int locate_micro_index(const ObCSRange &range) override;
   INHERIT_TO_STRING_KV("ObCGRowScanner", ObCGRowScanner,
       KPC_(output_exprs), K_(group_by_agg_idxs), KP_(group_by_cell));
 private:
   typedef ObSEArray<int32_t, 2>  ObGroupByAggIdxArray;
+  int open_group_by_micro_block();
   int do_group_by_aggregate(const uint64_t count, const bool is_group_by_col, const int64_t ref_offset);
   const sql::ObExprPtrIArray *output_exprs_;
   // aggregate cell indexes for each output(agg) expr
@@ -53,7 +53,12 @@ ObCOSSTableRowScanner::ObCOSSTableRowScanner()
     cg_param_pool_(nullptr),
     range_(nullptr),
     group_by_iters_(),
-    getter_projector_()
+    group_by_key_iters_(),
+    getter_projector_(),
+    topn_filter_(nullptr),
+    topn_key_iter_(nullptr),
+    topn_bitmap_(nullptr),
+    topn_allocator_("COTopNKeys")
 {
   type_ = ObStoreRowIterator::IteratorCOScan;
 }
@@ -86,8 +91,12 @@ int ObCOSSTableRowScanner::init(
       LOG_WARN("Fail to init rows filter", K(ret));
     } else if (OB_FAIL(init_project_iter(param, context, table))) {
       LOG_WARN("Fail to init project iter", K(ret));
-    } else if (param.enable_pd_group_by() && OB_FAIL(init_group_by_info(context))) {
-      LOG_WARN("Failed to init group by info", K(ret));
+    } else if (param.enable_pd_group_by()) {
+      if (OB_FAIL(init_group_by_info(context))) {
+        LOG_WARN("Failed to init group by info", K(ret));
+      }
+    } else if (OB_FAIL(init_topn_key_iter(param, context, table))) {
+      LOG_WARN("Fail to init topn key iter", K(ret));
     }
   }
   if (OB_SUCC(ret)) {
@@ -121,10 +130,13 @@ void ObCOSSTableRowScanner::reset()
   FREE_PTR_FROM_CONTEXT(access_ctx_, rows_filter_, ObCOSSTableRowsFilter);
   FREE_PTR_FROM_CONTEXT(access_ctx_, project_iter_, ObICGIterator);
   FREE_PTR_FROM_CONTEXT(access_ctx_, getter_project_iter_, ObICGIterator);
+  FREE_PTR_FROM_CONTEXT(access_ctx_, topn_key_iter_, ObICGIterator);
+  FREE_PTR_FROM_CONTEXT(access_ctx_, topn_bitmap_, ObCGBitmap);
   FREE_PTR_FROM_CONTEXT(access_ctx_, cg_param_pool_, ObCGIterParamPool);
   range_idx_ = 0;
   group_by_project_idx_ = 0;
   group_by_iters_.reset();
+  group_by_key_iters_.reset();
   group_by_cell_ = nullptr;
   is_new_group_ = false;
   iter_param_ = nullptr;
@@ -142,6 +154,8 @@ void ObCOSSTableRowScanner::reset()
   pending_end_row_id_ = OB_INVALID_CS_ROW_ID;
   column_group_cnt_ = -1;
   getter_projector_.reset();
+  topn_filter_ = nullptr;
+  topn_allocator_.reset();
 }
 
 void ObCOSSTableRowScanner::reuse()
@@ -159,6 +173,10 @@ void ObCOSSTableRowScanner::reuse()
   if (nullptr != getter_project_iter_) {
     getter_project_iter_->reuse();
   }
+  if (nullptr != topn_key_iter_) {
+    topn_key_iter_->reuse();
+  }
+  topn_allocator_.reuse();
   range_idx_ = 0;
   is_new_group_ = false;
   current_ = OB_INVALID_CS_ROW_ID;
@@ -365,6 +383,72 @@ int ObCOSSTableRowScanner::init_project_iter(
   return ret;
 }
 
+int ObCOSSTableRowScanner::init_topn_key_iter(
+    const ObTableIterParam &row_param,
+    ObTableAccessContext &context,
+    ObITable *table)
+{
+  int ret = OB_SUCCESS;
+  ObCOSSTableV2* co_sstable = static_cast<ObCOSSTableV2*>(table);
+  sql::ObPushdownFilterExecutor *root = nullptr == rows_filter_ ? nullptr : row_param.pushdown_filter_;
+  topn_filter_ = nullptr;
+  // only the topn runtime filter which must be passed by all output rows can be used,
+  // i.e. the root of the filter tree or a child of the root AND filter
+  if (nullptr == root) {
+  } else if (is_topn_filter(root)) {
+    topn_filter_ = static_cast<sql::ObDynamicFilterExecutor *>(root);
+  } else if (root->is_logic_and_node()) {
+    for (uint32_t i = 0; nullptr == topn_filter_ && i < root->get_child_count(); ++i) {
+      if (is_topn_filter(root->get_childs()[i])) {
+        topn_filter_ = static_cast<sql::ObDynamicFilterExecutor *>(root->get_childs()[i]);
+      }
+    }
+  }
+  if (nullptr != topn_filter_) {
+    const uint32_t cg_idx = topn_filter_->get_cg_idxs().at(0);
+    ObTableIterParam *cg_param = nullptr;
+    common::ObSEArray<ObTableIterParam*, 1> iter_params;
+    if (OB_FAIL(cg_param_pool_->get_iter_param(cg_idx, row_param, topn_filter_->get_cg_col_exprs()->at(0), cg_param))) {
+      LOG_WARN("Fail to get cg iter param", K(ret), K(cg_idx), K(row_param));
+    } else if (OB_FAIL(iter_params.push_back(cg_param))) {
+      LOG_WARN("Fail to push back cg iter param", K(ret), K(cg_param));
+    } else if (nullptr == topn_key_iter_) {
+      if (OB_FAIL(co_sstable->cg_scan(*cg_param, context, topn_key_iter_, true, false))) {
+        LOG_WARN("Failed to cg scan", K(ret));
+      } else if (ObICGIterator::OB_CG_ROW_SCANNER == topn_key_iter_->get_type()) {
+        static_cast<ObCGRowScanner *>(topn_key_iter_)->set_project_type(false);
+      }
+    } else if (OB_FAIL(ObCOSSTableRowsFilter::switch_context_for_cg_iter(true, false, false, co_sstable, context, iter_params,
+        column_group_cnt_ != co_sstable->get_cs_meta().get_column_group_count(), topn_key_iter_))) {
+      LOG_WARN("Fail to switch context for cg iter", K(ret));
+    }
+    if (OB_SUCC(ret) && nullptr == topn_bitmap_) {
+      if (OB_ISNULL(topn_bitmap_ = OB_NEWx(ObCGBitmap, context.stmt_allocator_, *context.stmt_allocator_))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("Fail to alloc topn bitmap", K(ret));
+      } else if (OB_FAIL(topn_bitmap_->init(row_param.get_storage_rowsets_size()))) {
+        LOG_WARN("Fail to init topn bitmap", K(ret));
+      }
+    }
+  }
+  LOG_DEBUG("[COLUMNSTORE] init topn key iter", K(ret), KPC_(topn_filter), KPC_(topn_key_iter));
+  return ret;
+}
+
+bool ObCOSSTableRowScanner::is_topn_filter(const sql::ObPushdownFilterExecutor *filter) const
+{
+  bool bret = false;
+  if (nullptr != filter && filter->is_filter_dynamic_node()) {
+    const sql::ObDynamicFilterExecutor *dynamic_filter = static_cast<const sql::ObDynamicFilterExecutor *>(filter);
+    // rows can only be pruned by the first sort key
+    bret = sql::DynamicFilterType::PD_TOPN_FILTER == dynamic_filter->get_filter_node().get_dynamic_filter_type() &&
+           0 == dynamic_filter->get_col_idx() &&
+           1 == dynamic_filter->get_cg_idxs().count() &&
+           !is_virtual_cg(dynamic_filter->get_cg_idxs().at(0));
+  }
+  return bret;
+}
+
 int ObCOSSTableRowScanner::init_project_iter_for_single_row(
     const ObTableIterParam &row_param,
     ObTableAccessContext &context,
@@ -675,7 +759,12 @@ int ObCOSSTableRowScanner::filter_rows_without_limit(BlockScanState &blockscan_s
       group_size_ = current_group_size;
     }
   }
-  if (OB_SUCC(ret) && OB_FAIL(project_iter_->locate(
+  if (OB_FAIL(ret)) {
+  } else if (nullptr != topn_filter_ && nullptr != result_bitmap &&
+             OB_FAIL(prune_topn_rows(ObCSRange(reverse_scan_ ? current_ - group_size_ + 1 : current_, group_size_),
+                                     result_bitmap))) {
+    LOG_WARN("Fail to prune topn rows", K(ret), K(current_), K(group_size_));
+  } else if (OB_FAIL(project_iter_->locate(
               ObCSRange(reverse_scan_ ? current_ - group_size_ + 1 : current_, group_size_),
               result_bitmap))) {
     LOG_WARN("Fail to locate", K(ret), K(current_), K(group_size_), KP(result_bitmap));
@@ -685,6 +774,107 @@ int ObCOSSTableRowScanner::filter_rows_without_limit(BlockScanState &blockscan_s
   return ret;
 }
 
+// Late materialization for top n: when the sort directly above keeps only n rows, the rows of the group
+// which are worse than the n-th best sort key are wiped from the bitmap before projecting, so that
+// only the sort key column is read for them. Rows equal to the n-th best key are kept for the ties.
+int ObCOSSTableRowScanner::prune_topn_rows(const ObCSRange &range, const ObCGBitmap *&result_bitmap)
+{
+  int ret = OB_SUCCESS;
+  const int64_t topn_cnt = topn_filter_->get_direct_topn_cnt();
+  const int64_t row_cnt = result_bitmap->popcnt();
+  if (topn_cnt <= 0 || !topn_filter_->is_data_prepared() || nullptr == topn_filter_->cmp_func_ ||
+      row_cnt < topn_cnt * TOPN_PRUNE_MIN_RATIO) {
+    // rows can not be pruned or not worth reading the sort key twice
+  } else {
+    ObDatum *keys = nullptr;
+    ObDatum *nth_keys = nullptr;
+    const bool is_ascending = sql::WHITE_OP_LT == topn_filter_->get_op_type() ||
+                              sql::WHITE_OP_LE == topn_filter_->get_op_type();
+    TopNKeyCompare compare(topn_filter_->cmp_func_, is_ascending, ret);
+    topn_allocator_.reuse();
+    if (OB_ISNULL(keys = static_cast<ObDatum *>(topn_allocator_.alloc(sizeof(ObDatum) * row_cnt * 2)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Fail to alloc topn keys", K(ret), K(row_cnt));
+    } else if (OB_FAIL(read_topn_keys(range, result_bitmap, keys, row_cnt))) {
+      LOG_WARN("Fail to read topn keys", K(ret), K(range), K(row_cnt));
+    } else if (OB_FAIL(topn_bitmap_->copy_from(*result_bitmap))) {
+      LOG_WARN("Fail to copy result bitmap", K(ret));
+    } else {
+      nth_keys = keys + row_cnt;
+      MEMCPY(nth_keys, keys, sizeof(ObDatum) * row_cnt);
+      std::nth_element(nth_keys, nth_keys + topn_cnt - 1, nth_keys + row_cnt, compare);
+      const ObDatum nth_key = nth_keys[topn_cnt - 1];
+      int64_t key_idx = 0;
+      // the keys are read in scan order
+      for (int64_t i = 0; OB_SUCC(ret) && i < range.get_row_count(); ++i) {
+        const ObCSRowId row_id = reverse_scan_ ? range.end_row_id_ - i : range.start_row_id_ + i;
+        if (!topn_bitmap_->test(row_id)) {
+        } else if (compare(nth_key, keys[key_idx++]) && OB_FAIL(topn_bitmap_->wipe(row_id))) {
+          LOG_WARN("Fail to wipe bitmap", K(ret), K(row_id));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        LOG_DEBUG("[COLUMNSTORE] prune topn rows", K(range), K(topn_cnt), K(row_cnt),
+                  "remain_cnt", topn_bitmap_->popcnt());
+        result_bitmap = topn_bitmap_;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObCOSSTableRowScanner::read_topn_keys(
+    const ObCSRange &range,
+    const ObCGBitmap *bitmap,
+    ObDatum *keys,
+    const int64_t key_cnt)
+{
+  int ret = OB_SUCCESS;
+  int64_t read_cnt = 0;
+  sql::ObExpr *key_expr = topn_filter_->get_cg_col_exprs()->at(0);
+  sql::ObEvalCtx &eval_ctx = iter_param_->op_->get_eval_ctx();
+  const uint64_t batch_size = iter_param_->op_->eval_ctx_.get_batch_size();
+  if (OB_FAIL(topn_key_iter_->locate(range, bitmap))) {
+    LOG_WARN("Fail to locate topn key iter", K(ret), K(range));
+  }
+  while (OB_SUCC(ret) && read_cnt < key_cnt) {
+    uint64_t count = 0;
+    if (OB_FAIL(topn_key_iter_->get_next_rows(count, batch_size))) {
+      if (OB_UNLIKELY(OB_ITER_END != ret)) {
+        LOG_WARN("Fail to get rows from topn key iter", K(ret));
+      }
+    }
+    if (OB_LIKELY(OB_SUCCESS == ret || OB_ITER_END == ret)) {
+      if (OB_UNLIKELY(read_cnt + static_cast<int64_t>(count) > key_cnt ||
+                      (0 == count && OB_ITER_END == ret))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("Unexpected topn key count", K(ret), K(read_cnt), K(count), K(key_cnt));
+      } else if (iter_param_->use_new_format()) {
+        ret = OB_SUCCESS;
+        const ObIVector *vec = key_expr->get_vector(eval_ctx);
+        for (uint64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+          bool is_null = false;
+          const char *payload = nullptr;
+          ObLength len = 0;
+          vec->get_payload(i, is_null, payload, len);
+          if (OB_FAIL(keys[read_cnt++].deep_copy(ObDatum(payload, len, is_null), topn_allocator_))) {
+            LOG_WARN("Fail to deep copy topn key", K(ret));
+          }
+        }
+      } else {
+        ret = OB_SUCCESS;
+        const ObDatum *datums = key_expr->locate_batch_datums(eval_ctx);
+        for (uint64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+          if (OB_FAIL(keys[read_cnt++].deep_copy(datums[i], topn_allocator_))) {
+            LOG_WARN("Fail to deep copy topn key", K(ret));
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObCOSSTableRowScanner::inner_filter(
     ObCSRowId &begin,
     int64_t &group_size,
@@ -963,6 +1153,8 @@ int ObCOSSTableRowScanner::filter_group_by_rows()
       LOG_WARN("Failed to locate", K(ret));
     } else if (OB_FAIL(group_by_processor->decide_group_size(group_size_))) {
       LOG_WARN("Failed to decide group size", K(ret));
+    } else if (!group_by_key_iters_.empty() && OB_FAIL(decide_group_by_keys_group_size())) {
+      LOG_WARN("Failed to decide group size of group by keys", K(ret));
     } else if (nullptr != rows_filter_) {
       if (OB_FAIL(rows_filter_->apply(ObCSRange(current_, group_size_)))) {
         LOG_WARN("Fail to apply rows filter", K(ret), K(current_), K(group_size_));
@@ -1011,7 +1203,9 @@ int ObCOSSTableRowScanner::fetch_group_by_rows()
     can_group_by = true;
   } else {
     can_group_by = is_new_group_;
-    if (can_group_by && OB_FAIL(group_by_processor->decide_can_group_by(group_by_col_offset, can_group_by))) {
+    if (can_group_by && group_by_cell_->has_group_by_keys() && OB_FAIL(check_group_by_keys(can_group_by))) {
+      LOG_WARN("Failed to check group by keys", K(ret));
+    } else if (can_group_by && OB_FAIL(group_by_processor->decide_can_group_by(group_by_col_offset, can_group_by))) {
       LOG_WARN("Failed to check group by info", K(ret));
     }
     is_new_group_ = false;
@@ -1083,6 +1277,8 @@ int ObCOSSTableRowScanner::do_group_by()
   ObICGGroupByProcessor *group_by_processor = group_by_iters_.at(0);
   if (OB_FAIL(group_by_processor->read_distinct(group_by_col_offset))) {
     LOG_WARN("Failed to read distinct", K(ret));
+  } else if (group_by_cell_->has_group_by_keys() && OB_FAIL(read_group_by_keys_distinct())) {
+    LOG_WARN("Failed to read distinct of group by keys", K(ret));
   } else if (group_by_cell_->need_read_reference()) {
     const bool need_extract_distinct = group_by_cell_->need_extract_distinct();
     const bool need_do_aggregate = group_by_cell_->need_do_aggregate();
@@ -1094,6 +1290,8 @@ int ObCOSSTableRowScanner::do_group_by()
         if (OB_UNLIKELY(OB_ITER_END != ret)) {
           LOG_WARN("Failed to read ref", K(ret));
         }
+      } else if (group_by_cell_->has_group_by_keys() && OB_FAIL(read_group_by_keys_reference())) {
+        LOG_WARN("Failed to read ref of group by keys", K(ret));
       } else if (0 == group_by_cell_->get_ref_cnt()) {
         continue;
       } else if (need_extract_distinct && OB_FAIL(group_by_cell_->extract_distinct())) {
@@ -1103,7 +1301,9 @@ int ObCOSSTableRowScanner::do_group_by()
           LOG_WARN("Failed to check valid", K(ret));
         }
         for (int64_t i = 0; OB_SUCC(ret) && i < group_by_iters_.count(); ++i) {
-          if (OB_FAIL(group_by_iters_.at(i)->calc_aggregate(0 == i/*is_group_by_col*/))) {
+          if (is_group_by_key_iter(group_by_iters_.at(i))) {
+            // output from dictionary in extract_distinct
+          } else if (OB_FAIL(group_by_iters_.at(i)->calc_aggregate(0 == i/*is_group_by_col*/))) {
             LOG_WARN("Failed to get next group by rows", K(ret), K(i));
           }
         }
@@ -1119,6 +1319,82 @@ int ObCOSSTableRowScanner::do_group_by()
   return ret;
 }
 
+// each secondary group by column should be read from one micro block in the group
+int ObCOSSTableRowScanner::decide_group_by_keys_group_size()
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < group_by_key_iters_.count(); ++i) {
+    int64_t key_group_size = 0;
+    ObICGGroupByProcessor *key_processor = group_by_key_iters_.at(i);
+    if (OB_FAIL(key_processor->locate_micro_index(ObCSRange(current_, group_size_)))) {
+      LOG_WARN("Failed to locate", K(ret), K(i));
+    } else if (OB_FAIL(key_processor->decide_group_size(key_group_size))) {
+      LOG_WARN("Failed to decide group size", K(ret), K(i));
+    } else {
+      group_size_ = MIN(group_size_, key_group_size);
+    }
+  }
+  return ret;
+}
+
+int ObCOSSTableRowScanner::check_group_by_keys(bool &can_group_by)
+{
+  int ret = OB_SUCCESS;
+  const int32_t group_by_col_offset = 0;
+  can_group_by = group_by_key_iters_.count() == group_by_cell_->get_group_by_key_cnt();
+  for (int64_t i = 0; OB_SUCC(ret) && can_group_by && i < group_by_key_iters_.count(); ++i) {
+    int64_t distinct_cnt = -1;
+    if (OB_FAIL(group_by_key_iters_.at(i)->get_group_by_distinct_cnt(group_by_col_offset, distinct_cnt))) {
+      LOG_WARN("Failed to get distinct cnt", K(ret), K(i));
+    } else if (distinct_cnt < 0) {
+      can_group_by = false;
+    } else if (OB_FAIL(group_by_cell_->set_group_by_key_distinct_cnt(i, distinct_cnt))) {
+      LOG_WARN("Failed to set distinct cnt", K(ret), K(i), K(distinct_cnt));
+    }
+  }
+  return ret;
+}
+
+int ObCOSSTableRowScanner::read_group_by_keys_distinct()
+{
+  int ret = OB_SUCCESS;
+  const int32_t group_by_col_offset = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && i < group_by_key_iters_.count(); ++i) {
+    group_by_cell_->switch_group_by_key(i);
+    if (OB_FAIL(group_by_key_iters_.at(i)->read_distinct(group_by_col_offset))) {
+      LOG_WARN("Failed to read distinct", K(ret), K(i));
+    }
+  }
+  group_by_cell_->switch_group_by_key(-1);
+  if (OB_SUCC(ret) && OB_FAIL(group_by_cell_->prepare_group_by_keys())) {
+    LOG_WARN("Failed to prepare group by keys", K(ret));
+  }
+  return ret;
+}
+
+int ObCOSSTableRowScanner::read_group_by_keys_reference()
+{
+  int ret = OB_SUCCESS;
+  const int32_t group_by_col_offset = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && i < group_by_key_iters_.count(); ++i) {
+    if (group_by_cell_->need_read_key_reference(i)) {
+      group_by_cell_->switch_group_by_key(i);
+      // the key column is located with the same range and bitmap, so it ends with the group by column
+      if (OB_FAIL(group_by_key_iters_.at(i)->read_reference(group_by_col_offset))) {
+        LOG_WARN("Failed to read ref", K(ret), K(i));
+        if (OB_ITER_END == ret) {
+          ret = OB_ERR_UNEXPECTED;
+        }
+      }
+    }
+  }
+  group_by_cell_->switch_group_by_key(-1);
+  if (OB_SUCC(ret) && group_by_cell_->get_ref_cnt() > 0 && OB_FAIL(group_by_cell_->combine_group_by_keys())) {
+    LOG_WARN("Failed to combine group by keys", K(ret));
+  }
+  return ret;
+}
+
 int ObCOSSTableRowScanner::init_group_by_info(ObTableAccessContext &context)
 {
   int ret = OB_SUCCESS;
@@ -1146,10 +1422,46 @@ int ObCOSSTableRowScanner::init_group_by_info(ObTableAccessContext &context)
         LOG_WARN("Failed to push group by processor", K(ret), K(i));
       }
     }
+    if (OB_SUCC(ret) && group_by_cell_->has_group_by_keys() && OB_FAIL(init_group_by_key_iters())) {
+      LOG_WARN("Failed to init group by key iters", K(ret));
+    }
   } else if (OB_FAIL(push_group_by_processor(project_iter_))) {
     LOG_WARN("Failed to push group by processor", K(ret));
   }
-  LOG_TRACE("[GROUP BY PUSHDOWN]", K(ret), K(group_by_project_idx_), K(group_by_iters_), KPC(group_by_cell_));
+  LOG_TRACE("[GROUP BY PUSHDOWN]", K(ret), K(group_by_project_idx_), K(group_by_iters_), K(group_by_key_iters_), KPC(group_by_cell_));
+  return ret;
+}
+
+int ObCOSSTableRowScanner::init_group_by_key_iters()
+{
+  int ret = OB_SUCCESS;
+  bool is_valid = true;
+  if (OB_FAIL(group_by_key_iters_.prepare_allocate(group_by_cell_->get_group_by_key_cnt()))) {
+    LOG_WARN("Failed to prepare allocate", K(ret));
+  } else {
+    for (int64_t i = 0; i < group_by_key_iters_.count(); ++i) {
+      group_by_key_iters_.at(i) = nullptr;
+    }
+  }
+  for (int64_t i = 1; OB_SUCC(ret) && is_valid && i < group_by_iters_.count(); ++i) {
+    int64_t key_idx = -1;
+    bool is_key_only = false;
+    if (OB_FAIL(group_by_iters_.at(i)->get_group_by_key_info(key_idx, is_key_only))) {
+      LOG_WARN("Failed to get group by key info", K(ret), K(i));
+    } else if (key_idx < 0) {
+    } else if (!is_key_only || key_idx >= group_by_key_iters_.count()) {
+      is_valid = false;
+    } else {
+      group_by_key_iters_.at(key_idx) = group_by_iters_.at(i);
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && is_valid && i < group_by_key_iters_.count(); ++i) {
+    is_valid = nullptr != group_by_key_iters_.at(i);
+  }
+  if (OB_FAIL(ret) || !is_valid) {
+    // the rows are output without group by
+    group_by_key_iters_.reset();
+  }
   return ret;
 }
 
@@ -81,12 +81,34 @@ public:
                K_(range),
                K_(pending_end_row_id),
                K_(column_group_cnt),
-               K_(getter_projector));
+               K_(getter_projector),
+               KP_(topn_filter),
+               KP_(topn_key_iter));
 protected:
   virtual int inner_get_next_row(const ObDatumRow *&store_row) override;
   virtual int refresh_blockscan_checker(const blocksstable::ObDatumRowkey &rowkey) override;
 private:
   static const ScanState STATE_TRANSITION[BlockScanState::MAX_STATE];
+  // prune rows by top n only if the selected rows are more than n * TOPN_PRUNE_MIN_RATIO
+  static const int64_t TOPN_PRUNE_MIN_RATIO = 2;
+  struct TopNKeyCompare
+  {
+    TopNKeyCompare(common::ObDatumCmpFuncType cmp_func, const bool is_ascending, int &ret)
+      : cmp_func_(cmp_func), is_ascending_(is_ascending), ret_(ret) {}
+    // whether %left is ordered before %right
+    OB_INLINE bool operator()(const ObDatum &left, const ObDatum &right)
+    {
+      int cmp_ret = 0;
+      if (OB_SUCCESS != ret_) {
+      } else if (OB_SUCCESS != (ret_ = cmp_func_(left, right, cmp_ret))) {
+        STORAGE_LOG_RET(WARN, ret_, "Fail to compare topn key", K(left), K(right));
+      }
+      return is_ascending_ ? cmp_ret < 0 : cmp_ret > 0;
+    }
+    common::ObDatumCmpFuncType cmp_func_;
+    bool is_ascending_;
+    int &ret_;
+  };
   virtual int init_row_scanner(
       const ObTableIterParam &param,
       ObTableAccessContext &context,
@@ -106,6 +128,17 @@ private:
       const ObTableIterParam &row_param,
       ObTableAccessContext &context,
       ObITable *table);
+  int init_topn_key_iter(
+      const ObTableIterParam &row_param,
+      ObTableAccessContext &context,
+      ObITable *table);
+  bool is_topn_filter(const sql::ObPushdownFilterExecutor *filter) const;
+  int prune_topn_rows(const ObCSRange &range, const ObCGBitmap *&result_bitmap);
+  int read_topn_keys(
+      const ObCSRange &range,
+      const ObCGBitmap *bitmap,
+      ObDatum *keys,
+      const int64_t key_cnt);
   int extract_group_by_iters();
   int construct_cg_iter_params_for_single_row(
       const ObTableIterParam &row_param,
@@ -144,6 +177,10 @@ private:
   int filter_group_by_rows();
   int fetch_group_by_rows();
   int do_group_by();
+  int decide_group_by_keys_group_size();
+  int check_group_by_keys(bool &can_group_by);
+  int read_group_by_keys_distinct();
+  int read_group_by_keys_reference();
   OB_INLINE bool end_of_scan()
   { return OB_INVALID_CS_ROW_ID == current_ ||
            (reverse_scan_ && current_ < end_) ||
@@ -168,6 +205,15 @@ protected:
 private:
   int init_group_by_info(ObTableAccessContext &context);
   int push_group_by_processor(ObICGIterator *cg_iterator);
+  int init_group_by_key_iters();
+  OB_INLINE bool is_group_by_key_iter(const ObICGGroupByProcessor *processor) const
+  {
+    bool found = false;
+    for (int64_t i = 0; !found && i < group_by_key_iters_.count(); ++i) {
+      found = processor == group_by_key_iters_.at(i);
+    }
+    return found;
+  }
   bool is_new_group_;
   bool reverse_scan_;
   bool is_limit_end_;
@@ -190,7 +236,15 @@ private:
   ObCGIterParamPool *cg_param_pool_;
   const blocksstable::ObDatumRange *range_;
   ObSEArray<ObICGGroupByProcessor*, 2> group_by_iters_;
+  // processors of the secondary group by columns indexed by group by key, empty if any of them
+  // can not be read from dictionary
+  ObSEArray<ObICGGroupByProcessor*, 2> group_by_key_iters_;
   common::ObFixedArray<int32_t, common::ObIAllocator> getter_projector_;
+  // for late materialization of top n
+  sql::ObDynamicFilterExecutor *topn_filter_;
+  ObICGIterator *topn_key_iter_;
+  ObCGBitmap *topn_bitmap_;
+  common::ObArenaAllocator topn_allocator_;
 };
 
 }
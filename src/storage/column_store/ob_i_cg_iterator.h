@@ -151,6 +151,17 @@ public:
    * is_group_by_col: current column is group by column?
    */
   virtual int calc_aggregate(const bool is_group_by_col) = 0;
+  /*
+   * get the distinct count of the column in the micro block of this group, the micro block is opened
+   * distinct_cnt: -1 if the column is not encoded with dictionary
+   */
+  virtual int get_group_by_distinct_cnt(const int32_t group_by_col, int64_t &distinct_cnt) = 0;
+  /*
+   * check whether this column group is a secondary group by column
+   * key_idx: index of the group by key in group by cell, -1 if not
+   * is_key_only: no aggregate other than the group by values on this column
+   */
+  virtual int get_group_by_key_info(int64_t &key_idx, bool &is_key_only) = 0;
 
   virtual int locate_micro_index(const ObCSRange &range) = 0;
   DECLARE_PURE_VIRTUAL_TO_STRING;
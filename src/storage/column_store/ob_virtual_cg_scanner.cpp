@@ -629,7 +629,7 @@ int ObDefaultCGGroupByScanner::decide_can_group_by(
   can_group_by = true;
   const ObCGBitmap *bitmap = nullptr;
   if (OB_FAIL(group_by_cell_->decide_use_group_by(
-    query_range_valid_row_count_, query_range_valid_row_count_, 1, bitmap, can_group_by))) {
+    query_range_valid_row_count_, query_range_valid_row_count_, group_by_cell_->get_group_by_key_space(1), bitmap, can_group_by))) {
     LOG_WARN("Failed to decide use group by", K(ret));
   }
   LOG_DEBUG("[GROUP BY PUSHDOWN]", K(ret), K(query_range_valid_row_count_), K(can_group_by));
@@ -682,5 +682,20 @@ int ObDefaultCGGroupByScanner::calc_aggregate(const bool is_group_by_col)
   return ret;
 }
 
+int ObDefaultCGGroupByScanner::get_group_by_key_info(int64_t &key_idx, bool &is_key_only)
+{
+  int ret = OB_SUCCESS;
+  key_idx = -1;
+  is_key_only = false;
+  if (OB_ISNULL(output_exprs_) || OB_UNLIKELY(1 != output_exprs_->count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected output exprs", K(ret), KPC_(output_exprs));
+  } else {
+    key_idx = group_by_cell_->find_group_by_key(output_exprs_->at(0));
+    is_key_only = key_idx >= 0 && 1 == group_by_agg_idxs_.count() && 1 == group_by_agg_idxs_.at(0).count();
+  }
+  return ret;
+}
+
 }
 }
@@ -144,6 +144,13 @@ public:
   virtual int read_distinct(const int32_t group_by_col) override;
   virtual int read_reference(const int32_t group_by_col) override;
   virtual int calc_aggregate(const bool is_group_by_col) override;
+  virtual int get_group_by_distinct_cnt(const int32_t group_by_col, int64_t &distinct_cnt) override
+  {
+    UNUSED(group_by_col);
+    distinct_cnt = 1;
+    return common::OB_SUCCESS;
+  }
+  virtual int get_group_by_key_info(int64_t &key_idx, bool &is_key_only) override;
   virtual int locate_micro_index(const ObCSRange &range) override
   { return locate(range, nullptr); }
   INHERIT_TO_STRING_KV("ObDefaultCGScanner", ObDefaultCGScanner,
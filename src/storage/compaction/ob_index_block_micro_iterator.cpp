@@ -26,7 +26,7 @@ namespace compaction
 ObMacroBlockDataIterator::ObMacroBlockDataIterator()
   : macro_buf_(nullptr), macro_buf_size_(0), range_(),
     micro_block_infos_(nullptr), endkeys_(nullptr),
-    cur_micro_cursor_(0), is_inited_(false) {}
+    cur_micro_cursor_(0), shared_dict_reader_(), compress_dict_(), is_inited_(false) {}
 
 ObMacroBlockDataIterator::~ObMacroBlockDataIterator()
 {
@@ -39,6 +39,8 @@ void ObMacroBlockDataIterator::reset()
   macro_buf_size_ = 0;
   cur_micro_cursor_ = 0;
   range_.reset();
+  shared_dict_reader_.reset();
+  compress_dict_.reset();
 }
 
 int ObMacroBlockDataIterator::init(
@@ -69,9 +71,13 @@ int ObMacroBlockDataIterator::init(
     LOG_WARN("Macro block type not supported for data iterator", K(ret));
   } else if (OB_FAIL(macro_header.deserialize(macro_block_buf, macro_block_buf_size, read_pos))) {
     LOG_WARN("fail to deserialize macro block header", K(ret), K(macro_header));
+  } else if (FALSE_IT(macro_buf_ = macro_block_buf)) {
+  } else if (FALSE_IT(macro_buf_size_ = macro_block_buf_size)) {
+  } else if (OB_FAIL(init_shared_dict(macro_header))) {
+    LOG_WARN("fail to init shared dict", K(ret), K(macro_header));
+  } else if (OB_FAIL(init_compress_dict(macro_header))) {
+    LOG_WARN("fail to init compress dict", K(ret), K(macro_header));
   } else {
-    macro_buf_ = macro_block_buf;
-    macro_buf_size_ = macro_block_buf_size;
     if (nullptr == range) {
       range_.set_whole_range();
     } else {
@@ -120,6 +126,8 @@ int ObMacroBlockDataIterator::next_micro_block(ObMicroBlock &micro_block)
       micro_block.data_.get_buf_size() = micro_buf_size;
       micro_block.payload_data_.get_buf() = payload_buf;
       micro_block.payload_data_.get_buf_size() = payload_size;
+      micro_block.data_.shared_dict_ = shared_dict_reader_.is_inited() ? &shared_dict_reader_ : nullptr;
+      micro_block.data_.compress_dict_ = compress_dict_;
       if (0 == cur_micro_cursor_) {
         micro_range.start_key_ = range_.get_start_key();
       } else {
@@ -136,6 +144,38 @@ int ObMacroBlockDataIterator::next_micro_block(ObMicroBlock &micro_block)
   return ret;
 }
 
+int ObMacroBlockDataIterator::init_shared_dict(const ObSSTableMacroBlockHeader &macro_header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t dict_offset = macro_header.shared_dict_offset_;
+  const int64_t dict_size = macro_header.shared_dict_size_;
+  shared_dict_reader_.reset();
+  if (!macro_header.has_shared_dict()) {
+  } else if (OB_UNLIKELY(dict_offset <= 0 || dict_offset + dict_size > macro_buf_size_)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid shared dict position", K(ret), K(dict_offset), K(dict_size), K_(macro_buf_size));
+  } else if (OB_FAIL(shared_dict_reader_.init(macro_buf_ + dict_offset, dict_size))) {
+    LOG_WARN("fail to init shared dict reader", K(ret), K(dict_offset), K(dict_size));
+  }
+  return ret;
+}
+
+int ObMacroBlockDataIterator::init_compress_dict(const ObSSTableMacroBlockHeader &macro_header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t dict_offset = macro_header.compress_dict_offset_;
+  const int64_t dict_size = macro_header.compress_dict_size_;
+  compress_dict_.reset();
+  if (!macro_header.has_compress_dict()) {
+  } else if (OB_UNLIKELY(dict_offset <= 0 || dict_offset + dict_size > macro_buf_size_)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid compress dict position", K(ret), K(dict_offset), K(dict_size), K_(macro_buf_size));
+  } else {
+    compress_dict_.assign_ptr(macro_buf_ + dict_offset, static_cast<int32_t>(dict_size));
+  }
+  return ret;
+}
+
 ObIndexBlockMicroIterator::ObIndexBlockMicroIterator()
   : data_iter_(), range_(), micro_block_(),
     macro_handle_(), allocator_("IBMI_IOUB", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID()), is_inited_(false) {}
@@ -22,6 +22,7 @@
 #include "storage/blocksstable/ob_macro_block_reader.h"
 #include "storage/blocksstable/index_block/ob_index_block_dual_meta_iterator.h"
 #include "storage/blocksstable/ob_block_manager.h"
+#include "storage/blocksstable/cs_encoding/ob_cs_shared_dict.h"
 
 namespace oceanbase
 {
@@ -55,6 +56,9 @@ public:
   OB_INLINE int64_t get_micro_index() const { return cur_micro_cursor_; }
 
   OB_INLINE int64_t get_range_block_count();
+private:
+  int init_shared_dict(const blocksstable::ObSSTableMacroBlockHeader &macro_header);
+  int init_compress_dict(const blocksstable::ObSSTableMacroBlockHeader &macro_header);
 private:
   const char *macro_buf_;
   int64_t macro_buf_size_;
@@ -62,6 +66,8 @@ private:
   const common::ObIArray<blocksstable::ObMicroIndexInfo> *micro_block_infos_;
   const common::ObIArray<blocksstable::ObDatumRowkey> *endkeys_;
   int64_t cur_micro_cursor_;
+  blocksstable::ObCSSharedDictReader shared_dict_reader_;
+  common::ObString compress_dict_;
   bool is_inited_;
 };
 
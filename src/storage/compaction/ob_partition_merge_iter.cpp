@@ -1092,6 +1092,7 @@ int ObPartitionMicroMergeIter::open_curr_micro_block(const int64_t start_row_id)
     LOG_WARN("Unexpected micro block", K(ret), KPC(curr_micro_block_));
   } else if (OB_FAIL(micro_index_info->row_header_->fill_micro_des_meta(false, micro_des_meta))) {
     LOG_WARN("Fail to fill micro block deserialize meta", K(ret), KPC(micro_index_info));
+  } else if (FALSE_IT(macro_reader_.set_compress_dict(curr_micro_block_->data_.compress_dict_))) {
   } else if (OB_FAIL(macro_reader_.decrypt_and_decompress_data(
       micro_des_meta,
       curr_micro_block_->data_.get_buf(),
@@ -1100,6 +1101,7 @@ int ObPartitionMicroMergeIter::open_curr_micro_block(const int64_t start_row_id)
       decompressed_data.get_buf_size(),
       is_compressed))) {
     LOG_WARN("Failed to decrypt and decompress data", K(ret), KPC_(curr_micro_block));
+  } else if (FALSE_IT(decompressed_data.shared_dict_ = curr_micro_block_->data_.shared_dict_)) {
   } else if (table_->is_normal_cg_sstable()) {
     ObCSRange range;
     range.start_row_id_ = MAX(0, start_row_id);
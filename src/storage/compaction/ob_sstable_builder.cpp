@@ -289,8 +289,14 @@ int ObSSTableBuilder::check_need_rebuild(const ObStaticMergeParam &merge_param,
 
     if (OB_LIKELY(ret == OB_ITER_END)) {
       ret = OB_SUCCESS;
+      bool is_movable = true;
       if (iter.get_macro_block_count() * REBUILD_MACRO_BLOCK_THRESOLD / 100 >= reduce_macro_block_cnt) {
         macro_id_array.reset();
+      } else if (OB_FAIL(check_macro_blocks_movable(macro_id_array, is_movable))) {
+        STORAGE_LOG(WARN, "fail to check macro blocks movable", K(ret), K(macro_id_array));
+      } else if (!is_movable) {
+        STORAGE_LOG(INFO, "skip rebuild since micro blocks depend on their macro blocks", K(macro_id_array));
+        macro_id_array.reset();
       }
     }
   }
@@ -298,6 +304,60 @@ int ObSSTableBuilder::check_need_rebuild(const ObStaticMergeParam &merge_param,
   return ret;
 }
 
+int ObSSTableBuilder::check_macro_blocks_movable(
+    const ObIArray<blocksstable::MacroBlockId> &macro_id_array,
+    bool &is_movable)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator io_allocator("SSRMB_IOUB", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID());
+  char *io_buf = nullptr;
+  is_movable = true;
+  if (macro_id_array.empty()) {
+  } else if (OB_ISNULL(io_buf = reinterpret_cast<char*>(io_allocator.alloc(common::OB_DEFAULT_MACRO_BLOCK_SIZE)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "failed to alloc read buffer", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && is_movable && i < macro_id_array.count(); ++i) {
+    blocksstable::ObMacroBlockHandle macro_handle;
+    blocksstable::ObMacroBlockReadInfo read_info;
+    read_info.macro_block_id_ = macro_id_array.at(i);
+    read_info.offset_ = 0;
+    read_info.size_ = common::OB_DEFAULT_MACRO_BLOCK_SIZE;
+    read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_COMPACT_READ);
+    read_info.buf_ = io_buf;
+    if (OB_FAIL(blocksstable::ObBlockManager::read_block(read_info, macro_handle))) {
+      STORAGE_LOG(WARN, "fail to read macro block", K(ret), K(read_info));
+    } else if (OB_FAIL(check_macro_block_movable(macro_handle.get_buffer(), macro_handle.get_data_size(), is_movable))) {
+      STORAGE_LOG(WARN, "fail to check macro block movable", K(ret), K(read_info));
+    }
+  }
+  return ret;
+}
+
+int ObSSTableBuilder::check_macro_block_movable(const char *buf, const int64_t buf_size, bool &is_movable)
+{
+  int ret = OB_SUCCESS;
+  blocksstable::ObMacroBlockCommonHeader common_header;
+  blocksstable::ObSSTableMacroBlockHeader macro_header;
+  int64_t pos = 0;
+  is_movable = true;
+  if (OB_FAIL(common_header.deserialize(buf, buf_size, pos))) {
+    STORAGE_LOG(WARN, "fail to deserialize common header", K(ret), KP(buf), K(buf_size));
+  } else if (OB_FAIL(common_header.check_integrity())) {
+    STORAGE_LOG(WARN, "invalid common header", K(ret), K(common_header));
+  } else if (OB_UNLIKELY(!common_header.is_sstable_data_block())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "not a data macro block", K(ret), K(common_header));
+  } else if (OB_FAIL(macro_header.deserialize(buf, buf_size, pos))) {
+    STORAGE_LOG(WARN, "fail to deserialize macro header", K(ret), K(common_header));
+  } else if (macro_header.has_shared_dict() || macro_header.has_compress_dict()) {
+    // references of shared dict and data compressed with compress dict are only valid in the
+    // macro block they are written
+    is_movable = false;
+  }
+  return ret;
+}
+
 int ObSSTableBuilder::check_cur_macro_need_merge(
     const int64_t last_macro_blocks_sum,
     const blocksstable::ObDataMacroBlockMeta &curr_macro_meta,
@@ -106,6 +106,12 @@ private:
                          MetaIter &iter,
                          int64_t &multiplexed_macro_block_count);
   int pre_check_rebuild(const ObStaticMergeParam &merge_param, bool &need_check_rebuild);
+  // micro blocks of the input may depend on dicts stored in their own macro blocks, which are
+  // written whenever the feature was enabled, so check the macro block headers instead of config
+  int check_macro_blocks_movable(
+      const ObIArray<blocksstable::MacroBlockId> &macro_id_array,
+      bool &is_movable);
+  static int check_macro_block_movable(const char *buf, const int64_t buf_size, bool &is_movable);
   bool check_macro_block_could_merge(const blocksstable::ObDataMacroBlockMeta &macro_meta) const
   {
     return data_store_desc_.get_desc().get_row_store_type() == macro_meta.val_.row_store_type_
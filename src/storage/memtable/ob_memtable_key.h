@@ -20,6 +20,7 @@
 #include "lib/oblog/ob_log_module.h"
 #include "share/schema/ob_table_schema.h"
 #include "share/schema/ob_table_param.h"
+#include "storage/memtable/mvcc/ob_keybtree_deps.h"
 
 namespace oceanbase
 {
@@ -303,6 +304,11 @@ public:
   int checksum(common::ObBatchChecksum &bc) const { return rowkey_->checksum(bc); }
   int64_t to_string(char *buf, const int64_t buf_len) const { return rowkey_->to_string(buf, buf_len); }
   const ObObj *get_ptr() const { return rowkey_->get_obj_ptr(); }
+  void get_key_prefix(uint64_t &prefix, uint8_t &prefix_type) const
+  {
+    const ObObj *first_obj = rowkey_->get_obj_cnt() > 0 ? rowkey_->get_obj_ptr() : nullptr;
+    keybtree::get_obj_key_prefix(first_obj, prefix, prefix_type);
+  }
   const char *repr() const { return rowkey_->repr(); }
 public:
   const common::ObStoreRowkey *rowkey_;
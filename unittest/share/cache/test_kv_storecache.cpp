@@ -1124,6 +1124,94 @@ TEST_F(TestKVCache, get_mb_list)
   ASSERT_EQ(MAX_TENANT_NUM_PER_SERVER, inst_map.list_pool_.get_total());
 }
 
+TEST(ObKVCacheFreqSketch, estimate_and_age)
+{
+  ObKVCacheFreqSketch sketch;
+  const uint64_t hash = 0x1234567887654321UL;
+  const uint64_t other_hash = 0x0FEDCBA987654321UL;
+  const int64_t max_freq = ObKVCacheFreqSketch::MAX_FREQ;
+  const int64_t sample_size = ObKVCacheFreqSketch::WIDTH * ObKVCacheFreqSketch::SAMPLE_FACTOR;
+
+  // not inited
+  sketch.increment(hash);
+  ASSERT_EQ(0, sketch.estimate(hash));
+  ASSERT_EQ(OB_SUCCESS, sketch.init());
+  ASSERT_EQ(OB_INIT_TWICE, sketch.init());
+
+  for (int64_t i = 0; i < 3; ++i) {
+    sketch.increment(hash);
+  }
+  ASSERT_EQ(3, sketch.estimate(hash));
+  ASSERT_EQ(0, sketch.estimate(other_hash));
+
+  // counters saturate
+  for (int64_t i = 0; i < 2 * max_freq; ++i) {
+    sketch.increment(hash);
+  }
+  ASSERT_EQ(max_freq, sketch.estimate(hash));
+
+  // counters are halved after sample size increments
+  sketch.increment(other_hash);
+  sketch.add_cnt_ = sample_size - 1;
+  sketch.increment(other_hash);
+  ASSERT_EQ(max_freq / 2, sketch.estimate(hash));
+  ASSERT_EQ(1, sketch.estimate(other_hash));
+  ASSERT_EQ(sample_size / 2, sketch.add_cnt_);
+  sketch.destroy();
+  ASSERT_FALSE(sketch.is_inited());
+}
+
+TEST_F(TestKVCache, test_admission)
+{
+  static const int64_t K_SIZE = 16;
+  static const int64_t V_SIZE = 64;
+  typedef TestKVCacheKey<K_SIZE> TestKey;
+  typedef TestKVCacheValue<V_SIZE> TestValue;
+
+  ObKVCache<TestKey, TestValue> cache;
+  TestKey key;
+  TestValue value;
+  const TestValue *pvalue = NULL;
+  ObKVCacheHandle handle;
+  ASSERT_EQ(OB_SUCCESS, cache.init("test_admission"));
+  ASSERT_EQ(OB_SUCCESS, cache.set_admission(true));
+
+  // key not read before is put into probation memblock, and promoted on the first get after put
+  key.v_ = 1;
+  key.tenant_id_ = tenant_id_;
+  value.v_ = 1;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(PROBATION, handle.mb_handle_->policy_);
+  ASSERT_EQ(1, pvalue->v_);
+  handle.reset();
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(LRU, handle.mb_handle_->policy_);
+  ASSERT_EQ(1, pvalue->v_);
+  handle.reset();
+
+  // key missed frequently before put is admitted into lru memblock directly
+  key.v_ = 2;
+  value.v_ = 2;
+  for (int64_t i = 0; i < ObKVGlobalCache::ADMISSION_FREQ_THRESHOLD; ++i) {
+    ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(key, pvalue, handle));
+  }
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(LRU, handle.mb_handle_->policy_);
+  handle.reset();
+
+  // admission disabled
+  ASSERT_EQ(OB_SUCCESS, cache.set_admission(false));
+  key.v_ = 3;
+  value.v_ = 3;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(LRU, handle.mb_handle_->policy_);
+  handle.reset();
+  cache.destroy();
+}
+
 /*
 TEST(ObSyncWashRt, sync_wash_mb_rt)
 {
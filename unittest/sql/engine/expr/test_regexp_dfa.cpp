@@ -0,0 +1,331 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <icu/i18n/unicode/uregex.h>
+#include "lib/allocator/page_arena.h"
+#include "lib/oblog/ob_log.h"
+#include "sql/engine/expr/ob_expr_regexp_dfa.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+// The DFA fast path must give the same answer as ICU whenever it decides.
+class TestRegexpDfa : public ::testing::Test
+{
+public:
+  TestRegexpDfa() : alloc_("TestRegexpDfa") {}
+  virtual void TearDown() { alloc_.reset(); }
+
+protected:
+  // decode well formed UTF-8 to UTF-16 code units
+  static std::vector<UChar> to_utf16(const std::string &utf8)
+  {
+    std::vector<UChar> res;
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(utf8.data());
+    for (size_t i = 0; i < utf8.size();) {
+      uint32_t cp = p[i];
+      int64_t n = 0;
+      if (cp < 0x80) {
+        n = 0;
+      } else if ((cp >> 5) == 0x6) {
+        cp &= 0x1F;
+        n = 1;
+      } else if ((cp >> 4) == 0xE) {
+        cp &= 0x0F;
+        n = 2;
+      } else {
+        cp &= 0x07;
+        n = 3;
+      }
+      for (int64_t j = 1; j <= n; j++) {
+        cp = (cp << 6) | (p[i + j] & 0x3F);
+      }
+      i += n + 1;
+      if (cp >= 0x10000) {
+        cp -= 0x10000;
+        res.push_back(static_cast<UChar>(0xD800 + (cp >> 10)));
+        res.push_back(static_cast<UChar>(0xDC00 + (cp & 0x3FF)));
+      } else {
+        res.push_back(static_cast<UChar>(cp));
+      }
+    }
+    return res;
+  }
+  // big endian UTF-16 bytes, the charset of pattern and utf16 text in regexp context
+  static std::string to_utf16be(const std::string &utf8)
+  {
+    std::vector<UChar> u = to_utf16(utf8);
+    std::string res;
+    for (size_t i = 0; i < u.size(); i++) {
+      res.push_back(static_cast<char>(u[i] >> 8));
+      res.push_back(static_cast<char>(u[i] & 0xFF));
+    }
+    return res;
+  }
+  static bool icu_find(const std::string &pattern, const uint32_t flags, const std::string &text)
+  {
+    UErrorCode err = U_ZERO_ERROR;
+    UParseError parse_err;
+    std::vector<UChar> u_pattern = to_utf16(pattern);
+    std::vector<UChar> u_text = to_utf16(text);
+    UChar dummy = 0;
+    URegularExpression *re = uregex_open(u_pattern.empty() ? &dummy : &u_pattern[0],
+                                         static_cast<int32_t>(u_pattern.size()),
+                                         flags, &parse_err, &err);
+    EXPECT_TRUE(U_SUCCESS(err)) << pattern;
+    bool found = false;
+    if (U_SUCCESS(err)) {
+      uregex_setText(re, u_text.empty() ? &dummy : &u_text[0],
+                     static_cast<int32_t>(u_text.size()), &err);
+      found = uregex_find(re, 0, &err);
+      EXPECT_TRUE(U_SUCCESS(err)) << pattern;
+    }
+    uregex_close(re);
+    return found;
+  }
+  bool compile(ObExprRegexDfa &dfa, const std::string &pattern, const uint32_t flags)
+  {
+    bool supported = false;
+    std::string u_pattern = to_utf16be(pattern);
+    EXPECT_EQ(OB_SUCCESS, dfa.init(alloc_, ObString(u_pattern.size(), u_pattern.data()),
+                                   flags, supported));
+    return supported;
+  }
+  // match UTF-8 and UTF-16 text, return the decided result, UNDECIDED is returned only if
+  // both are undecided.
+  ObExprRegexDfa::MatchResult dfa_match(const ObExprRegexDfa &dfa, const std::string &text)
+  {
+    std::string u_text = to_utf16be(text);
+    ObExprRegexDfa::MatchResult res8 = dfa.match(ObString(text.size(), text.data()), false);
+    ObExprRegexDfa::MatchResult res16 = dfa.match(ObString(u_text.size(), u_text.data()), true);
+    if (ObExprRegexDfa::UNDECIDED != res8 && ObExprRegexDfa::UNDECIDED != res16) {
+      EXPECT_EQ(res8, res16) << text;
+    }
+    return ObExprRegexDfa::UNDECIDED != res8 ? res8 : res16;
+  }
+  // the pattern must be supported and every text decided with the same result as ICU
+  void check_decided(const std::string &pattern, const uint32_t flags,
+                     const std::vector<std::string> &texts)
+  {
+    ObExprRegexDfa dfa;
+    ASSERT_TRUE(compile(dfa, pattern, flags)) << pattern;
+    for (size_t i = 0; i < texts.size(); i++) {
+      const bool expect = icu_find(pattern, flags, texts[i]);
+      ObExprRegexDfa::MatchResult res = dfa_match(dfa, texts[i]);
+      ASSERT_NE(ObExprRegexDfa::UNDECIDED, res) << pattern << " ~ " << texts[i];
+      EXPECT_EQ(expect, ObExprRegexDfa::MATCH == res) << pattern << " ~ " << texts[i];
+    }
+  }
+  void check_unsupported(const std::string &pattern, const uint32_t flags)
+  {
+    ObExprRegexDfa dfa;
+    EXPECT_FALSE(compile(dfa, pattern, flags)) << pattern;
+    EXPECT_FALSE(dfa.is_inited());
+  }
+
+protected:
+  ObArenaAllocator alloc_;
+};
+
+TEST_F(TestRegexpDfa, anchors)
+{
+  std::vector<std::string> texts = {"", "abc", "xabc", "abcx", "ab", "abcabc", "abc\n", "abc\r\n",
+                                    "abc\n\n", "abc\r", "\nabc", "abc\xc2\x85", "abc\xe2\x80\xa8"};
+  check_decided("abc", 0, texts);
+  check_decided("^abc", 0, texts);
+  check_decided("abc$", 0, texts);
+  check_decided("^abc$", 0, texts);
+  check_decided("^(abc)+$", 0, texts);
+  check_decided("^$", 0, texts);
+  check_decided("^", 0, texts);
+  check_decided("$", 0, texts);
+  check_decided("abc$", UREGEX_UNIX_LINES, texts);
+  check_decided("^abc$", UREGEX_DOTALL, texts);
+  check_decided("^a.c$", UREGEX_DOTALL, texts);
+}
+
+TEST_F(TestRegexpDfa, escapes)
+{
+  std::vector<std::string> texts = {"a.b", "axb", "a*b", "a+b", "(a)", "[x]", "a\\b", "a\tb",
+                                    "a\nb", "a\rb", "a\fb", "a\x07" "b", "a\x1b" "b", "a|b",
+                                    "{1}", "^$", "?"};
+  check_decided("a\\.b", 0, texts);
+  check_decided("a\\*b", 0, texts);
+  check_decided("a\\+b", 0, texts);
+  check_decided("\\(a\\)", 0, texts);
+  check_decided("\\[x\\]", 0, texts);
+  check_decided("a\\\\b", 0, texts);
+  check_decided("a\\tb", 0, texts);
+  check_decided("a\\nb", 0, texts);
+  check_decided("a\\rb", 0, texts);
+  check_decided("a\\fb", 0, texts);
+  check_decided("a\\ab", 0, texts);
+  check_decided("a\\eb", 0, texts);
+  check_decided("a\\|b", 0, texts);
+  check_decided("\\{1\\}", 0, texts);
+  check_decided("\\^\\$", 0, texts);
+  check_decided("\\?", 0, texts);
+  check_decided("a.b", 0, texts);
+  check_decided("a.b", UREGEX_DOTALL, texts);
+  check_decided("a.b", UREGEX_UNIX_LINES, texts);
+}
+
+TEST_F(TestRegexpDfa, classes)
+{
+  std::vector<std::string> texts = {"", "a", "z", "A", "Z", "0", "9", "_", "-", " ", "\t", "\n",
+                                    "]", "^", "\\", "ab12", "x-y", "a b", "..."};
+  check_decided("[abc]", 0, texts);
+  check_decided("[^abc]", 0, texts);
+  check_decided("[a-z]+", 0, texts);
+  check_decided("^[a-zA-Z0-9_]+$", 0, texts);
+  check_decided("[-a]", 0, texts);
+  check_decided("[a-]", 0, texts);
+  check_decided("[\\]]", 0, texts);
+  check_decided("[\\^x]", 0, texts);
+  check_decided("[\\\\]", 0, texts);
+  check_decided("[\\d]", 0, texts);
+  check_decided("\\d+", 0, texts);
+  check_decided("^\\D*$", 0, texts);
+  check_decided("\\w", 0, texts);
+  check_decided("^\\W+$", 0, texts);
+  check_decided("\\s", 0, texts);
+  check_decided("^\\S+$", 0, texts);
+  check_decided("[\\s\\d]", 0, texts);
+  check_decided("^(a|b|ab)(1|12)?$", 0, texts);
+  check_decided("^a{2,3}$", 0, {"a", "aa", "aaa", "aaaa"});
+  check_decided("^(ab){2}$", 0, {"ab", "abab", "ababab"});
+  check_decided("^a{2,}?$", 0, {"a", "aa", "aaaaaa"});
+  check_decided("^(?:a|bc)*d$", 0, {"d", "ad", "bcad", "bd", "abcbcd"});
+  check_decided("a+?b", 0, {"b", "ab", "aab"});
+}
+
+TEST_F(TestRegexpDfa, case_insensitive)
+{
+  std::vector<std::string> texts = {"abc", "ABC", "aBc", "xAbCx", "ab", "ABD", "[", "`", "@", "{",
+                                    "Z", "z"};
+  check_decided("abc", UREGEX_CASE_INSENSITIVE, texts);
+  check_decided("^aBc$", UREGEX_CASE_INSENSITIVE, texts);
+  check_decided("[a-c]+d", UREGEX_CASE_INSENSITIVE, texts);
+  check_decided("[^a-z]", UREGEX_CASE_INSENSITIVE, texts);
+  check_decided("[Z]", UREGEX_CASE_INSENSITIVE, texts);
+
+  // the fold of non-ASCII characters is not known by DFA
+  ObExprRegexDfa dfa;
+  ASSERT_TRUE(compile(dfa, "k", UREGEX_CASE_INSENSITIVE));
+  EXPECT_EQ(ObExprRegexDfa::UNDECIDED, dfa_match(dfa, "\xe2\x84\xaa"));  // KELVIN SIGN
+  EXPECT_EQ(ObExprRegexDfa::UNDECIDED, dfa_match(dfa, "\xc3\xa9"));
+  EXPECT_EQ(ObExprRegexDfa::MATCH, dfa_match(dfa, "K"));
+  EXPECT_TRUE(icu_find("k", UREGEX_CASE_INSENSITIVE, "\xe2\x84\xaa"));
+}
+
+TEST_F(TestRegexpDfa, non_ascii)
+{
+  std::vector<std::string> texts = {"", "\xc3\xa9", "a\xc3\xa9" "b", "\xe4\xb8\xad\xe6\x96\x87",
+                                    "\xf0\x9f\x98\x80", "a\xf0\x9f\x98\x80" "b", "ab",
+                                    "a\xe2\x80\xa8" "b", "a\xc2\x85" "b", "a\xe2\x80\xa9" "b"};
+  check_decided("a.b", 0, texts);
+  check_decided("a.b", UREGEX_DOTALL, texts);
+  check_decided("a.b", UREGEX_UNIX_LINES, texts);
+  check_decided("^.$", 0, texts);
+  check_decided("^.*$", 0, texts);
+  check_decided("^..$", 0, texts);
+  check_decided("[^a]", 0, texts);
+  check_decided("^[^x]+$", 0, texts);
+  check_decided("ab", 0, texts);
+  check_decided("^a", 0, texts);
+
+  // \d \w \s have Unicode semantic in ICU
+  ObExprRegexDfa dfa;
+  ASSERT_TRUE(compile(dfa, "\\d", 0));
+  EXPECT_EQ(ObExprRegexDfa::UNDECIDED, dfa_match(dfa, "\xd9\xa3"));  // ARABIC-INDIC DIGIT THREE
+  EXPECT_EQ(ObExprRegexDfa::MATCH, dfa_match(dfa, "3"));
+
+  // malformed UTF-8 is left to ICU
+  ObExprRegexDfa dfa2;
+  ASSERT_TRUE(compile(dfa2, "a.b", 0));
+  std::string bad("a\xc3" "b");
+  EXPECT_EQ(ObExprRegexDfa::UNDECIDED, dfa2.match(ObString(bad.size(), bad.data()), false));
+  std::string bad16("\x00" "a" "\xdc\x00" "\x00" "b", 6);
+  EXPECT_EQ(ObExprRegexDfa::UNDECIDED, dfa2.match(ObString(bad16.size(), bad16.data()), true));
+}
+
+TEST_F(TestRegexpDfa, unsupported)
+{
+  check_unsupported("(a)\\1", 0);
+  check_unsupported("a(?=b)", 0);
+  check_unsupported("a(?!b)", 0);
+  check_unsupported("\\bab", 0);
+  check_unsupported("a++", 0);
+  check_unsupported("\xc3\xa9", 0);
+  check_unsupported("\\p{L}", 0);
+  check_unsupported("^a", UREGEX_MULTILINE);
+  check_unsupported("a", UREGEX_COMMENTS);
+  // leading ']' in class is left to ICU
+  check_unsupported("[]a]", 0);
+}
+
+// random patterns over a small alphabet, compared with ICU on random texts
+TEST_F(TestRegexpDfa, random)
+{
+  const char *atoms[] = {"a", "b", ".", "[ab]", "[^a]", "\\d", "\\w", "\\s", "\xc3\xa9", "x"};
+  const char *texts_alphabet[] = {"a", "b", "1", " ", "\n", "x", "\xc3\xa9", "\xe4\xb8\xad", "_"};
+  const char *quants[] = {"", "", "*", "+", "?", "{1,2}", "*?"};
+  srand(20240601);
+  int64_t decided_cnt = 0;
+  for (int64_t i = 0; i < 1000; i++) {
+    std::string pattern;
+    if (0 == rand() % 3) {
+      pattern += "^";
+    }
+    const int64_t atom_cnt = 1 + rand() % 4;
+    for (int64_t j = 0; j < atom_cnt; j++) {
+      std::string atom = atoms[rand() % ARRAYSIZEOF(atoms)];
+      if (0 == rand() % 5) {
+        atom = "(" + atom + "|" + atoms[rand() % ARRAYSIZEOF(atoms)] + ")";
+      }
+      pattern += atom + quants[rand() % ARRAYSIZEOF(quants)];
+    }
+    if (0 == rand() % 3) {
+      pattern += "$";
+    }
+    const uint32_t flags = (0 == rand() % 4) ? UREGEX_CASE_INSENSITIVE : 0;
+    ObExprRegexDfa dfa;
+    if (!compile(dfa, pattern, flags)) {
+      continue;
+    }
+    for (int64_t k = 0; k < 20; k++) {
+      std::string text;
+      const int64_t len = rand() % 6;
+      for (int64_t j = 0; j < len; j++) {
+        text += texts_alphabet[rand() % ARRAYSIZEOF(texts_alphabet)];
+      }
+      ObExprRegexDfa::MatchResult res = dfa_match(dfa, text);
+      if (ObExprRegexDfa::UNDECIDED != res) {
+        decided_cnt++;
+        ASSERT_EQ(icu_find(pattern, flags, text), ObExprRegexDfa::MATCH == res)
+          << pattern << " ~ " << text;
+      }
+    }
+  }
+  EXPECT_GT(decided_cnt, 0);
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("WARN");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
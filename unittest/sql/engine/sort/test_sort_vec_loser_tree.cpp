@@ -0,0 +1,203 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "lib/oblog/ob_log_module.h"
+#include "lib/allocator/page_arena.h"
+#include "lib/random/ob_random.h"
+#include "sql/engine/sort/ob_sort_vec_op_loser_tree.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+// sorted run of the merge, like the sort chunk.
+struct SortRun
+{
+  SortRun() : pos_(0) {}
+  int64_t cur() const { return rows_.at(pos_); }
+  bool next() { return ++pos_ < static_cast<int64_t>(rows_.size()); }
+  std::vector<int64_t> rows_;
+  int64_t pos_;
+};
+
+struct RunCompare
+{
+  RunCompare(const bool desc) : desc_(desc), cmp_cnt_(0) {}
+  // returns true if r should be output before l
+  bool operator()(const SortRun *l, const SortRun *r)
+  {
+    cmp_cnt_++;
+    return desc_ ? l->cur() < r->cur() : l->cur() > r->cur();
+  }
+  int get_error_code() const { return OB_SUCCESS; }
+  bool desc_;
+  int64_t cmp_cnt_;
+};
+
+typedef ObSortVecOpLoserTree<SortRun *, RunCompare> LoserTree;
+
+class TestSortVecLoserTree : public ::testing::Test
+{
+public:
+  TestSortVecLoserTree() : alloc_("LoserTreeUT") {}
+
+  void gen_runs(const int64_t run_cnt, const int64_t max_rows, const bool desc,
+                std::vector<SortRun> &runs, std::vector<int64_t> &all)
+  {
+    runs.clear();
+    runs.resize(run_cnt);
+    all.clear();
+    for (int64_t i = 0; i < run_cnt; i++) {
+      // some runs are empty
+      const int64_t row_cnt = ObRandom::rand(0, max_rows);
+      for (int64_t j = 0; j < row_cnt; j++) {
+        // small value domain to have many equal rows among runs
+        runs[i].rows_.push_back(ObRandom::rand(-100, 100));
+      }
+      if (desc) {
+        std::sort(runs[i].rows_.begin(), runs[i].rows_.end(), std::greater<int64_t>());
+      } else {
+        std::sort(runs[i].rows_.begin(), runs[i].rows_.end());
+      }
+      all.insert(all.end(), runs[i].rows_.begin(), runs[i].rows_.end());
+    }
+    if (desc) {
+      std::sort(all.begin(), all.end(), std::greater<int64_t>());
+    } else {
+      std::sort(all.begin(), all.end());
+    }
+  }
+
+  void merge(LoserTree &tree, std::vector<SortRun> &runs, std::vector<int64_t> &res)
+  {
+    res.clear();
+    for (int64_t i = 0; i < static_cast<int64_t>(runs.size()); i++) {
+      ASSERT_EQ(OB_SUCCESS, tree.push(runs[i].rows_.empty() ? nullptr : &runs[i]));
+    }
+    ASSERT_EQ(OB_SUCCESS, tree.build());
+    while (!tree.empty()) {
+      SortRun *top = tree.top();
+      ASSERT_TRUE(nullptr != top);
+      res.push_back(top->cur());
+      if (top->next()) {
+        ASSERT_EQ(OB_SUCCESS, tree.replace_top(top));
+      } else {
+        ASSERT_EQ(OB_SUCCESS, tree.pop());
+      }
+    }
+  }
+
+  void check_merge(const int64_t run_cnt, const int64_t max_rows, const bool desc)
+  {
+    std::vector<SortRun> runs;
+    std::vector<int64_t> all;
+    std::vector<int64_t> res;
+    RunCompare cmp(desc);
+    LoserTree tree(cmp, &alloc_);
+    gen_runs(run_cnt, max_rows, desc, runs, all);
+    ASSERT_EQ(OB_SUCCESS, tree.init(run_cnt));
+    merge(tree, runs, res);
+    ASSERT_EQ(all, res) << "run_cnt: " << run_cnt << " desc: " << desc;
+  }
+
+protected:
+  ObArenaAllocator alloc_;
+};
+
+TEST_F(TestSortVecLoserTree, merge_runs)
+{
+  const int64_t run_cnts[] = {1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 31, 64, 100, 257};
+  for (int64_t i = 0; i < ARRAYSIZEOF(run_cnts); i++) {
+    check_merge(run_cnts[i], 50, false);
+    check_merge(run_cnts[i], 50, true);
+  }
+}
+
+TEST_F(TestSortVecLoserTree, all_runs_empty)
+{
+  std::vector<SortRun> runs(5);
+  std::vector<int64_t> res;
+  RunCompare cmp(false);
+  LoserTree tree(cmp, &alloc_);
+  ASSERT_EQ(OB_SUCCESS, tree.init(5));
+  merge(tree, runs, res);
+  ASSERT_TRUE(res.empty());
+
+  // no players at all
+  tree.reuse();
+  ASSERT_EQ(OB_SUCCESS, tree.build());
+  ASSERT_TRUE(tree.empty());
+}
+
+TEST_F(TestSortVecLoserTree, reuse_and_overflow)
+{
+  RunCompare cmp(false);
+  LoserTree tree(cmp, &alloc_);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, tree.init(0));
+  ASSERT_EQ(OB_SUCCESS, tree.init(4));
+  SortRun run;
+  run.rows_.push_back(1);
+  for (int64_t i = 0; i < 4; i++) {
+    ASSERT_EQ(OB_SUCCESS, tree.push(&run));
+  }
+  ASSERT_EQ(OB_SIZE_OVERFLOW, tree.push(&run));
+
+  // smaller fan-in reuses the nodes, larger one allocates new nodes
+  std::vector<SortRun> runs;
+  std::vector<int64_t> all;
+  std::vector<int64_t> res;
+  const int64_t fan_ins[] = {3, 4, 10, 2};
+  for (int64_t i = 0; i < ARRAYSIZEOF(fan_ins); i++) {
+    gen_runs(fan_ins[i], 30, false, runs, all);
+    ASSERT_EQ(OB_SUCCESS, tree.init(fan_ins[i]));
+    merge(tree, runs, res);
+    ASSERT_EQ(all, res);
+  }
+}
+
+// replacing the champion replays one leaf to root path, log(k) comparisons per row.
+TEST_F(TestSortVecLoserTree, compare_count)
+{
+  const int64_t run_cnt = 64;
+  const int64_t rows_per_run = 100;
+  std::vector<SortRun> runs(run_cnt);
+  std::vector<int64_t> res;
+  for (int64_t i = 0; i < run_cnt; i++) {
+    for (int64_t j = 0; j < rows_per_run; j++) {
+      runs[i].rows_.push_back(j * run_cnt + i);
+    }
+  }
+  RunCompare cmp(false);
+  LoserTree tree(cmp, &alloc_);
+  ASSERT_EQ(OB_SUCCESS, tree.init(run_cnt));
+  merge(tree, runs, res);
+  ASSERT_EQ(run_cnt * rows_per_run, static_cast<int64_t>(res.size()));
+  ASSERT_TRUE(std::is_sorted(res.begin(), res.end()));
+  // build: k - 1 matches, every replay: log2(64) = 6 matches
+  ASSERT_LE(cmp.cmp_cnt_, (run_cnt - 1) + run_cnt * rows_per_run * 6);
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -22,6 +22,7 @@
 #include "share/ob_cluster_version.h"
 #include "storage/blocksstable/ob_block_sstable_struct.h"
 #include "storage/blocksstable/cs_encoding/ob_column_encoding_struct.h"
+#include "storage/blocksstable/cs_encoding/ob_cs_shared_dict.h"
 #include "storage/blocksstable/cs_encoding/ob_micro_block_cs_decoder.h"
 #include "storage/blocksstable/cs_encoding/ob_micro_block_cs_encoder.h"
 #include "storage/blocksstable/ob_decode_resource_pool.h"
@@ -43,7 +44,7 @@ using namespace share::schema;
 class ObCSEncodingTestBase
 {
 public:
-  ObCSEncodingTestBase(): tenant_ctx_(500)
+  ObCSEncodingTestBase(): tenant_ctx_(500), shared_dict_(nullptr)
   {
     decode_res_pool_ = new(allocator_.alloc(sizeof(ObDecodeResourcePool))) ObDecodeResourcePool;
     tenant_ctx_.set(decode_res_pool_);
@@ -91,6 +92,7 @@ protected:
   int64_t column_cnt_;
   share::ObTenantBase tenant_ctx_;
   ObDecodeResourcePool *decode_res_pool_;
+  const ObICSSharedDictProvider *shared_dict_; // for micro blocks with shared dict
 };
 
 int ObCSEncodingTestBase::prepare(const ObObjType *col_types, const int64_t rowkey_cnt,
@@ -239,6 +241,7 @@ int ObCSEncodingTestBase::init_cs_decoder(const ObMicroBlockHeader *header,
   } else {
     full_transformed_data.buf_ = buf;
     full_transformed_data.size_ = buf_len;
+    full_transformed_data.shared_dict_ = shared_dict_;
     if (OB_FAIL(decoder.init(full_transformed_data, read_info_))) {
       LOG_WARN("fail to init decoder", K(ret));
     }
@@ -408,6 +411,7 @@ int ObCSEncodingTestBase::part_transform_check_row(const ObMicroBlockHeader *hea
   const char *block_buf = desc.buf_  - header->header_size_;
   const int64_t block_buf_len = desc.buf_size_ + header->header_size_;
   ObMicroBlockData part_transformed_data(block_buf, block_buf_len);
+  part_transformed_data.shared_dict_ = shared_dict_;
   int32_t project_step = 1;
   for (int project_step = 1; OB_SUCC(ret) && project_step < ctx_.column_cnt_; project_step++) {
     ObDatumRow row;
@@ -0,0 +1,295 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <cfloat>
+#include "ob_pd_filter_test_base.h"
+#include "storage/blocksstable/cs_encoding/ob_alp_float_util.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+class TestALPFloatPdFilter : public ObPdFilterTestBase
+{
+public:
+  enum ValueMode
+  {
+    DECIMAL_ONLY = 0, // all values are encoded without exceptions
+    WITH_SPECIAL,     // NaN, inf, -0.0, denormal and high precision values as exceptions
+    NAN_ONLY,
+  };
+
+  double gen_value(const int64_t row_id, const ValueMode mode);
+  void set_value(const bool is_float, const double value, ObDatum &datum);
+  void set_value(const bool is_float, const double value, ObObj &obj);
+  void check_float_filter(const ObWhiteFilterOperatorType op_type,
+                          const bool is_float,
+                          const double *refs,
+                          const int64_t ref_cnt,
+                          const ObDatumRow *row_arr,
+                          const int64_t row_cnt,
+                          ObMicroBlockCSDecoder &decoder);
+  void check_alp_float_column(const bool is_float, const ValueMode mode);
+};
+
+double TestALPFloatPdFilter::gen_value(const int64_t row_id, const ValueMode mode)
+{
+  double value = (row_id % 97) * 0.25 - 10;
+  if (NAN_ONLY == mode) {
+    value = NAN;
+  } else if (DECIMAL_ONLY == mode) {
+  } else if (0 == row_id % 37) {
+    value = NAN;
+  } else if (0 == row_id % 41) {
+    value = INFINITY;
+  } else if (0 == row_id % 43) {
+    value = -INFINITY;
+  } else if (0 == row_id % 47) {
+    value = -0.0;
+  } else if (0 == row_id % 53) {
+    value = 0 == row_id % 2 ? DBL_MIN / 2 : FLT_MIN / 2;
+  } else if (0 == row_id % 59) {
+    value = 1.0 / 3;
+  }
+  return value;
+}
+
+void TestALPFloatPdFilter::set_value(const bool is_float, const double value, ObDatum &datum)
+{
+  if (is_float) {
+    datum.set_float(static_cast<float>(value));
+  } else {
+    datum.set_double(value);
+  }
+}
+
+void TestALPFloatPdFilter::set_value(const bool is_float, const double value, ObObj &obj)
+{
+  if (is_float) {
+    obj.set_float(static_cast<float>(value));
+  } else {
+    obj.set_double(value);
+  }
+}
+
+void TestALPFloatPdFilter::check_float_filter(
+    const ObWhiteFilterOperatorType op_type,
+    const bool is_float,
+    const double *refs,
+    const int64_t ref_cnt,
+    const ObDatumRow *row_arr,
+    const int64_t row_cnt,
+    ObMicroBlockCSDecoder &decoder)
+{
+  const int64_t col_offset = 1;
+  const ObObjMeta &col_meta = col_descs_.at(col_offset).col_type_;
+  ObArray<ObObj> ref_objs;
+  ObDatum ref_datums[2];
+  char ref_bufs[2][sizeof(double)];
+  for (int64_t i = 0; i < ref_cnt; ++i) {
+    ObObj obj;
+    set_value(is_float, refs[i], obj);
+    ASSERT_EQ(OB_SUCCESS, ref_objs.push_back(obj));
+    ref_datums[i].ptr_ = ref_bufs[i];
+    ASSERT_EQ(OB_SUCCESS, ref_datums[i].from_obj(obj));
+  }
+  // expected results follow the datum compare of sql, NaN is bigger than any number
+  const ObDatumCmpFuncType cmp_func = ref_cnt > 0 ? get_datum_cmp_func(col_meta, ref_objs.at(0).get_meta()) : nullptr;
+  int64_t expect_cnt = 0;
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    const ObDatum &datum = row_arr[i].storage_datums_[col_offset];
+    bool is_match = false;
+    if (sql::WHITE_OP_NU == op_type) {
+      is_match = datum.is_null();
+    } else if (sql::WHITE_OP_NN == op_type) {
+      is_match = !datum.is_null();
+    } else if (datum.is_null()) {
+    } else {
+      int cmp = 0;
+      ASSERT_EQ(OB_SUCCESS, cmp_func(datum, ref_datums[0], cmp));
+      switch (op_type) {
+        case sql::WHITE_OP_EQ: is_match = 0 == cmp; break;
+        case sql::WHITE_OP_NE: is_match = 0 != cmp; break;
+        case sql::WHITE_OP_GT: is_match = cmp > 0; break;
+        case sql::WHITE_OP_GE: is_match = cmp >= 0; break;
+        case sql::WHITE_OP_LT: is_match = cmp < 0; break;
+        case sql::WHITE_OP_LE: is_match = cmp <= 0; break;
+        case sql::WHITE_OP_BT: {
+          int right_cmp = 0;
+          ASSERT_EQ(OB_SUCCESS, cmp_func(datum, ref_datums[1], right_cmp));
+          is_match = cmp >= 0 && right_cmp <= 0;
+          break;
+        }
+        default: break;
+      }
+    }
+    expect_cnt += is_match ? 1 : 0;
+  }
+  ASSERT_EQ(OB_SUCCESS, check_column_store_white_filter(op_type, row_cnt, ctx_.column_cnt_,
+      col_offset, col_meta, ref_objs, decoder, expect_cnt)) << "op_type: " << op_type
+      << ", ref: " << (ref_cnt > 0 ? refs[0] : 0);
+}
+
+void TestALPFloatPdFilter::check_alp_float_column(const bool is_float, const ValueMode mode)
+{
+  const int64_t rowkey_cnt = 1;
+  const int64_t col_cnt = 2;
+  ObObjType col_types[col_cnt] = {ObInt32Type, is_float ? ObFloatType : ObDoubleType};
+  ASSERT_EQ(OB_SUCCESS, prepare(col_types, rowkey_cnt, col_cnt));
+  ctx_.major_working_cluster_version_ = DATA_VERSION_4_3_2_0;
+  ctx_.column_encodings_[0] = ObCSColumnHeader::Type::INTEGER;
+  ctx_.column_encodings_[1] = ObCSColumnHeader::Type::ALP_FLOAT;
+
+  for (int8_t flag = 0; flag <= 1; ++flag) {
+    const bool has_null = flag;
+    const int64_t null_cnt = has_null ? 20 : 0;
+    const int64_t row_cnt = 300 + null_cnt;
+    ObMicroBlockCSEncoder encoder;
+    ASSERT_EQ(OB_SUCCESS, encoder.init(ctx_));
+    ObDatumRow row_arr[row_cnt];
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      ASSERT_EQ(OB_SUCCESS, row_arr[i].init(allocator_, col_cnt));
+      row_arr[i].storage_datums_[0].set_int32(i);
+      if (i >= row_cnt - null_cnt) {
+        row_arr[i].storage_datums_[1].set_null();
+      } else {
+        set_value(is_float, gen_value(i, mode), row_arr[i].storage_datums_[1]);
+      }
+      ASSERT_EQ(OB_SUCCESS, encoder.append_row(row_arr[i]));
+    }
+
+    // decode by full and part transform, get by rowkey
+    HANDLE_TRANSFORM();
+    ASSERT_EQ(ObCSColumnHeader::Type::ALP_FLOAT, encoder.encoders_.at(1)->get_type());
+    ASSERT_EQ(ObCSColumnHeader::Type::ALP_FLOAT, decoder.decoders_[1].ctx_->type_);
+    const ObALPFloatMeta &alp_meta = *decoder.decoders_[1].ctx_->alp_float_ctx_.alp_meta_;
+    ASSERT_EQ(is_float, alp_meta.is_float());
+    ASSERT_EQ(DECIMAL_ONLY != mode, alp_meta.has_nan());
+    ASSERT_EQ(NAN_ONLY != mode, alp_meta.has_value());
+    // fields of the meta are packed, copy them out before compare
+    const int64_t exception_cnt = alp_meta.exception_cnt_;
+    const double min = alp_meta.min_;
+    const double max = alp_meta.max_;
+    if (DECIMAL_ONLY == mode) {
+      ASSERT_EQ(0, exception_cnt);
+      ASSERT_EQ(-10, min);
+      ASSERT_EQ(14, max);
+    } else {
+      ASSERT_LT(0, exception_cnt);
+    }
+
+    // random access decode, special values are restored bit by bit
+    ObDatumRow row;
+    ASSERT_EQ(OB_SUCCESS, row.init(allocator_, col_cnt));
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      const int64_t row_idx = (i * 7919) % row_cnt;
+      ASSERT_EQ(OB_SUCCESS, decoder.get_row(row_idx, row));
+      ASSERT_TRUE(ObDatum::binary_equal(row_arr[row_idx].storage_datums_[1], row.storage_datums_[1])) << row_idx;
+    }
+
+    // out of the block range to check pruning by min and max
+    const double refs[] = {0.0, -0.0, 1.25, -10, 14, 1.0 / 3, DBL_MIN / 2, NAN, INFINITY, -INFINITY, 1e10, -1e10};
+    const int64_t ref_cnt = ARRAYSIZEOF(refs);
+    const ObWhiteFilterOperatorType cmp_ops[] = {
+      sql::WHITE_OP_EQ, sql::WHITE_OP_NE, sql::WHITE_OP_GT, sql::WHITE_OP_GE, sql::WHITE_OP_LT, sql::WHITE_OP_LE};
+    for (int64_t i = 0; i < ref_cnt; ++i) {
+      for (int64_t j = 0; j < ARRAYSIZEOF(cmp_ops); ++j) {
+        check_float_filter(cmp_ops[j], is_float, refs + i, 1, row_arr, row_cnt, decoder);
+      }
+    }
+    const double bt_refs[][2] = {{-1, 5}, {-INFINITY, NAN}, {NAN, NAN}, {1e10, NAN}, {5, -1}, {-1e10, -20}};
+    for (int64_t i = 0; i < ARRAYSIZEOF(bt_refs); ++i) {
+      check_float_filter(sql::WHITE_OP_BT, is_float, bt_refs[i], 2, row_arr, row_cnt, decoder);
+    }
+    check_float_filter(sql::WHITE_OP_NU, is_float, nullptr, 0, row_arr, row_cnt, decoder);
+    check_float_filter(sql::WHITE_OP_NN, is_float, nullptr, 0, row_arr, row_cnt, decoder);
+  }
+}
+
+TEST_F(TestALPFloatPdFilter, test_compare)
+{
+  ASSERT_EQ(0, ObALPFloatUtil::compare(NAN, NAN));
+  ASSERT_EQ(1, ObALPFloatUtil::compare(NAN, INFINITY));
+  ASSERT_EQ(-1, ObALPFloatUtil::compare(INFINITY, NAN));
+  ASSERT_EQ(-1, ObALPFloatUtil::compare(-INFINITY, -1e300));
+  ASSERT_EQ(0, ObALPFloatUtil::compare(-0.0, 0.0));
+  ASSERT_EQ(1, ObALPFloatUtil::compare(DBL_MIN / 2, 0.0));
+}
+
+TEST_F(TestALPFloatPdFilter, test_alp_double_decimal)
+{
+  check_alp_float_column(false /*is_float*/, DECIMAL_ONLY);
+}
+
+TEST_F(TestALPFloatPdFilter, test_alp_double_special_values)
+{
+  check_alp_float_column(false /*is_float*/, WITH_SPECIAL);
+}
+
+TEST_F(TestALPFloatPdFilter, test_alp_double_nan_only)
+{
+  check_alp_float_column(false /*is_float*/, NAN_ONLY);
+}
+
+TEST_F(TestALPFloatPdFilter, test_alp_float_decimal)
+{
+  check_alp_float_column(true /*is_float*/, DECIMAL_ONLY);
+}
+
+TEST_F(TestALPFloatPdFilter, test_alp_float_special_values)
+{
+  check_alp_float_column(true /*is_float*/, WITH_SPECIAL);
+}
+
+TEST_F(TestALPFloatPdFilter, test_choose_alp_by_data_version)
+{
+  const int64_t rowkey_cnt = 1;
+  const int64_t col_cnt = 2;
+  const int64_t row_cnt = 400;
+  ObObjType col_types[col_cnt] = {ObInt32Type, ObDoubleType};
+  ASSERT_EQ(OB_SUCCESS, prepare(col_types, rowkey_cnt, col_cnt));
+  ObDatumRow row_arr[row_cnt];
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    ASSERT_EQ(OB_SUCCESS, row_arr[i].init(allocator_, col_cnt));
+    row_arr[i].storage_datums_[0].set_int32(i);
+    row_arr[i].storage_datums_[1].set_double(i * 0.01 + 1000);
+  }
+
+  // the blocks of ALP_FLOAT can not be read by servers before 4.3.2.0
+  const int64_t versions[2] = {DATA_VERSION_4_3_1_0, DATA_VERSION_4_3_2_0};
+  for (int64_t i = 0; i < 2; ++i) {
+    ctx_.major_working_cluster_version_ = versions[i];
+    ObMicroBlockCSEncoder encoder;
+    ASSERT_EQ(OB_SUCCESS, encoder.init(ctx_));
+    for (int64_t j = 0; j < row_cnt; ++j) {
+      ASSERT_EQ(OB_SUCCESS, encoder.append_row(row_arr[j]));
+    }
+    ObMicroBlockDesc micro_block_desc;
+    ObMicroBlockHeader *header = nullptr;
+    ASSERT_EQ(OB_SUCCESS, build_micro_block_desc(encoder, micro_block_desc, header));
+    ASSERT_EQ(0 == i, ObCSColumnHeader::Type::ALP_FLOAT != encoder.encoders_.at(1)->get_type());
+    ASSERT_EQ(OB_SUCCESS, full_transform_check_row(header, micro_block_desc, row_arr, row_cnt, true));
+  }
+}
+
+}  // namespace blocksstable
+}  // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_alp_float_pd_filter.log*");
+  OB_LOGGER.set_file_name("test_alp_float_pd_filter.log", true, false);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,227 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_pd_filter_test_base.h"
+#include "storage/blocksstable/cs_encoding/ob_cs_shared_dict.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+class TestCSSharedDict : public ObPdFilterTestBase
+{
+public:
+  static const int64_t rowkey_cnt = 1;
+  static const int64_t col_cnt = 3;
+  static const int64_t char_data_arr_cnt = 6;
+  static const int64_t each_type_cnt = 25;
+  static const int64_t null_cnt = 20;
+  static const int64_t row_cnt = 4 * each_type_cnt + null_cnt;
+
+  virtual void SetUp() override;
+  virtual void TearDown() override;
+
+protected:
+  // the varchar column of rows of value %idx is %char_data_arr[idx] with length 10 * (idx + 1),
+  // the char column is %char_data_arr[idx] with length 100.
+  void fill_rows(const int64_t start_idx, ObMicroBlockCSEncoder &encoder, ObDatumRow *row_arr);
+
+  ObObjType col_types[col_cnt] = {ObInt32Type, ObVarcharType, ObCharType};
+  char *char_data_arr[char_data_arr_cnt];
+  ObCSSharedDictBuilder builder_;
+};
+
+const int64_t TestCSSharedDict::char_data_arr_cnt;
+const int64_t TestCSSharedDict::each_type_cnt;
+const int64_t TestCSSharedDict::null_cnt;
+const int64_t TestCSSharedDict::row_cnt;
+
+void TestCSSharedDict::SetUp()
+{
+  ASSERT_EQ(OB_SUCCESS, prepare(col_types, rowkey_cnt, col_cnt));
+  ctx_.column_encodings_[0] = ObCSColumnHeader::Type::INT_DICT;
+  ctx_.column_encodings_[1] = ObCSColumnHeader::Type::STR_DICT;
+  ctx_.column_encodings_[2] = ObCSColumnHeader::Type::STR_DICT;
+  ctx_.major_working_cluster_version_ = DATA_VERSION_4_3_2_0;
+  ASSERT_EQ(OB_SUCCESS, builder_.init(allocator_));
+  ctx_.shared_dict_builder_ = &builder_;
+  shared_dict_ = &builder_;
+  const char char_type_arr[char_data_arr_cnt] = {'a', 'b', 'c', 'd', 'e', 'f'};
+  for (int64_t i = 0; i < char_data_arr_cnt; ++i) {
+    char_data_arr[i] = static_cast<char *>(allocator_.alloc(1024));
+    ASSERT_TRUE(nullptr != char_data_arr[i]);
+    MEMSET(char_data_arr[i], char_type_arr[i], 1024);
+  }
+}
+
+void TestCSSharedDict::TearDown()
+{
+  ctx_.shared_dict_builder_ = nullptr;
+  shared_dict_ = nullptr;
+  builder_.reset();
+  reuse();
+}
+
+void TestCSSharedDict::fill_rows(const int64_t start_idx, ObMicroBlockCSEncoder &encoder, ObDatumRow *row_arr)
+{
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    ASSERT_EQ(OB_SUCCESS, row_arr[i].init(allocator_, col_cnt));
+  }
+  for (int64_t idx = 0; idx < 4; ++idx) {
+    for (int64_t i = each_type_cnt * idx; i < each_type_cnt * (idx + 1); ++i) {
+      row_arr[i].storage_datums_[0].set_int32(i);
+      row_arr[i].storage_datums_[1].set_string(char_data_arr[start_idx + idx], 10 * (start_idx + idx + 1));
+      row_arr[i].storage_datums_[2].set_string(char_data_arr[start_idx + idx], 100);
+      ASSERT_EQ(OB_SUCCESS, encoder.append_row(row_arr[i]));
+    }
+  }
+  for (int64_t i = row_cnt - null_cnt; i < row_cnt; ++i) {
+    row_arr[i].storage_datums_[0].set_int32(i);
+    row_arr[i].storage_datums_[1].set_null();
+    row_arr[i].storage_datums_[2].set_null();
+    ASSERT_EQ(OB_SUCCESS, encoder.append_row(row_arr[i]));
+  }
+}
+
+TEST_F(TestCSSharedDict, test_shared_dict_round_trip)
+{
+  const bool enable_check = true;
+  const int64_t col_offset = 1;
+  bool need_check = true;
+
+  // first micro block: values a..d
+  {
+    ObMicroBlockCSEncoder encoder;
+    ASSERT_EQ(OB_SUCCESS, encoder.init(ctx_));
+    ObDatumRow row_arr[row_cnt];
+    fill_rows(0, encoder, row_arr);
+
+    HANDLE_TRANSFORM();
+    ASSERT_TRUE(header->has_shared_dict());
+    const ObCSSharedDictColumn *dict_col = nullptr;
+    ASSERT_EQ(OB_SUCCESS, builder_.get_column_dict(1, dict_col));
+    ASSERT_TRUE(nullptr != dict_col);
+    ASSERT_EQ(4, dict_col->dict_cnt_);
+
+    {
+      std::pair<int64_t, int64_t> ref_arr[1] = {{0, 10}};
+      int64_t res_arr_nu[1] = {null_cnt};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_NU, 1, 0, res_arr_nu);
+      int64_t res_arr_nn[1] = {row_cnt - null_cnt};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_NN, 1, 0, res_arr_nn);
+    }
+    {
+      std::pair<int64_t, int64_t> ref_arr[3] = {{0, 10}, {1, 20}, {1, 30}};
+      int64_t res_arr_eq[3] = {each_type_cnt, each_type_cnt, 0};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_EQ, 3, 1, res_arr_eq);
+      int64_t res_arr_ne[3] = {3 * each_type_cnt, 3 * each_type_cnt, 4 * each_type_cnt};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_NE, 3, 1, res_arr_ne);
+      int64_t res_arr_gt[3] = {3 * each_type_cnt, 2 * each_type_cnt, 2 * each_type_cnt};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_GT, 3, 1, res_arr_gt);
+    }
+  }
+  // the micro block is written into macro block
+  builder_.commit();
+
+  // second micro block: values c..f, c and d are referenced from the committed dict
+  {
+    ObMicroBlockCSEncoder encoder;
+    ASSERT_EQ(OB_SUCCESS, encoder.init(ctx_));
+    ObDatumRow row_arr[row_cnt];
+    fill_rows(2, encoder, row_arr);
+
+    HANDLE_TRANSFORM();
+    ASSERT_TRUE(header->has_shared_dict());
+    const ObCSSharedDictColumn *dict_col = nullptr;
+    ASSERT_EQ(OB_SUCCESS, builder_.get_column_dict(1, dict_col));
+    ASSERT_TRUE(nullptr != dict_col);
+    ASSERT_EQ(char_data_arr_cnt, dict_col->dict_cnt_);
+
+    {
+      std::pair<int64_t, int64_t> ref_arr[1] = {{0, 10}};
+      int64_t res_arr_nu[1] = {null_cnt};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_NU, 1, 0, res_arr_nu);
+      int64_t res_arr_nn[1] = {row_cnt - null_cnt};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_NN, 1, 0, res_arr_nn);
+    }
+    // shared dict has values not in the micro block, and is not sorted
+    {
+      std::pair<int64_t, int64_t> ref_arr[4] = {{0, 10}, {2, 30}, {5, 60}, {2, 100}};
+      int64_t res_arr_eq[4] = {0, each_type_cnt, each_type_cnt, 0};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_EQ, 4, 1, res_arr_eq);
+      int64_t res_arr_ne[4] = {4 * each_type_cnt, 3 * each_type_cnt, 3 * each_type_cnt, 4 * each_type_cnt};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_NE, 4, 1, res_arr_ne);
+    }
+    {
+      std::pair<int64_t, int64_t> ref_arr[3] = {{1, 20}, {3, 40}, {5, 60}};
+      int64_t res_arr_gt[3] = {4 * each_type_cnt, 2 * each_type_cnt, 0};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_GT, 3, 1, res_arr_gt);
+      int64_t res_arr_lt[3] = {0, each_type_cnt, 3 * each_type_cnt};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_LT, 3, 1, res_arr_lt);
+    }
+    {
+      std::pair<int64_t, int64_t> ref_arr[3] = {{0, 10}, {2, 30}, {4, 50}};
+      int64_t res_arr[1] = {2 * each_type_cnt};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_IN, 1, 3, res_arr);
+    }
+    {
+      std::pair<int64_t, int64_t> ref_arr[2] = {{2, 30}, {4, 50}};
+      int64_t res_arr[1] = {3 * each_type_cnt};
+      string_type_filter_normal_check(true, ObWhiteFilterOperatorType::WHITE_OP_BT, 1, 2, res_arr);
+    }
+
+    // read the micro block with the serialized shared dict stored in macro block
+    builder_.commit();
+    const int64_t dict_size = builder_.get_serialize_size();
+    char *dict_buf = static_cast<char *>(allocator_.alloc(dict_size));
+    ASSERT_TRUE(nullptr != dict_buf);
+    int64_t pos = 0;
+    ASSERT_EQ(OB_SUCCESS, builder_.serialize(dict_buf, dict_size, pos));
+    ASSERT_EQ(dict_size, pos);
+    ObCSSharedDictReader reader;
+    ASSERT_EQ(OB_SUCCESS, reader.init(dict_buf, dict_size));
+    shared_dict_ = &reader;
+    ASSERT_EQ(OB_SUCCESS, full_transform_check_row(header, micro_block_desc, row_arr, row_cnt, true));
+    ASSERT_EQ(OB_SUCCESS, part_transform_check_row(header, micro_block_desc, row_arr, row_cnt, true));
+    shared_dict_ = &builder_;
+  }
+}
+
+TEST_F(TestCSSharedDict, test_shared_dict_data_version)
+{
+  // micro block header of older data version has no has_shared_dict_
+  ctx_.major_working_cluster_version_ = cal_version(4, 3, 1, 0);
+  ObMicroBlockCSEncoder encoder;
+  ASSERT_EQ(OB_SUCCESS, encoder.init(ctx_));
+  ObDatumRow row_arr[row_cnt];
+  fill_rows(0, encoder, row_arr);
+
+  HANDLE_TRANSFORM();
+  ASSERT_FALSE(header->has_shared_dict());
+  const ObCSSharedDictColumn *dict_col = nullptr;
+  ASSERT_EQ(OB_SUCCESS, builder_.get_column_dict(1, dict_col));
+  ASSERT_TRUE(nullptr == dict_col);
+  ASSERT_EQ(0, builder_.get_serialize_size());
+}
+
+}  // namespace blocksstable
+}  // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_cs_shared_dict.log*");
+  OB_LOGGER.set_file_name("test_cs_shared_dict.log", true, false);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
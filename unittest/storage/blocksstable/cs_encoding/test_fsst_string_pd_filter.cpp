@@ -0,0 +1,294 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_pd_filter_test_base.h"
+#include "storage/blocksstable/cs_encoding/ob_fsst_symbol_table.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+class TestFSSTStringPdFilter : public ObPdFilterTestBase
+{
+public:
+  static const int64_t DISTINCT_CNT = 50;
+  static const int64_t MAX_STR_LEN = 128;
+
+  void build_string(const int64_t seed, ObString &str);
+  // equality filters are evaluated on the compressed bytes only for binary varchar
+  void set_binary_collation(const int64_t col_idx);
+  void check_string_filter(const ObWhiteFilterOperatorType op_type,
+                           const ObString *refs,
+                           const int64_t ref_cnt,
+                           const ObDatumRow *row_arr,
+                           const int64_t row_cnt,
+                           ObMicroBlockCSDecoder &decoder);
+  void check_fsst_string_column(const bool is_binary);
+};
+
+void TestFSSTStringPdFilter::build_string(const int64_t seed, ObString &str)
+{
+  char *buf = static_cast<char *>(allocator_.alloc(MAX_STR_LEN));
+  ASSERT_TRUE(nullptr != buf);
+  const int64_t len = snprintf(buf, MAX_STR_LEN, "https://www.oceanbase.com/docs/page_%05ld/index.html?lang=en", seed);
+  str.assign_ptr(buf, static_cast<int32_t>(len));
+}
+
+void TestFSSTStringPdFilter::set_binary_collation(const int64_t col_idx)
+{
+  col_descs_.at(col_idx).col_type_.set_collation_type(CS_TYPE_BINARY);
+  read_info_.reset();
+  ASSERT_EQ(OB_SUCCESS, read_info_.init(allocator_, row_generate_.get_schema().get_column_count(),
+      row_generate_.get_schema().get_rowkey_column_num(), lib::is_oracle_mode(), col_descs_, nullptr));
+}
+
+void TestFSSTStringPdFilter::check_string_filter(
+    const ObWhiteFilterOperatorType op_type,
+    const ObString *refs,
+    const int64_t ref_cnt,
+    const ObDatumRow *row_arr,
+    const int64_t row_cnt,
+    ObMicroBlockCSDecoder &decoder)
+{
+  const int64_t col_offset = 1;
+  const ObObjMeta &col_meta = col_descs_.at(col_offset).col_type_;
+  ObArray<ObObj> ref_objs;
+  for (int64_t i = 0; i < ref_cnt; ++i) {
+    ObObj obj;
+    obj.set_varchar(refs[i]);
+    obj.set_collation_type(col_meta.get_collation_type());
+    obj.set_collation_level(CS_LEVEL_IMPLICIT);
+    ASSERT_EQ(OB_SUCCESS, ref_objs.push_back(obj));
+  }
+  int64_t expect_cnt = 0;
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    const ObDatum &datum = row_arr[i].storage_datums_[col_offset];
+    bool is_match = false;
+    if (sql::WHITE_OP_NU == op_type) {
+      is_match = datum.is_null();
+    } else if (sql::WHITE_OP_NN == op_type) {
+      is_match = !datum.is_null();
+    } else if (datum.is_null()) {
+    } else {
+      for (int64_t j = 0; !is_match && j < ref_cnt; ++j) {
+        const int cmp = datum.get_string().compare(refs[j]);
+        switch (op_type) {
+          case sql::WHITE_OP_EQ:
+          case sql::WHITE_OP_IN: is_match = 0 == cmp; break;
+          case sql::WHITE_OP_NE: is_match = 0 != cmp; break;
+          case sql::WHITE_OP_GT: is_match = cmp > 0; break;
+          case sql::WHITE_OP_LE: is_match = cmp <= 0; break;
+          default: break;
+        }
+      }
+    }
+    expect_cnt += is_match ? 1 : 0;
+  }
+  ASSERT_EQ(OB_SUCCESS, check_column_store_white_filter(op_type, row_cnt, ctx_.column_cnt_,
+      col_offset, col_meta, ref_objs, decoder, expect_cnt)) << "op_type: " << op_type;
+}
+
+void TestFSSTStringPdFilter::check_fsst_string_column(const bool is_binary)
+{
+  const int64_t rowkey_cnt = 1;
+  const int64_t col_cnt = 2;
+  ObObjType col_types[col_cnt] = {ObInt32Type, ObVarcharType};
+  ASSERT_EQ(OB_SUCCESS, prepare(col_types, rowkey_cnt, col_cnt));
+  if (is_binary) {
+    set_binary_collation(1);
+  }
+  ctx_.major_working_cluster_version_ = DATA_VERSION_4_3_2_0;
+  ctx_.column_encodings_[0] = ObCSColumnHeader::Type::INTEGER;
+  ctx_.column_encodings_[1] = ObCSColumnHeader::Type::FSST_STRING;
+
+  for (int8_t flag = 0; flag <= 1; ++flag) {
+    const bool has_null = flag;
+    const int64_t null_cnt = has_null ? 20 : 0;
+    const int64_t row_cnt = 200 + null_cnt;
+    ObMicroBlockCSEncoder encoder;
+    ASSERT_EQ(OB_SUCCESS, encoder.init(ctx_));
+    ObDatumRow row_arr[row_cnt];
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      ASSERT_EQ(OB_SUCCESS, row_arr[i].init(allocator_, col_cnt));
+      row_arr[i].storage_datums_[0].set_int32(i);
+      if (i >= row_cnt - null_cnt) {
+        row_arr[i].storage_datums_[1].set_null();
+      } else if (0 == i % 31) {
+        row_arr[i].storage_datums_[1].set_string(ObString::make_empty_string());
+      } else {
+        ObString str;
+        build_string(i % DISTINCT_CNT, str);
+        row_arr[i].storage_datums_[1].set_string(str);
+      }
+      ASSERT_EQ(OB_SUCCESS, encoder.append_row(row_arr[i]));
+    }
+
+    // decode by full and part transform, get by rowkey
+    HANDLE_TRANSFORM();
+    ASSERT_EQ(ObCSColumnHeader::Type::FSST_STRING, encoder.encoders_.at(1)->get_type());
+    ASSERT_EQ(ObCSColumnHeader::Type::FSST_STRING, decoder.decoders_[1].ctx_->type_);
+
+    // random access decode
+    ObDatumRow row;
+    ASSERT_EQ(OB_SUCCESS, row.init(allocator_, col_cnt));
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      const int64_t row_idx = (i * 7919) % row_cnt;
+      ASSERT_EQ(OB_SUCCESS, decoder.get_row(row_idx, row));
+      ASSERT_TRUE(ObDatum::binary_equal(row_arr[row_idx].storage_datums_[1], row.storage_datums_[1])) << row_idx;
+    }
+
+    ObString refs[4];
+    build_string(3, refs[0]);
+    build_string(DISTINCT_CNT + 1, refs[1]);
+    // prefix of a value, must not match on compressed bytes
+    refs[2].assign_ptr(refs[0].ptr(), refs[0].length() - 1);
+    build_string(7, refs[3]);
+    for (int64_t i = 0; i < 4; ++i) {
+      check_string_filter(sql::WHITE_OP_EQ, refs + i, 1, row_arr, row_cnt, decoder);
+      check_string_filter(sql::WHITE_OP_NE, refs + i, 1, row_arr, row_cnt, decoder);
+    }
+    check_string_filter(sql::WHITE_OP_IN, refs, 4, row_arr, row_cnt, decoder);
+    check_string_filter(sql::WHITE_OP_IN, refs + 1, 2, row_arr, row_cnt, decoder);
+    check_string_filter(sql::WHITE_OP_NU, nullptr, 0, row_arr, row_cnt, decoder);
+    check_string_filter(sql::WHITE_OP_NN, nullptr, 0, row_arr, row_cnt, decoder);
+    // range filters are evaluated on decompressed values
+    check_string_filter(sql::WHITE_OP_GT, refs, 1, row_arr, row_cnt, decoder);
+    check_string_filter(sql::WHITE_OP_LE, refs + 3, 1, row_arr, row_cnt, decoder);
+  }
+}
+
+TEST_F(TestFSSTStringPdFilter, test_symbol_table)
+{
+  const int64_t str_cnt = 500;
+  const int64_t max_symbol_cnt = ObFSSTSymbolTable::MAX_SYMBOL_CNT;
+  const int64_t padding_size = ObFSSTSymbolTable::DECOMPRESS_PADDING_SIZE;
+  ObColDatums datums(allocator_);
+  ObString strs[str_cnt + 3];
+  int64_t var_data_size = 0;
+  int64_t max_len = 0;
+  for (int64_t i = 0; i < str_cnt; ++i) {
+    build_string(i, strs[i]);
+    ObDatum datum;
+    datum.set_string(strs[i]);
+    ASSERT_EQ(OB_SUCCESS, datums.push_back(datum));
+    var_data_size += strs[i].length();
+    max_len = MAX(max_len, strs[i].length());
+  }
+  ObFSSTSymbolTable symbol_table;
+  ASSERT_EQ(OB_SUCCESS, symbol_table.build(datums, var_data_size, allocator_));
+  ASSERT_GT(symbol_table.get_symbol_cnt(), 0);
+  ASSERT_LE(symbol_table.get_symbol_cnt(), max_symbol_cnt);
+
+  // serialize and load as in the column meta
+  const int64_t meta_size = symbol_table.get_serialize_size();
+  char *meta_buf = static_cast<char *>(allocator_.alloc(meta_size));
+  ASSERT_TRUE(nullptr != meta_buf);
+  int64_t pos = 0;
+  ASSERT_EQ(OB_BUF_NOT_ENOUGH, symbol_table.serialize(max_len, meta_buf, meta_size - 1, pos));
+  ASSERT_EQ(OB_SUCCESS, symbol_table.serialize(max_len, meta_buf, meta_size, pos));
+  ASSERT_EQ(meta_size, pos);
+  const ObFSSTSymbolTableMeta &meta = *reinterpret_cast<const ObFSSTSymbolTableMeta *>(meta_buf);
+  ASSERT_EQ(symbol_table.get_symbol_cnt(), meta.symbol_cnt_);
+  ASSERT_EQ(max_len, meta.max_string_len_);
+  ObFSSTSymbolTable loaded_table;
+  ASSERT_EQ(OB_SUCCESS, loaded_table.load(meta));
+  ASSERT_EQ(symbol_table.get_symbol_cnt(), loaded_table.get_symbol_cnt());
+
+  // strings out of the samples, escape code as literal and empty string
+  const char escape_str[] = {'\xff', '\0', 'h', 't', 't', 'p', '\xff'};
+  strs[str_cnt].assign_ptr(escape_str, sizeof(escape_str));
+  strs[str_cnt + 1] = ObString::make_empty_string();
+  strs[str_cnt + 2].assign_ptr("no symbol here: ~~~~~~~~ ^^^^ ####", 34);
+  int64_t compressed_size = 0;
+  char comp_buf[2 * MAX_STR_LEN];
+  char loaded_comp_buf[2 * MAX_STR_LEN];
+  char decomp_buf[MAX_STR_LEN + padding_size];
+  for (int64_t i = 0; i < str_cnt + 3; ++i) {
+    const int64_t comp_len = symbol_table.compress(strs[i].ptr(), strs[i].length(), comp_buf);
+    ASSERT_LE(comp_len, 2 * strs[i].length());
+    if (i < str_cnt) {
+      compressed_size += comp_len;
+    }
+    // codes are kept by serialization, the loaded table compresses filter literals the same way
+    ASSERT_EQ(comp_len, loaded_table.compress(strs[i].ptr(), strs[i].length(), loaded_comp_buf));
+    ASSERT_EQ(0, MEMCMP(comp_buf, loaded_comp_buf, comp_len));
+    ASSERT_EQ(strs[i].length(), ObFSSTSymbolTable::get_decompress_len(meta, comp_buf, comp_len));
+    ASSERT_EQ(strs[i].length(), ObFSSTSymbolTable::decompress(meta, comp_buf, comp_len, decomp_buf));
+    ASSERT_EQ(0, MEMCMP(strs[i].ptr(), decomp_buf, strs[i].length())) << i;
+  }
+  ASSERT_LT(compressed_size, var_data_size / 2);
+
+  // all strings are null or empty
+  ObColDatums empty_datums(allocator_);
+  ASSERT_EQ(OB_SUCCESS, symbol_table.build(empty_datums, 0, allocator_));
+  ASSERT_EQ(0, symbol_table.get_symbol_cnt());
+
+  ObFSSTSymbolTableMeta invalid_meta = meta;
+  invalid_meta.version_ = ObFSSTSymbolTableMeta::OB_FSST_SYMBOL_TABLE_META_V1 + 1;
+  ASSERT_EQ(OB_INVALID_DATA, loaded_table.load(invalid_meta));
+}
+
+TEST_F(TestFSSTStringPdFilter, test_fsst_string_decoder_filter_varchar)
+{
+  check_fsst_string_column(false /*is_binary*/);
+}
+
+TEST_F(TestFSSTStringPdFilter, test_fsst_string_decoder_filter_binary)
+{
+  check_fsst_string_column(true /*is_binary*/);
+}
+
+TEST_F(TestFSSTStringPdFilter, test_choose_fsst_by_data_version)
+{
+  const int64_t rowkey_cnt = 1;
+  const int64_t col_cnt = 2;
+  const int64_t row_cnt = 400;
+  ObObjType col_types[col_cnt] = {ObInt32Type, ObVarcharType};
+  ASSERT_EQ(OB_SUCCESS, prepare(col_types, rowkey_cnt, col_cnt));
+  ObDatumRow row_arr[row_cnt];
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    ObString str;
+    build_string(i, str);
+    ASSERT_EQ(OB_SUCCESS, row_arr[i].init(allocator_, col_cnt));
+    row_arr[i].storage_datums_[0].set_int32(i);
+    row_arr[i].storage_datums_[1].set_string(str);
+  }
+
+  // the blocks of FSST_STRING can not be read by servers before 4.3.2.0
+  const int64_t versions[2] = {DATA_VERSION_4_3_1_0, DATA_VERSION_4_3_2_0};
+  for (int64_t i = 0; i < 2; ++i) {
+    ctx_.major_working_cluster_version_ = versions[i];
+    ObMicroBlockCSEncoder encoder;
+    ASSERT_EQ(OB_SUCCESS, encoder.init(ctx_));
+    for (int64_t j = 0; j < row_cnt; ++j) {
+      ASSERT_EQ(OB_SUCCESS, encoder.append_row(row_arr[j]));
+    }
+    ObMicroBlockDesc micro_block_desc;
+    ObMicroBlockHeader *header = nullptr;
+    ASSERT_EQ(OB_SUCCESS, build_micro_block_desc(encoder, micro_block_desc, header));
+    ASSERT_EQ(0 == i, ObCSColumnHeader::Type::FSST_STRING != encoder.encoders_.at(1)->get_type());
+    ASSERT_EQ(OB_SUCCESS, full_transform_check_row(header, micro_block_desc, row_arr, row_cnt, true));
+  }
+}
+
+}  // namespace blocksstable
+}  // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_fsst_string_pd_filter.log*");
+  OB_LOGGER.set_file_name("test_fsst_string_pd_filter.log", true, false);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "storage/blocksstable/ob_micro_block_cache.h"
+#include "share/ob_simple_mem_limit_getter.h"
+
+namespace oceanbase
+{
+using namespace common;
+static ObSimpleMemLimitGetter getter;
+
+namespace blocksstable
+{
+
+class TestCompressedBlockCache : public ::testing::Test
+{
+public:
+  virtual void SetUp();
+  virtual void TearDown();
+protected:
+  ObCompressedMicroBlockCache cache_;
+};
+
+void TestCompressedBlockCache::SetUp()
+{
+  const int64_t bucket_num = 1024;
+  const int64_t max_cache_size = 1024 * 1024 * 512;
+  const int64_t block_size = common::OB_MALLOC_BIG_BLOCK_SIZE;
+  ASSERT_EQ(OB_SUCCESS, getter.add_tenant(OB_SYS_TENANT_ID, 2 * 1024L * 1024L * 1024L,
+                                          4 * 1024L * 1024L * 1024L));
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().init(&getter, bucket_num, max_cache_size, block_size));
+  ASSERT_EQ(OB_SUCCESS, cache_.init("user_compressed_block_cache", 1));
+}
+
+void TestCompressedBlockCache::TearDown()
+{
+  cache_.destroy();
+  ObKVGlobalCache::get_instance().destroy();
+}
+
+TEST_F(TestCompressedBlockCache, test_put_get)
+{
+  const int64_t micro_size = 4096;
+  char block_buf[micro_size];
+  for (int64_t i = 0; i < micro_size; ++i) {
+    block_buf[i] = static_cast<char>(i % 251);
+  }
+  MacroBlockId macro_id(0, 100, 0);
+  ObMicroBlockCacheKey key(OB_SYS_TENANT_ID, macro_id, 0, micro_size);
+  ObMicroBlockCacheKey other_key(OB_SYS_TENANT_ID, macro_id, micro_size, micro_size);
+  const ObCompressedMicroBlockCacheValue *value = nullptr;
+  ObKVCacheHandle handle;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, cache_.put_block(key, nullptr, micro_size));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, cache_.put_block(key, block_buf, 0));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache_.get_block(key, value, handle));
+
+  // the cached block is a copy of the disk block, put it again is ignored
+  ASSERT_EQ(OB_SUCCESS, cache_.put_block(key, block_buf, micro_size));
+  ASSERT_EQ(OB_SUCCESS, cache_.put_block(key, block_buf, micro_size));
+  ASSERT_EQ(OB_SUCCESS, cache_.get_block(key, value, handle));
+  ASSERT_TRUE(nullptr != value);
+  ASSERT_EQ(micro_size, value->get_buf_size());
+  ASSERT_NE(block_buf, value->get_buf());
+  ASSERT_EQ(0, MEMCMP(block_buf, value->get_buf(), micro_size));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache_.get_block(other_key, value, handle));
+  handle.reset();
+
+  // erased block is read from disk again
+  ASSERT_EQ(OB_SUCCESS, cache_.erase(key));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache_.get_block(key, value, handle));
+}
+
+TEST_F(TestCompressedBlockCache, test_invalid_value)
+{
+  ObCompressedMicroBlockCacheValue empty_value;
+  char copy_buf[sizeof(ObCompressedMicroBlockCacheValue) + 16];
+  ObIKVCacheValue *copied = nullptr;
+  ASSERT_EQ(OB_INVALID_DATA, empty_value.deep_copy(copy_buf, sizeof(copy_buf), copied));
+
+  char block_buf[32] = {0};
+  ObCompressedMicroBlockCacheValue value(block_buf, sizeof(block_buf));
+  ASSERT_EQ(static_cast<int64_t>(sizeof(ObCompressedMicroBlockCacheValue) + sizeof(block_buf)), value.size());
+  ASSERT_EQ(OB_INVALID_ARGUMENT, value.deep_copy(copy_buf, sizeof(copy_buf), copied));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, value.deep_copy(nullptr, value.size(), copied));
+}
+
+}//namespace blocksstable
+}//namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("WARN");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,7 @@
 #define private public
 #include "lib/string/ob_sql_string.h"
 #include "storage/blocksstable/index_block/ob_index_block_aggregator.h"
+#include "share/datum/ob_datum_funcs.h"
 #include "ob_row_generate.h"
 
 
@@ -619,6 +620,148 @@ TEST_F(TestIndexBlockAggregator, test_sum)
   }
 }
 
+
+TEST_F(TestIndexBlockAggregator, test_bloom_filter)
+{
+  ObSkipIndexBloomFilter filter;
+  char buf[ObSkipIndexBloomFilter::MAX_SERIALIZE_SIZE];
+  int64_t pos = 0;
+  bool contain = false;
+  // exact hash set
+  for (uint64_t i = 0; i < ObSkipIndexBloomFilter::MAX_HASH_SET_CNT; ++i) {
+    filter.insert(murmurhash(&i, sizeof(i), 0));
+    filter.insert(murmurhash(&i, sizeof(i), 0));
+  }
+  ASSERT_FALSE(filter.is_bitmap_);
+  ASSERT_EQ(ObSkipIndexBloomFilter::MAX_HASH_SET_CNT, filter.hash_cnt_);
+  ASSERT_EQ(OB_SUCCESS, filter.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(filter.get_serialize_size(), pos);
+  for (uint64_t i = 0; i < 1000; ++i) {
+    ASSERT_EQ(OB_SUCCESS, ObSkipIndexBloomFilter::may_contain(buf, pos, murmurhash(&i, sizeof(i), 0), contain));
+    ASSERT_EQ(i < ObSkipIndexBloomFilter::MAX_HASH_SET_CNT, contain);
+  }
+
+  // turn into bitmap, no false negative and few false positive
+  const uint64_t bitmap_value_cnt = 200;
+  for (uint64_t i = ObSkipIndexBloomFilter::MAX_HASH_SET_CNT; i < bitmap_value_cnt; ++i) {
+    filter.insert(murmurhash(&i, sizeof(i), 0));
+  }
+  ASSERT_TRUE(filter.is_bitmap_);
+  ASSERT_FALSE(filter.is_saturated());
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, filter.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(ObSkipIndexBloomFilter::MAX_SERIALIZE_SIZE, pos);
+  int64_t false_positive_cnt = 0;
+  for (uint64_t i = 0; i < 10 * bitmap_value_cnt; ++i) {
+    ASSERT_EQ(OB_SUCCESS, ObSkipIndexBloomFilter::may_contain(buf, pos, murmurhash(&i, sizeof(i), 0), contain));
+    if (i < bitmap_value_cnt) {
+      ASSERT_TRUE(contain);
+    } else if (contain) {
+      false_positive_cnt++;
+    }
+  }
+  ASSERT_LT(false_positive_cnt, bitmap_value_cnt);
+
+  // merge hash set and bitmap into hash set
+  ObSkipIndexBloomFilter other;
+  char other_buf[ObSkipIndexBloomFilter::MAX_SERIALIZE_SIZE];
+  int64_t other_pos = 0;
+  for (uint64_t i = 1000; i < 1005; ++i) {
+    other.insert(murmurhash(&i, sizeof(i), 0));
+  }
+  ASSERT_EQ(OB_SUCCESS, other.merge(buf, pos));
+  ASSERT_TRUE(other.is_bitmap_);
+  ASSERT_EQ(OB_SUCCESS, other.serialize(other_buf, sizeof(other_buf), other_pos));
+  for (uint64_t i = 0; i < 1005; ++i) {
+    ASSERT_EQ(OB_SUCCESS, ObSkipIndexBloomFilter::may_contain(other_buf, other_pos, murmurhash(&i, sizeof(i), 0), contain));
+    ASSERT_TRUE(i >= bitmap_value_cnt && i < 1000 || contain);
+  }
+  ASSERT_NE(OB_SUCCESS, other.merge(buf, 2));
+  ASSERT_NE(OB_SUCCESS, ObSkipIndexBloomFilter::may_contain(buf, 2, 0, contain));
+
+  // too many values
+  for (uint64_t i = 0; i < 100 * bitmap_value_cnt; ++i) {
+    filter.insert(murmurhash(&i, sizeof(i), 0));
+  }
+  ASSERT_TRUE(filter.is_saturated());
+}
+
+TEST_F(TestIndexBlockAggregator, test_bloom_filter_aggregate)
+{
+  static const int64_t test_column_cnt = 3;
+  const int64_t test_row_cnt = 100;
+  const int64_t extra_rowkey_cnt = ObMultiVersionRowkeyHelpper::get_extra_rowkey_col_cnt();
+  ObObjType col_obj_types[test_column_cnt] = {ObIntType, ObVarcharType, ObDoubleType};
+  init_schema(test_column_cnt, col_obj_types);
+  for (int64_t i = 0; i < test_column_cnt; ++i) {
+    ObSkipIndexColMeta meta;
+    meta.col_idx_ = i < rowkey_count_ ? i : i + extra_rowkey_cnt;
+    meta.col_type_ = SK_IDX_BLOOM_FILTER;
+    ASSERT_EQ(OB_SUCCESS, full_agg_metas_.push_back(meta));
+  }
+  sql::ObExprHashFuncType hash_funcs[test_column_cnt];
+  for (int64_t i = 0; i < test_column_cnt; ++i) {
+    const ObColDesc &col_desc = col_descs_.at(full_agg_metas_.at(i).col_idx_);
+    hash_funcs[i] = ObDatumFuncs::get_basic_func(col_desc.col_type_.get_type(),
+        col_desc.col_type_.get_collation_type())->murmur_hash_v2_;
+  }
+
+  ObSkipIndexAggregator data_aggregator;
+  ObSkipIndexAggregator index_aggregator;
+  ObDatumRow data_agg_result;
+  ObDatumRow index_agg_result;
+  ASSERT_EQ(OB_SUCCESS, data_agg_result.init(full_agg_metas_.count()));
+  ASSERT_EQ(OB_SUCCESS, index_agg_result.init(full_agg_metas_.count()));
+  ASSERT_EQ(OB_SUCCESS, data_aggregator.init(full_agg_metas_, col_descs_, true, data_agg_result, allocator_));
+  ASSERT_EQ(OB_SUCCESS, index_aggregator.init(full_agg_metas_, col_descs_, false, index_agg_result, allocator_));
+
+  ObDatumRow generate_row;
+  ASSERT_EQ(OB_SUCCESS, generate_row.init(full_column_count_));
+  const ObDatumRow *data_agg_row = nullptr;
+  const ObDatumRow *index_agg_row = nullptr;
+  // each data block has 10 rows and keeps exact hash set, the index block turns into bitmap
+  for (int64_t block_idx = 0; block_idx < test_row_cnt / 10; ++block_idx) {
+    data_aggregator.reuse();
+    for (int64_t i = block_idx * 10; i < (block_idx + 1) * 10; ++i) {
+      generate_row_by_seed(i, generate_row);
+      ASSERT_EQ(OB_SUCCESS, data_aggregator.eval(generate_row));
+    }
+    ASSERT_EQ(OB_SUCCESS, data_aggregator.get_aggregated_row(data_agg_row));
+    if (0 == block_idx % 2) {
+      ASSERT_EQ(OB_SUCCESS, index_aggregator.eval(*data_agg_row));
+    } else {
+      const char *row_buf = nullptr;
+      int64_t row_size = 0;
+      serialize_agg_row(*data_agg_row, row_buf, row_size);
+      ASSERT_EQ(OB_SUCCESS, index_aggregator.eval(row_buf, row_size, block_idx));
+    }
+    // float and double are not aggregated
+    ASSERT_TRUE(data_agg_row->storage_datums_[2].is_nop());
+  }
+  ASSERT_EQ(OB_SUCCESS, index_aggregator.get_aggregated_row(index_agg_row));
+  ASSERT_TRUE(index_agg_row->storage_datums_[2].is_nop());
+  for (int64_t i = 0; i < test_row_cnt; ++i) {
+    generate_row_by_seed(i, generate_row);
+    for (int64_t col = 0; col < test_column_cnt - 1; ++col) {
+      const ObStorageDatum &datum = generate_row.storage_datums_[full_agg_metas_.at(col).col_idx_];
+      const ObStorageDatum &filter_datum = index_agg_row->storage_datums_[col];
+      uint64_t hash = 0;
+      bool contain = false;
+      ASSERT_EQ(OB_SUCCESS, hash_funcs[col](datum, ObSkipIndexBloomFilter::HASH_SEED, hash));
+      ASSERT_FALSE(filter_datum.is_nop());
+      ASSERT_EQ(OB_SUCCESS, ObSkipIndexBloomFilter::may_contain(filter_datum.ptr_, filter_datum.len_, hash, contain));
+      ASSERT_TRUE(contain);
+    }
+  }
+
+  // filter of a child block not aggregated makes the parent not aggregated too
+  index_aggregator.reuse();
+  const_cast<ObDatumRow *>(data_agg_row)->storage_datums_[0].set_nop();
+  ASSERT_EQ(OB_SUCCESS, index_aggregator.eval(*data_agg_row));
+  ASSERT_EQ(OB_SUCCESS, index_aggregator.get_aggregated_row(index_agg_row));
+  ASSERT_TRUE(index_agg_row->storage_datums_[0].is_nop());
+}
+
 }
 }
 
@@ -22,6 +22,7 @@
 #include "ob_row_generate.h"
 #include "ob_data_file_prepare.h"
 #include "share/ob_simple_mem_limit_getter.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
@@ -29,6 +30,7 @@ using namespace common;
 using namespace blocksstable;
 using namespace storage;
 using namespace share::schema;
+using namespace omt;
 static ObSimpleMemLimitGetter getter;
 
 namespace unittest
@@ -2348,6 +2350,189 @@ TEST_F(TestTmpFile, test_truncate_free_block) {
 
 }
 
+static void fill_random_buf(char *buf, const int64_t size, uint64_t seed)
+{
+  for (int64_t i = 0; i < size; ++i) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    buf[i] = static_cast<char>(seed);
+  }
+}
+
+static void set_tmp_file_compression(const bool enable)
+{
+  ObTenantConfigGuard tenant_config(TENANT_CONF(1));
+  ASSERT_TRUE(tenant_config.is_valid());
+  tenant_config->_enable_temporary_file_compression = enable;
+}
+
+TEST_F(TestTmpFile, test_tmp_file_page_compressor)
+{
+  const int64_t page_size = ObTmpMacroBlock::get_default_page_size();
+  const int64_t header_size = ObTmpFilePageCompressor::PAGE_RECORD_HEADER_SIZE;
+  ObCompressor *compressor = NULL;
+  int64_t buf_size = 0;
+  ASSERT_EQ(OB_SUCCESS, ObTmpFilePageCompressor::get_compressor(compressor));
+  ASSERT_EQ(OB_SUCCESS, ObTmpFilePageCompressor::get_compress_buf_size(*compressor, buf_size));
+  ASSERT_GE(buf_size, ObTmpFileStore::get_block_size());
+  ASSERT_EQ(0, buf_size % DIO_ALIGN_SIZE);
+
+  char *pages = (char *)malloc(3 * page_size);
+  char *comp_buf = (char *)malloc(buf_size);
+  char *out_buf = (char *)malloc(3 * page_size);
+  for (int64_t i = 0; i < page_size; ++i) {
+    pages[i] = static_cast<char>(i % 256);
+  }
+  fill_random_buf(pages + page_size, page_size, 7);
+  MEMSET(pages + 2 * page_size, 'x', page_size);
+
+  // compressible page, incompressible page and the page not written by any extent.
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, ObTmpFilePageCompressor::compress_page(*compressor, pages, true, comp_buf, buf_size, pos));
+  const int64_t first_record_size = pos;
+  ASSERT_LT(first_record_size, header_size + page_size / 8);
+  ASSERT_EQ(OB_SUCCESS, ObTmpFilePageCompressor::compress_page(*compressor, pages + page_size, true,
+      comp_buf, buf_size, pos));
+  ASSERT_EQ(first_record_size + header_size + page_size, pos);
+  ASSERT_EQ(OB_SUCCESS, ObTmpFilePageCompressor::compress_page(*compressor, pages + 2 * page_size, false,
+      comp_buf, buf_size, pos));
+  ASSERT_EQ(first_record_size + 2 * header_size + page_size, pos);
+
+  MEMSET(out_buf, 0, 3 * page_size);
+  ASSERT_EQ(OB_SUCCESS, ObTmpFilePageCompressor::decompress_pages(comp_buf, pos, 3, out_buf, 3 * page_size));
+  ASSERT_EQ(0, memcmp(pages, out_buf, 2 * page_size));
+
+  // read the pages from the middle of the block.
+  MEMSET(out_buf, 0, page_size);
+  ASSERT_EQ(OB_SUCCESS, ObTmpFilePageCompressor::decompress_pages(comp_buf + first_record_size,
+      header_size + page_size, 1, out_buf, page_size));
+  ASSERT_EQ(0, memcmp(pages + page_size, out_buf, page_size));
+
+  // invalid buffer and records.
+  int64_t small_pos = 0;
+  ASSERT_EQ(OB_BUF_NOT_ENOUGH, ObTmpFilePageCompressor::compress_page(*compressor, pages, true,
+      comp_buf, page_size, small_pos));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ObTmpFilePageCompressor::decompress_pages(comp_buf, pos, 3, out_buf, page_size));
+  ASSERT_EQ(OB_INVALID_DATA, ObTmpFilePageCompressor::decompress_pages(comp_buf, pos - header_size - 1, 3,
+      out_buf, 3 * page_size));
+  const int32_t invalid_size = static_cast<int32_t>(page_size + 1);
+  MEMCPY(comp_buf, &invalid_size, header_size);
+  ASSERT_EQ(OB_INVALID_DATA, ObTmpFilePageCompressor::decompress_pages(comp_buf, pos, 3, out_buf, 3 * page_size));
+
+  const int64_t block_size = ObTmpFileStore::get_block_size();
+  ASSERT_TRUE(ObTmpFilePageCompressor::is_worth_compressing(block_size - block_size / 8, block_size));
+  ASSERT_FALSE(ObTmpFilePageCompressor::is_worth_compressing(block_size - block_size / 8 + 1, block_size));
+
+  free(pages);
+  free(comp_buf);
+  free(out_buf);
+}
+
+TEST_F(TestTmpFile, test_tmp_file_wash_compressed)
+{
+  int ret = OB_SUCCESS;
+  int64_t dir = -1;
+  int64_t fd = -1;
+  const int64_t block_size = ObTmpFileStore::get_block_size();
+  const int64_t page_size = ObTmpMacroBlock::get_default_page_size();
+  ObTmpFileIOInfo io_info;
+  ObTmpFileIOHandle handle;
+  io_info.tenant_id_ = 1;
+  io_info.io_desc_.set_wait_event(2);
+  io_info.io_timeout_ms_ = DEFAULT_IO_WAIT_TIME_MS;
+  char *write_buf = (char *)malloc(block_size);
+  for (int64_t i = 0; i < block_size; ++i) {
+    write_buf[i] = static_cast<char>(i % 256);
+  }
+  char *random_buf = (char *)malloc(block_size);
+  fill_random_buf(random_buf, block_size, 13);
+  char *read_buf = (char *)malloc(block_size);
+
+  ASSERT_EQ(OB_SUCCESS, ObTenantConfigMgr::get_instance().add_tenant_config(1));
+  set_tmp_file_compression(true);
+  ObTmpTenantFileStoreHandle store_handle;
+  OB_TMP_FILE_STORE.get_store(1, store_handle);
+  ObTmpTenantMacroBlockManager &block_mgr = store_handle.get_tenant_store()->tmp_block_manager_;
+
+  // the compressible block is written with the page records.
+  ret = ObTmpFileManager::get_instance().alloc_dir(dir);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ret = ObTmpFileManager::get_instance().open(fd, dir);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  io_info.fd_ = fd;
+  io_info.buf_ = write_buf;
+  io_info.size_ = block_size;
+  ret = ObTmpFileManager::get_instance().write(io_info);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ObTmpFileManager::get_instance().sync(fd, 5000);
+  ASSERT_EQ(1, block_mgr.blocks_.size());
+  const int64_t comp_block_id = block_mgr.blocks_.begin()->first;
+  ObTmpMacroBlock *block = block_mgr.blocks_.begin()->second;
+  ASSERT_TRUE(block->is_disked());
+  const uint32_t *page_offsets = block->get_comp_page_offsets();
+  ASSERT_NE(nullptr, page_offsets);
+  ASSERT_EQ(0, page_offsets[0]);
+  ASSERT_TRUE(ObTmpFilePageCompressor::is_worth_compressing(
+      page_offsets[ObTmpFilePageBuddy::MAX_PAGE_NUMS], block_size));
+
+  // read through io and decompress, the whole block and a range across pages.
+  ObKVGlobalCache::get_instance().erase_cache(1, "tmp_block_cache");
+  ObKVGlobalCache::get_instance().erase_cache(1, "tmp_page_cache");
+  io_info.buf_ = read_buf;
+  io_info.size_ = block_size;
+  ret = ObTmpFileManager::get_instance().pread(io_info, 0, handle);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(block_size, handle.get_data_size());
+  ASSERT_EQ(0, memcmp(handle.get_buffer(), write_buf, block_size));
+  ObKVGlobalCache::get_instance().erase_cache(1, "tmp_block_cache");
+  ObKVGlobalCache::get_instance().erase_cache(1, "tmp_page_cache");
+  io_info.size_ = 3 * page_size;
+  ret = ObTmpFileManager::get_instance().pread(io_info, 10 * page_size + 100, handle);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(3 * page_size, handle.get_data_size());
+  ASSERT_EQ(0, memcmp(handle.get_buffer(), write_buf + 10 * page_size + 100, 3 * page_size));
+  handle.reset();
+  ObTmpFileManager::get_instance().remove(fd);
+
+  // the incompressible block is written as it is.
+  ret = ObTmpFileManager::get_instance().alloc_dir(dir);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ret = ObTmpFileManager::get_instance().open(fd, dir);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  io_info.fd_ = fd;
+  io_info.buf_ = random_buf;
+  io_info.size_ = block_size;
+  ret = ObTmpFileManager::get_instance().write(io_info);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ObTmpFileManager::get_instance().sync(fd, 5000);
+  block = NULL;
+  ObTmpTenantMacroBlockManager::TmpMacroBlockMap::iterator iter;
+  for (iter = block_mgr.blocks_.begin(); iter != block_mgr.blocks_.end(); ++iter) {
+    if (comp_block_id != iter->first) {
+      block = iter->second;
+    }
+  }
+  ASSERT_NE(nullptr, block);
+  ASSERT_TRUE(block->is_disked());
+  ASSERT_EQ(nullptr, block->get_comp_page_offsets());
+
+  ObKVGlobalCache::get_instance().erase_cache(1, "tmp_block_cache");
+  ObKVGlobalCache::get_instance().erase_cache(1, "tmp_page_cache");
+  io_info.buf_ = read_buf;
+  io_info.size_ = block_size;
+  ret = ObTmpFileManager::get_instance().pread(io_info, 0, handle);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(block_size, handle.get_data_size());
+  ASSERT_EQ(0, memcmp(handle.get_buffer(), random_buf, block_size));
+  handle.reset();
+  ObTmpFileManager::get_instance().remove(fd);
+
+  set_tmp_file_compression(false);
+  free(write_buf);
+  free(random_buf);
+  free(read_buf);
+}
 
 }  // end namespace unittest
 }  // end namespace oceanbase
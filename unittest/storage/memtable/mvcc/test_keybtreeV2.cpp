@@ -117,6 +117,10 @@ public:
   {
     return obj_;
   }
+  void get_key_prefix(uint64_t &prefix, uint8_t &prefix_type) const
+  {
+    get_obj_key_prefix(obj_, prefix, prefix_type);
+  }
   ObObj *obj_;
 };
 
@@ -283,6 +287,129 @@ TEST(TestBtree, smoke_test)
   allocator->free(end_key.get_ptr());
 }
 
+FakeKey build_key(const ObObj &obj)
+{
+  auto alloc = FakeAllocator::get_instance();
+  void *block = alloc->alloc_key(sizeof(ObObj));
+  EXPECT_TRUE(OB_NOT_NULL(block));
+  return FakeKey(new (block) ObObj(obj));
+}
+
+TEST(TestBtree, key_prefix)
+{
+  FakeAllocator *allocator = FakeAllocator::get_instance();
+  BtreeNodeAllocator<FakeKey, int64_t *> node_allocator(*allocator);
+  ObKeyBtree btree(node_allocator);
+  ASSERT_EQ(btree.init(), OB_SUCCESS);
+
+  // int keys of mixed width, unsigned keys on both sides of 2^63, and keys of int and uint mixed
+  // in the same nodes, values are distinct so that no two keys are equal
+  std::vector<ObObj> objs;
+  ObObj obj;
+  for (int64_t i = -3000; i < 3000; ++i) {
+    const int64_t v = i * 3;
+    if (v >= INT8_MIN && v <= INT8_MAX) {
+      obj.set_tinyint(static_cast<int8_t>(v));
+    } else if (v >= INT16_MIN && v <= INT16_MAX) {
+      obj.set_smallint(static_cast<int16_t>(v));
+    } else if (i % 2 == 0) {
+      obj.set_int32(static_cast<int32_t>(v));
+    } else {
+      obj.set_int(v * 1000000007L);
+    }
+    objs.push_back(obj);
+  }
+  for (int64_t i = 0; i < 1000; ++i) {
+    obj.set_uint64(i * 3 + 1);
+    objs.push_back(obj);
+    obj.set_uint64((1ULL << 63) + i * 7);
+    objs.push_back(obj);
+  }
+  obj.set_int(INT64_MIN);
+  objs.push_back(obj);
+  obj.set_int(INT64_MAX);
+  objs.push_back(obj);
+  obj.set_uint64(UINT64_MAX);
+  objs.push_back(obj);
+  std::random_shuffle(objs.begin(), objs.end());
+
+  std::vector<int64_t> vals(objs.size());
+  std::vector<FakeKey> keys;
+  for (int64_t i = 0; i < objs.size(); ++i) {
+    vals[i] = i;
+    keys.push_back(build_key(objs[i]));
+    int64_t *val = &vals[i];
+    ASSERT_EQ(OB_SUCCESS, btree.insert(keys[i], val));
+  }
+
+  // point get, with search keys built separately
+  int64_t *val = nullptr;
+  for (int64_t i = 0; i < objs.size(); ++i) {
+    FakeKey search_key(&objs[i]);
+    ASSERT_EQ(OB_SUCCESS, btree.get(search_key, val));
+    ASSERT_EQ(i, *val);
+  }
+  for (int64_t i = -100; i < 100; ++i) {
+    obj.set_int(i * 3 + 2);
+    FakeKey search_key(&obj);
+    ASSERT_EQ(OB_ENTRY_NOT_EXIST, btree.get(search_key, val));
+    obj.set_uint64((1ULL << 63) + (i + 100) * 7 + 3);
+    ASSERT_EQ(OB_ENTRY_NOT_EXIST, btree.get(search_key, val));
+  }
+
+  // full scan returns all keys in order
+  ObObj start_obj;
+  ObObj end_obj;
+  start_obj.set_int(INT64_MIN);
+  end_obj.set_uint64(UINT64_MAX);
+  BtreeIterator iter;
+  FakeKey key;
+  FakeKey prev_key;
+  int64_t cnt = 0;
+  ASSERT_EQ(OB_SUCCESS, btree.set_key_range(iter, FakeKey(&start_obj), false, FakeKey(&end_obj), false));
+  while (OB_SUCCESS == iter.get_next(key, val)) {
+    if (cnt > 0) {
+      int cmp = 0;
+      ASSERT_EQ(OB_SUCCESS, prev_key.compare(key, cmp));
+      ASSERT_LT(cmp, 0);
+    }
+    prev_key = key;
+    ++cnt;
+  }
+  ASSERT_EQ(objs.size(), cnt);
+
+  // range scan across the sign bit and the 2^63 boundary of unsigned keys
+  start_obj.set_smallint(-300);
+  end_obj.set_uint64((1ULL << 63) + 70);
+  iter.reset();
+  cnt = 0;
+  ASSERT_EQ(OB_SUCCESS, btree.set_key_range(iter, FakeKey(&start_obj), false, FakeKey(&end_obj), true));
+  while (OB_SUCCESS == iter.get_next(key, val)) {
+    int cmp = 0;
+    ASSERT_EQ(OB_SUCCESS, key.compare(FakeKey(&start_obj), cmp));
+    ASSERT_GE(cmp, 0);
+    ASSERT_EQ(OB_SUCCESS, key.compare(FakeKey(&end_obj), cmp));
+    ASSERT_LT(cmp, 0);
+    ++cnt;
+  }
+  int64_t expected_cnt = 0;
+  for (int64_t i = 0; i < objs.size(); ++i) {
+    int start_cmp = 0;
+    int end_cmp = 0;
+    ASSERT_EQ(OB_SUCCESS, objs[i].compare(start_obj, start_cmp));
+    ASSERT_EQ(OB_SUCCESS, objs[i].compare(end_obj, end_cmp));
+    if (start_cmp >= 0 && end_cmp < 0) {
+      ++expected_cnt;
+    }
+  }
+  ASSERT_EQ(expected_cnt, cnt);
+
+  btree.destroy(false /*is_batch_destroy*/);
+  for (auto &key : keys) {
+    allocator->free(key.get_ptr());
+  }
+}
+
 TEST(TestEventualConsistency, smoke_test)
 {
   constexpr uint64_t KEY_NUM = 6400000;
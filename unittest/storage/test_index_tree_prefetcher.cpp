@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/access/ob_index_tree_prefetcher.h"
+#include "storage/access/ob_table_access_context.h"
+
+namespace oceanbase
+{
+using namespace storage;
+using namespace blocksstable;
+using namespace common;
+namespace unittest
+{
+
+typedef ObIndexTreeMultiPassPrefetcher<> Prefetcher;
+
+class TestIndexTreePrefetcher : public ::testing::Test
+{
+public:
+  virtual void SetUp();
+  virtual void TearDown();
+  // make the micro block to be read next ready or not ready
+  void set_next_block_ready(const bool is_ready);
+  void set_reach_hold_limit(const bool reach_limit);
+protected:
+  ObTableAccessContext access_ctx_;
+  Prefetcher prefetcher_;
+  ObIOResult io_result_;
+};
+
+void TestIndexTreePrefetcher::SetUp()
+{
+  access_ctx_.micro_block_handle_mgr_.cache_mem_ctrl_.init(true /*enable_limit*/);
+  prefetcher_.access_ctx_ = &access_ctx_;
+  prefetcher_.max_micro_handle_cnt_ = Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  prefetcher_.cur_micro_data_fetch_idx_ = 0;
+  prefetcher_.prefetch_depth_ = Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  prefetcher_.max_data_prefetch_depth_ = Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  prefetcher_.data_ready_cnt_ = 0;
+}
+
+void TestIndexTreePrefetcher::TearDown()
+{
+  // io result is not allocated by io manager, detach it before the handles are reset
+  for (int64_t i = 0; i < Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT; ++i) {
+    prefetcher_.micro_data_handles_[i].io_handle_.io_handle_.result_ = nullptr;
+    prefetcher_.micro_data_handles_[i].block_state_ = ObSSTableMicroBlockState::UNKNOWN_STATE;
+  }
+  access_ctx_.micro_block_handle_mgr_.cache_mem_ctrl_.current_hold_size_ = 0;
+  prefetcher_.reset();
+}
+
+void TestIndexTreePrefetcher::set_next_block_ready(const bool is_ready)
+{
+  ObMicroBlockDataHandle &micro_handle = prefetcher_.current_micro_handle();
+  micro_handle.block_state_ = ObSSTableMicroBlockState::IN_BLOCK_IO;
+  micro_handle.io_handle_.io_handle_.result_ = &io_result_;
+  io_result_.is_finished_ = is_ready;
+}
+
+void TestIndexTreePrefetcher::set_reach_hold_limit(const bool reach_limit)
+{
+  ObCacheMemController &cache_mem_ctrl = access_ctx_.micro_block_handle_mgr_.cache_mem_ctrl_;
+  cache_mem_ctrl.current_hold_size_ = reach_limit ? cache_mem_ctrl.hold_limit_ : 0;
+}
+
+TEST_F(TestIndexTreePrefetcher, shrink_when_ready)
+{
+  const int16_t max_depth = Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  set_next_block_ready(true);
+  // additive decrease after a whole window is ready before read
+  for (int16_t i = 0; i < max_depth - 1; ++i) {
+    prefetcher_.adjust_data_prefetch_depth();
+  }
+  ASSERT_EQ(max_depth, prefetcher_.max_data_prefetch_depth_);
+  ASSERT_EQ(max_depth - 1, prefetcher_.data_ready_cnt_);
+  prefetcher_.adjust_data_prefetch_depth();
+  ASSERT_EQ(max_depth - 1, prefetcher_.max_data_prefetch_depth_);
+  ASSERT_EQ(max_depth - 1, prefetcher_.prefetch_depth_);
+  ASSERT_EQ(0, prefetcher_.data_ready_cnt_);
+
+  // block in cache is ready too
+  prefetcher_.current_micro_handle().block_state_ = ObSSTableMicroBlockState::IN_BLOCK_CACHE;
+  for (int16_t i = 0; i < max_depth - 1; ++i) {
+    prefetcher_.adjust_data_prefetch_depth();
+  }
+  ASSERT_EQ(max_depth - 2, prefetcher_.max_data_prefetch_depth_);
+
+  // never shrink below the min depth
+  for (int64_t i = 0; i < max_depth * max_depth; ++i) {
+    prefetcher_.adjust_data_prefetch_depth();
+  }
+  ASSERT_EQ(Prefetcher::MIN_ADAPTIVE_DATA_PREFETCH_DEPTH, prefetcher_.max_data_prefetch_depth_);
+  ASSERT_EQ(Prefetcher::MIN_ADAPTIVE_DATA_PREFETCH_DEPTH, prefetcher_.prefetch_depth_);
+}
+
+TEST_F(TestIndexTreePrefetcher, shrink_when_reach_hold_limit)
+{
+  const int16_t max_depth = Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  set_next_block_ready(true);
+  prefetcher_.adjust_data_prefetch_depth();
+  ASSERT_EQ(1, prefetcher_.data_ready_cnt_);
+
+  // multiplicative decrease when held io buffers reach limit
+  set_reach_hold_limit(true);
+  prefetcher_.adjust_data_prefetch_depth();
+  ASSERT_EQ(max_depth / 2, prefetcher_.max_data_prefetch_depth_);
+  ASSERT_EQ(max_depth / 2, prefetcher_.prefetch_depth_);
+  ASSERT_EQ(0, prefetcher_.data_ready_cnt_);
+  for (int64_t i = 0; i < max_depth; ++i) {
+    prefetcher_.adjust_data_prefetch_depth();
+  }
+  ASSERT_EQ(Prefetcher::MIN_ADAPTIVE_DATA_PREFETCH_DEPTH, prefetcher_.max_data_prefetch_depth_);
+}
+
+TEST_F(TestIndexTreePrefetcher, grow_when_io_not_finished)
+{
+  const int16_t max_depth = Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  const int16_t min_depth = Prefetcher::MIN_ADAPTIVE_DATA_PREFETCH_DEPTH;
+  set_reach_hold_limit(true);
+  for (int64_t i = 0; i < max_depth; ++i) {
+    prefetcher_.adjust_data_prefetch_depth();
+  }
+  ASSERT_EQ(min_depth, prefetcher_.max_data_prefetch_depth_);
+
+  // multiplicative increase when the scan stalls on io, even if hold limit is reached
+  set_next_block_ready(false);
+  prefetcher_.data_ready_cnt_ = 1;
+  prefetcher_.adjust_data_prefetch_depth();
+  ASSERT_EQ(2 * min_depth, prefetcher_.max_data_prefetch_depth_);
+  ASSERT_EQ(0, prefetcher_.data_ready_cnt_);
+  set_reach_hold_limit(false);
+  for (int64_t i = 0; i < max_depth; ++i) {
+    prefetcher_.adjust_data_prefetch_depth();
+  }
+  ASSERT_EQ(max_depth, prefetcher_.max_data_prefetch_depth_);
+  // prefetch depth is only bounded by the window here, it grows when prefetching
+  ASSERT_EQ(min_depth, prefetcher_.prefetch_depth_);
+
+  // io finished before read is ready
+  set_next_block_ready(true);
+  prefetcher_.adjust_data_prefetch_depth();
+  ASSERT_EQ(max_depth, prefetcher_.max_data_prefetch_depth_);
+  ASSERT_EQ(1, prefetcher_.data_ready_cnt_);
+}
+
+TEST_F(TestIndexTreePrefetcher, window_kept_by_reuse)
+{
+  const int16_t max_depth = Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  set_reach_hold_limit(true);
+  prefetcher_.adjust_data_prefetch_depth();
+  ASSERT_EQ(max_depth / 2, prefetcher_.max_data_prefetch_depth_);
+  set_reach_hold_limit(false);
+  set_next_block_ready(true);
+  prefetcher_.adjust_data_prefetch_depth();
+  ASSERT_EQ(1, prefetcher_.data_ready_cnt_);
+
+  // rescan reuses the prefetcher, only the states of current scan are reset
+  prefetcher_.inner_reset();
+  ASSERT_EQ(max_depth / 2, prefetcher_.max_data_prefetch_depth_);
+  ASSERT_EQ(0, prefetcher_.data_ready_cnt_);
+
+  // reset restores the default window
+  TearDown();
+  ASSERT_EQ(max_depth, prefetcher_.max_data_prefetch_depth_);
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_index_tree_prefetcher.log*");
+  OB_LOGGER.set_file_name("test_index_tree_prefetcher.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}